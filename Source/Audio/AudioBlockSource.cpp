@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+    AudioBlockSource.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "AudioBlockSource.h"
+#include <cmath>
+#include <memory>
+
+bool AudioBlockSource::writeTo(juce::AudioFormatWriter& writer, int64_t startSample, int64_t length,
+                               const std::function<bool()>& shouldContinue) const
+{
+    if (read == nullptr || startSample < 0 || length < 0 || startSample + length > numSamples)
+        return false;
+
+    juce::AudioBuffer<float> block(numChannels, static_cast<int>(juce::jmin<int64_t>(kBlockSamples, length)));
+
+    for (int64_t done = 0; done < length; done += kBlockSamples)
+    {
+        if (shouldContinue != nullptr && ! shouldContinue())
+            return false;
+
+        const int blockLength = static_cast<int>(juce::jmin<int64_t>(kBlockSamples, length - done));
+        block.setSize(numChannels, blockLength, false, false, true);
+
+        if (! read(block, startSample + done, blockLength)
+            || ! writer.writeFromAudioSampleBuffer(block, 0, blockLength))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+AudioBlockSource AudioBlockSource::fromBuffer(const juce::AudioBuffer<float>& buffer)
+{
+    AudioBlockSource source;
+    source.numChannels = buffer.getNumChannels();
+    source.numSamples = buffer.getNumSamples();
+    source.read = [&buffer](juce::AudioBuffer<float>& dest, int64_t startSample, int count)
+    {
+        if (startSample < 0 || startSample + count > buffer.getNumSamples() || dest.getNumSamples() < count)
+            return false;
+
+        const int channels = juce::jmin(dest.getNumChannels(), buffer.getNumChannels());
+        for (int ch = 0; ch < channels; ++ch)
+            dest.copyFrom(ch, 0, buffer, ch, static_cast<int>(startSample), count);
+
+        return true;
+    };
+
+    return source;
+}
+
+AudioBlockSource AudioBlockSource::fromSnapshot(AudioSnapshotPtr snapshot)
+{
+    AudioBlockSource source;
+
+    if (snapshot == nullptr)
+        return source;
+
+    source.numChannels = snapshot->getNumChannels();
+    source.numSamples = snapshot->getNumSamples();
+    source.read = [snapshot](juce::AudioBuffer<float>& dest, int64_t startSample, int count)
+    {
+        return snapshot->readRange(dest, 0, startSample, count);
+    };
+
+    return source;
+}
+
+AudioBlockSource AudioBlockSource::withChannels(AudioBlockSource source, std::vector<int> channels)
+{
+    AudioBlockSource result;
+
+    if (source.isEmpty() || channels.empty())
+        return result;
+
+    for (const int channel : channels)
+        if (channel < 0 || channel >= source.numChannels)
+            return result;
+
+    result.numChannels = static_cast<int>(channels.size());
+    result.numSamples = source.numSamples;
+
+    // The whole source is read into a scratch block, then the wanted
+    // channels are copied out; the lambda owns both.
+    auto scratch = std::make_shared<juce::AudioBuffer<float>>();
+    result.read = [input = std::move(source), channels = std::move(channels), scratch]
+                  (juce::AudioBuffer<float>& dest, int64_t startSample, int count)
+    {
+        if (dest.getNumSamples() < count)
+            return false;
+
+        scratch->setSize(input.numChannels, count, false, false, true);
+        if (! input.read(*scratch, startSample, count))
+            return false;
+
+        for (int ch = 0; ch < juce::jmin(dest.getNumChannels(), static_cast<int>(channels.size())); ++ch)
+            dest.copyFrom(ch, 0, *scratch, channels[static_cast<size_t>(ch)], 0, count);
+
+        return true;
+    };
+
+    return result;
+}
+
+AudioBlockSource AudioBlockSource::resampled(AudioBlockSource source,
+                                             double sourceSampleRate,
+                                             double targetSampleRate,
+                                             SampleRateConverter::Quality quality)
+{
+    if (source.isEmpty() || std::abs(sourceSampleRate - targetSampleRate) <= 0.01)
+        return source;
+
+    // Conversion state lives between read() calls; the lambda shares it.
+    struct State
+    {
+        State(AudioBlockSource in, double fromRate, double toRate, SampleRateConverter::Quality q)
+            : input(std::move(in)),
+              converter(fromRate, toRate, input.numChannels, q)
+        {
+        }
+
+        AudioBlockSource input;
+        SampleRateConverter converter;
+        juce::AudioBuffer<float> inputBlock;
+        juce::AudioBuffer<float> pending;   // converted, not yet handed out
+        int pendingStart = 0;
+        int pendingCount = 0;
+        int64_t inputPosition = 0;
+        int64_t outputPosition = 0;
+        bool finished = false;
+    };
+
+    auto state = std::make_shared<State>(std::move(source), sourceSampleRate, targetSampleRate, quality);
+
+    AudioBlockSource result;
+    result.numChannels = state->input.numChannels;
+    result.numSamples = state->converter.getOutputLength(state->input.numSamples);
+    result.read = [state](juce::AudioBuffer<float>& dest, int64_t startSample, int count)
+    {
+        auto& s = *state;
+        const int numChannels = s.input.numChannels;
+
+        if (startSample != s.outputPosition || dest.getNumSamples() < count)
+        {
+            jassertfalse;  // resampled sources are strictly sequential
+            return false;
+        }
+
+        for (int written = 0; written < count;)
+        {
+            if (s.pendingCount > 0)
+            {
+                const int take = juce::jmin(s.pendingCount, count - written);
+                for (int ch = 0; ch < juce::jmin(numChannels, dest.getNumChannels()); ++ch)
+                    dest.copyFrom(ch, written, s.pending, ch, s.pendingStart, take);
+
+                s.pendingStart += take;
+                s.pendingCount -= take;
+                written += take;
+                continue;
+            }
+
+            if (s.finished)
+                return false;
+
+            s.pendingStart = 0;
+
+            if (s.inputPosition < s.input.numSamples)
+            {
+                const int blockLength = static_cast<int>(
+                    juce::jmin<int64_t>(kBlockSamples, s.input.numSamples - s.inputPosition));
+                s.inputBlock.setSize(numChannels, blockLength, false, false, true);
+
+                if (! s.input.read(s.inputBlock, s.inputPosition, blockLength))
+                    return false;
+
+                s.inputPosition += blockLength;
+                s.pending.setSize(numChannels, s.converter.getMaxOutputSamples(blockLength), false, false, true);
+                s.pendingCount = s.converter.process(s.inputBlock.getArrayOfReadPointers(), blockLength,
+                                                     s.pending.getArrayOfWritePointers());
+            }
+            else
+            {
+                s.pending.setSize(numChannels, s.converter.getMaxOutputSamples(0), false, false, true);
+                s.pendingCount = s.converter.finish(s.pending.getArrayOfWritePointers());
+                s.finished = true;
+            }
+        }
+
+        s.outputPosition += count;
+        return true;
+    };
+
+    return result;
+}
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    AudioBlockSource.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "AudioSnapshot.h"
+#include "SampleRateConverter.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Audio supplied one bounded block at a time to the paths that write a
+ * whole document out (save, auto-save, region export).
+ *
+ * Writers pull kBlockSamples frames per call, so a document is never copied
+ * into one contiguous buffer first, peak memory does not grow with its
+ * length, and documents longer than INT_MAX samples save like any other.
+ *
+ * read() fills dest[0, numSamples) with the frames starting at startSample.
+ * It is called from one thread at a time; sources from resampled() further
+ * require consecutive ranges starting at 0, which is what writeTo() does.
+ */
+struct AudioBlockSource
+{
+    using Reader = std::function<bool(juce::AudioBuffer<float>& dest, int64_t startSample, int numSamples)>;
+
+    /** Frames fetched per read() by writeTo(). */
+    static constexpr int kBlockSamples = 1 << 16;
+
+    int numChannels = 0;
+    int64_t numSamples = 0;
+    Reader read;
+
+    bool isEmpty() const { return numChannels == 0 || numSamples == 0 || read == nullptr; }
+
+    /**
+     * Streams [startSample, startSample + length) into writer in
+     * kBlockSamples blocks.
+     *
+     * @param shouldContinue  Optional; polled between blocks, false stops
+     * @return false if a read or write failed or shouldContinue stopped it
+     */
+    bool writeTo(juce::AudioFormatWriter& writer, int64_t startSample, int64_t length,
+                 const std::function<bool()>& shouldContinue = nullptr) const;
+
+    /** writeTo() for the whole source. */
+    bool writeTo(juce::AudioFormatWriter& writer) const { return writeTo(writer, 0, numSamples); }
+
+    /** Reads from a buffer the caller keeps alive for as long as the source. */
+    static AudioBlockSource fromBuffer(const juce::AudioBuffer<float>& buffer);
+
+    /**
+     * Reads from a snapshot, which the source keeps alive. Safe to hand to a
+     * background thread: the snapshot never changes.
+     */
+    static AudioBlockSource fromSnapshot(AudioSnapshotPtr snapshot);
+
+    /**
+     * Reads only the listed channels of source, in the order given (channel
+     * indices must be valid for source). Sequential-only sources stay so.
+     */
+    static AudioBlockSource withChannels(AudioBlockSource source, std::vector<int> channels);
+
+    /**
+     * Converts source to targetSampleRate on the fly with a streaming
+     * SampleRateConverter; the output length is
+     * SampleRateConverter::getOutputLength(source.numSamples). Matching
+     * rates return source unchanged. The result keeps conversion state, so
+     * it must be read sequentially from the start, once.
+     */
+    static AudioBlockSource resampled(AudioBlockSource source,
+                                      double sourceSampleRate,
+                                      double targetSampleRate,
+                                      SampleRateConverter::Quality quality = SampleRateConverter::Quality::High);
+};
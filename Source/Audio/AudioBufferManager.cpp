@@ -36,6 +36,13 @@ bool AudioBufferManager::loadFromFile(const juce::File& file, juce::AudioFormatM
 {
     juce::ScopedLock sl(m_lock);
 
+    // Uncompressed WAV/AIFF: map the file instead of decoding it. Opening is
+    // O(header) and RAM is only used for ranges that get edited.
+    if (loadMappedFile(file, formatManager))
+        return true;
+
+    invalidateFlatView();
+
     // Create reader for the file
     std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
 
@@ -49,59 +56,235 @@ bool AudioBufferManager::loadFromFile(const juce::File& file, juce::AudioFormatM
     m_sampleRate = reader->sampleRate;
     m_bitDepth = static_cast<int>(reader->bitsPerSample);
 
-    // Allocate buffer for entire file
-    int numChannels = static_cast<int>(reader->numChannels);
-    int64_t numSamples = reader->lengthInSamples;
-
-    // juce::AudioBuffer is indexed by int. A file with more than INT_MAX
-    // samples would be silently truncated by the narrowing cast below, losing
-    // audio with no error. Refuse the load instead of corrupting it. See
-    // REVIEW-QA L2. (INT_MAX samples ~= 11.9 h at 192 kHz.)
-    if (numSamples > static_cast<int64_t>(std::numeric_limits<int>::max()))
+    // The store decodes in fixed-size chunks with 64-bit positions, so files
+    // longer than INT_MAX samples load in full. (The REVIEW-QA L2 refusal was
+    // only needed while the whole file had to fit one juce::AudioBuffer.)
+    if (! m_store.loadFromReader(*reader))
     {
-        juce::Logger::writeToLog(
-            "AudioBufferManager::loadFromFile: file exceeds maximum supported "
-            "length (" + juce::String(numSamples) + " samples > INT_MAX) for " +
-            file.getFileName());
+        juce::Logger::writeToLog("AudioBufferManager: Failed to read " + file.getFileName());
         return false;
     }
 
-    m_buffer.setSize(numChannels, static_cast<int>(numSamples));
+    DBG("AudioBufferManager: Loaded " + juce::String(m_store.getNumSamples()) +
+        " samples, " + juce::String(m_store.getNumChannels()) + " channels, " +
+        juce::String(m_sampleRate) + " Hz, " + juce::String(m_bitDepth) + " bits");
+
+    return true;
+}
+
+bool AudioBufferManager::loadMappedFile(const juce::File& file, juce::AudioFormatManager& formatManager)
+{
+    juce::ScopedLock sl(m_lock);
+
+    auto mapped = createMappedReader(file, formatManager);
+    if (mapped == nullptr)
+        return false;
+
+    invalidateFlatView();
 
-    // Read entire file into buffer
-    reader->read(&m_buffer, 0, static_cast<int>(numSamples), 0, true, true);
+    m_sampleRate = mapped->sampleRate;
+    m_bitDepth = static_cast<int>(mapped->bitsPerSample);
+    m_store.loadFromMappedReader(std::move(mapped));
 
-    DBG("AudioBufferManager: Loaded " + juce::String(numSamples) +
-        " samples, " + juce::String(numChannels) + " channels, " +
+    DBG("AudioBufferManager: Mapped " + juce::String(m_store.getNumSamples()) +
+        " samples, " + juce::String(m_store.getNumChannels()) + " channels, " +
         juce::String(m_sampleRate) + " Hz, " + juce::String(m_bitDepth) + " bits");
 
     return true;
 }
 
+void AudioBufferManager::beginIncrementalLoad(double sampleRate, int bitDepth)
+{
+    juce::ScopedLock sl(m_lock);
+
+    invalidateFlatView();
+    m_store.clear();
+    m_sampleRate = sampleRate;
+    m_bitDepth = bitDepth;
+}
+
+bool AudioBufferManager::appendLoadedAudio(const AudioSampleStore& block)
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+
+    if (! m_store.insert(m_store.getNumSamples(), block))
+    {
+        juce::Logger::writeToLog("AudioBufferManager: Loaded block has the wrong channel count");
+        return false;
+    }
+
+    invalidateFlatView();
+    return true;
+}
+
+std::unique_ptr<juce::MemoryMappedAudioFormatReader> AudioBufferManager::createMappedReader(
+    const juce::File& file, juce::AudioFormatManager& formatManager)
+{
+    auto* format = formatManager.findFormatForFileExtension(file.getFileExtension());
+
+    // Only the PCM container formats support mapping; everything else
+    // (FLAC, MP3, OGG, ...) returns nullptr and takes the decode path.
+    if (format == nullptr)
+        return nullptr;
+
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader(format->createMemoryMappedReader(file));
+
+    if (reader == nullptr || reader->numChannels == 0 || reader->lengthInSamples <= 0)
+        return nullptr;
+
+    if (! reader->mapEntireFile())
+    {
+        DBG("AudioBufferManager: Could not map " + file.getFileName() + ", decoding instead");
+        return nullptr;
+    }
+
+    return reader;
+}
+
+bool AudioBufferManager::isFileBacked() const
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+    return m_store.hasMappedPieces();
+}
+
+bool AudioBufferManager::detachFromMappedFile()
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+
+    if (! m_store.hasMappedPieces())
+        return true;
+
+    if (! m_store.materialiseMappedPieces())
+    {
+        juce::Logger::writeToLog("AudioBufferManager: Failed reading mapped audio into memory");
+        return false;
+    }
+
+    // Same samples, but the pieces changed: drop any view onto the old ones.
+    invalidateFlatView();
+    return true;
+}
+
+int64_t AudioBufferManager::getResidentBytes() const
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+
+    const int64_t flatCopyBytes = m_flatCopy != nullptr
+        ? static_cast<int64_t>(m_flatCopy->getNumChannels()) * m_flatCopy->getNumSamples()
+              * static_cast<int64_t>(sizeof(float))
+        : 0;
+
+    return m_store.getResidentBytes() + flatCopyBytes;
+}
+
+bool AudioBufferManager::spillToFile(const juce::File& spillFile)
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+
+    if (m_store.isEmpty())
+        return false;
+
+    const int numChannels = m_store.getNumChannels();
+    const int64_t totalSamples = m_store.getNumSamples();
+    juce::WavAudioFormat wavFormat;
+
+    {
+        spillFile.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream(spillFile.createOutputStream());
+        if (stream == nullptr)
+            return false;
+
+        // 32-bit float keeps edited audio bit-exact. The writer takes the
+        // stream only on success.
+        auto writer = wavFormat.createWriterFor(
+            stream,
+            juce::AudioFormatWriterOptions()
+                .withSampleRate(m_sampleRate)
+                .withNumChannels(numChannels)
+                .withBitsPerSample(32)
+                .withSampleFormat(juce::AudioFormatWriterOptions::SampleFormat::floatingPoint));
+        if (writer == nullptr)
+            return false;
+
+        juce::AudioBuffer<float> block(numChannels, AudioSampleStore::kChunkSamples);
+        for (int64_t position = 0; position < totalSamples; position += AudioSampleStore::kChunkSamples)
+        {
+            const int blockLength = static_cast<int>(
+                juce::jmin<int64_t>(AudioSampleStore::kChunkSamples, totalSamples - position));
+
+            if (! m_store.read(block, 0, position, blockLength)
+                || ! writer->writeFromAudioSampleBuffer(block, 0, blockLength))
+            {
+                juce::Logger::writeToLog("AudioBufferManager: Failed writing spill file "
+                                         + spillFile.getFullPathName());
+                return false;
+            }
+        }
+    }  // the writer flushes and closes the file here
+
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(wavFormat.createMemoryMappedReader(spillFile));
+    if (mapped == nullptr || mapped->lengthInSamples != totalSamples || ! mapped->mapEntireFile())
+    {
+        juce::Logger::writeToLog("AudioBufferManager: Could not map spill file "
+                                 + spillFile.getFullPathName());
+        return false;
+    }
+
+    // m_sampleRate / m_bitDepth / m_version describe the document, not the
+    // spill, so they are deliberately left alone.
+    invalidateFlatView();
+    m_store.loadFromMappedReader(std::move(mapped));
+    return true;
+}
+
 void AudioBufferManager::clear()
 {
     juce::ScopedLock sl(m_lock);
-    m_buffer.setSize(0, 0);
+    invalidateFlatView();
+    m_store.clear();
     m_sampleRate = 44100.0;
     m_bitDepth = 16;
 }
 
 bool AudioBufferManager::hasAudioData() const
 {
-    return m_buffer.getNumSamples() > 0 && m_buffer.getNumChannels() > 0;
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+    return ! m_store.isEmpty();
 }
 
 //==============================================================================
 // Audio properties
 
+int AudioBufferManager::getNumChannels() const
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+    return m_store.getNumChannels();
+}
+
+int64_t AudioBufferManager::getNumSamples() const
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+    return m_store.getNumSamples();
+}
+
 double AudioBufferManager::getLengthInSeconds() const
 {
-    if (m_sampleRate <= 0.0 || m_buffer.getNumSamples() == 0)
+    const int64_t numSamples = getNumSamples();
+
+    if (m_sampleRate <= 0.0 || numSamples == 0)
     {
         return 0.0;
     }
 
-    return static_cast<double>(m_buffer.getNumSamples()) / m_sampleRate;
+    return static_cast<double>(numSamples) / m_sampleRate;
 }
 
 //==============================================================================
@@ -131,38 +314,87 @@ double AudioBufferManager::sampleToTime(int64_t samplePosition) const
 //==============================================================================
 // Buffer access
 
+bool AudioBufferManager::readRange(juce::AudioBuffer<float>& dest, int destStartSample,
+                                   int64_t sourceStartSample, int numSamples) const
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+    return m_store.read(dest, destStartSample, sourceStartSample, numSamples);
+}
+
+bool AudioBufferManager::readChannelRange(int channel, float* dest,
+                                          int64_t sourceStartSample, int numSamples) const
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+    return m_store.readChannel(channel, dest, sourceStartSample, numSamples);
+}
+
+const juce::AudioBuffer<float>& AudioBufferManager::getBuffer() const
+{
+    juce::ScopedLock sl(m_lock);
+    return materializeFlatView(false);
+}
+
+juce::AudioBuffer<float>& AudioBufferManager::getMutableBuffer()
+{
+    juce::ScopedLock sl(m_lock);
+
+    // The caller may write anything, so treat this as an edit.
+    ++m_version;
+    return materializeFlatView(true);
+}
+
+AudioSnapshotPtr AudioBufferManager::getSnapshot() const
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+
+    // Unchanged since the last publish: hand out the same snapshot.
+    if (auto published = m_publishedSnapshot.lock())
+    {
+        if (published->getVersion() == m_version)
+            return published;
+    }
+
+    if (m_store.isEmpty())
+        return nullptr;
+
+    // Freeze a copy of the piece list; every chunk is shared, not copied,
+    // so this is O(pieces) however long the document is.
+    auto snapshot = std::make_shared<const AudioSnapshot>(m_store, m_sampleRate, m_version);
+    m_publishedSnapshot = snapshot;
+    return snapshot;
+}
+
+uint64_t AudioBufferManager::getVersion() const
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+    return m_version;
+}
+
 juce::AudioBuffer<float> AudioBufferManager::getAudioRange(int64_t startSample, int64_t numSamples) const
 {
     juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
-    // DEBUG: Log the extraction request
-    DBG("AudioBufferManager::getAudioRange called:");
-    DBG("  Start sample: " + juce::String(startSample));
-    DBG("  Num samples requested: " + juce::String(numSamples));
-    DBG("  Total buffer samples: " + juce::String(m_buffer.getNumSamples()));
-    DBG("  Buffer channels: " + juce::String(m_buffer.getNumChannels()));
+    const int64_t totalSamples = m_store.getNumSamples();
 
-    // Validate range
+    // Validate range (a single returned buffer is int-indexed)
     if (startSample < 0 || numSamples <= 0 ||
-        startSample + numSamples > m_buffer.getNumSamples())
+        startSample + numSamples > totalSamples ||
+        numSamples > static_cast<int64_t>(std::numeric_limits<int>::max()))
     {
         DBG("AudioBufferManager: Invalid range in getAudioRange");
         DBG("  Range check failed: startSample=" + juce::String(startSample) +
                                 " numSamples=" + juce::String(numSamples) +
-                                " totalSamples=" + juce::String(m_buffer.getNumSamples()));
+                                " totalSamples=" + juce::String(totalSamples));
         return juce::AudioBuffer<float>();
     }
 
-    // Create new buffer and copy the range
-    juce::AudioBuffer<float> rangeBuff(m_buffer.getNumChannels(), static_cast<int>(numSamples));
-
-    for (int ch = 0; ch < m_buffer.getNumChannels(); ++ch)
-    {
-        rangeBuff.copyFrom(ch, 0, m_buffer, ch, static_cast<int>(startSample), static_cast<int>(numSamples));
-    }
-
-    DBG("  Successfully extracted " + juce::String(rangeBuff.getNumSamples()) +
-                            " samples from position " + juce::String(startSample));
+    juce::AudioBuffer<float> rangeBuff(m_store.getNumChannels(), static_cast<int>(numSamples));
+    m_store.read(rangeBuff, 0, startSample, static_cast<int>(numSamples));
 
     return rangeBuff;
 }
@@ -173,49 +405,18 @@ juce::AudioBuffer<float> AudioBufferManager::getAudioRange(int64_t startSample,
 bool AudioBufferManager::deleteRange(int64_t startSample, int64_t numSamples)
 {
     juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
     // Validate range
     if (startSample < 0 || numSamples <= 0 ||
-        startSample + numSamples > m_buffer.getNumSamples())
+        startSample + numSamples > m_store.getNumSamples())
     {
         DBG("AudioBufferManager: Invalid range in deleteRange");
         return false;
     }
 
-    int numChannels = m_buffer.getNumChannels();
-    int oldNumSamples = m_buffer.getNumSamples();
-    int newNumSamples = oldNumSamples - static_cast<int>(numSamples);
-
-    // If deleting everything, just clear
-    if (newNumSamples <= 0)
-    {
-        m_buffer.setSize(numChannels, 0);
-        return true;
-    }
-
-    // Create new buffer without the deleted range
-    juce::AudioBuffer<float> newBuffer(numChannels, newNumSamples);
-
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        // Copy samples before the deleted range
-        if (startSample > 0)
-        {
-            newBuffer.copyFrom(ch, 0, m_buffer, ch, 0, static_cast<int>(startSample));
-        }
-
-        // Copy samples after the deleted range
-        int samplesAfterDelete = oldNumSamples - static_cast<int>(startSample + numSamples);
-        if (samplesAfterDelete > 0)
-        {
-            newBuffer.copyFrom(ch, static_cast<int>(startSample),
-                              m_buffer, ch, static_cast<int>(startSample + numSamples),
-                              samplesAfterDelete);
-        }
-    }
-
-    // Replace buffer
-    m_buffer = newBuffer;
+    invalidateFlatView();
+    m_store.erase(startSample, numSamples);
 
     DBG("AudioBufferManager: Deleted " + juce::String(numSamples) +
                              " samples starting at " + juce::String(startSample));
@@ -226,62 +427,78 @@ bool AudioBufferManager::deleteRange(int64_t startSample, int64_t numSamples)
 bool AudioBufferManager::insertAudio(int64_t insertPosition, const juce::AudioBuffer<float>& audioToInsert)
 {
     juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
     // Validate insert position
-    if (insertPosition < 0 || insertPosition > m_buffer.getNumSamples())
+    if (insertPosition < 0 || insertPosition > m_store.getNumSamples())
     {
         DBG("AudioBufferManager: Invalid insert position");
         return false;
     }
 
     // Check channel compatibility BEFORE any mutation. On mismatch we return
-    // false without touching m_buffer; the clipboard layer is responsible for
+    // false without touching the store; the clipboard layer is responsible for
     // surfacing the user-facing error and for channel normalization. Logged via
     // juce::Logger (not std::cerr) so it is visible in release. See REVIEW-QA C12.
-    if (m_buffer.getNumChannels() != audioToInsert.getNumChannels())
+    if (m_store.getNumChannels() != audioToInsert.getNumChannels())
     {
         juce::Logger::writeToLog(
             "AudioBufferManager::insertAudio: channel-count mismatch (buffer has " +
-            juce::String(m_buffer.getNumChannels()) + ", insert has " +
+            juce::String(m_store.getNumChannels()) + ", insert has " +
             juce::String(audioToInsert.getNumChannels()) + ") - insert refused");
         return false;
     }
 
-    int numChannels = m_buffer.getNumChannels();
-    int oldNumSamples = m_buffer.getNumSamples();
-    int insertNumSamples = audioToInsert.getNumSamples();
-    int newNumSamples = oldNumSamples + insertNumSamples;
+    // The store copies audioToInsert before splicing, so inserting the
+    // document's own flat view (paste-from-self) is safe.
+    m_store.insert(insertPosition, audioToInsert);
+    invalidateFlatView();
+
+    DBG("AudioBufferManager: Inserted " + juce::String(audioToInsert.getNumSamples()) +
+                             " samples at position " + juce::String(insertPosition));
 
-    // Create new buffer with space for inserted audio
-    juce::AudioBuffer<float> newBuffer(numChannels, newNumSamples);
+    return true;
+}
 
-    for (int ch = 0; ch < numChannels; ++ch)
+bool AudioBufferManager::insertFromFile(int64_t insertPosition, const juce::File& file,
+                                        juce::AudioFormatManager& formatManager)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr)
     {
-        // Copy samples before insert position
-        if (insertPosition > 0)
-        {
-            newBuffer.copyFrom(ch, 0, m_buffer, ch, 0, static_cast<int>(insertPosition));
-        }
+        juce::Logger::writeToLog("AudioBufferManager: Failed to create reader for " + file.getFileName());
+        return false;
+    }
+
+    // Decode off-lock; only the splice below needs the document.
+    AudioSampleStore decoded;
+    if (! decoded.loadFromReader(*reader))
+    {
+        juce::Logger::writeToLog("AudioBufferManager: Failed to read " + file.getFileName());
+        return false;
+    }
 
-        // Copy inserted audio
-        newBuffer.copyFrom(ch, static_cast<int>(insertPosition),
-                          audioToInsert, ch, 0, insertNumSamples);
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
-        // Copy samples after insert position
-        int samplesAfterInsert = oldNumSamples - static_cast<int>(insertPosition);
-        if (samplesAfterInsert > 0)
-        {
-            newBuffer.copyFrom(ch, static_cast<int>(insertPosition) + insertNumSamples,
-                              m_buffer, ch, static_cast<int>(insertPosition),
-                              samplesAfterInsert);
-        }
+    if (insertPosition < 0 || insertPosition > m_store.getNumSamples())
+    {
+        DBG("AudioBufferManager: Invalid insert position");
+        return false;
+    }
+
+    if (decoded.getNumChannels() != m_store.getNumChannels() || reader->sampleRate != m_sampleRate)
+    {
+        juce::Logger::writeToLog("AudioBufferManager::insertFromFile: " + file.getFileName()
+                                 + " does not match the document's channel count or sample rate - insert refused");
+        return false;
     }
 
-    // Replace buffer
-    m_buffer = newBuffer;
+    m_store.insert(insertPosition, decoded);
+    invalidateFlatView();
 
-    DBG("AudioBufferManager: Inserted " + juce::String(insertNumSamples) +
-                             " samples at position " + juce::String(insertPosition));
+    DBG("AudioBufferManager: Inserted " + juce::String(static_cast<juce::int64>(decoded.getNumSamples())) +
+        " samples from " + file.getFileName() + " at position " + juce::String(static_cast<juce::int64>(insertPosition)));
 
     return true;
 }
@@ -290,24 +507,21 @@ bool AudioBufferManager::replaceRange(int64_t startSample, int64_t numSamplesToR
                                      const juce::AudioBuffer<float>& newAudio)
 {
     juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
-    const int numChannels = m_buffer.getNumChannels();
-    const int oldNumSamples = m_buffer.getNumSamples();
+    const int numChannels = m_store.getNumChannels();
     const int insertNumSamples = newAudio.getNumSamples();
 
     // Validate the delete range BEFORE mutating anything.
     if (startSample < 0 || numSamplesToReplace <= 0 ||
-        startSample + numSamplesToReplace > oldNumSamples)
+        startSample + numSamplesToReplace > m_store.getNumSamples())
     {
         DBG("AudioBufferManager::replaceRange: invalid range");
         return false;
     }
 
-    // Validate channel compatibility BEFORE mutating anything. Previously this
-    // method deleted the range first and only then discovered an insert-side
-    // channel mismatch, leaving the buffer permanently short with a gap and no
-    // rollback. Now the whole operation is atomic: we either build the complete
-    // result and swap it in, or return false having touched nothing.
+    // Validate channel compatibility BEFORE mutating anything, so the whole
+    // operation is atomic: either the splice happens or nothing is touched.
     // See REVIEW-QA H1. (A zero-sample newAudio is a pure delete and skips the
     // channel check, matching the old insertAudio behaviour.)
     if (insertNumSamples > 0 && newAudio.getNumChannels() != numChannels)
@@ -319,31 +533,8 @@ bool AudioBufferManager::replaceRange(int64_t startSample, int64_t numSamplesToR
         return false;
     }
 
-    const int startInt = static_cast<int>(startSample);
-    const int deleteInt = static_cast<int>(numSamplesToReplace);
-    const int samplesAfter = oldNumSamples - (startInt + deleteInt);
-    const int newNumSamples = oldNumSamples - deleteInt + insertNumSamples;
-
-    // Build the result in a temp buffer, then swap. No partial mutation.
-    juce::AudioBuffer<float> newBuffer(numChannels, newNumSamples);
-
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        // Samples before the replaced range.
-        if (startInt > 0)
-            newBuffer.copyFrom(ch, 0, m_buffer, ch, 0, startInt);
-
-        // Replacement audio.
-        if (insertNumSamples > 0)
-            newBuffer.copyFrom(ch, startInt, newAudio, ch, 0, insertNumSamples);
-
-        // Samples after the replaced range.
-        if (samplesAfter > 0)
-            newBuffer.copyFrom(ch, startInt + insertNumSamples,
-                               m_buffer, ch, startInt + deleteInt, samplesAfter);
-    }
-
-    m_buffer = std::move(newBuffer);
+    m_store.replace(startSample, numSamplesToReplace, newAudio);
+    invalidateFlatView();
 
     DBG("AudioBufferManager: Replaced " + juce::String(numSamplesToReplace) +
         " samples at " + juce::String(startSample) + " with " +
@@ -355,20 +546,23 @@ bool AudioBufferManager::replaceRange(int64_t startSample, int64_t numSamplesToR
 bool AudioBufferManager::silenceRange(int64_t startSample, int64_t numSamples)
 {
     juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
     // Validate range
     if (startSample < 0 || numSamples <= 0 ||
-        startSample + numSamples > m_buffer.getNumSamples())
+        startSample + numSamples > m_store.getNumSamples())
     {
         DBG("AudioBufferManager: Invalid range in silenceRange");
         return false;
     }
 
     // Fill the range with zeros (digital silence)
-    for (int ch = 0; ch < m_buffer.getNumChannels(); ++ch)
-    {
-        m_buffer.clear(ch, static_cast<int>(startSample), static_cast<int>(numSamples));
-    }
+    modifyFrames(startSample, numSamples,
+                 [](juce::AudioBuffer<float>& block, int blockStart, int blockLength, int64_t)
+                 {
+                     for (int ch = 0; ch < block.getNumChannels(); ++ch)
+                         block.clear(ch, blockStart, blockLength);
+                 });
 
     DBG("AudioBufferManager: Silenced " + juce::String(numSamples) +
                              " samples starting at " + juce::String(startSample));
@@ -376,6 +570,21 @@ bool AudioBufferManager::silenceRange(int64_t startSample, int64_t numSamples)
     return true;
 }
 
+bool AudioBufferManager::processRange(int64_t startSample, int64_t numSamples, const FrameEditor& fn)
+{
+    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+
+    if (fn == nullptr || startSample < 0 || numSamples <= 0 ||
+        startSample + numSamples > m_store.getNumSamples())
+    {
+        DBG("AudioBufferManager: Invalid range in processRange");
+        return false;
+    }
+
+    return modifyFrames(startSample, numSamples, fn);
+}
+
 bool AudioBufferManager::silenceRangeForChannels(int64_t startSample, int64_t numSamples, int channelMask)
 {
     juce::ScopedLock sl(m_lock);
@@ -386,29 +595,29 @@ bool AudioBufferManager::silenceRangeForChannels(int64_t startSample, int64_t nu
         return silenceRange(startSample, numSamples);
     }
 
+    syncFlatViewIntoStore();
+
     // Validate range
     if (startSample < 0 || numSamples <= 0 ||
-        startSample + numSamples > m_buffer.getNumSamples())
+        startSample + numSamples > m_store.getNumSamples())
     {
         DBG("AudioBufferManager: Invalid range in silenceRangeForChannels");
         return false;
     }
 
     // Silence only the specified channels
-    [[maybe_unused]] int numChannelsSilenced = 0;
-    for (int ch = 0; ch < m_buffer.getNumChannels(); ++ch)
-    {
-        if ((channelMask & (1 << ch)) != 0)
-        {
-            m_buffer.clear(ch, static_cast<int>(startSample), static_cast<int>(numSamples));
-            numChannelsSilenced++;
-        }
-    }
+    modifyFrames(startSample, numSamples,
+                 [channelMask](juce::AudioBuffer<float>& block, int blockStart, int blockLength, int64_t)
+                 {
+                     for (int ch = 0; ch < block.getNumChannels(); ++ch)
+                     {
+                         if ((channelMask & (1 << ch)) != 0)
+                             block.clear(ch, blockStart, blockLength);
+                     }
+                 });
 
-    #if JUCE_DEBUG
     DBG("AudioBufferManager: Silenced " + juce::String(numSamples) +
-                             " samples on " + juce::String(numChannelsSilenced) + " channels");
-    #endif
+                             " samples on channel mask " + juce::String(channelMask));
 
     return true;
 }
@@ -423,9 +632,13 @@ juce::AudioBuffer<float> AudioBufferManager::getAudioRangeForChannels(int64_t st
         return getAudioRange(startSample, numSamples);
     }
 
+    syncFlatViewIntoStore();
+
+    const int numChannels = m_store.getNumChannels();
+
     // Count the number of channels to copy
     int outputChannelCount = 0;
-    for (int ch = 0; ch < m_buffer.getNumChannels(); ++ch)
+    for (int ch = 0; ch < numChannels; ++ch)
     {
         if ((channelMask & (1 << ch)) != 0)
             outputChannelCount++;
@@ -438,10 +651,10 @@ juce::AudioBuffer<float> AudioBufferManager::getAudioRangeForChannels(int64_t st
 
     // Validate range
     int64_t actualStart = juce::jmax((int64_t)0, startSample);
-    int64_t actualEnd = juce::jmin((int64_t)m_buffer.getNumSamples(), startSample + numSamples);
+    int64_t actualEnd = juce::jmin(m_store.getNumSamples(), startSample + numSamples);
     int64_t actualSamples = actualEnd - actualStart;
 
-    if (actualSamples <= 0)
+    if (actualSamples <= 0 || actualSamples > static_cast<int64_t>(std::numeric_limits<int>::max()))
     {
         return juce::AudioBuffer<float>();
     }
@@ -450,11 +663,11 @@ juce::AudioBuffer<float> AudioBufferManager::getAudioRangeForChannels(int64_t st
     juce::AudioBuffer<float> result(outputChannelCount, static_cast<int>(actualSamples));
 
     int outputCh = 0;
-    for (int ch = 0; ch < m_buffer.getNumChannels(); ++ch)
+    for (int ch = 0; ch < numChannels; ++ch)
     {
         if ((channelMask & (1 << ch)) != 0)
         {
-            result.copyFrom(outputCh, 0, m_buffer, ch, static_cast<int>(actualStart), static_cast<int>(actualSamples));
+            m_store.readChannel(ch, result.getWritePointer(outputCh), actualStart, static_cast<int>(actualSamples));
             outputCh++;
         }
     }
@@ -465,43 +678,48 @@ juce::AudioBuffer<float> AudioBufferManager::getAudioRangeForChannels(int64_t st
 bool AudioBufferManager::replaceChannelsInRange(int64_t startSample, const juce::AudioBuffer<float>& sourceAudio, int channelMask)
 {
     juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
     // Validate range
     if (startSample < 0 || sourceAudio.getNumSamples() <= 0 ||
-        startSample + sourceAudio.getNumSamples() > m_buffer.getNumSamples())
+        startSample + sourceAudio.getNumSamples() > m_store.getNumSamples())
     {
         DBG("AudioBufferManager: Invalid range in replaceChannelsInRange");
         return false;
     }
 
-    int numSamples = sourceAudio.getNumSamples();
-
-    // If channelMask is -1, replace all channels
-    if (channelMask == -1)
-    {
-        int channelsToReplace = juce::jmin(m_buffer.getNumChannels(), sourceAudio.getNumChannels());
-        for (int ch = 0; ch < channelsToReplace; ++ch)
-        {
-            m_buffer.copyFrom(ch, static_cast<int>(startSample), sourceAudio, ch, 0, numSamples);
-        }
-        return true;
-    }
-
-    // Count focused channels to determine source channel mapping
-    int sourceChIndex = 0;
-    for (int ch = 0; ch < m_buffer.getNumChannels(); ++ch)
-    {
-        if ((channelMask & (1 << ch)) != 0)
-        {
-            // Map source channel to destination channel
-            int srcCh = sourceChIndex % sourceAudio.getNumChannels();
-            m_buffer.copyFrom(ch, static_cast<int>(startSample), sourceAudio, srcCh, 0, numSamples);
-            sourceChIndex++;
-        }
-    }
+    const int numSamples = sourceAudio.getNumSamples();
+
+    modifyFrames(startSample, numSamples,
+                 [&sourceAudio, channelMask, startSample](juce::AudioBuffer<float>& block, int blockStart,
+                                                          int blockLength, int64_t documentPos)
+                 {
+                     const int sourceStart = static_cast<int>(documentPos - startSample);
+
+                     // If channelMask is -1, replace all channels
+                     if (channelMask == -1)
+                     {
+                         const int channelsToReplace = juce::jmin(block.getNumChannels(), sourceAudio.getNumChannels());
+                         for (int ch = 0; ch < channelsToReplace; ++ch)
+                             block.copyFrom(ch, blockStart, sourceAudio, ch, sourceStart, blockLength);
+                         return;
+                     }
+
+                     // Focused channels take source channels in order
+                     int sourceChIndex = 0;
+                     for (int ch = 0; ch < block.getNumChannels(); ++ch)
+                     {
+                         if ((channelMask & (1 << ch)) != 0)
+                         {
+                             const int srcCh = sourceChIndex % sourceAudio.getNumChannels();
+                             block.copyFrom(ch, blockStart, sourceAudio, srcCh, sourceStart, blockLength);
+                             sourceChIndex++;
+                         }
+                     }
+                 });
 
     DBG("AudioBufferManager: Replaced " + juce::String(numSamples) +
-                             " samples on " + juce::String(sourceChIndex) + " channels");
+                             " samples on channel mask " + juce::String(channelMask));
 
     return true;
 }
@@ -509,32 +727,24 @@ bool AudioBufferManager::replaceChannelsInRange(int64_t startSample, const juce:
 bool AudioBufferManager::trimToRange(int64_t startSample, int64_t numSamples)
 {
     juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
     // Validate range
     if (startSample < 0 || numSamples <= 0 ||
-        startSample + numSamples > m_buffer.getNumSamples())
+        startSample + numSamples > m_store.getNumSamples())
     {
         DBG("AudioBufferManager: Invalid range in trimToRange");
         return false;
     }
 
     // If trimming to entire buffer, nothing to do
-    if (startSample == 0 && numSamples == m_buffer.getNumSamples())
+    if (startSample == 0 && numSamples == m_store.getNumSamples())
     {
         return true;
     }
 
-    // Create new buffer with only the specified range
-    int numChannels = m_buffer.getNumChannels();
-    juce::AudioBuffer<float> newBuffer(numChannels, static_cast<int>(numSamples));
-
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        newBuffer.copyFrom(ch, 0, m_buffer, ch, static_cast<int>(startSample), static_cast<int>(numSamples));
-    }
-
-    // Replace buffer
-    m_buffer = newBuffer;
+    invalidateFlatView();
+    m_store.trim(startSample, numSamples);
 
     DBG("AudioBufferManager: Trimmed to " + juce::String(numSamples) +
                              " samples starting at " + juce::String(startSample));
@@ -546,123 +756,228 @@ bool AudioBufferManager::trimToRange(int64_t startSample, int64_t numSamples)
 // Channel conversion
 
 bool AudioBufferManager::convertToStereo()
+{
+    return convertChannels(2, waveedit::ChannelLayoutType::Stereo);
+}
+
+bool AudioBufferManager::convertToMono()
+{
+    return convertChannels(1, waveedit::ChannelLayoutType::Mono);
+}
+
+bool AudioBufferManager::convertToChannelCount(int targetChannels)
+{
+    // Validate target channel count
+    if (targetChannels < 1 || targetChannels > 8)
+    {
+        DBG("AudioBufferManager: Invalid target channel count: " +
+                                 juce::String(targetChannels) + " (must be 1-8)");
+        return false;
+    }
+
+    return convertChannels(targetChannels, waveedit::ChannelLayoutType::Unknown);
+}
+
+bool AudioBufferManager::convertChannels(int targetChannels, waveedit::ChannelLayoutType layout)
 {
     juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
-    int currentChannels = m_buffer.getNumChannels();
+    const int currentChannels = m_store.getNumChannels();
 
-    // No-op if already stereo
-    if (currentChannels == 2)
+    // No-op if already at target count
+    if (currentChannels == targetChannels)
     {
-        DBG("AudioBufferManager: Buffer is already stereo, skipping conversion");
+        DBG("AudioBufferManager: Buffer already has " +
+                                 juce::String(targetChannels) + " channels, skipping conversion");
         return false;
     }
 
-    if (m_buffer.getNumSamples() == 0)
+    if (m_store.getNumSamples() == 0)
     {
-        DBG("AudioBufferManager: Empty buffer, skipping stereo conversion");
+        DBG("AudioBufferManager: Empty buffer, skipping channel conversion");
         return false;
     }
 
-    // Use ChannelConverter for generalized N-channel to stereo conversion
-    juce::AudioBuffer<float> stereoBuffer = waveedit::ChannelConverter::convert(
-        m_buffer, 2, waveedit::ChannelLayoutType::Stereo);
+    // Channel conversion mixes every frame, so it works on the flat buffer.
+    const auto& source = materializeFlatView(false);
+    if (source.getNumSamples() == 0)
+    {
+        juce::Logger::writeToLog("AudioBufferManager: document too long to convert "
+                                 "channels in one pass - conversion refused");
+        return false;
+    }
 
-    // Replace buffer
-    m_buffer = std::move(stereoBuffer);
+    // Use ChannelConverter for generalized N-channel conversion
+    juce::AudioBuffer<float> convertedBuffer = waveedit::ChannelConverter::convert(
+        source, targetChannels, layout);
+
+    // Adopt without copying. This releases the chunk the view referred to,
+    // so drop the view straight away.
+    m_store.adopt(std::move(convertedBuffer));
+    invalidateFlatView();
 
     DBG("AudioBufferManager: Converted " + juce::String(currentChannels) +
-                             " channels to stereo (" + juce::String(m_buffer.getNumSamples()) + " samples)");
+                             " channels to " + juce::String(targetChannels) +
+                             " channels (" + juce::String(m_store.getNumSamples()) + " samples)");
 
     return true;
 }
 
-bool AudioBufferManager::convertToMono()
+void AudioBufferManager::setBuffer(const juce::AudioBuffer<float>& newBuffer, double sampleRate)
 {
     juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
+
+    // assign() copies before releasing the old chunks, so newBuffer may be
+    // this manager's own getBuffer().
+    m_store.assign(newBuffer);
+    invalidateFlatView();
+    m_sampleRate = sampleRate;
+
+    DBG("AudioBufferManager: setBuffer with " +
+                             juce::String(m_store.getNumChannels()) + " channels, " +
+                             juce::String(m_store.getNumSamples()) + " samples");
+}
 
-    int currentChannels = m_buffer.getNumChannels();
+//==============================================================================
+// Flat view management
 
-    // No-op if already mono
-    if (currentChannels == 1)
+void AudioBufferManager::syncFlatViewIntoStore() const
+{
+    if (m_flatChunk != nullptr)
     {
-        DBG("AudioBufferManager: Buffer is already mono, skipping conversion");
-        return false;
+        // Still referring to the chunk we handed out: in-place writes already
+        // landed in the store.
+        if (m_buffer.getNumChannels() == m_flatChunk->getNumChannels()
+            && m_buffer.getNumSamples() == m_flatChunk->getNumSamples()
+            && m_buffer.getReadPointer(0) == m_flatChunk->getReadPointer(0))
+        {
+            return;
+        }
     }
-
-    if (m_buffer.getNumSamples() == 0)
+    else if (m_buffer.getNumSamples() == 0)
     {
-        DBG("AudioBufferManager: Empty buffer, skipping mono conversion");
-        return false;
+        // No view handed out since the last structural change.
+        return;
     }
 
-    // Use ChannelConverter for generalized N-channel to mono mixdown
-    juce::AudioBuffer<float> monoBuffer = waveedit::ChannelConverter::convert(
-        m_buffer, 1, waveedit::ChannelLayoutType::Mono);
-
-    // Replace buffer
-    m_buffer = std::move(monoBuffer);
-
-    DBG("AudioBufferManager: Converted " + juce::String(currentChannels) +
-                             " channels to mono (" + juce::String(m_buffer.getNumSamples()) + " samples)");
+    // A legacy caller resized or reassigned the buffer it got from
+    // getMutableBuffer(), so m_buffer now owns new storage. Take it over.
+    ++m_version;
+    m_flatChunk = nullptr;
+    m_store.adopt(std::move(m_buffer));
+    m_buffer = juce::AudioBuffer<float>();
+}
 
-    return true;
+bool AudioBufferManager::flatViewIsStoreChunk() const
+{
+    return m_flatChunk != nullptr && m_flatCopy == nullptr && m_store.isExclusivelyConsolidated();
 }
 
-bool AudioBufferManager::convertToChannelCount(int targetChannels)
+juce::AudioBuffer<float>& AudioBufferManager::materializeFlatView(bool forWriting) const
 {
-    juce::ScopedLock sl(m_lock);
+    syncFlatViewIntoStore();
 
-    // Validate target channel count
-    if (targetChannels < 1 || targetChannels > 8)
+    if (m_flatChunk != nullptr)
     {
-        DBG("AudioBufferManager: Invalid target channel count: " +
-                                 juce::String(targetChannels) + " (must be 1-8)");
-        return false;
+        if (! forWriting || flatViewIsStoreChunk())
+            return m_buffer;
+
+        // The view is a read-only copy, or a published snapshot shares its
+        // samples; writing through it would either miss the store or change
+        // audio that playback/rendering treat as immutable. Drop the view
+        // and re-materialise onto a private chunk below.
+        m_flatChunk = nullptr;
+        m_flatCopy = nullptr;
+        m_buffer = juce::AudioBuffer<float>();
     }
 
-    int currentChannels = m_buffer.getNumChannels();
+    AudioSampleStore::ChunkPtr chunk;
 
-    // No-op if already at target count
-    if (currentChannels == targetChannels)
+    if (forWriting)
     {
-        DBG("AudioBufferManager: Buffer already has " +
-                                 juce::String(targetChannels) + " channels, skipping conversion");
-        return false;
+        chunk = m_store.consolidateExclusive();
     }
-
-    if (m_buffer.getNumSamples() == 0)
+    else if (m_store.isConsolidated())
     {
-        DBG("AudioBufferManager: Empty buffer, skipping channel conversion");
-        return false;
+        // Already one float chunk: view it without copying.
+        chunk = m_store.consolidate();
     }
+    else if (! m_store.isEmpty()
+             && m_store.getNumSamples() <= static_cast<int64_t>(std::numeric_limits<int>::max()))
+    {
+        const int length = static_cast<int>(m_store.getNumSamples());
+        m_flatCopy = std::make_shared<juce::AudioBuffer<float>>(m_store.getNumChannels(), length);
+        if (! m_store.read(*m_flatCopy, 0, 0, length))
+            m_flatCopy = nullptr;
 
-    // Use ChannelConverter for generalized conversion
-    juce::AudioBuffer<float> convertedBuffer = waveedit::ChannelConverter::convert(
-        m_buffer, targetChannels);
+        chunk = m_flatCopy;
+    }
 
-    // Replace buffer
-    m_buffer = std::move(convertedBuffer);
+    // Start from a fresh buffer: setDataToReferTo() on a buffer that still
+    // owns memory would leak its contents into the new view.
+    m_buffer = juce::AudioBuffer<float>();
 
-    DBG("AudioBufferManager: Converted " + juce::String(currentChannels) +
-                             " channels to " + juce::String(targetChannels) +
-                             " channels (" + juce::String(m_buffer.getNumSamples()) + " samples)");
+    if (chunk == nullptr)
+    {
+        if (m_store.getNumSamples() > 0)
+        {
+            juce::Logger::writeToLog("AudioBufferManager: document exceeds INT_MAX samples - "
+                                     "whole-buffer access unavailable, use readRange()");
+        }
 
-    return true;
+        // Keep the channel count visible on an emptied document.
+        m_buffer.setSize(m_store.getNumChannels(), 0);
+        return m_buffer;
+    }
+
+    m_buffer.setDataToReferTo(chunk->getArrayOfWritePointers(),
+                              chunk->getNumChannels(),
+                              chunk->getNumSamples());
+    m_flatChunk = chunk.get();
+    return m_buffer;
 }
 
-void AudioBufferManager::setBuffer(const juce::AudioBuffer<float>& newBuffer, double sampleRate)
+void AudioBufferManager::invalidateFlatView() const
 {
-    juce::ScopedLock sl(m_lock);
+    ++m_version;
+    m_flatChunk = nullptr;
+    m_flatCopy = nullptr;
+    m_buffer = juce::AudioBuffer<float>();
+}
 
-    m_buffer.setSize(newBuffer.getNumChannels(), newBuffer.getNumSamples());
-    for (int ch = 0; ch < newBuffer.getNumChannels(); ++ch)
+bool AudioBufferManager::modifyFrames(int64_t startSample, int64_t numSamples, const FrameEditor& fn)
+{
+    if (flatViewIsStoreChunk())
     {
-        m_buffer.copyFrom(ch, 0, newBuffer, ch, 0, newBuffer.getNumSamples());
+        // Nothing else shares the view's samples, so write through it.
+        ++m_version;
+        fn(m_buffer, static_cast<int>(startSample), static_cast<int>(numSamples), startSample);
+        return true;
     }
-    m_sampleRate = sampleRate;
 
-    DBG("AudioBufferManager: setBuffer with " +
-                             juce::String(m_buffer.getNumChannels()) + " channels, " +
-                             juce::String(m_buffer.getNumSamples()) + " samples");
+    // Copy-on-write: only the edited range is copied; published snapshots
+    // keep the untouched original chunk.
+    invalidateFlatView();
+
+    const int numChannels = m_store.getNumChannels();
+    const int blockSize = static_cast<int>(juce::jmin<int64_t>(numSamples, AudioSampleStore::kChunkSamples));
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+
+    for (int64_t pos = startSample; pos < startSample + numSamples; pos += blockSize)
+    {
+        const int blockLength = static_cast<int>(juce::jmin<int64_t>(blockSize, startSample + numSamples - pos));
+        block.setSize(numChannels, blockLength, false, false, true);
+
+        if (! m_store.read(block, 0, pos, blockLength))
+            return false;
+
+        fn(block, 0, blockLength, pos);
+
+        if (! m_store.replace(pos, blockLength, block))
+            return false;
+    }
+
+    return true;
 }
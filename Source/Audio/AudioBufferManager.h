@@ -17,6 +17,11 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_audio_formats/juce_audio_formats.h>
+#include "AudioSampleStore.h"
+#include "AudioSnapshot.h"
+#include <functional>
+
+namespace waveedit { enum class ChannelLayoutType; }
 
 /**
  * Manages an editable audio buffer for sample-accurate editing operations.
@@ -25,6 +30,14 @@
  * - Sample-accurate cut, copy, paste, delete operations
  * - Converting between time and sample positions
  * - Getting audio data for specific ranges
+ *
+ * Storage is an AudioSampleStore piece table, so structural edits splice
+ * pieces instead of rebuilding the whole file, and documents may exceed
+ * INT_MAX samples. New code should read through readRange()/readChannelRange()
+ * and edit through the range operations, which split pieces and leave mapped
+ * or packed audio untouched. getBuffer() (a read-only flat copy) and
+ * getMutableBuffer() (which consolidates the store) remain for legacy
+ * whole-buffer callers.
  */
 class AudioBufferManager
 {
@@ -38,12 +51,41 @@ public:
     /**
      * Loads audio data from a file into the editable buffer.
      *
+     * Uncompressed WAV/AIFF files are memory-mapped rather than decoded: the
+     * OS pages samples in as they are read and only edited ranges are copied
+     * into float memory. Other formats are decoded into RAM, in their source
+     * PCM width where that is lossless (see AudioSampleStore::appendPacked).
+     *
      * @param file The audio file to load
      * @param formatManager The format manager to use for reading
      * @return true if successful, false otherwise
      */
     bool loadFromFile(const juce::File& file, juce::AudioFormatManager& formatManager);
 
+    /**
+     * The memory-mapping half of loadFromFile(): succeeds only for files that
+     * can be mapped, and never decodes. Callers that decode on a background
+     * thread (ProgressiveAudioLoader) try this first.
+     *
+     * @return false if the file cannot be mapped; the buffer is unchanged
+     */
+    bool loadMappedFile(const juce::File& file, juce::AudioFormatManager& formatManager);
+
+    /**
+     * Starts an incremental load: clears the document and sets its format.
+     * Decoded audio then arrives in file order through appendLoadedAudio().
+     */
+    void beginIncrementalLoad(double sampleRate, int bitDepth);
+
+    /**
+     * Appends decoded audio to the end of the document by sharing the
+     * block's pieces, which ProgressiveAudioLoader has already packed to the
+     * source width where lossless. O(pieces); no samples are touched.
+     *
+     * @return false if the channel count does not match earlier blocks
+     */
+    bool appendLoadedAudio(const AudioSampleStore& block);
+
     /**
      * Clears the buffer and resets all properties.
      */
@@ -56,6 +98,42 @@ public:
      */
     bool hasAudioData() const;
 
+    /**
+     * True while part of the document is still read from a memory-mapped
+     * source file (see loadFromFile). Edits only copy the ranges they touch,
+     * so this stays true until the whole file has been rewritten,
+     * getMutableBuffer() consolidates the store, or detachFromMappedFile().
+     */
+    bool isFileBacked() const;
+
+    /**
+     * Reads any still-mapped audio into RAM so the document no longer
+     * depends on its source file, e.g. before that file is overwritten.
+     * Snapshots published earlier keep their own mapping; republish after
+     * calling this.
+     *
+     * @return false if the mapped file could not be read; nothing changes
+     */
+    bool detachFromMappedFile();
+
+    /** RAM held by the samples; see AudioSampleStore::getResidentBytes(). */
+    int64_t getResidentBytes() const;
+
+    /**
+     * Writes the whole document to spillFile (32-bit float WAV) and then
+     * memory-maps it in place of the in-memory audio, releasing that RAM.
+     * Used to hibernate inactive tabs. The audio, sample rate, bit depth and
+     * edit version are unchanged; reads page the samples back in on demand.
+     * The file stays in use until the next load, clear(),
+     * detachFromMappedFile() or getMutableBuffer(), and published snapshots
+     * keep it mapped for as long as they live; check isFileBacked() before
+     * deleting it.
+     *
+     * @return false if the document is empty or the file could not be
+     *         written/mapped; the audio is then left in memory
+     */
+    bool spillToFile(const juce::File& spillFile);
+
     //==============================================================================
     // Audio properties
 
@@ -67,12 +145,12 @@ public:
     /**
      * Gets the number of channels.
      */
-    int getNumChannels() const { return m_buffer.getNumChannels(); }
+    int getNumChannels() const;
 
     /**
-     * Gets the total number of samples.
+     * Gets the total number of samples (64-bit; may exceed INT_MAX).
      */
-    int64_t getNumSamples() const { return m_buffer.getNumSamples(); }
+    int64_t getNumSamples() const;
 
     /**
      * Gets the total length in seconds.
@@ -107,15 +185,65 @@ public:
     // Buffer access
 
     /**
-     * Gets read-only access to the audio buffer.
+     * Copies a range of every channel into dest, starting at destStartSample.
+     * Costs O(numSamples) regardless of document length or edit history.
+     *
+     * @return false if the range is out of bounds or dest is too small
+     */
+    bool readRange(juce::AudioBuffer<float>& dest, int destStartSample,
+                   int64_t sourceStartSample, int numSamples) const;
+
+    /**
+     * Single-channel variant of readRange() for analysis (zero-crossing
+     * search, peak scans) that only needs one channel.
+     */
+    bool readChannelRange(int channel, float* dest,
+                          int64_t sourceStartSample, int numSamples) const;
+
+    /**
+     * Gets read-only access to the whole document as one contiguous buffer.
+     *
+     * Legacy path: the first call after an edit copies the pieces into one
+     * buffer (O(file length)) unless the document already is a single
+     * in-memory chunk; later calls are free. The piece table itself is left
+     * as it is, so memory-mapped and packed audio stay that way. The
+     * returned reference is invalidated by any edit, load, clear or channel
+     * conversion.
+     * Documents longer than INT_MAX samples cannot be flattened and yield an
+     * empty buffer; use readRange() instead.
      */
-    const juce::AudioBuffer<float>& getBuffer() const { return m_buffer; }
+    const juce::AudioBuffer<float>& getBuffer() const;
 
     /**
-     * Gets mutable access to the audio buffer for in-place operations.
+     * Gets mutable access to the whole document for in-place operations.
+     * Unlike getBuffer() this materialises the whole document as float in
+     * the store, mapped and packed pieces included; edits should use the
+     * range operations below instead, which split pieces. Same invalidation
+     * rules as getBuffer(). Resizing or
+     * reassigning the returned buffer is supported: the new contents are
+     * adopted into the store on the next call into this class.
+     *
+     * Counts as an edit. If a published snapshot still shares the samples,
+     * they are copied first so the snapshot stays unchanged; finish writing
+     * before calling getSnapshot() again.
      * WARNING: Use carefully and ensure thread safety.
      */
-    juce::AudioBuffer<float>& getMutableBuffer() { return m_buffer; }
+    juce::AudioBuffer<float>& getMutableBuffer();
+
+    /**
+     * Returns an immutable snapshot of the current audio to hand to playback
+     * (AudioEngine::loadFromSnapshot) and rendering
+     * (WaveformDisplay::reloadFromSnapshot). The snapshot is a copy of the
+     * piece list that shares the editor's chunks, so publishing costs
+     * O(pieces) and never flattens the document or copies samples. Repeated
+     * calls without an intervening edit return the same snapshot.
+     *
+     * @return nullptr if the document is empty
+     */
+    AudioSnapshotPtr getSnapshot() const;
+
+    /** Edit counter; changes whenever the audio may have changed. */
+    uint64_t getVersion() const;
 
     /**
      * Replaces the entire buffer with a new buffer.
@@ -156,6 +284,18 @@ public:
      */
     bool insertAudio(int64_t insertPosition, const juce::AudioBuffer<float>& audioToInsert);
 
+    /**
+     * Decodes a file and inserts it at insertPosition. The file is decoded
+     * in AudioSampleStore::kChunkSamples blocks before the lock is taken,
+     * so its length is not limited to INT_MAX and it is never held in one
+     * contiguous buffer. The file may be deleted afterwards.
+     *
+     * @return false if the file cannot be read or its channel count or
+     *         sample rate differ from the document's; nothing changes then
+     */
+    bool insertFromFile(int64_t insertPosition, const juce::File& file,
+                        juce::AudioFormatManager& formatManager);
+
     /**
      * Replaces a range with new audio data (deletes old range, inserts new data).
      *
@@ -212,6 +352,27 @@ public:
      */
     bool replaceChannelsInRange(int64_t startSample, const juce::AudioBuffer<float>& sourceAudio, int channelMask);
 
+    /**
+     * Edits a block of frames in place; see processRange(). Arguments are the
+     * block buffer, the block's first frame within it, its length, and the
+     * document position of that frame.
+     */
+    using FrameEditor = std::function<void(juce::AudioBuffer<float>&, int, int, int64_t)>;
+
+    /**
+     * Same-length modification of [startSample, startSample + numSamples),
+     * for per-sample processing (gain, fades, ...) that undo actions redo.
+     *
+     * Writes in place when the document is one chunk nobody else shares;
+     * otherwise copies the range out in blocks of at most
+     * AudioSampleStore::kChunkSamples, lets fn edit each block, and splices it
+     * back (copy-on-write), so the rest of the document -- including mapped
+     * and packed pieces -- is never flattened.
+     *
+     * @return false if the range is invalid or a block could not be read
+     */
+    bool processRange(int64_t startSample, int64_t numSamples, const FrameEditor& fn);
+
     /**
      * Trims audio to keep only the specified range (deletes everything outside).
      *
@@ -253,7 +414,54 @@ public:
     bool convertToChannelCount(int targetChannels);
 
 private:
-    juce::AudioBuffer<float> m_buffer;
+    /**
+     * Opens and maps a PCM WAV/AIFF file, or returns nullptr if the format
+     * cannot be memory-mapped.
+     */
+    static std::unique_ptr<juce::MemoryMappedAudioFormatReader> createMappedReader(
+        const juce::File& file, juce::AudioFormatManager& formatManager);
+
+    /** Shared body of the convertTo* methods. */
+    bool convertChannels(int targetChannels, waveedit::ChannelLayoutType layout);
+
+    /** Adopts m_buffer into the store if a legacy caller replaced its storage. */
+    void syncFlatViewIntoStore() const;
+
+    /** True if m_buffer is a writable view of the store's own single chunk. */
+    bool flatViewIsStoreChunk() const;
+
+    /**
+     * Points m_buffer at the whole document. Without forWriting the pieces
+     * are left alone: a store that is not already one chunk is copied into
+     * m_flatCopy. With forWriting the store itself is consolidated (the
+     * legacy materialising path), first moving off any chunk a published
+     * snapshot still shares.
+     */
+    juce::AudioBuffer<float>& materializeFlatView(bool forWriting) const;
+
+    /** Drops m_buffer's reference; called after every structural change. */
+    void invalidateFlatView() const;
+
+    /** Body of processRange(); the caller holds m_lock and has validated the range. */
+    bool modifyFrames(int64_t startSample, int64_t numSamples, const FrameEditor& fn);
+
+    // Authoritative sample storage.
+    mutable AudioSampleStore m_store;
+
+    // Lazily materialised contiguous view for getBuffer()/getMutableBuffer().
+    // Refers to (does not own) m_flatChunk's memory while the view is valid.
+    mutable juce::AudioBuffer<float> m_buffer;
+    mutable const juce::AudioBuffer<float>* m_flatChunk = nullptr;
+
+    // Read-only flattened copy behind getBuffer() when the store is not a
+    // single chunk. Kept beside the pieces rather than replacing them, so
+    // mapped and packed pieces survive a whole-buffer read.
+    mutable AudioSampleStore::ChunkPtr m_flatCopy;
+
+    // Bumped by every edit; stamps published snapshots.
+    mutable uint64_t m_version = 0;
+    mutable std::weak_ptr<const AudioSnapshot> m_publishedSnapshot;
+
     double m_sampleRate;
     int m_bitDepth;
     juce::CriticalSection m_lock;
@@ -14,6 +14,7 @@
 */
 
 #include "AudioEngine.h"
+#include "PlaybackMixer.h"
 #include "../Automation/AutomationManager.h"
 #include "../UI/SpectrumAnalyzer.h"
 #include "../UI/GraphicalEQEditor.h"
@@ -43,14 +44,13 @@ AudioEngine::AudioEngine()
     // Listen for transport source changes
     m_transportSource.addChangeListener(this);
 
-    // Initialize background thread for file loading
-    m_backgroundThread = std::make_unique<juce::TimeSliceThread>("Audio Loading Thread");
-    m_backgroundThread->startThread();
-
     // Create buffer sources (initially empty)
     m_bufferSource = std::make_unique<MemoryAudioSource>();
     m_previewBufferSource = std::make_unique<MemoryAudioSource>();
 
+    // Shared with the other engines; held so it runs for as long as we do
+    m_readAheadThread = PlaybackMixer::getInstance().acquireReadAheadThread();
+
     // Initialize dynamic parametric EQ processor (20-band, multiple filter types)
     m_dynamicEQ = std::make_unique<DynamicParametricEQ>();
 
@@ -66,6 +66,9 @@ AudioEngine::AudioEngine()
 
 AudioEngine::~AudioEngine()
 {
+    // Leave the shared mixer first so no device callback reaches a half-destroyed engine
+    PlaybackMixer::getInstance().removeVoice(this);
+
     // CRITICAL: Clear global preview pointer if it points to us
     // This prevents dangling pointer issues when an AudioEngine is destroyed
     // while in preview mode
@@ -75,12 +78,6 @@ AudioEngine::~AudioEngine()
         s_previewingEngine.store(nullptr);
     }
 
-    // Stop background thread
-    if (m_backgroundThread)
-    {
-        m_backgroundThread->stopThread(1000);
-    }
-
     // Clean up
     m_transportSource.removeChangeListener(this);
     m_transportSource.setSource(nullptr);
@@ -92,34 +89,13 @@ AudioEngine::~AudioEngine()
 
 bool AudioEngine::initializeAudioDevice()
 {
-    // Set up audio device with default settings
-    // This will use the system's default audio output device
-    juce::String audioError = m_deviceManager.initialise(
-        0,      // Number of input channels (0 for playback only - recording in future release)
-        2,      // Number of output channels (stereo)
-        nullptr, // No saved state to restore
-        true,    // Select default device if possible
-        {},      // Preferred default device name
-        nullptr  // Preferred setup options
-    );
-
-    if (audioError.isNotEmpty())
-    {
-        // Initialization failed
-        return false;
-    }
-
-    // Add this audio engine as the audio callback
-    m_deviceManager.addAudioCallback(this);
+    // The device itself is opened once by the application; every engine is a
+    // voice in the shared mixer, so opening a document never touches the device.
+    PlaybackMixer::getInstance().addVoice(this);
 
     return true;
 }
 
-juce::AudioDeviceManager& AudioEngine::getDeviceManager()
-{
-    return m_deviceManager;
-}
-
 juce::AudioFormatManager& AudioEngine::getFormatManager()
 {
     return m_formatManager;
@@ -143,8 +119,20 @@ bool AudioEngine::loadAudioFile(const juce::File& file)
     m_transportSource.setSource(nullptr);
     m_readerSource.reset();
 
-    // Create a reader for the audio file
-    auto* reader = m_formatManager.createReaderFor(file);
+    // Create a reader for the audio file. PCM WAV/AIFF is read through a
+    // memory map so playback shares OS page cache with the editor's mapped
+    // copy (AudioBufferManager::loadFromFile) instead of buffering its own.
+    juce::AudioFormatReader* reader = nullptr;
+
+    if (auto* format = m_formatManager.findFormatForFileExtension(file.getFileExtension()))
+    {
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+        if (mapped != nullptr && mapped->lengthInSamples > 0 && mapped->mapEntireFile())
+            reader = mapped.release();
+    }
+
+    if (reader == nullptr)
+        reader = m_formatManager.createReaderFor(file);
 
     if (reader == nullptr)
     {
@@ -171,7 +159,7 @@ bool AudioEngine::loadAudioFile(const juce::File& file)
     m_transportSource.setSource(
         m_readerSource.get(),
         0,                      // Buffer size to use (0 = default)
-        m_backgroundThread.get(), // Background thread for non-blocking loading
+        m_readAheadThread.get(), // Shared read-ahead thread
         m_sampleRate,           // Sample rate of the reader
         m_numChannels           // Number of channels
     );
@@ -190,55 +178,26 @@ bool AudioEngine::loadAudioFile(const juce::File& file)
 
 bool AudioEngine::loadFromBuffer(const juce::AudioBuffer<float>& buffer, double sampleRate, int numChannels)
 {
-    // IMPORTANT: This method must only be called from the message thread
-    // It performs memory allocation and modifies the transport source
-    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
-
-    // Validate buffer
-    if (buffer.getNumSamples() == 0 || buffer.getNumChannels() == 0)
+    if (buffer.getNumSamples() == 0 || buffer.getNumChannels() == 0 || numChannels != buffer.getNumChannels())
     {
         return false;
     }
 
-    // Validate channel count matches buffer
-    if (numChannels != buffer.getNumChannels())
-    {
-        return false;
-    }
+    // Deep copy: the caller keeps ownership of 'buffer'.
+    juce::AudioBuffer<float> copy;
+    copy.makeCopyOf(buffer);
+    return loadFromSnapshot(AudioSnapshot::fromBuffer(std::move(copy), sampleRate));
+}
 
-    // Validate sample rate is in reasonable range
-    if (sampleRate <= 0.0 || sampleRate < 8000.0 || sampleRate > 192000.0)
-    {
-        return false;
-    }
+bool AudioEngine::loadFromSnapshot(const AudioSnapshotPtr& snapshot)
+{
+    // IMPORTANT: This method must only be called from the message thread
+    // It performs memory allocation and modifies the transport source
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
 
-    // H7 FIX: a full O(N) NaN/Inf scan here froze the message thread for seconds
-    // on long files (a 1-hr 96k stereo file is ~690M samples), violating the §9
-    // load-time budget. reloadBufferPreservingPlayback() never did this scan, so
-    // the check was also asymmetric. We now sample a bounded subset (head, tail,
-    // and an even stride across the buffer) so the cost is O(1) regardless of
-    // length while still catching whole-buffer corruption. Per-sample DSP paths
-    // are responsible for not introducing NaN/Inf, so a probabilistic check is
-    // an adequate safety net here.
+    if (snapshot == nullptr || ! isPlayableSnapshot(*snapshot, true))
     {
-        constexpr int maxProbesPerChannel = 4096;
-        const int numSamples = buffer.getNumSamples();
-        const int stride = juce::jmax(1, numSamples / maxProbesPerChannel);
-
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            const float* data = buffer.getReadPointer(ch);
-
-            // Always check the very first and last sample, then a strided subset.
-            if (numSamples > 0 && (!std::isfinite(data[0]) || !std::isfinite(data[numSamples - 1])))
-                return false;
-
-            for (int i = 0; i < numSamples; i += stride)
-            {
-                if (!std::isfinite(data[i]))
-                    return false;
-            }
-        }
+        return false;
     }
 
     // Stop playback before switching sources
@@ -249,8 +208,8 @@ bool AudioEngine::loadFromBuffer(const juce::AudioBuffer<float>& buffer, double
     m_readerSource.reset();
 
     // Store audio properties (thread-safe atomic stores)
-    m_sampleRate.store(sampleRate);
-    m_numChannels.store(numChannels);
+    m_sampleRate.store(snapshot->getSampleRate());
+    m_numChannels.store(snapshot->getNumChannels());
 
     // Set bit depth to 32-bit float for buffer playback
     // (AudioBuffer<float> is always 32-bit float internally)
@@ -267,51 +226,143 @@ bool AudioEngine::loadFromBuffer(const juce::AudioBuffer<float>& buffer, double
         return false;
     }
 
-    // Set the buffer in our memory source
-    m_bufferSource->setBuffer(buffer, sampleRate);
+    // Set the snapshot in our memory source (pointer swap, no copy)
+    m_bufferSource->setSnapshot(snapshot);
+    connectBufferSource(*snapshot);
 
-    // Connect the buffer source to the transport source
-    // Verify the buffer source pointer is valid before using it
-    if (m_bufferSource.get() == nullptr)
+    // Switch to buffer playback mode
+    m_isPlayingFromBuffer.store(true);
+
+    // H7: recompute the surround fold-down matrix for the new channel count.
+    rebuildFoldDownMatrix();
+
+    return true;
+}
+
+bool AudioEngine::isPlayableSnapshot(const AudioSnapshot& snapshot, bool probeSamples)
+{
+    // Validate audio
+    if (snapshot.getNumSamples() == 0 || snapshot.getNumChannels() == 0)
     {
         return false;
     }
 
-    m_transportSource.setSource(
-        m_bufferSource.get(),
-        0,                      // Buffer size to use (0 = default)
-        nullptr,                // No background thread needed for memory buffer
-        sampleRate,             // Sample rate
-        numChannels             // Number of channels
-    );
+    // Validate sample rate is in reasonable range
+    const double sampleRate = snapshot.getSampleRate();
+    if (sampleRate <= 0.0 || sampleRate < 8000.0 || sampleRate > 192000.0)
+    {
+        return false;
+    }
 
-    // Switch to buffer playback mode
-    m_isPlayingFromBuffer.store(true);
+    if (! probeSamples)
+    {
+        return true;
+    }
 
-    // H7: recompute the surround fold-down matrix for the new channel count.
-    rebuildFoldDownMatrix();
+    // H7 FIX: a full O(N) NaN/Inf scan here froze the message thread for seconds
+    // on long files (a 1-hr 96k stereo file is ~690M samples), violating the §9
+    // load-time budget. reloadBufferPreservingPlayback() never did this scan, so
+    // the check was also asymmetric (it still only runs on load). We now sample a bounded subset (head, tail,
+    // and an even stride across the audio) so the cost is O(1) regardless of
+    // length while still catching whole-buffer corruption. Per-sample DSP paths
+    // are responsible for not introducing NaN/Inf, so a probabilistic check is
+    // an adequate safety net here.
+    constexpr int64_t maxProbesPerChannel = 4096;
+    const int64_t numSamples = snapshot.getNumSamples();
+    const int64_t stride = juce::jmax<int64_t>(1, numSamples / maxProbesPerChannel);
+
+    for (int ch = 0; ch < snapshot.getNumChannels(); ++ch)
+    {
+        // Always check the very last sample, then a strided subset from the first.
+        float value = 0.0f;
+        if (! snapshot.readChannelRange(ch, &value, numSamples - 1, 1) || ! std::isfinite(value))
+            return false;
+
+        for (int64_t i = 0; i < numSamples; i += stride)
+        {
+            if (! snapshot.readChannelRange(ch, &value, i, 1) || ! std::isfinite(value))
+                return false;
+        }
+    }
 
     return true;
 }
 
+void AudioEngine::connectBufferSource(const AudioSnapshot& snapshot)
+{
+    // Mapped audio may page-fault, which must not happen on the audio
+    // thread, so it is read ahead; RAM-resident audio is read directly.
+    constexpr int kReadAheadSamples = 32768;
+    m_bufferSourceReadsAhead = snapshot.isFileBacked();
+
+    m_transportSource.setSource(
+        m_bufferSource.get(),
+        m_bufferSourceReadsAhead ? kReadAheadSamples : 0,
+        m_bufferSourceReadsAhead ? m_readAheadThread.get() : nullptr,
+        snapshot.getSampleRate(),
+        snapshot.getNumChannels()
+    );
+}
+
 bool AudioEngine::reloadBufferPreservingPlayback(const juce::AudioBuffer<float>& buffer, double sampleRate, int numChannels)
 {
-    // IMPORTANT: This method must only be called from the message thread
+    if (buffer.getNumSamples() == 0 || buffer.getNumChannels() == 0 || numChannels != buffer.getNumChannels())
+    {
+        return false;
+    }
+
+    // Deep copy: the caller keeps ownership of 'buffer'.
+    juce::AudioBuffer<float> copy;
+    copy.makeCopyOf(buffer);
+    return reloadSnapshotPreservingPlayback(AudioSnapshot::fromBuffer(std::move(copy), sampleRate));
+}
+
+bool AudioEngine::applyEditedSnapshot(const AudioSnapshotPtr& snapshot, const AudioEditRange& range)
+{
     jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
 
-    // Validate buffer
-    if (buffer.getNumSamples() == 0 || buffer.getNumChannels() == 0)
+    if (snapshot == nullptr)
     {
         return false;
     }
 
-    // Validate channel count and sample rate
-    if (numChannels != buffer.getNumChannels())
+    const bool canHotSwap = m_isPlayingFromBuffer.load()
+                            && m_bufferSource != nullptr
+                            && m_bufferSource->getTotalLength() == snapshot->getNumSamples() - range.getLengthDelta()
+                            && m_numChannels.load() == snapshot->getNumChannels()
+                            && m_sampleRate.load() == snapshot->getSampleRate()
+                            && m_bufferSourceReadsAhead == snapshot->isFileBacked();
+
+    if (! canHotSwap)
     {
-        return false;
+        return reloadSnapshotPreservingPlayback(snapshot);
     }
 
-    if (sampleRate <= 0.0 || sampleRate < 8000.0 || sampleRate > 192000.0)
+    // Same layout: samples outside the range are identical (only shifted by
+    // the length delta), so the transport keeps reading across the swap.
+    if (! m_bufferSourceReadsAhead)
+    {
+        m_bufferSource->setEditedSnapshot(snapshot, range);
+        return true;
+    }
+
+    // Behind the read-ahead buffer the source's position runs ahead of what
+    // is audible. Remap the transport's position instead and re-seek, which
+    // also drops audio read ahead before the edit.
+    const double sampleRate = snapshot->getSampleRate();
+    const auto heard = static_cast<int64_t>(m_transportSource.getCurrentPosition() * sampleRate);
+    m_bufferSource->setEditedSnapshot(snapshot, range);
+    m_transportSource.setPosition(static_cast<double>(range.remapPosition(heard)) / sampleRate);
+
+    return true;
+}
+
+bool AudioEngine::reloadSnapshotPreservingPlayback(const AudioSnapshotPtr& snapshot)
+{
+    // IMPORTANT: This method must only be called from the message thread
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    if (snapshot == nullptr || ! isPlayableSnapshot(*snapshot, false))
     {
         return false;
     }
@@ -322,17 +373,21 @@ bool AudioEngine::reloadBufferPreservingPlayback(const juce::AudioBuffer<float>&
     const bool   wasPlaying      = isPlaying();
     const double currentPosition = getCurrentPosition();
 
-    // CRITICAL: Disconnect transport before updating buffer
+    // CRITICAL: Disconnect transport before updating the snapshot
     // This flushes AudioTransportSource's internal buffers so it will read fresh audio
     // after reconnecting. Without this, the transport continues playing cached audio
     // from the old buffer even after we update it.
     m_transportSource.setSource(nullptr);
 
-    // Update buffer in memory source (this is thread-safe with the lock in setBuffer)
+    // Playback now comes from the snapshot; release the file reader (and its
+    // memory map, if any) so the source file is no longer held open.
+    m_readerSource.reset();
+
+    // Update the memory source (pointer swap under its lock).
     // Don't pass preservePosition - we'll manage position via transport reconnect
     if (m_bufferSource)
     {
-        m_bufferSource->setBuffer(buffer, sampleRate, false);
+        m_bufferSource->setSnapshot(snapshot, false);
     }
     else
     {
@@ -340,23 +395,18 @@ bool AudioEngine::reloadBufferPreservingPlayback(const juce::AudioBuffer<float>&
     }
 
     // Reconnect transport to buffer source with updated audio
-    // This forces fresh audio to be read from the new buffer
-    m_transportSource.setSource(
-        m_bufferSource.get(),
-        0,                      // Buffer size to use (0 = default)
-        nullptr,                // No background thread needed for memory buffer
-        sampleRate,             // Sample rate
-        numChannels             // Number of channels
-    );
+    // This forces fresh audio to be read from the new snapshot
+    connectBufferSource(*snapshot);
 
     // Update stored properties
+    const double sampleRate = snapshot->getSampleRate();
     m_sampleRate.store(sampleRate);
-    m_numChannels.store(numChannels);
+    m_numChannels.store(snapshot->getNumChannels());
     m_isPlayingFromBuffer.store(true);
 
-    // Restore position (clamped to the new buffer length in case the edit
+    // Restore position (clamped to the new length in case the edit
     // shortened it). Always do this so paused edits don't snap to 0.
-    const double newLength       = buffer.getNumSamples() / sampleRate;
+    const double newLength       = static_cast<double>(snapshot->getNumSamples()) / sampleRate;
     const double clampedPosition = juce::jmin(currentPosition, newLength);
     m_transportSource.setPosition(clampedPosition);
 
@@ -370,6 +420,23 @@ bool AudioEngine::reloadBufferPreservingPlayback(const juce::AudioBuffer<float>&
     return true;
 }
 
+void AudioEngine::releasePlaybackBuffer()
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    if (!m_isPlayingFromBuffer.load())
+    {
+        return;
+    }
+
+    stop();
+
+    // Disconnect first so the transport cannot read the buffer while it is
+    // being released.
+    m_transportSource.setSource(nullptr);
+    m_bufferSource->clear();
+}
+
 void AudioEngine::closeAudioFile()
 {
     // Stop playback
@@ -807,6 +874,10 @@ void AudioEngine::audioDeviceIOCallbackWithContext(const float* const* /*inputCh
         m_transportSource.getNextAudioBlock(channelInfo);
     }
 
+    // Transport position just past this block, before any loop wrap below
+    // moves it. Plugin automation is scheduled from the block's start.
+    const double blockEndPosition = m_transportSource.getCurrentPosition();
+
     //==============================================================================
     // LOOP POINT HANDLING: Sample-accurate loop point checking
     // If loop points are set and we've passed the loop end, either loop back or stop
@@ -879,24 +950,40 @@ void AudioEngine::audioDeviceIOCallbackWithContext(const float* const* /*inputCh
         buffer.copyFrom(1, 0, buffer, 0, 0, numSamples);
     }
 
-    //==============================================================================
-    // PLUGIN PARAMETER AUTOMATION: Apply automation curves before plugin processing
-    // Lock-free: reads from each AutomationCurve's atomic point list.
-    if (m_automationManager != nullptr && m_pluginChainEnabled.load())
-    {
-        double currentPos = m_transportSource.getCurrentPosition();
-        m_automationManager->applyAutomation(m_pluginChain, currentPos);
-    }
-
     //==============================================================================
     // VST3/AU PLUGIN CHAIN: Real-time effect processing (Soundminer-style monitoring)
     // This runs ALWAYS during playback when enabled, not just in preview mode.
     // Enables professional real-time plugin monitoring - users can hear effects
     // while the chain panel is open and plugins are enabled (checked).
     // Plugin chain uses SpinLock for thread-safe audio processing.
+    //
+    // PLUGIN PARAMETER AUTOMATION is applied before each slice of the chain:
+    // applyAutomation() returns how far the current values hold (next
+    // breakpoint, or a short ramp step), and the block is split there so
+    // automation does not step once per device buffer. Slices refer into the
+    // output buffer; nothing is allocated. Lock-free curve reads.
     if (m_pluginChainEnabled.load() && !m_pluginChain.isEmpty())
     {
-        m_pluginChain.processBlock(buffer, m_emptyMidiBuffer);
+        if (m_automationManager != nullptr)
+        {
+            const double deviceRate = m_deviceSampleRate.load();
+            const double blockStart = juce::jmax(0.0, blockEndPosition - numSamples / deviceRate);
+
+            for (int done = 0; done < numSamples;)
+            {
+                const int sliceLength = m_automationManager->applyAutomation(
+                    m_pluginChain, blockStart + done / deviceRate, deviceRate, numSamples - done);
+
+                juce::AudioBuffer<float> slice(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                               done, sliceLength);
+                m_pluginChain.processBlock(slice, m_emptyMidiBuffer);
+                done += sliceLength;
+            }
+        }
+        else
+        {
+            m_pluginChain.processBlock(buffer, m_emptyMidiBuffer);
+        }
     }
 
     //==============================================================================
@@ -916,43 +1003,11 @@ void AudioEngine::audioDeviceIOCallbackWithContext(const float* const* /*inputCh
         // 3. EQ (frequency shaping)
         // 4. Fade (final envelope)
         // 5. Preview plugin instance (for OfflinePluginDialog)
+        //
+        // 1-4 run as one fused pass over the block; see processRealtimePreview().
+        processRealtimePreview(buffer);
 
-        // 1. Apply DC Offset removal if enabled
-        double sampleRate = m_sampleRate.load();
-        if (sampleRate > 0)
-        {
-            m_dcOffsetProcessor.process(buffer, sampleRate);
-        }
-
-        // 2. Apply gain processor (for Gain dialog)
-        m_gainProcessor.process(buffer);
-
-        // 3. Apply normalize processor (for Normalize dialog)
-        m_normalizeProcessor.process(buffer);
-
-        // 5c. Apply dynamic parametric EQ if enabled (20-band, multiple filter
-        // types). Same C1 contract: every mutator builds coefficients on the
-        // message thread under the EQ's own lock; applyEQ() only processes.
-        if (m_dynamicEQEnabled.get() && m_dynamicEQ)
-        {
-            m_dynamicEQ->applyEQ(buffer);
-        }
-
-        // 6. Apply fade processor last (affects overall envelope).
-        // Position-driven: feed the current transport position within the fade
-        // span (file samples) + the file-samples-per-output-sample ratio, so the
-        // fade is rate-independent and re-aligns on each loop wrap. (sampleRate
-        // here is the FILE rate, m_sampleRate.)
-        if (sampleRate > 0)
-        {
-            const double deviceRate = m_deviceSampleRate.load();
-            const double posSec = m_transportSource.getCurrentPosition() - m_previewRegionStartSec.load();
-            const double posFileSamples = juce::jmax(0.0, posSec) * sampleRate;
-            const double fileSamplesPerOutputSample = (deviceRate > 0.0) ? (sampleRate / deviceRate) : 1.0;
-            m_fadeProcessor.process(buffer, posFileSamples, fileSamplesPerOutputSample);
-        }
-
-        // 7. Apply preview plugin instance (for OfflinePluginDialog real-time preview)
+        // 5. Apply preview plugin instance (for OfflinePluginDialog real-time preview)
         // This allows plugins like FabFilter Pro-Q 4 to receive audio and display
         // their visualizations (spectrum, waveform, etc.) during preview.
         //
@@ -20,8 +20,10 @@
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_dsp/juce_dsp.h>
+#include "AudioSnapshot.h"
 #include "ChannelLayout.h"
 #include "../DSP/DynamicParametricEQ.h"
+#include "../DSP/TimePitchEngine.h"
 #include "../Plugins/PluginChain.h"
 
 /**
@@ -43,25 +45,27 @@ enum class PlaybackState
  * Architecture:
  * - DISABLED: Normal playback from main or preview buffer (no DSP)
  * - REALTIME_DSP: Real-time effects via ProcessorChain (EQ, Gain, Fade)
- * - OFFLINE_BUFFER: Pre-rendered preview buffer (Normalize, Time Stretch)
+ * - OFFLINE_BUFFER: Preview-owned source played from 0 -- a pre-rendered buffer
+ *   (Normalize, Head & Tail) or the streaming time-stretch / pitch-shift source
  */
 enum class PreviewMode
 {
     DISABLED,        // No preview, play main buffer
     REALTIME_DSP,    // Preview via ProcessorChain (instant, no latency)
-    OFFLINE_BUFFER   // Preview via pre-rendered buffer (for heavy effects)
+    OFFLINE_BUFFER   // Preview via a preview-owned source (heavy or length-changing effects)
 };
 
 /**
  * Core audio engine for WaveEdit.
  *
- * Handles audio playback, transport control, and device management.
+ * Handles one document's playback and transport control. The engine does
+ * not own an audio device: it is a voice in the process-wide PlaybackMixer,
+ * which renders every open document's engine into the application's device.
  * This class is thread-safe and designed for real-time audio processing.
  *
  * Key features:
  * - Playback control (play, pause, stop)
  * - Transport source management
- * - Audio device configuration
  * - State machine for playback states
  */
 class AudioEngine : public juce::ChangeListener,
@@ -75,20 +79,14 @@ public:
     // Device Management
 
     /**
-     * Initializes the audio device manager with default settings.
-     * Should be called during application startup.
+     * Registers this engine as a voice in the shared PlaybackMixer. The
+     * engine is prepared for the running device, if any, and removed again
+     * on destruction.
      *
      * @return true if initialization succeeded, false otherwise
      */
     bool initializeAudioDevice();
 
-    /**
-     * Gets the audio device manager for configuration.
-     *
-     * @return Reference to the audio device manager
-     */
-    juce::AudioDeviceManager& getDeviceManager();
-
     /**
      * Gets the audio format manager for file format support.
      *
@@ -132,6 +130,38 @@ public:
      */
     bool reloadBufferPreservingPlayback(const juce::AudioBuffer<float>& buffer, double sampleRate, int numChannels);
 
+    /**
+     * As loadFromBuffer(), but plays directly from the document's published
+     * snapshot instead of copying it. Use this for document audio: the
+     * editor, playback and waveform then share one copy of the samples.
+     */
+    bool loadFromSnapshot(const AudioSnapshotPtr& snapshot);
+
+    /**
+     * As reloadBufferPreservingPlayback(), but swaps in the snapshot without
+     * copying; the cost no longer depends on the file length.
+     */
+    bool reloadSnapshotPreservingPlayback(const AudioSnapshotPtr& snapshot);
+
+    /**
+     * Swaps in the snapshot after an edit that changed only range. An edit
+     * of the buffer already playing is hot-swapped under the running
+     * transport: no stop, no disconnect. When the edit inserted or removed
+     * samples the play position is remapped through range
+     * (AudioEditRange::remapPosition()), so playback carries on with the
+     * same material. Layout changes and file playback fall back to
+     * reloadSnapshotPreservingPlayback().
+     */
+    bool applyEditedSnapshot(const AudioSnapshotPtr& snapshot, const AudioEditRange& range);
+
+    /**
+     * Stops playback and drops the in-memory playback buffer (document
+     * hibernation). Buffer mode and the current file are kept, so the
+     * engine still reports edited audio; reload with
+     * reloadSnapshotPreservingPlayback() before playing again.
+     */
+    void releasePlaybackBuffer();
+
     /**
      * Closes the currently loaded audio file and releases resources.
      */
@@ -356,7 +386,7 @@ public:
      *
      * DISABLED: Normal playback (no DSP)
      * REALTIME_DSP: Apply ProcessorChain effects in real-time (EQ, Gain, Fade)
-     * OFFLINE_BUFFER: Play pre-rendered preview buffer (Normalize, Time Stretch)
+     * OFFLINE_BUFFER: Play a preview-owned buffer or stream (Normalize, Time Stretch)
      *
      * IMPORTANT: Only one AudioEngine can be in preview mode at a time across
      * all open documents. When an engine enters preview mode, all other engines
@@ -470,6 +500,19 @@ public:
     bool startBufferPreview(const juce::AudioBuffer<float>& buffer, double sampleRate,
                             int numChannels, bool loop, double fileOffsetSeconds = 0.0);
 
+    /** Start a streaming time-stretch / pitch-shift preview of buffer. SoundTouch
+        runs block by block in the audio callback (OFFLINE_BUFFER mode, playing
+        from 0), so nothing is rendered up front and setTimePitchPreview() is
+        heard from the next audio block. Looping wraps inside the excerpt.
+        Returns false if the buffer is empty. Message thread only. */
+    bool startTimePitchPreview(const juce::AudioBuffer<float>& buffer, double sampleRate,
+                               int numChannels, bool loop, double fileOffsetSeconds,
+                               const TimePitchEngine::Recipe& recipe);
+
+    /** Change the recipe of a running time-stretch / pitch-shift preview. An
+        identity recipe plays the excerpt unprocessed (Bypass). Message thread only. */
+    void setTimePitchPreview(const TimePitchEngine::Recipe& recipe);
+
     /** Stop any preview, disable all preview effects, and restore normal
         playback. Idempotent. Message thread only. */
     void stopSelectionPreview();
@@ -740,7 +783,7 @@ private:
     // Private Helper Classes
 
     /**
-     * Memory-based audio source that plays from an AudioBuffer.
+     * Audio source that plays from a published AudioSnapshot.
      * This is used for playback of edited audio.
      */
     class MemoryAudioSource : public juce::PositionableAudioSource
@@ -750,6 +793,17 @@ private:
         ~MemoryAudioSource() override;
 
         void setBuffer(const juce::AudioBuffer<float>& buffer, double sampleRate, bool preservePosition = false);
+
+        /** Plays from a snapshot without copying it (pointer swap). */
+        void setSnapshot(AudioSnapshotPtr snapshot, bool preservePosition = false);
+
+        /**
+         * As setSnapshot(), for a snapshot that differs from the current one
+         * only by range. The read position is remapped through the range in
+         * the same locked step as the swap, so the audio thread never reads
+         * the new audio at an old position.
+         */
+        void setEditedSnapshot(AudioSnapshotPtr snapshot, const AudioEditRange& range);
         void clear();
 
         // PositionableAudioSource implementation
@@ -763,17 +817,15 @@ private:
         void setLooping(bool shouldLoop) override;
 
     private:
-        // H20/L1/M-H1 FIX: the playback buffer is held behind a shared_ptr that
+        // H20/L1/M-H1 FIX: the playback audio is held behind a shared_ptr that
         // is swapped by the message thread. setBuffer()/clear() perform the
-        // expensive deep makeCopyOf and the old-buffer free OFF-lock, holding
+        // expensive deep makeCopyOf and the old-snapshot free OFF-lock, holding
         // m_lock only for the pointer swap. The audio thread reads via a
         // ScopedTryLock and dereferences the RAW pointer inside the locked scope
         // -- no blocking (skips to silence on contention) and no shared_ptr
         // refcount traffic on the audio thread (§6.4).
-        using BufferPtr = std::shared_ptr<const juce::AudioBuffer<float>>;
-        BufferPtr m_buffer;                      // guarded by m_lock (pointer swap only)
-        std::atomic<juce::int64> m_bufferLength{0};  // mirrors m_buffer length for lock-free reads
-        double m_sampleRate;
+        AudioSnapshotPtr m_snapshot;                 // guarded by m_lock (pointer swap only)
+        std::atomic<juce::int64> m_bufferLength{0};  // mirrors m_snapshot length for lock-free reads
         std::atomic<juce::int64> m_readPosition;
         bool m_isLooping;
         juce::CriticalSection m_lock;
@@ -784,16 +836,16 @@ private:
     //==============================================================================
     // Private Members
 
-    juce::AudioDeviceManager m_deviceManager;
     juce::AudioFormatManager m_formatManager;
+    std::shared_ptr<juce::TimeSliceThread> m_readAheadThread;  // Declared first: outlives the transport
     juce::AudioTransportSource m_transportSource;
 
     std::unique_ptr<juce::AudioFormatReaderSource> m_readerSource;
     std::unique_ptr<MemoryAudioSource> m_bufferSource;
-    std::unique_ptr<juce::TimeSliceThread> m_backgroundThread;
 
     std::atomic<PlaybackState> m_playbackState;
     std::atomic<bool> m_isPlayingFromBuffer;
+    bool m_bufferSourceReadsAhead = false;  // message thread: m_bufferSource is behind a BufferingAudioSource
     std::atomic<bool> m_isLooping;
     std::atomic<double> m_loopStartTime;  // Loop start in seconds (-1 = disabled)
     std::atomic<double> m_loopEndTime;    // Loop end in seconds
@@ -862,23 +914,24 @@ private:
     // Allows A/B comparison between processed and unprocessed audio
     std::atomic<bool> m_previewBypassed{false};
 
-    // Preview buffer for offline effects (Normalize, Time Stretch, etc.)
+    // Preview buffer for offline effects (Normalize, Head & Tail, etc.)
     std::unique_ptr<MemoryAudioSource> m_previewBufferSource;
 
-    // Real-time DSP chain for instant preview (EQ, Gain, Fade)
-    // Simple gain processor for Phase 1 (will expand to ProcessorChain in Phase 2)
+    // Streaming time-stretch / pitch-shift preview (startTimePitchPreview)
+    std::unique_ptr<TimePitchEngine::StreamingSource> m_timePitchSource;
+
+    // Real-time DSP chain for instant preview (EQ, Gain, Fade).
+    // The processors below only hold parameters and per-channel state; the
+    // audio thread runs them as one fused pass (processRealtimePreview()).
     struct GainProcessor
     {
         std::atomic<float> gainDB{0.0f};
         std::atomic<bool> enabled{false};
 
-        void process(juce::AudioBuffer<float>& buffer)
+        /** Linear multiplier this stage contributes (1 when disabled). */
+        float getLinearGain() const
         {
-            if (enabled.load())
-            {
-                float gainLinear = juce::Decibels::decibelsToGain(gainDB.load());
-                buffer.applyGain(gainLinear);
-            }
+            return enabled.load() ? juce::Decibels::decibelsToGain(gainDB.load()) : 1.0f;
         }
     };
 
@@ -890,11 +943,10 @@ private:
         std::atomic<float> gainDB{0.0f};
         std::atomic<bool> enabled{false};
 
-        void process(juce::AudioBuffer<float>& buffer)
+        /** Linear multiplier this stage contributes (1 when disabled). */
+        float getLinearGain() const
         {
-            if (!enabled.load()) return;
-            float gain = juce::Decibels::decibelsToGain(gainDB.load());
-            buffer.applyGain(gain);
+            return enabled.load() ? juce::Decibels::decibelsToGain(gainDB.load()) : 1.0f;
         }
     };
     NormalizeProcessor m_normalizeProcessor;
@@ -913,27 +965,38 @@ private:
         std::atomic<int>   curveType{0};               // 0=Lin,1=Log,2=Exp,3=S-Curve
         std::atomic<float> fadeDurationSamples{0.0f};  // span length, FILE samples
 
-        void process(juce::AudioBuffer<float>& buffer,
-                     double posAtBlockStartFileSamples,
-                     double fileSamplesPerOutputSample)
+        bool isActive() const
         {
-            if (!enabled.load()) return;
+            // An instantaneous fade is unity -> no-op
+            return enabled.load() && fadeDurationSamples.load() > 0.0f;
+        }
 
+        /**
+         * Fills ramp[0..numSamples) with gain * fade gain, one entry per output
+         * sample, so the kernel can apply it to every channel with one vector
+         * multiply. Past the end of the span the fade is constant; then nothing
+         * is written, constantGain receives the product and this returns false.
+         */
+        bool renderRamp(float* ramp, int numSamples,
+                        double posAtStartFileSamples, double fileSamplesPerOutputSample,
+                        float gain, float& constantGain) const
+        {
             const double duration = fadeDurationSamples.load();
-            if (duration <= 0.0) return;   // instantaneous fade -> unity, no-op
+            const bool   isFadeIn = fadeIn.load();
+            const int    curve    = curveType.load();
 
-            const int  numSamples  = buffer.getNumSamples();
-            const int  numChannels = buffer.getNumChannels();
-            const bool isFadeIn    = fadeIn.load();
-            const int  curve       = curveType.load();
+            if (posAtStartFileSamples >= duration)
+            {
+                constantGain = gain * AudioEngine::fadeGainAt(posAtStartFileSamples, duration, isFadeIn, curve);
+                return false;
+            }
 
             for (int i = 0; i < numSamples; ++i)
             {
-                const double pos  = posAtBlockStartFileSamples + i * fileSamplesPerOutputSample;
-                const float  gain = AudioEngine::fadeGainAt(pos, duration, isFadeIn, curve);
-                for (int ch = 0; ch < numChannels; ++ch)
-                    buffer.getWritePointer(ch)[i] *= gain;
+                const double pos = posAtStartFileSamples + i * fileSamplesPerOutputSample;
+                ramp[i] = gain * AudioEngine::fadeGainAt(pos, duration, isFadeIn, curve);
             }
+            return true;
         }
     };
     FadeProcessor m_fadeProcessor;
@@ -959,12 +1022,23 @@ private:
                 alpha = rc / (rc + dt);
             }
 
-            float processSample(float input)
+            /** Filters data in place, scaling each output by ramp[i] (UseRamp) or gain. */
+            template <bool UseRamp>
+            void processBlock(float* data, int numSamples, float gain, const float* ramp)
             {
-                float output = alpha * (y1 + input - x1);
-                x1 = input;
-                y1 = output;
-                return output;
+                float x = x1, y = y1;
+                const float a = alpha;
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const float input = data[i];
+                    y = a * (y + input - x);
+                    x = input;
+                    data[i] = y * (UseRamp ? ramp[i] : gain);
+                }
+
+                x1 = x;
+                y1 = y;
             }
 
             void reset()
@@ -976,26 +1050,22 @@ private:
 
         std::array<DCBlocker, 8> dcBlockers;  // Support up to 8 channels
 
-        void process(juce::AudioBuffer<float>& buffer, double sampleRate)
-        {
-            if (!enabled.load()) return;
+        // Rate/cutoff the blockers' alpha was computed for (audio thread only)
+        double coefficientSampleRate = 0.0;
+        float coefficientCutoff = 0.0f;
 
-            const int numChannels = buffer.getNumChannels();
-            const int numSamples = buffer.getNumSamples();
+        /** Recomputes the blockers' coefficient only when rate or cutoff changed. */
+        void updateCoefficients(double sampleRate)
+        {
             const float freq = highpassFreq.load();
+            if (sampleRate == coefficientSampleRate && freq == coefficientCutoff)
+                return;
 
-            // Update filter coefficients if needed
-            for (int ch = 0; ch < numChannels && ch < 8; ++ch)
-            {
-                dcBlockers[static_cast<size_t>(ch)].updateCoefficient(sampleRate, freq);
+            for (auto& blocker : dcBlockers)
+                blocker.updateCoefficient(sampleRate, freq);
 
-                // Process samples
-                float* channelData = buffer.getWritePointer(ch);
-                for (int i = 0; i < numSamples; ++i)
-                {
-                    channelData[i] = dcBlockers[static_cast<size_t>(ch)].processSample(channelData[i]);
-                }
-            }
+            coefficientSampleRate = sampleRate;
+            coefficientCutoff = freq;
         }
 
         void reset()
@@ -1070,6 +1140,24 @@ private:
     void renderFoldDownBlock(juce::AudioBuffer<float>& output, int numOutputChannels,
                              int numSamples, int sourceChannels);
 
+    /**
+     * Audio-thread REALTIME_DSP preview: DC removal, Gain, Normalize, dynamic
+     * EQ and Fade as one fused pass. Gain and Normalize fold into a single
+     * multiplier; the fade is rendered once per chunk as a ramp and applied
+     * to every channel by vector multiply, folded into the DC pass when no EQ
+     * sits between them. Only the active stages run.
+     */
+    void processRealtimePreview(juce::AudioBuffer<float>& buffer);
+
+    /**
+     * One fused multiply pass of processRealtimePreview(): optional DC removal,
+     * then scaling by gain, or by gain times the fade ramp when applyFade is
+     * set. Allocation-free (the ramp lives on the stack, chunked).
+     */
+    void applyPreviewGainStage(juce::AudioBuffer<float>& buffer, bool removeDC, float gain,
+                               bool applyFade, double fadePosFileSamples,
+                               double fileSamplesPerOutputSample);
+
     /**
      * Validates that the audio file format is supported.
      *
@@ -1078,5 +1166,18 @@ private:
      */
     bool validateAudioFormat(juce::AudioFormatReader* reader);
 
+    /**
+     * Cheap sanity check of a snapshot before it is played: shape and rate,
+     * plus (with probeSamples) a bounded NaN/Inf probe of the samples.
+     */
+    static bool isPlayableSnapshot(const AudioSnapshot& snapshot, bool probeSamples);
+
+    /**
+     * Connects m_bufferSource to the transport. Snapshots that still read
+     * from a mapped file are buffered on the read-ahead thread so that page
+     * faults never land on the audio thread.
+     */
+    void connectBufferSource(const AudioSnapshot& snapshot);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioEngine)
 };
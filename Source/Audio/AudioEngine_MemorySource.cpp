@@ -5,8 +5,8 @@
     WaveEdit - Professional Audio Editor
     Copyright (C) 2025 ZQ SFX
 
-    MemoryAudioSource: the lock-light in-memory AudioSource that feeds the
-    transport from an AudioBuffer. Extracted from AudioEngine.cpp to stay
+    MemoryAudioSource: the lock-light AudioSource that feeds the transport
+    from a published AudioSnapshot. Extracted from AudioEngine.cpp to stay
     under the Sec 7.5 file-size cap.
 
   ==============================================================================
@@ -18,9 +18,7 @@
 // MemoryAudioSource Implementation
 
 AudioEngine::MemoryAudioSource::MemoryAudioSource()
-    : m_buffer(std::make_shared<const juce::AudioBuffer<float>>()),
-      m_sampleRate(44100.0),
-      m_readPosition(0),
+    : m_readPosition(0),
       m_isLooping(false)
 {
 }
@@ -35,45 +33,75 @@ void AudioEngine::MemoryAudioSource::setBuffer(const juce::AudioBuffer<float>& b
     // This method allocates memory and should never be called from audio thread
     jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
 
-    // Capture current position BEFORE the deep copy.
-    juce::int64 savedPosition = preservePosition ? m_readPosition.load() : 0;
-
     // H20 FIX: do the expensive deep copy OFF-lock. The audio thread keeps
-    // playing the previous buffer snapshot during this copy and never blocks.
-    auto newBuffer = std::make_shared<juce::AudioBuffer<float>>();
-    newBuffer->makeCopyOf(buffer);
-    const juce::int64 newLength = newBuffer->getNumSamples();
-
-    juce::int64 newPosition = preservePosition ? juce::jmin(savedPosition, newLength) : 0;
-
-    // Swap in the new buffer under a brief lock (pointer swap only). Use
-    // swap, not move-assign: assignment would release the OLD buffer inside
-    // the lock, and a multi-hundred-MB deallocation would stall any audio
-    // callback blocked on m_lock. After the swap, newBuffer holds the old
-    // buffer and frees it below, outside the locked scope. (M1)
-    BufferPtr incoming = std::move(newBuffer);
+    // playing the previous snapshot during this copy and never blocks.
+    juce::AudioBuffer<float> copy;
+    copy.makeCopyOf(buffer);
+
+    if (auto snapshot = AudioSnapshot::fromBuffer(std::move(copy), sampleRate))
+        setSnapshot(std::move(snapshot), preservePosition);
+    else
+        clear();
+}
+
+void AudioEngine::MemoryAudioSource::setSnapshot(AudioSnapshotPtr snapshot, bool preservePosition)
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+    jassert(snapshot != nullptr);
+
+    const juce::int64 savedPosition = preservePosition ? m_readPosition.load() : 0;
+    const juce::int64 newLength = snapshot->getNumSamples();
+    const juce::int64 newPosition = preservePosition ? juce::jmin(savedPosition, newLength) : 0;
+
+    // Swap in the new snapshot under a brief lock (pointer swap only). Use
+    // swap, not move-assign: assignment would release the OLD snapshot inside
+    // the lock, and if it held the last reference to its chunks, a
+    // multi-hundred-MB deallocation would stall any audio callback blocked on
+    // m_lock. After the swap, 'snapshot' holds the old one and frees it
+    // below, outside the locked scope. (M1) A document snapshot shares the
+    // editor's chunks, so no samples were copied at all.
     {
         juce::ScopedLock sl(m_lock);
-        std::swap(m_buffer, incoming);
-        m_sampleRate = sampleRate;
+        std::swap(m_snapshot, snapshot);
     }
-    // 'incoming' now owns the OLD buffer and releases it here, off-lock.
+    // 'snapshot' now owns the OLD snapshot and releases it here, off-lock.
 
-    // Publish the new length and position for lock-free readers (L1).
+    // Publish the new length and position for lock-free readers (L1). A
+    // preserved position that still fits is left alone: storing the value
+    // read before the swap would rewind the audio thread by whatever it
+    // played in between (edits hot-swapped during playback).
     m_bufferLength.store(newLength);
-    m_readPosition.store(newPosition);
+    if (! preservePosition || savedPosition > newLength)
+        m_readPosition.store(newPosition);
+}
+
+void AudioEngine::MemoryAudioSource::setEditedSnapshot(AudioSnapshotPtr snapshot, const AudioEditRange& range)
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+    jassert(snapshot != nullptr);
+
+    const juce::int64 newLength = snapshot->getNumSamples();
+
+    // The audio thread advances m_readPosition while holding m_lock, so
+    // remapping it here, in the same scope as the swap, cannot lose a block
+    // or pair the new audio with a stale position. The old snapshot is
+    // released below, off-lock, as in setSnapshot().
+    {
+        juce::ScopedLock sl(m_lock);
+        std::swap(m_snapshot, snapshot);
+        m_bufferLength.store(newLength);
+        m_readPosition.store(juce::jlimit<juce::int64>(0, newLength, range.remapPosition(m_readPosition.load())));
+    }
 }
 
 void AudioEngine::MemoryAudioSource::clear()
 {
-    auto emptyBuffer = std::make_shared<juce::AudioBuffer<float>>();
-    BufferPtr previous;
+    AudioSnapshotPtr previous;
     {
         juce::ScopedLock sl(m_lock);
-        previous = std::move(m_buffer);
-        m_buffer = std::move(emptyBuffer);
+        std::swap(previous, m_snapshot);
     }
-    // 'previous' releases the old buffer here, outside the lock (M1).
+    // 'previous' releases the old snapshot here, outside the lock (M1).
     m_bufferLength.store(0);
     m_readPosition.store(0);
 }
@@ -92,41 +120,43 @@ void AudioEngine::MemoryAudioSource::getNextAudioBlock(const juce::AudioSourceCh
 {
     bufferToFill.clearActiveBufferRegion();
 
-    // M-H1 FIX: try-lock and read the buffer through a RAW pointer inside the
-    // locked scope -- no blocking, and no shared_ptr refcount traffic on the
-    // audio thread. setBuffer()/clear() do their expensive deep copy and old-
-    // buffer free OFF-lock and only swap the pointer under m_lock, so holding
-    // m_lock across this bounded per-block copy is safe (the message thread
-    // waits at most one block for the swap). On the rare contended block
-    // (a writer mid pointer-swap) we emit the already-cleared silence and
-    // return -- the audio thread NEVER blocks (§6.4). The previous code held a
-    // blocking ScopedLock and copied the shared_ptr (a refcount bump/decrement).
+    // M-H1 FIX: try-lock and read the snapshot through a RAW pointer inside
+    // the locked scope -- no blocking, and no shared_ptr refcount traffic on
+    // the audio thread. setBuffer()/clear() do their expensive deep copy and
+    // old-snapshot free OFF-lock and only swap the pointer under m_lock, so
+    // holding m_lock across this bounded per-block read is safe (the message
+    // thread waits at most one block for the swap). On the rare contended
+    // block (a writer mid pointer-swap) we emit the already-cleared silence
+    // and return -- the audio thread NEVER blocks (§6.4). The snapshot's
+    // range reader is allocation-free; mapped audio that could page-fault is
+    // only ever read here from the transport's read-ahead thread.
     const juce::ScopedTryLock stl(m_lock);
     if (! stl.isLocked())
         return;
 
-    if (m_buffer == nullptr)
+    const AudioSnapshot* src = m_snapshot.get();
+    if (src == nullptr)
         return;
 
-    const juce::AudioBuffer<float>& src = *m_buffer;
-    if (src.getNumSamples() == 0)
+    const juce::int64 totalSamples = src->getNumSamples();
+    if (totalSamples == 0)
     {
         return;
     }
 
     juce::int64 startSample = m_readPosition.load();
     int numSamplesToRead = bufferToFill.numSamples;
-    int numSamplesAvailable = static_cast<int>(src.getNumSamples() - startSample);
+    juce::int64 numSamplesAvailable = totalSamples - startSample;
 
     if (numSamplesAvailable <= 0)
     {
-        // Reached end of buffer
+        // Reached end of the audio
         if (m_isLooping)
         {
             // Reset position and recalculate - avoid recursion
             m_readPosition.store(0);
             startSample = 0;
-            numSamplesAvailable = src.getNumSamples();
+            numSamplesAvailable = totalSamples;
         }
         else
         {
@@ -134,41 +164,34 @@ void AudioEngine::MemoryAudioSource::getNextAudioBlock(const juce::AudioSourceCh
         }
     }
 
-    int numSamples = juce::jmin(numSamplesToRead, numSamplesAvailable);
+    const int numSamples = static_cast<int>(juce::jmin<juce::int64>(numSamplesToRead, numSamplesAvailable));
 
-    // Additional safety: Ensure we don't read past buffer end
-    if (startSample + numSamples > src.getNumSamples())
-    {
-        numSamples = static_cast<int>(src.getNumSamples() - startSample);
-        if (numSamples <= 0)
-            return;
-    }
-
-    // Copy audio data from buffer to output
+    // Copy audio data from the snapshot to output
     // IMPORTANT: Handle mono-to-stereo conversion professionally
     // Mono files should play centered (equal on both channels), not just left channel
-    int sourceChannels = src.getNumChannels();
+    int sourceChannels = src->getNumChannels();
     int outputChannels = bufferToFill.buffer->getNumChannels();
+    bool readOk = false;
 
     if (sourceChannels == 1 && outputChannels == 2)
     {
         // Mono to stereo: duplicate mono channel to both L and R for center-panned playback
         // This matches professional audio editor behavior (Sound Forge, Pro Tools, etc.)
-        bufferToFill.buffer->copyFrom(0, bufferToFill.startSample,
-                                      src, 0, static_cast<int>(startSample), numSamples);
+        readOk = src->readChannelRange(0, bufferToFill.buffer->getWritePointer(0, bufferToFill.startSample),
+                                       startSample, numSamples);
         bufferToFill.buffer->copyFrom(1, bufferToFill.startSample,
-                                      src, 0, static_cast<int>(startSample), numSamples);
+                                      *bufferToFill.buffer, 0, bufferToFill.startSample, numSamples);
     }
     else
     {
         // Standard channel mapping: match channels one-to-one up to minimum of source/output
-        for (int ch = 0; ch < juce::jmin(sourceChannels, outputChannels); ++ch)
-        {
-            bufferToFill.buffer->copyFrom(ch, bufferToFill.startSample,
-                                          src, ch, static_cast<int>(startSample), numSamples);
-        }
+        readOk = src->readRange(*bufferToFill.buffer, bufferToFill.startSample, startSample, numSamples);
     }
 
+    // A failed mapped read leaves partial data behind; play silence instead.
+    if (! readOk)
+        bufferToFill.clearActiveBufferRegion();
+
     m_readPosition.store(startSample + numSamples);
 }
 
@@ -9,14 +9,16 @@
     Hosts the preview-system surface — entering / leaving preview mode,
     loading the preview buffer, atomic param-exchange setters for each
     processor (gain / normalize / fade / DC offset / parametric EQ /
-    dynamic EQ), the bypass + reset + disable helpers, and the
-    selection-offset accounting used by previewing dialogs to map the
-    file timeline back into the preview buffer.
+    dynamic EQ), the fused audio-thread kernel that runs them, the
+    bypass + reset + disable helpers, and the selection-offset
+    accounting used by previewing dialogs to map the file timeline back
+    into the preview buffer.
 
   ==============================================================================
 */
 
 #include "AudioEngine.h"
+#include "PlaybackMixer.h"
 #include <cmath>
 
 //==============================================================================
@@ -134,7 +136,7 @@ bool AudioEngine::loadPreviewBuffer(const juce::AudioBuffer<float>& previewBuffe
     // CRITICAL: Call prepareToPlay() after changing the source
     // This is REQUIRED by JUCE's AudioTransportSource - without it, the transport
     // continues reading from the old source despite the setSource() call!
-    auto* device = m_deviceManager.getCurrentAudioDevice();
+    auto* device = PlaybackMixer::getInstance().getCurrentDevice();
     if (device != nullptr)
     {
         m_transportSource.prepareToPlay(device->getCurrentBufferSizeSamples(),
@@ -313,6 +315,106 @@ double AudioEngine::getPreviewSelectionOffsetSeconds() const
     return static_cast<double>(offsetSamples) / currentSampleRate;
 }
 
+//==============================================================================
+// Fused real-time preview kernel (audio thread)
+
+namespace
+{
+    /** Samples per fused pass; bounds the on-stack fade ramp. */
+    constexpr int kPreviewKernelChunk = 256;
+}
+
+void AudioEngine::processRealtimePreview(juce::AudioBuffer<float>& buffer)
+{
+    // sampleRate is the FILE rate (m_sampleRate)
+    const double sampleRate = m_sampleRate.load();
+
+    const bool removeDC = sampleRate > 0.0 && m_dcOffsetProcessor.enabled.load();
+    if (removeDC)
+        m_dcOffsetProcessor.updateCoefficients(sampleRate);
+
+    // Gain and Normalize are both plain multipliers: fold them into one
+    const float gain = m_gainProcessor.getLinearGain() * m_normalizeProcessor.getLinearGain();
+
+    const bool eqActive = m_dynamicEQEnabled.get() && m_dynamicEQ != nullptr;
+
+    // Position-driven fade: feed the current transport position within the
+    // fade span (file samples) + the file-samples-per-output-sample ratio, so
+    // the fade is rate-independent and re-aligns on each loop wrap.
+    const bool fadeActive = sampleRate > 0.0 && m_fadeProcessor.isActive();
+    double fadePos = 0.0;
+    double fileSamplesPerOutputSample = 1.0;
+    if (fadeActive)
+    {
+        const double deviceRate = m_deviceSampleRate.load();
+        const double posSec = m_transportSource.getCurrentPosition() - m_previewRegionStartSec.load();
+        fadePos = juce::jmax(0.0, posSec) * sampleRate;
+        fileSamplesPerOutputSample = (deviceRate > 0.0) ? (sampleRate / deviceRate) : 1.0;
+    }
+
+    // The fade is the final envelope. Without an EQ in between, it shares the
+    // DC/gain pass; otherwise it gets its own pass after the EQ.
+    const bool fadeInFirstPass = fadeActive && !eqActive;
+
+    if (removeDC || gain != 1.0f || fadeInFirstPass)
+        applyPreviewGainStage(buffer, removeDC, gain, fadeInFirstPass, fadePos, fileSamplesPerOutputSample);
+
+    // C1 contract: every mutator builds coefficients on the message thread
+    // under the EQ's own lock; applyEQ() only processes.
+    if (eqActive)
+        m_dynamicEQ->applyEQ(buffer);
+
+    if (fadeActive && eqActive)
+        applyPreviewGainStage(buffer, false, 1.0f, true, fadePos, fileSamplesPerOutputSample);
+}
+
+void AudioEngine::applyPreviewGainStage(juce::AudioBuffer<float>& buffer, bool removeDC, float gain,
+                                        bool applyFade, double fadePosFileSamples,
+                                        double fileSamplesPerOutputSample)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    const int numDCChannels = juce::jmin(numChannels, static_cast<int>(m_dcOffsetProcessor.dcBlockers.size()));
+
+    float ramp[kPreviewKernelChunk];
+
+    for (int start = 0; start < numSamples; start += kPreviewKernelChunk)
+    {
+        const int count = juce::jmin(kPreviewKernelChunk, numSamples - start);
+
+        // Rendered once per chunk for all channels; a chunk past the end of the
+        // fade span collapses to a scalar
+        float chunkGain = gain;
+        const bool useRamp = applyFade
+            && m_fadeProcessor.renderRamp(ramp, count,
+                                          fadePosFileSamples + start * fileSamplesPerOutputSample,
+                                          fileSamplesPerOutputSample, gain, chunkGain);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* data = buffer.getWritePointer(ch, start);
+
+            if (removeDC && ch < numDCChannels)
+            {
+                // The filter is recursive, so the multiply rides along in its loop
+                auto& blocker = m_dcOffsetProcessor.dcBlockers[static_cast<size_t>(ch)];
+                if (useRamp)
+                    blocker.processBlock<true>(data, count, chunkGain, ramp);
+                else
+                    blocker.processBlock<false>(data, count, chunkGain, nullptr);
+            }
+            else if (useRamp)
+            {
+                juce::FloatVectorOperations::multiply(data, ramp, count);
+            }
+            else if (chunkGain != 1.0f)
+            {
+                juce::FloatVectorOperations::multiply(data, chunkGain, count);
+            }
+        }
+    }
+}
+
 //==============================================================================
 // Shared preview helpers (pure) + session control
 //==============================================================================
@@ -419,6 +521,57 @@ bool AudioEngine::startBufferPreview(const juce::AudioBuffer<float>& buffer, dou
     return true;
 }
 
+bool AudioEngine::startTimePitchPreview(const juce::AudioBuffer<float>& buffer, double sampleRate,
+                                        int numChannels, bool loop, double fileOffsetSeconds,
+                                        const TimePitchEngine::Recipe& recipe)
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    if (buffer.getNumSamples() <= 0 || numChannels <= 0 || sampleRate <= 0.0)
+        return false;
+
+    setPreviewMode(PreviewMode::OFFLINE_BUFFER);
+
+    // Same source swap as loadPreviewBuffer(): stop and disconnect first so the
+    // old source is no longer referenced by the audio thread when it is freed.
+    if (m_transportSource.isPlaying())
+        m_transportSource.stop();
+    m_transportSource.releaseResources();
+    m_transportSource.setSource(nullptr);
+
+    m_timePitchSource = std::make_unique<TimePitchEngine::StreamingSource>(buffer, sampleRate);
+    m_timePitchSource->setRecipe(recipe);
+    m_timePitchSource->setLooping(loop);
+
+    m_transportSource.setSource(m_timePitchSource.get(), 0, nullptr, sampleRate, numChannels);
+    if (auto* device = PlaybackMixer::getInstance().getCurrentDevice())
+    {
+        m_transportSource.prepareToPlay(device->getCurrentBufferSizeSamples(),
+                                         device->getCurrentSampleRate());
+    }
+
+    m_sampleRate.store(sampleRate);
+    m_numChannels.store(numChannels);
+
+    // Playhead mapping as in startBufferPreview(). The source wraps at the end
+    // of the excerpt itself, so no engine loop points are set: a transport
+    // seek would reset SoundTouch on every wrap.
+    setPreviewSelectionOffset(static_cast<int64_t>(std::llround(fileOffsetSeconds * sampleRate)));
+    m_previewRegionStartSec.store(fileOffsetSeconds);
+    clearLoopPoints();
+    setLooping(loop);
+
+    setPosition(0.0);
+    play();
+    return true;
+}
+
+void AudioEngine::setTimePitchPreview(const TimePitchEngine::Recipe& recipe)
+{
+    if (m_timePitchSource != nullptr)
+        m_timePitchSource->setRecipe(recipe);
+}
+
 void AudioEngine::stopSelectionPreview()
 {
     // Order matters: stop() also clears loop state, so clear/disable afterwards.
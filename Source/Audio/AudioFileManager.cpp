@@ -258,13 +258,22 @@ bool AudioFileManager::saveAsWav(const juce::File& file,
                                   double sampleRate,
                                   int bitDepth,
                                   const juce::StringPairArray& metadata)
+{
+    return saveAsWav(file, AudioBlockSource::fromBuffer(buffer), sampleRate, bitDepth, metadata);
+}
+
+bool AudioFileManager::saveAsWav(const juce::File& file,
+                                  const AudioBlockSource& source,
+                                  double sampleRate,
+                                  int bitDepth,
+                                  const juce::StringPairArray& metadata)
 {
     clearError();
 
     // Validate parameters
-    if (!validateBufferForSaving(buffer, sampleRate, bitDepth))
+    if (!validateForSaving(source.numChannels, source.numSamples, sampleRate, bitDepth))
     {
-        // Error message already set by validateBufferForSaving
+        // Error message already set by validateForSaving
         return false;
     }
 
@@ -303,7 +312,7 @@ bool AudioFileManager::saveAsWav(const juce::File& file,
     // Build options using fluent API
     auto options = juce::AudioFormatWriterOptions()
         .withSampleRate(sampleRate)
-        .withNumChannels(buffer.getNumChannels())
+        .withNumChannels(source.numChannels)
         .withBitsPerSample(bitDepth)
         .withMetadataValues(metadataMap)
         .withQualityOptionIndex(0);
@@ -333,8 +342,8 @@ bool AudioFileManager::saveAsWav(const juce::File& file,
 
     // Note: outputStream ownership transferred via reference above (unique_ptr now null)
 
-    // Write the buffer to the temp file
-    bool writeSuccess = writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    // Stream the audio to the temp file block by block
+    bool writeSuccess = source.writeTo(*writer);
 
     // Flush and close the writer
     writer.reset();
@@ -455,12 +464,13 @@ void AudioFileManager::setError(const juce::String& errorMessage)
     DBG("AudioFileManager error: " + errorMessage);
 }
 
-bool AudioFileManager::validateBufferForSaving(const juce::AudioBuffer<float>& buffer,
-                                                double sampleRate,
-                                                int bitDepth)
+bool AudioFileManager::validateForSaving(int numChannels,
+                                         int64_t numSamples,
+                                         double sampleRate,
+                                         int bitDepth)
 {
-    // Check buffer is not empty
-    if (buffer.getNumChannels() == 0 || buffer.getNumSamples() == 0)
+    // Check the audio is not empty
+    if (numChannels == 0 || numSamples == 0)
     {
         setError("Cannot save empty audio buffer");
         return false;
@@ -494,7 +504,6 @@ bool AudioFileManager::validateBufferForSaving(const juce::AudioBuffer<float>& b
     }
 
     // Check channel count
-    int numChannels = buffer.getNumChannels();
     if (numChannels < 1 || numChannels > 8)
     {
         setError("Unsupported channel count for saving: " + juce::String(numChannels) +
@@ -656,7 +665,7 @@ bool AudioFileManager::appendiXMLChunk(const juce::File& file, const juce::Strin
     // Atomic replace: write the rebuilt file to a sibling temp file, then
     // swap it onto the target in one step. A crash / disk-full mid-write
     // leaves the original intact instead of a truncated or deleted file
-    // (C10). Pattern mirrors ThumbnailDiskCache::save.
+    // (C10). Pattern mirrors PeakFileCache::saveAsync.
     {
         juce::TemporaryFile tmp(file, juce::TemporaryFile::useHiddenFile);
         {
@@ -795,6 +804,17 @@ bool AudioFileManager::saveAudioFile(const juce::File& file,
                                       int bitDepth,
                                       int qualityOptionIndex,
                                       const juce::StringPairArray& metadata)
+{
+    return saveAudioFile(file, AudioBlockSource::fromBuffer(buffer), sampleRate,
+                         bitDepth, qualityOptionIndex, metadata);
+}
+
+bool AudioFileManager::saveAudioFile(const juce::File& file,
+                                      const AudioBlockSource& source,
+                                      double sampleRate,
+                                      int bitDepth,
+                                      int qualityOptionIndex,
+                                      const juce::StringPairArray& metadata)
 {
     clearError();
 
@@ -805,7 +825,7 @@ bool AudioFileManager::saveAudioFile(const juce::File& file,
         return false;
     }
 
-    if (buffer.getNumChannels() == 0 || buffer.getNumSamples() == 0)
+    if (source.isEmpty())
     {
         setError("Cannot save empty audio buffer");
         return false;
@@ -822,13 +842,13 @@ bool AudioFileManager::saveAudioFile(const juce::File& file,
 
     juce::Logger::writeToLog("Saving audio file: " + file.getFullPathName());
     DBG("Format: " + extension + ", Sample rate: " + juce::String(sampleRate) +
-                            "Hz, Channels: " + juce::String(buffer.getNumChannels()) +
-                            ", Samples: " + juce::String(buffer.getNumSamples()));
+                            "Hz, Channels: " + juce::String(source.numChannels) +
+                            ", Samples: " + juce::String(static_cast<juce::int64>(source.numSamples)));
 
     // For WAV files, use the existing saveAsWav method (which handles BWF metadata and iXML)
     if (extension == ".wav")
     {
-        return saveAsWav(file, buffer, sampleRate, bitDepth, metadata);
+        return saveAsWav(file, source, sampleRate, bitDepth, metadata);
     }
 
     // For other formats (FLAC, OGG, MP3), use the generic audio format writer.
@@ -868,10 +888,10 @@ bool AudioFileManager::saveAudioFile(const juce::File& file,
     {
 #if WAVEEDIT_HAVE_LAME
         // MP3 is mono/stereo only.
-        if (buffer.getNumChannels() > 2)
+        if (source.numChannels > 2)
         {
             setError("MP3 export supports mono or stereo only (this audio has "
-                     + juce::String(buffer.getNumChannels()) + " channels).");
+                     + juce::String(source.numChannels) + " channels).");
             return false;
         }
 
@@ -949,7 +969,7 @@ bool AudioFileManager::saveAudioFile(const juce::File& file,
     // ownership of the stream when writer creation succeeds
     auto writerOptions = juce::AudioFormatWriterOptions()
         .withSampleRate(sampleRate)
-        .withNumChannels(buffer.getNumChannels())
+        .withNumChannels(source.numChannels)
         .withBitsPerSample(24) // Use 24-bit for best quality with compressed formats
         .withQualityOptionIndex(quality); // No metadata support for FLAC/OGG via JUCE writer
 
@@ -961,8 +981,8 @@ bool AudioFileManager::saveAudioFile(const juce::File& file,
         return false;
     }
 
-    // Write audio data
-    bool writeSuccess = writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    // Write audio data block by block
+    bool writeSuccess = source.writeTo(*writer);
 
     // Close writer (flushes data)
     writer.reset();
@@ -983,60 +1003,19 @@ bool AudioFileManager::saveAudioFile(const juce::File& file,
 
 juce::AudioBuffer<float> AudioFileManager::resampleBuffer(const juce::AudioBuffer<float>& sourceBuffer,
                                                            double sourceSampleRate,
-                                                           double targetSampleRate)
+                                                           double targetSampleRate,
+                                                           SampleRateConverter::Quality quality)
 {
-    // If sample rates match, return copy of source
-    if (std::abs(sourceSampleRate - targetSampleRate) < 0.01)
-    {
-        juce::AudioBuffer<float> copy(sourceBuffer.getNumChannels(), sourceBuffer.getNumSamples());
-        for (int ch = 0; ch < sourceBuffer.getNumChannels(); ++ch)
-            copy.copyFrom(ch, 0, sourceBuffer, ch, 0, sourceBuffer.getNumSamples());
-        return copy;
-    }
-
-    // Calculate resampling ratio and target length
-    double ratio = targetSampleRate / sourceSampleRate;
-    int targetNumSamples = (int)(sourceBuffer.getNumSamples() * ratio);
-
-    // Create output buffer
-    juce::AudioBuffer<float> targetBuffer(sourceBuffer.getNumChannels(), targetNumSamples);
-    targetBuffer.clear();
-
-    // Use JUCE's LagrangeInterpolator for high-quality resampling
-    // Process each channel independently
-    for (int ch = 0; ch < sourceBuffer.getNumChannels(); ++ch)
-    {
-        juce::LagrangeInterpolator interpolator;
-        interpolator.reset();
-
-        const float* sourceData = sourceBuffer.getReadPointer(ch);
-        float* targetData = targetBuffer.getWritePointer(ch);
-
-        // CRITICAL: LagrangeInterpolator speed ratio is SOURCE/TARGET (inverse of our ratio)
-        // For downsampling 96kHz->8kHz: speed = 96000/8000 = 12.0 (consume input faster)
-        // For upsampling 8kHz->96kHz: speed = 8000/96000 = 0.0833 (consume input slower)
-        const double speedRatio = sourceSampleRate / targetSampleRate;
-        const int totalInputSamples = sourceBuffer.getNumSamples();
-
-        // Resample the whole channel in a SINGLE process() call. process()
-        // reads/writes the caller's buffers directly (no internal allocation),
-        // so there is no memory benefit to chunking by output -- and chunking
-        // re-seeds the interpolator's internal filter history at every chunk
-        // boundary, which produced audible discontinuities (the earlier bug).
-        // One call keeps the interpolator state continuous across the buffer.
-        interpolator.process(
-            speedRatio,             // source/target ratio
-            sourceData,             // full input
-            targetData,             // full output
-            targetNumSamples,       // total output samples to produce
-            totalInputSamples,      // input samples available
-            0);                     // no wraparound
-    }
+    // Windowed-sinc polyphase conversion, band-limited on downsampling, with
+    // channels and output chunks rendered in parallel. Matching rates return
+    // a copy.
+    auto targetBuffer = SampleRateConverter::resample(sourceBuffer, sourceSampleRate,
+                                                      targetSampleRate, quality);
 
     DBG("Resampled audio: " + juce::String(sourceSampleRate, 0) +
                              " Hz → " + juce::String(targetSampleRate, 0) + " Hz (" +
                              juce::String(sourceBuffer.getNumSamples()) + " → " +
-                             juce::String(targetNumSamples) + " samples)");
+                             juce::String(targetBuffer.getNumSamples()) + " samples)");
 
     return targetBuffer;
 }
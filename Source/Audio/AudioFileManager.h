@@ -18,6 +18,8 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_core/juce_core.h>
+#include "AudioBlockSource.h"
+#include "SampleRateConverter.h"
 
 /**
  * Audio file format information structure.
@@ -178,6 +180,17 @@ public:
                    int bitDepth = 16,
                    const juce::StringPairArray& metadata = {});
 
+    /**
+     * Streaming variant of saveAsWav(): the audio is pulled from source in
+     * bounded blocks, so it need not fit one buffer. Files past 4 GB are
+     * written as RF64.
+     */
+    bool saveAsWav(const juce::File& file,
+                   const AudioBlockSource& source,
+                   double sampleRate,
+                   int bitDepth = 16,
+                   const juce::StringPairArray& metadata = {});
+
     /**
      * Overwrites an existing file with new audio data.
      * This is the "Save" operation (not "Save As").
@@ -269,6 +282,18 @@ public:
                        int qualityOptionIndex = 5,
                        const juce::StringPairArray& metadata = {});
 
+    /**
+     * Streaming variant of saveAudioFile(); see saveAsWav(const juce::File&,
+     * const AudioBlockSource&, ...). Document saves use this so long
+     * documents are written without flattening them.
+     */
+    bool saveAudioFile(const juce::File& file,
+                       const AudioBlockSource& source,
+                       double sampleRate,
+                       int bitDepth = 16,
+                       int qualityOptionIndex = 5,
+                       const juce::StringPairArray& metadata = {});
+
     //==============================================================================
     // Error Handling
 
@@ -288,16 +313,21 @@ public:
     // Sample Rate Conversion
 
     /**
-     * Resamples an audio buffer to a different sample rate using high-quality interpolation.
+     * Resamples an audio buffer to a different sample rate with the
+     * band-limited polyphase converter (see SampleRateConverter).
      *
      * @param sourceBuffer The input audio buffer to resample
      * @param sourceSampleRate The current sample rate of the audio
      * @param targetSampleRate The desired output sample rate
+     * @param quality Filter quality tier
      * @return New buffer with resampled audio
+     * @throws std::length_error if the result is too long for one buffer
      */
     static juce::AudioBuffer<float> resampleBuffer(const juce::AudioBuffer<float>& sourceBuffer,
                                                     double sourceSampleRate,
-                                                    double targetSampleRate);
+                                                    double targetSampleRate,
+                                                    SampleRateConverter::Quality quality
+                                                        = SampleRateConverter::Quality::High);
 
 private:
     //==============================================================================
@@ -315,11 +345,12 @@ private:
     void setError(const juce::String& errorMessage);
 
     /**
-     * Validates audio buffer parameters before saving.
+     * Validates audio parameters before saving.
      */
-    bool validateBufferForSaving(const juce::AudioBuffer<float>& buffer,
-                                  double sampleRate,
-                                  int bitDepth);
+    bool validateForSaving(int numChannels,
+                           int64_t numSamples,
+                           double sampleRate,
+                           int bitDepth);
 
 private:
     /**
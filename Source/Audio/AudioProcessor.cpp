@@ -14,6 +14,10 @@
 */
 
 #include "AudioProcessor.h"
+#include "ParallelChunkExecutor.h"
+#include <algorithm>
+#include <iterator>
+#include <vector>
 
 //==============================================================================
 // Gain and Level Operations
@@ -454,34 +458,17 @@ bool AudioProcessor::applyGainWithProgress(juce::AudioBuffer<float>& buffer, flo
     // Convert dB to linear gain
     float linearGain = dBToLinear(gainDB);
 
-    // Process in chunks with progress reporting
-    const int chunkSize = 4096;
-    int processed = 0;
+    // Channels and sample chunks are processed in parallel. If cancelled,
+    // the operation is partially complete.
+    float* const* channels = buffer.getArrayOfWritePointers();
 
-    while (processed < actualNumSamples)
-    {
-        // Calculate chunk boundaries
-        int chunkStart = startSample + processed;
-        int chunkSamples = std::min(chunkSize, actualNumSamples - processed);
-
-        // Apply gain to this chunk across all channels
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    return ParallelChunkExecutor::run(buffer.getNumChannels(), startSample, actualNumSamples,
+        [channels, linearGain](const ParallelChunkExecutor::Tile& tile)
         {
-            buffer.applyGain(ch, chunkStart, chunkSamples, linearGain);
-        }
-
-        processed += chunkSamples;
-
-        // Report progress
-        float progressValue = static_cast<float>(processed) / static_cast<float>(actualNumSamples);
-        if (!progress(progressValue, "Applying gain..."))
-        {
-            // Cancelled - operation is partially complete
-            return false;
-        }
-    }
-
-    return true;
+            juce::FloatVectorOperations::multiply(channels[tile.channel] + tile.startSample,
+                                                  linearGain, tile.numSamples);
+        },
+        progress, "Applying gain...");
 }
 
 bool AudioProcessor::normalizeWithProgress(juce::AudioBuffer<float>& buffer, float targetDB,
@@ -513,32 +500,28 @@ bool AudioProcessor::normalizeWithProgress(juce::AudioBuffer<float>& buffer, flo
         return false;
     }
 
-    // Phase 1: Find peak (50% of progress)
-    float peak = 0.0f;
-    const int chunkSize = 4096;
-    int processed = 0;
+    const int numChannels = buffer.getNumChannels();
 
-    while (processed < actualNumSamples)
-    {
-        int chunkStart = startSample + processed;
-        int chunkSamples = std::min(chunkSize, actualNumSamples - processed);
+    // Phase 1: Find peak (0-50% of progress). Parallel reduction: each tile
+    // records its own peak, and the maximum is taken afterwards.
+    const float* const* readChannels = buffer.getArrayOfReadPointers();
+    std::vector<float> tilePeaks(static_cast<size_t>(
+        ParallelChunkExecutor::getNumTiles(numChannels, actualNumSamples)), 0.0f);
 
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            float channelPeak = buffer.getMagnitude(ch, chunkStart, chunkSamples);
-            peak = std::max(peak, channelPeak);
-        }
-
-        processed += chunkSamples;
-
-        // Report progress (0-50% for peak finding)
-        float progressValue = 0.5f * static_cast<float>(processed) / static_cast<float>(actualNumSamples);
-        if (!progress(progressValue, "Analyzing peak levels..."))
-        {
-            return false;
-        }
+    if (!ParallelChunkExecutor::run(numChannels, startSample, actualNumSamples,
+            [readChannels, &tilePeaks](const ParallelChunkExecutor::Tile& tile)
+            {
+                const auto range = juce::FloatVectorOperations::findMinAndMax(
+                    readChannels[tile.channel] + tile.startSample, tile.numSamples);
+                tilePeaks[static_cast<size_t>(tile.index)] = std::max(-range.getStart(), range.getEnd());
+            },
+            progress, "Analyzing peak levels...", 0.0f, 0.5f))
+    {
+        return false;
     }
 
+    const float peak = *std::max_element(tilePeaks.begin(), tilePeaks.end());
+
     // Check if buffer is silent
     if (peak < 1e-6f)
     {
@@ -550,29 +533,15 @@ bool AudioProcessor::normalizeWithProgress(juce::AudioBuffer<float>& buffer, flo
     float requiredGain = targetLinear / peak;
 
     // Phase 2: Apply gain (50-100% of progress)
-    processed = 0;
-
-    while (processed < actualNumSamples)
-    {
-        int chunkStart = startSample + processed;
-        int chunkSamples = std::min(chunkSize, actualNumSamples - processed);
-
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            buffer.applyGain(ch, chunkStart, chunkSamples, requiredGain);
-        }
+    float* const* channels = buffer.getArrayOfWritePointers();
 
-        processed += chunkSamples;
-
-        // Report progress (50-100% for gain application)
-        float progressValue = 0.5f + 0.5f * static_cast<float>(processed) / static_cast<float>(actualNumSamples);
-        if (!progress(progressValue, "Normalizing audio..."))
+    return ParallelChunkExecutor::run(numChannels, startSample, actualNumSamples,
+        [channels, requiredGain](const ParallelChunkExecutor::Tile& tile)
         {
-            return false;
-        }
-    }
-
-    return true;
+            juce::FloatVectorOperations::multiply(channels[tile.channel] + tile.startSample,
+                                                  requiredGain, tile.numSamples);
+        },
+        progress, "Normalizing audio...", 0.5f, 1.0f);
 }
 
 bool AudioProcessor::fadeInWithProgress(juce::AudioBuffer<float>& buffer, int numSamples,
@@ -591,21 +560,15 @@ bool AudioProcessor::fadeInWithProgress(juce::AudioBuffer<float>& buffer, int nu
         fadeSamples = buffer.getNumSamples();
     }
 
-    // Process in chunks with progress reporting
-    const int chunkSize = 4096;
-    int processed = 0;
+    // Channels and sample chunks are processed in parallel
+    float* const* channels = buffer.getArrayOfWritePointers();
 
-    while (processed < fadeSamples)
-    {
-        int chunkStart = processed;
-        int chunkSamples = std::min(chunkSize, fadeSamples - processed);
-
-        // Apply fade to this chunk across all channels
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    return ParallelChunkExecutor::run(buffer.getNumChannels(), 0, fadeSamples,
+        [channels, fadeSamples, curve](const ParallelChunkExecutor::Tile& tile)
         {
-            float* channelData = buffer.getWritePointer(ch);
+            float* channelData = channels[tile.channel];
 
-            for (int i = chunkStart; i < chunkStart + chunkSamples; ++i)
+            for (int i = tile.startSample; i < tile.startSample + tile.numSamples; ++i)
             {
                 float normalizedPosition = static_cast<float>(i) / static_cast<float>(fadeSamples);
                 float gain = 0.0f;
@@ -628,19 +591,8 @@ bool AudioProcessor::fadeInWithProgress(juce::AudioBuffer<float>& buffer, int nu
 
                 channelData[i] *= gain;
             }
-        }
-
-        processed += chunkSamples;
-
-        // Report progress
-        float progressValue = static_cast<float>(processed) / static_cast<float>(fadeSamples);
-        if (!progress(progressValue, "Applying fade in..."))
-        {
-            return false;
-        }
-    }
-
-    return true;
+        },
+        progress, "Applying fade in...");
 }
 
 bool AudioProcessor::fadeOutWithProgress(juce::AudioBuffer<float>& buffer, int numSamples,
@@ -662,24 +614,17 @@ bool AudioProcessor::fadeOutWithProgress(juce::AudioBuffer<float>& buffer, int n
     // Calculate start position (fade from end backwards)
     int startSample = buffer.getNumSamples() - fadeSamples;
 
-    // Process in chunks with progress reporting
-    const int chunkSize = 4096;
-    int processed = 0;
-
-    while (processed < fadeSamples)
-    {
-        int chunkOffset = processed;
-        int chunkSamples = std::min(chunkSize, fadeSamples - processed);
+    // Channels and sample chunks are processed in parallel
+    float* const* channels = buffer.getArrayOfWritePointers();
 
-        // Apply fade to this chunk across all channels
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    return ParallelChunkExecutor::run(buffer.getNumChannels(), startSample, fadeSamples,
+        [channels, startSample, fadeSamples, curve](const ParallelChunkExecutor::Tile& tile)
         {
-            float* channelData = buffer.getWritePointer(ch);
+            float* channelData = channels[tile.channel];
 
-            for (int i = 0; i < chunkSamples; ++i)
+            for (int sampleIndex = tile.startSample; sampleIndex < tile.startSample + tile.numSamples; ++sampleIndex)
             {
-                int sampleIndex = startSample + chunkOffset + i;
-                float normalizedPosition = static_cast<float>(chunkOffset + i) / static_cast<float>(fadeSamples);
+                float normalizedPosition = static_cast<float>(sampleIndex - startSample) / static_cast<float>(fadeSamples);
                 float gain = 0.0f;
 
                 switch (curve)
@@ -703,19 +648,8 @@ bool AudioProcessor::fadeOutWithProgress(juce::AudioBuffer<float>& buffer, int n
 
                 channelData[sampleIndex] *= gain;
             }
-        }
-
-        processed += chunkSamples;
-
-        // Report progress
-        float progressValue = static_cast<float>(processed) / static_cast<float>(fadeSamples);
-        if (!progress(progressValue, "Applying fade out..."))
-        {
-            return false;
-        }
-    }
-
-    return true;
+        },
+        progress, "Applying fade out...");
 }
 
 //==============================================================================
@@ -732,18 +666,19 @@ bool AudioProcessor::reverseRange(juce::AudioBuffer<float>& buffer, int startSam
     if (buffer.getNumSamples() == 0 || numSamples <= 0) return false;
     if (startSample < 0 || startSample + numSamples > buffer.getNumSamples()) return false;
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        auto* data = buffer.getWritePointer(ch);
-        int left = startSample;
-        int right = startSample + numSamples - 1;
-        while (left < right)
+    // Tiles cover the first half of the range; each swaps its samples with
+    // the mirrored span in the second half, so tiles never overlap.
+    float* const* channels = buffer.getArrayOfWritePointers();
+    const int endSample = startSample + numSamples;
+
+    ParallelChunkExecutor::run(buffer.getNumChannels(), startSample, numSamples / 2,
+        [channels, startSample, endSample](const ParallelChunkExecutor::Tile& tile)
         {
-            std::swap(data[left], data[right]);
-            ++left;
-            --right;
-        }
-    }
+            float* data = channels[tile.channel];
+            float* first = data + tile.startSample;
+            std::swap_ranges(first, first + tile.numSamples,
+                             std::make_reverse_iterator(data + endSample - (tile.startSample - startSample)));
+        });
 
     DBG(juce::String::formatted(
         "AudioProcessor::reverseRange - Reversed samples %d-%d (%d channels)",
@@ -763,10 +698,14 @@ bool AudioProcessor::invertRange(juce::AudioBuffer<float>& buffer, int startSamp
     if (buffer.getNumSamples() == 0 || numSamples <= 0) return false;
     if (startSample < 0 || startSample + numSamples > buffer.getNumSamples()) return false;
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        buffer.applyGain(ch, startSample, numSamples, -1.0f);
-    }
+    float* const* channels = buffer.getArrayOfWritePointers();
+
+    ParallelChunkExecutor::run(buffer.getNumChannels(), startSample, numSamples,
+        [channels](const ParallelChunkExecutor::Tile& tile)
+        {
+            float* data = channels[tile.channel] + tile.startSample;
+            juce::FloatVectorOperations::negate(data, data, tile.numSamples);
+        });
 
     DBG(juce::String::formatted(
         "AudioProcessor::invertRange - Inverted polarity for samples %d-%d (%d channels)",
@@ -775,6 +714,25 @@ bool AudioProcessor::invertRange(juce::AudioBuffer<float>& buffer, int startSamp
     return true;
 }
 
+bool AudioProcessor::swapChannelsRange(juce::AudioBuffer<float>& buffer, int channelA, int channelB,
+                                       int startSample, int numSamples)
+{
+    if (buffer.getNumSamples() == 0 || numSamples <= 0) return false;
+    if (startSample < 0 || startSample + numSamples > buffer.getNumSamples()) return false;
+    if (channelA < 0 || channelB < 0
+        || channelA >= buffer.getNumChannels() || channelB >= buffer.getNumChannels()
+        || channelA == channelB) return false;
+
+    float* a = buffer.getWritePointer(channelA, startSample);
+    std::swap_ranges(a, a + numSamples, buffer.getWritePointer(channelB, startSample));
+
+    DBG(juce::String::formatted(
+        "AudioProcessor::swapChannelsRange - Swapped channels %d/%d for samples %d-%d",
+        channelA, channelB, startSample, startSample + numSamples - 1));
+
+    return true;
+}
+
 //==============================================================================
 // Progress-Enabled Operations
 
@@ -789,67 +747,51 @@ bool AudioProcessor::removeDCOffsetWithProgress(juce::AudioBuffer<float>& buffer
 
     int numSamples = buffer.getNumSamples();
     int numChannels = buffer.getNumChannels();
-    const int chunkSize = 4096;
 
-    // Phase 1: Calculate DC offset for each channel (50% of progress)
-    std::vector<double> dcOffsets(static_cast<size_t>(numChannels), 0.0);
+    // Phase 1: Calculate DC offset for each channel (0-50% of progress).
+    // Parallel reduction: each tile sums its own samples, then the tile sums
+    // are added per channel in tile order, so the result is deterministic.
+    const float* const* readChannels = buffer.getArrayOfReadPointers();
+    std::vector<double> tileSums(static_cast<size_t>(
+        ParallelChunkExecutor::getNumTiles(numChannels, numSamples)), 0.0);
 
-    int processed = 0;
-    while (processed < numSamples)
-    {
-        int chunkSamples = std::min(chunkSize, numSamples - processed);
-
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            const float* channelData = buffer.getReadPointer(ch);
-            for (int i = processed; i < processed + chunkSamples; ++i)
+    if (!ParallelChunkExecutor::run(numChannels, 0, numSamples,
+            [readChannels, &tileSums](const ParallelChunkExecutor::Tile& tile)
             {
-                dcOffsets[static_cast<size_t>(ch)] += channelData[i];
-            }
-        }
-
-        processed += chunkSamples;
-
-        // Report progress (0-50% for analysis)
-        float progressValue = 0.5f * static_cast<float>(processed) / static_cast<float>(numSamples);
-        if (!progress(progressValue, "Analyzing DC offset..."))
-        {
-            return false;
-        }
-    }
-
-    // Calculate average DC offset per channel
-    for (int ch = 0; ch < numChannels; ++ch)
+                const float* channelData = readChannels[tile.channel];
+                double sum = 0.0;
+                for (int i = tile.startSample; i < tile.startSample + tile.numSamples; ++i)
+                {
+                    sum += channelData[i];
+                }
+                tileSums[static_cast<size_t>(tile.index)] = sum;
+            },
+            progress, "Analyzing DC offset...", 0.0f, 0.5f))
     {
-        dcOffsets[static_cast<size_t>(ch)] /= numSamples;
+        return false;
     }
 
-    // Phase 2: Remove DC offset (50-100% of progress)
-    processed = 0;
-    while (processed < numSamples)
+    // Calculate average DC offset per channel (tiles are numbered channel-minor)
+    std::vector<float> dcOffsets(static_cast<size_t>(numChannels), 0.0f);
+    for (int ch = 0; ch < numChannels; ++ch)
     {
-        int chunkSamples = std::min(chunkSize, numSamples - processed);
-
-        for (int ch = 0; ch < numChannels; ++ch)
+        double sum = 0.0;
+        for (size_t t = static_cast<size_t>(ch); t < tileSums.size(); t += static_cast<size_t>(numChannels))
         {
-            float* channelData = buffer.getWritePointer(ch);
-            float offset = static_cast<float>(dcOffsets[static_cast<size_t>(ch)]);
-
-            for (int i = processed; i < processed + chunkSamples; ++i)
-            {
-                channelData[i] -= offset;
-            }
+            sum += tileSums[t];
         }
+        dcOffsets[static_cast<size_t>(ch)] = static_cast<float>(sum / numSamples);
+    }
 
-        processed += chunkSamples;
+    // Phase 2: Remove DC offset (50-100% of progress)
+    float* const* channels = buffer.getArrayOfWritePointers();
 
-        // Report progress (50-100% for removal)
-        float progressValue = 0.5f + 0.5f * static_cast<float>(processed) / static_cast<float>(numSamples);
-        if (!progress(progressValue, "Removing DC offset..."))
+    return ParallelChunkExecutor::run(numChannels, 0, numSamples,
+        [channels, &dcOffsets](const ParallelChunkExecutor::Tile& tile)
         {
-            return false;
-        }
-    }
-
-    return true;
+            juce::FloatVectorOperations::add(channels[tile.channel] + tile.startSample,
+                                             -dcOffsets[static_cast<size_t>(tile.channel)],
+                                             tile.numSamples);
+        },
+        progress, "Removing DC offset...", 0.5f, 1.0f);
 }
@@ -112,6 +112,10 @@ public:
 
     //==============================================================================
     // Progress-Enabled Operations (for long-running tasks)
+    //
+    // These split channels and sample chunks across cores with
+    // ParallelChunkExecutor; the progress callback is still only invoked on
+    // the calling thread.
 
     /**
      * Applies gain adjustment with progress reporting.
@@ -291,6 +295,23 @@ public:
      */
     static bool invertRange(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
 
+    /**
+     * Exchanges two channels over a range (e.g. left/right of a stereo file).
+     * Exact and self-inverse: applying it twice restores the input bit for bit.
+     *
+     * @param buffer Audio buffer to process (modified in place)
+     * @param channelA First channel index
+     * @param channelB Second channel index
+     * @param startSample Starting sample index (0-based)
+     * @param numSamples Number of samples to swap
+     * @return true if successful, false if a channel or the range is invalid
+     *
+     * Thread Safety: Safe to call from any thread
+     * Performance: O(n)
+     */
+    static bool swapChannelsRange(juce::AudioBuffer<float>& buffer, int channelA, int channelB,
+                                  int startSample, int numSamples);
+
     //==============================================================================
     // Utility Functions
 
@@ -0,0 +1,740 @@
+/*
+  ==============================================================================
+
+    AudioSampleStore.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "AudioSampleStore.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <set>
+
+namespace
+{
+    // Scale used by juce::AudioFormatReader (and readMapped) to turn
+    // left-aligned fixed-point samples into float.
+    const float kFixedToFloat = 1.0f / static_cast<float>(0x7fffffff);
+}
+
+//==============================================================================
+// Whole-store operations
+
+void AudioSampleStore::clear()
+{
+    m_pieces.clear();
+    m_pieceStarts.clear();
+    m_totalLength = 0;
+    m_numChannels = 0;
+}
+
+void AudioSampleStore::assign(const juce::AudioBuffer<float>& buffer)
+{
+    // Copy BEFORE clearing: the source may be a view onto one of our own
+    // chunks (AudioBufferManager::setBuffer(getBuffer(), ...)).
+    auto pieces = makePieces(buffer);
+    const int numChannels = buffer.getNumChannels();
+
+    clear();
+    m_numChannels = numChannels;
+    m_pieces = std::move(pieces);
+    rebuildIndex();
+}
+
+void AudioSampleStore::adopt(juce::AudioBuffer<float>&& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int length = buffer.getNumSamples();
+
+    std::vector<Piece> pieces;
+    if (numChannels > 0 && length > 0)
+        pieces.push_back({ std::make_shared<juce::AudioBuffer<float>>(std::move(buffer)), nullptr, 0, length });
+
+    clear();
+    m_numChannels = numChannels;
+    m_pieces = std::move(pieces);
+    rebuildIndex();
+}
+
+bool AudioSampleStore::loadFromReader(juce::AudioFormatReader& reader)
+{
+    clear();
+
+    const int numChannels = static_cast<int>(reader.numChannels);
+    const int64_t length = reader.lengthInSamples;
+
+    if (numChannels <= 0 || length < 0)
+        return false;
+
+    std::vector<Piece> pieces;
+    pieces.reserve(static_cast<size_t>((length + kChunkSamples - 1) / kChunkSamples));
+
+    for (int64_t position = 0; position < length; position += kChunkSamples)
+    {
+        const int blockLength = static_cast<int>(juce::jmin<int64_t>(kChunkSamples, length - position));
+        auto chunk = std::make_shared<juce::AudioBuffer<float>>(numChannels, blockLength);
+
+        if (! reader.read(chunk.get(), 0, blockLength, position, true, true))
+        {
+            juce::Logger::writeToLog("AudioSampleStore::loadFromReader: read failed at sample "
+                                     + juce::String(position));
+            return false;
+        }
+
+        if (auto packed = pack(*chunk, static_cast<int>(reader.bitsPerSample)))
+            pieces.push_back({ nullptr, nullptr, 0, blockLength, std::move(packed) });
+        else
+            pieces.push_back({ std::move(chunk), nullptr, 0, blockLength });
+    }
+
+    m_numChannels = numChannels;
+    m_pieces = std::move(pieces);
+    rebuildIndex();
+    return true;
+}
+
+void AudioSampleStore::loadFromMappedReader(std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader)
+{
+    clear();
+
+    if (reader == nullptr || reader->numChannels == 0 || reader->lengthInSamples <= 0)
+        return;
+
+    m_numChannels = static_cast<int>(reader->numChannels);
+    const int64_t length = reader->lengthInSamples;
+
+    m_pieces.push_back({ nullptr, MappedPtr(std::move(reader)), 0, length });
+    rebuildIndex();
+}
+
+bool AudioSampleStore::append(ChunkPtr chunk)
+{
+    if (chunk == nullptr || chunk->getNumSamples() == 0)
+        return true;
+
+    if (m_pieces.empty())
+        m_numChannels = chunk->getNumChannels();
+    else if (chunk->getNumChannels() != m_numChannels)
+        return false;
+
+    const int64_t length = chunk->getNumSamples();
+
+    // Only the tail changes, so extend the index instead of rebuilding it.
+    m_pieceStarts.push_back(m_totalLength);
+    m_pieces.push_back({ std::move(chunk), nullptr, 0, length });
+    m_totalLength += length;
+    return true;
+}
+
+bool AudioSampleStore::appendPacked(const juce::AudioBuffer<float>& audio, int bitsPerSample)
+{
+    if (! m_pieces.empty() && audio.getNumChannels() != m_numChannels)
+        return false;
+
+    auto packed = pack(audio, bitsPerSample);
+    if (packed == nullptr)
+        return false;
+
+    if (m_pieces.empty())
+        m_numChannels = packed->numChannels;
+
+    const int64_t length = packed->numSamples;
+
+    m_pieceStarts.push_back(m_totalLength);
+    m_pieces.push_back({ nullptr, nullptr, 0, length, std::move(packed) });
+    m_totalLength += length;
+    return true;
+}
+
+bool AudioSampleStore::hasMappedPieces() const
+{
+    return std::any_of(m_pieces.begin(), m_pieces.end(),
+                       [](const Piece& piece) { return piece.mapped != nullptr; });
+}
+
+bool AudioSampleStore::materialiseMappedPieces()
+{
+    if (! hasMappedPieces())
+        return true;
+
+    std::vector<Piece> pieces;
+    pieces.reserve(m_pieces.size());
+
+    for (const auto& piece : m_pieces)
+    {
+        if (piece.mapped == nullptr)
+        {
+            pieces.push_back(piece);
+            continue;
+        }
+
+        for (int64_t done = 0; done < piece.length; done += kChunkSamples)
+        {
+            const int blockLength = static_cast<int>(juce::jmin<int64_t>(kChunkSamples, piece.length - done));
+            auto chunk = std::make_shared<juce::AudioBuffer<float>>(m_numChannels, blockLength);
+
+            if (! readMapped(piece, chunk->getArrayOfWritePointers(), m_numChannels, done, blockLength))
+                return false;
+
+            pieces.push_back({ std::move(chunk), nullptr, 0, blockLength });
+        }
+    }
+
+    m_pieces = std::move(pieces);
+    rebuildIndex();
+    return true;
+}
+
+int64_t AudioSampleStore::getResidentBytes() const
+{
+    std::set<const void*> seen;
+    int64_t bytes = 0;
+
+    for (const auto& piece : m_pieces)
+    {
+        if (piece.chunk != nullptr && seen.insert(piece.chunk.get()).second)
+        {
+            bytes += static_cast<int64_t>(piece.chunk->getNumChannels())
+                   * piece.chunk->getNumSamples() * static_cast<int64_t>(sizeof(float));
+        }
+        else if (piece.packed != nullptr && seen.insert(piece.packed.get()).second)
+        {
+            bytes += static_cast<int64_t>(piece.packed->numChannels)
+                   * piece.packed->numSamples * piece.packed->bytesPerSample;
+        }
+    }
+
+    return bytes;
+}
+
+//==============================================================================
+// Range reader
+
+bool AudioSampleStore::read(juce::AudioBuffer<float>& dest, int destStart,
+                            int64_t sourceStart, int numSamples) const
+{
+    if (numSamples == 0)
+        return true;
+
+    if (numSamples < 0 || sourceStart < 0 || sourceStart + numSamples > m_totalLength
+        || destStart < 0 || destStart + numSamples > dest.getNumSamples())
+    {
+        return false;
+    }
+
+    const int channels = juce::jmin(dest.getNumChannels(), m_numChannels);
+
+    // Playback reads through here, so only files wider than
+    // kMaxStackChannels pay for a heap allocation.
+    float* stackDests[kMaxStackChannels];
+    std::vector<float*> heapDests;
+    float** dests = stackDests;
+    if (channels > kMaxStackChannels)
+    {
+        heapDests.resize(static_cast<size_t>(channels));
+        dests = heapDests.data();
+    }
+
+    size_t index = findPiece(sourceStart);
+    int64_t position = sourceStart;
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        const Piece& piece = m_pieces[index];
+        const int64_t offsetInPiece = position - m_pieceStarts[index];
+        const int count = static_cast<int>(juce::jmin<int64_t>(numSamples - done, piece.length - offsetInPiece));
+
+        if (piece.chunk != nullptr)
+        {
+            for (int ch = 0; ch < channels; ++ch)
+                dest.copyFrom(ch, destStart + done, *piece.chunk, ch,
+                              static_cast<int>(piece.offset + offsetInPiece), count);
+        }
+        else
+        {
+            for (int ch = 0; ch < channels; ++ch)
+                dests[ch] = dest.getWritePointer(ch, destStart + done);
+
+            if (piece.packed != nullptr)
+                readPacked(piece, dests, channels, offsetInPiece, count);
+            else if (! readMapped(piece, dests, channels, offsetInPiece, count))
+                return false;
+        }
+
+        done += count;
+        position += count;
+        ++index;
+    }
+
+    return true;
+}
+
+bool AudioSampleStore::readChannel(int channel, float* dest, int64_t sourceStart, int numSamples) const
+{
+    if (numSamples == 0)
+        return true;
+
+    if (dest == nullptr || channel < 0 || channel >= m_numChannels || numSamples < 0
+        || sourceStart < 0 || sourceStart + numSamples > m_totalLength)
+    {
+        return false;
+    }
+
+    size_t index = findPiece(sourceStart);
+    int64_t position = sourceStart;
+    int done = 0;
+
+    float* stackDests[kMaxStackChannels] = {};
+    std::vector<float*> heapDests;
+    float** dests = stackDests;
+    if (m_numChannels > kMaxStackChannels)
+    {
+        heapDests.assign(static_cast<size_t>(m_numChannels), nullptr);
+        dests = heapDests.data();
+    }
+
+    while (done < numSamples)
+    {
+        const Piece& piece = m_pieces[index];
+        const int64_t offsetInPiece = position - m_pieceStarts[index];
+        const int count = static_cast<int>(juce::jmin<int64_t>(numSamples - done, piece.length - offsetInPiece));
+
+        if (piece.chunk != nullptr)
+        {
+            juce::FloatVectorOperations::copy(dest + done,
+                                              piece.chunk->getReadPointer(channel, static_cast<int>(piece.offset + offsetInPiece)),
+                                              count);
+        }
+        else
+        {
+            dests[channel] = dest + done;
+
+            if (piece.packed != nullptr)
+                readPacked(piece, dests, m_numChannels, offsetInPiece, count);
+            else if (! readMapped(piece, dests, m_numChannels, offsetInPiece, count))
+                return false;
+        }
+
+        done += count;
+        position += count;
+        ++index;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Structural edits
+
+bool AudioSampleStore::erase(int64_t start, int64_t numSamples)
+{
+    if (start < 0 || numSamples <= 0 || start + numSamples > m_totalLength)
+        return false;
+
+    const size_t first = splitAt(start);
+    const size_t last = splitAt(start + numSamples);
+
+    m_pieces.erase(m_pieces.begin() + static_cast<std::ptrdiff_t>(first),
+                   m_pieces.begin() + static_cast<std::ptrdiff_t>(last));
+    rebuildIndex();
+    compactIfFragmented();
+    return true;
+}
+
+bool AudioSampleStore::insert(int64_t position, const juce::AudioBuffer<float>& audio)
+{
+    if (position < 0 || position > m_totalLength)
+        return false;
+
+    if (audio.getNumChannels() != m_numChannels)
+        return false;
+
+    if (audio.getNumSamples() == 0)
+        return true;
+
+    auto newPieces = makePieces(audio);
+    const size_t at = splitAt(position);
+
+    m_pieces.insert(m_pieces.begin() + static_cast<std::ptrdiff_t>(at),
+                    std::make_move_iterator(newPieces.begin()),
+                    std::make_move_iterator(newPieces.end()));
+    rebuildIndex();
+    compactIfFragmented();
+    return true;
+}
+
+bool AudioSampleStore::insert(int64_t position, const AudioSampleStore& audio)
+{
+    if (position < 0 || position > m_totalLength)
+        return false;
+
+    if (audio.isEmpty())
+        return true;
+
+    if (m_pieces.empty())
+        m_numChannels = audio.getNumChannels();
+    else if (audio.getNumChannels() != m_numChannels)
+        return false;
+
+    // Copied first, so inserting a store into itself is safe.
+    auto newPieces = audio.m_pieces;
+    const size_t at = splitAt(position);
+
+    m_pieces.insert(m_pieces.begin() + static_cast<std::ptrdiff_t>(at),
+                    std::make_move_iterator(newPieces.begin()),
+                    std::make_move_iterator(newPieces.end()));
+    rebuildIndex();
+    compactIfFragmented();
+    return true;
+}
+
+bool AudioSampleStore::replace(int64_t start, int64_t numSamples, const juce::AudioBuffer<float>& audio)
+{
+    if (start < 0 || numSamples <= 0 || start + numSamples > m_totalLength)
+        return false;
+
+    // A zero-length replacement is a pure delete and skips the channel check.
+    if (audio.getNumSamples() > 0 && audio.getNumChannels() != m_numChannels)
+        return false;
+
+    auto newPieces = makePieces(audio);
+    const size_t first = splitAt(start);
+    const size_t last = splitAt(start + numSamples);
+
+    auto insertPoint = m_pieces.erase(m_pieces.begin() + static_cast<std::ptrdiff_t>(first),
+                                      m_pieces.begin() + static_cast<std::ptrdiff_t>(last));
+    m_pieces.insert(insertPoint,
+                    std::make_move_iterator(newPieces.begin()),
+                    std::make_move_iterator(newPieces.end()));
+    rebuildIndex();
+    compactIfFragmented();
+    return true;
+}
+
+bool AudioSampleStore::trim(int64_t start, int64_t numSamples)
+{
+    if (start < 0 || numSamples <= 0 || start + numSamples > m_totalLength)
+        return false;
+
+    const size_t first = splitAt(start);
+    const size_t last = splitAt(start + numSamples);
+
+    m_pieces.erase(m_pieces.begin() + static_cast<std::ptrdiff_t>(last), m_pieces.end());
+    m_pieces.erase(m_pieces.begin(), m_pieces.begin() + static_cast<std::ptrdiff_t>(first));
+    rebuildIndex();
+    return true;
+}
+
+//==============================================================================
+// Consolidation
+
+AudioSampleStore::ChunkPtr AudioSampleStore::consolidate()
+{
+    if (isEmpty())
+        return nullptr;
+
+    if (m_totalLength > static_cast<int64_t>(std::numeric_limits<int>::max()))
+        return nullptr;
+
+    if (m_pieces.size() == 1)
+    {
+        const Piece& only = m_pieces.front();
+        if (only.chunk != nullptr
+            && only.offset == 0
+            && only.length == only.chunk->getNumSamples())
+        {
+            return only.chunk;
+        }
+    }
+
+    const int length = static_cast<int>(m_totalLength);
+    auto chunk = std::make_shared<juce::AudioBuffer<float>>(m_numChannels, length);
+    read(*chunk, 0, 0, length);
+
+    m_pieces.clear();
+    m_pieces.push_back({ chunk, nullptr, 0, length });
+    rebuildIndex();
+    return chunk;
+}
+
+AudioSampleStore::ChunkPtr AudioSampleStore::consolidateExclusive()
+{
+    auto chunk = consolidate();
+
+    // Store piece + the local 'chunk' = 2 references when nothing else holds it.
+    if (chunk == nullptr || chunk.use_count() <= 2)
+        return chunk;
+
+    auto copy = std::make_shared<juce::AudioBuffer<float>>();
+    copy->makeCopyOf(*chunk);
+
+    m_pieces.front().chunk = copy;
+    return copy;
+}
+
+bool AudioSampleStore::isConsolidated() const
+{
+    if (m_pieces.size() != 1)
+        return false;
+
+    const Piece& only = m_pieces.front();
+    return only.chunk != nullptr
+        && only.offset == 0
+        && only.length == only.chunk->getNumSamples();
+}
+
+bool AudioSampleStore::isExclusivelyConsolidated() const
+{
+    return isConsolidated() && m_pieces.front().chunk.use_count() == 1;
+}
+
+void AudioSampleStore::compactIfFragmented()
+{
+    if (m_pieces.size() <= static_cast<size_t>(kMaxPiecesBeforeCompact))
+        return;
+
+    std::vector<Piece> compacted;
+    compacted.reserve(m_pieces.size());
+
+    size_t i = 0;
+    while (i < m_pieces.size())
+    {
+        // Gather a run of adjacent short pieces, bounded by kChunkSamples.
+        size_t runEnd = i;
+        int64_t runLength = 0;
+        while (runEnd < m_pieces.size()
+               && m_pieces[runEnd].length < kShortPieceSamples
+               && runLength + m_pieces[runEnd].length <= kChunkSamples)
+        {
+            runLength += m_pieces[runEnd].length;
+            ++runEnd;
+        }
+
+        if (runEnd - i < 2)
+        {
+            // Long piece, or a lone short one: nothing to merge.
+            compacted.push_back(m_pieces[i]);
+            ++i;
+            continue;
+        }
+
+        const int length = static_cast<int>(runLength);
+        auto chunk = std::make_shared<juce::AudioBuffer<float>>(m_numChannels, length);
+        read(*chunk, 0, m_pieceStarts[i], length);
+        compacted.push_back({ std::move(chunk), nullptr, 0, length });
+        i = runEnd;
+    }
+
+    m_pieces = std::move(compacted);
+    rebuildIndex();
+}
+
+//==============================================================================
+// Private helpers
+
+size_t AudioSampleStore::findPiece(int64_t position) const
+{
+    jassert(position >= 0 && position < m_totalLength);
+
+    const auto it = std::upper_bound(m_pieceStarts.begin(), m_pieceStarts.end(), position);
+    return static_cast<size_t>(std::distance(m_pieceStarts.begin(), it)) - 1;
+}
+
+size_t AudioSampleStore::splitAt(int64_t position)
+{
+    if (position >= m_totalLength)
+        return m_pieces.size();
+
+    const size_t index = findPiece(position);
+    const int64_t pieceStart = m_pieceStarts[index];
+
+    if (pieceStart == position)
+        return index;
+
+    // Both halves keep referencing the same chunk; no samples are copied.
+    const int64_t leftLength = position - pieceStart;
+    Piece right = m_pieces[index];
+    right.offset += leftLength;
+    right.length -= leftLength;
+    m_pieces[index].length = leftLength;
+
+    m_pieces.insert(m_pieces.begin() + static_cast<std::ptrdiff_t>(index + 1), std::move(right));
+    m_pieceStarts.insert(m_pieceStarts.begin() + static_cast<std::ptrdiff_t>(index + 1), position);
+    return index + 1;
+}
+
+bool AudioSampleStore::readMapped(const Piece& piece, float* const* dests, int numDests,
+                                  int64_t offsetInPiece, int count)
+{
+    auto& reader = *piece.mapped;
+
+    // AudioFormatReader writes fixed-point ints (or raw floats) into the
+    // destination and leaves the float conversion to the caller, exactly as
+    // AudioFormatReader::read(AudioBuffer*) does internally.
+    if (! reader.read(reinterpret_cast<int* const*>(dests), numDests,
+                      piece.offset + offsetInPiece, count, false))
+    {
+        return false;
+    }
+
+    if (! reader.usesFloatingPointData)
+    {
+        for (int ch = 0; ch < numDests; ++ch)
+        {
+            if (float* d = dests[ch])
+                juce::FloatVectorOperations::convertFixedToFloat(d, reinterpret_cast<const int*>(d),
+                                                                 kFixedToFloat, count);
+        }
+    }
+
+    return true;
+}
+
+void AudioSampleStore::readPacked(const Piece& piece, float* const* dests, int numDests,
+                                  int64_t offsetInPiece, int count)
+{
+    const PackedChunk& packed = *piece.packed;
+    const int bytes = packed.bytesPerSample;
+    const size_t first = static_cast<size_t>(piece.offset + offsetInPiece);
+
+    for (int ch = 0; ch < numDests; ++ch)
+    {
+        float* d = dests[ch];
+        if (d == nullptr)
+            continue;
+
+        // Rebuild the left-aligned int a PCM reader produces, then convert it
+        // with the same scale so packed and float pieces read identically.
+        auto* asInt = reinterpret_cast<int*>(d);
+        const uint8_t* src = packed.getChannel(ch) + first * static_cast<size_t>(bytes);
+
+        if (bytes == 2)
+        {
+            for (int i = 0; i < count; ++i, src += 2)
+            {
+                int16_t value;
+                std::memcpy(&value, src, sizeof(value));
+                asInt[i] = static_cast<int>(value) * 65536;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < count; ++i, src += 3)
+                asInt[i] = static_cast<int>(static_cast<uint32_t>(src[0]) << 8
+                                            | static_cast<uint32_t>(src[1]) << 16
+                                            | static_cast<uint32_t>(src[2]) << 24);
+        }
+
+        juce::FloatVectorOperations::convertFixedToFloat(d, asInt, kFixedToFloat, count);
+    }
+}
+
+std::shared_ptr<AudioSampleStore::PackedChunk> AudioSampleStore::pack(const juce::AudioBuffer<float>& audio,
+                                                                      int bitsPerSample)
+{
+    if (bitsPerSample != 16 && bitsPerSample != 24)
+        return nullptr;
+
+    const int numChannels = audio.getNumChannels();
+    const int numSamples = audio.getNumSamples();
+    if (numChannels == 0 || numSamples == 0)
+        return nullptr;
+
+    const int bytes = bitsPerSample / 8;
+    const int step = 1 << (32 - bitsPerSample);   // left-alignment of one LSB
+    const int maxValue = (1 << (bitsPerSample - 1)) - 1;
+    const double floatToValue = static_cast<double>(0x7fffffff) / static_cast<double>(step);
+
+    auto packed = std::make_shared<PackedChunk>();
+    packed->numChannels = numChannels;
+    packed->numSamples = numSamples;
+    packed->bytesPerSample = bytes;
+    packed->data.malloc(static_cast<size_t>(numChannels) * static_cast<size_t>(numSamples)
+                        * static_cast<size_t>(bytes));
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const float* src = audio.getReadPointer(ch);
+        uint8_t* dst = packed->data.get() + static_cast<size_t>(ch) * static_cast<size_t>(numSamples)
+                                               * static_cast<size_t>(bytes);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int value = juce::roundToInt(static_cast<double>(src[i]) * floatToValue);
+
+            // Anything that isn't exactly a source-width sample (gain applied,
+            // lossy decode, float file) stays float.
+            if (value > maxValue || value < -maxValue - 1
+                || static_cast<float>(value * step) * kFixedToFloat != src[i])
+            {
+                return nullptr;
+            }
+
+            if (bytes == 2)
+            {
+                const auto v16 = static_cast<int16_t>(value);
+                std::memcpy(dst, &v16, sizeof(v16));
+                dst += 2;
+            }
+            else
+            {
+                const auto bits = static_cast<uint32_t>(value);
+                *dst++ = static_cast<uint8_t>(bits);
+                *dst++ = static_cast<uint8_t>(bits >> 8);
+                *dst++ = static_cast<uint8_t>(bits >> 16);
+            }
+        }
+    }
+
+    return packed;
+}
+
+std::vector<AudioSampleStore::Piece> AudioSampleStore::makePieces(const juce::AudioBuffer<float>& audio) const
+{
+    std::vector<Piece> pieces;
+
+    const int numChannels = audio.getNumChannels();
+    const int length = audio.getNumSamples();
+
+    if (numChannels == 0 || length == 0)
+        return pieces;
+
+    for (int64_t position = 0; position < length; position += kChunkSamples)
+    {
+        const int start = static_cast<int>(position);
+        const int blockLength = juce::jmin(kChunkSamples, length - start);
+        auto chunk = std::make_shared<juce::AudioBuffer<float>>(numChannels, blockLength);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            chunk->copyFrom(ch, 0, audio, ch, start, blockLength);
+
+        pieces.push_back({ std::move(chunk), nullptr, 0, blockLength });
+    }
+
+    return pieces;
+}
+
+void AudioSampleStore::rebuildIndex()
+{
+    m_pieceStarts.resize(m_pieces.size());
+
+    int64_t position = 0;
+    for (size_t i = 0; i < m_pieces.size(); ++i)
+    {
+        m_pieceStarts[i] = position;
+        position += m_pieces[i].length;
+    }
+
+    m_totalLength = position;
+}
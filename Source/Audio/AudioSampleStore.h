@@ -0,0 +1,296 @@
+/*
+  ==============================================================================
+
+    AudioSampleStore.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <memory>
+#include <vector>
+
+/**
+ * Chunked, reference-counted piece table holding a document's samples.
+ *
+ * The audio lives in immutable chunks (each an AudioBuffer<float> of at most
+ * kChunkSamples frames). The document is an ordered list of pieces, each a
+ * (chunk, offset, length) window onto one chunk. Structural edits -- delete,
+ * insert, replace, trim -- only split and splice the piece list, so their cost
+ * is O(pieces) plus the size of any NEW audio, never O(file length). Removed
+ * audio is freed when the last piece referencing its chunk goes away.
+ *
+ * Positions and lengths are 64-bit throughout, so a document is not limited to
+ * the 2^31 frames a single juce::AudioBuffer can address; only an individual
+ * chunk is int-indexed.
+ *
+ * A piece may also refer to a memory-mapped PCM file instead of a chunk
+ * (loadFromMappedReader). Those frames are paged in by the OS on demand and
+ * converted to float only when read; edits materialise just the touched
+ * range as float chunks, leaving the rest of the file mapped.
+ *
+ * Decoded audio from 16/24-bit sources (FLAC, ...) is likewise kept packed in
+ * its source PCM width (appendPacked), which halves the RAM of unedited
+ * 16-bit material. Only edited audio is held as float.
+ *
+ * Copying a store copies only the piece list, never the samples: both
+ * copies share every chunk, and neither ever writes to a chunk the other can
+ * see (see isExclusivelyConsolidated()). AudioSnapshot relies on this to
+ * publish an edit in O(pieces).
+ *
+ * Not thread-safe: the owner (AudioBufferManager) serialises access. A copy
+ * that nobody modifies may be read from several threads at once, and read()
+ * does not allocate, so it is safe on the audio thread.
+ */
+class AudioSampleStore
+{
+public:
+    /** Largest chunk created when ingesting from a reader (~21 s at 48 kHz). */
+    static constexpr int kChunkSamples = 1 << 20;
+
+    using ChunkPtr = std::shared_ptr<juce::AudioBuffer<float>>;
+
+    AudioSampleStore() = default;
+    AudioSampleStore(const AudioSampleStore&) = default;
+    AudioSampleStore& operator=(const AudioSampleStore&) = default;
+
+    //==============================================================================
+    // Whole-store operations
+
+    /** Removes all audio and resets the channel count to 0. */
+    void clear();
+
+    /** Replaces the contents with a copy of the given buffer. */
+    void assign(const juce::AudioBuffer<float>& buffer);
+
+    /**
+     * Replaces the contents with the given buffer without copying. The store
+     * takes ownership of the sample memory (the buffer is moved from).
+     */
+    void adopt(juce::AudioBuffer<float>&& buffer);
+
+    /**
+     * Replaces the contents by decoding a reader in kChunkSamples blocks.
+     * Supports readers longer than INT_MAX frames.
+     *
+     * @return false if the reader failed; the store is left empty.
+     */
+    bool loadFromReader(juce::AudioFormatReader& reader);
+
+    /**
+     * Replaces the contents with a single piece backed by a memory-mapped
+     * reader; nothing is decoded up front. The reader must already have
+     * mapped its sample data (mapEntireFile()). The store owns the reader
+     * until the last piece referring to it is removed.
+     */
+    void loadFromMappedReader(std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader);
+
+    /**
+     * Appends a chunk to the end of the document without copying it; used by
+     * progressive loading. The store shares ownership, so the caller must not
+     * write to the chunk afterwards. The channel count must match unless the
+     * store is empty.
+     */
+    bool append(ChunkPtr chunk);
+
+    /**
+     * As append(), but stores the frames in their source PCM width (16 or 24
+     * bits) instead of float. Only done when lossless: every sample must
+     * convert back to exactly the float a PCM reader would have produced.
+     *
+     * @return false if the block cannot be packed (float or lossy source,
+     *         unsupported width, channel mismatch); nothing is appended and
+     *         the caller should append() the float block instead.
+     */
+    bool appendPacked(const juce::AudioBuffer<float>& audio, int bitsPerSample);
+
+    /** True while any piece still refers to a memory-mapped file. */
+    bool hasMappedPieces() const;
+
+    /**
+     * Decodes every memory-mapped piece into float chunks (kChunkSamples
+     * each), leaving in-memory and packed pieces as they are. Afterwards the
+     * store no longer reads from any file, though copies made earlier still
+     * do.
+     *
+     * @return false if a mapped read failed; the store is then unchanged.
+     */
+    bool materialiseMappedPieces();
+
+    //==============================================================================
+    // Properties
+
+    int getNumChannels() const { return m_numChannels; }
+    int64_t getNumSamples() const { return m_totalLength; }
+    bool isEmpty() const { return m_totalLength == 0 || m_numChannels == 0; }
+
+    /** Number of pieces in the table (diagnostics / fragmentation checks). */
+    int getNumPieces() const { return static_cast<int>(m_pieces.size()); }
+
+    /**
+     * Heap bytes of the float and packed chunks the table references, each
+     * counted once however many pieces share it. Memory-mapped ranges are
+     * not counted: the OS can drop those pages at any time.
+     */
+    int64_t getResidentBytes() const;
+
+    //==============================================================================
+    // Range reader
+
+    /**
+     * Copies [sourceStart, sourceStart + numSamples) into dest starting at
+     * destStart. Channels are mapped one-to-one up to the smaller channel count.
+     *
+     * @return false if the source range is out of bounds or dest is too small.
+     */
+    bool read(juce::AudioBuffer<float>& dest, int destStart,
+              int64_t sourceStart, int numSamples) const;
+
+    /** Single-channel variant of read() for analysis that touches one channel. */
+    bool readChannel(int channel, float* dest, int64_t sourceStart, int numSamples) const;
+
+    //==============================================================================
+    // Structural edits (O(pieces) + size of inserted audio)
+
+    /** Removes [start, start + numSamples). */
+    bool erase(int64_t start, int64_t numSamples);
+
+    /** Inserts a copy of audio at position. Channel count must match. */
+    bool insert(int64_t position, const juce::AudioBuffer<float>& audio);
+
+    /**
+     * Inserts all of another store's pieces at position, sharing their
+     * chunks (O(pieces), no samples copied). Channel count must match unless
+     * this store is empty, in which case it takes on audio's.
+     */
+    bool insert(int64_t position, const AudioSampleStore& audio);
+
+    /**
+     * Replaces [start, start + numSamples) with a copy of audio (which may be
+     * a different length). Validated up front; nothing is mutated on failure.
+     */
+    bool replace(int64_t start, int64_t numSamples, const juce::AudioBuffer<float>& audio);
+
+    /** Keeps only [start, start + numSamples). */
+    bool trim(int64_t start, int64_t numSamples);
+
+    //==============================================================================
+    // Consolidation
+
+    /**
+     * Collapses the piece table into a single chunk holding every frame, and
+     * returns it. Returns the existing chunk without copying when the table
+     * already is a single full-length in-memory piece. Returns nullptr if the
+     * document is empty or longer than INT_MAX frames.
+     *
+     * The chunk may be shared with published AudioSnapshots, so it must be
+     * treated as read-only; use consolidateExclusive() before writing.
+     */
+    ChunkPtr consolidate();
+
+    /**
+     * As consolidate(), but additionally guarantees that nothing outside the
+     * store references the returned chunk, copying it if necessary
+     * (copy-on-write). The caller may then write into it in place; this is
+     * the legacy contiguous-buffer path behind
+     * AudioBufferManager::getMutableBuffer().
+     */
+    ChunkPtr consolidateExclusive();
+
+    /** True if the table is one full in-memory float chunk (possibly shared). */
+    bool isConsolidated() const;
+
+    /** True if the table is one full chunk that only the store references. */
+    bool isExclusivelyConsolidated() const;
+
+    /**
+     * If the table has no more pieces than kMaxPiecesBeforeCompact this does
+     * nothing; otherwise runs of adjacent short pieces are merged into fresh
+     * chunks so lookups stay cheap after long editing sessions.
+     */
+    void compactIfFragmented();
+
+private:
+    using MappedPtr = std::shared_ptr<juce::MemoryMappedAudioFormatReader>;
+
+    /** Immutable frames in their source PCM width; see appendPacked(). */
+    struct PackedChunk
+    {
+        int numChannels = 0;
+        int numSamples = 0;
+        int bytesPerSample = 0;          // 2 (16-bit) or 3 (24-bit)
+        juce::HeapBlock<uint8_t> data;   // planar, one numSamples run per channel
+
+        const uint8_t* getChannel(int channel) const
+        {
+            return data.get() + static_cast<size_t>(channel) * static_cast<size_t>(numSamples)
+                                    * static_cast<size_t>(bytesPerSample);
+        }
+    };
+
+    using PackedPtr = std::shared_ptr<const PackedChunk>;
+
+    struct Piece
+    {
+        ChunkPtr chunk;          // in-memory float frames, or
+        MappedPtr mapped;        // frames still in the mapped source file, or
+        int64_t offset = 0;      // first frame inside chunk / file / packed
+        int64_t length = 0;      // frames
+        PackedPtr packed;        // frames packed in the source PCM width
+    };
+
+    static constexpr int kMaxPiecesBeforeCompact = 1024;
+    static constexpr int kShortPieceSamples = 4096;
+
+    /** Channel pointers read() keeps on the stack; wider files fall back to the heap. */
+    static constexpr int kMaxStackChannels = 64;
+
+    /** Index of the piece containing position (position < total length). */
+    size_t findPiece(int64_t position) const;
+
+    /**
+     * Ensures a piece boundary exists at position and returns the index of the
+     * piece that starts there (m_pieces.size() when position == total length).
+     */
+    size_t splitAt(int64_t position);
+
+    /**
+     * Converts count frames of a mapped piece, starting offsetInPiece frames
+     * in, into float. dests[ch] may be nullptr to skip a channel.
+     */
+    static bool readMapped(const Piece& piece, float* const* dests, int numDests,
+                           int64_t offsetInPiece, int count);
+
+    /** readMapped() for packed pieces; cannot fail. */
+    static void readPacked(const Piece& piece, float* const* dests, int numDests,
+                           int64_t offsetInPiece, int count);
+
+    /**
+     * Packs audio into bitsPerSample-wide integers, or returns nullptr if the
+     * width is unsupported or any sample would not round-trip exactly.
+     */
+    static std::shared_ptr<PackedChunk> pack(const juce::AudioBuffer<float>& audio, int bitsPerSample);
+
+    /** Builds pieces (and chunks) holding a copy of audio, kChunkSamples each. */
+    std::vector<Piece> makePieces(const juce::AudioBuffer<float>& audio) const;
+
+    /** Recomputes m_pieceStarts and m_totalLength after the piece list changed. */
+    void rebuildIndex();
+
+    std::vector<Piece> m_pieces;
+    std::vector<int64_t> m_pieceStarts;  // m_pieceStarts[i] = document position of m_pieces[i]
+    int64_t m_totalLength = 0;
+    int m_numChannels = 0;
+
+    JUCE_LEAK_DETECTOR(AudioSampleStore)
+};
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    AudioSnapshot.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "AudioSampleStore.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+class AudioSnapshot;
+using AudioSnapshotPtr = std::shared_ptr<const AudioSnapshot>;
+
+/**
+ * Immutable, versioned view of a document's audio at one point in time.
+ *
+ * AudioBufferManager publishes a snapshot after each edit; the playback
+ * source (AudioEngine) and the direct renderer (WaveformDisplay) keep a
+ * reference to it instead of deep-copying the samples. A snapshot is a
+ * frozen copy of the document's piece list (see AudioSampleStore): it shares
+ * every chunk, packed block and mapped file with the editor, so publishing
+ * an edit costs O(pieces) whatever the document's length, and documents
+ * longer than INT_MAX samples publish like any other.
+ *
+ * The samples must never change while a snapshot refers to them. The buffer
+ * manager enforces this with copy-on-write: an in-place edit on a chunk that
+ * a snapshot still shares first moves the editor onto a private copy.
+ *
+ * Read through readRange()/readChannelRange(). Both are const, lock-free and
+ * allocation-free, so any number of threads (including the audio thread) may
+ * read one snapshot at once.
+ *
+ * The version increases with every edit of the owning document, so holders
+ * can tell cheaply whether the audio they cached is still current.
+ */
+class AudioSnapshot
+{
+public:
+    AudioSnapshot(const AudioSampleStore& store, double sampleRate, uint64_t version)
+        : m_store(store),
+          m_sampleRate(sampleRate),
+          m_version(version)
+    {
+    }
+
+    /**
+     * Wraps a standalone buffer (previews, freshly rendered audio) without
+     * copying its samples. Returns nullptr for an empty buffer.
+     */
+    static AudioSnapshotPtr fromBuffer(juce::AudioBuffer<float>&& buffer, double sampleRate)
+    {
+        if (buffer.getNumChannels() == 0 || buffer.getNumSamples() == 0)
+            return nullptr;
+
+        AudioSampleStore store;
+        store.adopt(std::move(buffer));
+        return std::make_shared<const AudioSnapshot>(store, sampleRate, 0);
+    }
+
+    /** See AudioSampleStore::read(). */
+    bool readRange(juce::AudioBuffer<float>& dest, int destStartSample,
+                   int64_t sourceStartSample, int numSamples) const
+    {
+        return m_store.read(dest, destStartSample, sourceStartSample, numSamples);
+    }
+
+    /** See AudioSampleStore::readChannel(). */
+    bool readChannelRange(int channel, float* dest, int64_t sourceStartSample, int numSamples) const
+    {
+        return m_store.readChannel(channel, dest, sourceStartSample, numSamples);
+    }
+
+    int getNumChannels() const { return m_store.getNumChannels(); }
+    int64_t getNumSamples() const { return m_store.getNumSamples(); }
+    double getSampleRate() const { return m_sampleRate; }
+    uint64_t getVersion() const { return m_version; }
+
+    /**
+     * True if some of the audio is still read from a memory-mapped file, so
+     * a read may block on disk. Playback then reads ahead on a background
+     * thread rather than on the audio thread.
+     */
+    bool isFileBacked() const { return m_store.hasMappedPieces(); }
+
+private:
+    const AudioSampleStore m_store;
+    const double m_sampleRate;
+    const uint64_t m_version;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioSnapshot)
+};
+
+//==============================================================================
+/**
+ * The span of a document's audio that one edit (or its undo) changed.
+ *
+ * oldLength samples starting at startSample were replaced by newLength
+ * samples; everything before startSample is untouched and everything after
+ * moved by getLengthDelta(). An in-place edit (gain, fade, silence, ...) has
+ * oldLength == newLength. Holders of the previous snapshot use this to
+ * refresh only what changed instead of reloading the whole file.
+ */
+struct AudioEditRange
+{
+    int64_t startSample = 0;
+    int64_t oldLength = 0;
+    int64_t newLength = 0;
+
+    /** An edit that rewrote numSamples samples without moving anything. */
+    static AudioEditRange inPlace(int64_t startSample, int64_t numSamples)
+    {
+        return { startSample, numSamples, numSamples };
+    }
+
+    int64_t getLengthDelta() const { return newLength - oldLength; }
+    bool changesLength() const { return newLength != oldLength; }
+
+    /**
+     * Where a position in the old audio lands in the new audio: unchanged
+     * before the edit, shifted by getLengthDelta() after it, and clamped to
+     * the new span inside it. Playback uses this to keep playing the same
+     * material across an edit that inserted or removed samples.
+     */
+    int64_t remapPosition(int64_t position) const
+    {
+        if (position < startSample)
+            return position;
+
+        if (position >= startSample + oldLength)
+            return position + getLengthDelta();
+
+        return startSample + std::min(position - startSample, newLength);
+    }
+};
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    ParallelChunkExecutor.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "ParallelChunkExecutor.h"
+#include <atomic>
+#include <memory>
+
+namespace
+{
+    /** Shared with the helper jobs, which may start after runTasks() has returned. */
+    struct RunState
+    {
+        std::atomic<int> nextTask { 0 };
+        std::atomic<int> tasksDone { 0 };
+        std::atomic<bool> cancelled { false };
+
+        juce::CriticalSection lock;      // Guards runningHelpers and closed
+        int runningHelpers = 0;
+        bool closed = false;             // Set once run() stops waiting; late helpers exit untouched
+        juce::WaitableEvent helpersIdle;
+    };
+}
+
+int ParallelChunkExecutor::getNumTiles(int numChannels, int numSamples)
+{
+    if (numChannels <= 0 || numSamples <= 0)
+        return 0;
+
+    const int numChunks = (numSamples + kTileSamples - 1) / kTileSamples;
+    return numChunks * numChannels;
+}
+
+juce::ThreadPool& ParallelChunkExecutor::getPool()
+{
+    // The caller works too, so one fewer worker than cores keeps them all busy
+    static juce::ThreadPool pool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1));
+    return pool;
+}
+
+bool ParallelChunkExecutor::run(int numChannels, int startSample, int numSamples,
+                                const TileFunction& processTile,
+                                const ProgressCallback& progress,
+                                const juce::String& status,
+                                float progressStart, float progressEnd)
+{
+    const int numTiles = getNumTiles(numChannels, numSamples);
+
+    return runTasks(numTiles, [&processTile, numChannels, startSample, numSamples](int index)
+    {
+        const int offset = (index / numChannels) * kTileSamples;
+
+        Tile tile;
+        tile.index = index;
+        tile.channel = index % numChannels;
+        tile.startSample = startSample + offset;
+        tile.numSamples = juce::jmin(kTileSamples, numSamples - offset);
+
+        processTile(tile);
+    }, progress, status, progressStart, progressEnd);
+}
+
+bool ParallelChunkExecutor::runTasks(int numTasks, const TaskFunction& task,
+                                     const ProgressCallback& progress,
+                                     const juce::String& status,
+                                     float progressStart, float progressEnd)
+{
+    if (numTasks <= 0)
+        return true;
+
+    auto state = std::make_shared<RunState>();
+
+    // Claims and runs the next task; false once none are left or cancelled
+    const auto runNextTask = [&task, state = state.get(), numTasks]()
+    {
+        if (state->cancelled.load())
+            return false;
+
+        const int index = state->nextTask.fetch_add(1);
+        if (index >= numTasks)
+            return false;
+
+        task(index);
+        state->tasksDone.fetch_add(1);
+        return true;
+    };
+
+    // Helpers reference runNextTask on this stack frame. That is safe: a
+    // helper registers under the lock before touching it, and this function
+    // does not return until every registered helper has left.
+    const int numHelpers = juce::jmin(getPool().getNumThreads(), numTasks - 1);
+    for (int i = 0; i < numHelpers; ++i)
+    {
+        getPool().addJob([state, &runNextTask]()
+        {
+            {
+                const juce::ScopedLock sl(state->lock);
+                if (state->closed)
+                    return;
+                ++state->runningHelpers;
+            }
+
+            while (runNextTask())
+            {
+            }
+
+            const juce::ScopedLock sl(state->lock);
+            if (--state->runningHelpers == 0)
+                state->helpersIdle.signal();
+        });
+    }
+
+    const auto reportProgress = [&]()
+    {
+        const float fraction = static_cast<float>(state->tasksDone.load()) / static_cast<float>(numTasks);
+        if (!progress(progressStart + (progressEnd - progressStart) * fraction, status))
+            state->cancelled.store(true);
+    };
+
+    // The calling thread claims tasks as well, and is the only one to report
+    while (runNextTask())
+    {
+        if (progress)
+            reportProgress();
+    }
+
+    // Wait out helpers still finishing their last task. With a few long
+    // tasks this can be most of the run, so progress (and cancellation)
+    // keeps being reported while waiting.
+    for (;;)
+    {
+        {
+            const juce::ScopedLock sl(state->lock);
+            state->closed = true;
+            if (state->runningHelpers == 0)
+                break;
+        }
+
+        if (state->helpersIdle.wait(100))
+            continue;
+
+        if (progress && !state->cancelled.load())
+            reportProgress();
+    }
+
+    if (state->cancelled.load())
+        return false;
+
+    if (progress)
+        reportProgress();
+
+    return !state->cancelled.load();
+}
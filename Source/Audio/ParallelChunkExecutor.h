@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    ParallelChunkExecutor.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <functional>
+#include "../Utils/ProgressCallback.h"
+
+/**
+ * Spreads an offline buffer operation across cores.
+ *
+ * The channels × samples range is cut into tiles of one channel and at most
+ * kTileSamples samples. The calling thread and a shared pool of workers
+ * (one fewer than the CPU count) claim tiles until none are left, so a long
+ * multichannel edit scales with the core count while a short one runs on
+ * the caller alone.
+ *
+ * Tiles are numbered time-major (all channels of one chunk, then the next
+ * chunk), and each tile gets its index, so a two-pass operation can reduce
+ * its analysis pass by writing one partial result per tile and combining
+ * them afterwards in a fixed order. Results therefore do not depend on
+ * which thread ran which tile.
+ *
+ * Progress is only ever reported from the calling thread, so a
+ * ProgressCallback that is not re-entrant stays safe. When it returns false
+ * no further tiles start, run() waits for tiles already in flight and
+ * returns false, leaving the range partially processed, as the sequential
+ * loops did.
+ */
+class ParallelChunkExecutor
+{
+public:
+    /** One channel's slice of the range. */
+    struct Tile
+    {
+        int index = 0;          // 0 .. getNumTiles() - 1
+        int channel = 0;
+        int startSample = 0;    // Absolute sample index in the buffer
+        int numSamples = 0;
+    };
+
+    /** Processes one tile. Runs concurrently with other tiles; must only touch its own samples. */
+    using TileFunction = std::function<void(const Tile&)>;
+
+    /** Runs one task of runTasks(). Runs concurrently with other tasks. */
+    using TaskFunction = std::function<void(int taskIndex)>;
+
+    /** Samples per tile: large enough to amortise dispatch, small enough for even load. */
+    static constexpr int kTileSamples = 1 << 16;
+
+    /** Number of tiles run() uses for a range, for sizing per-tile results. */
+    static int getNumTiles(int numChannels, int numSamples);
+
+    /**
+     * Runs processTile over every tile of numChannels × [startSample,
+     * startSample + numSamples) and returns once all of them have finished.
+     *
+     * @param progress      Optional; receives values in [progressStart, progressEnd]
+     * @param status        Status text passed to progress
+     * @return true if every tile ran, false if progress requested cancellation
+     */
+    static bool run(int numChannels, int startSample, int numSamples,
+                    const TileFunction& processTile,
+                    const ProgressCallback& progress = {},
+                    const juce::String& status = {},
+                    float progressStart = 0.0f, float progressEnd = 1.0f);
+
+    /**
+     * Runs task(0) .. task(numTasks - 1) on the same workers, for work that
+     * does not cut into channel tiles (e.g. whole-buffer segments). Progress
+     * advances as tasks complete, and is polled about every 100 ms while the
+     * caller waits for the last tasks, so a long task can be cancelled (by
+     * the task itself, which must watch for it) and the bar keeps moving.
+     * Threading is as for run().
+     *
+     * @return true if every task ran, false if progress requested cancellation
+     */
+    static bool runTasks(int numTasks, const TaskFunction& task,
+                         const ProgressCallback& progress = {},
+                         const juce::String& status = {},
+                         float progressStart = 0.0f, float progressEnd = 1.0f);
+
+private:
+    static juce::ThreadPool& getPool();
+
+    // Private constructor - this is a utility class (static methods only)
+    ParallelChunkExecutor() = delete;
+    ~ParallelChunkExecutor() = delete;
+
+    JUCE_DECLARE_NON_COPYABLE(ParallelChunkExecutor)
+};
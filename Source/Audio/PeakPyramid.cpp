@@ -0,0 +1,576 @@
+/*
+  ==============================================================================
+
+    PeakPyramid.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "PeakPyramid.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+//==============================================================================
+namespace
+{
+    /** Level-0 peaks computed per parallel task (~5.5 s at 48 kHz). */
+    constexpr int64_t kPeaksPerTask = 4096;
+
+    // Peak file header: magic, then little-endian fields at fixed offsets
+    // (version, channels, samples, base resolution, level ratio, levels,
+    // bytes per peak). Bump kFileVersion whenever the layout changes.
+    constexpr char kFileMagic[8] = { 'W', 'E', 'P', 'E', 'A', 'K', 'S', 0 };
+    constexpr int kFileVersion = 1;
+    constexpr int kFileHeaderSize = 40;
+
+    int64_t ceilDiv(int64_t value, int64_t divisor)
+    {
+        return (value + divisor - 1) / divisor;
+    }
+
+    /** Peaks per level for numSamples of audio, finest level first, down to one peak. */
+    std::vector<int64_t> getPeaksPerLevel(int64_t numSamples)
+    {
+        std::vector<int64_t> peaksPerLevel;
+        int64_t samplesPerPeak = PeakPyramid::kBaseSamplesPerPeak;
+
+        while (numSamples > 0)
+        {
+            peaksPerLevel.push_back(ceilDiv(numSamples, samplesPerPeak));
+            if (peaksPerLevel.back() <= 1)
+                break;
+
+            samplesPerPeak *= PeakPyramid::kLevelRatio;
+        }
+
+        return peaksPerLevel;
+    }
+
+    PeakPyramid::Peak mergePeaks(const PeakPyramid::Peak* peaks, int64_t count)
+    {
+        PeakPyramid::Peak merged = peaks[0];
+        double sumOfSquares = static_cast<double>(peaks[0].rms) * peaks[0].rms;
+
+        for (int64_t i = 1; i < count; ++i)
+        {
+            merged.minValue = juce::jmin(merged.minValue, peaks[i].minValue);
+            merged.maxValue = juce::jmax(merged.maxValue, peaks[i].maxValue);
+            sumOfSquares += static_cast<double>(peaks[i].rms) * peaks[i].rms;
+        }
+
+        merged.rms = static_cast<float>(std::sqrt(sumOfSquares / static_cast<double>(count)));
+        return merged;
+    }
+
+    /**
+     * Runs task(0) .. task(numTasks - 1) across a shared pool, with the
+     * calling thread taking tasks too, and returns once all have finished.
+     * Helpers that start late find no work left, so the caller never waits
+     * on a pool thread that is busy elsewhere.
+     */
+    void parallelFor(int numTasks, const std::function<void(int)>& task)
+    {
+        if (numTasks <= 1)
+        {
+            if (numTasks == 1)
+                task(0);
+            return;
+        }
+
+        static juce::ThreadPool pool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1));
+
+        struct State
+        {
+            std::function<void(int)> task;
+            int numTasks = 0;
+            std::atomic<int> next { 0 };
+            std::atomic<int> finished { 0 };
+            juce::WaitableEvent allFinished;
+        };
+
+        auto state = std::make_shared<State>();
+        state->task = task;
+        state->numTasks = numTasks;
+
+        auto work = [state]()
+        {
+            for (int i = state->next++; i < state->numTasks; i = state->next++)
+            {
+                state->task(i);
+                if (++state->finished == state->numTasks)
+                    state->allFinished.signal();
+            }
+        };
+
+        const int numHelpers = juce::jmin(pool.getNumThreads(), numTasks - 1);
+        for (int i = 0; i < numHelpers; ++i)
+            pool.addJob(work);
+
+        work();
+        state->allFinished.wait();
+    }
+}
+
+//==============================================================================
+void PeakPyramid::reset(int numChannels, int64_t numSamples)
+{
+    m_levels.clear();
+    m_mappedFile.reset();
+    m_numChannels = juce::jmax(0, numChannels);
+    m_numSamples = juce::jmax<int64_t>(0, numSamples);
+    m_coveredSamples = 0;
+    resizeLevels(m_numSamples);
+}
+
+void PeakPyramid::clear()
+{
+    reset(0, 0);
+}
+
+void PeakPyramid::build(const juce::AudioBuffer<float>& audio)
+{
+    build(audio.getNumChannels(), audio.getNumSamples(), makeReader(audio));
+}
+
+void PeakPyramid::build(int numChannels, int64_t numSamples, const SampleReader& read)
+{
+    reset(numChannels, numSamples);
+    if (m_levels.empty())
+        return;
+
+    m_coveredSamples = m_numSamples;
+
+    const int64_t numBasePeaks = m_levels[0].getNumPeaks();
+    computeBasePeaks(read, 0, numBasePeaks);
+    updateUpperLevels(0, numBasePeaks);
+}
+
+void PeakPyramid::rebuildRange(const juce::AudioBuffer<float>& audio, int64_t startSample, int64_t endSample)
+{
+    rebuildRange(audio.getNumChannels(), audio.getNumSamples(), makeReader(audio), startSample, endSample);
+}
+
+void PeakPyramid::rebuildRange(int numChannels, int64_t numSamples, const SampleReader& read,
+                               int64_t startSample, int64_t endSample)
+{
+    if (numChannels != m_numChannels
+        || numSamples != m_numSamples
+        || m_coveredSamples != m_numSamples)
+    {
+        build(numChannels, numSamples, read);
+        return;
+    }
+
+    if (m_levels.empty() || endSample <= startSample)
+        return;
+
+    makeWritable();
+
+    const int64_t numBasePeaks = m_levels[0].getNumPeaks();
+    const int64_t firstPeak = juce::jlimit<int64_t>(0, numBasePeaks, startSample / kBaseSamplesPerPeak);
+    const int64_t endPeak = juce::jlimit<int64_t>(firstPeak, numBasePeaks, ceilDiv(endSample, kBaseSamplesPerPeak));
+
+    computeBasePeaks(read, firstPeak, endPeak);
+    updateUpperLevels(firstPeak, endPeak);
+}
+
+void PeakPyramid::rebuildFrom(const juce::AudioBuffer<float>& audio, int64_t startSample)
+{
+    rebuildFrom(audio.getNumChannels(), audio.getNumSamples(), makeReader(audio), startSample);
+}
+
+void PeakPyramid::rebuildFrom(int numChannels, int64_t numSamples, const SampleReader& read, int64_t startSample)
+{
+    if (numChannels != m_numChannels
+        || m_coveredSamples != m_numSamples
+        || m_levels.empty()
+        || startSample <= 0)
+    {
+        build(numChannels, numSamples, read);
+        return;
+    }
+
+    makeWritable();
+
+    m_numSamples = numSamples;
+    m_coveredSamples = m_numSamples;
+    const bool levelsChanged = resizeLevels(m_numSamples);
+
+    if (m_levels.empty())
+        return;
+
+    // The peak containing the old end may have been partial; recompute it too.
+    const int64_t numBasePeaks = m_levels[0].getNumPeaks();
+    const int64_t firstPeak = juce::jlimit<int64_t>(0, juce::jmax<int64_t>(0, numBasePeaks - 1),
+                                                    startSample / kBaseSamplesPerPeak);
+
+    computeBasePeaks(read, firstPeak, numBasePeaks);
+    updateUpperLevels(levelsChanged ? 0 : firstPeak, numBasePeaks);
+}
+
+void PeakPyramid::addBlock(int64_t startSample, const juce::AudioBuffer<float>& block)
+{
+    if (block.getNumChannels() != m_numChannels || block.getNumSamples() <= 0)
+    {
+        jassertfalse;
+        return;
+    }
+
+    // Blocks arrive in decode order; anything else would leave holes.
+    jassert(startSample == m_coveredSamples);
+
+    makeWritable();
+
+    // Normally the length is known up front; a file that decodes longer
+    // than its header said grows here.
+    const int64_t endSample = startSample + block.getNumSamples();
+    bool levelsChanged = false;
+    if (endSample > m_numSamples)
+    {
+        m_numSamples = endSample;
+        levelsChanged = resizeLevels(m_numSamples);
+    }
+
+    const int64_t firstPeak = startSample / kBaseSamplesPerPeak;
+    const int64_t endPeak = ceilDiv(endSample, kBaseSamplesPerPeak);
+
+    for (int ch = 0; ch < m_numChannels; ++ch)
+    {
+        auto& peaks = m_levels[0].channels[static_cast<size_t>(ch)];
+        const float* samples = block.getReadPointer(ch);
+
+        for (int64_t i = firstPeak; i < endPeak; ++i)
+        {
+            const int64_t peakStart = i * kBaseSamplesPerPeak;
+            const int64_t from = juce::jmax(peakStart, startSample);
+            const int64_t to = juce::jmin(peakStart + kBaseSamplesPerPeak, endSample);
+
+            Peak peak = computePeak(samples + (from - startSample), static_cast<int>(to - from));
+
+            // The previous block ended mid-peak: fold in what it contributed.
+            if (from > peakStart)
+            {
+                const auto& earlier = peaks[static_cast<size_t>(i)];
+                const double earlierCount = static_cast<double>(from - peakStart);
+                const double newCount = static_cast<double>(to - from);
+
+                peak.minValue = juce::jmin(peak.minValue, earlier.minValue);
+                peak.maxValue = juce::jmax(peak.maxValue, earlier.maxValue);
+                peak.rms = static_cast<float>(std::sqrt(
+                    (static_cast<double>(earlier.rms) * earlier.rms * earlierCount
+                     + static_cast<double>(peak.rms) * peak.rms * newCount)
+                    / (earlierCount + newCount)));
+            }
+
+            peaks[static_cast<size_t>(i)] = peak;
+        }
+    }
+
+    m_coveredSamples = juce::jmax(m_coveredSamples, endSample);
+    updateUpperLevels(levelsChanged ? 0 : firstPeak, endPeak);
+}
+
+int64_t PeakPyramid::getMemoryBytes() const
+{
+    int64_t bytes = 0;
+    for (const auto& level : m_levels)
+        for (const auto& peaks : level.channels)
+            bytes += static_cast<int64_t>(peaks.size() * sizeof(Peak));
+
+    return bytes;
+}
+
+bool PeakPyramid::writeTo(juce::OutputStream& out) const
+{
+   #if JUCE_BIG_ENDIAN
+    // The peak arrays are written raw so they can be mapped; keep the
+    // on-disk format little-endian only.
+    juce::ignoreUnused(out);
+    return false;
+   #else
+    if (isEmpty() || m_coveredSamples != m_numSamples)
+        return false;
+
+    bool ok = out.write(kFileMagic, sizeof(kFileMagic))
+              && out.writeInt(kFileVersion)
+              && out.writeInt(m_numChannels)
+              && out.writeInt64(m_numSamples)
+              && out.writeInt(kBaseSamplesPerPeak)
+              && out.writeInt(kLevelRatio)
+              && out.writeInt(static_cast<int>(m_levels.size()))
+              && out.writeInt(static_cast<int>(sizeof(Peak)));
+
+    for (const auto& level : m_levels)
+        for (const auto* peaks : level.readPointers)
+            ok = ok && out.write(peaks, static_cast<size_t>(level.numPeaks) * sizeof(Peak));
+
+    return ok;
+   #endif
+}
+
+bool PeakPyramid::loadFromMappedFile(const juce::File& file, int expectedChannels, int64_t expectedSamples)
+{
+   #if JUCE_BIG_ENDIAN
+    juce::ignoreUnused(file, expectedChannels, expectedSamples);
+    return false;
+   #else
+    static_assert(sizeof(Peak) == 3 * sizeof(float), "Peak must have no padding to be mapped");
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    if (mapped->getData() == nullptr || mapped->getSize() < static_cast<size_t>(kFileHeaderSize))
+        return false;
+
+    const auto* bytes = static_cast<const char*>(mapped->getData());
+    const auto readInt = [bytes](int offset) { return static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + offset)); };
+    const auto numSamples = static_cast<int64_t>(juce::ByteOrder::littleEndianInt64(bytes + 16));
+
+    if (std::memcmp(bytes, kFileMagic, sizeof(kFileMagic)) != 0
+        || readInt(8) != kFileVersion
+        || readInt(12) != expectedChannels
+        || numSamples != expectedSamples
+        || readInt(24) != kBaseSamplesPerPeak
+        || readInt(28) != kLevelRatio
+        || readInt(36) != static_cast<int>(sizeof(Peak))
+        || expectedChannels <= 0)
+    {
+        return false;
+    }
+
+    const auto peaksPerLevel = getPeaksPerLevel(numSamples);
+    if (readInt(32) != static_cast<int>(peaksPerLevel.size()))
+        return false;
+
+    int64_t totalPeaks = 0;
+    for (auto numPeaks : peaksPerLevel)
+        totalPeaks += numPeaks * expectedChannels;
+
+    // A truncated or padded file is as good as corrupt.
+    if (mapped->getSize() != static_cast<size_t>(kFileHeaderSize + totalPeaks * static_cast<int64_t>(sizeof(Peak))))
+        return false;
+
+    m_levels.clear();
+    m_levels.resize(peaksPerLevel.size());
+    m_numChannels = expectedChannels;
+    m_numSamples = numSamples;
+    m_coveredSamples = numSamples;
+
+    const auto* peaks = reinterpret_cast<const Peak*>(bytes + kFileHeaderSize);
+    int64_t samplesPerPeak = kBaseSamplesPerPeak;
+
+    for (size_t l = 0; l < m_levels.size(); ++l)
+    {
+        auto& level = m_levels[l];
+        level.samplesPerPeak = samplesPerPeak;
+        level.numPeaks = peaksPerLevel[l];
+        level.channels.resize(static_cast<size_t>(m_numChannels));
+
+        for (int ch = 0; ch < m_numChannels; ++ch)
+        {
+            level.readPointers.push_back(peaks);
+            peaks += level.numPeaks;
+        }
+
+        samplesPerPeak *= kLevelRatio;
+    }
+
+    m_mappedFile = std::move(mapped);
+    return true;
+   #endif
+}
+
+void PeakPyramid::getColumns(int channel, double startSample, double samplesPerColumn,
+                             int numColumns, Peak* dest) const
+{
+    if (channel < 0 || channel >= m_numChannels || m_levels.empty() || samplesPerColumn <= 0.0)
+    {
+        std::fill(dest, dest + numColumns, Peak());
+        return;
+    }
+
+    size_t levelIndex = 0;
+    while (levelIndex + 1 < m_levels.size()
+           && static_cast<double>(m_levels[levelIndex + 1].samplesPerPeak) <= samplesPerColumn)
+    {
+        ++levelIndex;
+    }
+
+    const auto& level = m_levels[levelIndex];
+    const Peak* peaks = level.readPointers[static_cast<size_t>(channel)];
+    const double samplesPerPeak = static_cast<double>(level.samplesPerPeak);
+    const int64_t numCoveredPeaks = ceilDiv(m_coveredSamples, level.samplesPerPeak);
+
+    for (int c = 0; c < numColumns; ++c)
+    {
+        const double columnStart = startSample + c * samplesPerColumn;
+        const double columnEnd = columnStart + samplesPerColumn;
+
+        if (columnEnd <= 0.0 || columnStart >= static_cast<double>(m_coveredSamples))
+        {
+            dest[c] = Peak();
+            continue;
+        }
+
+        const int64_t firstPeak = juce::jmax<int64_t>(0, static_cast<int64_t>(std::floor(columnStart / samplesPerPeak)));
+        const int64_t endPeak = juce::jmin(numCoveredPeaks,
+                                           juce::jmax(firstPeak + 1,
+                                                      static_cast<int64_t>(std::ceil(columnEnd / samplesPerPeak))));
+
+        dest[c] = mergePeaks(peaks + firstPeak, endPeak - firstPeak);
+    }
+}
+
+PeakPyramid::Peak PeakPyramid::computePeak(const float* samples, int numSamples)
+{
+    Peak peak;
+    if (numSamples <= 0)
+        return peak;
+
+    const auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+    peak.minValue = range.getStart();
+    peak.maxValue = range.getEnd();
+
+    double sumOfSquares = 0.0;
+    for (int i = 0; i < numSamples; ++i)
+        sumOfSquares += static_cast<double>(samples[i]) * samples[i];
+
+    peak.rms = static_cast<float>(std::sqrt(sumOfSquares / numSamples));
+    return peak;
+}
+
+//==============================================================================
+bool PeakPyramid::resizeLevels(int64_t numSamples)
+{
+    jassert(m_mappedFile == nullptr);
+
+    const auto peaksPerLevel = getPeaksPerLevel(numSamples);
+    const bool levelsChanged = peaksPerLevel.size() != m_levels.size();
+    m_levels.resize(peaksPerLevel.size());
+
+    int64_t samplesPerPeak = kBaseSamplesPerPeak;
+    for (size_t l = 0; l < m_levels.size(); ++l)
+    {
+        auto& level = m_levels[l];
+        level.samplesPerPeak = samplesPerPeak;
+        level.numPeaks = peaksPerLevel[l];
+        level.channels.resize(static_cast<size_t>(m_numChannels));
+        level.readPointers.resize(static_cast<size_t>(m_numChannels));
+
+        for (size_t ch = 0; ch < level.channels.size(); ++ch)
+        {
+            level.channels[ch].resize(static_cast<size_t>(level.numPeaks));
+            level.readPointers[ch] = level.channels[ch].data();
+        }
+
+        samplesPerPeak *= kLevelRatio;
+    }
+
+    return levelsChanged;
+}
+
+void PeakPyramid::makeWritable()
+{
+    if (m_mappedFile == nullptr)
+        return;
+
+    for (auto& level : m_levels)
+    {
+        for (size_t ch = 0; ch < level.readPointers.size(); ++ch)
+        {
+            level.channels[ch].assign(level.readPointers[ch], level.readPointers[ch] + level.numPeaks);
+            level.readPointers[ch] = level.channels[ch].data();
+        }
+    }
+
+    m_mappedFile.reset();
+}
+
+void PeakPyramid::computeBasePeaks(const SampleReader& read, int64_t firstPeak, int64_t endPeak)
+{
+    if (endPeak <= firstPeak)
+        return;
+
+    const int tasksPerChannel = static_cast<int>(ceilDiv(endPeak - firstPeak, kPeaksPerTask));
+
+    parallelFor(tasksPerChannel * m_numChannels, [&](int taskIndex)
+    {
+        const int ch = taskIndex / tasksPerChannel;
+        const int64_t from = firstPeak + (taskIndex % tasksPerChannel) * kPeaksPerTask;
+        const int64_t to = juce::jmin(endPeak, from + kPeaksPerTask);
+
+        const int64_t firstSample = from * kBaseSamplesPerPeak;
+        const int numSamples = static_cast<int>(juce::jmin(to * kBaseSamplesPerPeak, m_numSamples) - firstSample);
+
+        // One task's span (kPeaksPerTask peaks) is read in a single call.
+        std::vector<float> samples(static_cast<size_t>(numSamples));
+        auto& peaks = m_levels[0].channels[static_cast<size_t>(ch)];
+
+        if (! read(ch, firstSample, numSamples, samples.data()))
+        {
+            std::fill(peaks.begin() + static_cast<std::ptrdiff_t>(from),
+                      peaks.begin() + static_cast<std::ptrdiff_t>(to), Peak {});
+            return;
+        }
+
+        for (int64_t i = from; i < to; ++i)
+        {
+            const int offset = static_cast<int>((i - from) * kBaseSamplesPerPeak);
+            const int count = juce::jmin(kBaseSamplesPerPeak, numSamples - offset);
+            peaks[static_cast<size_t>(i)] = computePeak(samples.data() + offset, count);
+        }
+    });
+}
+
+PeakPyramid::SampleReader PeakPyramid::makeReader(const juce::AudioBuffer<float>& audio)
+{
+    return [&audio](int channel, int64_t startSample, int numSamples, float* dest)
+    {
+        if (channel >= audio.getNumChannels() || startSample + numSamples > audio.getNumSamples())
+            return false;
+
+        juce::FloatVectorOperations::copy(dest, audio.getReadPointer(channel, static_cast<int>(startSample)),
+                                          numSamples);
+        return true;
+    };
+}
+
+void PeakPyramid::updateUpperLevels(int64_t firstPeak, int64_t endPeak)
+{
+    for (size_t l = 1; l < m_levels.size(); ++l)
+    {
+        const auto& below = m_levels[l - 1];
+        auto& level = m_levels[l];
+
+        firstPeak /= kLevelRatio;
+        endPeak = juce::jmin(level.getNumPeaks(), ceilDiv(endPeak, kLevelRatio));
+
+        // During a progressive load only the children decoded so far count.
+        const int64_t numCoveredBelow = ceilDiv(m_coveredSamples, below.samplesPerPeak);
+
+        for (int ch = 0; ch < m_numChannels; ++ch)
+        {
+            const auto& children = below.channels[static_cast<size_t>(ch)];
+            auto& peaks = level.channels[static_cast<size_t>(ch)];
+
+            for (int64_t i = firstPeak; i < endPeak; ++i)
+            {
+                const int64_t firstChild = i * kLevelRatio;
+                const int64_t endChild = juce::jmin(firstChild + kLevelRatio, numCoveredBelow);
+
+                peaks[static_cast<size_t>(i)] = endChild > firstChild
+                    ? mergePeaks(children.data() + firstChild, endChild - firstChild)
+                    : Peak();
+            }
+        }
+    }
+}
@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    PeakPyramid.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * Multi-resolution min/max/RMS summary of a document's audio, used to draw
+ * the waveform at any zoom level in time proportional to the number of
+ * pixel columns rather than the number of visible samples.
+ *
+ * Level 0 holds one peak per kBaseSamplesPerPeak samples; each level above
+ * summarises kLevelRatio peaks of the one below, up to a single peak for
+ * the whole file. The pyramid costs about 6% of the float audio it
+ * describes.
+ *
+ * A complete pyramid can be saved with writeTo() and reopened with
+ * loadFromMappedFile(), which reads the peaks straight out of the mapped
+ * file; the first edit copies them into memory.
+ *
+ * Not thread-safe: the owner serialises writers and readers.
+ */
+class PeakPyramid
+{
+public:
+    struct Peak
+    {
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+        float rms = 0.0f;
+    };
+
+    /** Samples summarised by one level-0 peak. */
+    static constexpr int kBaseSamplesPerPeak = 64;
+
+    /** Peaks of one level summarised by one peak of the level above. */
+    static constexpr int kLevelRatio = 4;
+
+    /**
+     * Reads numSamples samples of channel from startSample into dest. Lets
+     * the pyramid be built from audio that is not one contiguous buffer
+     * (an AudioSnapshot's pieces); may be called from several threads at once.
+     */
+    using SampleReader = std::function<bool(int channel, int64_t startSample, int numSamples, float* dest)>;
+
+    PeakPyramid() = default;
+
+    /** Sizes the pyramid for numSamples of audio with nothing covered yet (see addBlock()). */
+    void reset(int numChannels, int64_t numSamples);
+
+    /** Drops all peaks. */
+    void clear();
+
+    /** Computes every level for audio, splitting the work across cores. */
+    void build(const juce::AudioBuffer<float>& audio);
+
+    /** As build(), reading numSamples samples of numChannels channels through read. */
+    void build(int numChannels, int64_t numSamples, const SampleReader& read);
+
+    /**
+     * Recomputes the peaks over [startSample, endSample) after an edit that
+     * left the length unchanged. audio is the whole edited document.
+     */
+    void rebuildRange(const juce::AudioBuffer<float>& audio, int64_t startSample, int64_t endSample);
+
+    /** As rebuildRange(), reading the edited document through read. */
+    void rebuildRange(int numChannels, int64_t numSamples, const SampleReader& read,
+                      int64_t startSample, int64_t endSample);
+
+    /**
+     * Resizes to audio's length and recomputes everything from startSample
+     * on; the peaks before it are kept. Used after an edit that changed the
+     * length (everything after the edit point has moved).
+     */
+    void rebuildFrom(const juce::AudioBuffer<float>& audio, int64_t startSample);
+
+    /** As rebuildFrom(), reading the edited document through read. */
+    void rebuildFrom(int numChannels, int64_t numSamples, const SampleReader& read, int64_t startSample);
+
+    /**
+     * Adds audio decoded in order at startSample, extending the covered
+     * range (progressive loading). The block need not be peak-aligned.
+     */
+    void addBlock(int64_t startSample, const juce::AudioBuffer<float>& block);
+
+    bool isEmpty() const { return m_numSamples == 0; }
+    int getNumChannels() const { return m_numChannels; }
+    int64_t getNumSamples() const { return m_numSamples; }
+
+    /** Samples from the start whose peaks are known; equals getNumSamples() once complete. */
+    int64_t getCoveredSamples() const { return m_coveredSamples; }
+
+    /** Heap bytes held by all levels (a mapped file's pages are not counted). */
+    int64_t getMemoryBytes() const;
+
+    /** True while the peaks are read from a file opened with loadFromMappedFile(). */
+    bool isMapped() const { return m_mappedFile != nullptr; }
+
+    //==============================================================================
+    // Peak files
+
+    /**
+     * Writes the pyramid in the versioned peak-file layout: a fixed header
+     * followed by every level's peaks, channel by channel, in native
+     * little-endian floats so the file can be mapped back as-is.
+     *
+     * @return false if the pyramid is incomplete or the write failed
+     */
+    bool writeTo(juce::OutputStream& out) const;
+
+    /**
+     * Replaces the contents with the peaks in file (see writeTo()), mapped
+     * rather than read. Fails, leaving the pyramid untouched, if the file
+     * is not a current-version peak file for audio of this shape.
+     */
+    bool loadFromMappedFile(const juce::File& file, int expectedChannels, int64_t expectedSamples);
+
+    /**
+     * Summarises channel into numColumns peaks, column c covering samples
+     * [startSample + c * samplesPerColumn, startSample + (c + 1) * samplesPerColumn).
+     * Reads the coarsest level whose peaks are no wider than a column, so
+     * each column merges only a handful of peaks. Columns outside the
+     * covered range come back as silence.
+     */
+    void getColumns(int channel, double startSample, double samplesPerColumn,
+                    int numColumns, Peak* dest) const;
+
+    /** Summarises numSamples raw samples into one peak. */
+    static Peak computePeak(const float* samples, int numSamples);
+
+private:
+    struct Level
+    {
+        int64_t samplesPerPeak = 0;
+        int64_t numPeaks = 0;
+        std::vector<std::vector<Peak>> channels;  // [channel][peak index]; empty while mapped
+        std::vector<const Peak*> readPointers;    // [channel]: into channels, or into the mapped file
+
+        int64_t getNumPeaks() const { return numPeaks; }
+    };
+
+    /**
+     * Resizes every level for numSamples, keeping existing peaks.
+     * @return true if levels were added or removed (the upper levels then need a full update)
+     */
+    bool resizeLevels(int64_t numSamples);
+
+    /** Copies mapped peaks into memory so they can be modified. */
+    void makeWritable();
+
+    /** Recomputes level-0 peaks [firstPeak, endPeak) from the audio, in parallel for large spans. */
+    void computeBasePeaks(const SampleReader& read, int64_t firstPeak, int64_t endPeak);
+
+    /** A SampleReader over a contiguous buffer. */
+    static SampleReader makeReader(const juce::AudioBuffer<float>& audio);
+
+    /** Recomputes the ancestors of level-0 peaks [firstPeak, endPeak) up to the top level. */
+    void updateUpperLevels(int64_t firstPeak, int64_t endPeak);
+
+    std::vector<Level> m_levels;
+    std::unique_ptr<juce::MemoryMappedFile> m_mappedFile;
+    int m_numChannels = 0;
+    int64_t m_numSamples = 0;
+    int64_t m_coveredSamples = 0;
+};
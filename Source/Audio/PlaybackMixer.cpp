@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+    PlaybackMixer.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "PlaybackMixer.h"
+#include <algorithm>
+
+PlaybackMixer& PlaybackMixer::getInstance()
+{
+    static PlaybackMixer instance;
+    return instance;
+}
+
+PlaybackMixer::PlaybackMixer()
+    : m_voices(std::make_unique<const VoiceList>())
+{
+    m_activeVoices.store(m_voices.get());
+}
+
+PlaybackMixer::~PlaybackMixer()
+{
+    detach();
+}
+
+std::shared_ptr<juce::TimeSliceThread> PlaybackMixer::acquireReadAheadThread()
+{
+    if (auto thread = m_readAheadThread.lock())
+        return thread;
+
+    auto thread = std::shared_ptr<juce::TimeSliceThread>(new juce::TimeSliceThread("Playback Read-Ahead"),
+                                                         [](juce::TimeSliceThread* t)
+                                                         {
+                                                             t->stopThread(1000);
+                                                             delete t;
+                                                         });
+    thread->startThread();
+    m_readAheadThread = thread;
+    return thread;
+}
+
+//==============================================================================
+// Device and voices
+
+void PlaybackMixer::attachTo(juce::AudioDeviceManager& deviceManager)
+{
+    if (m_deviceManager == &deviceManager)
+        return;
+
+    detach();
+    m_deviceManager = &deviceManager;
+    m_deviceManager->addAudioCallback(this);
+}
+
+void PlaybackMixer::detach()
+{
+    if (m_deviceManager == nullptr)
+        return;
+
+    // Calls audioDeviceStopped(), which stops every voice
+    m_deviceManager->removeAudioCallback(this);
+    m_deviceManager = nullptr;
+}
+
+void PlaybackMixer::addVoice(juce::AudioIODeviceCallback* voice)
+{
+    if (voice == nullptr)
+        return;
+
+    // Prepare before the callback can see it, as AudioDeviceManager does:
+    // preparing can be slow and must not stall the device callback.
+    if (auto* device = getCurrentDevice())
+        voice->audioDeviceAboutToStart(device);
+
+    const juce::ScopedLock sl(m_lock);
+    if (std::find(m_voices->begin(), m_voices->end(), voice) != m_voices->end())
+        return;
+
+    auto voices = *m_voices;
+    voices.push_back(voice);
+    publishVoices(std::move(voices));
+}
+
+void PlaybackMixer::removeVoice(juce::AudioIODeviceCallback* voice)
+{
+    {
+        const juce::ScopedLock sl(m_lock);
+        if (std::find(m_voices->begin(), m_voices->end(), voice) == m_voices->end())
+            return;
+
+        auto voices = *m_voices;
+        voices.erase(std::remove(voices.begin(), voices.end(), voice), voices.end());
+        publishVoices(std::move(voices));
+    }
+
+    // The callback no longer renders it
+    if (getCurrentDevice() != nullptr)
+        voice->audioDeviceStopped();
+}
+
+void PlaybackMixer::publishVoices(VoiceList voices)
+{
+    auto next = std::make_unique<const VoiceList>(std::move(voices));
+    m_activeVoices.store(next.get());
+
+    // A callback that began before the store may still be walking the old
+    // list; it finishes within one device block. Any later callback loads
+    // the new one, so once m_inCallback reads false the old list is free.
+    while (m_inCallback.load())
+        juce::Thread::yield();
+
+    m_voices = std::move(next);
+}
+
+//==============================================================================
+// AudioIODeviceCallback
+
+void PlaybackMixer::audioDeviceAboutToStart(juce::AudioIODevice* device)
+{
+    // No callback runs while the device starts, so the scratch is ours.
+    m_scratch.setSize(juce::jmax(1, device->getActiveOutputChannels().countNumberOfSetBits()),
+                      device->getCurrentBufferSizeSamples());
+    m_currentDevice.store(device);
+
+    VoiceList voices;
+    {
+        const juce::ScopedLock sl(m_lock);
+        voices = *m_voices;
+    }
+
+    for (auto* voice : voices)
+        voice->audioDeviceAboutToStart(device);
+}
+
+void PlaybackMixer::audioDeviceStopped()
+{
+    m_currentDevice.store(nullptr);
+
+    VoiceList voices;
+    {
+        const juce::ScopedLock sl(m_lock);
+        voices = *m_voices;
+    }
+
+    for (auto* voice : voices)
+        voice->audioDeviceStopped();
+}
+
+void PlaybackMixer::audioDeviceIOCallbackWithContext(const float* const* inputChannelData,
+                                                     int numInputChannels,
+                                                     float* const* outputChannelData,
+                                                     int numOutputChannels,
+                                                     int numSamples,
+                                                     const juce::AudioIODeviceCallbackContext& context)
+{
+    // Flag first, then load: publishVoices() relies on this order.
+    m_inCallback.store(true);
+    const auto& voices = *m_activeVoices.load();
+
+    if (voices.empty())
+    {
+        for (int ch = 0; ch < numOutputChannels; ++ch)
+            if (outputChannelData[ch] != nullptr)
+                juce::FloatVectorOperations::clear(outputChannelData[ch], numSamples);
+
+        m_inCallback.store(false);
+        return;
+    }
+
+    // The first voice renders straight into the output; the rest render into
+    // scratch and are summed on top. The scratch is sized when the device
+    // starts, so this only reallocates if a driver delivers an oversized block.
+    voices.front()->audioDeviceIOCallbackWithContext(inputChannelData, numInputChannels,
+                                                     outputChannelData, numOutputChannels,
+                                                     numSamples, context);
+
+    if (voices.size() > 1)
+    {
+        m_scratch.setSize(juce::jmax(m_scratch.getNumChannels(), numOutputChannels), numSamples,
+                          false, false, true);
+
+        for (size_t i = 1; i < voices.size(); ++i)
+        {
+            voices[i]->audioDeviceIOCallbackWithContext(inputChannelData, numInputChannels,
+                                                        m_scratch.getArrayOfWritePointers(),
+                                                        numOutputChannels, numSamples, context);
+
+            for (int ch = 0; ch < numOutputChannels; ++ch)
+                if (outputChannelData[ch] != nullptr)
+                    juce::FloatVectorOperations::add(outputChannelData[ch], m_scratch.getReadPointer(ch), numSamples);
+        }
+    }
+
+    m_inCallback.store(false);
+}
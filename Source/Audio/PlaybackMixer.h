@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    PlaybackMixer.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_devices/juce_audio_devices.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * The one audio device callback for document playback.
+ *
+ * Every open document's AudioEngine registers with the mixer as a voice. The
+ * mixer is attached once to the application's AudioDeviceManager and, on
+ * each device block, renders every voice and sums them into the output. The
+ * device is never reopened when documents are opened, closed or switched,
+ * so playing one file and then another is instant, and several documents can
+ * sound at once for A/B comparison. The voices also share one read-ahead
+ * thread for file-backed playback.
+ *
+ * Voices keep their own transport, DSP and mute state. A voice added while a
+ * device is running is prepared for it immediately; a removed voice is told
+ * the device stopped.
+ *
+ * The device callback never locks: it renders from an immutable voice list
+ * that the message thread replaces atomically. removeVoice() waits out a
+ * callback still using the old list (at most one device block) before it
+ * returns, so the caller may then destroy the voice.
+ */
+class PlaybackMixer : public juce::AudioIODeviceCallback
+{
+public:
+    static PlaybackMixer& getInstance();
+
+    /** Starts mixing into deviceManager's device. Message thread. */
+    void attachTo(juce::AudioDeviceManager& deviceManager);
+
+    /** Stops mixing and stops every voice. Call before the device manager is destroyed. */
+    void detach();
+
+    /** The attached device manager, or nullptr. */
+    juce::AudioDeviceManager* getDeviceManager() const { return m_deviceManager; }
+
+    /** The running device, or nullptr when none is open. */
+    juce::AudioIODevice* getCurrentDevice() const { return m_currentDevice.load(); }
+
+    /**
+     * The read-ahead thread for the voices' file-backed transports. Every
+     * holder shares one thread; it starts with the first AudioEngine that
+     * acquires it and stops when the last one releases it, so it never
+     * outlives the engines into static destruction. Message thread.
+     */
+    std::shared_ptr<juce::TimeSliceThread> acquireReadAheadThread();
+
+    /** Adds a voice, preparing it for the running device first. Message thread. */
+    void addVoice(juce::AudioIODeviceCallback* voice);
+
+    /** Removes a voice; it receives audioDeviceStopped() if a device was running. */
+    void removeVoice(juce::AudioIODeviceCallback* voice);
+
+    //==============================================================================
+    // AudioIODeviceCallback
+
+    void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
+    void audioDeviceStopped() override;
+    void audioDeviceIOCallbackWithContext(const float* const* inputChannelData,
+                                          int numInputChannels,
+                                          float* const* outputChannelData,
+                                          int numOutputChannels,
+                                          int numSamples,
+                                          const juce::AudioIODeviceCallbackContext& context) override;
+
+private:
+    using VoiceList = std::vector<juce::AudioIODeviceCallback*>;
+
+    PlaybackMixer();
+    ~PlaybackMixer() override;
+
+    /** Publishes voices to the device callback and waits until it no longer uses the old list. */
+    void publishVoices(VoiceList voices);
+
+    juce::CriticalSection m_lock;                    // Serialises publishVoices(); never taken by the callback
+    std::unique_ptr<const VoiceList> m_voices;       // What m_activeVoices points to; message thread
+    std::atomic<const VoiceList*> m_activeVoices { nullptr };
+    std::atomic<bool> m_inCallback { false };
+    std::atomic<juce::AudioIODevice*> m_currentDevice { nullptr };
+    juce::AudioBuffer<float> m_scratch;              // One voice's block, summed into the output; device thread
+
+    juce::AudioDeviceManager* m_deviceManager = nullptr;
+    std::weak_ptr<juce::TimeSliceThread> m_readAheadThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlaybackMixer)
+};
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    PreviewRenderer.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "PreviewRenderer.h"
+
+PreviewRenderer::PreviewRenderer()
+    : m_state(std::make_shared<State>())
+{
+}
+
+PreviewRenderer::~PreviewRenderer()
+{
+    cancel();
+
+    // Wait out a render in progress: it may be reading the owner's state.
+    const juce::ScopedLock sl(m_state->renderLock);
+}
+
+juce::ThreadPool& PreviewRenderer::getWorker()
+{
+    static juce::ThreadPool pool(1);
+    return pool;
+}
+
+void PreviewRenderer::cancel()
+{
+    ++m_state->generation;
+}
+
+void PreviewRenderer::submitJob(Job job)
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    const uint64_t generation = ++m_state->generation;
+
+    getWorker().addJob([state = m_state, generation, job = std::move(job)]()
+    {
+        std::function<void()> deliver;
+
+        {
+            const juce::ScopedLock sl(state->renderLock);
+
+            // Superseded while queued: skip without rendering
+            if (state->generation.load() != generation)
+                return;
+
+            const ShouldCancel shouldCancel = [&state, generation]()
+            {
+                return state->generation.load() != generation;
+            };
+
+            try
+            {
+                deliver = job(shouldCancel);
+            }
+            catch (const std::exception& e)
+            {
+                juce::Logger::writeToLog("PreviewRenderer: render failed - " + juce::String(e.what()));
+                return;
+            }
+        }
+
+        if (deliver == nullptr || state->generation.load() != generation)
+            return;
+
+        juce::MessageManager::callAsync([state, generation, deliver = std::move(deliver)]()
+        {
+            // Checked again here: a newer submit() may have come in while this was queued
+            if (state->generation.load() == generation)
+                deliver();
+        });
+    });
+}
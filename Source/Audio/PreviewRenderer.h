@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    PreviewRenderer.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/**
+ * Renders a processing dialog's offline preview on a background worker, so
+ * a slow render never freezes the dialog.
+ *
+ * Each dialog owns a PreviewRenderer. Every submit() starts a new
+ * generation and supersedes the ones before it: a superseded render that
+ * has not started is skipped, a running one sees shouldCancel() turn true,
+ * and a finished one is never delivered. Only the newest result reaches
+ * onDone, which runs on the message thread (typically handing the buffer
+ * to AudioEngine::startBufferPreview()).
+ *
+ * All dialogs share one worker thread, so at most one preview renders at a
+ * time. Destroying a PreviewRenderer cancels its work and waits for a
+ * render in progress to return, so a render may safely read state owned by
+ * the dialog that outlives the renderer (declare the renderer last).
+ */
+class PreviewRenderer
+{
+public:
+    /** Polled by long renders; true once the render has been superseded. */
+    using ShouldCancel = std::function<bool()>;
+
+    PreviewRenderer();
+    ~PreviewRenderer();
+
+    /**
+     * Queues render on the worker, superseding every earlier submission.
+     * onDone receives the result on the message thread unless a newer
+     * submit() or cancel() came first. Message thread only.
+     */
+    template <typename Result>
+    void submit(std::function<Result(const ShouldCancel&)> render,
+                std::function<void(Result&)> onDone)
+    {
+        submitJob([render = std::move(render), onDone = std::move(onDone)](const ShouldCancel& shouldCancel)
+                      -> std::function<void()>
+        {
+            auto result = std::make_shared<Result>(render(shouldCancel));
+            return [onDone, result]() { onDone(*result); };
+        });
+    }
+
+    /** Drops every pending and running render without delivering it. */
+    void cancel();
+
+private:
+    struct State
+    {
+        std::atomic<uint64_t> generation { 0 };
+        juce::CriticalSection renderLock;   // Held while one of this renderer's jobs runs
+    };
+
+    /** Runs on the worker; returns what to do with the result on the message thread. */
+    using Job = std::function<std::function<void()>(const ShouldCancel&)>;
+
+    void submitJob(Job job);
+
+    static juce::ThreadPool& getWorker();
+
+    std::shared_ptr<State> m_state;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PreviewRenderer)
+};
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    ProgressiveAudioLoader.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "ProgressiveAudioLoader.h"
+
+ProgressiveAudioLoader::ProgressiveAudioLoader()
+    : juce::Thread("Progressive Audio Loader")
+{
+}
+
+ProgressiveAudioLoader::~ProgressiveAudioLoader()
+{
+    cancel();
+}
+
+bool ProgressiveAudioLoader::start(const juce::File& file, juce::AudioFormatManager& formatManager)
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+    jassert(! isThreadRunning());
+
+    m_reader.reset(formatManager.createReaderFor(file));
+
+    if (m_reader == nullptr || m_reader->numChannels == 0 || m_reader->lengthInSamples <= 0)
+    {
+        juce::Logger::writeToLog("ProgressiveAudioLoader: Cannot read " + file.getFileName());
+        m_reader.reset();
+        return false;
+    }
+
+    m_sampleRate = m_reader->sampleRate;
+    m_numChannels = static_cast<int>(m_reader->numChannels);
+    m_bitsPerSample = static_cast<int>(m_reader->bitsPerSample);
+    m_totalSamples = m_reader->lengthInSamples;
+
+    m_decodedSamples.store(0);
+    m_decoderDone.store(false);
+    m_failed.store(false);
+
+    startThread();
+    return true;
+}
+
+void ProgressiveAudioLoader::cancel()
+{
+    // The decoder checks threadShouldExit() between blocks, so this waits at
+    // most one block's decode time.
+    stopThread(10000);
+
+    const juce::ScopedLock sl(m_blockLock);
+    m_pendingBlocks.clear();
+}
+
+std::vector<ProgressiveAudioLoader::DecodedBlock> ProgressiveAudioLoader::takeDecodedBlocks()
+{
+    std::vector<DecodedBlock> blocks;
+
+    const juce::ScopedLock sl(m_blockLock);
+    blocks.swap(m_pendingBlocks);
+    return blocks;
+}
+
+bool ProgressiveAudioLoader::isFinished() const
+{
+    if (! m_decoderDone.load())
+        return false;
+
+    const juce::ScopedLock sl(m_blockLock);
+    return m_pendingBlocks.empty();
+}
+
+double ProgressiveAudioLoader::getProgress() const
+{
+    if (m_totalSamples <= 0)
+        return 0.0;
+
+    return static_cast<double>(m_decodedSamples.load()) / static_cast<double>(m_totalSamples);
+}
+
+void ProgressiveAudioLoader::run()
+{
+    int64_t position = 0;
+
+    while (position < m_totalSamples && ! threadShouldExit())
+    {
+        const int blockLength = static_cast<int>(juce::jmin<int64_t>(kBlockSamples, m_totalSamples - position));
+        auto block = std::make_shared<juce::AudioBuffer<float>>(m_numChannels, blockLength);
+
+        if (! m_reader->read(block.get(), 0, blockLength, position, true, true))
+        {
+            juce::Logger::writeToLog("ProgressiveAudioLoader: Read failed at sample " + juce::String(position));
+            m_failed.store(true);
+            break;
+        }
+
+        // Packing scans every sample, so it happens here rather than on the
+        // message thread. Float or lossy sources share the decoded block.
+        DecodedBlock decoded;
+        decoded.startSample = position;
+        if (! decoded.pieces.appendPacked(*block, m_bitsPerSample))
+            decoded.pieces.append(block);
+        decoded.audio = std::move(block);
+
+        {
+            const juce::ScopedLock sl(m_blockLock);
+            m_pendingBlocks.push_back(std::move(decoded));
+        }
+
+        position += blockLength;
+        m_decodedSamples.store(position);
+    }
+
+    // Release the file handle as soon as decoding ends rather than when the
+    // document closes.
+    m_reader.reset();
+    m_decoderDone.store(true);
+}
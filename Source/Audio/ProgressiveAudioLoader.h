@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    ProgressiveAudioLoader.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "AudioSampleStore.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Decodes an audio file on a background thread, one block at a time.
+ *
+ * Document uses this for formats that cannot be memory-mapped (FLAC, MP3,
+ * OGG, ...) so that opening a long take no longer blocks the message thread.
+ * The owner polls takeDecodedBlocks() from the message thread and appends
+ * each block to its AudioBufferManager and waveform, so the file is decoded
+ * exactly once and the display fills in from left to right.
+ *
+ * Each block is also stored in its source PCM width on the decoder thread
+ * (AudioSampleStore::appendPacked), so the message thread only splices
+ * ready-made pieces into the document and never packs samples itself.
+ *
+ * Cancellation: cancel() (or destruction) stops the decoder between blocks,
+ * so closing a tab mid-load returns promptly.
+ */
+class ProgressiveAudioLoader : private juce::Thread
+{
+public:
+    /** Frames decoded per block (~5.5 s at 48 kHz). Also the cancel latency. */
+    static constexpr int kBlockSamples = 1 << 18;
+
+    struct DecodedBlock
+    {
+        int64_t startSample = 0;
+        AudioSampleStore::ChunkPtr audio;   // float frames for the waveform peaks; read-only
+        AudioSampleStore pieces;            // the same frames, packed where lossless
+    };
+
+    ProgressiveAudioLoader();
+    ~ProgressiveAudioLoader() override;
+
+    /**
+     * Opens the file (header only) and starts decoding in the background.
+     * Format properties are available as soon as this returns true.
+     *
+     * @return false if no registered format can read the file
+     */
+    bool start(const juce::File& file, juce::AudioFormatManager& formatManager);
+
+    /** Stops decoding and waits for the thread. Pending blocks are discarded. */
+    void cancel();
+
+    /**
+     * Hands over every block decoded since the last call, in file order.
+     * Message thread only.
+     */
+    std::vector<DecodedBlock> takeDecodedBlocks();
+
+    /** True once the decoder has stopped and every block has been taken. */
+    bool isFinished() const;
+
+    /** True if a read failed; the blocks taken so far are still valid. */
+    bool hasFailed() const { return m_failed.load(); }
+
+    /** Fraction of the file decoded so far (0.0 - 1.0). */
+    double getProgress() const;
+
+    //==============================================================================
+    // Format of the file being loaded (valid after start())
+
+    double getSampleRate() const { return m_sampleRate; }
+    int getNumChannels() const { return m_numChannels; }
+    int getBitsPerSample() const { return m_bitsPerSample; }
+    int64_t getTotalSamples() const { return m_totalSamples; }
+
+private:
+    void run() override;
+
+    std::unique_ptr<juce::AudioFormatReader> m_reader;  // owned by the thread while it runs
+
+    double m_sampleRate = 0.0;
+    int m_numChannels = 0;
+    int m_bitsPerSample = 0;
+    int64_t m_totalSamples = 0;
+
+    std::atomic<int64_t> m_decodedSamples { 0 };
+    std::atomic<bool> m_decoderDone { false };
+    std::atomic<bool> m_failed { false };
+
+    juce::CriticalSection m_blockLock;
+    std::vector<DecodedBlock> m_pendingBlocks;  // guarded by m_blockLock
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProgressiveAudioLoader)
+};
@@ -14,6 +14,112 @@
 */
 
 #include "RecordingEngine.h"
+#include "../Utils/Settings.h"
+#include <functional>
+#include <utility>
+
+//==============================================================================
+/**
+ * Streams one take to disk. The audio thread copies blocks into a
+ * single-producer/single-consumer AbstractFifo; the recording writer thread
+ * polls it every kWriterPollMs and writes what is ready. Unlike
+ * AudioFormatWriter::ThreadedWriter, write() never notifies the thread, so
+ * the audio thread touches nothing but the FIFO's atomics and its memory.
+ * The first failed disk write calls onWriteFailed on the writer thread;
+ * after that the writer discards input instead of writing past the gap.
+ */
+class RecordingEngine::TakeWriter : public juce::TimeSliceClient
+{
+public:
+    TakeWriter(std::unique_ptr<juce::AudioFormatWriter> writer, juce::TimeSliceThread& thread,
+               int fifoSamples, int flushIntervalSamples, std::function<void()> onWriteFailed)
+        : m_writer(std::move(writer)),
+          m_thread(thread),
+          m_fifo(fifoSamples),
+          m_fifoBuffer(static_cast<int>(m_writer->getNumChannels()), fifoSamples),
+          m_flushInterval(flushIntervalSamples),
+          m_onWriteFailed(std::move(onWriteFailed))
+    {
+        m_thread.addTimeSliceClient(this);
+    }
+
+    ~TakeWriter() override
+    {
+        // Waits for a running useTimeSlice(), then writes what is left.
+        m_thread.removeTimeSliceClient(this);
+        while (drain() > 0) {}
+        // Destroying the writer finalizes the WAV header.
+    }
+
+    /** Audio thread. Copies numSamples frames in; false if the FIFO is full or the disk failed. */
+    bool write(const float* const* channels, int numSamples)
+    {
+        if (m_failed.load() || m_fifo.getFreeSpace() < numSamples)
+            return false;
+
+        int start1, size1, start2, size2;
+        m_fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+        for (int ch = 0; ch < m_fifoBuffer.getNumChannels(); ++ch)
+        {
+            m_fifoBuffer.copyFrom(ch, start1, channels[ch], size1);
+            if (size2 > 0)
+                m_fifoBuffer.copyFrom(ch, start2, channels[ch] + size1, size2);
+        }
+
+        m_fifo.finishedWrite(size1 + size2);
+        return true;
+    }
+
+    int useTimeSlice() override
+    {
+        return drain() > 0 ? 0 : kWriterPollMs;
+    }
+
+private:
+    /** Writer thread. Writes everything ready; returns the frame count. */
+    int drain()
+    {
+        int start1, size1, start2, size2;
+        m_fifo.prepareToRead(m_fifo.getNumReady(), start1, size1, start2, size2);
+
+        // Once a write has failed the rest is discarded: the file already
+        // has a gap, and appending after it would hide where the take broke.
+        bool ok = ! m_failed.load();
+        if (ok && size1 > 0)
+            ok = m_writer->writeFromAudioSampleBuffer(m_fifoBuffer, start1, size1);
+        if (ok && size2 > 0)
+            ok = m_writer->writeFromAudioSampleBuffer(m_fifoBuffer, start2, size2);
+
+        const int written = size1 + size2;
+        m_fifo.finishedRead(written);
+
+        // Rewrites the header as the take grows, so a crash mid-take still
+        // leaves a valid file up to the last flush.
+        m_samplesSinceFlush += written;
+        if (ok && m_flushInterval > 0 && m_samplesSinceFlush >= m_flushInterval)
+        {
+            ok = m_writer->flush();
+            m_samplesSinceFlush = 0;
+        }
+
+        if (! ok && ! m_failed.exchange(true) && m_onWriteFailed)
+            m_onWriteFailed();
+
+        return written;
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> m_writer;
+    juce::TimeSliceThread& m_thread;
+    juce::AbstractFifo m_fifo;
+    juce::AudioBuffer<float> m_fifoBuffer;
+    const int m_flushInterval;
+    int m_samplesSinceFlush = 0;
+    std::function<void()> m_onWriteFailed;
+    std::atomic<bool> m_failed { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TakeWriter)
+};
 
 //==============================================================================
 // Constructor / Destructor
@@ -22,7 +128,6 @@ RecordingEngine::RecordingEngine()
     : m_recordingState(RecordingState::IDLE),
       m_sampleRate(44100.0),
       m_numChannels(2),
-      m_bufferFull(false),
       m_recordedSampleCount(0)
 {
     // Initialize level meters to zero
@@ -36,6 +141,8 @@ RecordingEngine::RecordingEngine()
 RecordingEngine::~RecordingEngine()
 {
     stopRecording();
+    clearRecording();
+    m_writerThread.stopThread(1000);
 }
 
 //==============================================================================
@@ -52,16 +159,16 @@ bool RecordingEngine::startRecording()
     // Clear any previous recording
     clearRecording();
 
-    // M18: allocate the (large) recording buffer here, on record start,
-    // rather than on every device (re)start. M17: reset drop counter.
+    // Open the take on record start, not on device (re)start, so an idle
+    // device reconfigure never touches the disk. M17: reset drop counter.
     {
         juce::ScopedLock lock(m_bufferLock);
         m_droppedSampleCount.store(0);
-        resolveRecordChannels();  // set m_numChannels before sizing the buffer
-        if (! ensureRecordingBufferAllocated())
+        resolveRecordChannels();  // set m_numChannels before creating the writer
+        if (! openTakeWriter())
         {
             juce::Logger::writeToLog("RecordingEngine::startRecording: "
-                                     "failed to allocate recording buffer");
+                                     "failed to create take file");
             return false;
         }
     }
@@ -86,49 +193,100 @@ void RecordingEngine::resolveRecordChannels()
     m_numChannels.store(juce::jmax(1, resolved));
 }
 
-bool RecordingEngine::ensureRecordingBufferAllocated()
+bool RecordingEngine::openTakeWriter()
 {
-    // Caller holds m_bufferLock. Allocate ~1 hour at the current rate.
+    // Caller holds m_bufferLock.
     const double sr = m_sampleRate.load();
     const int    ch = juce::jmax(1, m_numChannels.load());
-    const int maxSamples = static_cast<int>(sr * kMaxRecordSeconds);  // 1 hour
-    if (maxSamples <= 0)
+    if (sr <= 0.0)
+        return false;
+
+    const auto takeDir = Settings::getInstance().getSettingsDirectory().getChildFile("recordings");
+    if (takeDir.createDirectory().failed())
+        return false;
+
+    m_takeFile = takeDir.getNonexistentChildFile(
+        "Take_" + juce::Time::getCurrentTime().formatted("%Y%m%d_%H%M%S"), ".wav", false);
+
+    auto fileStream = std::make_unique<juce::FileOutputStream>(m_takeFile);
+    if (fileStream->failedToOpen())
         return false;
 
-    if (m_recordedBuffer.getNumChannels() != ch
-        || m_recordedBuffer.getNumSamples() != maxSamples)
+    // 32-bit float keeps the input bit-exact. JUCE's WAV writer reserves room
+    // for a ds64 chunk and switches the header to RF64 once the data passes
+    // 4 GB, so a take has no practical length limit.
+    std::unique_ptr<juce::OutputStream> stream = std::move(fileStream);
+    juce::WavAudioFormat wavFormat;
+    auto writer = wavFormat.createWriterFor(stream,
+                                            juce::AudioFormatWriterOptions()
+                                                .withSampleRate(sr)
+                                                .withNumChannels(ch)
+                                                .withBitsPerSample(32)
+                                                .withSampleFormat(juce::AudioFormatWriterOptions::SampleFormat::floatingPoint));
+    if (writer == nullptr)
     {
-        m_recordedBuffer.setSize(ch, maxSamples);
+        m_takeFile.deleteFile();
+        return false;
     }
-    m_recordedBuffer.clear();
+
+    // The FIFO is allocated once here, so memory stays constant however long
+    // the take runs. It rides out kFifoSeconds of disk stall, less for very
+    // wide inputs where that would cost more than kMaxFifoBytes.
+    const int64_t bytesPerFrame = static_cast<int64_t>(ch) * sizeof(float);
+    const int fifoSamples = static_cast<int>(juce::jmin(static_cast<int64_t>(sr * kFifoSeconds),
+                                                        kMaxFifoBytes / bytesPerFrame));
+
+    if (! m_writerThread.isThreadRunning())
+        m_writerThread.startThread();
+
+    // Runs on the writer thread, which cannot stop the take itself
+    // (closeTakeWriter() waits for it), so listeners are told instead.
+    const auto takePath = m_takeFile.getFullPathName();
+    auto onWriteFailed = [this, takePath]
+    {
+        m_writeFailed.store(true);
+        juce::Logger::writeToLog("RecordingEngine: writing the take failed, disk full or removed? "
+                                 + takePath);
+        notifyListenersAsync();
+    };
+
+    m_writer = std::make_unique<TakeWriter>(std::move(writer), m_writerThread, fifoSamples,
+                                            static_cast<int>(sr * kHeaderFlushSeconds),
+                                            std::move(onWriteFailed));
+
     m_recordedSampleCount = 0;
+    m_activeWriter.store(m_writer.get());
     return true;
 }
 
+void RecordingEngine::closeTakeWriter()
+{
+    // Caller holds m_bufferLock. The audio thread raises m_writerInUse before
+    // it loads m_activeWriter, and we clear m_activeWriter before we check
+    // m_writerInUse, so once the flag reads false no callback can still hold
+    // the writer (both sides are sequentially consistent).
+    m_activeWriter.store(nullptr);
+    while (m_writerInUse.load())
+        juce::Thread::yield();
+
+    // Drains the FIFO to disk and finalizes the WAV header.
+    m_writer.reset();
+}
+
 bool RecordingEngine::stopRecording()
 {
-    if (m_recordingState == RecordingState::IDLE)
+    // Exchange so a stop from the device-teardown thread and one from the
+    // UI cannot both finalize the take
+    if (m_recordingState.exchange(RecordingState::IDLE) == RecordingState::IDLE)
     {
         return false;  // Not recording
     }
 
-    // Stop recording
-    m_recordingState = RecordingState::IDLE;
-
-    // Trim the recorded buffer to actual sample count
+    // Finalize the take. It is not read back here: the editor maps the
+    // file (releaseTakeFile()), so stopping costs the same for any length.
     {
         juce::ScopedLock lock(m_bufferLock);
-
-        int actualSamples = m_recordedSampleCount.load();
-        if (actualSamples > 0 && actualSamples < m_recordedBuffer.getNumSamples())
-        {
-            juce::AudioBuffer<float> trimmedBuffer(m_numChannels, actualSamples);
-            for (int ch = 0; ch < m_numChannels; ++ch)
-            {
-                trimmedBuffer.copyFrom(ch, 0, m_recordedBuffer, ch, 0, actualSamples);
-            }
-            m_recordedBuffer = std::move(trimmedBuffer);
-        }
+        closeTakeWriter();
     }
 
     // Notify listeners. stopRecording() can be invoked from the device
@@ -149,17 +307,19 @@ bool RecordingEngine::isRecording() const
     return m_recordingState == RecordingState::RECORDING;
 }
 
-bool RecordingEngine::isBufferFull() const
-{
-    return m_bufferFull.load();
-}
-
 //==============================================================================
 // Recorded Audio Access
 
-const juce::AudioBuffer<float>& RecordingEngine::getRecordedAudio() const
+juce::File RecordingEngine::releaseTakeFile()
 {
-    return m_recordedBuffer;
+    if (m_recordingState.load() != RecordingState::IDLE)
+        return {};
+
+    juce::ScopedLock lock(m_bufferLock);
+    if (m_writer != nullptr || ! m_takeFile.existsAsFile())
+        return {};
+
+    return std::exchange(m_takeFile, juce::File());
 }
 
 double RecordingEngine::getRecordedSampleRate() const
@@ -184,25 +344,10 @@ int RecordingEngine::getRequestedChannelCount() const
     return juce::jlimit(1, MAX_CHANNELS, m_requestedChannels.load());
 }
 
-double RecordingEngine::getMaxRecordSeconds() const
+juce::File RecordingEngine::getTakeFile() const
 {
-    return kMaxRecordSeconds;
-}
-
-double RecordingEngine::getRemainingRecordSeconds() const
-{
-    const double sr = m_sampleRate.load();
-    if (sr <= 0.0)
-        return 0.0;
-
-    // Capacity is fixed for the duration of a take (only resized under lock
-    // at record start), so reading getNumSamples() lock-free here is safe.
-    const int capacity = m_recordedBuffer.getNumSamples();
-    if (capacity <= 0)
-        return kMaxRecordSeconds;  // not yet allocated -> full cap available
-
-    const int used = m_recordedSampleCount.load();
-    return juce::jmax(0, capacity - used) / sr;
+    juce::ScopedLock lock(m_bufferLock);
+    return m_takeFile;
 }
 
 double RecordingEngine::getRecordingDuration() const
@@ -218,10 +363,12 @@ void RecordingEngine::clearRecording()
 {
     juce::ScopedLock lock(m_bufferLock);
 
-    m_recordedBuffer.clear();
+    // A claimed take now belongs to its document; an unclaimed one stays
+    // on disk so the audio is not lost.
+    m_takeFile = juce::File();
     m_recordedSampleCount = 0;
-    m_bufferFull.store(false);
     m_droppedSampleCount.store(0);  // M17
+    m_writeFailed.store(false);
 
     // Reset level meters
     for (int i = 0; i < MAX_CHANNELS; ++i)
@@ -258,11 +405,9 @@ void RecordingEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
     if (device == nullptr)
         return;
 
-    // Store device parameters only. M18: do NOT allocate the 1-hour
-    // recording buffer here — this fires on every device / sample-rate /
-    // buffer-size change, even while idle, and at pro rates the
-    // allocation is gigabytes under the lock. The buffer is allocated
-    // lazily in startRecording() instead.
+    // Store device parameters only. M18: do NOT open a take here — this
+    // fires on every device / sample-rate / buffer-size change, even while
+    // idle. The take is created in startRecording() instead.
     m_sampleRate = device->getCurrentSampleRate();
 
     // Record how many input channels the device exposes so the recorded
@@ -314,7 +459,7 @@ void RecordingEngine::audioDeviceIOCallbackWithContext(const float* const* input
     // This allows the UI to show levels even before recording starts
     updateInputLevels(inputChannelData, numInputChannels, numSamples);
 
-    // Only append to buffer when actually recording
+    // Only stream to the take when actually recording
     if (m_recordingState == RecordingState::RECORDING)
     {
         appendToRecordingBuffer(inputChannelData, numInputChannels, numSamples);
@@ -367,56 +512,29 @@ void RecordingEngine::appendToRecordingBuffer(const float* const* audioData, int
         return;
     }
 
-    // CRITICAL: Use tryLock to avoid blocking on audio thread
-    if (!m_bufferLock.tryEnter())
-    {
-        // Skip this buffer if we can't get the lock immediately
-        // Better to drop samples than block the audio thread.
-        // M17: track the gap so it isn't invisible. Only counts when we
-        // are actually recording (lock contention while idle is benign).
-        // Atomic increment only — no logging/allocation on the audio
-        // thread; the UI reads getDroppedSampleCount() on its timer.
-        if (m_recordingState.load() == RecordingState::RECORDING)
-            m_droppedSampleCount.fetch_add(numSamples);
-        return;
-    }
+    // Wait-free: no lock, no allocation, no thread signalling (the writer
+    // thread polls the FIFO). The flag pairs with closeTakeWriter() so the
+    // writer cannot be destroyed under us.
+    m_writerInUse.store(true);
 
-    // Manual unlock using RAII pattern
-    struct ScopedUnlocker
+    if (auto* writer = m_activeWriter.load())
     {
-        juce::CriticalSection& lock;
-        ~ScopedUnlocker() { lock.exit(); }
-    } unlocker{m_bufferLock};
-
-    int currentSampleCount = m_recordedSampleCount.load();
-    int availableSpace = m_recordedBuffer.getNumSamples() - currentSampleCount;
-
-    // Check if we have space in the buffer
-    if (availableSpace < numSamples)
-    {
-        // Buffer full - stop recording gracefully. We're on the realtime
-        // audio thread, so we MUST NOT sendChangeMessage()/callAsync here
-        // (C9 / §6.4). Instead set the atomic m_bufferFull flag; the
-        // RecordingDialog's timer polls isBufferFull() and tears down the
-        // recording on the message thread, so the UI does learn that
-        // recording stopped.
-        m_recordingState.store(RecordingState::IDLE);
-        m_bufferFull.store(true);  // Set flag for UI to poll (thread-safe, no allocation)
-        return;
-    }
-
-    // Copy samples to recording buffer
-    int channelsToCopy = juce::jmin(numChannels, m_numChannels.load());
-    for (int ch = 0; ch < channelsToCopy; ++ch)
-    {
-        if (audioData[ch] != nullptr)
-        {
-            m_recordedBuffer.copyFrom(ch, currentSampleCount, audioData[ch], numSamples);
-        }
+        const int channelsToWrite = m_numChannels.load();
+        bool inputsPresent = (numChannels >= channelsToWrite);
+        for (int ch = 0; inputsPresent && ch < channelsToWrite; ++ch)
+            inputsPresent = (audioData[ch] != nullptr);
+
+        // write() fails when the FIFO is full, i.e. the disk has fallen
+        // kFifoSeconds behind, or after a disk write failed. M17: count the
+        // gap so it isn't invisible; the UI reads getDroppedSampleCount()
+        // on its timer.
+        if (inputsPresent && writer->write(audioData, numSamples))
+            m_recordedSampleCount.fetch_add(numSamples);
+        else
+            m_droppedSampleCount.fetch_add(numSamples);
     }
 
-    // Update sample count
-    m_recordedSampleCount = currentSampleCount + numSamples;
+    m_writerInUse.store(false);
 }
 
 void RecordingEngine::notifyListenersAsync()
@@ -17,6 +17,7 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_audio_devices/juce_audio_devices.h>
+#include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_core/juce_core.h>
 
 /**
@@ -33,13 +34,22 @@ enum class RecordingState
  * Audio recording engine for WaveEdit.
  *
  * Handles real-time audio input recording with:
- * - Thread-safe buffer accumulation
+ * - Streaming to a take file on disk (no length limit, constant memory)
  * - Level monitoring for input
- * - Sample rate conversion
+ * - Any number of device input channels
  * - Recording state management
  *
+ * Each take streams to a 32-bit float WAV in the settings folder's
+ * "recordings" directory. The audio thread copies input blocks into a
+ * single-producer AbstractFifo (no lock, no allocation, no signalling) that
+ * a writer thread polls and drains to disk, rewriting the WAV header every
+ * second so a crash leaves a readable file. Past 4 GB the file switches to
+ * RF64. On stop the take is finalized and handed over as a file
+ * (releaseTakeFile()); the editor memory-maps it rather than reading it
+ * into RAM, so a take of any length opens.
+ *
  * Thread Safety:
- * - Audio callback runs on real-time audio thread
+ * - Audio callback runs on real-time audio thread and never locks
  * - UI queries run on message thread
  * - All shared state protected with atomics or locks
  */
@@ -55,15 +65,15 @@ public:
 
     /**
      * Starts recording from the currently selected input device.
-     * Creates a new recording buffer and begins accumulating samples.
+     * Creates a new take file and begins streaming samples to it.
      *
      * @return true if recording started successfully, false otherwise
      */
     bool startRecording();
 
     /**
-     * Stops recording and finalizes the buffer.
-     * After calling this, use getRecordedAudio() to retrieve the buffer.
+     * Stops recording and finalizes the take file.
+     * After calling this, use releaseTakeFile() to claim the take.
      *
      * @return true if recording stopped successfully, false otherwise
      */
@@ -83,24 +93,16 @@ public:
      */
     bool isRecording() const;
 
-    /**
-     * Checks if the recording buffer is full.
-     * Thread-safe, can be polled from UI thread.
-     *
-     * @return true if buffer is full and recording has stopped
-     */
-    bool isBufferFull() const;
-
     //==============================================================================
     // Recorded Audio Access
 
     /**
-     * Gets the recorded audio buffer.
-     * Only valid after stopRecording() has been called.
-     *
-     * @return Reference to the recorded audio buffer
+     * Hands the finalized take file to the caller, which becomes
+     * responsible for it (Document::loadRecordedTake() maps it and deletes
+     * it once no longer needed). Only valid after stopRecording(); returns
+     * File() while recording or if there is no take.
      */
-    const juce::AudioBuffer<float>& getRecordedAudio() const;
+    juce::File releaseTakeFile();
 
     /**
      * Gets the sample rate of the recorded audio.
@@ -117,50 +119,45 @@ public:
     int getRecordedNumChannels() const;
 
     /**
-     * Sets the desired recorded channel count (1 = mono, 2 = stereo).
+     * Sets the desired recorded channel count (1 = mono, 2 = stereo, more
+     * for multichannel interfaces).
      * Applied on the next startRecording(); ignored while recording.
      * Value is clamped to [1, MAX_CHANNELS]. The engine captures the first
      * `channelCount` device input channels (mono = input 1, stereo =
      * inputs 1-2); it does not downmix.
      *
-     * @param channelCount 1 for mono, 2 for stereo
+     * @param channelCount Number of device inputs to record
      */
     void setRequestedChannelCount(int channelCount);
 
     /**
-     * Gets the requested recorded channel count (1 or 2).
+     * Gets the requested recorded channel count.
      */
     int getRequestedChannelCount() const;
 
     /**
-     * Hard cap on recording duration in seconds (RAM-bounded ring; the
-     * buffer holds this many seconds regardless of channel count because
-     * capacity scales with the sample rate).
-     */
-    static constexpr double kMaxRecordSeconds = 3600.0;  // 1 hour
-
-    /**
-     * Maximum recordable duration in seconds for the current configuration.
-     * Thread-safe; safe to poll from the UI timer.
+     * Most input channels one take can record.
      */
-    double getMaxRecordSeconds() const;
+    static constexpr int MAX_CHANNELS = 64;
 
     /**
-     * Remaining recordable time in seconds before the RAM cap is hit,
-     * based on the real buffer capacity, the recorded sample count, and
-     * the sample rate. Thread-safe; safe to poll from the UI timer.
+     * The current or last take's WAV file, until releaseTakeFile() hands it
+     * over. The engine never deletes a take: one that nobody claimed is
+     * left on disk for the user.
      */
-    double getRemainingRecordSeconds() const;
+    juce::File getTakeFile() const;
 
     /**
-     * Gets the total recording duration in seconds.
+     * Gets the total recording duration in seconds (samples that reached
+     * the writer FIFO).
      *
      * @return Duration in seconds
      */
     double getRecordingDuration() const;
 
     /**
-     * Clears the recorded audio buffer and resets state.
+     * Forgets the last take (leaving any unclaimed file on disk) and resets
+     * state.
      */
     void clearRecording();
 
@@ -171,7 +168,7 @@ public:
      * Gets the current peak input level for a specific channel.
      * Thread-safe, can be called from UI thread.
      *
-     * @param channel Channel index (0 = left, 1 = right)
+     * @param channel Input channel index (0 = left, 1 = right)
      * @return Peak level in range [0.0, 1.0+]
      */
     float getInputPeakLevel(int channel) const;
@@ -180,7 +177,7 @@ public:
      * Gets the current RMS input level for a specific channel.
      * Thread-safe, can be called from UI thread.
      *
-     * @param channel Channel index (0 = left, 1 = right)
+     * @param channel Input channel index (0 = left, 1 = right)
      * @return RMS level in range [0.0, 1.0+]
      */
     float getInputRMSLevel(int channel) const;
@@ -217,21 +214,32 @@ private:
     std::atomic<RecordingState> m_recordingState;
     std::atomic<double> m_sampleRate;
     std::atomic<int> m_numChannels;   // resolved recorded channel count (set on record start)
-    std::atomic<bool> m_bufferFull;  // Set by audio thread when buffer is full
 
-    // User-requested channel count (1 or 2), and the input channel count
+    // User-requested channel count, and the input channel count
     // reported by the current device. The recorded channel count is
     // resolved from these on record start (min of the two, at least 1).
     std::atomic<int> m_requestedChannels { 2 };
     std::atomic<int> m_deviceInputChannels { 0 };
 
-    // Audio buffer for recorded samples
-    juce::AudioBuffer<float> m_recordedBuffer;
-    std::atomic<int> m_recordedSampleCount;
-    juce::CriticalSection m_bufferLock;
+    // Take streaming. The audio thread only touches m_activeWriter, under
+    // the m_writerInUse handshake, so the writer can be finalized without
+    // the audio thread ever taking a lock (see closeTakeWriter()).
+    class TakeWriter;
+    juce::TimeSliceThread m_writerThread { "Recording Writer" };
+    std::unique_ptr<TakeWriter> m_writer;
+    std::atomic<TakeWriter*> m_activeWriter { nullptr };
+    std::atomic<bool> m_writerInUse { false };
+    juce::File m_takeFile;
+
+    static constexpr double kFifoSeconds = 10.0;          // Disk stall the FIFO rides out
+    static constexpr int64_t kMaxFifoBytes = 64 << 20;    // Caps the FIFO for wide inputs
+    static constexpr double kHeaderFlushSeconds = 1.0;    // WAV header rewrite interval
+    static constexpr int kWriterPollMs = 10;              // Writer thread's FIFO poll interval
+
+    std::atomic<int64_t> m_recordedSampleCount;
+    juce::CriticalSection m_bufferLock;   // Guards m_writer and m_takeFile (never the audio thread)
 
     // Level monitoring
-    static constexpr int MAX_CHANNELS = 2;  // Stereo support
     std::atomic<float> m_inputPeakLevels[MAX_CHANNELS];
     std::atomic<float> m_inputRMSLevels[MAX_CHANNELS];
 
@@ -249,8 +257,9 @@ private:
     void updateInputLevels(const float* const* audioData, int numChannels, int numSamples);
 
     /**
-     * Appends audio samples to the recording buffer.
-     * Called from audio callback thread.
+     * Pushes audio samples into the take's writer FIFO.
+     * Called from audio callback thread; wait-free (atomics and a copy
+     * only -- the writer thread polls the FIFO, so nothing is signalled).
      *
      * @param audioData Audio samples to append
      * @param numChannels Number of channels
@@ -271,13 +280,19 @@ private:
     void notifyListenersAsync();
 
     /**
-     * Lazily allocate the recording buffer for the current sample rate /
-     * channel count (M18). Called on record START, not on device start,
-     * so a device (re)configuration while idle never allocates the full
-     * 1-hour buffer. Returns false if allocation could not proceed.
+     * Creates the take file and its threaded writer for the current sample
+     * rate / channel count, and publishes it to the audio thread. Returns
+     * false if the file or writer could not be created.
      * Caller must hold m_bufferLock.
      */
-    bool ensureRecordingBufferAllocated();
+    bool openTakeWriter();
+
+    /**
+     * Unpublishes the writer, waits for an in-flight audio callback to
+     * leave it, then destroys it, which drains the FIFO and finalizes the
+     * WAV header. Caller must hold m_bufferLock.
+     */
+    void closeTakeWriter();
 
     /**
      * Resolves m_numChannels (the recorded channel count) from the
@@ -286,17 +301,26 @@ private:
      */
     void resolveRecordChannels();
 
-    // M17: count of input samples dropped because the audio thread could
-    // not acquire m_bufferLock (non-blocking tryEnter). Surfaced to the
-    // UI so the silent gap at the stop boundary is visible.
+    // M17: count of input samples dropped because the writer FIFO was
+    // full, i.e. the disk fell more than kFifoSeconds behind. Surfaced to
+    // the UI so a gap in the take is visible.
     std::atomic<int> m_droppedSampleCount { 0 };
 
+    // Set by the writer thread when writing the take to disk fails.
+    std::atomic<bool> m_writeFailed { false };
+
 public:
     /** M17: total input samples dropped during the last/current
-        recording because the buffer lock was contended. Non-zero means
-        a short gap exists near a stop/clear boundary. Thread-safe. */
+        recording because the disk could not keep up. Non-zero means the
+        take has a gap. Thread-safe. */
     int getDroppedSampleCount() const { return m_droppedSampleCount.load(); }
 
+    /** True once writing the last/current take to disk has failed (disk
+        full, drive removed). The take keeps what was written before the
+        failure and nothing after it, so the recording should be stopped;
+        listeners get a change message when it happens. Thread-safe. */
+    bool hasWriteFailed() const { return m_writeFailed.load(); }
+
 private:
     JUCE_DECLARE_WEAK_REFERENCEABLE(RecordingEngine)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RecordingEngine)
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    SampleRateConverter.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Polyphase windowed-sinc sample rate converter.
+ *
+ * Rates are reduced to a ratio of integers L/M (44.1k -> 48k is 160/147),
+ * and each output sample is one dot product of a precomputed filter phase
+ * with the input. When L is small enough (the whole 44.1k/48k family, and
+ * every rate in the Resample dialog against another), the bank holds one
+ * exact phase per L and positions are tracked in integers, so there is no
+ * drift however long the stream. Other ratios use a finely sampled bank
+ * and interpolate between neighbouring phases. Banks are Kaiser-windowed
+ * sincs whose cutoff follows the lower of the two Nyquist rates, so
+ * downsampling is band-limited rather than aliasing. They are cached and
+ * shared between converters.
+ *
+ * Use resample() for a whole buffer; it renders channels and output chunks
+ * in parallel. For chunked work (batch conversion, saving), create a
+ * converter and feed it blocks through process(), then call finish() to
+ * flush the filter tail. Both give identical output.
+ *
+ * Not thread-safe: one converter instance per stream.
+ */
+class SampleRateConverter
+{
+public:
+    /** Filter length / stopband trade-off. */
+    enum class Quality
+    {
+        Draft,      // ~60 dB stopband, shortest filters; previews
+        Standard,   // ~90 dB
+        High        // ~120 dB; default for edits and renders
+    };
+
+    SampleRateConverter(double sourceSampleRate, double targetSampleRate,
+                        int numChannels, Quality quality = Quality::High);
+    ~SampleRateConverter();
+
+    /** Forgets all input, ready for a new stream. */
+    void reset();
+
+    /**
+     * Output samples a stream of numInputSamples source samples converts to.
+     */
+    int64_t getOutputLength(int64_t numInputSamples) const;
+
+    /**
+     * Upper bound on what the next process() (or finish(), with 0) call can
+     * write, for sizing the output buffers.
+     */
+    int getMaxOutputSamples(int numInputSamples) const;
+
+    /**
+     * Feeds numInputSamples per channel and writes every output sample that
+     * can now be computed. Output lags input by half the filter length until
+     * finish() is called.
+     *
+     * @param input   numChannels read pointers
+     * @param output  numChannels write pointers with getMaxOutputSamples() room
+     * @return Number of samples written per channel
+     */
+    int process(const float* const* input, int numInputSamples, float* const* output);
+
+    /**
+     * Flushes the filter tail at the end of the stream. Afterwards the total
+     * output equals getOutputLength(total input). Call reset() to reuse.
+     *
+     * @return Number of samples written per channel
+     */
+    int finish(float* const* output);
+
+    /**
+     * Converts a whole buffer, splitting channels and output chunks across
+     * cores.
+     *
+     * @throws std::length_error if the result would exceed an AudioBuffer's size
+     */
+    static juce::AudioBuffer<float> resample(const juce::AudioBuffer<float>& source,
+                                             double sourceSampleRate,
+                                             double targetSampleRate,
+                                             Quality quality = Quality::High);
+
+    /** Display names, indexed by Quality. */
+    static juce::StringArray getQualityNames();
+
+private:
+    struct FilterBank;
+
+    static std::shared_ptr<const FilterBank> getFilterBank(double sourceSampleRate,
+                                                           double targetSampleRate,
+                                                           Quality quality);
+
+    void appendInput(const float* const* input, int numInputSamples);
+    int renderAvailable(float* const* output, int64_t outputLimit);
+
+    std::shared_ptr<const FilterBank> m_bank;   // nullptr when the rates match
+    int m_numChannels;
+
+    // Input not yet consumed by every output that needs it. m_history
+    // sample 0 is absolute input sample m_historyStart (negative at the
+    // start of a stream, where the window reads leading zeros).
+    juce::AudioBuffer<float> m_history;
+    int m_historySize = 0;
+    int64_t m_historyStart = 0;
+
+    int64_t m_inputCount = 0;     // Source samples fed since reset()
+    int64_t m_nextOutput = 0;     // Index of the next output sample
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleRateConverter)
+};
@@ -0,0 +1,613 @@
+/*
+  ==============================================================================
+
+    SpectrogramCache.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "SpectrogramCache.h"
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <tuple>
+
+//==============================================================================
+namespace
+{
+    // Finest first: 1024-point FFT every 256 samples (~5 ms at 48 kHz) for
+    // clicks, up to 4096 points every 4096 samples (~12 Hz bands) for hum.
+    constexpr SpectrogramCache::Level kLevels[SpectrogramCache::kNumLevels] = {
+        { 10, 256 },
+        { 11, 1024 },
+        { 12, 4096 }
+    };
+
+    // Overview file header: magic, version, channels, samples, sample rate,
+    // FFT order, hop, bands. Bump kFileVersion whenever the layout or the
+    // analysis changes.
+    constexpr char kFileMagic[8] = { 'W', 'E', 'S', 'P', 'E', 'C', 'T', 0 };
+    constexpr int kFileVersion = 1;
+
+    int64_t ceilDiv(int64_t value, int64_t divisor)
+    {
+        return (value + divisor - 1) / divisor;
+    }
+
+    uint8_t toByte(float magnitude)
+    {
+        const float decibels = juce::Decibels::gainToDecibels(magnitude, SpectrogramCache::kMinDecibels);
+        const float normalised = 1.0f - decibels / SpectrogramCache::kMinDecibels;
+        return static_cast<uint8_t>(juce::jlimit(0, 255, juce::roundToInt(normalised * 255.0f)));
+    }
+}
+
+//==============================================================================
+bool SpectrogramCache::TileKey::operator< (const TileKey& other) const
+{
+    return std::tie(level, channel, index) < std::tie(other.level, other.channel, other.index);
+}
+
+bool SpectrogramCache::TileKey::operator== (const TileKey& other) const
+{
+    return level == other.level && channel == other.channel && index == other.index;
+}
+
+SpectrogramCache::Level SpectrogramCache::getLevel(int level)
+{
+    return kLevels[juce::jlimit(0, kNumLevels - 1, level)];
+}
+
+int SpectrogramCache::getLevelFor(double samplesPerPixel)
+{
+    for (int level = kNumLevels - 1; level > 0; --level)
+        if (kLevels[level].hopSize <= samplesPerPixel)
+            return level;
+
+    return 0;
+}
+
+//==============================================================================
+class SpectrogramCache::RequestJob : public juce::ThreadPoolJob
+{
+public:
+    explicit RequestJob(SpectrogramCache& owner)
+        : juce::ThreadPoolJob("Spectrogram Tile"),
+          m_owner(owner)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        m_owner.runOneRequest();
+        return jobHasFinished;
+    }
+
+    bool belongsTo(const SpectrogramCache& cache) const { return &m_owner == &cache; }
+
+private:
+    SpectrogramCache& m_owner;
+};
+
+juce::ThreadPool& SpectrogramCache::getPool()
+{
+    static juce::ThreadPool pool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1));
+    return pool;
+}
+
+//==============================================================================
+SpectrogramCache::SpectrogramCache(SampleSource source, std::function<void()> tileReady)
+    : m_source(std::move(source)),
+      m_tileReady(std::move(tileReady))
+{
+}
+
+SpectrogramCache::~SpectrogramCache()
+{
+    // Jobs call back into this object: drop the queued ones and let the
+    // running ones finish. Other caches' jobs carry on.
+    struct OwnJobs : juce::ThreadPool::JobSelector
+    {
+        explicit OwnJobs(const SpectrogramCache& cache) : owner(cache) {}
+
+        bool isJobSuitable(juce::ThreadPoolJob* job) override
+        {
+            auto* request = dynamic_cast<RequestJob*>(job);
+            return request != nullptr && request->belongsTo(owner);
+        }
+
+        const SpectrogramCache& owner;
+    };
+
+    OwnJobs ownJobs(*this);
+    getPool().removeAllJobs(true, 10000, &ownJobs);
+}
+
+std::shared_ptr<const SpectrogramCache::Analysis> SpectrogramCache::buildAnalysis(double sampleRate)
+{
+    auto analysis = std::make_shared<Analysis>();
+    const double nyquist = sampleRate * 0.5;
+
+    for (int level = 0; level < kNumLevels; ++level)
+    {
+        const int fftSize = 1 << kLevels[level].fftOrder;
+
+        auto& window = analysis->windows[level];
+        window.resize(static_cast<size_t>(fftSize));
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(
+            window.data(), static_cast<size_t>(fftSize), juce::dsp::WindowingFunction<float>::hann, false);
+
+        float windowSum = 0.0f;
+        for (float w : window)
+            windowSum += w;
+        analysis->gain[level] = windowSum > 0.0f ? 2.0f / windowSum : 0.0f;
+
+        // Log-spaced band edges. Low bands narrower than one FFT bin still
+        // get the bin they fall in, so neighbouring rows may repeat.
+        auto& ranges = analysis->bandRanges[level];
+        ranges.resize(kNumBins);
+        const double binWidth = sampleRate / fftSize;
+        const double ratio = nyquist > kMinFrequency ? std::log(nyquist / kMinFrequency) : 0.0;
+
+        for (int band = 0; band < kNumBins; ++band)
+        {
+            const double low = kMinFrequency * std::exp(ratio * band / kNumBins);
+            const double high = kMinFrequency * std::exp(ratio * (band + 1) / kNumBins);
+            const int first = juce::jlimit(0, fftSize / 2, static_cast<int>(low / binWidth));
+            const int end = juce::jlimit(first + 1, fftSize / 2 + 1, static_cast<int>(std::ceil(high / binWidth)));
+            ranges[static_cast<size_t>(band)] = { first, end };
+        }
+    }
+
+    return analysis;
+}
+
+void SpectrogramCache::reset(int numChannels, int64_t numSamples, double sampleRate)
+{
+    juce::ScopedLock lock(m_lock);
+
+    ++m_epoch;
+    m_numChannels = juce::jmax(0, numChannels);
+    m_numSamples = juce::jmax<int64_t>(0, numSamples);
+
+    if (sampleRate != m_sampleRate || m_analysis == nullptr)
+    {
+        m_sampleRate = sampleRate;
+        m_analysis = sampleRate > 0.0 ? buildAnalysis(sampleRate) : nullptr;
+    }
+
+    m_overview.assign(static_cast<size_t>(m_numChannels),
+                      std::vector<TilePtr>(static_cast<size_t>(ceilDiv(getNumColumns(kOverviewLevel), kColumnsPerTile))));
+    m_overviewBytes = 0;
+    m_detailTiles.clear();
+    m_detailIndex.clear();
+    m_detailBytes = 0;
+    m_pendingUrgent.clear();
+    m_pendingBackground.clear();
+
+    // Anything still computing belongs to the old audio.
+    for (auto& request : m_inFlight)
+        request.stale = true;
+}
+
+bool SpectrogramCache::isEmpty() const
+{
+    juce::ScopedLock lock(m_lock);
+    return m_numChannels == 0 || m_numSamples == 0 || m_analysis == nullptr;
+}
+
+int64_t SpectrogramCache::getNumColumns(int level) const
+{
+    juce::ScopedLock lock(m_lock);
+    return ceilDiv(m_numSamples, getLevel(level).hopSize);
+}
+
+float SpectrogramCache::getBinFrequency(int bin) const
+{
+    juce::ScopedLock lock(m_lock);
+    const double nyquist = m_sampleRate * 0.5;
+    if (nyquist <= kMinFrequency)
+        return kMinFrequency;
+
+    return static_cast<float>(kMinFrequency * std::exp(std::log(nyquist / kMinFrequency) * bin / kNumBins));
+}
+
+//==============================================================================
+SpectrogramCache::TilePtr SpectrogramCache::getTile(int level, int channel, int64_t tileIndex)
+{
+    juce::ScopedLock lock(m_lock);
+
+    if (channel < 0 || channel >= m_numChannels || tileIndex < 0 || m_analysis == nullptr)
+        return nullptr;
+
+    if (level == kOverviewLevel)
+    {
+        auto& tiles = m_overview[static_cast<size_t>(channel)];
+        if (tileIndex >= static_cast<int64_t>(tiles.size()))
+            return nullptr;
+
+        if (auto tile = tiles[static_cast<size_t>(tileIndex)])
+            return tile;
+    }
+    else
+    {
+        const auto found = m_detailIndex.find({ level, channel, tileIndex });
+        if (found != m_detailIndex.end())
+        {
+            m_detailTiles.splice(m_detailTiles.begin(), m_detailTiles, found->second);
+            return found->second->second;
+        }
+    }
+
+    requestLocked({ level, channel, tileIndex }, true);
+    return nullptr;
+}
+
+void SpectrogramCache::requestOverview()
+{
+    juce::ScopedLock lock(m_lock);
+
+    // Queued last tile first so the pool works through the file from the start.
+    for (int channel = 0; channel < m_numChannels; ++channel)
+    {
+        const auto& tiles = m_overview[static_cast<size_t>(channel)];
+        for (int64_t index = static_cast<int64_t>(tiles.size()) - 1; index >= 0; --index)
+            if (tiles[static_cast<size_t>(index)] == nullptr)
+                requestLocked({ kOverviewLevel, channel, index }, false);
+    }
+}
+
+bool SpectrogramCache::isOverviewComplete() const
+{
+    juce::ScopedLock lock(m_lock);
+
+    if (m_overview.empty())
+        return false;
+
+    for (const auto& tiles : m_overview)
+        for (const auto& tile : tiles)
+            if (tile == nullptr)
+                return false;
+
+    return true;
+}
+
+void SpectrogramCache::requestLocked(const TileKey& key, bool onScreen)
+{
+    const auto computing = std::any_of(m_inFlight.begin(), m_inFlight.end(), [&key](const PendingTile& p)
+    {
+        return p.key == key && ! p.stale;
+    });
+    if (computing)
+        return;
+
+    // On-screen requests are served newest first, and the oldest are
+    // dropped once the view has clearly moved on.
+    const auto urgent = std::find(m_pendingUrgent.begin(), m_pendingUrgent.end(), key);
+    if (urgent != m_pendingUrgent.end())
+    {
+        std::rotate(urgent, urgent + 1, m_pendingUrgent.end());
+        return;
+    }
+
+    const auto background = std::find(m_pendingBackground.begin(), m_pendingBackground.end(), key);
+    if (background != m_pendingBackground.end())
+    {
+        if (! onScreen)
+            return;
+
+        // Now visible: promote it (it already has a job).
+        m_pendingBackground.erase(background);
+        m_pendingUrgent.push_back(key);
+        return;
+    }
+
+    auto& queue = onScreen ? m_pendingUrgent : m_pendingBackground;
+    queue.push_back(key);
+
+    constexpr size_t kMaxPendingUrgent = 256;
+    if (onScreen && queue.size() > kMaxPendingUrgent)
+        queue.erase(queue.begin());
+
+    // One job per queued tile; a job that finds the queue empty just returns.
+    getPool().addJob(new RequestJob(*this), true);
+}
+
+void SpectrogramCache::runOneRequest()
+{
+    PendingTile request;
+    std::shared_ptr<const Analysis> analysis;
+    int64_t numSamples = 0;
+    int64_t numColumns = 0;
+
+    {
+        juce::ScopedLock lock(m_lock);
+
+        auto& queue = ! m_pendingUrgent.empty() ? m_pendingUrgent : m_pendingBackground;
+        if (queue.empty() || m_analysis == nullptr)
+            return;
+
+        request.key = queue.back();
+        request.epoch = m_epoch;
+        queue.pop_back();
+        m_inFlight.push_back(request);
+
+        analysis = m_analysis;
+        numSamples = m_numSamples;
+        numColumns = ceilDiv(m_numSamples, getLevel(request.key.level).hopSize);
+    }
+
+    // Nothing to redraw for a discarded tile; a failed read would otherwise
+    // repaint, ask again and fail again in a loop.
+    if (storeTile(request, computeTile(request.key, *analysis, numSamples, numColumns)) && m_tileReady)
+        m_tileReady();
+}
+
+void SpectrogramCache::getTileSampleRange(const TileKey& key, int64_t& start, int64_t& end)
+{
+    const auto level = getLevel(key.level);
+    const int64_t fftSize = int64_t { 1 } << level.fftOrder;
+    const int64_t firstColumn = key.index * kColumnsPerTile;
+
+    // Column c's window is centred on the middle of hop c.
+    start = firstColumn * level.hopSize + level.hopSize / 2 - fftSize / 2;
+    end = start + static_cast<int64_t>(kColumnsPerTile - 1) * level.hopSize + fftSize;
+}
+
+SpectrogramCache::TilePtr SpectrogramCache::computeTile(const TileKey& key, const Analysis& analysis,
+                                                        int64_t numSamples, int64_t numColumns) const
+{
+    const auto level = getLevel(key.level);
+    const int fftSize = 1 << level.fftOrder;
+    const int64_t firstColumn = key.index * kColumnsPerTile;
+    const int tileColumns = static_cast<int>(juce::jlimit<int64_t>(0, kColumnsPerTile, numColumns - firstColumn));
+    if (tileColumns <= 0)
+        return nullptr;
+
+    // Read every window of the tile in one go, zero-padded outside the audio.
+    int64_t spanStart = 0;
+    int64_t spanEnd = 0;
+    getTileSampleRange(key, spanStart, spanEnd);
+
+    std::vector<float> samples(static_cast<size_t>(spanEnd - spanStart), 0.0f);
+    const int64_t readStart = juce::jmax<int64_t>(0, spanStart);
+    const int64_t readEnd = juce::jmin(numSamples, spanEnd);
+    if (readEnd > readStart
+        && ! m_source(key.channel, readStart, static_cast<int>(readEnd - readStart),
+                      samples.data() + (readStart - spanStart)))
+    {
+        return nullptr;
+    }
+
+    juce::dsp::FFT fft(level.fftOrder);
+    std::vector<float> fftData(static_cast<size_t>(2 * fftSize));
+    const auto& window = analysis.windows[key.level];
+    const auto& bands = analysis.bandRanges[key.level];
+    const float gain = analysis.gain[key.level];
+
+    auto tile = std::make_shared<Tile>();
+    tile->magnitudes.assign(static_cast<size_t>(kColumnsPerTile * kNumBins), 0);
+
+    for (int column = 0; column < tileColumns; ++column)
+    {
+        const float* frame = samples.data() + static_cast<size_t>(column) * static_cast<size_t>(level.hopSize);
+        for (int i = 0; i < fftSize; ++i)
+            fftData[static_cast<size_t>(i)] = frame[i] * window[static_cast<size_t>(i)];
+        std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+        fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+        uint8_t* dest = tile->magnitudes.data() + column * kNumBins;
+        for (int band = 0; band < kNumBins; ++band)
+        {
+            const auto range = bands[static_cast<size_t>(band)];
+            float loudest = 0.0f;
+            for (int bin = range.first; bin < range.second; ++bin)
+                loudest = juce::jmax(loudest, fftData[static_cast<size_t>(bin)]);
+
+            dest[band] = toByte(loudest * gain);
+        }
+    }
+
+    return tile;
+}
+
+bool SpectrogramCache::storeTile(const PendingTile& request, TilePtr tile)
+{
+    juce::ScopedLock lock(m_lock);
+
+    const auto flight = std::find_if(m_inFlight.begin(), m_inFlight.end(), [&request](const PendingTile& p)
+    {
+        return p.key == request.key && p.epoch == request.epoch;
+    });
+
+    const bool stale = flight == m_inFlight.end() || flight->stale || request.epoch != m_epoch;
+    if (flight != m_inFlight.end())
+        m_inFlight.erase(flight);
+
+    if (stale || tile == nullptr)
+        return false;
+
+    const auto& key = request.key;
+    if (key.level == kOverviewLevel)
+    {
+        auto& tiles = m_overview[static_cast<size_t>(key.channel)];
+        if (key.index >= static_cast<int64_t>(tiles.size()))
+            return false;
+
+        auto& slot = tiles[static_cast<size_t>(key.index)];
+        if (slot == nullptr)
+            m_overviewBytes += kTileBytes;
+
+        slot = std::move(tile);
+        trimToBudgetLocked();
+        return true;
+    }
+
+    if (m_detailIndex.count(key) != 0)
+        return false;
+
+    m_detailTiles.emplace_front(key, std::move(tile));
+    m_detailIndex[key] = m_detailTiles.begin();
+    m_detailBytes += kTileBytes;
+
+    trimToBudgetLocked();
+    return true;
+}
+
+void SpectrogramCache::trimToBudgetLocked()
+{
+    // The overview cannot be recomputed piecemeal behind the view, so only
+    // detail tiles go; the most recent one stays for the frame asking for it.
+    while (m_overviewBytes + m_detailBytes > kBudgetBytes && m_detailTiles.size() > 1)
+    {
+        m_detailIndex.erase(m_detailTiles.back().first);
+        m_detailTiles.pop_back();
+        m_detailBytes -= kTileBytes;
+    }
+}
+
+void SpectrogramCache::invalidateSamples(int64_t startSample, int64_t endSample)
+{
+    if (endSample <= startSample)
+        return;
+
+    const auto touches = [startSample, endSample](const TileKey& key)
+    {
+        int64_t tileStart = 0;
+        int64_t tileEnd = 0;
+        getTileSampleRange(key, tileStart, tileEnd);
+        return endSample > tileStart && startSample < tileEnd;
+    };
+
+    juce::ScopedLock lock(m_lock);
+
+    for (int channel = 0; channel < static_cast<int>(m_overview.size()); ++channel)
+    {
+        auto& tiles = m_overview[static_cast<size_t>(channel)];
+        for (int64_t index = 0; index < static_cast<int64_t>(tiles.size()); ++index)
+        {
+            if (tiles[static_cast<size_t>(index)] != nullptr && touches({ kOverviewLevel, channel, index }))
+            {
+                tiles[static_cast<size_t>(index)] = nullptr;
+                m_overviewBytes -= kTileBytes;
+            }
+        }
+    }
+
+    for (auto it = m_detailTiles.begin(); it != m_detailTiles.end();)
+    {
+        if (touches(it->first))
+        {
+            m_detailIndex.erase(it->first);
+            it = m_detailTiles.erase(it);
+            m_detailBytes -= kTileBytes;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto& request : m_inFlight)
+        if (touches(request.key))
+            request.stale = true;
+}
+
+//==============================================================================
+bool SpectrogramCache::writeOverviewTo(juce::OutputStream& out) const
+{
+    if (! isOverviewComplete())
+        return false;
+
+    juce::ScopedLock lock(m_lock);
+
+    const auto level = getLevel(kOverviewLevel);
+    const int64_t numColumns = ceilDiv(m_numSamples, level.hopSize);
+
+    bool ok = out.write(kFileMagic, sizeof(kFileMagic))
+              && out.writeInt(kFileVersion)
+              && out.writeInt(m_numChannels)
+              && out.writeInt64(m_numSamples)
+              && out.writeDouble(m_sampleRate)
+              && out.writeInt(level.fftOrder)
+              && out.writeInt(level.hopSize)
+              && out.writeInt(kNumBins);
+
+    for (const auto& tiles : m_overview)
+    {
+        int64_t remaining = numColumns;
+        for (const auto& tile : tiles)
+        {
+            const auto columns = juce::jmin<int64_t>(kColumnsPerTile, remaining);
+            ok = ok && out.write(tile->magnitudes.data(), static_cast<size_t>(columns * kNumBins));
+            remaining -= columns;
+        }
+    }
+
+    return ok;
+}
+
+bool SpectrogramCache::readOverviewFrom(juce::InputStream& in)
+{
+    char magic[sizeof(kFileMagic)] = {};
+    if (in.read(magic, sizeof(magic)) != static_cast<int>(sizeof(magic))
+        || std::memcmp(magic, kFileMagic, sizeof(kFileMagic)) != 0
+        || in.readInt() != kFileVersion)
+    {
+        return false;
+    }
+
+    const int numChannels = in.readInt();
+    const int64_t numSamples = in.readInt64();
+    const double sampleRate = in.readDouble();
+    const int fftOrder = in.readInt();
+    const int hopSize = in.readInt();
+    const int numBins = in.readInt();
+
+    const auto level = getLevel(kOverviewLevel);
+
+    juce::ScopedLock lock(m_lock);
+
+    if (numChannels != m_numChannels || numSamples != m_numSamples || sampleRate != m_sampleRate
+        || fftOrder != level.fftOrder || hopSize != level.hopSize || numBins != kNumBins)
+    {
+        return false;
+    }
+
+    const int64_t numColumns = ceilDiv(numSamples, hopSize);
+    const auto numTiles = static_cast<size_t>(ceilDiv(numColumns, kColumnsPerTile));
+    std::vector<std::vector<TilePtr>> overview(static_cast<size_t>(numChannels));
+
+    for (auto& tiles : overview)
+    {
+        int64_t remaining = numColumns;
+        for (size_t index = 0; index < numTiles; ++index)
+        {
+            const auto columns = juce::jmin<int64_t>(kColumnsPerTile, remaining);
+            auto tile = std::make_shared<Tile>();
+            tile->magnitudes.assign(static_cast<size_t>(kColumnsPerTile * kNumBins), 0);
+
+            const auto bytes = static_cast<int>(columns * kNumBins);
+            if (in.read(tile->magnitudes.data(), bytes) != bytes)
+                return false;
+
+            tiles.push_back(std::move(tile));
+            remaining -= columns;
+        }
+    }
+
+    m_overview = std::move(overview);
+    m_overviewBytes = static_cast<int64_t>(numChannels) * static_cast<int64_t>(numTiles) * kTileBytes;
+    m_pendingBackground.clear();
+    trimToBudgetLocked();
+    return true;
+}
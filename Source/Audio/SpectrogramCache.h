@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    SpectrogramCache.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * Short-time Fourier transform of a document's audio, computed in tiles on
+ * a thread pool and cached for the spectrogram view.
+ *
+ * There are kNumLevels time/frequency resolutions. Each level has its own
+ * FFT size and hop, and a column of level L analyses one hop of audio,
+ * centred on the hop. Every column is reduced to kNumBins log-spaced bands
+ * from kMinFrequency to Nyquist, with each band keeping the loudest FFT bin
+ * inside it. Magnitudes are stored as one byte each, spanning
+ * kMinDecibels..0 dBFS.
+ *
+ * The coarsest level is the overview. It is computed for the whole file
+ * (requestOverview()), kept for as long as the audio is unchanged, and can
+ * be written out and read back with writeOverviewTo()/readOverviewFrom()
+ * so a reopened file shows its spectrogram at once. The detail levels are
+ * computed on demand for what is on screen and held in an LRU cache. Both
+ * count toward kBudgetBytes: the overview (about 21 MB per channel-hour
+ * at 48 kHz) is never evicted, so the detail tiles get what it leaves.
+ *
+ * getTile() returns a computed tile, or nullptr after queueing it ahead of
+ * the background overview work; the tileReady callback fires (on a pool
+ * thread) as tiles are stored. A tile the source cannot supply is simply
+ * not stored, and is asked for again by the next getTile(). Edits call
+ * invalidateSamples(), and results computed from superseded audio are
+ * discarded.
+ *
+ * Tiles are computed on one pool of (CPU count - 1) threads shared by
+ * every cache, so opening more documents does not add threads.
+ */
+class SpectrogramCache
+{
+public:
+    /** Log-spaced frequency bands per column. */
+    static constexpr int kNumBins = 256;
+
+    /** Lower edge of the lowest band, in Hz. */
+    static constexpr float kMinFrequency = 20.0f;
+
+    /** Level of a zero byte; 255 is 0 dBFS. */
+    static constexpr float kMinDecibels = -120.0f;
+
+    /** Columns per tile. */
+    static constexpr int kColumnsPerTile = 256;
+
+    static constexpr int kNumLevels = 3;
+    static constexpr int kOverviewLevel = kNumLevels - 1;
+
+    /**
+     * Tile bytes, overview included, kept before the least recently used
+     * detail tiles are dropped.
+     */
+    static constexpr int64_t kBudgetBytes = 128 * 1024 * 1024;
+
+    struct Level
+    {
+        int fftOrder;
+        int hopSize;
+    };
+
+    /** FFT order and hop of level (0 is the finest). */
+    static Level getLevel(int level);
+
+    /** The coarsest level whose hop is no wider than samplesPerPixel (level 0 when zoomed in further). */
+    static int getLevelFor(double samplesPerPixel);
+
+    /** kColumnsPerTile columns of kNumBins bytes, stored column by column; bin 0 is the lowest band. */
+    struct Tile
+    {
+        std::vector<uint8_t> magnitudes;
+
+        const uint8_t* getColumn(int column) const { return magnitudes.data() + column * kNumBins; }
+    };
+
+    using TilePtr = std::shared_ptr<const Tile>;
+
+    /**
+     * Copies numSamples of channel from startSample into dest. The range is
+     * always inside the audio. Called on pool threads; must do its own
+     * locking. Returns false if the audio cannot be read.
+     */
+    using SampleSource = std::function<bool(int channel, int64_t startSample, int numSamples, float* dest)>;
+
+    SpectrogramCache(SampleSource source, std::function<void()> tileReady);
+    ~SpectrogramCache();
+
+    /** Drops everything and sizes the cache for audio of this shape. */
+    void reset(int numChannels, int64_t numSamples, double sampleRate);
+
+    bool isEmpty() const;
+
+    /** Columns in level for the current audio. */
+    int64_t getNumColumns(int level) const;
+
+    /** The tile, or nullptr after queueing it for computation. Message thread. */
+    TilePtr getTile(int level, int channel, int64_t tileIndex);
+
+    /** Queues every missing overview tile, behind any detail tiles. */
+    void requestOverview();
+
+    /** True once every overview tile of every channel is computed. */
+    bool isOverviewComplete() const;
+
+    /** Drops every tile whose analysis windows touch [startSample, endSample). Any thread. */
+    void invalidateSamples(int64_t startSample, int64_t endSample);
+
+    /** Lower edge of band bin, in Hz. */
+    float getBinFrequency(int bin) const;
+
+    /**
+     * Writes the complete overview: a header recording the audio's shape
+     * and the analysis settings, then each channel's columns.
+     * @return false if the overview is incomplete or the write failed
+     */
+    bool writeOverviewTo(juce::OutputStream& out) const;
+
+    /**
+     * Replaces the overview with one written by writeOverviewTo(). Fails,
+     * changing nothing, unless it was written for audio of the current
+     * shape with the current analysis settings.
+     */
+    bool readOverviewFrom(juce::InputStream& in);
+
+private:
+    struct TileKey
+    {
+        int level = 0;
+        int channel = 0;
+        int64_t index = 0;
+
+        bool operator< (const TileKey& other) const;
+        bool operator== (const TileKey& other) const;
+    };
+
+    struct PendingTile
+    {
+        TileKey key;
+        uint64_t epoch = 0;   // m_epoch when taken; a later reset() makes the result stale
+        bool stale = false;   // Invalidated while computing: discard the result
+    };
+
+    /** Per-level analysis tables for the current sample rate. Immutable once built. */
+    struct Analysis
+    {
+        std::vector<float> windows[kNumLevels];                  // Hann, fft size long
+        std::vector<std::pair<int, int>> bandRanges[kNumLevels]; // [first, end) FFT bin per band
+        float gain[kNumLevels] {};                               // Normalises a full-scale sine to 1
+    };
+
+    static std::shared_ptr<const Analysis> buildAnalysis(double sampleRate);
+
+    /** Sample range read by key's analysis windows (may extend past the audio). */
+    static void getTileSampleRange(const TileKey& key, int64_t& start, int64_t& end);
+
+    /**
+     * Queues key unless it is queued or computing; onScreen requests jump
+     * ahead of background ones. Caller holds m_lock.
+     */
+    void requestLocked(const TileKey& key, bool onScreen);
+
+    /** Pool job body: takes the newest request and computes it. */
+    void runOneRequest();
+
+    /** Computes key's tile from the source. Pool thread, no lock held. */
+    TilePtr computeTile(const TileKey& key, const Analysis& analysis,
+                        int64_t numSamples, int64_t numColumns) const;
+
+    /**
+     * Stores a computed tile unless it went stale, then trims detail tiles
+     * to budget. Returns false if the tile was discarded.
+     */
+    bool storeTile(const PendingTile& request, TilePtr tile);
+
+    /** Drops least recently used detail tiles until the cache fits kBudgetBytes. Caller holds m_lock. */
+    void trimToBudgetLocked();
+
+    /** Pool job that runs one request for its cache; see requestLocked(). */
+    class RequestJob;
+
+    /** The pool every cache's jobs run on. */
+    static juce::ThreadPool& getPool();
+
+    /** Bytes of one stored tile, whatever its level. */
+    static constexpr int64_t kTileBytes = static_cast<int64_t>(kColumnsPerTile) * kNumBins;
+
+    const SampleSource m_source;
+    const std::function<void()> m_tileReady;
+
+    mutable juce::CriticalSection m_lock;    // Guards everything below
+    int m_numChannels = 0;
+    int64_t m_numSamples = 0;
+    double m_sampleRate = 0.0;
+    uint64_t m_epoch = 0;                    // Bumped by reset()
+    std::shared_ptr<const Analysis> m_analysis;
+
+    std::vector<std::vector<TilePtr>> m_overview;             // [channel][tile index]
+    int64_t m_overviewBytes = 0;
+    std::list<std::pair<TileKey, TilePtr>> m_detailTiles;     // Most recently used first
+    std::map<TileKey, std::list<std::pair<TileKey, TilePtr>>::iterator> m_detailIndex;
+    int64_t m_detailBytes = 0;
+
+    std::vector<TileKey> m_pendingUrgent;      // Requested by getTile(); back is computed next
+    std::vector<TileKey> m_pendingBackground;  // Overview fill, computed when nothing is urgent
+    std::vector<PendingTile> m_inFlight;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrogramCache)
+};
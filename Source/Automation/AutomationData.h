@@ -30,6 +30,7 @@
 #include <mutex>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 //==============================================================================
 /**
@@ -107,6 +108,126 @@ public:
     AutomationCurve(const AutomationCurve&) = delete;
     AutomationCurve& operator=(const AutomationCurve&) = delete;
 
+    //==========================================================================
+    // Playback cursors (sub-block automation)
+
+    /** Shortest slice a breakpoint split may produce, so no plugin call is tiny. */
+    static constexpr int kMinSliceSamples = 32;
+
+    /** Longest slice while a value is ramping: the ramp resolution (~2.9 ms at 44.1 kHz). */
+    static constexpr int kRampSliceSamples = 128;
+
+    /**
+     * A reader's position in a point list. Successive reads at increasing
+     * times step forward from the previous segment instead of binary
+     * searching, so playback lookups are O(1) amortized. The cursor is only a
+     * hint: after a publish, seek or loop wrap it falls back to a binary
+     * search, so a stale cursor is never wrong.
+     */
+    struct Cursor
+    {
+        const void* list = nullptr;   // Point list 'index' refers to
+        size_t index = 0;             // Number of points at or before the last read time
+    };
+
+    /** The curve around one read time. */
+    struct Segment
+    {
+        float value = 0.0f;
+        double nextPointTime = 0.0;   // Next breakpoint after the read time (infinity past the last)
+        bool ramping = false;         // Value changes before nextPointTime
+    };
+
+    /**
+     * Value and surrounding segment at a time over a NON-EMPTY point list,
+     * resolved through cursor. Pure and allocation-free.
+     */
+    static Segment evaluateSegment(const std::vector<AutomationPoint>& points,
+                                   double timeInSeconds, Cursor& cursor) noexcept
+    {
+        const size_t numPoints = points.size();
+        const auto firstAfter = [&points, timeInSeconds](size_t from)
+        {
+            return static_cast<size_t>(std::upper_bound(points.begin() + static_cast<std::ptrdiff_t>(from), points.end(),
+                timeInSeconds,
+                [](double t, const AutomationPoint& pt) { return t < pt.timeInSeconds; }) - points.begin());
+        };
+
+        size_t index = 0;
+        if (cursor.list == &points && cursor.index <= numPoints
+            && (cursor.index == 0 || points[cursor.index - 1].timeInSeconds <= timeInSeconds))
+        {
+            // Step over the breakpoints passed since the last read; a long
+            // jump forward (seek) searches the rest instead
+            index = cursor.index;
+            for (int steps = 0; index < numPoints && points[index].timeInSeconds <= timeInSeconds; ++steps)
+            {
+                if (steps == 4)
+                {
+                    index = firstAfter(index);
+                    break;
+                }
+                ++index;
+            }
+        }
+        else
+        {
+            index = firstAfter(0);
+        }
+
+        cursor.list = &points;
+        cursor.index = index;
+
+        Segment segment;
+        if (index == 0)
+        {
+            segment.value = points.front().value;
+            segment.nextPointTime = points.front().timeInSeconds;
+        }
+        else if (index == numPoints)
+        {
+            segment.value = points.back().value;
+            segment.nextPointTime = std::numeric_limits<double>::infinity();
+        }
+        else
+        {
+            const auto& a = points[index - 1];
+            const auto& b = points[index];
+            segment.value = interpolate(a, b, timeInSeconds);
+            segment.nextPointTime = b.timeInSeconds;
+            segment.ramping = a.curve != AutomationPoint::CurveType::Step && a.value != b.value;
+        }
+        return segment;
+    }
+
+    /**
+     * How many of the next maxSamples can be rendered with segment's value
+     * before the parameter needs updating: up to the next breakpoint (at
+     * least kMinSliceSamples), and at most kRampSliceSamples while ramping.
+     * A ramp's last full slice is shortened when it would leave less than
+     * kMinSliceSamples before the breakpoint, so the slice after it still
+     * ends exactly there.
+     */
+    static int samplesUntilUpdate(const Segment& segment, double timeInSeconds,
+                                  double sampleRate, int maxSamples) noexcept
+    {
+        int limit = maxSamples;
+        const double untilNext = std::ceil((segment.nextPointTime - timeInSeconds) * sampleRate);
+
+        if (segment.ramping)
+        {
+            limit = juce::jmin(limit, kRampSliceSamples);
+
+            if (untilNext > kRampSliceSamples && untilNext < kRampSliceSamples + kMinSliceSamples)
+                limit = juce::jmin(limit, static_cast<int>(untilNext) - kMinSliceSamples);
+        }
+
+        if (untilNext < static_cast<double>(limit))
+            limit = juce::jmax(kMinSliceSamples, static_cast<int>(untilNext));
+
+        return juce::jlimit(1, juce::jmax(1, maxSamples), limit);
+    }
+
     //==========================================================================
     // Audio thread (real-time read — try-lock, no allocation, no refcount)
 
@@ -143,6 +264,28 @@ public:
         return true;
     }
 
+    /**
+     * Audio-thread read for sub-block automation: like getValueAtRealtime(),
+     * but resolves through the caller's playback cursor and also reports the
+     * segment, so the caller knows how long the value holds.
+     *
+     * @returns false (leaving 'out' untouched) when the curve is empty or the
+     *          message thread is mid-publish.
+     */
+    bool getSegmentRealtime(double timeInSeconds, Cursor& cursor, Segment& out) const noexcept
+    {
+        const juce::SpinLock::ScopedTryLockType lock(m_ptrLock);
+        if (! lock.isLocked())
+            return false;
+
+        const PointList* points = m_points.get();   // raw deref, no refcount
+        if (points == nullptr || points->empty())
+            return false;
+
+        out = evaluateSegment(*points, timeInSeconds, cursor);
+        return true;
+    }
+
     //==========================================================================
     // Message thread reads (UI drawing — blocking lock acceptable off-audio)
 
@@ -353,33 +496,18 @@ private:
     }
 
     /** Interpolated value over a NON-EMPTY point list. Pure, allocation-free;
-        shared by the audio-thread and message-thread readers so the selection +
-        interpolation logic lives in exactly one place. */
+        shared by every reader (through evaluateSegment) so the selection +
+        interpolation logic lives in exactly one place. A point's own time
+        belongs to the segment it starts, so a Step lands exactly on it. */
     static float evaluate(const PointList& points, double timeInSeconds) noexcept
     {
-        if (timeInSeconds <= points.front().timeInSeconds)
-            return points.front().value;
-
-        if (timeInSeconds >= points.back().timeInSeconds)
-            return points.back().value;
-
-        // Binary search for surrounding points
-        auto it = std::lower_bound(points.begin(), points.end(),
-            timeInSeconds,
-            [](const AutomationPoint& pt, double t) { return pt.timeInSeconds < t; });
-
-        if (it == points.begin())
-            return it->value;
-
-        const auto& b = *it;
-        const auto& a = *(it - 1);
-
-        return interpolate(a, b, timeInSeconds);
+        Cursor cursor;   // Fresh cursor: plain binary search
+        return evaluateSegment(points, timeInSeconds, cursor).value;
     }
 
     static float interpolate(const AutomationPoint& a,
                              const AutomationPoint& b,
-                             double time)
+                             double time) noexcept
     {
         double duration = b.timeInSeconds - a.timeInSeconds;
         if (duration <= 0.0)
@@ -429,6 +557,9 @@ struct AutomationLane
     bool enabled = true;
     bool isRecording = false;
 
+    // Playback position in the curve (audio thread only; see AutomationCurve::Cursor)
+    AutomationCurve::Cursor playbackCursor;
+
     AutomationLane() = default;
     AutomationLane(AutomationLane&&) noexcept = default;
     AutomationLane& operator=(AutomationLane&&) noexcept = default;
@@ -440,3 +571,17 @@ struct AutomationLane
         return pluginIndex == plugIdx && parameterIndex == paramIdx;
     }
 };
+
+//==============================================================================
+/**
+ * Frozen copy of one enabled lane for an offline render. Lets a background
+ * render follow the automation without reading the live lanes, which the
+ * message thread may edit meanwhile.
+ */
+struct AutomationLaneSnapshot
+{
+    int pluginIndex = -1;
+    int parameterIndex = -1;
+    std::vector<AutomationPoint> points;   // Non-empty
+    AutomationCurve::Cursor cursor;
+};
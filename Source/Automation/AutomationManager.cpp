@@ -174,14 +174,15 @@ void AutomationManager::shiftPluginIndices(int fromIndex, int delta)
 // Playback (audio thread)
 //==============================================================================
 
-void AutomationManager::applyAutomation(PluginChain& chain, double timeInSeconds)
+int AutomationManager::applyAutomation(PluginChain& chain, double timeInSeconds,
+                                       double sampleRate, int maxSamples)
 {
     // C7: audio thread. Try-lock only — never block the audio thread.
     // If the message thread is mid-mutation of m_lanes, skip automation
     // for this one buffer; it resumes on the next callback. The lock
     // protects against iterator invalidation / UAF on add/remove/clear.
     if (! m_lanesLock.tryEnter())
-        return;
+        return maxSamples;
 
     // RAII exit so every return path inside the loop releases the lock.
     struct ScopedExit
@@ -197,6 +198,11 @@ void AutomationManager::applyAutomation(PluginChain& chain, double timeInSeconds
     // the guard no-ops when there is none.
     AutomationRecorder::ScopedApplyGuard applyGuard(m_recorder.get());
 
+    // Read half a sample in, so a breakpoint that a previous slice ended on
+    // is reliably passed despite rounding in the caller's time arithmetic.
+    const double readTime = sampleRate > 0.0 ? timeInSeconds + 0.5 / sampleRate : timeInSeconds;
+    int sliceLength = maxSamples;
+
     for (auto& lane : m_lanes)
     {
         if (!lane.enabled)
@@ -218,11 +224,39 @@ void AutomationManager::applyAutomation(PluginChain& chain, double timeInSeconds
         // previous value) when the curve is empty or the message thread is
         // mid-publish -- folds the old hasPoints() empty-check in, dropping a
         // second blocking lock off the audio path.
-        float value = 0.0f;
-        if (! lane.curve.getValueAtRealtime(timeInSeconds, value))
+        AutomationCurve::Segment segment;
+        if (! lane.curve.getSegmentRealtime(readTime, lane.playbackCursor, segment))
             continue;
-        params[lane.parameterIndex]->setValue(value);
+        params[lane.parameterIndex]->setValue(segment.value);
+
+        if (sampleRate > 0.0)
+            sliceLength = juce::jmin(sliceLength,
+                AutomationCurve::samplesUntilUpdate(segment, readTime, sampleRate, maxSamples));
     }
+
+    return sliceLength;
+}
+
+std::vector<AutomationLaneSnapshot> AutomationManager::createSnapshot() const
+{
+    std::vector<AutomationLaneSnapshot> snapshot;
+
+    const juce::ScopedLock sl(m_lanesLock);
+    for (const auto& lane : m_lanes)
+    {
+        if (!lane.enabled)
+            continue;
+
+        AutomationLaneSnapshot copy;
+        copy.pluginIndex = lane.pluginIndex;
+        copy.parameterIndex = lane.parameterIndex;
+        copy.points = lane.curve.getPoints();
+
+        if (!copy.points.empty())
+            snapshot.push_back(std::move(copy));
+    }
+
+    return snapshot;
 }
 
 //==============================================================================
@@ -36,6 +36,8 @@ class PluginChain;
  * - Lane management (add/remove/edit): message thread only
  * - applyAutomation(): called from audio thread, reads lock-free
  *   from each lane's AutomationCurve
+ * - createSnapshot(): message thread; the copy is then read by an offline
+ *   render (PluginChainRenderer) on its worker thread
  */
 class AutomationManager
 {
@@ -87,12 +89,24 @@ public:
     // Playback (called from audio thread context)
 
     /**
-     * Apply all enabled automation at the given time position.
-     * Called from the audio thread BEFORE plugin processing.
+     * Apply all enabled automation at the given time position and return how
+     * many of the next maxSamples the caller may process through the chain
+     * before calling again: up to the next breakpoint, or a short slice while
+     * a parameter ramps (see AutomationCurve::samplesUntilUpdate). The caller
+     * splits its block accordingly, so automation is sample-accurate at
+     * breakpoints and ramps without block-sized steps.
+     * Called from the audio thread BEFORE each plugin-chain slice.
      *
-     * Lock-free: reads from each AutomationCurve's atomic point list.
+     * Lock-free: reads from each AutomationCurve's atomic point list through
+     * the lane's playback cursor (O(1) amortized during playback).
      */
-    void applyAutomation(PluginChain& chain, double timeInSeconds);
+    int applyAutomation(PluginChain& chain, double timeInSeconds, double sampleRate, int maxSamples);
+
+    /**
+     * Copies every enabled lane that has points, for an offline render of the
+     * chain. Message thread.
+     */
+    std::vector<AutomationLaneSnapshot> createSnapshot() const;
 
     //==========================================================================
     // Global state
@@ -9,6 +9,7 @@
 */
 
 #include "BatchJob.h"
+#include "../Audio/AudioBlockSource.h"
 #include "../Audio/AudioProcessor.h"
 #include "../Audio/LameMP3AudioFormat.h"
 #include "../DSP/DynamicParametricEQ.h"
@@ -16,6 +17,7 @@
 #include "../Plugins/PluginChain.h"
 #include "../Plugins/PluginChainRenderer.h"
 #include "../Plugins/PluginPresetManager.h"
+#include <cmath>
 
 namespace waveedit
 {
@@ -456,37 +458,12 @@ bool BatchJob::convertFormat(std::function<bool(float, const juce::String&)>& pr
 {
     const auto& fmt = m_settings.outputFormat;
 
-    // Check if sample rate conversion is needed
+    // The conversion itself runs while saving: saveOutputFile() streams
+    // the audio through the polyphase converter block by block, straight
+    // into the writer, so the resampled file is never held in memory.
+    m_outputSampleRate = m_sampleRate;
     if (fmt.sampleRate > 0 && static_cast<int>(m_sampleRate) != fmt.sampleRate)
-    {
-        if (!progress(0.8f, "Converting sample rate..."))
-            return false;
-
-        // Create resampler
-        juce::LagrangeInterpolator interpolator;
-
-        double ratio = static_cast<double>(fmt.sampleRate) / m_sampleRate;
-        int newNumSamples = static_cast<int>(std::ceil(m_buffer.getNumSamples() * ratio));
-
-        juce::AudioBuffer<float> resampledBuffer(m_numChannels, newNumSamples);
-
-        for (int channel = 0; channel < m_numChannels; ++channel)
-        {
-            interpolator.reset();
-            int outputSamples = interpolator.process(
-                ratio,
-                m_buffer.getReadPointer(channel),
-                resampledBuffer.getWritePointer(channel),
-                newNumSamples);
-
-            // Handle any difference in output length
-            if (outputSamples < newNumSamples)
-                resampledBuffer.clear(channel, outputSamples, newNumSamples - outputSamples);
-        }
-
-        m_buffer = std::move(resampledBuffer);
-        m_sampleRate = fmt.sampleRate;
-    }
+        m_outputSampleRate = fmt.sampleRate;
 
     if (!progress(0.9f, "Format conversion complete"))
         return false;
@@ -581,7 +558,10 @@ bool BatchJob::saveOutputFile(std::function<bool(float, const juce::String&)>& p
         return false;
     }
 
-    std::unique_ptr<juce::OutputStream> outputStream(outputFile.createOutputStream());
+    // Written beside the target and moved over it once complete, so a
+    // cancelled or failed save leaves any existing file untouched.
+    juce::TemporaryFile tempFile(outputFile, juce::TemporaryFile::useHiddenFile);
+    std::unique_ptr<juce::OutputStream> outputStream(tempFile.getFile().createOutputStream());
 
     if (!outputStream)
     {
@@ -594,7 +574,7 @@ bool BatchJob::saveOutputFile(std::function<bool(float, const juce::String&)>& p
     // ownership of the stream when writer creation succeeds
     auto writer = format->createWriterFor(outputStream,
                                           juce::AudioFormatWriterOptions()
-                                              .withSampleRate(m_sampleRate)
+                                              .withSampleRate(m_outputSampleRate)
                                               .withNumChannels(m_numChannels)
                                               .withBitsPerSample(bitsPerSample));
 
@@ -605,14 +585,37 @@ bool BatchJob::saveOutputFile(std::function<bool(float, const juce::String&)>& p
         return false;
     }
 
-    // Write audio data
-    if (!writer->writeFromAudioSampleBuffer(m_buffer, 0, m_buffer.getNumSamples()))
+    // Sample rate conversion (see convertFormat()) happens here, one block
+    // at a time between the buffer and the writer.
+    const bool resampling = std::abs(m_outputSampleRate - m_sampleRate) > 0.01;
+    const auto source = AudioBlockSource::resampled(AudioBlockSource::fromBuffer(m_buffer),
+                                                    m_sampleRate, m_outputSampleRate);
+    const juce::String status = resampling ? "Converting sample rate..." : "Saving " + outputFile.getFileName();
+    const int64_t numBlocks = (source.numSamples + AudioBlockSource::kBlockSamples - 1) / AudioBlockSource::kBlockSamples;
+    int64_t blocksWritten = 0;
+    bool cancelled = false;
+
+    const bool written = source.writeTo(*writer, 0, source.numSamples, [&]()
+    {
+        const float fraction = numBlocks > 0 ? static_cast<float>(blocksWritten++) / static_cast<float>(numBlocks) : 1.0f;
+        cancelled = m_cancelled.load() || !progress(0.9f + 0.1f * fraction, status);
+        return !cancelled;
+    });
+
+    writer.reset();  // flushes and closes the temporary file
+
+    if (cancelled)
+        return false;
+
+    if (!written || !tempFile.overwriteTargetFileWithTemporary())
     {
         m_result.status = BatchJobStatus::FAILED;
         m_result.errorMessage = "Failed to write audio data to: " + outputFile.getFullPathName();
         return false;
     }
 
+    m_sampleRate = m_outputSampleRate;
+
     if (!progress(1.0f, "Saved " + outputFile.getFileName()))
         return false;
 
@@ -132,6 +132,7 @@ private:
     // Audio data
     juce::AudioBuffer<float> m_buffer;
     double m_sampleRate = 44100.0;
+    double m_outputSampleRate = 44100.0;  // Rate saveOutputFile() converts to (see convertFormat())
     int m_numChannels = 2;
 
     // State
@@ -88,6 +88,7 @@ void CommandHandler::getAllCommands(juce::Array<juce::CommandID>& commands)
         CommandIDs::viewZoomToRegion,     // Z or Cmd+Option+Z - Zoom to selected region
         CommandIDs::viewAutoPreviewRegions,  // Toggle auto-play regions on select
         CommandIDs::viewToggleRegions,    // Cmd+Shift+H - Toggle region visibility
+        CommandIDs::viewSpectrogram,      // Waveform/spectrogram display toggle
         CommandIDs::viewSpectrumAnalyzer, // Cmd+Alt+S - Show/hide Spectrum Analyzer
         // Spectrum Analyzer configuration commands
         CommandIDs::viewSpectrumFFTSize512,
@@ -131,6 +132,7 @@ void CommandHandler::getAllCommands(juce::Array<juce::CommandID>& commands)
         CommandIDs::processDCOffset,
         CommandIDs::processReverse,
         CommandIDs::processInvert,
+        CommandIDs::processSwapChannels,
         CommandIDs::processResample,
         CommandIDs::processTimeStretch,
         CommandIDs::processPitchShift,
@@ -206,11 +208,57 @@ void CommandHandler::getAllCommands(juce::Array<juce::CommandID>& commands)
 // MainComponent so it can reach the controller members it dispatches to.
 //==============================================================================
 
+bool CommandHandler::isAvailableWhileLoading(juce::CommandID commandID)
+{
+    switch (commandID)
+    {
+        case CommandIDs::fileNew:
+        case CommandIDs::fileOpen:
+        case CommandIDs::fileClose:
+        case CommandIDs::fileExit:
+        case CommandIDs::filePreferences:
+        case CommandIDs::fileBatchProcessor:
+        case CommandIDs::editSelectAll:
+        case CommandIDs::editMarkSelectionStart:
+        case CommandIDs::editMarkSelectionEnd:
+        case CommandIDs::playbackPlay:
+        case CommandIDs::playbackPause:
+        case CommandIDs::playbackStop:
+        case CommandIDs::playbackLoop:
+        case CommandIDs::playbackLoopRegion:
+            return true;
+
+        default:
+            break;
+    }
+
+    // Whole ranges that only move the view, cursor or selection.
+    switch (commandID & 0xF000)
+    {
+        case 0x4000:  // View
+        case 0x6000:  // Navigation
+        case 0x7000:  // Selection
+        case 0x8000:  // Snap
+        case 0x9000:  // Help
+        case 0xA000:  // Tabs
+        case 0xE000:  // Toolbar
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 bool CommandHandler::performCommand(MainComponent& mc,
                                  const juce::ApplicationCommandTarget::InvocationInfo& info)
 {
     auto* doc = mc.getCurrentDocument();
 
+    // Mirrors getCommandInfo(): keyboard shortcuts can still arrive for
+    // commands that are greyed out while the document is loading.
+    if (doc != nullptr && doc->isLoading() && ! isAvailableWhileLoading(info.commandID))
+        return false;
+
     // CRITICAL FIX: Don't early return - allow document-independent commands
     // Commands like File → Open and File → Exit must work without a document
 
@@ -440,6 +488,11 @@ bool CommandHandler::performCommand(MainComponent& mc,
             mc.toggleRegionVisibility();
             return true;
 
+        case CommandIDs::viewSpectrogram:
+            if (!doc) return false;
+            doc->getWaveformDisplay().setSpectrogramMode(!doc->getWaveformDisplay().isSpectrogramMode());
+            return true;
+
         case CommandIDs::viewSpectrumAnalyzer:
             mc.toggleSpectrumAnalyzer();
             return true;
@@ -779,6 +832,11 @@ bool CommandHandler::performCommand(MainComponent& mc,
             mc.m_dspController.invertSelection(doc);
             return true;
 
+        case CommandIDs::processSwapChannels:
+            if (!doc) return false;
+            mc.m_dspController.swapChannels(doc);
+            return true;
+
         case CommandIDs::processResample:
             if (!doc) return false;
             mc.m_dspController.showResampleDialog(doc, &mc);
@@ -86,4 +86,12 @@ public:
      */
     bool performCommand(MainComponent& mc,
                         const juce::ApplicationCommandTarget::InvocationInfo& info);
+
+private:
+    /**
+     * True for commands that neither modify nor export the document's audio
+     * (playback, view, navigation, tabs, ...). Only these stay enabled while
+     * Document::isLoading().
+     */
+    static bool isAvailableWhileLoading(juce::CommandID commandID);
 };
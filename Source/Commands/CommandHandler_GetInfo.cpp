@@ -395,6 +395,14 @@ void CommandHandler::getCommandInfo(juce::CommandID commandID,
                 result.setActive(doc && doc->getAudioEngine().isFileLoaded());
                 break;
 
+            case CommandIDs::viewSpectrogram:
+                result.setInfo("Spectrogram", "Show the spectrogram instead of the waveform", "View", 0);
+                if (keyPress.isValid())
+                    result.addDefaultKeypress(keyPress.getKeyCode(), keyPress.getModifiers());
+                result.setTicked(doc && doc->getWaveformDisplay().isSpectrogramMode());
+                result.setActive(doc && doc->getAudioEngine().isFileLoaded());
+                break;
+
             case CommandIDs::viewSpectrumAnalyzer:
                 result.setInfo("Spectrum Analyzer", "Show/hide real-time spectrum analyzer", "View", 0);
                 if (keyPress.isValid())
@@ -689,6 +697,14 @@ void CommandHandler::getCommandInfo(juce::CommandID commandID,
                 result.setActive(doc && doc->getAudioEngine().isFileLoaded());
                 break;
 
+            case CommandIDs::processSwapChannels:
+                result.setInfo("Swap Channels", "Swap left and right channels of selection or entire file", "Process", 0);
+                if (keyPress.isValid())
+                    result.addDefaultKeypress(keyPress.getKeyCode(), keyPress.getModifiers());
+                result.setActive(doc && doc->getAudioEngine().isFileLoaded()
+                                 && doc->getBufferManager().getNumChannels() >= 2);
+                break;
+
             case CommandIDs::processResample:
                 result.setInfo("Resample...", "Change sample rate of audio file", "Process", 0);
                 if (keyPress.isValid())
@@ -1037,4 +1053,9 @@ void CommandHandler::getCommandInfo(juce::CommandID commandID,
             default:
                 break;
         }
+
+        // While a file is still decoding in the background the document is
+        // incomplete: keep only commands that leave the audio untouched.
+        if (doc != nullptr && doc->isLoading() && ! isAvailableWhileLoading(commandID))
+            result.setActive(false);
     }
@@ -78,6 +78,7 @@ namespace CommandIDs
         viewSpectrumWindowHamming = 0x4011,  // Set window function to Hamming
         viewSpectrumWindowBlackman = 0x4012,  // Set window function to Blackman
         viewSpectrumWindowRectangular = 0x4013,  // Set window function to Rectangular
+        viewSpectrogram = 0x4014,  // Show the spectrogram instead of the waveform
 
         // Processing Operations (0x5000 - 0x50FF)
         processFadeIn   = 0x5000,
@@ -95,6 +96,7 @@ namespace CommandIDs
         processResample         = 0x500C,  // Resample to different sample rate
         processTimeStretch      = 0x500D,  // Time stretch (SoundTouch)
         processPitchShift       = 0x500E,  // Pitch shift (SoundTouch)
+        processSwapChannels     = 0x500F,  // Swap left/right channels
 
         // Navigation Operations (0x6000 - 0x60FF)
         navigateLeft         = 0x6000,  // Arrow left (uses current snap increment)
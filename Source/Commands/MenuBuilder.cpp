@@ -119,6 +119,7 @@ juce::PopupMenu MenuBuilder::getMenuForIndex(int menuIndex,
         menu.addCommandItem(context.commandManager, CommandIDs::viewZoomToRegion);
         menu.addCommandItem(context.commandManager, CommandIDs::viewAutoPreviewRegions);
         menu.addCommandItem(context.commandManager, CommandIDs::viewToggleRegions);
+        menu.addCommandItem(context.commandManager, CommandIDs::viewSpectrogram);
 
         // --- Spectrum Analyzer ---
         menu.addSectionHeader("Spectrum Analyzer");
@@ -227,6 +228,7 @@ juce::PopupMenu MenuBuilder::getMenuForIndex(int menuIndex,
         menu.addSectionHeader("Transform");
         menu.addCommandItem(context.commandManager, CommandIDs::processReverse);
         menu.addCommandItem(context.commandManager, CommandIDs::processInvert);
+        menu.addCommandItem(context.commandManager, CommandIDs::processSwapChannels);
         menu.addCommandItem(context.commandManager, CommandIDs::processResample);
         menu.addCommandItem(context.commandManager, CommandIDs::processTimeStretch);
         menu.addCommandItem(context.commandManager, CommandIDs::processPitchShift);
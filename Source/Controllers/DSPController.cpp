@@ -43,6 +43,56 @@
 #include "../UI/ProgressDialog.h"
 #include "../UI/ErrorDialog.h"
 #include "../UI/ThemeManager.h"
+#include <limits>
+
+//==============================================================================
+
+namespace
+{
+    /** The document range an edit applies to. */
+    struct TargetRange
+    {
+        int64_t start = 0;
+        int64_t length = 0;
+        bool isSelection = false;
+    };
+
+    /** The selection clamped to the document, or the entire file when nothing is selected. */
+    TargetRange getSelectionOrFile(Document* doc)
+    {
+        const auto& bufferManager = doc->getBufferManager();
+        const auto& waveform = doc->getWaveformDisplay();
+        const int64_t total = bufferManager.getNumSamples();
+
+        if (! waveform.hasSelection())
+            return { 0, total, false };
+
+        const int64_t start = juce::jlimit<int64_t>(0, total, bufferManager.timeToSample(waveform.getSelectionStart()));
+        const int64_t end = juce::jlimit<int64_t>(start, total, bufferManager.timeToSample(waveform.getSelectionEnd()));
+        return { start, end - start, true };
+    }
+
+    /**
+     * Copies [start, start + length) out of the document for an undo entry
+     * that stores the before-state. Only the range is read; the rest of the
+     * document is never flattened. The copy is one AudioBuffer, so a range
+     * of more than INT_MAX samples is refused with a message to the user
+     * and an empty buffer is returned.
+     */
+    juce::AudioBuffer<float> readRangeForUndo(Document* doc, int64_t start, int64_t length,
+                                              const juce::String& title)
+    {
+        if (length > static_cast<int64_t>(std::numeric_limits<int>::max()))
+        {
+            ErrorDialog::show(title,
+                "The range is too long to apply this operation to in one step. "
+                "Select a shorter range and try again.");
+            return {};
+        }
+
+        return doc->getBufferManager().getAudioRange(start, length);
+    }
+}
 
 //==============================================================================
 
@@ -78,43 +128,34 @@ void DSPController::applyGainAdjustment(Document* doc, float gainDB, int64_t sta
         // updates the audio buffer while preserving playback position if currently playing.
         // This allows real-time gain adjustments during playback without interruption.
 
-        // Get current buffer
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        if (buffer.getNumSamples() == 0)
+        const int64_t totalSamples = doc->getBufferManager().getNumSamples();
+        if (totalSamples == 0)
         {
             return;
         }
 
         // Determine region to process
-        int startSampleInt = 0;
-        int numSamples = buffer.getNumSamples();
-        bool isSelection = false;
+        auto range = getSelectionOrFile(doc);
 
         // CRITICAL FIX: Use explicit bounds if provided (from dialog preview)
         // This ensures we apply to the SAME region that was previewed
         if (startSample >= 0 && endSample >= 0)
         {
             // Explicit bounds provided (from dialog) - use these
-            startSampleInt = static_cast<int>(startSample);
-            numSamples = static_cast<int>(endSample - startSample);
-            isSelection = (startSample != 0 || endSample != buffer.getNumSamples());
-        }
-        else if (doc->getWaveformDisplay().hasSelection())
-        {
-            // No explicit bounds - check current selection (for keyboard shortcuts)
-            startSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionStart()));
-            int endSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionEnd()));
-            numSamples = endSampleInt - startSampleInt;
-            isSelection = true;
+            range.start = juce::jmin(startSample, totalSamples);
+            range.length = juce::jlimit<int64_t>(0, totalSamples - range.start, endSample - startSample);
+            range.isSelection = (range.start != 0 || range.length != totalSamples);
         }
 
+        if (range.length <= 0)
+            return;
+
         // Store before state for undo (only the affected region for memory efficiency)
-        juce::AudioBuffer<float> beforeBuffer;
-        beforeBuffer.setSize(buffer.getNumChannels(), numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            beforeBuffer.copyFrom(ch, 0, buffer, ch, startSampleInt, numSamples);
-        }
+        const auto beforeBuffer = readRangeForUndo(doc, range.start, range.length, "Gain");
+        if (beforeBuffer.getNumSamples() == 0)
+            return;
+
+        const bool isSelection = range.isSelection;
 
         // CRITICAL FIX: Start a new transaction so each gain adjustment is a separate undo step
         // Without this, JUCE groups all actions into one transaction and undo undoes everything at once
@@ -131,8 +172,8 @@ void DSPController::applyGainAdjustment(Document* doc, float gainDB, int64_t sta
             doc->getWaveformDisplay(),
             doc->getAudioEngine(),
             beforeBuffer,
-            startSampleInt,
-            numSamples,
+            range.start,
+            beforeBuffer.getNumSamples(),
             gainDB,
             isSelection
         );
@@ -234,26 +275,16 @@ void DSPController::showNormalizeDialog(Document* doc, juce::Component* parent)
     // Set up callbacks
     dialog.onApply([doc, &dialog](float targetDB) {
         // Get selection or entire file
-        int startSampleInt = 0;
-        int numSamples = doc->getBufferManager().getBuffer().getNumSamples();
-        bool isSelection = false;
-
-        if (doc->getWaveformDisplay().hasSelection())
-        {
-            startSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionStart()));
-            int endSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionEnd()));
-            numSamples = endSampleInt - startSampleInt;
-            isSelection = true;
-        }
+        const auto range = getSelectionOrFile(doc);
+        const int64_t startSampleInt = range.start;
+        const bool isSelection = range.isSelection;
 
         // Store before state for undo (MUST happen before any processing)
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        auto beforeBuffer = std::make_shared<juce::AudioBuffer<float>>();
-        beforeBuffer->setSize(buffer.getNumChannels(), numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            beforeBuffer->copyFrom(ch, 0, buffer, ch, startSampleInt, numSamples);
-        }
+        auto beforeBuffer = std::make_shared<juce::AudioBuffer<float>>(
+            readRangeForUndo(doc, range.start, range.length, "Normalize"));
+        const int numSamples = beforeBuffer->getNumSamples();
+        if (numSamples == 0)
+            return;
 
         // Get mode and calculate required gain
         NormalizeDialog::NormalizeMode mode = dialog.getMode();
@@ -279,12 +310,7 @@ void DSPController::showNormalizeDialog(Document* doc, juce::Component* parent)
         {
             // ASYNCHRONOUS PATH: Large operation - show progress dialog
             // Create a working copy of the selection region for processing
-            auto regionBuffer = std::make_shared<juce::AudioBuffer<float>>();
-            regionBuffer->setSize(buffer.getNumChannels(), numSamples);
-            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            {
-                regionBuffer->copyFrom(ch, 0, buffer, ch, startSampleInt, numSamples);
-            }
+            auto regionBuffer = std::make_shared<juce::AudioBuffer<float>>(*beforeBuffer);
 
             ProgressDialog::runWithProgress(
                 transactionName,
@@ -297,11 +323,7 @@ void DSPController::showNormalizeDialog(Document* doc, juce::Component* parent)
                     if (success)
                     {
                         // Copy processed region back to main buffer at correct position
-                        auto& buf = doc->getBufferManager().getMutableBuffer();
-                        for (int ch = 0; ch < regionBuffer->getNumChannels(); ++ch)
-                        {
-                            buf.copyFrom(ch, startSampleInt, *regionBuffer, ch, 0, numSamples);
-                        }
+                        doc->getBufferManager().replaceChannelsInRange(startSampleInt, *regionBuffer, -1);
 
                         // Register undo action (operation already applied)
                         doc->getUndoManager().beginNewTransaction(transactionName);
@@ -321,24 +343,18 @@ void DSPController::showNormalizeDialog(Document* doc, juce::Component* parent)
                         doc->setModified(true);
 
                         // Update waveform display
-                        doc->getAudioEngine().reloadBufferPreservingPlayback(
-                            buf, doc->getBufferManager().getSampleRate(), buf.getNumChannels());
-                        doc->getWaveformDisplay().reloadFromBuffer(
-                            buf, doc->getAudioEngine().getSampleRate(), true, true);
+                        const auto snapshot = doc->getBufferManager().getSnapshot();
+                        doc->getAudioEngine().reloadSnapshotPreservingPlayback(snapshot);
+                        doc->getWaveformDisplay().reloadFromSnapshot(snapshot, true, true);
                     }
                     else
                     {
                         // Cancelled: Restore buffer from snapshot
-                        auto& buf = doc->getBufferManager().getMutableBuffer();
-                        for (int ch = 0; ch < beforeBuffer->getNumChannels(); ++ch)
-                        {
-                            buf.copyFrom(ch, startSampleInt, *beforeBuffer, ch, 0, numSamples);
-                        }
+                        doc->getBufferManager().replaceChannelsInRange(startSampleInt, *beforeBuffer, -1);
                         // Update display to show restored state
-                        doc->getAudioEngine().reloadBufferPreservingPlayback(
-                            buf, doc->getBufferManager().getSampleRate(), buf.getNumChannels());
-                        doc->getWaveformDisplay().reloadFromBuffer(
-                            buf, doc->getAudioEngine().getSampleRate(), true, true);
+                        const auto snapshot = doc->getBufferManager().getSnapshot();
+                        doc->getAudioEngine().reloadSnapshotPreservingPlayback(snapshot);
+                        doc->getWaveformDisplay().reloadFromSnapshot(snapshot, true, true);
                     }
                 }
             );
@@ -415,18 +431,15 @@ void DSPController::showFadeInDialog(Document* doc, juce::Component* parent)
     // Set up callbacks
     dialog.onApply([doc, &dialog]() {
         // Get selection
-        int startSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionStart()));
-        int endSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionEnd()));
-        int numSamples = endSampleInt - startSampleInt;
+        const auto range = getSelectionOrFile(doc);
+        const int64_t startSampleInt = range.start;
 
         // Store before state for undo (MUST happen before any processing)
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        auto beforeBuffer = std::make_shared<juce::AudioBuffer<float>>();
-        beforeBuffer->setSize(buffer.getNumChannels(), numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            beforeBuffer->copyFrom(ch, 0, buffer, ch, startSampleInt, numSamples);
-        }
+        auto beforeBuffer = std::make_shared<juce::AudioBuffer<float>>(
+            readRangeForUndo(doc, range.start, range.length, "Fade In"));
+        const int numSamples = beforeBuffer->getNumSamples();
+        if (numSamples == 0)
+            return;
 
         // Get selected curve type from dialog
         FadeCurveType curveType = dialog.getSelectedCurveType();
@@ -440,12 +453,7 @@ void DSPController::showFadeInDialog(Document* doc, juce::Component* parent)
         {
             // ASYNCHRONOUS PATH: Large operation - show progress dialog
             // Create a working copy of the selection region for processing
-            auto regionBuffer = std::make_shared<juce::AudioBuffer<float>>();
-            regionBuffer->setSize(buffer.getNumChannels(), numSamples);
-            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            {
-                regionBuffer->copyFrom(ch, 0, buffer, ch, startSampleInt, numSamples);
-            }
+            auto regionBuffer = std::make_shared<juce::AudioBuffer<float>>(*beforeBuffer);
 
             ProgressDialog::runWithProgress(
                 "Fade In",
@@ -457,11 +465,7 @@ void DSPController::showFadeInDialog(Document* doc, juce::Component* parent)
                     if (success)
                     {
                         // Copy processed region back to main buffer at correct position
-                        auto& buf = doc->getBufferManager().getMutableBuffer();
-                        for (int ch = 0; ch < regionBuffer->getNumChannels(); ++ch)
-                        {
-                            buf.copyFrom(ch, startSampleInt, *regionBuffer, ch, 0, numSamples);
-                        }
+                        doc->getBufferManager().replaceChannelsInRange(startSampleInt, *regionBuffer, -1);
 
                         // Register undo action (operation already applied)
                         doc->getUndoManager().beginNewTransaction("Fade In");
@@ -479,23 +483,17 @@ void DSPController::showFadeInDialog(Document* doc, juce::Component* parent)
                         doc->setModified(true);
 
                         // Update waveform display
-                        doc->getAudioEngine().reloadBufferPreservingPlayback(
-                            buf, doc->getBufferManager().getSampleRate(), buf.getNumChannels());
-                        doc->getWaveformDisplay().reloadFromBuffer(
-                            buf, doc->getAudioEngine().getSampleRate(), true, true);
+                        const auto snapshot = doc->getBufferManager().getSnapshot();
+                        doc->getAudioEngine().reloadSnapshotPreservingPlayback(snapshot);
+                        doc->getWaveformDisplay().reloadFromSnapshot(snapshot, true, true);
                     }
                     else
                     {
                         // Cancelled: Restore buffer from snapshot
-                        auto& buf = doc->getBufferManager().getMutableBuffer();
-                        for (int ch = 0; ch < beforeBuffer->getNumChannels(); ++ch)
-                        {
-                            buf.copyFrom(ch, startSampleInt, *beforeBuffer, ch, 0, numSamples);
-                        }
-                        doc->getAudioEngine().reloadBufferPreservingPlayback(
-                            buf, doc->getBufferManager().getSampleRate(), buf.getNumChannels());
-                        doc->getWaveformDisplay().reloadFromBuffer(
-                            buf, doc->getAudioEngine().getSampleRate(), true, true);
+                        doc->getBufferManager().replaceChannelsInRange(startSampleInt, *beforeBuffer, -1);
+                        const auto snapshot = doc->getBufferManager().getSnapshot();
+                        doc->getAudioEngine().reloadSnapshotPreservingPlayback(snapshot);
+                        doc->getWaveformDisplay().reloadFromSnapshot(snapshot, true, true);
                     }
                 }
             );
@@ -571,18 +569,15 @@ void DSPController::showFadeOutDialog(Document* doc, juce::Component* parent)
     // Set up callbacks
     dialog.onApply([doc, &dialog]() {
         // Get selection
-        int startSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionStart()));
-        int endSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionEnd()));
-        int numSamples = endSampleInt - startSampleInt;
+        const auto range = getSelectionOrFile(doc);
+        const int64_t startSampleInt = range.start;
 
         // Store before state for undo (MUST happen before any processing)
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        auto beforeBuffer = std::make_shared<juce::AudioBuffer<float>>();
-        beforeBuffer->setSize(buffer.getNumChannels(), numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            beforeBuffer->copyFrom(ch, 0, buffer, ch, startSampleInt, numSamples);
-        }
+        auto beforeBuffer = std::make_shared<juce::AudioBuffer<float>>(
+            readRangeForUndo(doc, range.start, range.length, "Fade Out"));
+        const int numSamples = beforeBuffer->getNumSamples();
+        if (numSamples == 0)
+            return;
 
         // Get selected curve type from dialog
         FadeCurveType curveType = dialog.getSelectedCurveType();
@@ -596,12 +591,7 @@ void DSPController::showFadeOutDialog(Document* doc, juce::Component* parent)
         {
             // ASYNCHRONOUS PATH: Large operation - show progress dialog
             // Create a working copy of the selection region for processing
-            auto regionBuffer = std::make_shared<juce::AudioBuffer<float>>();
-            regionBuffer->setSize(buffer.getNumChannels(), numSamples);
-            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            {
-                regionBuffer->copyFrom(ch, 0, buffer, ch, startSampleInt, numSamples);
-            }
+            auto regionBuffer = std::make_shared<juce::AudioBuffer<float>>(*beforeBuffer);
 
             ProgressDialog::runWithProgress(
                 "Fade Out",
@@ -613,11 +603,7 @@ void DSPController::showFadeOutDialog(Document* doc, juce::Component* parent)
                     if (success)
                     {
                         // Copy processed region back to main buffer at correct position
-                        auto& buf = doc->getBufferManager().getMutableBuffer();
-                        for (int ch = 0; ch < regionBuffer->getNumChannels(); ++ch)
-                        {
-                            buf.copyFrom(ch, startSampleInt, *regionBuffer, ch, 0, numSamples);
-                        }
+                        doc->getBufferManager().replaceChannelsInRange(startSampleInt, *regionBuffer, -1);
 
                         // Register undo action (operation already applied)
                         doc->getUndoManager().beginNewTransaction("Fade Out");
@@ -635,23 +621,17 @@ void DSPController::showFadeOutDialog(Document* doc, juce::Component* parent)
                         doc->setModified(true);
 
                         // Update waveform display
-                        doc->getAudioEngine().reloadBufferPreservingPlayback(
-                            buf, doc->getBufferManager().getSampleRate(), buf.getNumChannels());
-                        doc->getWaveformDisplay().reloadFromBuffer(
-                            buf, doc->getAudioEngine().getSampleRate(), true, true);
+                        const auto snapshot = doc->getBufferManager().getSnapshot();
+                        doc->getAudioEngine().reloadSnapshotPreservingPlayback(snapshot);
+                        doc->getWaveformDisplay().reloadFromSnapshot(snapshot, true, true);
                     }
                     else
                     {
                         // Cancelled: Restore buffer from snapshot
-                        auto& buf = doc->getBufferManager().getMutableBuffer();
-                        for (int ch = 0; ch < beforeBuffer->getNumChannels(); ++ch)
-                        {
-                            buf.copyFrom(ch, startSampleInt, *beforeBuffer, ch, 0, numSamples);
-                        }
-                        doc->getAudioEngine().reloadBufferPreservingPlayback(
-                            buf, doc->getBufferManager().getSampleRate(), buf.getNumChannels());
-                        doc->getWaveformDisplay().reloadFromBuffer(
-                            buf, doc->getAudioEngine().getSampleRate(), true, true);
+                        doc->getBufferManager().replaceChannelsInRange(startSampleInt, *beforeBuffer, -1);
+                        const auto snapshot = doc->getBufferManager().getSnapshot();
+                        doc->getAudioEngine().reloadSnapshotPreservingPlayback(snapshot);
+                        doc->getWaveformDisplay().reloadFromSnapshot(snapshot, true, true);
                     }
                 }
             );
@@ -705,36 +685,20 @@ void DSPController::applyDCOffset(Document* doc)
 
     try
     {
-        // Determine if we have a selection or should process entire file
-        auto& waveform = doc->getWaveformDisplay();
-        bool hasSelection = waveform.hasSelection();
-
         // Get bounds (selection or entire file)
-        int startSampleInt, endSampleInt, numSamples;
-
-        if (hasSelection)
-        {
-            startSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(waveform.getSelectionStart()));
-            endSampleInt = static_cast<int>(doc->getBufferManager().timeToSample(waveform.getSelectionEnd()));
-        }
-        else
-        {
-            startSampleInt = 0;
-            endSampleInt = static_cast<int>(doc->getBufferManager().getBuffer().getNumSamples());
-        }
-        numSamples = endSampleInt - startSampleInt;
+        const auto range = getSelectionOrFile(doc);
+        const bool hasSelection = range.isSelection;
+        const int64_t startSampleInt = range.start;
 
-        if (numSamples <= 0)
+        if (range.length <= 0)
             return;
 
         // Store before state for undo (MUST happen before any processing)
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        auto beforeBuffer = std::make_shared<juce::AudioBuffer<float>>();
-        beforeBuffer->setSize(buffer.getNumChannels(), numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            beforeBuffer->copyFrom(ch, 0, buffer, ch, startSampleInt, numSamples);
-        }
+        auto beforeBuffer = std::make_shared<juce::AudioBuffer<float>>(
+            readRangeForUndo(doc, range.start, range.length, "Remove DC Offset"));
+        const int numSamples = beforeBuffer->getNumSamples();
+        if (numSamples == 0)
+            return;
 
         juce::String transactionName = hasSelection ? "Remove DC Offset (selection)" : "Remove DC Offset (entire file)";
 
@@ -743,12 +707,7 @@ void DSPController::applyDCOffset(Document* doc)
         {
             // ASYNCHRONOUS PATH: Large operation - show progress dialog
             // Create a working copy of the region for processing
-            auto regionBuffer = std::make_shared<juce::AudioBuffer<float>>();
-            regionBuffer->setSize(buffer.getNumChannels(), numSamples);
-            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            {
-                regionBuffer->copyFrom(ch, 0, buffer, ch, startSampleInt, numSamples);
-            }
+            auto regionBuffer = std::make_shared<juce::AudioBuffer<float>>(*beforeBuffer);
 
             ProgressDialog::runWithProgress(
                 "Remove DC Offset",
@@ -760,11 +719,7 @@ void DSPController::applyDCOffset(Document* doc)
                     if (success)
                     {
                         // Copy processed region back to main buffer at correct position
-                        auto& buf = doc->getBufferManager().getMutableBuffer();
-                        for (int ch = 0; ch < regionBuffer->getNumChannels(); ++ch)
-                        {
-                            buf.copyFrom(ch, startSampleInt, *regionBuffer, ch, 0, numSamples);
-                        }
+                        doc->getBufferManager().replaceChannelsInRange(startSampleInt, *regionBuffer, -1);
 
                         // Register undo action (operation already applied)
                         doc->getUndoManager().beginNewTransaction(transactionName);
@@ -781,24 +736,18 @@ void DSPController::applyDCOffset(Document* doc)
                         doc->setModified(true);
 
                         // Update waveform display
-                        doc->getAudioEngine().reloadBufferPreservingPlayback(
-                            buf, doc->getBufferManager().getSampleRate(), buf.getNumChannels());
-                        doc->getWaveformDisplay().reloadFromBuffer(
-                            buf, doc->getAudioEngine().getSampleRate(), true, true);
+                        const auto snapshot = doc->getBufferManager().getSnapshot();
+                        doc->getAudioEngine().reloadSnapshotPreservingPlayback(snapshot);
+                        doc->getWaveformDisplay().reloadFromSnapshot(snapshot, true, true);
                     }
                     else
                     {
                         // Cancelled: Restore buffer from snapshot
-                        auto& buf = doc->getBufferManager().getMutableBuffer();
-                        for (int ch = 0; ch < beforeBuffer->getNumChannels(); ++ch)
-                        {
-                            buf.copyFrom(ch, startSampleInt, *beforeBuffer, ch, 0, numSamples);
-                        }
+                        doc->getBufferManager().replaceChannelsInRange(startSampleInt, *beforeBuffer, -1);
                         // Update display to show restored state
-                        doc->getAudioEngine().reloadBufferPreservingPlayback(
-                            buf, doc->getBufferManager().getSampleRate(), buf.getNumChannels());
-                        doc->getWaveformDisplay().reloadFromBuffer(
-                            buf, doc->getAudioEngine().getSampleRate(), true, true);
+                        const auto snapshot = doc->getBufferManager().getSnapshot();
+                        doc->getAudioEngine().reloadSnapshotPreservingPlayback(snapshot);
+                        doc->getWaveformDisplay().reloadFromSnapshot(snapshot, true, true);
                     }
                 }
             );
@@ -844,41 +793,23 @@ void DSPController::applyNormalize(Document* doc)
 
     try
     {
-        // Get current buffer
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        int startSample = 0;
-        int numSamples = buffer.getNumSamples();
-        bool isSelection = false;
-
-        if (doc->getWaveformDisplay().hasSelection())
-        {
-            startSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionStart()));
-            int endSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionEnd()));
-            numSamples = endSample - startSample;
-            isSelection = true;
-        }
+        const auto range = getSelectionOrFile(doc);
+        const int64_t startSample = range.start;
+        const bool isSelection = range.isSelection;
 
-        if (numSamples <= 0)
+        if (range.length <= 0)
             return;
 
         // Store before state for undo
-        juce::AudioBuffer<float> beforeBuffer;
-        beforeBuffer.setSize(buffer.getNumChannels(), numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            beforeBuffer.copyFrom(ch, 0, buffer, ch, startSample, numSamples);
-        }
+        const auto beforeBuffer = readRangeForUndo(doc, range.start, range.length, "Normalize");
+        const int numSamples = beforeBuffer.getNumSamples();
+        if (numSamples == 0)
+            return;
 
         // Find peak level
         float peakLevel = 0.0f;
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            const auto* samples = buffer.getReadPointer(ch);
-            for (int i = 0; i < numSamples; ++i)
-            {
-                peakLevel = juce::jmax(peakLevel, std::abs(samples[startSample + i]));
-            }
-        }
+        for (int ch = 0; ch < beforeBuffer.getNumChannels(); ++ch)
+            peakLevel = juce::jmax(peakLevel, beforeBuffer.getMagnitude(ch, 0, numSamples));
 
         // Calculate gain needed to reach 0dB
         float gainDB = 0.0f;
@@ -941,21 +872,17 @@ void DSPController::applyFadeIn(Document* doc)
         }
 
         // Get selection
-        int startSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionStart()));
-        int endSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionEnd()));
-        int numSamples = endSample - startSample;
+        const auto range = getSelectionOrFile(doc);
+        const int64_t startSample = range.start;
 
-        if (numSamples <= 0)
+        if (range.length <= 0)
             return;
 
         // Store before state for undo
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        juce::AudioBuffer<float> beforeBuffer;
-        beforeBuffer.setSize(buffer.getNumChannels(), numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            beforeBuffer.copyFrom(ch, 0, buffer, ch, startSample, numSamples);
-        }
+        const auto beforeBuffer = readRangeForUndo(doc, range.start, range.length, "Fade In");
+        const int numSamples = beforeBuffer.getNumSamples();
+        if (numSamples == 0)
+            return;
 
         // Create undo action
         doc->getUndoManager().beginNewTransaction("Fade In");
@@ -1003,21 +930,17 @@ void DSPController::applyFadeOut(Document* doc)
         }
 
         // Get selection
-        int startSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionStart()));
-        int endSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionEnd()));
-        int numSamples = endSample - startSample;
+        const auto range = getSelectionOrFile(doc);
+        const int64_t startSample = range.start;
 
-        if (numSamples <= 0)
+        if (range.length <= 0)
             return;
 
         // Store before state for undo
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        juce::AudioBuffer<float> beforeBuffer;
-        beforeBuffer.setSize(buffer.getNumChannels(), numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            beforeBuffer.copyFrom(ch, 0, buffer, ch, startSample, numSamples);
-        }
+        const auto beforeBuffer = readRangeForUndo(doc, range.start, range.length, "Fade Out");
+        const int numSamples = beforeBuffer.getNumSamples();
+        if (numSamples == 0)
+            return;
 
         // Create undo action
         doc->getUndoManager().beginNewTransaction("Fade Out");
@@ -1065,21 +988,17 @@ void DSPController::silenceSelection(Document* doc)
         }
 
         // Get selection
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        int startSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionStart()));
-        int endSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionEnd()));
-        int numSamples = endSample - startSample;
+        const auto range = getSelectionOrFile(doc);
+        const int64_t startSample = range.start;
 
-        if (numSamples <= 0)
+        if (range.length <= 0)
             return;
 
         // Store before state for undo
-        juce::AudioBuffer<float> beforeBuffer;
-        beforeBuffer.setSize(buffer.getNumChannels(), numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            beforeBuffer.copyFrom(ch, 0, buffer, ch, startSample, numSamples);
-        }
+        const auto beforeBuffer = readRangeForUndo(doc, range.start, range.length, "Silence");
+        const int numSamples = beforeBuffer.getNumSamples();
+        if (numSamples == 0)
+            return;
 
         // Create undo action
         doc->getUndoManager().beginNewTransaction("Silence");
@@ -1104,116 +1023,85 @@ void DSPController::silenceSelection(Document* doc)
     }
 }
 
-/**
- * Reverse the selection (or entire file if no selection).
- * Reverse is self-inverse so undo simply re-reverses.
- */
-void DSPController::reverseSelection(Document* doc)
+namespace
 {
-    if (!doc || !doc->getAudioEngine().isFileLoaded())
-        return;
-
-    try
+    /**
+     * Shared body of the lossless transform commands: applies transform to
+     * the selection (or the entire file) through an operation-log undo entry,
+     * so the undo history stores no audio for it.
+     */
+    void applyLosslessTransformToSelection(Document* doc, LosslessTransform transform,
+                                           const juce::String& failureMessage)
     {
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        if (buffer.getNumSamples() == 0)
+        if (!doc || !doc->getAudioEngine().isFileLoaded())
             return;
 
-        // Determine region to process
-        int startSample = 0;
-        int numSamples = buffer.getNumSamples();
-        bool isSelection = false;
+        const juce::String name = LosslessTransforms::getName(transform);
 
-        if (doc->getWaveformDisplay().hasSelection())
+        try
         {
-            startSample = static_cast<int>(doc->getBufferManager().timeToSample(
-                doc->getWaveformDisplay().getSelectionStart()));
-            int endSample = static_cast<int>(doc->getBufferManager().timeToSample(
-                doc->getWaveformDisplay().getSelectionEnd()));
-            numSamples = endSample - startSample;
-            isSelection = true;
-        }
-
-        if (numSamples <= 0)
-            return;
-
-        // Create undo action (no before buffer needed -- reverse is self-inverse)
-        juce::String transactionName = isSelection ? "Reverse Selection" : "Reverse";
-        doc->getUndoManager().beginNewTransaction(transactionName);
-        doc->getUndoManager().perform(new ReverseUndoAction(
-            doc->getBufferManager(),
-            doc->getWaveformDisplay(),
-            doc->getAudioEngine(),
-            startSample,
-            numSamples,
-            isSelection
-        ));
+            const auto& bufferManager = doc->getBufferManager();
+            if (bufferManager.getNumSamples() == 0)
+                return;
+
+            if (transform == LosslessTransform::swapChannels && bufferManager.getNumChannels() < 2)
+                return;
+
+            // Determine region to process. The transform runs block by
+            // block, so the range may exceed what one AudioBuffer can hold.
+            const auto range = getSelectionOrFile(doc);
+            if (range.length <= 0)
+                return;
+
+            // No before buffer: the undo entry re-applies the exact inverse.
+            doc->getUndoManager().beginNewTransaction(range.isSelection ? name + " Selection" : name);
+            doc->getUndoManager().perform(new LosslessTransformUndoAction(
+                doc->getBufferManager(),
+                doc->getWaveformDisplay(),
+                doc->getAudioEngine(),
+                transform,
+                range.start,
+                range.length,
+                range.isSelection
+            ));
 
-        doc->setModified(true);
-    }
-    catch (const std::exception& e)
-    {
-        juce::Logger::writeToLog("DSPController::reverseSelection - Error: " + juce::String(e.what()));
-        ErrorDialog::show("Reverse",
-            "Could not reverse the audio. No changes were made -- the original "
-            "audio is intact.\n\nDetails: " + juce::String(e.what()));
+            doc->setModified(true);
+        }
+        catch (const std::exception& e)
+        {
+            juce::Logger::writeToLog("DSPController - " + name + " error: " + juce::String(e.what()));
+            ErrorDialog::show(name,
+                failureMessage + " No changes were made -- the original "
+                "audio is intact.\n\nDetails: " + juce::String(e.what()));
+        }
     }
 }
 
+/**
+ * Reverse the selection (or entire file if no selection).
+ * Reverse is self-inverse so undo simply re-reverses.
+ */
+void DSPController::reverseSelection(Document* doc)
+{
+    applyLosslessTransformToSelection(doc, LosslessTransform::reverse, "Could not reverse the audio.");
+}
+
 /**
  * Invert polarity of the selection (or entire file if no selection).
  * Invert is self-inverse so undo simply re-inverts.
  */
 void DSPController::invertSelection(Document* doc)
 {
-    if (!doc || !doc->getAudioEngine().isFileLoaded())
-        return;
-
-    try
-    {
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        if (buffer.getNumSamples() == 0)
-            return;
-
-        // Determine region to process
-        int startSample = 0;
-        int numSamples = buffer.getNumSamples();
-        bool isSelection = false;
-
-        if (doc->getWaveformDisplay().hasSelection())
-        {
-            startSample = static_cast<int>(doc->getBufferManager().timeToSample(
-                doc->getWaveformDisplay().getSelectionStart()));
-            int endSample = static_cast<int>(doc->getBufferManager().timeToSample(
-                doc->getWaveformDisplay().getSelectionEnd()));
-            numSamples = endSample - startSample;
-            isSelection = true;
-        }
-
-        if (numSamples <= 0)
-            return;
-
-        // Create undo action (no before buffer needed -- invert is self-inverse)
-        juce::String transactionName = isSelection ? "Invert Selection" : "Invert";
-        doc->getUndoManager().beginNewTransaction(transactionName);
-        doc->getUndoManager().perform(new InvertUndoAction(
-            doc->getBufferManager(),
-            doc->getWaveformDisplay(),
-            doc->getAudioEngine(),
-            startSample,
-            numSamples,
-            isSelection
-        ));
+    applyLosslessTransformToSelection(doc, LosslessTransform::invert, "Could not invert the audio.");
+}
 
-        doc->setModified(true);
-    }
-    catch (const std::exception& e)
-    {
-        juce::Logger::writeToLog("DSPController::invertSelection - Error: " + juce::String(e.what()));
-        ErrorDialog::show("Invert",
-            "Could not invert the audio. No changes were made -- the original "
-            "audio is intact.\n\nDetails: " + juce::String(e.what()));
-    }
+/**
+ * Swap the first two channels (left/right) of the selection or entire file.
+ * Swapping is self-inverse so undo simply swaps again.
+ */
+void DSPController::swapChannels(Document* doc)
+{
+    applyLosslessTransformToSelection(doc, LosslessTransform::swapChannels, "Could not swap the channels.");
 }
 
 /**
@@ -1239,32 +1127,28 @@ void DSPController::trimToSelection(Document* doc)
         }
 
         // Get selection
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        int startSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionStart()));
-        int endSample = static_cast<int>(doc->getBufferManager().timeToSample(doc->getWaveformDisplay().getSelectionEnd()));
+        const auto range = getSelectionOrFile(doc);
+        const int64_t startSample = range.start;
+        const int64_t endSample = range.start + range.length;
 
-        if (startSample < 0 || endSample > buffer.getNumSamples() || startSample >= endSample)
+        if (startSample >= endSample)
         {
             DBG("Invalid trim selection");
             return;
         }
 
-        // Store entire buffer before for undo
-        juce::AudioBuffer<float> beforeBuffer;
-        beforeBuffer.makeCopyOf(buffer, true);
-
+        // The undo action keeps only the removed head and tail.
         // Create undo action.
         // TrimUndoAction forwards its last argument to trimToRange() as a sample
         // COUNT (numSamples), not an absolute end index. Pass the count of the
         // selected range, otherwise the trim keeps the wrong number of samples
         // (and silently no-ops for back-half selections). See REVIEW-QA C1.
-        const int numSamplesToKeep = endSample - startSample;
+        const int64_t numSamplesToKeep = endSample - startSample;
         doc->getUndoManager().beginNewTransaction("Trim to Selection");
         auto* undoAction = new TrimUndoAction(
             doc->getBufferManager(),
             doc->getWaveformDisplay(),
             doc->getAudioEngine(),
-            beforeBuffer,
             startSample,
             numSamplesToKeep
         );
@@ -1295,16 +1179,16 @@ void DSPController::applyDCOffsetRemoval(Document* doc)
             return;
         }
 
-        // Get current buffer
-        auto& buffer = doc->getBufferManager().getMutableBuffer();
-        if (buffer.getNumSamples() == 0)
+        const int64_t totalSamples = doc->getBufferManager().getNumSamples();
+        if (totalSamples == 0)
         {
             return;
         }
 
-        // Store entire buffer before processing for undo
-        juce::AudioBuffer<float> beforeBuffer;
-        beforeBuffer.makeCopyOf(buffer, true);
+        // Store entire file before processing for undo
+        const auto beforeBuffer = readRangeForUndo(doc, 0, totalSamples, "Remove DC Offset");
+        if (beforeBuffer.getNumSamples() == 0)
+            return;
 
         // Start a new transaction
         juce::String transactionName = "Remove DC Offset (entire file)";
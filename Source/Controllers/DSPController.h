@@ -56,6 +56,7 @@ public:
 
     void reverseSelection(Document* doc);
     void invertSelection(Document* doc);
+    void swapChannels(Document* doc);
 
     // Dialog-based operations
     void showResampleDialog(Document* doc, juce::Component* parent);
@@ -26,6 +26,7 @@
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <juce_audio_formats/juce_audio_formats.h>
 #include "../Audio/AudioEngine.h"
+#include "../Audio/AudioBlockSource.h"
 #include "../Audio/AudioFileManager.h"
 #include "../Audio/AudioBufferManager.h"
 #include "../Audio/AudioProcessor.h"
@@ -49,6 +50,32 @@
 #include "../Plugins/PluginManager.h"
 #include "../Plugins/PluginChainRenderer.h"
 
+namespace
+{
+    /**
+     * Copies the whole document out for the operations that rewrite all of
+     * it (channel conversion, resample, head & tail, whole-file time-pitch),
+     * whose undo entries hold the whole before-state anyway. Unlike
+     * getBuffer() the copy is not cached beside the pieces, so it is freed
+     * with the operation. A document longer than one AudioBuffer can hold
+     * (INT_MAX samples) is refused with a message to the user, and an empty
+     * buffer is returned.
+     */
+    juce::AudioBuffer<float> readWholeDocument(Document* doc, const juce::String& title)
+    {
+        const auto& bufferManager = doc->getBufferManager();
+
+        if (bufferManager.getNumSamples() > static_cast<int64_t>(std::numeric_limits<int>::max()))
+        {
+            ErrorDialog::show(title,
+                "The file is too long for this operation. No changes were made.");
+            return {};
+        }
+
+        return bufferManager.getAudioRange(0, bufferManager.getNumSamples());
+    }
+}
+
 //==============================================================================
 // EQ dialogs
 //==============================================================================
@@ -106,7 +133,7 @@ void DSPController::showChannelConverterDialog(Document* doc, juce::Component* /
     if (!doc || !doc->getAudioEngine().isFileLoaded())
         return;
 
-    const int currentChannels = doc->getBufferManager().getBuffer().getNumChannels();
+    const int currentChannels = doc->getBufferManager().getNumChannels();
 
     auto result = ChannelConverterDialog::showDialog(currentChannels);
     if (!result.has_value())
@@ -117,7 +144,10 @@ void DSPController::showChannelConverterDialog(Document* doc, juce::Component* /
 
     try
     {
-        const auto& source = doc->getBufferManager().getBuffer();
+        const auto source = readWholeDocument(doc, "Channel Conversion");
+        if (source.getNumSamples() == 0)
+            return;
+
         auto converted = waveedit::ChannelConverter::convert(
             source,
             result->targetChannels,
@@ -210,6 +240,10 @@ void DSPController::showChannelExtractorDialog(Document* doc, juce::Component* /
 
     try
     {
+        // Channels are streamed block by block from a snapshot, so the
+        // document is never flattened and may exceed INT_MAX samples.
+        const auto source = AudioBlockSource::fromSnapshot(bufferManager.getSnapshot());
+
         if (result->exportMode == ChannelExtractorDialog::ExportMode::IndividualMono)
         {
             int successCount = 0;
@@ -221,9 +255,8 @@ void DSPController::showChannelExtractorDialog(Document* doc, juce::Component* /
                     + channelLabel + extension;
                 const juce::File outFile = result->outputDirectory.getChildFile(filename);
 
-                juce::AudioBuffer<float> monoBuffer(1, static_cast<int>(bufferManager.getNumSamples()));
-                monoBuffer.copyFrom(0, 0, bufferManager.getBuffer(),
-                                    srcChannel, 0, static_cast<int>(bufferManager.getNumSamples()));
+                const auto mono = AudioBlockSource::withChannels(source, { srcChannel });
+                if (mono.isEmpty()) continue;
 
                 std::unique_ptr<juce::OutputStream> outputStream = outFile.createOutputStream();
                 if (!outputStream) continue;
@@ -231,7 +264,7 @@ void DSPController::showChannelExtractorDialog(Document* doc, juce::Component* /
                 auto writer = createWriter(outputStream, 1);
                 if (!writer) continue;
 
-                if (writer->writeFromAudioSampleBuffer(monoBuffer, 0, monoBuffer.getNumSamples()))
+                if (mono.writeTo(*writer))
                     ++successCount;
             }
 
@@ -254,8 +287,12 @@ void DSPController::showChannelExtractorDialog(Document* doc, juce::Component* /
                 + "_extracted" + extension;
             const juce::File outFile = result->outputDirectory.getChildFile(filename);
 
-            auto combinedBuffer = waveedit::ChannelConverter::extractChannels(
-                bufferManager.getBuffer(), result->channels);
+            const auto combined = AudioBlockSource::withChannels(source, result->channels);
+            if (combined.isEmpty())
+            {
+                ErrorDialog::show("Export Error", "No valid channels were selected.");
+                return;
+            }
 
             std::unique_ptr<juce::OutputStream> outputStream = outFile.createOutputStream();
             if (!outputStream)
@@ -264,7 +301,7 @@ void DSPController::showChannelExtractorDialog(Document* doc, juce::Component* /
                 return;
             }
 
-            auto writer = createWriter(outputStream, combinedBuffer.getNumChannels());
+            auto writer = createWriter(outputStream, combined.numChannels);
             if (!writer)
             {
                 ErrorDialog::show("Export Error",
@@ -272,14 +309,13 @@ void DSPController::showChannelExtractorDialog(Document* doc, juce::Component* /
                 return;
             }
 
-            if (writer->writeFromAudioSampleBuffer(combinedBuffer, 0,
-                                                   combinedBuffer.getNumSamples()))
+            if (combined.writeTo(*writer))
             {
                 juce::AlertWindow::showMessageBoxAsync(
                     juce::AlertWindow::InfoIcon,
                     "Export Complete",
                     "Successfully exported "
-                    + juce::String(combinedBuffer.getNumChannels())
+                    + juce::String(combined.numChannels)
                     + " channel(s) to:\n" + outFile.getFullPathName());
             }
             else
@@ -344,12 +380,11 @@ void DSPController::applyPluginChainToSelectionInternal(Document* doc,
     }
 
     auto& bufferManager = doc->getBufferManager();
-    auto& buffer = bufferManager.getMutableBuffer();
-    if (buffer.getNumSamples() == 0)
+    if (bufferManager.getNumSamples() == 0)
         return;
 
     int64_t startSample = 0;
-    int64_t numSamples  = buffer.getNumSamples();
+    int64_t numSamples  = bufferManager.getNumSamples();
     const bool hasSelection = doc->getWaveformDisplay().hasSelection();
 
     if (hasSelection)
@@ -366,7 +401,7 @@ void DSPController::applyPluginChainToSelectionInternal(Document* doc,
     const double sampleRate = bufferManager.getSampleRate();
 
     int outputChannels = 0; // 0 = match source
-    if (convertToStereo && buffer.getNumChannels() == 1)
+    if (convertToStereo && bufferManager.getNumChannels() == 1)
     {
         // Convert to stereo BEFORE processing so display + engine update properly.
         doc->getUndoManager().beginNewTransaction("Convert to Stereo");
@@ -382,9 +417,24 @@ void DSPController::applyPluginChainToSelectionInternal(Document* doc,
     if (includeTail && tailLengthSeconds > 0.0)
         tailSamples = static_cast<int64_t>(tailLengthSeconds * sampleRate);
 
+    // Render from a copy of the selection only (read after any stereo
+    // conversion above), so the rest of the document is never flattened
+    // and the background render never touches the live buffer.
+    auto source = std::make_shared<const juce::AudioBuffer<float>>(
+        bufferManager.getAudioRange(startSample, numSamples));
+    if (source->getNumSamples() != numSamples)
+    {
+        ErrorDialog::show("Apply Plugin Chain",
+                          "The selection is too long to process in one step. "
+                          "Select a shorter range and try again.");
+        return;
+    }
+
+    // Render follows the document's plugin automation, as playback does
     auto renderer = std::make_shared<PluginChainRenderer>();
     auto offlineChain = std::make_shared<PluginChainRenderer::OfflineChain>(
-        PluginChainRenderer::createOfflineChain(chain, sampleRate, renderer->getBlockSize()));
+        PluginChainRenderer::createOfflineChain(chain, sampleRate, renderer->getBlockSize(),
+                                                &doc->getAutomationManager()));
 
     if (!offlineChain->isValid())
     {
@@ -455,15 +505,15 @@ void DSPController::applyPluginChainToSelectionInternal(Document* doc,
 
         ProgressDialog::runWithProgress(
             transactionName,
-            [doc, renderer, offlineChain, processedBuffer, startSample, numSamples,
+            [source, renderer, offlineChain, processedBuffer, numSamples,
              sampleRate, outputChannels, tailSamples]
             (std::function<bool(float, const juce::String&)> progress) -> bool
             {
                 auto result = renderer->renderWithOfflineChain(
-                    doc->getBufferManager().getBuffer(),
+                    *source,
                     *offlineChain,
                     sampleRate,
-                    startSample,
+                    0,
                     numSamples,
                     progress,
                     outputChannels,
@@ -491,8 +541,8 @@ void DSPController::applyPluginChainToSelectionInternal(Document* doc,
     {
         // Synchronous small-selection path
         auto result = renderer->renderWithOfflineChain(
-            buffer, *offlineChain, sampleRate,
-            startSample, numSamples, nullptr,
+            *source, *offlineChain, sampleRate,
+            0, numSamples, nullptr,
             outputChannels, tailSamples);
 
         if (result.success)
@@ -519,7 +569,7 @@ void DSPController::showOfflinePluginDialog(Document* doc, juce::Component* /*pa
     auto& bufferManager = doc->getBufferManager();
 
     int64_t selectionStart = 0;
-    int64_t selectionEnd   = bufferManager.getBuffer().getNumSamples();
+    int64_t selectionEnd   = bufferManager.getNumSamples();
 
     if (doc->getWaveformDisplay().hasSelection())
     {
@@ -556,11 +606,10 @@ void DSPController::applyOfflinePluginToSelection(Document* doc,
         return;
 
     auto& bufferManager = doc->getBufferManager();
-    auto& buffer = bufferManager.getMutableBuffer();
     const double sampleRate = bufferManager.getSampleRate();
 
     int outputChannels = 0;
-    if (convertToStereo && buffer.getNumChannels() == 1)
+    if (convertToStereo && bufferManager.getNumChannels() == 1)
     {
         doc->getUndoManager().beginNewTransaction("Convert to Stereo");
         doc->getUndoManager().perform(new ConvertToStereoAction(
@@ -575,6 +624,17 @@ void DSPController::applyOfflinePluginToSelection(Document* doc,
     if (includeTail && tailLengthSeconds > 0.0)
         tailSamples = static_cast<int64_t>(tailLengthSeconds * sampleRate);
 
+    // As in the plugin-chain path: render from a copy of the selection only.
+    auto source = std::make_shared<const juce::AudioBuffer<float>>(
+        bufferManager.getAudioRange(startSample, numSamples));
+    if (source->getNumSamples() != numSamples)
+    {
+        ErrorDialog::show("Offline Plugin",
+                          "The selection is too long to process in one step. "
+                          "Select a shorter range and try again.");
+        return;
+    }
+
     PluginChain tempChain;
     // Stack-local chain (never audio-thread-visible), but use the configured
     // add anyway so state is applied pre-publish, matching the C4 pattern.
@@ -658,15 +718,15 @@ void DSPController::applyOfflinePluginToSelection(Document* doc,
 
         ProgressDialog::runWithProgress(
             transactionName,
-            [doc, renderer, offlineChain, processedBuffer, startSample, numSamples,
+            [source, renderer, offlineChain, processedBuffer, numSamples,
              sampleRate, outputChannels, tailSamples]
             (std::function<bool(float, const juce::String&)> progress) -> bool
             {
                 auto result = renderer->renderWithOfflineChain(
-                    doc->getBufferManager().getBuffer(),
+                    *source,
                     *offlineChain,
                     sampleRate,
-                    startSample,
+                    0,
                     numSamples,
                     progress,
                     outputChannels,
@@ -693,8 +753,8 @@ void DSPController::applyOfflinePluginToSelection(Document* doc,
     else
     {
         auto result = renderer->renderWithOfflineChain(
-            buffer, *offlineChain, sampleRate,
-            startSample, numSamples, nullptr,
+            *source, *offlineChain, sampleRate,
+            0, numSamples, nullptr,
             outputChannels, tailSamples);
 
         if (result.success)
@@ -748,6 +808,9 @@ void DSPController::showResampleDialog(Document* doc, juce::Component* /*parent*
         dialog.addComboBox("rate", comboItems, "Sample Rate (Hz)");
         dialog.addTextEditor("custom", juce::String(static_cast<int>(currentRate)),
                              "Custom rate (Hz)");
+        dialog.addComboBox("quality", SampleRateConverter::getQualityNames(), "Quality");
+        dialog.getComboBoxComponent("quality")->setSelectedItemIndex(
+            static_cast<int>(SampleRateConverter::Quality::High), juce::dontSendNotification);
         dialog.addButton("OK", 1, juce::KeyPress(juce::KeyPress::returnKey));
         dialog.addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
 
@@ -792,7 +855,12 @@ void DSPController::showResampleDialog(Document* doc, juce::Component* /*parent*
 
             if (newRate > 0 && std::abs(newRate - currentRate) > 0.01)
             {
-                auto& buffer = doc->getBufferManager().getBuffer();
+                const auto buffer = readWholeDocument(doc, "Resample");
+                if (buffer.getNumSamples() == 0)
+                    return;
+
+                const auto quality = static_cast<SampleRateConverter::Quality>(
+                    juce::jmax(0, dialog.getComboBoxComponent("quality")->getSelectedItemIndex()));
 
                 doc->getUndoManager().beginNewTransaction(
                     "Resample to " + juce::String(newRate, 0) + " Hz");
@@ -802,7 +870,8 @@ void DSPController::showResampleDialog(Document* doc, juce::Component* /*parent*
                     doc->getAudioEngine(),
                     buffer,
                     currentRate,
-                    newRate
+                    newRate,
+                    quality
                 ));
 
                 doc->setModified(true);
@@ -866,7 +935,7 @@ namespace
                 bufferManager,
                 doc->getWaveformDisplay(),
                 doc->getAudioEngine(),
-                bufferManager.getBuffer(),   // "before" == current whole-file buffer
+                bufferManager.getAudioRange(0, bufferManager.getNumSamples()),   // "before" == whole file
                 processed,
                 sampleRate,
                 description));
@@ -891,7 +960,6 @@ namespace
             return;
 
         auto& bufferManager = doc->getBufferManager();
-        const auto& srcBuffer = bufferManager.getBuffer();
         const double sampleRate = doc->getAudioEngine().getSampleRate();
         const juce::int64 totalSamples = bufferManager.getNumSamples();
 
@@ -921,14 +989,21 @@ namespace
             selectionScoped = true;
         }
 
-        if (rangeLen <= 0 || srcBuffer.getNumChannels() <= 0)
+        if (rangeLen <= 0 || bufferManager.getNumChannels() <= 0)
             return;
 
+        if (rangeLen > (juce::int64) std::numeric_limits<int>::max())
+        {
+            ErrorDialog::show(description,
+                              "The range is too long to process in one step. "
+                              "Select a shorter range and try again.");
+            return;
+        }
+
         // Extract the source range to process (the whole file when not scoped).
-        auto srcRange = std::make_shared<juce::AudioBuffer<float>>();
-        srcRange->setSize(srcBuffer.getNumChannels(), (int) rangeLen);
-        for (int ch = 0; ch < srcBuffer.getNumChannels(); ++ch)
-            srcRange->copyFrom(ch, 0, srcBuffer, ch, (int) rangeStart, (int) rangeLen);
+        // Only the range is read; the rest of the document is never flattened.
+        auto srcRange = std::make_shared<juce::AudioBuffer<float>>(
+            bufferManager.getAudioRange(rangeStart, rangeLen));
 
         // Below the threshold: process synchronously on the message thread.
         if (rangeLen < kTimePitchProgressThreshold)
@@ -1046,7 +1121,6 @@ namespace
             return;
 
         auto& waveform = doc->getWaveformDisplay();
-        const auto& buffer = doc->getBufferManager().getBuffer();
         const double sr = doc->getAudioEngine().getSampleRate();
 
         // Capture the selection (in seconds) now; re-validated at apply time.
@@ -1054,7 +1128,7 @@ namespace
         const double selStartSeconds = waveform.getSelectionStart();
         const double selEndSeconds   = waveform.getSelectionEnd();
 
-        auto* dialog = new TimePitchDialog(mode, buffer, sr,
+        auto* dialog = new TimePitchDialog(mode, doc->getBufferManager(), sr,
                                            hasSel,
                                            selStartSeconds,
                                            selEndSeconds,
@@ -1109,7 +1183,10 @@ void DSPController::applyHeadTail(Document* doc, const HeadTailRecipe& recipe)
 
     try
     {
-        const auto& inputBuffer = doc->getBufferManager().getBuffer();
+        const auto inputBuffer = readWholeDocument(doc, "Head & Tail");
+        if (inputBuffer.getNumSamples() == 0)
+            return;
+
         double sampleRate = doc->getAudioEngine().getSampleRate();
 
         juce::AudioBuffer<float> outputBuffer;
@@ -1148,9 +1225,13 @@ void DSPController::showHeadTailDialog(Document* doc, juce::Component* /*parent*
     if (!doc || !doc->getAudioEngine().isFileLoaded())
         return;
 
-    const auto& buffer  = doc->getBufferManager().getBuffer();
+    // The dialog keeps its own copy, so this one is freed once it is built.
+    const auto  buffer  = readWholeDocument(doc, "Head & Tail Processing");
     double      sr      = doc->getAudioEngine().getSampleRate();
 
+    if (buffer.getNumSamples() == 0)
+        return;
+
     // Pass the document's WaveformDisplay as a SafePointer lifeline: the dialog
     // is launched async, so if the document (and its AudioEngine) is closed
     // while the dialog is open, the dialog stops touching the dangling engine.
@@ -1195,7 +1276,6 @@ void DSPController::showLoopingToolsDialog(Document* doc, juce::Component* /*par
         return;
     }
 
-    const auto& buffer     = doc->getBufferManager().getBuffer();
     double      sampleRate = doc->getAudioEngine().getSampleRate();
     auto&       waveform   = doc->getWaveformDisplay();
 
@@ -1204,7 +1284,8 @@ void DSPController::showLoopingToolsDialog(Document* doc, juce::Component* /*par
 
     juce::File sourceFile = doc->getAudioEngine().getCurrentFile();
 
-    auto* dialog = new LoopingToolsDialog(buffer, sampleRate, selStart, selEnd, sourceFile);
+    auto* dialog = new LoopingToolsDialog(doc->getBufferManager(), sampleRate,
+                                          selStart, selEnd, sourceFile);
     dialog->onCancel = []() {};
 
     // Wire preview playback callbacks to AudioEngine. The dialog is
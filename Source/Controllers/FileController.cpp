@@ -51,17 +51,16 @@ void FileController::createNewFile()
     juce::AudioBuffer<float> emptyBuffer(settings->numChannels, static_cast<int>(numSamples));
     emptyBuffer.clear();
 
-    auto& buffer = newDoc->getBufferManager().getMutableBuffer();
-    buffer.setSize(settings->numChannels, static_cast<int>(numSamples));
-    buffer.clear();
+    newDoc->getBufferManager().setBuffer(emptyBuffer, settings->sampleRate);
 
-    newDoc->getAudioEngine().loadFromBuffer(emptyBuffer, settings->sampleRate, settings->numChannels);
-    newDoc->getWaveformDisplay().reloadFromBuffer(emptyBuffer, settings->sampleRate, false, false);
+    const auto snapshot = newDoc->getBufferManager().getSnapshot();
+    newDoc->getAudioEngine().loadFromSnapshot(snapshot);
+    newDoc->getWaveformDisplay().reloadFromSnapshot(snapshot, false, false);
 
     newDoc->getRegionDisplay().setSampleRate(settings->sampleRate);
     newDoc->getRegionDisplay().setTotalDuration(settings->durationSeconds);
     newDoc->getRegionDisplay().setVisibleRange(0.0, settings->durationSeconds);
-    newDoc->getRegionDisplay().setAudioBuffer(&buffer);
+    newDoc->getRegionDisplay().setBufferManager(&newDoc->getBufferManager());
 
     newDoc->getMarkerDisplay().setSampleRate(settings->sampleRate);
     newDoc->getMarkerDisplay().setTotalDuration(settings->durationSeconds);
@@ -309,7 +308,7 @@ bool FileController::saveDocumentAs(Document* doc)
 
     // Show Save As dialog to get format and encoding settings
     double sourceSampleRate = doc->getAudioEngine().getSampleRate();
-    int sourceChannels = doc->getBufferManager().getBuffer().getNumChannels();
+    int sourceChannels = doc->getBufferManager().getNumChannels();
 
     auto result = SaveAsOptionsPanel::showDialog(sourceSampleRate, sourceChannels, currentFile);
 
@@ -553,8 +552,8 @@ void FileController::performAutoSave()
             continue;  // Skip unmodified documents
 
         // Nothing to recover if there's no audio yet.
-        const auto& buffer = doc->getBufferManager().getBuffer();
-        if (buffer.getNumSamples() <= 0)
+        auto snapshot = doc->getBufferManager().getSnapshot();
+        if (snapshot == nullptr || snapshot->getNumSamples() <= 0)
             continue;
 
         // Key the auto-save on the document's source file when it has one.
@@ -594,8 +593,9 @@ void FileController::performAutoSave()
         double sampleRate = doc->getAudioEngine().getSampleRate();
         int bitDepth = doc->getAudioEngine().getBitDepth();
 
-        // Create auto-save job (makes buffer copy for thread safety)
-        auto* job = new AutoSaveJob(buffer, autoSaveFile, originalFile, sampleRate, bitDepth);
+        // Create auto-save job. The snapshot is immutable, so the job can
+        // stream it to disk without copying the samples first.
+        auto* job = new AutoSaveJob(std::move(snapshot), autoSaveFile, originalFile, sampleRate, bitDepth);
 
         // Add job to thread pool (will run on background thread)
         m_autoSaveThreadPool.addJob(job, true);  // deleteJobWhenFinished = true
@@ -681,19 +681,18 @@ void FileController::requestUIRefresh()
 // AutoSaveJob implementation
 //==============================================================================
 
-FileController::AutoSaveJob::AutoSaveJob(const juce::AudioBuffer<float>& buffer,
+FileController::AutoSaveJob::AutoSaveJob(AudioSnapshotPtr audio,
                                          const juce::File& target,
                                          const juce::File& original,
                                          double rate,
                                          int depth)
     : juce::ThreadPoolJob("AutoSave"),
+      snapshot(std::move(audio)),
       targetFile(target),
       originalFile(original),
       sampleRate(rate),
       bitDepth(depth)
 {
-    // Make a copy of the buffer for thread safety
-    bufferCopy.makeCopyOf(buffer);
 }
 
 juce::ThreadPoolJob::JobStatus FileController::AutoSaveJob::runJob()
@@ -720,7 +719,7 @@ juce::ThreadPoolJob::JobStatus FileController::AutoSaveJob::runJob()
             outputStream,
             juce::AudioFormatWriterOptions()
                 .withSampleRate(sampleRate)
-                .withNumChannels(bufferCopy.getNumChannels())
+                .withNumChannels(snapshot->getNumChannels())
                 .withBitsPerSample(safeBitDepth));
 
         if (!writer)
@@ -729,8 +728,11 @@ juce::ThreadPoolJob::JobStatus FileController::AutoSaveJob::runJob()
             return jobHasFinished;
         }
 
-        // Write buffer to file
-        bool success = writer->writeFromAudioSampleBuffer(bufferCopy, 0, bufferCopy.getNumSamples());
+        // Stream the snapshot to file in bounded blocks, giving up early if
+        // the pool is shutting down
+        bool success = AudioBlockSource::fromSnapshot(snapshot)
+                           .writeTo(*writer, 0, snapshot->getNumSamples(),
+                                    [this] { return !shouldExit(); });
         writer.reset();  // Flush and close
 
         if (success)
@@ -855,19 +857,18 @@ static bool recoverUntitledTakeInto(DocumentManager& docManager,
         return false;
 
     const double sampleRate    = info.sampleRate;
-    const int    numChannels   = recovered.getNumChannels();
     const double durationSecs  = recovered.getNumSamples() / sampleRate;
 
-    auto& buffer = newDoc->getBufferManager().getMutableBuffer();
-    buffer = recovered;
+    newDoc->getBufferManager().setBuffer(recovered, sampleRate);
 
-    newDoc->getAudioEngine().loadFromBuffer(recovered, sampleRate, numChannels);
-    newDoc->getWaveformDisplay().reloadFromBuffer(recovered, sampleRate, false, false);
+    const auto snapshot = newDoc->getBufferManager().getSnapshot();
+    newDoc->getAudioEngine().loadFromSnapshot(snapshot);
+    newDoc->getWaveformDisplay().reloadFromSnapshot(snapshot, false, false);
 
     newDoc->getRegionDisplay().setSampleRate(sampleRate);
     newDoc->getRegionDisplay().setTotalDuration(durationSecs);
     newDoc->getRegionDisplay().setVisibleRange(0.0, durationSecs);
-    newDoc->getRegionDisplay().setAudioBuffer(&buffer);
+    newDoc->getRegionDisplay().setBufferManager(&newDoc->getBufferManager());
 
     newDoc->getMarkerDisplay().setSampleRate(sampleRate);
     newDoc->getMarkerDisplay().setTotalDuration(durationSecs);
@@ -1037,10 +1038,8 @@ void FileController::offerCrashRecovery(Document* doc, const juce::File& origina
             // the audio engine so playback uses the recovered audio.
             const double sr = docPtr->getAudioEngine().getSampleRate();
             docPtr->getBufferManager().setBuffer(recovered, sr);
-            docPtr->getAudioEngine().reloadBufferPreservingPlayback(
-                docPtr->getBufferManager().getBuffer(),
-                sr,
-                docPtr->getBufferManager().getBuffer().getNumChannels());
+            docPtr->getAudioEngine().reloadSnapshotPreservingPlayback(
+                docPtr->getBufferManager().getSnapshot());
             docPtr->setModified(true);
 
             // Only now that recovery succeeded, discard the consumed
@@ -208,13 +208,13 @@ private:
     /** Background job for auto-saving to avoid blocking the message thread. */
     struct AutoSaveJob : public juce::ThreadPoolJob
     {
-        juce::AudioBuffer<float> bufferCopy;
+        AudioSnapshotPtr snapshot;
         juce::File targetFile;
         juce::File originalFile;
         double sampleRate;
         int bitDepth;
 
-        AutoSaveJob(const juce::AudioBuffer<float>& buffer,
+        AutoSaveJob(AudioSnapshotPtr audio,
                     const juce::File& target,
                     const juce::File& original,
                     double rate,
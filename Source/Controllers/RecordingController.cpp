@@ -36,7 +36,7 @@ namespace
         {
         }
 
-        void recordingCompleted(const juce::AudioBuffer<float>& audioBuffer,
+        void recordingCompleted(const juce::File& takeFile,
                                 double sampleRate,
                                 int numChannels) override
         {
@@ -53,88 +53,65 @@ namespace
                 && m_documentManager != nullptr
                 && m_documentManager->getDocumentIndex(m_targetDocument) >= 0;
 
-            if (targetStillOpen)
-                appendToDocument(m_targetDocument, audioBuffer, sampleRate, numChannels);
-            else
-                createNewDocument(audioBuffer, sampleRate, numChannels);
+            // A take whose layout doesn't match the target also opens as
+            // its own document rather than being dropped.
+            if (targetStillOpen && appendToDocument(m_targetDocument, takeFile, sampleRate, numChannels))
+                return;
+
+            createNewDocument(takeFile);
         }
 
     private:
-        void appendToDocument(Document* targetDoc,
-                              const juce::AudioBuffer<float>& audioBuffer,
-                              double sampleRate,
+        bool appendToDocument(Document* targetDoc,
+                              const juce::File& takeFile,
+                              double /*sampleRate*/,
                               int /*numChannels*/)
         {
+            auto& bufferManager = targetDoc->getBufferManager();
             const double cursorSeconds = targetDoc->getWaveformDisplay().getPlaybackPosition();
-            auto& currentBuffer = targetDoc->getBufferManager().getMutableBuffer();
-            const double currentSampleRate = targetDoc->getAudioEngine().getSampleRate();
-
-            int insertPositionSamples = static_cast<int>(cursorSeconds * currentSampleRate);
-            insertPositionSamples = juce::jlimit(0, currentBuffer.getNumSamples(), insertPositionSamples);
-
-            const int currentSamples = currentBuffer.getNumSamples();
-            const int newSamples     = audioBuffer.getNumSamples();
-            const int totalSamples   = currentSamples + newSamples;
-
-            juce::AudioBuffer<float> combined(
-                juce::jmax(currentBuffer.getNumChannels(), audioBuffer.getNumChannels()),
-                totalSamples);
-
-            for (int ch = 0; ch < currentBuffer.getNumChannels(); ++ch)
-                combined.copyFrom(ch, 0, currentBuffer, ch, 0, insertPositionSamples);
-
-            for (int ch = 0; ch < audioBuffer.getNumChannels(); ++ch)
-                combined.copyFrom(ch, insertPositionSamples, audioBuffer, ch, 0, newSamples);
-
-            const int remaining = currentSamples - insertPositionSamples;
-            if (remaining > 0)
+            const int64_t oldLength = bufferManager.getNumSamples();
+            const int64_t insertPosition = juce::jlimit<int64_t>(
+                0, oldLength, static_cast<int64_t>(cursorSeconds * bufferManager.getSampleRate()));
+
+            // Decoded block by block and spliced in; the take is not needed
+            // afterwards.
+            if (!bufferManager.insertFromFile(insertPosition, takeFile,
+                                              targetDoc->getAudioEngine().getFormatManager()))
             {
-                for (int ch = 0; ch < currentBuffer.getNumChannels(); ++ch)
-                {
-                    combined.copyFrom(ch, insertPositionSamples + newSamples,
-                                      currentBuffer, ch,
-                                      insertPositionSamples, remaining);
-                }
+                return false;
             }
 
-            currentBuffer.makeCopyOf(combined, true);
-            targetDoc->getAudioEngine().loadFromBuffer(combined, sampleRate,
-                                                       combined.getNumChannels());
-            targetDoc->getWaveformDisplay().reloadFromBuffer(combined, sampleRate, false, false);
-            targetDoc->getRegionDisplay().setTotalDuration(totalSamples / sampleRate);
-            targetDoc->getMarkerDisplay().setTotalDuration(totalSamples / sampleRate);
+            takeFile.deleteFile();
+
+            const AudioEditRange range { insertPosition, 0, bufferManager.getNumSamples() - oldLength };
+            const auto snapshot = bufferManager.getSnapshot();
+            targetDoc->getAudioEngine().applyEditedSnapshot(snapshot, range);
+            targetDoc->getWaveformDisplay().applyEditedSnapshot(snapshot, range);
+
+            const double duration = bufferManager.getLengthInSeconds();
+            targetDoc->getRegionDisplay().setTotalDuration(duration);
+            targetDoc->getMarkerDisplay().setTotalDuration(duration);
             targetDoc->setModified(true);
+            return true;
         }
 
-        void createNewDocument(const juce::AudioBuffer<float>& audioBuffer,
-                               double sampleRate,
-                               int numChannels)
+        void createNewDocument(const juce::File& takeFile)
         {
             auto* newDoc = m_documentManager->createDocument();
-            if (newDoc == nullptr)
+            if (newDoc == nullptr || !newDoc->loadRecordedTake(takeFile))
             {
-                juce::Logger::writeToLog("RecordingController: failed to create new document for recording");
-                return;
+                if (newDoc != nullptr)
+                    m_documentManager->closeDocument(newDoc);
+
+                juce::Logger::writeToLog("RecordingController: could not open recording, kept at "
+                                         + takeFile.getFullPathName());
+                juce::NativeMessageBox::showMessageBoxAsync(
+                    juce::MessageBoxIconType::WarningIcon,
+                    "Recording Saved",
+                    "The recording could not be opened for editing. It has been saved to:\n"
+                        + takeFile.getFullPathName(),
+                    nullptr);
             }
-
-            auto& buffer = newDoc->getBufferManager().getMutableBuffer();
-            buffer.setSize(audioBuffer.getNumChannels(), audioBuffer.getNumSamples());
-            buffer.makeCopyOf(audioBuffer, true);
-
-            newDoc->getAudioEngine().loadFromBuffer(audioBuffer, sampleRate, numChannels);
-            newDoc->getWaveformDisplay().reloadFromBuffer(audioBuffer, sampleRate, false, false);
-
-            const double durationSeconds = audioBuffer.getNumSamples() / sampleRate;
-
-            newDoc->getRegionDisplay().setSampleRate(sampleRate);
-            newDoc->getRegionDisplay().setTotalDuration(durationSeconds);
-            newDoc->getRegionDisplay().setVisibleRange(0.0, durationSeconds);
-            newDoc->getRegionDisplay().setAudioBuffer(&buffer);
-
-            newDoc->getMarkerDisplay().setSampleRate(sampleRate);
-            newDoc->getMarkerDisplay().setTotalDuration(durationSeconds);
-
-            newDoc->setModified(true);
         }
 
         DocumentManager* m_documentManager;
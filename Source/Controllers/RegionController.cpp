@@ -31,9 +31,36 @@
 #include "../UI/SidecarNotifications.h"
 #include "../UI/EditRegionBoundariesDialog.h"
 #include "../UI/ThemeManager.h"
+#include "../UI/ErrorDialog.h"
 #include <algorithm>
+#include <limits>
 #include <set>
 
+namespace
+{
+    /**
+     * AudioUnits::snapToZeroCrossing() over a window of +/- searchRadius
+     * samples read around the position, so the snap never flattens the
+     * whole document.
+     */
+    int64_t snapToZeroCrossingNear(const AudioBufferManager& bufferManager, int64_t position,
+                                   int channel, int searchRadius)
+    {
+        const int64_t total = bufferManager.getNumSamples();
+        const int64_t windowStart = juce::jlimit<int64_t>(0, total, position - searchRadius);
+        const int64_t windowEnd = juce::jlimit<int64_t>(windowStart, total, position + searchRadius + 1);
+        const int windowLength = static_cast<int>(windowEnd - windowStart);
+        if (windowLength <= 0)
+            return juce::jlimit<int64_t>(0, juce::jmax<int64_t>(0, total - 1), position);
+
+        juce::AudioBuffer<float> window(1, windowLength);
+        if (! bufferManager.readChannelRange(channel, window.getWritePointer(0), windowStart, windowLength))
+            return position;
+
+        return windowStart + AudioUnits::snapToZeroCrossing(position - windowStart, window, 0, searchRadius);
+    }
+}
+
 RegionController::RegionController()
 {
 }
@@ -93,14 +120,14 @@ void RegionController::addRegionFromSelection(Document* doc)
     // Apply zero-crossing snap if enabled (Phase 3.3)
     if (Settings::getInstance().getSnapRegionsToZeroCrossings())
     {
-        const auto& buffer = doc->getBufferManager().getBuffer();
-        if (buffer.getNumChannels() > 0 && buffer.getNumSamples() > 0)
+        const auto& bufferManager = doc->getBufferManager();
+        if (bufferManager.getNumChannels() > 0 && bufferManager.getNumSamples() > 0)
         {
             int channel = 0;  // Use first channel for snap detection
             int searchRadius = 1000;  // 1000 samples (~22ms at 44.1kHz)
 
-            startSample = AudioUnits::snapToZeroCrossing(startSample, buffer, channel, searchRadius);
-            endSample = AudioUnits::snapToZeroCrossing(endSample, buffer, channel, searchRadius);
+            startSample = snapToZeroCrossingNear(bufferManager, startSample, channel, searchRadius);
+            endSample = snapToZeroCrossingNear(bufferManager, endSample, channel, searchRadius);
 
             DBG(juce::String::formatted(
                 "Zero-crossing snap applied to selection boundaries"));
@@ -370,8 +397,18 @@ void RegionController::showStripSilenceDialog(Document* doc, juce::Component* pa
     if (!doc)
         return;
 
-    // Get audio buffer, sample rate, and current file from current document
-    const auto& buffer = doc->getBufferManager().getBuffer();
+    // Auto Region analyses the whole file. The dialog keeps its own copy
+    // (not the shared getBuffer() cache) so a later edit cannot pull the
+    // audio out from under it; one AudioBuffer cannot hold more than
+    // INT_MAX samples, so longer files are refused up front.
+    const int64_t totalSamples = doc->getBufferManager().getNumSamples();
+    if (totalSamples > std::numeric_limits<int>::max())
+    {
+        ErrorDialog::show("Auto Region",
+                          "The file is too long to analyse for Auto Region. No regions were changed.");
+        return;
+    }
+    auto buffer = doc->getBufferManager().getAudioRange(0, totalSamples);
     double sampleRate = doc->getBufferManager().getSampleRate();
     juce::File currentFile = doc->getAudioEngine().getCurrentFile();
 
@@ -385,7 +422,7 @@ void RegionController::showStripSilenceDialog(Document* doc, juce::Component* pa
     }
 
     // Create dialog
-    auto* dialog = new StripSilenceDialog(doc->getRegionManager(), buffer, sampleRate);
+    auto* dialog = new StripSilenceDialog(doc->getRegionManager(), std::move(buffer), sampleRate);
 
     // Set up Apply callback with retrospective undo support
     dialog->onApply = [doc, currentFile, oldRegions](int /*numRegionsCreated*/) mutable
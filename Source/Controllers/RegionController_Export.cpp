@@ -201,11 +201,11 @@ void RegionController::showBatchExportDialog(Document* doc, juce::Component* /*p
         }
     }
 
-    // Sec 6.9: copy the audio buffer and region data BEFORE handing them to the
-    // worker thread. The worker owns these copies and never touches the live
+    // Sec 6.9: capture the audio and region data BEFORE handing them to the
+    // worker thread. The audio is an immutable snapshot (no sample copy);
+    // the worker streams each region out of it and never touches the live
     // Document or UI.
-    auto bufferCopy = std::make_shared<juce::AudioBuffer<float>>();
-    bufferCopy->makeCopyOf(doc->getBufferManager().getBuffer());
+    const auto audio = AudioBlockSource::fromSnapshot(doc->getBufferManager().getSnapshot());
     const double sampleRate = doc->getAudioEngine().getSampleRate();
 
     auto regionsCopy = std::make_shared<RegionManager>();
@@ -218,7 +218,7 @@ void RegionController::showBatchExportDialog(Document* doc, juce::Component* /*p
 
     ProgressDialog::runWithProgress(
         "Exporting Regions",
-        [bufferCopy, sampleRate, regionsCopy, sourceFile, settings, result]
+        [audio, sampleRate, regionsCopy, sourceFile, settings, result]
             (ProgressCallback progress) -> bool
         {
             // Adapt RegionExporter's (current,total,name) callback onto the
@@ -230,7 +230,7 @@ void RegionController::showBatchExportDialog(Document* doc, juce::Component* /*p
                 return progress(p, "Exporting: " + name);
             };
 
-            *result = RegionExporter::exportRegionsEx(*bufferCopy, sampleRate,
+            *result = RegionExporter::exportRegionsEx(audio, sampleRate,
                                                       *regionsCopy, sourceFile,
                                                       settings, adapter);
 
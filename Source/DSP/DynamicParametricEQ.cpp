@@ -31,15 +31,9 @@ void DynamicParametricEQ::prepare(double sampleRate, int maxBlockSize)
     m_sampleRate = sampleRate;
     m_maxBlockSize = maxBlockSize;
 
-    // Prepare existing band states
     const juce::ScopedLock sl(m_parameterLock);
     for (auto& band : m_bandStates)
-    {
-        ensureBandChannelCount(band);
-        for (auto& filter : band.filters)
-            filter.reset();
         band.needsUpdate = true;
-    }
 
     // C1 FIX (review follow-up): applyEQ() no longer rebuilds coefficients,
     // so rebuild them HERE for the (possibly new) sample rate. Without this,
@@ -47,35 +41,25 @@ void DynamicParametricEQ::prepare(double sampleRate, int maxBlockSize)
     // the old rate until the next parameter edit.
     updateCoefficientsLocked();
 
+    // A new rate is a new stream: start on the new coefficients, not a ramp
+    resetBandStates();
+
     m_parametersChanged.store(true);
 }
 
-void DynamicParametricEQ::ensureBandChannelCount(BandState& band) const
+void DynamicParametricEQ::reset()
 {
-    // C1 FIX: size every band's filter bank to the app-wide channel ceiling up
-    // front (message thread), so applyEQ() never grows it on the audio thread.
-    // 20 bands x 8 tiny IIR filters is negligible memory; the win is that the
-    // audio thread never allocates. New filters inherit the band's
-    // coefficients so they process identically to the existing channels.
-    const size_t target = static_cast<size_t>(MAX_CHANNELS);
-    if (band.filters.size() == target)
-        return;
-
-    band.filters.resize(target);
-    for (auto& filter : band.filters)
-    {
-        if (band.coefficients != nullptr)
-            filter.coefficients = band.coefficients;
-        filter.reset();
-    }
+    resetBandStates();
 }
 
-void DynamicParametricEQ::reset()
+void DynamicParametricEQ::resetBandStates()
 {
     for (auto& band : m_bandStates)
     {
-        for (auto& filter : band.filters)
-            filter.reset();
+        band.current = band.target;
+        band.rampBlocksRemaining = 0;
+        band.s1.fill(0.0f);
+        band.s2.fill(0.0f);
     }
 }
 
@@ -147,32 +131,50 @@ void DynamicParametricEQ::applyEQ(juce::dsp::AudioBlock<float>& block)
     if (!stl.isLocked())
         return;
 
-    const auto numChannels = static_cast<int>(block.getNumChannels());
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), MAX_CHANNELS);
     const auto numSamples = block.getNumSamples();
 
     // C1 FIX: no coefficient building and no filter-bank growth here anymore.
     // Every mutator (setParameters/addBand/setBandParameters/...) builds
-    // coefficients and sizes filter banks to MAX_CHANNELS on the message
-    // thread, under this same lock. The audio thread only ever processes.
+    // coefficients on the message thread, under this same lock, and band
+    // state is fixed-size. The audio thread only ever processes.
 
-    // Process each enabled band
-    for (size_t bandIdx = 0; bandIdx < m_parameters.bands.size(); ++bandIdx)
+    if (numChannels > 0 && numSamples > 0)
     {
-        if (bandIdx >= m_bandStates.size())
-            break;
+        const juce::ScopedNoDenormals noDenormals;
 
-        auto& band = m_bandStates[bandIdx];
-        if (!band.params.enabled || band.coefficients == nullptr)
-            continue;
+        float* channels[MAX_CHANNELS] = {};
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels[ch] = block.getChannelPointer(static_cast<size_t>(ch));
+
+        // The kernel runs a fixed lane count so the channel loop vectorises;
+        // round the channel count up and leave the spare lanes silent.
+        const int numLanes = numChannels == 1 ? 1
+                           : numChannels == 2 ? 2
+                           : numChannels <= 4 ? 4
+                           : MAX_CHANNELS;
+
+        alignas(32) float tile[kSubBlockSize * MAX_CHANNELS];
 
-        // Process each channel (one filter instance per channel)
-        const int chCount = juce::jmin(numChannels, static_cast<int>(band.filters.size()));
-        for (int ch = 0; ch < chCount; ++ch)
+        for (size_t offset = 0; offset < numSamples; offset += kSubBlockSize)
         {
-            auto* channelData = block.getChannelPointer(static_cast<size_t>(ch));
-            for (size_t i = 0; i < numSamples; ++i)
+            const int tileSamples = static_cast<int>(juce::jmin(static_cast<size_t>(kSubBlockSize),
+                                                                numSamples - offset));
+            switch (numLanes)
             {
-                channelData[i] = band.filters[static_cast<size_t>(ch)].processSample(channelData[i]);
+                case 1:  processTile<1>(channels, numChannels, offset, tileSamples, tile); break;
+                case 2:  processTile<2>(channels, numChannels, offset, tileSamples, tile); break;
+                case 4:  processTile<4>(channels, numChannels, offset, tileSamples, tile); break;
+                default: processTile<MAX_CHANNELS>(channels, numChannels, offset, tileSamples, tile); break;
+            }
+        }
+
+        for (auto& band : m_bandStates)
+        {
+            for (int ch = 0; ch < MAX_CHANNELS; ++ch)
+            {
+                juce::dsp::util::snapToZero(band.s1[static_cast<size_t>(ch)]);
+                juce::dsp::util::snapToZero(band.s2[static_cast<size_t>(ch)]);
             }
         }
     }
@@ -184,6 +186,98 @@ void DynamicParametricEQ::applyEQ(juce::dsp::AudioBlock<float>& block)
     }
 }
 
+template <int NumLanes>
+void DynamicParametricEQ::processTile(float* const* channels, int numChannels, size_t offset,
+                                      int numSamples, float* tile)
+{
+    // Interleave the channels into lanes: tile[sample * NumLanes + channel]
+    for (int ch = 0; ch < NumLanes; ++ch)
+    {
+        if (ch < numChannels)
+        {
+            const float* source = channels[ch] + offset;
+            for (int i = 0; i < numSamples; ++i)
+                tile[i * NumLanes + ch] = source[i];
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                tile[i * NumLanes + ch] = 0.0f;
+        }
+    }
+
+    // Each band runs over the whole tile while it sits in L1. Ramps advance
+    // once per tile, disabled bands included, so re-enabling one picks up
+    // where its coefficients would have been.
+    const size_t numBands = juce::jmin(m_parameters.bands.size(), m_bandStates.size());
+    for (size_t bandIdx = 0; bandIdx < numBands; ++bandIdx)
+    {
+        auto& band = m_bandStates[bandIdx];
+
+        if (band.rampBlocksRemaining > 0)
+        {
+            if (--band.rampBlocksRemaining == 0)
+            {
+                band.current = band.target;
+            }
+            else
+            {
+                band.current.b0 += band.step.b0;
+                band.current.b1 += band.step.b1;
+                band.current.b2 += band.step.b2;
+                band.current.a1 += band.step.a1;
+                band.current.a2 += band.step.a2;
+            }
+        }
+
+        if (!band.params.enabled || band.coefficients == nullptr)
+            continue;
+
+        processSection<NumLanes>(band.current, band.s1.data(), band.s2.data(), tile, numSamples);
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float* dest = channels[ch] + offset;
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = tile[i * NumLanes + ch];
+    }
+}
+
+template <int NumLanes>
+void DynamicParametricEQ::processSection(const Biquad& c, float* s1, float* s2,
+                                         float* tile, int numSamples)
+{
+    // Transposed direct form II. State lives in locals for the tile so the
+    // lane loop stays in registers.
+    float z1[NumLanes];
+    float z2[NumLanes];
+    for (int lane = 0; lane < NumLanes; ++lane)
+    {
+        z1[lane] = s1[lane];
+        z2[lane] = s2[lane];
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float* x = tile + i * NumLanes;
+        for (int lane = 0; lane < NumLanes; ++lane)
+        {
+            const float in = x[lane];
+            const float out = c.b0 * in + z1[lane];
+            z1[lane] = c.b1 * in - c.a1 * out + z2[lane];
+            z2[lane] = c.b2 * in - c.a2 * out;
+            x[lane] = out;
+        }
+    }
+
+    for (int lane = 0; lane < NumLanes; ++lane)
+    {
+        s1[lane] = z1[lane];
+        s2[lane] = z2[lane];
+    }
+}
+
 //==============================================================================
 void DynamicParametricEQ::updateCoefficientsLocked()
 {
@@ -210,18 +304,36 @@ void DynamicParametricEQ::updateCoefficientsLocked()
 
 void DynamicParametricEQ::updateBandCoefficients(BandState& band)
 {
+    // A band's first coefficients start it outright; there is nothing to ramp from
+    const bool isNewBand = band.coefficients == nullptr;
+
     band.coefficients = createCoefficients(band.params);
+    if (band.coefficients == nullptr)
+        return;
 
-    // H4 FIX: make sure the band has one filter per channel before assigning.
-    ensureBandChannelCount(band);
+    // JUCE stores biquads normalised: [b0, b1, b2, a1, a2] (see getFilterResponse)
+    const auto& coeffs = band.coefficients->coefficients;
+    if (coeffs.size() < 5)
+        return;
+
+    band.target = { coeffs[0], coeffs[1], coeffs[2], coeffs[3], coeffs[4] };
 
-    if (band.coefficients != nullptr)
+    if (isNewBand)
     {
-        for (auto& filter : band.filters)
-        {
-            filter.coefficients = band.coefficients;
-        }
+        band.current = band.target;
+        band.rampBlocksRemaining = 0;
+        return;
     }
+
+    // Linear steps between two stable sections stay stable: the (a1, a2)
+    // stability triangle is convex.
+    const float scale = 1.0f / static_cast<float>(kCoefficientRampBlocks);
+    band.step.b0 = (band.target.b0 - band.current.b0) * scale;
+    band.step.b1 = (band.target.b1 - band.current.b1) * scale;
+    band.step.b2 = (band.target.b2 - band.current.b2) * scale;
+    band.step.a1 = (band.target.a1 - band.current.a1) * scale;
+    band.step.a2 = (band.target.a2 - band.current.a2) * scale;
+    band.rampBlocksRemaining = kCoefficientRampBlocks;
 }
 
 DynamicParametricEQ::IIRCoefficients::Ptr DynamicParametricEQ::createCoefficients(
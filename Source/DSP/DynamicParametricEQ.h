@@ -24,6 +24,10 @@
 /**
  * Dynamic Parametric EQ with up to 20 bands and multiple filter types.
  *
+ * Processing runs the whole band cascade over short tiles with one SIMD lane
+ * per channel, so each sample is read and written once per tile rather than
+ * once per band and channel.
+ *
  * Thread Safety:
  * - Parameter updates are thread-safe via atomic flag exchange
  * - applyEQ() is real-time safe (no allocations)
@@ -386,26 +390,43 @@ public:
 private:
     //==============================================================================
     // Internal filter representation
-    using IIRFilter = juce::dsp::IIR::Filter<float>;
     using IIRCoefficients = juce::dsp::IIR::Coefficients<float>;
 
+    /** Maximum channels supported (matches AudioEngine MAX_CHANNELS). */
+    static constexpr int MAX_CHANNELS = 8;
+
+    /** Samples per tile of the cascade kernel; a full 8-channel tile is 2 KB. */
+    static constexpr int kSubBlockSize = 64;
+
+    /** Tiles a coefficient change is spread over (1024 samples). */
+    static constexpr int kCoefficientRampBlocks = 16;
+
+    /** Biquad coefficients normalised by a0, as the cascade kernel reads them. */
+    struct Biquad
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    };
+
     /**
-     * Internal band state with filter instances and cached coefficients.
-     *
-     * H4 FIX: filters is sized to the actual channel count (up to 8 per
-     * CLAUDE.md), not hard-capped at 2. Resized in prepare()/setParameters().
+     * Internal band state: one transposed direct form II section with a state
+     * pair per channel, sized to MAX_CHANNELS up front so applyEQ() never
+     * allocates. Coefficient changes move current towards target over
+     * kCoefficientRampBlocks tiles rather than jumping, so dragging a band
+     * during preview does not click.
      */
     struct BandState
     {
         BandParameters params;
-        std::vector<IIRFilter> filters;  // One filter per channel
-        IIRCoefficients::Ptr coefficients;
+        IIRCoefficients::Ptr coefficients;   // Source of target; also drives the response curve
+        Biquad current;                      // What the kernel runs
+        Biquad target;
+        Biquad step;                         // Added to current once per tile while ramping
+        int rampBlocksRemaining = 0;
+        std::array<float, MAX_CHANNELS> s1 {};
+        std::array<float, MAX_CHANNELS> s2 {};
         bool needsUpdate = true;
     };
 
-    /** Maximum channels supported (matches AudioEngine MAX_CHANNELS). */
-    static constexpr int MAX_CHANNELS = 8;
-
     //==============================================================================
     /** Recalculate coefficients for dirty bands. Caller must hold m_parameterLock. */
     void updateCoefficientsLocked();
@@ -413,13 +434,21 @@ private:
     IIRCoefficients::Ptr createCoefficients(const BandParameters& params) const;
     std::complex<double> getFilterResponse(const BandState& band, double frequency) const;
 
+    /** Ends any coefficient ramp and clears every band's filter state. */
+    void resetBandStates();
+
+    /** Runs every enabled band over one tile of interleaved channel lanes. */
+    template <int NumLanes>
+    void processTile(float* const* channels, int numChannels, size_t offset,
+                     int numSamples, float* tile);
+
+    template <int NumLanes>
+    static void processSection(const Biquad& c, float* s1, float* s2, float* tile, int numSamples);
+
     //==============================================================================
     double m_sampleRate = 0;
     int m_maxBlockSize = 0;
 
-    /** Ensure a band has one filter per channel, sharing the band's coefficients. */
-    void ensureBandChannelCount(BandState& band) const;
-
     // Thread-safe parameter storage
     Parameters m_parameters;
     mutable juce::CriticalSection m_parameterLock;
@@ -23,7 +23,8 @@
 HeadTailReport HeadTailEngine::process(const juce::AudioBuffer<float>& input,
                                         double sampleRate,
                                         const HeadTailRecipe& recipe,
-                                        juce::AudioBuffer<float>& output)
+                                        juce::AudioBuffer<float>& output,
+                                        const ShouldCancel& shouldCancel)
 {
     HeadTailReport report;
     report.originalLength = input.getNumSamples();
@@ -51,7 +52,14 @@ HeadTailReport HeadTailEngine::process(const juce::AudioBuffer<float>& input,
     {
         auto [detStart, detEnd] = findSilenceBoundaries(
             input, sampleRate, recipe.thresholdDB,
-            recipe.detectionMode, recipe.holdTimeMs);
+            recipe.detectionMode, recipe.holdTimeMs, shouldCancel);
+
+        if (isCancelled(shouldCancel))
+        {
+            report.success = false;
+            report.errorMessage = "Cancelled.";
+            return report;
+        }
 
         if (detStart == -1 || detEnd == -1)
         {
@@ -269,6 +277,13 @@ HeadTailReport HeadTailEngine::process(const juce::AudioBuffer<float>& input,
     //--------------------------------------------------------------------------
     // Step 6: Set output and finalize report
     //--------------------------------------------------------------------------
+    if (isCancelled(shouldCancel))
+    {
+        report.success = false;
+        report.errorMessage = "Cancelled.";
+        return report;
+    }
+
     output = std::move(trimmedBuffer);
 
     report.finalLength = output.getNumSamples();
@@ -296,7 +311,8 @@ std::pair<int64_t, int64_t> HeadTailEngine::findSilenceBoundaries(
     double sampleRate,
     float thresholdDB,
     HeadTailRecipe::DetectionMode mode,
-    float holdTimeMs)
+    float holdTimeMs,
+    const ShouldCancel& shouldCancel)
 {
     int numChannels = buffer.getNumChannels();
     int64_t totalSamples = buffer.getNumSamples();
@@ -313,6 +329,18 @@ std::pair<int64_t, int64_t> HeadTailEngine::findSilenceBoundaries(
     int64_t firstNonSilent = -1;
     int64_t lastNonSilent = -1;
 
+    // Polls shouldCancel once per kCancelPollSamples scanned frames
+    int64_t framesSincePoll = 0;
+    auto cancelledAfter = [&](int64_t frames)
+    {
+        framesSincePoll += frames;
+        if (framesSincePoll < kCancelPollSamples)
+            return false;
+
+        framesSincePoll = 0;
+        return isCancelled(shouldCancel);
+    };
+
     if (mode == HeadTailRecipe::DetectionMode::Peak)
     {
         //----------------------------------------------------------------------
@@ -323,6 +351,9 @@ std::pair<int64_t, int64_t> HeadTailEngine::findSilenceBoundaries(
         int64_t consecutiveAbove = 0;
         for (int64_t s = 0; s < totalSamples; ++s)
         {
+            if (cancelledAfter(1))
+                return { -1, -1 };
+
             bool aboveThreshold = false;
             for (int ch = 0; ch < numChannels; ++ch)
             {
@@ -353,6 +384,9 @@ std::pair<int64_t, int64_t> HeadTailEngine::findSilenceBoundaries(
         consecutiveAbove = 0;
         for (int64_t s = totalSamples - 1; s >= 0; --s)
         {
+            if (cancelledAfter(1))
+                return { -1, -1 };
+
             bool aboveThreshold = false;
             for (int ch = 0; ch < numChannels; ++ch)
             {
@@ -396,6 +430,9 @@ std::pair<int64_t, int64_t> HeadTailEngine::findSilenceBoundaries(
             int64_t windowEnd = std::min(s + windowSize, totalSamples);
             int64_t actualWindow = windowEnd - s;
 
+            if (cancelledAfter(actualWindow))
+                return { -1, -1 };
+
             // Compute RMS across all channels for this window
             float sumSquares = 0.0f;
             int64_t sampleCount = 0;
@@ -438,6 +475,9 @@ std::pair<int64_t, int64_t> HeadTailEngine::findSilenceBoundaries(
             int64_t windowStart = std::max(s - windowSize, static_cast<int64_t>(0));
             int64_t actualWindow = s - windowStart;
 
+            if (cancelledAfter(actualWindow))
+                return { -1, -1 };
+
             float sumSquares = 0.0f;
             int64_t sampleCount = 0;
             for (int ch = 0; ch < numChannels; ++ch)
@@ -20,10 +20,14 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "HeadTailRecipe.h"
+#include <functional>
 
 class HeadTailEngine
 {
 public:
+    /** Polled between blocks of work; returning true abandons the run. */
+    using ShouldCancel = std::function<bool()>;
+
     /**
      * Process an audio buffer according to a HeadTailRecipe.
      *
@@ -37,12 +41,15 @@ public:
      * @param sampleRate Sample rate of the audio
      * @param recipe    Processing recipe
      * @param output    Receives the processed audio buffer
+     * @param shouldCancel Optional; when it returns true the run stops,
+     *                  output is left untouched and the report fails
      * @return HeadTailReport with processing details
      */
     static HeadTailReport process(const juce::AudioBuffer<float>& input,
                                    double sampleRate,
                                    const HeadTailRecipe& recipe,
-                                   juce::AudioBuffer<float>& output);
+                                   juce::AudioBuffer<float>& output,
+                                   const ShouldCancel& shouldCancel = nullptr);
 
     /**
      * Detect content boundaries in a buffer using the recipe's detection settings.
@@ -66,15 +73,25 @@ private:
      * @param thresholdDB Silence threshold in dB
      * @param mode        Peak or RMS detection
      * @param holdTimeMs  Minimum sustained signal duration to confirm detection
+     * @param shouldCancel Optional; polled every kCancelPollSamples frames
      * @return Pair of (firstNonSilent, lastNonSilent) sample indices,
-     *         or (-1, -1) if all silent
+     *         or (-1, -1) if all silent or cancelled
      */
     static std::pair<int64_t, int64_t> findSilenceBoundaries(
         const juce::AudioBuffer<float>& buffer,
         double sampleRate,
         float thresholdDB,
         HeadTailRecipe::DetectionMode mode,
-        float holdTimeMs);
+        float holdTimeMs,
+        const ShouldCancel& shouldCancel = nullptr);
+
+    /** Frames scanned between two shouldCancel polls. */
+    static constexpr int64_t kCancelPollSamples = 1 << 16;
+
+    static bool isCancelled(const ShouldCancel& shouldCancel)
+    {
+        return shouldCancel != nullptr && shouldCancel();
+    }
 
     /** Convert milliseconds to sample count. */
     static int64_t msToSamples(float ms, double sampleRate)
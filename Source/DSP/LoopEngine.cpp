@@ -25,7 +25,8 @@ LoopResult LoopEngine::createLoop(
     double sampleRate,
     int64_t startSample,
     int64_t endSample,
-    const LoopRecipe& recipe)
+    const LoopRecipe& recipe,
+    const ShouldCancel& shouldCancel)
 {
     LoopResult result;
 
@@ -119,6 +120,12 @@ LoopResult LoopEngine::createLoop(
     // ------------------------------------------------------------------
     // 5. Extract regions and crossfade
     // ------------------------------------------------------------------
+    if (isCancelled(shouldCancel))
+    {
+        result.errorMessage = "Cancelled";
+        return result;
+    }
+
     int numChannels = sourceBuffer.getNumChannels();
     int64_t loopLength = selLen - xfadeLen;
 
@@ -372,7 +379,8 @@ LoopResult LoopEngine::createShepardLoop(
     double sampleRate,
     int64_t startSample,
     int64_t endSample,
-    const LoopRecipe& recipe)
+    const LoopRecipe& recipe,
+    const ShouldCancel& shouldCancel)
 {
     LoopResult result;
 
@@ -412,6 +420,12 @@ LoopResult LoopEngine::createShepardLoop(
     {
         for (int64_t i = 0; i < loopLength; ++i)
         {
+            if (i % kCancelPollSamples == 0 && isCancelled(shouldCancel))
+            {
+                result.errorMessage = "Cancelled";
+                return result;
+            }
+
             float progress = static_cast<float>(i) / static_cast<float>(loopLength);
 
             // Calculate current pitch ratios for both layers
@@ -20,11 +20,15 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "LoopRecipe.h"
+#include <functional>
 #include <vector>
 
 class LoopEngine
 {
 public:
+    /** Polled between blocks of work; returning true abandons the run. */
+    using ShouldCancel = std::function<bool()>;
+
     /**
      * Create a seamless loop from a region of the source buffer.
      *
@@ -37,6 +41,7 @@ public:
      * @param startSample   Selection start (inclusive)
      * @param endSample     Selection end (exclusive)
      * @param recipe        Crossfade and zero-crossing settings
+     * @param shouldCancel  Optional; when it returns true the result fails
      * @return LoopResult with the processed loop buffer and diagnostics
      */
     static LoopResult createLoop(
@@ -44,7 +49,8 @@ public:
         double sampleRate,
         int64_t startSample,
         int64_t endSample,
-        const LoopRecipe& recipe);
+        const LoopRecipe& recipe,
+        const ShouldCancel& shouldCancel = nullptr);
 
     /**
      * Create multiple loop variations from a single selection by applying
@@ -69,14 +75,17 @@ public:
      * rising (or falling) pitch using two crossfaded pitch-ramped layers.
      *
      * Uses resampling-based pitch shifting (works well for 0.5-2 semitones
-     * on tonal/ambient content).
+     * on tonal/ambient content). shouldCancel, if given, is polled every
+     * kCancelPollSamples output frames; a cancelled run returns a failed
+     * result.
      */
     static LoopResult createShepardLoop(
         const juce::AudioBuffer<float>& sourceBuffer,
         double sampleRate,
         int64_t startSample,
         int64_t endSample,
-        const LoopRecipe& recipe);
+        const LoopRecipe& recipe,
+        const ShouldCancel& shouldCancel = nullptr);
 
     /**
      * Measure the sample discontinuity at the loop point of a buffer.
@@ -97,6 +106,14 @@ public:
         float t, LoopRecipe::CrossfadeCurve curve);
 
 private:
+    /** Frames rendered between two shouldCancel polls. */
+    static constexpr int64_t kCancelPollSamples = 1 << 16;
+
+    static bool isCancelled(const ShouldCancel& shouldCancel)
+    {
+        return shouldCancel != nullptr && shouldCancel();
+    }
+
     /**
      * Search for the nearest zero-crossing (minimum amplitude) around
      * targetSample within +/- searchRadius.
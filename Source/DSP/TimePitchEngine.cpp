@@ -9,12 +9,235 @@
 
 #include "TimePitchEngine.h"
 
+#include "../Audio/ParallelChunkExecutor.h"
+
 #include <SoundTouch.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
 namespace TimePitchEngine
 {
 
+namespace
+{
+    /** Frames moved through SoundTouch per put/receive call. */
+    constexpr int kChunkFrames = 4096;
+
+    /** Source seconds each parallel segment owns. Shorter inputs run as one stream. */
+    constexpr double kSegmentSeconds = 30.0;
+
+    /** Extra audio (in output seconds) fed either side of a segment, so
+        SoundTouch has settled wherever that segment's output is used. */
+    constexpr double kSegmentMarginSeconds = 1.0;
+
+    /** Output seconds neighbouring segments crossfade over. */
+    constexpr double kCrossfadeSeconds = 0.05;
+
+    /** Furthest a segment may move (output seconds) to line up with the one before. */
+    constexpr double kAlignSeconds = 0.01;
+
+    /** Coarse step of the alignment search, refined around the best match. */
+    constexpr int kAlignCoarseStep = 4;
+
+    /**
+     * Runs input[start, start + length) through one SoundTouch instance and
+     * flushes it. Output sample 0 lines up with source sample start.
+     * Empty buffer if onProgress cancels.
+     */
+    juce::AudioBuffer<float> processRange(const juce::AudioBuffer<float>& input,
+                                          int start, int length,
+                                          double sampleRate,
+                                          const Recipe& recipe,
+                                          const std::function<bool(float)>& onProgress)
+    {
+        const int numChannels = input.getNumChannels();
+        const auto frameSize = static_cast<size_t>(numChannels);
+
+        soundtouch::SoundTouch st;
+        st.setSampleRate(static_cast<unsigned int>(sampleRate));
+        st.setChannels(static_cast<unsigned int>(numChannels));
+        st.setTempoChange(recipe.tempoPercent);
+        st.setPitchSemiTones(recipe.pitchSemitones);
+
+        // Interleaved output, reserved for the expected length so long
+        // stretches do not reallocate as they grow.
+        const double tempoRatio = 1.0 + recipe.tempoPercent / 100.0;
+        std::vector<float> collected;
+        collected.reserve((static_cast<size_t>(length / tempoRatio) + kChunkFrames) * frameSize);
+
+        std::vector<float> interleavedIn (static_cast<size_t>(kChunkFrames) * frameSize);
+        std::vector<float> interleavedOut(static_cast<size_t>(kChunkFrames) * frameSize);
+
+        auto drainOutput = [&]()
+        {
+            for (;;)
+            {
+                const auto received = st.receiveSamples(
+                    interleavedOut.data(),
+                    static_cast<unsigned int>(kChunkFrames));
+                if (received == 0)
+                    break;
+
+                collected.insert(collected.end(), interleavedOut.begin(),
+                                 interleavedOut.begin() + static_cast<std::ptrdiff_t>(received * frameSize));
+            }
+        };
+
+        // Push the source through in chunks, draining as we go.
+        int srcPos = 0;
+        while (srcPos < length)
+        {
+            const int chunk = std::min(kChunkFrames, length - srcPos);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float* source = input.getReadPointer(ch, start + srcPos);
+                for (int i = 0; i < chunk; ++i)
+                    interleavedIn[static_cast<size_t>(i) * frameSize + static_cast<size_t>(ch)] = source[i];
+            }
+
+            st.putSamples(interleavedIn.data(), static_cast<unsigned int>(chunk));
+            drainOutput();
+            srcPos += chunk;
+
+            // Report progress from the push phase; bail out (empty result) on cancel.
+            if (onProgress != nullptr
+                && ! onProgress(static_cast<float>(srcPos) / static_cast<float>(length)))
+            {
+                return {};
+            }
+        }
+
+        // Flush internal state and drain whatever's left.
+        st.flush();
+        drainOutput();
+
+        const int outNumSamples = static_cast<int>(collected.size() / frameSize);
+        juce::AudioBuffer<float> result(numChannels, outNumSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* dest = result.getWritePointer(ch);
+            for (int i = 0; i < outNumSamples; ++i)
+                dest[i] = collected[static_cast<size_t>(i) * frameSize + static_cast<size_t>(ch)];
+        }
+
+        return result;
+    }
+
+    /** One segment of a parallel render. */
+    struct Segment
+    {
+        int inputStart = 0;
+        int inputLength = 0;
+        juce::int64 placement = 0;          // Output index of output sample 0, before alignment
+        juce::AudioBuffer<float> output;
+        std::exception_ptr error;           // Thrown while rendering, rethrown by the caller
+    };
+
+    /**
+     * Picks the shift in [-maxShift, maxShift] that best lines segment (placed
+     * at placement + shift) up with what result already holds over
+     * [fadeStart, fadeStart + fadeLength), by normalised cross-correlation of
+     * the channel sums. Two SoundTouch instances choose their own splice
+     * points, so the same passage can come out a few milliseconds apart;
+     * crossfading without this would comb-filter. The search is coarse, then
+     * refined, and keeps the first best match, so the result is deterministic.
+     */
+    int findAlignment(const juce::AudioBuffer<float>& result, int fadeStart, int fadeLength,
+                      const Segment& segment, int maxShift)
+    {
+        const int numChannels = result.getNumChannels();
+        const int segmentLength = segment.output.getNumSamples();
+
+        std::vector<float> reference(static_cast<size_t>(fadeLength), 0.0f);
+        std::vector<float> candidate(static_cast<size_t>(fadeLength + 2 * maxShift), 0.0f);
+
+        // candidate[m] is the segment at output index fadeStart - maxShift + m, unshifted
+        const juce::int64 candidateStart = fadeStart - maxShift - segment.placement;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* placed = result.getReadPointer(ch, fadeStart);
+            for (int i = 0; i < fadeLength; ++i)
+                reference[static_cast<size_t>(i)] += placed[i];
+
+            const float* source = segment.output.getReadPointer(ch);
+            for (size_t m = 0; m < candidate.size(); ++m)
+            {
+                const juce::int64 index = candidateStart + static_cast<juce::int64>(m);
+                if (index >= 0 && index < segmentLength)
+                    candidate[m] += source[index];
+            }
+        }
+
+        double referenceEnergy = 0.0;
+        for (const float sample : reference)
+            referenceEnergy += static_cast<double>(sample) * sample;
+        if (referenceEnergy < 1.0e-12)
+            return 0;   // Silence: nothing to line up with
+
+        // A shift of d reads candidate[i + maxShift - d] against reference[i]
+        const auto score = [&](int shift)
+        {
+            const float* window = candidate.data() + (maxShift - shift);
+            double product = 0.0;
+            double energy = 0.0;
+            for (int i = 0; i < fadeLength; ++i)
+            {
+                product += static_cast<double>(reference[static_cast<size_t>(i)]) * window[i];
+                energy += static_cast<double>(window[i]) * window[i];
+            }
+            return product / std::sqrt(energy + 1.0e-12);
+        };
+
+        int bestShift = 0;
+        double bestScore = score(0);
+
+        for (int shift = -maxShift; shift <= maxShift; shift += kAlignCoarseStep)
+        {
+            const double s = score(shift);
+            if (s > bestScore)
+            {
+                bestScore = s;
+                bestShift = shift;
+            }
+        }
+
+        const int coarseBest = bestShift;
+        const int refineFrom = std::max(-maxShift, coarseBest - kAlignCoarseStep + 1);
+        const int refineTo   = std::min(maxShift, coarseBest + kAlignCoarseStep - 1);
+        for (int shift = refineFrom; shift <= refineTo; ++shift)
+        {
+            const double s = score(shift);
+            if (s > bestScore)
+            {
+                bestScore = s;
+                bestShift = shift;
+            }
+        }
+
+        return bestShift;
+    }
+
+    /** Copies the segment, placed at offset, into result over [from, to). */
+    void copyPlaced(juce::AudioBuffer<float>& result, const Segment& segment,
+                    juce::int64 offset, int from, int to)
+    {
+        const juce::int64 first = std::max<juce::int64>(from, offset);
+        const juce::int64 last  = std::min<juce::int64>(to, offset + segment.output.getNumSamples());
+        if (first >= last)
+            return;
+
+        for (int ch = 0; ch < result.getNumChannels(); ++ch)
+            result.copyFrom(ch, static_cast<int>(first), segment.output, ch,
+                            static_cast<int>(first - offset), static_cast<int>(last - first));
+    }
+}
+
 juce::AudioBuffer<float> apply(const juce::AudioBuffer<float>& input,
                                 double sampleRate,
                                 const Recipe& recipe,
@@ -34,84 +257,393 @@ juce::AudioBuffer<float> apply(const juce::AudioBuffer<float>& input,
         return out;
     }
 
-    soundtouch::SoundTouch st;
-    st.setSampleRate(static_cast<unsigned int>(sampleRate));
+    // The segment count depends only on the input length, never on the
+    // machine, so a given file always renders to the same result.
+    const int segmentLength = std::max(1, juce::roundToInt(kSegmentSeconds * sampleRate));
+    const int numSegments = numSamples / segmentLength;
+    if (numSegments < 2)
+        return processRange(input, 0, numSamples, sampleRate, recipe, onProgress);
+
+    const double tempoRatio = 1.0 + recipe.tempoPercent / 100.0;    // Source samples per output sample
+    const auto toOutput = [tempoRatio](juce::int64 sourceSample)
+    {
+        return static_cast<juce::int64>(std::llround(static_cast<double>(sourceSample) / tempoRatio));
+    };
+
+    // Segment k owns source [k * segmentLength, (k + 1) * segmentLength); the
+    // last one takes the remainder.
+    const auto boundary = [numSegments, numSamples, segmentLength](int k)
+    {
+        return k >= numSegments ? numSamples : k * segmentLength;
+    };
+
+    const int margin = juce::roundToInt(kSegmentMarginSeconds * sampleRate * std::max(1.0, tempoRatio));
+
+    std::vector<Segment> segments(static_cast<size_t>(numSegments));
+    for (int k = 0; k < numSegments; ++k)
+    {
+        auto& segment = segments[static_cast<size_t>(k)];
+        segment.inputStart  = std::max(0, boundary(k) - margin);
+        segment.inputLength = std::min(numSamples, boundary(k + 1) + margin) - segment.inputStart;
+        segment.placement   = toOutput(segment.inputStart);
+    }
+
+    // Each segment gets its own SoundTouch and reports how far it has got;
+    // the calling thread passes the mean on, and a cancel stops the
+    // segments still rendering.
+    std::vector<std::atomic<float>> segmentProgress(static_cast<size_t>(numSegments));
+    for (auto& fraction : segmentProgress)
+        fraction.store(0.0f);
+
+    std::atomic<bool> cancelled { false };
+
+    ProgressCallback progress;
+    if (onProgress != nullptr)
+    {
+        progress = [&](float, const juce::String&)
+        {
+            float total = 0.0f;
+            for (const auto& fraction : segmentProgress)
+                total += fraction.load();
+
+            if (! onProgress(total / static_cast<float>(numSegments)))
+                cancelled.store(true);
+
+            return ! cancelled.load();
+        };
+    }
+
+    const bool completed = ParallelChunkExecutor::runTasks(numSegments, [&](int index)
+    {
+        auto& segment = segments[static_cast<size_t>(index)];
+        auto& fraction = segmentProgress[static_cast<size_t>(index)];
+        try
+        {
+            segment.output = processRange(input, segment.inputStart, segment.inputLength,
+                                          sampleRate, recipe, [&](float p)
+                                          {
+                                              fraction.store(p);
+                                              return ! cancelled.load();
+                                          });
+        }
+        catch (...)
+        {
+            // Pool threads must not throw; rethrown below, on the calling thread
+            segment.error = std::current_exception();
+        }
+    }, progress);
+
+    if (! completed || cancelled.load())
+        return {};
+
+    for (const auto& segment : segments)
+        if (segment.error != nullptr)
+            std::rethrow_exception(segment.error);
+
+    const int crossfade = std::max(1, juce::roundToInt(kCrossfadeSeconds * sampleRate));
+    const int maxShift = juce::roundToInt(kAlignSeconds * sampleRate);
+
+    // The result ends where the last segment ends once it is aligned, which
+    // is only known after stitching; allocate for the furthest it can land
+    // and trim afterwards.
+    const auto& lastSegment = segments.back();
+    const juce::int64 maxOutputLength = lastSegment.placement + maxShift + lastSegment.output.getNumSamples();
+    if (maxOutputLength > std::numeric_limits<int>::max())
+        throw std::length_error("Time stretch result exceeds the maximum buffer length");
+
+    // Stitch in order. Each segment fills its own span plus one crossfade
+    // length past it; the next segment is aligned against that overhang and
+    // fades in over it.
+    juce::AudioBuffer<float> result(numChannels, static_cast<int>(maxOutputLength));
+    result.clear();
+
+    const int resultLength = static_cast<int>(maxOutputLength);
+    int outputLength = resultLength;
+
+    for (int k = 0; k < numSegments; ++k)
+    {
+        const auto& segment = segments[static_cast<size_t>(k)];
+        const bool isLast = k == numSegments - 1;
+
+        const int ownStart = k == 0 ? 0 : static_cast<int>(std::min<juce::int64>(toOutput(boundary(k)), resultLength));
+        const int ownEnd = isLast ? resultLength
+                                  : static_cast<int>(std::min<juce::int64>(toOutput(boundary(k + 1)), resultLength));
+
+        int writeFrom = ownStart;
+        juce::int64 offset = segment.placement;
+
+        if (k > 0)
+        {
+            const int fadeLength = std::min(crossfade, ownEnd - ownStart);
+            if (fadeLength > 0)
+            {
+                offset += findAlignment(result, ownStart, fadeLength, segment, maxShift);
+
+                // Raised-cosine fade: the gains sum to one, as suits aligned material
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    float* dest = result.getWritePointer(ch);
+                    const float* source = segment.output.getReadPointer(ch);
+                    for (int i = 0; i < fadeLength; ++i)
+                    {
+                        const int n = ownStart + i;
+                        const juce::int64 index = n - offset;
+                        const float incoming = (index >= 0 && index < segment.output.getNumSamples())
+                                                 ? source[index] : 0.0f;
+                        const float w = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::pi
+                                                               * (static_cast<float>(i) + 0.5f)
+                                                               / static_cast<float>(fadeLength));
+                        dest[n] = dest[n] * (1.0f - w) + incoming * w;
+                    }
+                }
+
+                writeFrom = ownStart + fadeLength;
+            }
+        }
+
+        if (isLast)
+            outputLength = static_cast<int>(juce::jlimit<juce::int64>(ownStart, resultLength,
+                                                                        offset + segment.output.getNumSamples()));
+
+        const int writeTo = isLast ? outputLength : std::min(resultLength, ownEnd + crossfade);
+        copyPlaced(result, segment, offset, writeFrom, writeTo);
+
+        // Free as we go: the segments together are as large as the result
+        segments[static_cast<size_t>(k)].output.setSize(0, 0);
+    }
+
+    result.setSize(numChannels, outputLength, true, false, true);
+    return result;
+}
+
+//==============================================================================
+// StreamingSource
+
+StreamingSource::StreamingSource(const juce::AudioBuffer<float>& source, double sampleRate)
+    : m_sampleRate(sampleRate)
+{
+    m_source.makeCopyOf(source);
+
+    const int numChannels = std::max(1, m_source.getNumChannels());
+    m_interleaved.resize(static_cast<size_t>(kChunkFrames) * static_cast<size_t>(numChannels));
+    m_processor = createProcessor(Recipe {});
+}
+
+StreamingSource::~StreamingSource()
+{
+    delete m_pendingProcessor.exchange(nullptr);
+    delete m_retiredProcessor.exchange(nullptr);
+}
+
+std::unique_ptr<StreamingSource::Processor> StreamingSource::createProcessor(const Recipe& recipe) const
+{
+    const int numChannels = std::max(1, m_source.getNumChannels());
+
+    auto processor = std::make_unique<Processor>();
+    processor->recipe = recipe;
+    processor->soundTouch = std::make_unique<soundtouch::SoundTouch>();
+
+    auto& st = *processor->soundTouch;
+    st.setSampleRate(static_cast<unsigned int>(m_sampleRate));
     st.setChannels(static_cast<unsigned int>(numChannels));
+
+    if (isIdentity(recipe))
+        return processor;
+
+    // setTempoChange()/setPitchSemiTones() resize SoundTouch's internal
+    // buffers, and so does the first audio through it. Do both here, then
+    // clear(), which keeps the capacity: the audio thread's put/receive
+    // calls then run without allocating.
     st.setTempoChange(recipe.tempoPercent);
     st.setPitchSemiTones(recipe.pitchSemitones);
 
-    // Per-channel output collectors. Conservative initial capacity of
-    // numSamples * 2 covers both speed-up (smaller) and 2x slowdown.
-    std::vector<std::vector<float>> outChannels(static_cast<size_t>(numChannels));
-    for (auto& c : outChannels)
-        c.reserve(static_cast<size_t>(numSamples) * 2);
+    std::vector<float> silence(static_cast<size_t>(kChunkFrames) * static_cast<size_t>(numChannels), 0.0f);
+    for (int i = 0; i < kPrimeChunks; ++i)
+    {
+        st.putSamples(silence.data(), static_cast<unsigned int>(kChunkFrames));
+        while (st.receiveSamples(silence.data(), static_cast<unsigned int>(kChunkFrames)) > 0) {}
+    }
+    st.clear();
+
+    return processor;
+}
 
-    constexpr int kChunkFrames = 4096;
-    std::vector<float> interleavedIn (static_cast<size_t>(kChunkFrames) * static_cast<size_t>(numChannels));
-    std::vector<float> interleavedOut(static_cast<size_t>(kChunkFrames) * static_cast<size_t>(numChannels));
+void StreamingSource::setRecipe(const Recipe& recipe)
+{
+    // Free what the audio thread handed back, then publish the replacement.
+    // A processor published earlier but not yet picked up is superseded.
+    delete m_retiredProcessor.exchange(nullptr);
+    delete m_pendingProcessor.exchange(createProcessor(recipe).release());
+}
 
-    auto drainOutput = [&]()
+void StreamingSource::prepareToPlay(int, double)
+{
+    // The source rate is fixed at construction; the transport resamples to the device.
+}
+
+void StreamingSource::releaseResources()
+{
+}
+
+void StreamingSource::applyPendingChanges()
+{
+    if (m_retiredProcessor.load() == nullptr)
     {
-        for (;;)
+        if (auto* next = m_pendingProcessor.exchange(nullptr))
         {
-            const auto received = st.receiveSamples(
-                interleavedOut.data(),
-                static_cast<unsigned int>(kChunkFrames));
-            if (received == 0)
-                break;
+            m_retiredProcessor.store(m_processor.release());
+            m_processor.reset(next);
 
-            for (unsigned int i = 0; i < received; ++i)
-                for (int ch = 0; ch < numChannels; ++ch)
-                    outChannels[static_cast<size_t>(ch)].push_back(
-                        interleavedOut[i * static_cast<size_t>(numChannels)
-                                          + static_cast<size_t>(ch)]);
+            // The new instance starts empty: resume from what is being
+            // heard, not from how far ahead the old one had read.
+            m_inputPosition = static_cast<juce::int64>(m_playhead.load());
+            m_identity = isIdentity(next->recipe);
+            m_tempoRatio = 1.0 + next->recipe.tempoPercent / 100.0;
         }
-    };
+    }
+
+    const juce::int64 seek = m_pendingSeek.exchange(-1);
+    if (seek >= 0)
+    {
+        m_inputPosition = std::min(seek, static_cast<juce::int64>(m_source.getNumSamples()));
+        m_playhead.store(static_cast<double>(m_inputPosition));
+        m_processor->soundTouch->clear();
+    }
+}
+
+double StreamingSource::getHeardPosition() const
+{
+    if (m_identity)
+        return static_cast<double>(m_inputPosition);
+
+    // Input SoundTouch has not processed yet, plus processed output not yet
+    // received (converted back to source samples).
+    const auto& st = *m_processor->soundTouch;
+    const double buffered = static_cast<double>(st.numUnprocessedSamples())
+                          + static_cast<double>(st.numSamples()) * m_tempoRatio;
+
+    const double length = static_cast<double>(m_source.getNumSamples());
+    double heard = static_cast<double>(m_inputPosition) - buffered;
+
+    if (m_looping.load() && length > 0.0)
+        heard = std::fmod(heard + length, length);
+
+    return std::max(0.0, heard);
+}
+
+void StreamingSource::feedChunk()
+{
+    const int numChannels = m_source.getNumChannels();
+    const juce::int64 length = m_source.getNumSamples();
+    const bool looping = m_looping.load();
 
-    // Push the source through in chunks, draining as we go.
-    int srcPos = 0;
-    while (srcPos < numSamples)
+    juce::int64 pos = m_inputPosition;
+    for (int i = 0; i < kChunkFrames; ++i, ++pos)
     {
-        const int chunk = std::min(kChunkFrames, numSamples - srcPos);
+        if (looping && pos >= length)
+            pos = 0;
 
-        for (int i = 0; i < chunk; ++i)
-            for (int ch = 0; ch < numChannels; ++ch)
-                interleavedIn[static_cast<size_t>(i) * static_cast<size_t>(numChannels)
-                              + static_cast<size_t>(ch)]
-                    = input.getSample(ch, srcPos + i);
+        float* frame = m_interleaved.data() + static_cast<size_t>(i) * static_cast<size_t>(numChannels);
+        for (int ch = 0; ch < numChannels; ++ch)
+            frame[ch] = pos < length ? m_source.getSample(ch, static_cast<int>(pos)) : 0.0f;
+    }
+    m_inputPosition = pos;
 
-        st.putSamples(interleavedIn.data(), static_cast<unsigned int>(chunk));
-        drainOutput();
-        srcPos += chunk;
+    // Past the end of a one-shot preview this feeds silence, which drains
+    // SoundTouch's tail without flush() (which allocates).
+    m_processor->soundTouch->putSamples(m_interleaved.data(), static_cast<unsigned int>(kChunkFrames));
+}
+
+void StreamingSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    auto& out = *bufferToFill.buffer;
+    const int start = bufferToFill.startSample;
+    const int numSamples = bufferToFill.numSamples;
+    const int numChannels = m_source.getNumChannels();
+    const int numOutChannels = std::min(out.getNumChannels(), numChannels);
+    const juce::int64 length = m_source.getNumSamples();
+    const bool looping = m_looping.load();
+
+    for (int ch = numOutChannels; ch < out.getNumChannels(); ++ch)
+        out.clear(ch, start, numSamples);
+
+    if (numChannels <= 0 || length <= 0)
+    {
+        out.clear(start, numSamples);
+        return;
+    }
+
+    applyPendingChanges();
 
-        // Report progress from the push phase; bail out (empty result) on cancel.
-        if (onProgress != nullptr
-            && ! onProgress(static_cast<float>(srcPos) / static_cast<float>(numSamples)))
+    if (m_identity)
+    {
+        juce::int64 pos = m_inputPosition;
+        for (int i = 0; i < numSamples; ++i, ++pos)
         {
-            return {};
+            if (looping && pos >= length)
+                pos = 0;
+
+            for (int ch = 0; ch < numOutChannels; ++ch)
+                out.setSample(ch, start + i, pos < length ? m_source.getSample(ch, static_cast<int>(pos)) : 0.0f);
         }
+        m_inputPosition = pos;
+        m_playhead.store(static_cast<double>(pos));
+        return;
     }
 
-    // Flush internal state and drain whatever's left.
-    st.flush();
-    drainOutput();
-
-    // Build the result buffer from the collected channel data.
-    const int outNumSamples = static_cast<int>(outChannels[0].size());
-    juce::AudioBuffer<float> result(numChannels, outNumSamples);
-    for (int ch = 0; ch < numChannels; ++ch)
+    int done = 0;
+    while (done < numSamples)
     {
-        const int chFrames = std::min(outNumSamples,
-                                       static_cast<int>(outChannels[static_cast<size_t>(ch)].size()));
-        if (chFrames > 0)
+        const int wanted = std::min(numSamples - done, kChunkFrames);
+        const int received = static_cast<int>(m_processor->soundTouch->receiveSamples(
+            m_interleaved.data(), static_cast<unsigned int>(wanted)));
+
+        if (received == 0)
+        {
+            feedChunk();
+            continue;
+        }
+
+        for (int i = 0; i < received; ++i)
         {
-            std::memcpy(result.getWritePointer(ch),
-                        outChannels[static_cast<size_t>(ch)].data(),
-                        static_cast<size_t>(chFrames) * sizeof(float));
+            const float* frame = m_interleaved.data() + static_cast<size_t>(i) * static_cast<size_t>(numChannels);
+            for (int ch = 0; ch < numOutChannels; ++ch)
+                out.setSample(ch, start + done + i, frame[ch]);
         }
+        done += received;
     }
 
-    return result;
+    m_playhead.store(getHeardPosition());
+}
+
+void StreamingSource::setNextReadPosition(juce::int64 newPosition)
+{
+    newPosition = std::max(static_cast<juce::int64>(0), newPosition);
+    m_playhead.store(static_cast<double>(newPosition));
+    m_pendingSeek.store(newPosition);
+}
+
+juce::int64 StreamingSource::getNextReadPosition() const
+{
+    return static_cast<juce::int64>(m_playhead.load());
+}
+
+juce::int64 StreamingSource::getTotalLength() const
+{
+    // Source samples, like the read position. That position already lags by
+    // what SoundTouch still holds, so a one-shot preview reaches this only
+    // once the stretched tail has played out.
+    return m_source.getNumSamples();
+}
+
+bool StreamingSource::isLooping() const
+{
+    return m_looping.load();
+}
+
+void StreamingSource::setLooping(bool shouldLoop)
+{
+    m_looping.store(shouldLoop);
 }
 
 }  // namespace TimePitchEngine
@@ -13,6 +13,8 @@
     SoundTouch-backed time-stretch and pitch-shift DSP. The engine
     processes a JUCE AudioBuffer<float> offline (i.e. not on the audio
     thread) and returns a new buffer with the requested length / pitch.
+    StreamingSource runs the same processing incrementally on the audio
+    thread for previews, with the recipe changeable while it plays.
 
     This is a thin C++ wrapper over the SoundTouch library; the
     interesting algorithms live in libSoundTouch (LGPL-2.1). Bundling
@@ -25,7 +27,12 @@
 #pragma once
 
 #include <juce_audio_basics/juce_audio_basics.h>
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <vector>
+
+namespace soundtouch { class SoundTouch; }
 
 namespace TimePitchEngine
 {
@@ -52,17 +59,119 @@ namespace TimePitchEngine
      * return the resulting buffer. Channel count is preserved; sample
      * count scales with tempo (slower → more samples).
      *
+     * Inputs of a minute or more are cut into 30-second segments that render
+     * on their own SoundTouch instances across cores. Each segment also reads
+     * a margin either side, and neighbours are joined by a short crossfade
+     * after lining up their waveforms. The cut points depend only on the
+     * input length, so the result is the same on every run and machine.
+     *
      * @param input          Source audio (planar, JUCE convention).
      * @param sampleRate     Sample rate in Hz.
      * @param recipe         Tempo + pitch parameters.
-     * @param onProgress     Optional progress callback invoked from the chunked
-     *                       processing loop with a 0..1 fraction. Return false to
-     *                       cancel: the engine stops and returns an empty buffer.
-     *                       May be null/empty (no reporting, never cancelled).
+     * @param onProgress     Optional progress callback with a 0..1 fraction,
+     *                       always invoked on the calling thread: per chunk for
+     *                       short inputs, and for long ones as segments finish
+     *                       and about every 100 ms while they render.
+     *                       Return false to cancel: the engine stops (segments
+     *                       still rendering stop at their next chunk) and
+     *                       returns an empty buffer. May be null/empty (no
+     *                       reporting, never cancelled).
      * @return Processed audio buffer. Empty buffer on invalid input or cancel.
+     * @throws std::length_error if the result would exceed an AudioBuffer's size
      */
     juce::AudioBuffer<float> apply(const juce::AudioBuffer<float>& input,
                                     double sampleRate,
                                     const Recipe& recipe,
                                     std::function<bool(float)> onProgress = {});
+
+    /**
+     * Plays a buffer through SoundTouch one audio block at a time, for the
+     * Time Stretch / Pitch Shift preview. There is no up-front render: a
+     * setRecipe() call is heard from the next block, whatever the buffer's
+     * length.
+     *
+     * The read position is in source samples and is what is being heard:
+     * the audio fed to SoundTouch but still buffered inside it (its
+     * latency) is subtracted, so the playhead follows the source audio
+     * while the stretched result plays, and a one-shot preview ends when
+     * the last source sample has come out rather than when it went in. An
+     * identity recipe plays the source directly, which is also how the
+     * preview's Bypass is heard.
+     *
+     * getNextAudioBlock() does not lock or allocate. setRecipe() configures
+     * (and pre-sizes) a fresh SoundTouch on the calling thread and hands it
+     * over through an atomic slot; the audio thread only swaps pointers and
+     * hands the old instance back to be freed by the next setRecipe() call.
+     * setRecipe() must not be called from the audio thread; setLooping()
+     * and setNextReadPosition() may be called from any thread.
+     */
+    class StreamingSource : public juce::PositionableAudioSource
+    {
+    public:
+        /** Copies source; sampleRate is its rate. */
+        StreamingSource(const juce::AudioBuffer<float>& source, double sampleRate);
+        ~StreamingSource() override;
+
+        /** Takes effect at the start of the next audio block. Allocates. */
+        void setRecipe(const Recipe& recipe);
+
+        // PositionableAudioSource implementation
+        void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+        void releaseResources() override;
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+        void setNextReadPosition(juce::int64 newPosition) override;
+        juce::int64 getNextReadPosition() const override;
+        juce::int64 getTotalLength() const override;
+        bool isLooping() const override;
+        void setLooping(bool shouldLoop) override;
+
+    private:
+        /** Frames moved through SoundTouch per put/receive call. */
+        static constexpr int kChunkFrames = 1024;
+
+        /** Chunks pushed through a new instance to size its buffers up front. */
+        static constexpr int kPrimeChunks = 32;
+
+        /** A SoundTouch configured for one recipe, built off the audio thread. */
+        struct Processor
+        {
+            Recipe recipe;
+            std::unique_ptr<soundtouch::SoundTouch> soundTouch;
+        };
+
+        /** Builds and pre-sizes a Processor for recipe. Allocates. */
+        std::unique_ptr<Processor> createProcessor(const Recipe& recipe) const;
+
+        /** Picks up a new processor or seek. Audio thread. */
+        void applyPendingChanges();
+
+        /** Feeds one chunk of source (silence past the end) into SoundTouch. */
+        void feedChunk();
+
+        /** Source position being heard now: fed minus still buffered in SoundTouch. */
+        double getHeardPosition() const;
+
+        juce::AudioBuffer<float> m_source;
+        double m_sampleRate;
+        std::vector<float> m_interleaved;              // kChunkFrames frames, in and out
+
+        // setRecipe() -> audio thread, and the replaced processor back. The
+        // audio thread only takes a new processor while the retired slot is
+        // empty, so it never has to free one itself.
+        std::atomic<Processor*> m_pendingProcessor { nullptr };
+        std::atomic<Processor*> m_retiredProcessor { nullptr };
+        std::atomic<juce::int64> m_pendingSeek { -1 };
+        std::atomic<bool> m_looping { false };
+
+        // Audio thread only
+        std::unique_ptr<Processor> m_processor;
+        bool m_identity = true;
+        double m_tempoRatio = 1.0;                     // Source samples per output sample
+        juce::int64 m_inputPosition = 0;               // Next source sample fed to SoundTouch
+
+        // Playhead in source samples (read from any thread)
+        std::atomic<double> m_playhead { 0.0 };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingSource)
+    };
 }
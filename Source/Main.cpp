@@ -22,6 +22,8 @@
 
 
 #include "MainComponent.h"
+#include "Audio/PlaybackMixer.h"
+#include "Utils/UndoAudioSpool.h"
 
 
 //==============================================================================
@@ -136,9 +138,11 @@ public:
         m_lookAndFeel = std::make_unique<waveedit::WaveEditLookAndFeel>();
         juce::LookAndFeel::setDefaultLookAndFeel(m_lookAndFeel.get());
 
-        // Initialize audio device manager
+        // Initialize audio device manager. Playback only: recording opens
+        // its own input device (RecordingDialog), so the two never reconfigure
+        // each other.
         juce::String audioError = m_audioDeviceManager.initialise(
-            2,      // number of input channels
+            0,      // number of input channels
             2,      // number of output channels
             nullptr, // saved state
             true);   // select default device
@@ -148,6 +152,13 @@ public:
             juce::Logger::writeToLog("Audio initialization error: " + audioError);
         }
 
+        // Every document plays through this one device via the shared mixer
+        PlaybackMixer::getInstance().attachTo(m_audioDeviceManager);
+
+        // Undo history spills to disk through this; it must exist before any
+        // document and outlive them all (see shutdown()).
+        m_undoSpool = std::make_unique<UndoAudioSpool>();
+
         // Create main window
         mainWindow.reset(new MainWindow(getApplicationName(), m_audioDeviceManager));
 
@@ -178,6 +189,11 @@ public:
     {
         // Clean up on exit
         mainWindow = nullptr;
+        PlaybackMixer::getInstance().detach();
+
+        // After the documents (and their undo payloads) are gone, and while
+        // the message loop still runs for the spool's in-flight jobs.
+        m_undoSpool.reset();
 
         // Detach the file logger before destroying it.
         juce::Logger::writeToLog("WaveEdit shutting down cleanly");
@@ -300,6 +316,7 @@ private:
     juce::AudioDeviceManager m_audioDeviceManager;
     std::unique_ptr<MainWindow> mainWindow;
     std::unique_ptr<juce::FileLogger> m_fileLogger;
+    std::unique_ptr<UndoAudioSpool> m_undoSpool;
 };
 
 //==============================================================================
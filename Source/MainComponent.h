@@ -37,6 +37,7 @@
 #include "Utils/Settings.h"
 #include "Utils/AudioClipboard.h"
 #include "Utils/UndoableEdits.h"
+#include "Utils/UndoAudioSpool.h"
 #include "Utils/UndoActions/AudioUndoActions.h"
 #include "Utils/UndoActions/RegionUndoActions.h"
 #include "Utils/UndoActions/MarkerUndoActions.h"
@@ -780,6 +781,18 @@ public:
                 currentTime.toRawUTF8(),
                 totalTime.toRawUTF8());
 
+            // Undo history footprint, once there is any: RAM, then the
+            // compressed spill on disk.
+            const auto* undoSpool = UndoAudioSpool::getInstance();
+            const int64_t undoResidentMB = undoSpool != nullptr ? undoSpool->getResidentBytes() / (1024 * 1024) : 0;
+            const int64_t undoSpilledMB = undoSpool != nullptr ? undoSpool->getSpilledBytes() / (1024 * 1024) : 0;
+            if (undoSpilledMB > 0)
+                info += juce::String::formatted(" | Undo: %d MB (+%d MB on disk)",
+                                                static_cast<int>(undoResidentMB),
+                                                static_cast<int>(undoSpilledMB));
+            else if (undoResidentMB > 0)
+                info += juce::String::formatted(" | Undo: %d MB", static_cast<int>(undoResidentMB));
+
             g.drawText(info, leftSection, juce::Justification::centredLeft, true);
 
             // Surround fold-down badge (H7): never fold down silently. Shown at the
@@ -1160,8 +1173,9 @@ public:
     {
         auto& undoMgr = doc->getUndoManager();
         if (! undoMgr.canUndo()) return;
+        if (deferUntilUndoAudioReloaded(doc, true, &MainComponent::handleUndo)) return;
 
-        undoMgr.undo();
+        takeHistoryStep(doc, true);
         doc->setModified(true);
         if (m_regionListPanel) m_regionListPanel->refresh();
         if (m_markerListPanel) m_markerListPanel->refresh();
@@ -1172,14 +1186,47 @@ public:
     {
         auto& undoMgr = doc->getUndoManager();
         if (! undoMgr.canRedo()) return;
+        if (deferUntilUndoAudioReloaded(doc, false, &MainComponent::handleRedo)) return;
 
-        undoMgr.redo();
+        takeHistoryStep(doc, false);
         doc->setModified(true);
         if (m_regionListPanel) m_regionListPanel->refresh();
         if (m_markerListPanel) m_markerListPanel->refresh();
         repaint();
     }
 
+    /**
+     * If the audio the undo (or redo) restores has been spilled to disk,
+     * starts reading it back and queues the step to run once it is in RAM
+     * instead of blocking the message thread on the read; returns true if
+     * it did.
+     */
+    bool deferUntilUndoAudioReloaded(Document* doc, bool isUndo, void (MainComponent::*handler)(Document*))
+    {
+        auto* spool = UndoAudioSpool::getInstance();
+        if (spool == nullptr)
+            return false;
+
+        juce::Component::SafePointer<MainComponent> safeThis(this);
+        return spool->prepareHistoryStep(doc->getBufferManager(), isUndo, [safeThis, doc, handler]()
+        {
+            if (safeThis != nullptr && safeThis->m_documentManager.getDocumentIndex(doc) >= 0)
+                (safeThis.getComponent()->*handler)(doc);
+        });
+    }
+
+    /** Undoes or redoes one step, letting the spool follow the history position. */
+    void takeHistoryStep(Document* doc, bool isUndo)
+    {
+        auto& undoMgr = doc->getUndoManager();
+        const auto step = [&undoMgr, isUndo]() { return isUndo ? undoMgr.undo() : undoMgr.redo(); };
+
+        if (auto* spool = UndoAudioSpool::getInstance())
+            spool->takeHistoryStep(doc->getBufferManager(), isUndo, step);
+        else
+            step();
+    }
+
     void showBWFMetadataDialog(Document* doc)
     {
         BWFEditorDialog::showDialog(this, doc->getBWFMetadata(),
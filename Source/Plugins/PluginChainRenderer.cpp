@@ -14,6 +14,7 @@
 */
 
 #include "PluginChainRenderer.h"
+#include "../Automation/AutomationManager.h"
 #include <iostream>
 
 //==============================================================================
@@ -67,7 +68,6 @@ PluginChainRenderer::RenderResult PluginChainRenderer::renderWithOfflineChain(
     // Reset the per-render log throttle counter at the start of each render.
     m_blockCounter = 0;
 
-    (void)sampleRate;  // Sample rate was used during chain creation
     RenderResult result;
 
     // Validate inputs
@@ -178,8 +178,16 @@ PluginChainRenderer::RenderResult PluginChainRenderer::renderWithOfflineChain(
             chunk.copyFrom(ch, 0, inputBuffer, ch, static_cast<int>(samplesProcessed), chunkSize);
         }
 
-        // Process chunk through plugin chain
-        if (!processBlock(offlineChain, chunk, emptyMidi))
+        // Process chunk through plugin chain. Automated chains are sliced at
+        // automation updates; the timeline position of input sample p is
+        // startSample + p - latency (the prepended silence comes first).
+        const bool processed = offlineChain.automation.empty() || sampleRate <= 0.0
+            ? processBlock(offlineChain, chunk, emptyMidi)
+            : processAutomatedChunk(offlineChain, chunk, chunkSize,
+                                    static_cast<double>(startSample + samplesProcessed - offlineChain.totalLatency) / sampleRate,
+                                    sampleRate, emptyMidi);
+
+        if (!processed)
         {
             result.errorMessage = "Plugin crashed during processing";
             return result;
@@ -284,7 +292,8 @@ juce::String PluginChainRenderer::buildChainDescription(PluginChain& chain)
 PluginChainRenderer::OfflineChain PluginChainRenderer::createOfflineChain(
     PluginChain& chain,
     double sampleRate,
-    int blockSize)
+    int blockSize,
+    const AutomationManager* automation)
 {
     std::cerr << "[RENDERER] createOfflineChain: Starting, sampleRate=" << sampleRate
               << ", blockSize=" << blockSize << std::endl;
@@ -385,6 +394,7 @@ PluginChainRenderer::OfflineChain PluginChainRenderer::createOfflineChain(
 
         offlineChain.instances.push_back(std::move(instance));
         offlineChain.bypassed.push_back(bypassed);
+        offlineChain.chainIndices.push_back(i);
         std::cerr << "[RENDERER] createOfflineChain: Plugin added to chain" << std::endl;
         std::cerr.flush();
     }
@@ -393,6 +403,9 @@ PluginChainRenderer::OfflineChain PluginChainRenderer::createOfflineChain(
               << offlineChain.instances.size() << ", latency=" << offlineChain.totalLatency << std::endl;
     std::cerr.flush();
 
+    if (automation != nullptr)
+        offlineChain.automation = automation->createSnapshot();
+
     DBG("PluginChainRenderer: Created offline chain with " +
         juce::String(offlineChain.instances.size()) + " plugins, total latency: " +
         juce::String(offlineChain.totalLatency) + " samples");
@@ -461,3 +474,62 @@ bool PluginChainRenderer::processBlock(
 
     return true;
 }
+
+//==============================================================================
+bool PluginChainRenderer::processAutomatedChunk(
+    OfflineChain& offlineChain,
+    juce::AudioBuffer<float>& chunk,
+    int numSamples,
+    double chunkStartTime,
+    double sampleRate,
+    juce::MidiBuffer& midi)
+{
+    for (int done = 0; done < numSamples;)
+    {
+        const int sliceLength = applyAutomation(offlineChain, chunkStartTime + done / sampleRate,
+                                                sampleRate, numSamples - done);
+
+        // Refers into the chunk; nothing is copied
+        juce::AudioBuffer<float> slice(chunk.getArrayOfWritePointers(), chunk.getNumChannels(),
+                                       done, sliceLength);
+        if (!processBlock(offlineChain, slice, midi))
+            return false;
+
+        done += sliceLength;
+    }
+
+    return true;
+}
+
+int PluginChainRenderer::applyAutomation(OfflineChain& offlineChain, double timeInSeconds,
+                                         double sampleRate, int maxSamples)
+{
+    // Same half-sample read offset as AutomationManager::applyAutomation()
+    const double readTime = timeInSeconds + 0.5 / sampleRate;
+    int sliceLength = maxSamples;
+
+    for (auto& lane : offlineChain.automation)
+    {
+        const auto it = std::find(offlineChain.chainIndices.begin(), offlineChain.chainIndices.end(),
+                                  lane.pluginIndex);
+        if (it == offlineChain.chainIndices.end())
+            continue;
+
+        const auto instanceIndex = static_cast<size_t>(it - offlineChain.chainIndices.begin());
+        auto& instance = offlineChain.instances[instanceIndex];
+        if (instance == nullptr || offlineChain.bypassed[instanceIndex])
+            continue;
+
+        auto& params = instance->getParameters();
+        if (lane.parameterIndex < 0 || lane.parameterIndex >= params.size())
+            continue;
+
+        const auto segment = AutomationCurve::evaluateSegment(lane.points, readTime, lane.cursor);
+        params[lane.parameterIndex]->setValue(segment.value);
+
+        sliceLength = juce::jmin(sliceLength,
+            AutomationCurve::samplesUntilUpdate(segment, readTime, sampleRate, maxSamples));
+    }
+
+    return sliceLength;
+}
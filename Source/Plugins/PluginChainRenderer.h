@@ -20,6 +20,9 @@
 #include "PluginChain.h"
 #include "PluginManager.h"
 #include "../Utils/ProgressCallback.h"
+#include "../Automation/AutomationData.h"
+
+class AutomationManager;
 
 /**
  * Offline renderer for processing audio through a plugin chain.
@@ -38,6 +41,12 @@
  * - Prepends silence to input, processes, then discards initial samples
  * - Result buffer has same length as input, properly aligned
  *
+ * Automation:
+ * - An offline chain created with the document's AutomationManager carries a
+ *   snapshot of its lanes. Rendering then splits each block at breakpoints
+ *   and ramp steps exactly as real-time playback does, so a render sounds
+ *   like playback of the same automation
+ *
  * Usage:
  * @code
  * PluginChainRenderer renderer;
@@ -150,6 +159,8 @@ public:
     {
         std::vector<std::unique_ptr<juce::AudioPluginInstance>> instances;
         std::vector<bool> bypassed;  ///< Bypass state per plugin
+        std::vector<int> chainIndices;  ///< Source chain index per instance (failed plugins are skipped)
+        std::vector<AutomationLaneSnapshot> automation;  ///< Lanes to follow (empty = static render)
         int totalLatency = 0;
 
         bool isValid() const { return !instances.empty(); }
@@ -164,12 +175,14 @@ public:
      * @param chain Source chain to copy from
      * @param sampleRate Sample rate for processing
      * @param blockSize Block size for processing
+     * @param automation Automation for chain's plugins, snapshotted for the render (optional)
      * @return OfflineChain with instances ready for processing, or empty on failure
      */
     static OfflineChain createOfflineChain(
         PluginChain& chain,
         double sampleRate,
-        int blockSize);
+        int blockSize,
+        const AutomationManager* automation = nullptr);
 
     /**
      * Renders using a pre-created offline chain.
@@ -219,5 +232,27 @@ private:
         juce::AudioBuffer<float>& buffer,
         juce::MidiBuffer& midi);
 
+    /**
+     * Processes the first numSamples of a chunk in slices, applying the
+     * chain's automation before each slice.
+     *
+     * @param chunkStartTime Timeline position (seconds) of the chunk's first sample
+     * @return true if successful, false if a plugin crashed
+     */
+    bool processAutomatedChunk(
+        OfflineChain& offlineChain,
+        juce::AudioBuffer<float>& chunk,
+        int numSamples,
+        double chunkStartTime,
+        double sampleRate,
+        juce::MidiBuffer& midi);
+
+    /**
+     * Applies the automation snapshot at a time and returns how many of the
+     * next maxSamples hold those values (see AutomationCurve::samplesUntilUpdate).
+     */
+    static int applyAutomation(OfflineChain& offlineChain, double timeInSeconds,
+                               double sampleRate, int maxSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginChainRenderer)
 };
@@ -500,18 +500,53 @@ void HeadTailDialog::updateOverlay()
 
 void HeadTailDialog::renderProcessed()
 {
-    try
-    {
-        HeadTailEngine::process(m_originalBuffer, m_sampleRate, buildRecipe(), m_processedBuffer);
-    }
-    catch (const std::exception& e)
+    // Rendered on the shared preview worker so a long file never freezes the
+    // dialog; a newer recipe supersedes this one before it is delivered.
+    const auto recipe = buildRecipe();
+    m_renderer.submit<juce::AudioBuffer<float>>(
+        [this, recipe](const PreviewRenderer::ShouldCancel& shouldCancel)
+        {
+            juce::AudioBuffer<float> processed;
+            try
+            {
+                // A cancelled run leaves processed empty
+                HeadTailEngine::process(m_originalBuffer, m_sampleRate, recipe, processed, shouldCancel);
+            }
+            catch (const std::exception& e)
+            {
+                juce::Logger::writeToLog("HeadTailDialog::renderProcessed - " + juce::String(e.what()));
+                processed.setSize(0, 0);
+            }
+            return processed;
+        },
+        [this](juce::AudioBuffer<float>& processed) { previewRendered(processed); });
+}
+
+void HeadTailDialog::previewRendered(juce::AudioBuffer<float>& processed)
+{
+    if (! m_previewActive)
+        return;
+
+    if (! engineUsable())   // document closed while the render was running
     {
-        juce::Logger::writeToLog("HeadTailDialog::renderProcessed - " + juce::String(e.what()));
-        m_processedBuffer.setSize(0, 0);
+        stopPreview();
+        return;
     }
 
+    m_processedBuffer = std::move(processed);
     m_processedPlayable = previewIsPlayable(m_processedBuffer.getNumSamples(),
                                             m_processedBuffer.getNumChannels());
+    if (! m_processedPlayable)
+    {
+        m_summaryEditor.setText("Result is empty - nothing to preview.", juce::dontSendNotification);
+        stopPreview();
+        return;
+    }
+
+    // While bypassed the original keeps playing; the new render is picked up
+    // when Bypass is released.
+    if (! m_bypassActive && ! reloadActiveBuffer())   // startBufferPreview restarts playback itself
+        stopPreview();
 }
 
 bool HeadTailDialog::engineUsable() const noexcept
@@ -539,20 +574,12 @@ void HeadTailDialog::startPreview()
     if (! engineUsable())
         return;
 
-    renderProcessed();
-    if (! m_processedPlayable)
-    {
-        m_summaryEditor.setText("Result is empty - nothing to preview.", juce::dontSendNotification);
-        return;
-    }
-
+    // Playback starts when the render arrives (previewRendered)
     m_previewActive = true;
     m_bypassActive  = false;
-    if (! reloadActiveBuffer())   // loads + loops + plays via startBufferPreview
-    {
-        stopPreview();
-        return;
-    }
+    m_processedBuffer.setSize(0, 0);
+    m_processedPlayable = false;
+    renderProcessed();
 
     m_previewButton.setButtonText("STOP");   // short label: "Stop Preview" was clipped
     m_previewButton.setColour(juce::TextButton::buttonColourId,
@@ -565,6 +592,7 @@ void HeadTailDialog::stopPreview()
     if (engineUsable())
         m_audioEngine->stopSelectionPreview();
     stopTimer();
+    m_renderer.cancel();
 
     m_previewActive = false;
     m_bypassActive  = false;
@@ -588,16 +616,8 @@ void HeadTailDialog::timerCallback()
         return;
     }
 
-    renderProcessed();
-    if (! m_processedPlayable)
-    {
-        m_summaryEditor.setText("Result is empty - nothing to preview.", juce::dontSendNotification);
-        stopPreview();
-        return;
-    }
-
     updateOverlay();
-    reloadActiveBuffer();   // startBufferPreview restarts playback itself
+    renderProcessed();   // previewRendered() restarts playback with the result
 }
 
 HeadTailDialog::~HeadTailDialog()
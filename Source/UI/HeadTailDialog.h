@@ -18,6 +18,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "../DSP/HeadTailRecipe.h"
+#include "../Audio/PreviewRenderer.h"
 
 class AudioEngine; // full include in the .cpp (preview playback)
 
@@ -200,7 +201,7 @@ private:
     double                           m_sampleRate;
 
     //==========================================================================
-    // Audio preview (§6.8) — offline-render the recipe, play via OFFLINE_BUFFER.
+    // Audio preview (§6.8) — render the recipe in the background, play via OFFLINE_BUFFER.
 
     AudioEngine*             m_audioEngine = nullptr;
     // Lifeline to a Document-owned Component (its WaveformDisplay). The dialog
@@ -214,13 +215,19 @@ private:
     bool m_previewActive     = false;
     bool m_bypassActive      = false;
 
+    // Renders read m_originalBuffer on the worker; declared after it so the
+    // renderer's destructor waits for a running render before the buffer goes.
+    PreviewRenderer m_renderer;
+
     static constexpr int kPreviewDebounceMs = 200;
 
     /** True only when the engine pointer is set AND its document is still alive. */
     bool engineUsable() const noexcept;
-    /** Recompute and render the offline preview buffer from the current recipe. */
+    /** Queue a background render of the current recipe, superseding any pending one. */
     void renderProcessed();
-    /** Begin audio preview (render + load + loop + play). No-op if not playable. */
+    /** A render finished: keep it and (re)start playback of it. */
+    void previewRendered(juce::AudioBuffer<float>& processed);
+    /** Begin audio preview (render, then load + loop + play). */
     void startPreview();
     /** Stop audio preview and restore the engine to normal. Idempotent + UAF-safe. */
     void stopPreview();
@@ -14,6 +14,7 @@
 */
 
 #include "LoopingToolsDialog.h"
+#include "../Audio/AudioBufferManager.h"
 #include "ThemeManager.h"
 #include "UIConstants.h"
 
@@ -146,18 +147,26 @@ void LoopingToolsDialog::WaveformPreview::drawWaveform(juce::Graphics& g,
 // LoopingToolsDialog constructor
 //==============================================================================
 
-LoopingToolsDialog::LoopingToolsDialog(const juce::AudioBuffer<float>& buffer,
+LoopingToolsDialog::LoopingToolsDialog(const AudioBufferManager& bufferManager,
                                         double sampleRate,
                                         int64_t selectionStart,
                                         int64_t selectionEnd,
                                         const juce::File& sourceFile)
-    : m_audioBuffer(buffer)
-    , m_sampleRate(sampleRate)
+    : m_sampleRate(sampleRate)
     , m_selectionStart(selectionStart)
     , m_selectionEnd(selectionEnd)
     , m_sourceFile(sourceFile)
     , m_outputDirectory(sourceFile.getParentDirectory())
 {
+    // Owned copy of the selection for preview and export (see header)
+    const int64_t totalSamples = bufferManager.getNumSamples();
+    m_previewSourceOffset = juce::jlimit((int64_t) 0, totalSamples,
+                                         m_selectionStart - kPreviewMarginSamples);
+    const int64_t previewSourceEnd = juce::jlimit(m_previewSourceOffset, totalSamples,
+                                                  m_selectionEnd + kPreviewMarginSamples);
+    m_previewSource = bufferManager.getAudioRange(m_previewSourceOffset,
+                                                  previewSourceEnd - m_previewSourceOffset);
+
     //--------------------------------------------------------------------------
     // Section 1: Loop Settings
 
@@ -785,18 +794,37 @@ LoopRecipe LoopingToolsDialog::buildRecipe() const
     return recipe;
 }
 
-void LoopingToolsDialog::updatePreview()
+void LoopingToolsDialog::updatePreview(bool restartPlayback)
 {
-    auto recipe = buildRecipe();
+    m_playbackRestartPending = m_playbackRestartPending || restartPlayback;
 
-    LoopResult result;
-    if (recipe.shepardEnabled)
-        result = LoopEngine::createShepardLoop(m_audioBuffer, m_sampleRate,
-                                                m_selectionStart, m_selectionEnd, recipe);
-    else
-        result = LoopEngine::createLoop(m_audioBuffer, m_sampleRate,
-                                         m_selectionStart, m_selectionEnd, recipe);
+    const auto recipe = buildRecipe();
+    const int64_t offset = m_previewSourceOffset;
+    const int64_t start  = m_selectionStart - offset;
+    const int64_t end    = m_selectionEnd - offset;
+
+    // Rendered on the shared preview worker; a newer request supersedes this
+    // one before it is delivered.
+    m_renderer.submit<LoopResult>(
+        [this, recipe, offset, start, end](const PreviewRenderer::ShouldCancel& shouldCancel)
+        {
+            LoopResult result = recipe.shepardEnabled
+                ? LoopEngine::createShepardLoop(m_previewSource, m_sampleRate, start, end, recipe, shouldCancel)
+                : LoopEngine::createLoop(m_previewSource, m_sampleRate, start, end, recipe, shouldCancel);
 
+            // Back to document samples, as the diagnostics report them
+            if (result.success)
+            {
+                result.loopStartSample += offset;
+                result.loopEndSample   += offset;
+            }
+            return result;
+        },
+        [this, recipe](LoopResult& result) { previewRendered(result, recipe); });
+}
+
+void LoopingToolsDialog::previewRendered(LoopResult& result, const LoopRecipe& recipe)
+{
     if (result.success)
     {
         m_previewResult = result;
@@ -889,6 +917,35 @@ void LoopingToolsDialog::updatePreview()
         m_diagnosticsLabel.setText("Preview failed: " + result.errorMessage,
                                     juce::dontSendNotification);
     }
+
+    // Hand the loop to playback if this render was asked to start or restart it
+    const bool playable = result.success && m_previewResult.loopBuffer.getNumSamples() > 0;
+
+    if (m_previewStartPending)
+    {
+        m_previewStartPending    = false;
+        m_playbackRestartPending = false;
+        if (!playable)
+            return;
+
+        m_isPreviewPlaying = true;
+        m_previewPlaybackButton.setButtonText("Stop Preview");
+        m_previewPlaybackButton.setColour(juce::TextButton::buttonColourId,
+            ui::colour(ui::kButtonPreviewActive));
+    }
+    else if (m_playbackRestartPending)
+    {
+        m_playbackRestartPending = false;
+        if (!m_isPreviewPlaying || !playable)
+            return;
+    }
+    else
+    {
+        return;
+    }
+
+    if (onPreviewRequested)
+        onPreviewRequested(m_previewResult.loopBuffer, m_sampleRate);
 }
 
 //==============================================================================
@@ -902,6 +959,7 @@ void LoopingToolsDialog::togglePreviewPlayback()
         // Stop playback
         stopTimer();
         m_isPreviewPlaying = false;
+        m_playbackRestartPending = false;
         m_previewPlaybackButton.setButtonText("Preview");
         m_previewPlaybackButton.setColour(juce::TextButton::buttonColourId,
             getLookAndFeel().findColour(juce::TextButton::buttonColourId));
@@ -911,19 +969,9 @@ void LoopingToolsDialog::togglePreviewPlayback()
     }
     else
     {
-        // Build loop and start playback
+        // Build the loop; playback starts when it arrives (previewRendered)
+        m_previewStartPending = true;
         updatePreview();
-
-        if (!m_previewResult.success || m_previewResult.loopBuffer.getNumSamples() == 0)
-            return;
-
-        m_isPreviewPlaying = true;
-        m_previewPlaybackButton.setButtonText("Stop Preview");
-        m_previewPlaybackButton.setColour(juce::TextButton::buttonColourId,
-            ui::colour(ui::kButtonPreviewActive));
-
-        if (onPreviewRequested)
-            onPreviewRequested(m_previewResult.loopBuffer, m_sampleRate);
     }
 }
 
@@ -932,13 +980,7 @@ void LoopingToolsDialog::rebuildPreviewPlayback()
     if (!m_isPreviewPlaying)
         return;
 
-    updatePreview();
-
-    if (m_previewResult.success && m_previewResult.loopBuffer.getNumSamples() > 0)
-    {
-        if (onPreviewRequested)
-            onPreviewRequested(m_previewResult.loopBuffer, m_sampleRate);
-    }
+    updatePreview(true);
 }
 
 void LoopingToolsDialog::schedulePreviewRebuild()
@@ -1008,16 +1050,20 @@ void LoopingToolsDialog::exportLoops()
         default: break;
     }
 
+    // Selection bounds within m_previewSource
+    const int64_t start = m_selectionStart - m_previewSourceOffset;
+    const int64_t end   = m_selectionEnd - m_previewSourceOffset;
+
     if (recipe.loopCount <= 1)
     {
         // Single loop export
         LoopResult result;
         if (recipe.shepardEnabled)
-            result = LoopEngine::createShepardLoop(m_audioBuffer, m_sampleRate,
-                                                    m_selectionStart, m_selectionEnd, recipe);
+            result = LoopEngine::createShepardLoop(m_previewSource, m_sampleRate,
+                                                    start, end, recipe);
         else
-            result = LoopEngine::createLoop(m_audioBuffer, m_sampleRate,
-                                             m_selectionStart, m_selectionEnd, recipe);
+            result = LoopEngine::createLoop(m_previewSource, m_sampleRate,
+                                             start, end, recipe);
         if (!result.success)
         {
             juce::AlertWindow::showMessageBoxAsync(
@@ -1051,9 +1097,8 @@ void LoopingToolsDialog::exportLoops()
     else
     {
         // Multiple variation export
-        auto results = LoopEngine::createVariations(m_audioBuffer, m_sampleRate,
-                                                     m_selectionStart, m_selectionEnd,
-                                                     recipe);
+        auto results = LoopEngine::createVariations(m_previewSource, m_sampleRate,
+                                                     start, end, recipe);
         int exported = 0;
 
         for (size_t i = 0; i < results.size(); ++i)
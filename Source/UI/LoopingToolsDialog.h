@@ -20,6 +20,9 @@
 #include <juce_audio_formats/juce_audio_formats.h>
 #include "../DSP/LoopRecipe.h"
 #include "../DSP/LoopEngine.h"
+#include "../Audio/PreviewRenderer.h"
+
+class AudioBufferManager;
 
 /**
  * Looping Tools Dialog.
@@ -48,13 +51,14 @@ public:
     /**
      * Creates the Looping Tools dialog.
      *
-     * @param buffer         Source audio buffer (read-only; not modified)
+     * @param bufferManager  Source document; only the selection (plus the
+     *                       zero-crossing search margin) is read
      * @param sampleRate     Sample rate in Hz
      * @param selectionStart Selection start in samples (inclusive)
      * @param selectionEnd   Selection end in samples (exclusive)
      * @param sourceFile     Source file used to derive default output names
      */
-    LoopingToolsDialog(const juce::AudioBuffer<float>& buffer,
+    LoopingToolsDialog(const AudioBufferManager& bufferManager,
                        double sampleRate,
                        int64_t selectionStart,
                        int64_t selectionEnd,
@@ -207,7 +211,6 @@ private:
     //==========================================================================
     // State
 
-    const juce::AudioBuffer<float>& m_audioBuffer;
     double      m_sampleRate;
     int64_t     m_selectionStart;
     int64_t     m_selectionEnd;
@@ -217,14 +220,33 @@ private:
     LoopResult  m_previewResult;    // Cached result from last updatePreview()
     bool        m_isPreviewPlaying = false;  // Real-time preview playback state
 
+    // Preview renders and export read an owned copy of the selection (plus
+    // the widest zero-crossing search) rather than the live document, which
+    // can be edited while this dialog is open and is never flattened for it.
+    static constexpr int kPreviewMarginSamples = 5000;   // Search Window slider maximum
+    juce::AudioBuffer<float> m_previewSource;
+    int64_t     m_previewSourceOffset = 0;   // Document sample of m_previewSource[0]
+    bool        m_previewStartPending = false;     // Preview clicked; play the next render
+    bool        m_playbackRestartPending = false;  // Playing; restart with the next render
+
+    // Declared after m_previewSource: its destructor waits for a running render.
+    PreviewRenderer m_renderer;
+
     //==========================================================================
     // Core logic
 
     /** Build a LoopRecipe from the current UI state. */
     LoopRecipe buildRecipe() const;
 
-    /** Run LoopEngine::createLoop, update waveform preview and diagnostics. */
-    void updatePreview();
+    /**
+     * Queue LoopEngine::createLoop in the background; the result updates the
+     * waveform preview and diagnostics. With restartPlayback, a playing
+     * preview is also restarted with the new loop.
+     */
+    void updatePreview(bool restartPlayback = false);
+
+    /** Show a finished render (waveform + diagnostics) and hand it to playback. */
+    void previewRendered(LoopResult& result, const LoopRecipe& recipe);
 
     /** Rebuild the filename preview label from current recipe + suffix. */
     void updateFilePreview();
@@ -232,7 +254,7 @@ private:
     /** Start or stop real-time preview playback. */
     void togglePreviewPlayback();
 
-    /** Rebuild and send preview buffer to audio engine (called after debounce). */
+    /** Re-render and send the preview buffer to the audio engine (called after debounce). */
     void rebuildPreviewPlayback();
 
     /** Schedule a debounced rebuild of preview playback (200ms). */
@@ -14,6 +14,7 @@
 */
 
 #include "RecordingDialog.h"
+#include "ErrorDialog.h"
 #include "ThemeManager.h"
 #include "UIConstants.h"
 
@@ -107,10 +108,11 @@ void RecordingDialog::LevelMeter::mouseDown(const juce::MouseEvent&)
 //==============================================================================
 // RecordingDialog Implementation
 
-RecordingDialog::RecordingDialog(juce::AudioDeviceManager& deviceManager)
-    : m_deviceManager(deviceManager),
-      m_recordingEngine(std::make_unique<RecordingEngine>())
+RecordingDialog::RecordingDialog(const juce::AudioDeviceManager& playbackDeviceManager)
+    : m_recordingEngine(std::make_unique<RecordingEngine>())
 {
+    openInputDevice(playbackDeviceManager);
+
     // Input device selection
     m_inputDeviceLabel.setText("Input Device:", juce::dontSendNotification);
     addAndMakeVisible(m_inputDeviceLabel);
@@ -184,8 +186,9 @@ RecordingDialog::RecordingDialog(juce::AudioDeviceManager& deviceManager)
     m_recordingEngine->addChangeListener(this);
 
     // This dialog can stay open for the duration of a recording session
-    // (up to the 1-hour buffer cap), so cached colours below need to be
-    // re-applied on a live theme switch, not just read once at construction.
+    // (takes stream to disk and have no length limit), so cached colours
+    // below need to be re-applied on a live theme switch, not just read once
+    // at construction.
     waveedit::ThemeManager::getInstance().addChangeListener(this);
 
     // Add audio callback for input monitoring IMMEDIATELY
@@ -333,6 +336,20 @@ void RecordingDialog::comboBoxChanged(juce::ComboBox* comboBox)
 //==============================================================================
 // Device / rate / channel switching
 
+void RecordingDialog::openInputDevice(const juce::AudioDeviceManager& playbackDeviceManager)
+{
+    // Same input the application opened, but no outputs: this device only
+    // captures, and the playback device keeps running untouched.
+    auto setup = playbackDeviceManager.getAudioDeviceSetup();
+    setup.outputDeviceName = juce::String();
+    setup.outputChannels.clear();
+    setup.useDefaultOutputChannels = false;
+
+    const auto error = m_deviceManager.initialise(2, 0, nullptr, true, juce::String(), &setup);
+    if (error.isNotEmpty())
+        juce::Logger::writeToLog("RecordingDialog: Could not open input device: " + error);
+}
+
 bool RecordingDialog::applyDeviceSetup(const juce::AudioDeviceManager::AudioDeviceSetup& newSetup,
                                        juce::String& error)
 {
@@ -401,7 +418,7 @@ void RecordingDialog::handleSampleRateChange()
 
 void RecordingDialog::applyChannelSelection()
 {
-    // The channel-combo item ID IS the recorded channel count (1 or 2).
+    // The channel-combo item ID IS the recorded channel count.
     const int channelCount = juce::jmax(1, m_channelConfigSelector.getSelectedId());
     m_recordingEngine->setRequestedChannelCount(channelCount);
 
@@ -428,6 +445,18 @@ void RecordingDialog::changeListenerCallback(juce::ChangeBroadcaster* source)
 {
     if (source == m_recordingEngine.get())
     {
+        // The disk write failed: stop now, so the take ends where the audio
+        // does, and hand over what was written before the failure.
+        if (m_recordingEngine->isRecording() && m_recordingEngine->hasWriteFailed())
+        {
+            stopRecording();
+            ErrorDialog::show("Recording Stopped",
+                              "Writing the recording to disk failed, so recording was stopped. "
+                              "The audio recorded before the failure has been kept.\n\n"
+                              "Check that the disk has free space and is still connected.");
+            return;
+        }
+
         updateUIState();
     }
     else if (source == &waveedit::ThemeManager::getInstance())
@@ -466,43 +495,19 @@ void RecordingDialog::timerCallback()
     // Always update level meters for input monitoring (before AND during recording)
     updateLevelMeters();
 
-    // Check if buffer became full (polled on UI thread, not audio thread).
-    // Latch so the warning is shown AT MOST ONCE per recording session,
-    // otherwise the modal stacks on every timer tick (~33ms).
-    if (m_recordingEngine->isBufferFull() && !m_bufferFullHandled)
-    {
-        m_bufferFullHandled = true;
-
-        juce::Logger::writeToLog("RecordingDialog::timerCallback: recording buffer full, stopping recording");
-
-        // Prevent an immediate re-record refilling the buffer.
-        m_recordButton.setEnabled(false);
-
-        // Notify the user once.
-        juce::NativeMessageBox::showMessageBoxAsync(
-            juce::MessageBoxIconType::WarningIcon,
-            "Recording Buffer Full",
-            "Maximum recording duration reached (1 hour). Recording has been stopped.",
-            this);
-
-        // Finalize the recording via the existing Stop code path.
-        stopRecording();
-        return;
-    }
-
     // Only update elapsed time during recording
     if (m_recordingEngine->isRecording())
     {
         updateElapsedTime();
 
-        // Surface the RAM cap honestly: show how much record time is left
-        // before the 1-hour buffer fills (derived from real buffer capacity).
-        const double remaining = m_recordingEngine->getRemainingRecordSeconds();
-        const int totalSecs = juce::jmax(0, static_cast<int>(remaining));
-        const juce::String remainingText =
-            juce::String::formatted("Recording - %02d:%02d remaining",
-                                    totalSecs / 60, totalSecs % 60);
-        m_statusLabel.setText(remainingText, juce::dontSendNotification);
+        // The take streams to disk, so there is no time limit to show. A
+        // drop only happens if the disk falls behind the writer FIFO; say so
+        // rather than leaving a silent gap in the take.
+        const int dropped = m_recordingEngine->getDroppedSampleCount();
+        if (dropped > 0)
+            m_statusLabel.setText("Recording - disk too slow, "
+                                      + juce::String(dropped) + " samples dropped",
+                                  juce::dontSendNotification);
     }
 }
 
@@ -523,11 +528,11 @@ void RecordingDialog::removeListener(Listener* listener)
 // Static Helper
 
 void RecordingDialog::showDialog(juce::Component* parentComponent,
-                                 juce::AudioDeviceManager& deviceManager,
+                                 const juce::AudioDeviceManager& playbackDeviceManager,
                                  Listener* listener,
                                  std::function<void(bool)> recordingStateCallback)
 {
-    auto* dialog = new RecordingDialog(deviceManager);
+    auto* dialog = new RecordingDialog(playbackDeviceManager);
 
     if (listener != nullptr)
     {
@@ -637,6 +642,7 @@ void RecordingDialog::populateChannelConfigurations()
     // Simple, honest semantics (documented inline in the item text):
     //   Mono   -> records the first device input channel (input 1).
     //   Stereo -> records the first two device input channels (inputs 1-2).
+    //   All    -> records every device input (multichannel interfaces).
     // No downmix is performed. The item ID IS the recorded channel count.
     m_channelConfigSelector.addItem("Mono (records input 1)", 1);
 
@@ -648,6 +654,11 @@ void RecordingDialog::populateChannelConfigurations()
     if (availableInputs >= 2)
         m_channelConfigSelector.addItem("Stereo (records inputs 1-2)", 2);
 
+    const int allInputs = juce::jmin(availableInputs, RecordingEngine::MAX_CHANNELS);
+    if (allInputs > 2)
+        m_channelConfigSelector.addItem("All inputs (records inputs 1-" + juce::String(allInputs) + ")",
+                                        allInputs);
+
     // Default to stereo when available, otherwise mono.
     m_channelConfigSelector.setSelectedId(availableInputs >= 2 ? 2 : 1, juce::dontSendNotification);
 
@@ -671,7 +682,6 @@ void RecordingDialog::startRecording()
     // Just start the recording state
     if (m_recordingEngine->startRecording())
     {
-        m_bufferFullHandled = false;  // Reset buffer-full latch for the new session
         m_recordingStartTime = juce::Time::getMillisecondCounterHiRes() / 1000.0;
 
         // Fresh take -> clear any latched clip from monitoring.
@@ -693,16 +703,20 @@ void RecordingDialog::stopRecording()
     // Remove callback from device manager
     m_deviceManager.removeAudioCallback(m_recordingEngine.get());
 
-    // Get recorded audio
-    const auto& audioBuffer = m_recordingEngine->getRecordedAudio();
+    // Hand the finalized take to the listener; it is opened memory-mapped,
+    // so there is no length limit and nothing is read here.
     double sampleRate = m_recordingEngine->getRecordedSampleRate();
     int numChannels = m_recordingEngine->getRecordedNumChannels();
+    const auto takeFile = m_recordingEngine->releaseTakeFile();
 
-    // Notify listeners
-    m_listeners.call([&](Listener& listener)
+    if (takeFile.existsAsFile())
     {
-        listener.recordingCompleted(audioBuffer, sampleRate, numChannels);
-    });
+        // Notify listeners
+        m_listeners.call([&](Listener& listener)
+        {
+            listener.recordingCompleted(takeFile, sampleRate, numChannels);
+        });
+    }
 
     if (m_recordingStateCallback)
         m_recordingStateCallback(false);
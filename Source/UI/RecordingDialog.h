@@ -49,21 +49,25 @@ public:
         /**
          * Called when recording completes successfully.
          *
-         * @param audioBuffer The recorded audio buffer
+         * @param takeFile The finalized take (32-bit float WAV). The
+         *                 listener owns it and must open, move or delete it.
          * @param sampleRate Sample rate of the recording
          * @param numChannels Number of channels in the recording
          */
-        virtual void recordingCompleted(const juce::AudioBuffer<float>& audioBuffer,
+        virtual void recordingCompleted(const juce::File& takeFile,
                                        double sampleRate,
                                        int numChannels) = 0;
     };
 
     /**
-     * Constructor.
+     * Constructor. Capture runs on the dialog's own input-only device, so
+     * choosing an input or rate here never reopens the device documents
+     * play through.
      *
-     * @param deviceManager Reference to the application's AudioDeviceManager
+     * @param playbackDeviceManager The application's AudioDeviceManager; its
+     *        current input is the initial choice, and it is not reconfigured
      */
-    explicit RecordingDialog(juce::AudioDeviceManager& deviceManager);
+    explicit RecordingDialog(const juce::AudioDeviceManager& playbackDeviceManager);
     ~RecordingDialog() override;
 
     //==============================================================================
@@ -122,14 +126,14 @@ public:
      * Shows the recording dialog as a (non-modal) async window.
      *
      * @param parentComponent Parent component to center the dialog over
-     * @param deviceManager Reference to the application's AudioDeviceManager
+     * @param playbackDeviceManager The application's AudioDeviceManager (see the constructor)
      * @param listener Listener to notify when recording completes
      * @param recordingStateCallback Optional; called with true when capture
      *        actually starts and false when it stops/closes, so a persistent
      *        transport can show a live recording indicator.
      */
     static void showDialog(juce::Component* parentComponent,
-                          juce::AudioDeviceManager& deviceManager,
+                          const juce::AudioDeviceManager& playbackDeviceManager,
                           Listener* listener,
                           std::function<void(bool)> recordingStateCallback = {});
 
@@ -137,7 +141,7 @@ private:
     //==============================================================================
     // Private Members
 
-    juce::AudioDeviceManager& m_deviceManager;
+    juce::AudioDeviceManager m_deviceManager;   // input-only, separate from the playback device
     std::unique_ptr<RecordingEngine> m_recordingEngine;
 
     juce::ListenerList<Listener> m_listeners;
@@ -202,9 +206,6 @@ private:
     // Timing
     double m_recordingStartTime = 0.0;
 
-    // Latch so the buffer-full warning is shown at most once per session
-    bool m_bufferFullHandled = false;
-
     // True while at least one input device is available. When false the
     // record button and all three config combos stay disabled.
     bool m_hasInputDevice = true;
@@ -267,6 +268,9 @@ private:
      * @param error      Receives the device-manager error (empty on success)
      * @return true if the setup applied cleanly
      */
+    /** Opens m_deviceManager on the playback setup's input, without outputs. */
+    void openInputDevice(const juce::AudioDeviceManager& playbackDeviceManager);
+
     bool applyDeviceSetup(const juce::AudioDeviceManager::AudioDeviceSetup& newSetup,
                           juce::String& error);
 
@@ -21,6 +21,7 @@
 */
 
 #include "RegionDisplay.h"
+#include "../Audio/AudioBufferManager.h"
 #include "../Utils/AudioUnits.h"
 #include "../Utils/Settings.h"
 #include "ThemeManager.h"
@@ -32,7 +33,7 @@ RegionDisplay::RegionDisplay(RegionManager& regionManager)
     , m_visibleEnd(1.0)
     , m_sampleRate(44100.0)
     , m_totalDuration(0.0)
-    , m_audioBuffer(nullptr)
+    , m_bufferManager(nullptr)
     , m_hoveredRegionIndex(-1)
     , m_draggedRegionIndex(-1)
     , m_resizeMode(ResizeMode::None)
@@ -68,9 +69,27 @@ void RegionDisplay::setTotalDuration(double duration)
     m_totalDuration = duration;
 }
 
-void RegionDisplay::setAudioBuffer(const juce::AudioBuffer<float>* buffer)
+void RegionDisplay::setBufferManager(const AudioBufferManager* bufferManager)
 {
-    m_audioBuffer = buffer;
+    m_bufferManager = bufferManager;
+}
+
+int64_t RegionDisplay::snapToZeroCrossing(int64_t sample, int channel, int searchRadius) const
+{
+    const int64_t totalSamples = m_bufferManager->getNumSamples();
+    if (sample < 0 || sample >= totalSamples)
+        return juce::jlimit<int64_t>(0, totalSamples - 1, sample);
+
+    // Read only the search window instead of touching the whole document.
+    const int64_t windowStart = juce::jmax<int64_t>(0, sample - searchRadius);
+    const int64_t windowEnd = juce::jmin<int64_t>(totalSamples, sample + searchRadius + 1);
+    juce::AudioBuffer<float> window(1, static_cast<int>(windowEnd - windowStart));
+
+    if (! m_bufferManager->readChannelRange(channel, window.getWritePointer(0),
+                                            windowStart, window.getNumSamples()))
+        return sample;
+
+    return windowStart + AudioUnits::snapToZeroCrossing(sample - windowStart, window, 0, searchRadius);
 }
 
 //==============================================================================
@@ -421,9 +440,9 @@ void RegionDisplay::mouseUp(const juce::MouseEvent& /*event*/)
         {
             // Apply zero-crossing snap if enabled (Phase 3.3)
             if (Settings::getInstance().getSnapRegionsToZeroCrossings() &&
-                m_audioBuffer != nullptr &&
-                m_audioBuffer->getNumChannels() > 0 &&
-                m_audioBuffer->getNumSamples() > 0)
+                m_bufferManager != nullptr &&
+                m_bufferManager->getNumChannels() > 0 &&
+                m_bufferManager->getNumSamples() > 0)
             {
                 int channel = 0;  // Use first channel for snap detection
                 int searchRadius = 1000;  // 1000 samples (~22ms at 44.1kHz)
@@ -431,8 +450,8 @@ void RegionDisplay::mouseUp(const juce::MouseEvent& /*event*/)
                 int64_t startSample = region->getStartSample();
                 int64_t endSample = region->getEndSample();
 
-                int64_t snappedStart = AudioUnits::snapToZeroCrossing(startSample, *m_audioBuffer, channel, searchRadius);
-                int64_t snappedEnd = AudioUnits::snapToZeroCrossing(endSample, *m_audioBuffer, channel, searchRadius);
+                int64_t snappedStart = snapToZeroCrossing(startSample, channel, searchRadius);
+                int64_t snappedEnd = snapToZeroCrossing(endSample, channel, searchRadius);
 
                 // Ensure region remains valid (start < end) after snap
                 if (snappedStart < snappedEnd)
@@ -25,6 +25,8 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "../Utils/RegionManager.h"
 
+class AudioBufferManager;
+
 /**
  * Visual component that displays regions as colored bars above the waveform.
  *
@@ -78,12 +80,13 @@ public:
     void setTotalDuration(double duration);
 
     /**
-     * Sets the audio buffer pointer for zero-crossing snap (Phase 3.3).
-     * RegionDisplay does not own the buffer, just references it.
+     * Sets the document's buffer manager for zero-crossing snap (Phase 3.3).
+     * RegionDisplay does not own it; only the samples around a snapped
+     * boundary are read, through the manager's range reader.
      *
-     * @param buffer Pointer to the audio buffer (may be nullptr)
+     * @param bufferManager Pointer to the buffer manager (may be nullptr)
      */
-    void setAudioBuffer(const juce::AudioBuffer<float>* buffer);
+    void setBufferManager(const AudioBufferManager* bufferManager);
 
     //==============================================================================
     // Region interaction callbacks
@@ -161,6 +164,12 @@ private:
      */
     double sampleToTime(int64_t sample) const;
 
+    /**
+     * Snaps a sample position to the nearest zero crossing on one channel,
+     * reading only the +/- searchRadius window from the buffer manager.
+     */
+    int64_t snapToZeroCrossing(int64_t sample, int channel, int searchRadius) const;
+
     /**
      * Finds the region at a given x-coordinate.
      *
@@ -232,8 +241,8 @@ private:
     double m_sampleRate;
     double m_totalDuration;
 
-    // Audio buffer (for zero-crossing snap, Phase 3.3)
-    const juce::AudioBuffer<float>* m_audioBuffer;  // Not owned, just referenced
+    // Audio source (for zero-crossing snap, Phase 3.3)
+    const AudioBufferManager* m_bufferManager;  // Not owned, just referenced
 
     // Interaction state
     int m_hoveredRegionIndex;
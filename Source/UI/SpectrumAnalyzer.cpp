@@ -55,12 +55,47 @@ namespace
     constexpr float SMOOTHING_FACTOR = 0.75f;
 }
 
+//==============================================================================
+class SpectrumAnalyzer::AnalysisThread : public juce::Thread
+{
+public:
+    explicit AnalysisThread(SpectrumAnalyzer& owner)
+        : juce::Thread("Spectrum Analysis"),
+          m_owner(owner)
+    {
+    }
+
+    ~AnalysisThread() override
+    {
+        stopThread(2000);
+    }
+
+    void run() override
+    {
+        // Paced at the display rate: smoothing and peak hold are tuned per frame
+        while (! threadShouldExit())
+        {
+            m_owner.runAnalysisPass();
+            wait(1000 / UPDATE_RATE_HZ);
+        }
+    }
+
+private:
+    SpectrumAnalyzer& m_owner;
+};
+
+//==============================================================================
 SpectrumAnalyzer::SpectrumAnalyzer()
     : m_currentFFTSize(FFTSize::SIZE_2048)
     , m_currentWindow(WindowFunction::HANN)
-    , m_fftOrder(11) // 2^11 = 2048
-    , m_fifoIndex(0)
-    , m_nextFFTBlockReady(false)
+    , m_resetPending(false)
+    , m_ringFifo(RING_SIZE)
+    , m_builtFFTSize(0)
+    , m_builtWindow(WindowFunction::HANN)
+    , m_historyWritePos(0)
+    , m_historyFilled(0)
+    , m_publishedSerial(0)
+    , m_displaySerial(0)
     , m_audioEngine(nullptr)
     , m_minFrequency(20.0f)
     , m_maxFrequency(20000.0f)
@@ -70,18 +105,18 @@ SpectrumAnalyzer::SpectrumAnalyzer()
     m_sampleRate.store(44100.0);
 
     // Initialize buffers
+    m_ring.fill(0.0f);
     m_fftData.fill(0.0f);
-    m_scopeData.fill(0.0f);
-    m_peakHold.fill(m_minDB);
-
-    for (int i = 0; i < MAX_FFT_SIZE; ++i)
-    {
-        m_peakHoldTime[i] = 0;
-    }
+    clearAnalysisState();
+    clearFrame(m_publishedFrame);
+    clearFrame(m_displayFrame);
 
-    // Create FFT and window
+    // Create FFT and window before the analysis thread starts using them
     updateFFTConfiguration();
 
+    m_analysisThread = std::make_unique<AnalysisThread>(*this);
+    m_analysisThread->startThread();
+
     // Start timer for UI updates (30fps)
     startTimer(1000 / UPDATE_RATE_HZ);
 }
@@ -89,6 +124,7 @@ SpectrumAnalyzer::SpectrumAnalyzer()
 SpectrumAnalyzer::~SpectrumAnalyzer()
 {
     stopTimer();
+    m_analysisThread.reset();
 }
 
 //==============================================================================
@@ -98,8 +134,9 @@ void SpectrumAnalyzer::setFFTSize(FFTSize size)
 {
     if (m_currentFFTSize != size)
     {
+        // The analysis thread rebuilds the FFT and clears its history on its
+        // next pass when it sees the new size
         m_currentFFTSize = size;
-        updateFFTConfiguration();
         reset();
     }
 }
@@ -109,23 +146,31 @@ void SpectrumAnalyzer::setWindowFunction(WindowFunction window)
     if (m_currentWindow != window)
     {
         m_currentWindow = window;
-        updateFFTConfiguration();
     }
 }
 
 void SpectrumAnalyzer::updateFFTConfiguration()
 {
-    // Calculate FFT order from size
-    int fftSize = static_cast<int>(m_currentFFTSize);
-    m_fftOrder = static_cast<int>(std::log2(fftSize));
+    const int fftSize = static_cast<int>(m_currentFFTSize.load());
+    const WindowFunction window = m_currentWindow.load();
+
+    if (fftSize == m_builtFFTSize && window == m_builtWindow && m_fft != nullptr)
+        return;
+
+    if (fftSize != m_builtFFTSize || m_fft == nullptr)
+    {
+        // Calculate FFT order from size
+        const int fftOrder = static_cast<int>(std::log2(fftSize));
+        m_fft = std::make_unique<juce::dsp::FFT>(fftOrder);
 
-    // Create new FFT object
-    m_fft = std::make_unique<juce::dsp::FFT>(m_fftOrder);
+        // Old samples are laid out for the old size
+        clearAnalysisState();
+    }
 
     // Create windowing function
     auto windowType = juce::dsp::WindowingFunction<float>::hann;
 
-    switch (m_currentWindow)
+    switch (window)
     {
         case WindowFunction::HANN:
             windowType = juce::dsp::WindowingFunction<float>::hann;
@@ -141,7 +186,9 @@ void SpectrumAnalyzer::updateFFTConfiguration()
             break;
     }
 
-    m_window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, windowType);
+    m_window = std::make_unique<juce::dsp::WindowingFunction<float>>(static_cast<size_t>(fftSize), windowType);
+    m_builtFFTSize = fftSize;
+    m_builtWindow = window;
 }
 
 //==============================================================================
@@ -149,50 +196,28 @@ void SpectrumAnalyzer::updateFFTConfiguration()
 
 void SpectrumAnalyzer::pushAudioData(const float* buffer, int numSamples)
 {
-    if (m_nextFFTBlockReady.load())
-    {
-        return; // Skip if previous FFT block hasn't been consumed yet
-    }
-
-    int fftSize = static_cast<int>(m_currentFFTSize);
-
-    // H2 FIX: this runs on the audio thread (fed from AudioEngine's
-    // audioDeviceIOCallbackWithContext). Never block the real-time thread on
-    // a lock contended by the message-thread processFFT() -- try-lock and
-    // simply skip this block on contention (matching the m_analyzerLock
-    // try-lock pattern one level up in AudioEngine.cpp).
-    const juce::SpinLock::ScopedTryLockType lock(m_fftLock);
-    if (!lock.isLocked())
-        return;
-
-    for (int i = 0; i < numSamples; ++i)
-    {
-        m_fftData[static_cast<size_t>(m_fifoIndex)] = buffer[i];
-        m_fifoIndex++;
-
-        if (m_fifoIndex == fftSize)
-        {
-            // We have enough samples for an FFT
-            m_fifoIndex = 0;
-            m_nextFFTBlockReady.store(true);
-            break;
-        }
-    }
+    // Runs on the audio thread (fed from AudioEngine's
+    // audioDeviceIOCallbackWithContext). The ring is single-producer /
+    // single-consumer, so this is a plain copy with no lock: if the analysis
+    // thread has fallen behind, whatever does not fit is dropped.
+    int start1, size1, start2, size2;
+    m_ringFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        std::copy(buffer, buffer + size1, m_ring.begin() + start1);
+    if (size2 > 0)
+        std::copy(buffer + size1, buffer + size1 + size2, m_ring.begin() + start2);
+
+    m_ringFifo.finishedWrite(size1 + size2);
 }
 
 void SpectrumAnalyzer::reset()
 {
-    m_fftData.fill(0.0f);
-    m_scopeData.fill(0.0f);
-    m_peakHold.fill(m_minDB);
-    m_fifoIndex = 0;
-    m_nextFFTBlockReady.store(false);
-
-    for (int i = 0; i < MAX_FFT_SIZE; ++i)
-    {
-        m_peakHoldTime[i] = 0;
-    }
+    // The analysis thread owns the history; ask it to clear, and blank the
+    // display now so the reset is visible immediately
+    m_resetPending.store(true);
 
+    clearFrame(m_displayFrame);
     repaint();
 }
 
@@ -215,17 +240,61 @@ void SpectrumAnalyzer::setAudioEngine(AudioEngine* audioEngine)
 
 void SpectrumAnalyzer::timerCallback()
 {
-    if (m_nextFFTBlockReady.load())
+    // Only copy out the newest published frame; all analysis happens on the
+    // analysis thread
     {
-        processFFT();
-        m_nextFFTBlockReady.store(false);
-        repaint();
+        const juce::SpinLock::ScopedLockType lock(m_frameLock);
+        if (m_publishedSerial == m_displaySerial)
+            return;
+
+        m_displayFrame = m_publishedFrame;
+        m_displaySerial = m_publishedSerial;
     }
 
-    // Update peak hold timers
-    bool needsRepaint = false;
-    int fftSize = static_cast<int>(m_currentFFTSize);
+    repaint();
+}
+
+//==============================================================================
+// Analysis Thread
+
+void SpectrumAnalyzer::runAnalysisPass()
+{
+    bool changed = false;
+
+    updateFFTConfiguration();
+    const int fftSize = m_builtFFTSize;
+
+    if (m_resetPending.exchange(false))
+    {
+        // Drop queued samples too: they belong to what was playing before
+        m_ringFifo.finishedRead(m_ringFifo.getNumReady());
+        clearAnalysisState();
+        changed = true;
+    }
+
+    // Drain everything the audio thread has queued
+    const int numReady = m_ringFifo.getNumReady();
+    if (numReady > 0)
+    {
+        int start1, size1, start2, size2;
+        m_ringFifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+        if (size1 > 0)
+            appendToHistory(m_ring.data() + start1, size1, fftSize);
+        if (size2 > 0)
+            appendToHistory(m_ring.data() + start2, size2, fftSize);
+
+        m_ringFifo.finishedRead(size1 + size2);
+
+        // Analyse once we have a full window of audio
+        if (m_historyFilled >= fftSize)
+        {
+            processFFT(fftSize);
+            changed = true;
+        }
+    }
 
+    // Update peak hold timers
     for (size_t i = 0; i < static_cast<size_t>(fftSize / 2); ++i)
     {
         if (m_peakHoldTime[i] > 0)
@@ -233,53 +302,92 @@ void SpectrumAnalyzer::timerCallback()
             m_peakHoldTime[i]--;
             if (m_peakHoldTime[i] == 0)
             {
-                m_peakHold[i] = m_minDB;
-                needsRepaint = true;
+                m_analysisFrame.peak[i] = m_minDB;
+                changed = true;
             }
         }
     }
 
-    if (needsRepaint)
+    if (changed)
+    {
+        m_analysisFrame.fftSize = fftSize;
+
+        const juce::SpinLock::ScopedLockType lock(m_frameLock);
+        m_publishedFrame = m_analysisFrame;
+        ++m_publishedSerial;
+    }
+}
+
+void SpectrumAnalyzer::appendToHistory(const float* samples, int numSamples, int fftSize)
+{
+    // Only the newest fftSize samples can contribute to the next frame
+    if (numSamples >= fftSize)
     {
-        repaint();
+        std::copy(samples + numSamples - fftSize, samples + numSamples, m_history.begin());
+        m_historyWritePos = 0;
+        m_historyFilled = fftSize;
+        return;
     }
+
+    const int firstPart = juce::jmin(numSamples, fftSize - m_historyWritePos);
+    std::copy(samples, samples + firstPart, m_history.begin() + m_historyWritePos);
+    std::copy(samples + firstPart, samples + numSamples, m_history.begin());
+
+    m_historyWritePos = (m_historyWritePos + numSamples) % fftSize;
+    m_historyFilled = juce::jmin(fftSize, m_historyFilled + numSamples);
 }
 
-void SpectrumAnalyzer::processFFT()
+void SpectrumAnalyzer::clearAnalysisState()
 {
-    int fftSize = static_cast<int>(m_currentFFTSize);
+    m_history.fill(0.0f);
+    m_historyWritePos = 0;
+    m_historyFilled = 0;
+    clearFrame(m_analysisFrame);
 
-    // Copy FFT data to local buffer (thread-safe)
-    std::array<float, MAX_FFT_SIZE * 2> localFFTData;
+    for (int i = 0; i < MAX_BINS; ++i)
     {
-        const juce::SpinLock::ScopedLockType lock(m_fftLock);
-        std::copy(m_fftData.begin(), m_fftData.begin() + fftSize, localFFTData.begin());
+        m_peakHoldTime[i] = 0;
     }
+}
+
+void SpectrumAnalyzer::clearFrame(Frame& frame) const
+{
+    frame.fftSize = 0;
+    frame.scope.fill(m_minDB);
+    frame.peak.fill(m_minDB);
+}
+
+void SpectrumAnalyzer::processFFT(int fftSize)
+{
+    // Unroll the circular history into chronological order
+    const auto oldestPart = static_cast<size_t>(fftSize - m_historyWritePos);
+    std::copy(m_history.begin() + m_historyWritePos, m_history.begin() + fftSize, m_fftData.begin());
+    std::copy(m_history.begin(), m_history.begin() + m_historyWritePos, m_fftData.begin() + static_cast<std::ptrdiff_t>(oldestPart));
 
     // Apply windowing function
-    m_window->multiplyWithWindowingTable(localFFTData.data(), static_cast<size_t>(fftSize));
+    m_window->multiplyWithWindowingTable(m_fftData.data(), static_cast<size_t>(fftSize));
 
     // Perform FFT
-    m_fft->performFrequencyOnlyForwardTransform(localFFTData.data());
+    m_fft->performFrequencyOnlyForwardTransform(m_fftData.data());
 
     // Convert to dB and update scope data with smoothing
     for (size_t i = 0; i < static_cast<size_t>(fftSize / 2); ++i)
     {
         // Calculate magnitude in dB with proper normalization
         // Normalize by FFT size and apply empirically-determined display scale
-        float magnitude = localFFTData[i] / (float)fftSize;
+        float magnitude = m_fftData[i] / (float)fftSize;
         magnitude *= FFT_DISPLAY_SCALE;
 
         float dB = magnitude > 0.0001f ? juce::Decibels::gainToDecibels(magnitude) : m_minDB;
         dB = juce::jlimit(m_minDB, m_maxDB, dB);
 
         // Apply exponential smoothing for professional animation
-        m_scopeData[i] = m_scopeData[i] * SMOOTHING_FACTOR + dB * (1.0f - SMOOTHING_FACTOR);
+        m_analysisFrame.scope[i] = m_analysisFrame.scope[i] * SMOOTHING_FACTOR + dB * (1.0f - SMOOTHING_FACTOR);
 
         // Update peak hold
-        if (dB > m_peakHold[i])
+        if (dB > m_analysisFrame.peak[i])
         {
-            m_peakHold[i] = dB;
+            m_analysisFrame.peak[i] = dB;
             m_peakHoldTime[i] = (PEAK_HOLD_TIME_MS * UPDATE_RATE_HZ) / 1000;
         }
     }
@@ -499,7 +607,11 @@ void SpectrumAnalyzer::drawMagnitudeAxis(juce::Graphics& g, juce::Rectangle<floa
 
 void SpectrumAnalyzer::drawSpectrum(juce::Graphics& g, juce::Rectangle<float> bounds)
 {
-    int fftSize = static_cast<int>(m_currentFFTSize);
+    // Bin layout follows the frame, which may predate an FFT size change
+    int fftSize = m_displayFrame.fftSize;
+    if (fftSize <= 0)
+        return;
+
     double sampleRate = m_sampleRate.load();
     float binWidth = static_cast<float>(sampleRate / fftSize);
 
@@ -517,7 +629,7 @@ void SpectrumAnalyzer::drawSpectrum(juce::Graphics& g, juce::Rectangle<float> bo
             break;
 
         float x = frequencyToX(frequency, bounds);
-        float dB = m_scopeData[i];
+        float dB = m_displayFrame.scope[i];
         float y = dBToY(dB, bounds);
 
         if (!pathStarted)
@@ -563,10 +675,11 @@ void SpectrumAnalyzer::drawSpectrum(juce::Graphics& g, juce::Rectangle<float> bo
         if (frequency > m_maxFrequency)
             break;
 
-        if (m_peakHoldTime[i] > 0)
+        // Peaks that are not held sit at m_minDB
+        if (m_displayFrame.peak[i] > m_minDB)
         {
             float x = frequencyToX(frequency, bounds);
-            float dB = m_peakHold[i];
+            float dB = m_displayFrame.peak[i];
             float y = dBToY(dB, bounds);
 
             g.drawHorizontalLine(static_cast<int>(y), x - 1.0f, x + 1.0f);
@@ -33,7 +33,15 @@ class AudioEngine;
  * - Multiple windowing functions (Hann, Hamming, Blackman, Rectangular)
  * - Logarithmic frequency scale for natural perception
  * - Peak hold visualization
- * - Thread-safe audio data transfer (audio thread → UI thread)
+ * - Lock-free audio data transfer (audio thread → analysis thread → UI thread)
+ *
+ * Threading:
+ * - The audio thread only copies samples into a single-producer/single-consumer
+ *   ring (pushAudioData never locks or allocates)
+ * - A dedicated analysis thread drains the ring at the display rate, then
+ *   windows, transforms, smooths and peak-holds the newest FFT-sized window
+ * - The message thread only copies the latest published frame and paints, so
+ *   even 8192-point FFTs never run on it
  *
  * Design Philosophy:
  * - Inspired by professional tools (Sound Forge, Adobe Audition, iZotope RX)
@@ -88,21 +96,22 @@ public:
      *
      * @return Current FFT size
      */
-    FFTSize getFFTSize() const { return m_currentFFTSize; }
+    FFTSize getFFTSize() const { return m_currentFFTSize.load(); }
 
     /**
      * Gets the current windowing function.
      *
      * @return Current window function
      */
-    WindowFunction getWindowFunction() const { return m_currentWindow; }
+    WindowFunction getWindowFunction() const { return m_currentWindow.load(); }
 
     //==============================================================================
     // Audio Data Input (called from audio thread)
 
     /**
-     * Pushes audio samples for FFT analysis (thread-safe).
-     * Called from audio thread during playback.
+     * Pushes audio samples for FFT analysis (lock-free, wait-free).
+     * Called from audio thread during playback. Samples that do not fit in
+     * the ring (analysis thread stalled) are dropped.
      *
      * @param buffer Audio buffer containing samples
      * @param numSamples Number of samples in buffer
@@ -111,6 +120,8 @@ public:
 
     /**
      * Resets the spectrum analyzer to zero state.
+     * The display clears immediately; the analysis thread discards its
+     * history and any queued samples on its next pass.
      */
     void reset();
 
@@ -136,22 +147,52 @@ private:
 
     static constexpr int MAX_FFT_SIZE = 8192;
     static constexpr int MAX_FFT_SIZE_ORDER = 13; // 2^13 = 8192
+    static constexpr int MAX_BINS = MAX_FFT_SIZE / 2;
+    static constexpr int RING_SIZE = MAX_FFT_SIZE * 4; // ~170ms at 192kHz between analysis passes
+
+    /** One published analysis result: smoothed magnitudes and held peaks in dB. */
+    struct Frame
+    {
+        int fftSize = 0;                           // Size the frame was computed with (0 = empty)
+        std::array<float, MAX_BINS> scope;         // Smoothed magnitude per bin
+        std::array<float, MAX_BINS> peak;          // Held peak per bin (m_minDB when not held)
+    };
+
+    class AnalysisThread;
 
-    FFTSize m_currentFFTSize;
-    WindowFunction m_currentWindow;
-    int m_fftOrder;
+    // Settings written by the message thread, picked up by the analysis thread
+    std::atomic<FFTSize> m_currentFFTSize;
+    std::atomic<WindowFunction> m_currentWindow;
+    std::atomic<bool> m_resetPending;
 
+    // Audio thread -> analysis thread (single producer, single consumer)
+    juce::AbstractFifo m_ringFifo;
+    std::array<float, RING_SIZE> m_ring;
+
+    // Analysis thread state (touched only by the analysis thread)
+    int m_builtFFTSize;
+    WindowFunction m_builtWindow;
     std::unique_ptr<juce::dsp::FFT> m_fft;
     std::unique_ptr<juce::dsp::WindowingFunction<float>> m_window;
 
-    // FFT input/output buffers (protected by spin lock for thread safety)
+    std::array<float, MAX_FFT_SIZE> m_history;     // Newest fftSize samples, circular
+    int m_historyWritePos;
+    int m_historyFilled;
     std::array<float, MAX_FFT_SIZE * 2> m_fftData; // Input data (time domain) + output (frequency domain)
-    std::array<float, MAX_FFT_SIZE> m_scopeData;   // Visualisation data for UI thread
-    std::array<float, MAX_FFT_SIZE> m_peakHold;    // Peak hold values
+    Frame m_analysisFrame;                         // Frame being updated
+    int m_peakHoldTime[MAX_BINS];                  // Peak hold timer per frequency bin (analysis ticks)
+
+    // Analysis thread -> message thread. The lock is only ever taken by these
+    // two threads, for one frame copy; the audio thread never touches it.
+    juce::SpinLock m_frameLock;
+    Frame m_publishedFrame;
+    uint32_t m_publishedSerial;                    // Bumped on every publish (guarded by m_frameLock)
 
-    int m_fifoIndex;                               // Current write position in FIFO
-    std::atomic<bool> m_nextFFTBlockReady;        // Flag for new FFT data ready
-    juce::SpinLock m_fftLock;                     // Protects m_fftData during audio thread writes
+    // Message thread copy used for painting
+    Frame m_displayFrame;
+    uint32_t m_displaySerial;
+
+    std::unique_ptr<AnalysisThread> m_analysisThread;
 
     // Audio source (not owned)
     AudioEngine* m_audioEngine;
@@ -164,7 +205,6 @@ private:
     float m_minDB;          // Minimum dB level (default: -80 dB)
     float m_maxDB;          // Maximum dB level (default: 0 dB)
 
-    int m_peakHoldTime[MAX_FFT_SIZE];  // Peak hold timer per frequency bin
     static constexpr int PEAK_HOLD_TIME_MS = 1500;
     static constexpr int UPDATE_RATE_HZ = 30;
 
@@ -175,19 +215,37 @@ private:
     // Helper Methods
 
     /**
-     * Updates the FFT with new configuration (size, window function).
+     * Rebuilds the FFT and window if the requested size or window function
+     * changed. Analysis thread only.
      */
     void updateFFTConfiguration();
 
     /**
-     * Applies the selected window function to the time-domain data.
+     * One analysis pass: applies pending resets and configuration changes,
+     * drains the ring, runs the FFT on the newest window, ages the peak
+     * holds and publishes the frame. Analysis thread only.
+     */
+    void runAnalysisPass();
+
+    /**
+     * Appends samples to the circular history, keeping the newest fftSize.
+     */
+    void appendToHistory(const float* samples, int numSamples, int fftSize);
+
+    /**
+     * Clears the history, smoothing and peak hold state. Analysis thread only.
+     */
+    void clearAnalysisState();
+
+    /**
+     * Processes the FFT on the history and updates m_analysisFrame.
      */
-    void applyWindow();
+    void processFFT(int fftSize);
 
     /**
-     * Processes the FFT and updates visualization data.
+     * Fills a frame with the empty (silent) state.
      */
-    void processFFT();
+    void clearFrame(Frame& frame) const;
 
     /**
      * Converts frequency to X position on screen (logarithmic scale).
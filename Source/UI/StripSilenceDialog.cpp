@@ -20,10 +20,10 @@
 namespace ui = waveedit::ui;
 
 StripSilenceDialog::StripSilenceDialog(RegionManager& regionManager,
-                                       const juce::AudioBuffer<float>& audioBuffer,
+                                       juce::AudioBuffer<float> audioBuffer,
                                        double sampleRate)
     : m_regionManager(regionManager)
-    , m_audioBuffer(audioBuffer)
+    , m_audioBuffer(std::move(audioBuffer))
     , m_sampleRate(sampleRate)
     , m_isPreviewMode(false)
 {
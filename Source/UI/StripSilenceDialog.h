@@ -46,11 +46,11 @@ public:
      * Creates a Auto Region dialog.
      *
      * @param regionManager RegionManager to populate with auto-created regions
-     * @param audioBuffer Audio buffer to analyze
+     * @param audioBuffer Audio to analyze; the dialog keeps its own copy
      * @param sampleRate Sample rate for time calculations
      */
     StripSilenceDialog(RegionManager& regionManager,
-                       const juce::AudioBuffer<float>& audioBuffer,
+                       juce::AudioBuffer<float> audioBuffer,
                        double sampleRate);
 
     ~StripSilenceDialog() override;
@@ -273,7 +273,7 @@ private:
     // State
 
     RegionManager& m_regionManager;
-    const juce::AudioBuffer<float>& m_audioBuffer;
+    juce::AudioBuffer<float> m_audioBuffer;
     double m_sampleRate;
 
     bool m_isPreviewMode;
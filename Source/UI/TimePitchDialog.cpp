@@ -16,6 +16,7 @@
 #include "TimePitchDialog.h"
 #include "../DSP/TimePitchEngine.h"
 #include "../Audio/AudioEngine.h"
+#include "../Audio/AudioBufferManager.h"
 #include "ThemeManager.h"
 #include "UIConstants.h"
 
@@ -23,12 +24,26 @@
 
 namespace ui = waveedit::ui;
 
+namespace
+{
+    /** The recipe a slider value means in this mode. */
+    TimePitchEngine::Recipe makeRecipe(TimePitchDialog::Mode mode, double value)
+    {
+        TimePitchEngine::Recipe recipe;
+        if (mode == TimePitchDialog::Mode::TimeStretch)
+            recipe.tempoPercent = value;
+        else
+            recipe.pitchSemitones = value;
+        return recipe;
+    }
+}
+
 //==============================================================================
 // Construction
 //==============================================================================
 
 TimePitchDialog::TimePitchDialog(Mode mode,
-                                 const juce::AudioBuffer<float>& audioBuffer,
+                                 const AudioBufferManager& bufferManager,
                                  double sampleRate,
                                  bool hasSelection,
                                  double selectionStartSeconds,
@@ -48,7 +63,7 @@ TimePitchDialog::TimePitchDialog(Mode mode,
     m_selectionEndSeconds   = selectionEndSeconds;
 
     if (sampleRate > 0.0)
-        m_fullDurationSeconds = (double) audioBuffer.getNumSamples() / sampleRate;
+        m_fullDurationSeconds = (double) bufferManager.getNumSamples() / sampleRate;
 
     // Apply is selection-scoped when a selection exists, so projections and the
     // target-duration entry describe the selected range (else the whole file).
@@ -57,20 +72,15 @@ TimePitchDialog::TimePitchDialog(Mode mode,
             ? (selectionEndSeconds - selectionStartSeconds)
             : m_fullDurationSeconds;
 
-    // Own a copy of the preview excerpt (not the live document buffer). Rendering
-    // the whole file through SoundTouch is slow, so we only render this excerpt.
-    const auto range = computePreviewExcerpt(audioBuffer.getNumSamples(), sampleRate,
+    // Own a copy of the preview excerpt (not the live document buffer), so the
+    // streaming preview never reads audio an edit could replace under it.
+    // Only the excerpt is read, so the rest of the document is never flattened.
+    const auto range = computePreviewExcerpt(bufferManager.getNumSamples(), sampleRate,
                                              hasSelection, selectionStartSeconds,
                                              selectionEndSeconds, cursorSeconds);
     m_excerptFileStartSeconds = (sampleRate > 0.0) ? (range.getStart() / sampleRate) : 0.0;
-    const int excerptLen = (int) juce::jmax((juce::int64) 0, range.getLength());
-    if (excerptLen > 0 && audioBuffer.getNumChannels() > 0)
-    {
-        m_originalExcerpt.setSize(audioBuffer.getNumChannels(), excerptLen);
-        for (int ch = 0; ch < audioBuffer.getNumChannels(); ++ch)
-            m_originalExcerpt.copyFrom(ch, 0, audioBuffer, ch,
-                                       (int) range.getStart(), excerptLen);
-    }
+    if (range.getLength() > 0 && bufferManager.getNumChannels() > 0)
+        m_originalExcerpt = bufferManager.getAudioRange(range.getStart(), range.getLength());
 
     //--------------------------------------------------------------------------
     // Help line -- wording mirrors the previous AlertWindow prompts.
@@ -187,7 +197,7 @@ TimePitchDialog::TimePitchDialog(Mode mode,
             m_bypassButton.removeColour(juce::TextButton::textColourOffId);
         }
 
-        reloadActiveBuffer();   // startBufferPreview restarts playback itself
+        updatePreviewRecipe();   // A/B switch without restarting playback
     };
     addAndMakeVisible(m_bypassButton);
 
@@ -245,7 +255,6 @@ TimePitchDialog::~TimePitchDialog()
     waveedit::ThemeManager::getInstance().removeChangeListener(this);
 
     // Safety net for every close path: never leave the engine in preview mode.
-    stopTimer();
     stopPreview();
 }
 
@@ -317,44 +326,37 @@ bool TimePitchDialog::engineUsable() const noexcept
     return m_audioEngine != nullptr && m_documentLifeline.getComponent() != nullptr;
 }
 
-void TimePitchDialog::renderProcessed()
+bool TimePitchDialog::reloadActiveBuffer()
 {
+    if (! engineUsable() || ! m_previewActive)
+        return false;
+
     try
     {
-        TimePitchEngine::Recipe recipe;
-        if (m_mode == Mode::TimeStretch)
-            recipe.tempoPercent = m_paramSlider.getValue();
-        else
-            recipe.pitchSemitones = m_paramSlider.getValue();
-
-        if (TimePitchEngine::isIdentity(recipe))
-            m_processedBuffer.makeCopyOf(m_originalExcerpt);   // preview original
-        else
-            m_processedBuffer =
-                TimePitchEngine::apply(m_originalExcerpt, m_sampleRate, recipe);
+        const auto recipe = m_bypassActive ? TimePitchEngine::Recipe{}
+                                           : makeRecipe(m_mode, m_paramSlider.getValue());
+        return m_audioEngine->startTimePitchPreview(m_originalExcerpt, m_sampleRate,
+                                                    m_originalExcerpt.getNumChannels(),
+                                                    m_loopToggle.getToggleState(),
+                                                    m_excerptFileStartSeconds, recipe);
     }
     catch (const std::exception& e)
     {
-        juce::Logger::writeToLog("TimePitchDialog::renderProcessed - "
+        juce::Logger::writeToLog("TimePitchDialog::reloadActiveBuffer - "
                                  + juce::String(e.what()));
         m_summaryLabel.setText("Preview failed: " + juce::String(e.what()),
                                juce::dontSendNotification);
-        m_processedBuffer.setSize(0, 0);
+        return false;
     }
-
-    m_processedPlayable = previewIsPlayable(m_processedBuffer.getNumSamples(),
-                                            m_processedBuffer.getNumChannels());
 }
 
-bool TimePitchDialog::reloadActiveBuffer()
+void TimePitchDialog::updatePreviewRecipe()
 {
     if (! engineUsable() || ! m_previewActive)
-        return false;
+        return;
 
-    const auto& buf = m_bypassActive ? m_originalExcerpt : m_processedBuffer;
-    return m_audioEngine->startBufferPreview(buf, m_sampleRate, buf.getNumChannels(),
-                                             m_loopToggle.getToggleState(),
-                                             m_excerptFileStartSeconds);
+    m_audioEngine->setTimePitchPreview(m_bypassActive ? TimePitchEngine::Recipe{}
+                                                      : makeRecipe(m_mode, m_paramSlider.getValue()));
 }
 
 void TimePitchDialog::startPreview()
@@ -370,14 +372,6 @@ void TimePitchDialog::startPreview()
         return;
     }
 
-    renderProcessed();
-    if (! m_processedPlayable)
-    {
-        m_summaryLabel.setText("Result is empty - nothing to preview.",
-                               juce::dontSendNotification);
-        return;
-    }
-
     m_previewActive = true;
     m_bypassActive  = false;
     if (! reloadActiveBuffer())
@@ -396,7 +390,6 @@ void TimePitchDialog::stopPreview()
 {
     if (engineUsable())
         m_audioEngine->stopSelectionPreview();
-    stopTimer();
 
     m_previewActive = false;
     m_bypassActive  = false;
@@ -408,30 +401,6 @@ void TimePitchDialog::stopPreview()
     m_bypassButton.setEnabled(false);
 }
 
-void TimePitchDialog::timerCallback()
-{
-    stopTimer();
-    if (! m_previewActive)
-        return;
-
-    if (! engineUsable())   // document closed while a re-render was pending
-    {
-        stopPreview();
-        return;
-    }
-
-    renderProcessed();
-    if (! m_processedPlayable)
-    {
-        m_summaryLabel.setText("Result is empty - nothing to preview.",
-                               juce::dontSendNotification);
-        stopPreview();
-        return;
-    }
-
-    reloadActiveBuffer();   // startBufferPreview restarts playback itself
-}
-
 //==============================================================================
 // UI helpers
 //==============================================================================
@@ -474,9 +443,9 @@ void TimePitchDialog::updateSummary()
             juce::dontSendNotification);
     }
 
-    // Debounced preview re-render: a single hook covers the slider.
+    // Live preview: a single hook covers the slider and the target duration.
     if (m_previewActive)
-        startTimer(kPreviewDebounceMs);
+        updatePreviewRecipe();
 }
 
 void TimePitchDialog::updateScopeLabel()
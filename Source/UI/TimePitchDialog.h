@@ -19,27 +19,27 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 
 class AudioEngine; // full include in the .cpp (preview playback)
+class AudioBufferManager;
 
 /**
  * Shared Time-Stretch / Pitch-Shift processing dialog.
  *
  * A single dialog class serves both the Time Stretch and Pitch Shift commands
  * via the Mode enum. It follows the CLAUDE.md Sec 6.8 processing-dialog footer
- * (Preview / Bypass / Loop | Cancel / Apply) and mirrors HeadTailDialog's
- * offline-render preview architecture.
+ * (Preview / Bypass / Loop | Cancel / Apply).
  *
- * The dialog is pure UI: it renders a short SoundTouch preview of an excerpt of
- * the source audio and calls onApply(value) when the user applies. All buffer
- * replacement, range validation, the identity short-circuit, and undo
- * registration live in DSPController.
+ * The dialog is pure UI: it streams an excerpt of the source audio through
+ * SoundTouch in the audio callback (AudioEngine::startTimePitchPreview) and
+ * calls onApply(value) when the user applies. Nothing is rendered up front:
+ * slider moves and Bypass are pushed to the running preview and heard from the
+ * next audio block. All buffer replacement, range validation, the identity
+ * short-circuit, and undo registration live in DSPController.
  *
- * Preview excerpt: full-buffer SoundTouch rendering can be slow on long files,
- * so the preview renders from up to kPreviewSeconds of source audio starting at
- * the selection start (if any), else the edit cursor, else 0 -- clamped to the
- * buffer bounds. See computePreviewExcerpt().
+ * Preview excerpt: the preview plays an owned copy of up to kPreviewSeconds of
+ * source audio starting at the selection start (if any), else the edit cursor,
+ * else 0 -- clamped to the buffer bounds. See computePreviewExcerpt().
  */
 class TimePitchDialog : public juce::Component,
-                        private juce::Timer,
                         private juce::ChangeListener
 {
 public:
@@ -54,7 +54,7 @@ public:
      * Creates the Time-Stretch / Pitch-Shift dialog.
      *
      * @param mode                  TimeStretch or PitchShift.
-     * @param audioBuffer           Full source audio buffer (not modified).
+     * @param bufferManager         Source document; only the preview excerpt is read.
      * @param sampleRate            Sample rate for time calculations.
      * @param hasSelection          True if the document has an active selection.
      * @param selectionStartSeconds Selection start in seconds (used when
@@ -71,7 +71,7 @@ public:
      *                              lifeline for the async dialog.
      */
     TimePitchDialog(Mode mode,
-                    const juce::AudioBuffer<float>& audioBuffer,
+                    const AudioBufferManager& bufferManager,
                     double sampleRate,
                     bool hasSelection,
                     double selectionStartSeconds,
@@ -120,12 +120,13 @@ public:
                                                           double selectionEndSeconds,
                                                           double cursorSeconds) noexcept;
 
-    /** True if a rendered preview buffer with this shape can be played. Pure +
+    /** True if a preview excerpt with this shape can be played. Pure +
         static so it is unit-testable. */
     static bool previewIsPlayable(int numSamples, int numChannels) noexcept;
 
-    /** Maximum preview excerpt length in seconds. */
-    static constexpr double kPreviewSeconds = 10.0;
+    /** Maximum preview excerpt length in seconds. Bounds the excerpt copy only;
+        streaming makes preview latency independent of it. */
+    static constexpr double kPreviewSeconds = 60.0;
 
 private:
     //==========================================================================
@@ -164,30 +165,25 @@ private:
     double m_processDurationSeconds = 0.0;  // Selection duration, else whole file
 
     //==========================================================================
-    // Audio preview (Sec 6.8) -- offline-render the recipe on an excerpt.
+    // Audio preview (Sec 6.8) -- stream the recipe over an excerpt.
 
     AudioEngine*             m_audioEngine = nullptr;
     juce::Component::SafePointer<juce::Component> m_documentLifeline;
-    juce::AudioBuffer<float> m_originalExcerpt;   // owned excerpt copy (A/B, lifetime)
-    juce::AudioBuffer<float> m_processedBuffer;   // last offline render
-    bool m_processedPlayable = false;
+    juce::AudioBuffer<float> m_originalExcerpt;   // owned excerpt copy (lifetime)
     bool m_previewActive     = false;
     bool m_bypassActive      = false;
 
-    static constexpr int kPreviewDebounceMs = 200;
-
     /** True only when the engine pointer is set AND its document is still alive. */
     bool engineUsable() const noexcept;
-    /** Recompute and render the offline preview buffer from the current value. */
-    void renderProcessed();
-    /** Begin audio preview (render + load + loop + play). No-op if not playable. */
+    /** Begin audio preview (load + loop + play). No-op if not playable. */
     void startPreview();
     /** Stop audio preview and restore the engine to normal. Idempotent + UAF-safe. */
     void stopPreview();
-    /** (Re)load the active (processed or bypassed) excerpt and start playback.
-        Returns false if the buffer was empty. */
+    /** (Re)start streaming the excerpt with the active (processed or bypassed)
+        recipe. Returns false if it could not be started. */
     bool reloadActiveBuffer();
-    void timerCallback() override;
+    /** Push the active recipe to the running preview (heard next block). */
+    void updatePreviewRecipe();
 
     /** Re-applies cached theme colours when the active theme changes (Sec 6.11). */
     void changeListenerCallback(juce::ChangeBroadcaster* source) override;
@@ -25,19 +25,89 @@
 #include "../Utils/RegionManager.h"
 #include "../Utils/Region.h"
 #include "../Utils/Settings.h"
-#include "../Utils/ThumbnailDiskCache.h"
+#include "../Utils/PeakFileCache.h"
 #include "ThemeManager.h"
 #include "../Audio/ChannelLayout.h"
 #include <cmath>
+#include <limits>
 #include <juce_gui_extra/juce_gui_extra.h>
 
+//==============================================================================
+class WaveformDisplay::PeakScanThread : public juce::Thread
+{
+public:
+    PeakScanThread(WaveformDisplay& owner, const juce::File& file,
+                   std::unique_ptr<juce::AudioFormatReader> reader)
+        : juce::Thread("Waveform Peak Scan"),
+          m_owner(owner),
+          m_file(file),
+          m_reader(std::move(reader))
+    {
+    }
+
+    ~PeakScanThread() override
+    {
+        // Checked between blocks, so this waits at most one block's read.
+        stopThread(10000);
+    }
+
+    void run() override
+    {
+        const int numChannels = static_cast<int>(m_reader->numChannels);
+        const int64_t totalSamples = m_reader->lengthInSamples;
+        juce::AudioBuffer<float> block(numChannels, kBlockSamples);
+
+        for (int64_t position = 0; position < totalSamples && ! threadShouldExit();)
+        {
+            const int numSamples = static_cast<int>(juce::jmin<int64_t>(kBlockSamples, totalSamples - position));
+            if (! m_reader->read(&block, 0, numSamples, position, true, true))
+            {
+                juce::Logger::writeToLog("WaveformDisplay: Peak scan read failed at sample " + juce::String(position));
+                break;
+            }
+
+            // Peaks are cheap next to the read, so computing them under the
+            // lock holds up a paint by well under a millisecond.
+            juce::AudioBuffer<float> view(block.getArrayOfWritePointers(), numChannels, numSamples);
+            {
+                juce::ScopedLock lock(m_owner.m_bufferLock);
+                m_owner.m_peaks.addBlock(position, view);
+            }
+
+            m_owner.m_tileCache.invalidateSamples(position, position + numSamples);
+            m_owner.m_peaksChanged.store(true);
+            position += numSamples;
+        }
+
+        // A complete scan goes into the peak file cache, so the next open
+        // of this file skips it. writeTo() refuses incomplete peaks.
+        if (! threadShouldExit())
+        {
+            juce::MemoryBlock serialised;
+            {
+                juce::MemoryOutputStream out(serialised, false);
+                juce::ScopedLock lock(m_owner.m_bufferLock);
+                if (! m_owner.m_peaks.writeTo(out))
+                    serialised.reset();
+            }
+
+            PeakFileCache::saveAsync(m_file, std::move(serialised));
+        }
+    }
+
+private:
+    static constexpr int kBlockSamples = 1 << 18;
+
+    WaveformDisplay& m_owner;
+    const juce::File m_file;
+    std::unique_ptr<juce::AudioFormatReader> m_reader;
+};
+
 //==============================================================================
 WaveformDisplay::WaveformDisplay(juce::AudioFormatManager& formatManager)
-    : m_thumbnailCache(5),
-      m_thumbnail(512, formatManager, m_thumbnailCache),
+    : m_formatManager(formatManager),
       m_scrollbar(false),
       m_fileLoaded(false),
-      m_isLoading(false),
       m_numChannels(0),
       m_sampleRate(44100.0),
       m_totalDuration(0.0),
@@ -69,12 +139,8 @@ WaveformDisplay::WaveformDisplay(juce::AudioFormatManager& formatManager)
       m_lastSnapIncrementIndex(1),  // Remember first increment (10ms default)
       m_zeroCrossingEnabled(false),
       m_audioBufferRef(nullptr),
-      m_useDirectRendering(false),
       m_regionManager(nullptr)
 {
-    // Set up thumbnail
-    m_thumbnail.addChangeListener(this);
-
     // Subscribe to theme switches so we re-skin live without a restart.
     waveedit::ThemeManager::getInstance().addChangeListener(this);
 
@@ -93,7 +159,7 @@ WaveformDisplay::WaveformDisplay(juce::AudioFormatManager& formatManager)
 WaveformDisplay::~WaveformDisplay()
 {
     stopTimer();
-    m_thumbnail.removeChangeListener(this);
+    m_peakScan.reset();
     waveedit::ThemeManager::getInstance().removeChangeListener(this);
     m_scrollbar.removeListener(this);
 }
@@ -116,55 +182,233 @@ bool WaveformDisplay::loadFile(const juce::File& file, double sampleRate, int nu
         return false;
     }
 
+    std::unique_ptr<juce::AudioFormatReader> reader(m_formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0
+        || static_cast<int>(reader->numChannels) != numChannels)
+    {
+        m_lastError = "Cannot read audio file: " + file.getFileName();
+        return false;
+    }
+
+    // The length comes from the header, so the timeline can be shown
+    // straight away; the waveform fills in as the scan gets through it.
+    beginProgressiveLoad(file, sampleRate, numChannels, reader->lengthInSamples);
+    m_loadProgress = -1.0;
+
+    if (! m_peaksFromCache)
+    {
+        m_peakScan = std::make_unique<PeakScanThread>(*this, file, std::move(reader));
+        m_peakScan->startThread();
+    }
+
+    return true;
+}
+
+void WaveformDisplay::beginProgressiveLoad(const juce::File& file, double sampleRate,
+                                           int numChannels, int64_t totalSamples)
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+
     clear();
 
-    // Store audio properties
     m_sampleRate = sampleRate;
     m_numChannels = numChannels;
-
-    // Bookkeeping for the disk cache.
+    m_totalDuration = sampleRate > 0.0 ? totalSamples / sampleRate : 0.0;
     m_loadedFile = file;
-    m_thumbnailFromCache = false;
-    m_thumbnailCacheSaved = false;
-    m_isLoading = true;
 
-    // Try to populate the thumbnail from the on-disk cache. If the
-    // load succeeds, AudioThumbnail::loadFrom() fires its change
-    // message and our changeListenerCallback finishes the rest of
-    // the setup — no audio decoding required.
-    if (ThumbnailDiskCache::tryLoad(file, m_thumbnail))
+    // Cached peaks show the whole file immediately; otherwise they are fed
+    // block by block from the decoder.
     {
-        m_thumbnailFromCache = true;
-        repaint();
-        return true;
+        juce::ScopedLock lock(m_bufferLock);
+        m_peaksFromCache = PeakFileCache::tryMap(file, numChannels, totalSamples, m_peaks,
+            [safeThis = juce::Component::SafePointer<WaveformDisplay>(this), file]
+            {
+                if (safeThis != nullptr)
+                    safeThis->rescanStalePeaks(file);
+            });
+        if (! m_peaksFromCache)
+            m_peaks.reset(numChannels, totalSamples);
+
+        // The decoder's samples only reach the display once the load is
+        // done; the spectrogram reads the file itself until then.
+        m_spectrogramSourceFile = file;
     }
 
-    // Cache miss: kick off the normal async generation. AudioThumbnail
-    // takes ownership of the source.
-    auto source = std::make_unique<juce::FileInputSource>(file);
-    m_thumbnail.setSource(source.release());
+    resetSpectrogram(numChannels, totalSamples);
+
+    // The timeline is known up front, so show it (and allow playback and
+    // navigation) right away.
+    m_fileLoaded = true;
+    m_loadProgress = 0.0;
+
+    m_visibleStart = 0.0;
+    m_visibleEnd = m_totalDuration;
+    m_zoomLevel = 1.0;
+    m_playbackPosition = 0.0;
+    updateScrollbar();
+
+    if (onVisibleRangeChanged)
+        onVisibleRangeChanged(m_visibleStart, m_visibleEnd);
 
-    // The thumbnail will call changeListenerCallback when data is ready
     repaint();
-    return true;
+}
+
+void WaveformDisplay::addLoadedBlock(int64_t startSample, const juce::AudioBuffer<float>& block)
+{
+    if (m_peaksFromCache)
+        return;
+
+    {
+        juce::ScopedLock lock(m_bufferLock);
+        m_peaks.addBlock(startSample, block);
+    }
+
+    repaintSampleRange(startSample, startSample + block.getNumSamples());
+}
+
+void WaveformDisplay::savePeakFile(const juce::File& audioFile)
+{
+    // The file now holds the displayed audio, so the spectrogram can read
+    // it again once the samples are released.
+    {
+        juce::ScopedLock lock(m_bufferLock);
+        m_spectrogramSourceFile = audioFile;
+    }
+
+    if (! (m_spectrogramSaved && audioFile == m_loadedFile))
+        saveSpectrogramFile(audioFile);
+
+    if (m_peaksFromCache && audioFile == m_loadedFile)
+        return;
+
+    juce::MemoryBlock serialised;
+    {
+        juce::MemoryOutputStream out(serialised, false);
+        juce::ScopedLock lock(m_bufferLock);
+        if (! m_peaks.writeTo(out))
+            return;
+    }
+
+    PeakFileCache::saveAsync(audioFile, std::move(serialised));
+}
+
+void WaveformDisplay::saveSpectrogramFile(const juce::File& audioFile)
+{
+    juce::MemoryBlock serialised;
+    {
+        juce::MemoryOutputStream out(serialised, false);
+        if (! m_spectrogram.writeOverviewTo(out))
+            return;
+    }
+
+    m_spectrogramSaved = true;
+    PeakFileCache::saveAsync(audioFile, std::move(serialised), PeakFileCache::kSpectrogramExtension);
+}
+
+void WaveformDisplay::rescanStalePeaks(const juce::File& file)
+{
+    // Edited or reloaded peaks no longer come from the entry.
+    if (! m_peaksFromCache || file != m_loadedFile)
+        return;
+
+    std::unique_ptr<juce::AudioFormatReader> reader(m_formatManager.createReaderFor(file));
+    if (reader == nullptr || static_cast<int>(reader->numChannels) != m_numChannels)
+        return;
+
+    {
+        juce::ScopedLock lock(m_bufferLock);
+        m_peaks.reset(m_numChannels, reader->lengthInSamples);
+        m_peaksFromCache = false;
+    }
+
+    m_tileCache.invalidateAll();
+    invalidateBodyLayer();
+
+    m_peakScan = std::make_unique<PeakScanThread>(*this, file, std::move(reader));
+    m_peakScan->startThread();
+    repaint();
+}
+
+void WaveformDisplay::recomputeStaleSpectrogram(const juce::File& file)
+{
+    if (file != m_loadedFile || m_spectrogram.isEmpty())
+        return;
+
+    resetSpectrogram(m_numChannels, std::llround(m_totalDuration * m_sampleRate));
+    repaint();
+}
+
+void WaveformDisplay::setLoadProgress(double progress)
+{
+    m_loadProgress = progress;
+    repaint();
 }
 
 bool WaveformDisplay::reloadFromBuffer(const juce::AudioBuffer<float>& buffer,
                                        double sampleRate,
                                        bool preserveView,
-                                       bool preserveEditCursor)
+                                       bool preserveEditCursor,
+                                       bool sameAudio)
+{
+    // Validate buffer
+    if (buffer.getNumSamples() == 0 || buffer.getNumChannels() == 0)
+    {
+        m_lastError = "Cannot reload from empty buffer";
+        DBG("WaveformDisplay::reloadFromBuffer - Empty buffer");
+        return false;
+    }
+
+    // Deep copy: the caller keeps ownership of 'buffer'.
+    juce::AudioBuffer<float> copy;
+    copy.makeCopyOf(buffer);
+    return reloadFromSnapshotAt(AudioSnapshot::fromBuffer(std::move(copy), sampleRate),
+                                preserveView, preserveEditCursor, 0, sameAudio);
+}
+
+bool WaveformDisplay::reloadFromSnapshot(const AudioSnapshotPtr& snapshot,
+                                         bool preserveView,
+                                         bool preserveEditCursor,
+                                         bool sameAudio)
+{
+    if (snapshot == nullptr)
+    {
+        m_lastError = "Cannot reload from empty snapshot";
+        DBG("WaveformDisplay::reloadFromSnapshot - Null snapshot");
+        return false;
+    }
+
+    return reloadFromSnapshotAt(snapshot, preserveView, preserveEditCursor, 0, sameAudio);
+}
+
+PeakPyramid::SampleReader WaveformDisplay::makeSnapshotReader(const AudioSnapshot& snapshot)
+{
+    return [&snapshot](int channel, int64_t startSample, int numSamples, float* dest)
+    {
+        return snapshot.readChannelRange(channel, dest, startSample, numSamples);
+    };
+}
+
+bool WaveformDisplay::reloadFromSnapshotAt(AudioSnapshotPtr snapshot,
+                                           bool preserveView,
+                                           bool preserveEditCursor,
+                                           int64_t firstChangedSample,
+                                           bool sameAudio)
 {
     // IMPORTANT: Must be called from message thread only
     jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
 
-    // Validate buffer
-    if (buffer.getNumSamples() == 0 || buffer.getNumChannels() == 0)
+    // Validate audio
+    if (snapshot == nullptr
+        || snapshot->getNumSamples() == 0 || snapshot->getNumChannels() == 0)
     {
         m_lastError = "Cannot reload from empty buffer";
         DBG("WaveformDisplay::reloadFromBuffer - Empty buffer");
         return false;
     }
 
+    const auto& audio = *snapshot;
+    const double sampleRate = audio.getSampleRate();
+
     if (sampleRate <= 0.0)
     {
         m_lastError = "Invalid sample rate";
@@ -185,40 +429,61 @@ bool WaveformDisplay::reloadFromBuffer(const juce::AudioBuffer<float>& buffer,
         savedHasEditCursor ? "YES" : "NO", savedEditCursorPos,
         preserveView ? 1 : 0, preserveEditCursor ? 1 : 0));
 
+    const bool sameShape = audio.getNumChannels() == m_numChannels
+                           && audio.getNumSamples() == std::llround(m_totalDuration * m_sampleRate)
+                           && sampleRate == m_sampleRate;
+
     // Store audio properties
     m_sampleRate = sampleRate;
-    m_numChannels = buffer.getNumChannels();
-    m_totalDuration = buffer.getNumSamples() / sampleRate;
+    m_numChannels = audio.getNumChannels();
+    m_totalDuration = static_cast<double>(audio.getNumSamples()) / sampleRate;
+
+    // These samples supersede whatever a background scan is still reading.
+    m_peakScan.reset();
 
-    // PERFORMANCE OPTIMIZATION (2025-10-08):
-    // =======================================
-    // Cache buffer for fast direct rendering (<10ms visual feedback)
     {
         juce::ScopedLock lock(m_bufferLock);
 
-        // Make a deep copy of the buffer for direct rendering
-        m_cachedBuffer.setSize(buffer.getNumChannels(), buffer.getNumSamples(), false, false, false);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        // Share the snapshot (no copy). The previous one is released here;
+        // if this display was its last holder its chunks are freed.
+        m_cachedSnapshot = std::move(snapshot);
+
+        // The same samples the finished scan (or the peak file) described
+        // need no new peaks; attaching them for direct rendering is then
+        // free however long the file is. Otherwise only the peaks from the
+        // first changed sample on can differ (rebuildFrom() falls back to a
+        // full build when it must).
+        const bool peaksCurrent = sameAudio && sameShape
+                                  && m_peaks.getNumSamples() == audio.getNumSamples()
+                                  && m_peaks.getCoveredSamples() == audio.getNumSamples();
+        if (! peaksCurrent)
         {
-            m_cachedBuffer.copyFrom(ch, 0, buffer, ch, 0, buffer.getNumSamples());
+            m_peaks.rebuildFrom(audio.getNumChannels(), audio.getNumSamples(),
+                                makeSnapshotReader(audio), firstChangedSample);
+            m_peaksFromCache = false;
         }
 
-        // Enable fast direct rendering mode - STAY in this mode permanently after edits
-        m_useDirectRendering = true;
+        if (! sameAudio)
+            m_spectrogramSourceFile = juce::File();
 
         DBG(juce::String::formatted(
-            "PERFORMANCE: Fast rendering enabled - %d samples cached",
-            buffer.getNumSamples()));
+            "WaveformDisplay: Peaks rebuilt from sample %lld - %lld samples shared",
+            static_cast<long long>(firstChangedSample), static_cast<long long>(audio.getNumSamples())));
     }
 
-    // CRITICAL OPTIMIZATION: DO NOT regenerate entire AudioThumbnail after edits!
-    // This was causing the slow redraw - regenerating entire thumbnail is wasteful.
-    // Fast direct rendering is sufficient for all zoom levels.
-    // Thumbnail is only needed for initial file load (handled in loadFile()).
+    // Everything after the first change may have moved.
+    m_tileCache.invalidateSamples(firstChangedSample, std::numeric_limits<int64_t>::max());
+    invalidateBodyLayer();
+
+    // The spectrogram is the expensive part: keep it for the same samples,
+    // and up to the first change when only the contents moved.
+    if (! sameShape)
+        resetSpectrogram(m_numChannels, audio.getNumSamples());
+    else if (! sameAudio)
+        invalidateSpectrogram(firstChangedSample, std::numeric_limits<int64_t>::max());
 
-    // Mark as ready immediately - no waiting for thumbnail regeneration
+    // Mark as ready immediately
     m_fileLoaded = true;
-    m_isLoading = false;
 
     // CRITICAL: Restore view state if requested
     if (preserveView && m_totalDuration > 0)
@@ -273,8 +538,8 @@ bool WaveformDisplay::reloadFromBuffer(const juce::AudioBuffer<float>& buffer,
         DBG("Edit cursor NOT restored (savedHasEditCursor=false)");
     }
 
-    DBG("WaveformDisplay: Reloaded from buffer - " +
-                             juce::String(buffer.getNumSamples()) + " samples, " +
+    DBG("WaveformDisplay: Reloaded from snapshot - " +
+                             juce::String(audio.getNumSamples()) + " samples, " +
                              juce::String(m_numChannels) + " channels, " +
                              juce::String(m_totalDuration, 2) + " seconds");
 
@@ -282,11 +547,88 @@ bool WaveformDisplay::reloadFromBuffer(const juce::AudioBuffer<float>& buffer,
     return true;
 }
 
+bool WaveformDisplay::applyEditedSnapshot(const AudioSnapshotPtr& snapshot, const AudioEditRange& range)
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    if (snapshot == nullptr)
+    {
+        m_lastError = "Cannot reload from empty snapshot";
+        return false;
+    }
+
+    bool sameShape = false;
+    {
+        juce::ScopedLock lock(m_bufferLock);
+
+        sameShape = ! range.changesLength()
+                    && m_cachedSnapshot != nullptr
+                    && m_cachedSnapshot->getNumChannels() == snapshot->getNumChannels()
+                    && m_cachedSnapshot->getNumSamples() == snapshot->getNumSamples()
+                    && m_sampleRate == snapshot->getSampleRate();
+
+        // Duration, view and cursor are all still valid: only the samples
+        // and peaks in the range differ.
+        if (sameShape)
+        {
+            m_cachedSnapshot = snapshot;
+            m_peaks.rebuildRange(snapshot->getNumChannels(), snapshot->getNumSamples(),
+                                 makeSnapshotReader(*snapshot),
+                                 range.startSample, range.startSample + range.newLength);
+            m_peaksFromCache = false;
+            m_spectrogramSourceFile = juce::File();
+        }
+    }
+
+    if (! sameShape)
+    {
+        return reloadFromSnapshotAt(snapshot, true, true, range.startSample);
+    }
+
+    invalidateSpectrogram(range.startSample, range.startSample + range.newLength);
+    repaintSampleRange(range.startSample, range.startSample + range.newLength);
+    return true;
+}
+
+void WaveformDisplay::repaintSampleRange(int64_t startSample, int64_t endSample)
+{
+    if (m_sampleRate <= 0.0 || endSample <= startSample)
+        return;
+
+    m_tileCache.invalidateSamples(startSample, endSample);
+    invalidateBodyLayer();
+
+    const double startTime = static_cast<double>(startSample) / m_sampleRate;
+    const double endTime = static_cast<double>(endSample) / m_sampleRate;
+
+    if (endTime < m_visibleStart || startTime > m_visibleEnd)
+        return;
+
+    // One column of slack each side: a column straddling the range edge
+    // draws min/max over samples from both sides.
+    const int left = juce::jmax(0, timeToX(startTime) - 1);
+    const int right = juce::jmin(getWidth(), timeToX(endTime) + 2);
+    repaint(left, 0, right - left, getHeight());
+}
+
+bool WaveformDisplay::releaseCachedBuffer()
+{
+    juce::ScopedLock lock(m_bufferLock);
+
+    if (m_cachedSnapshot == nullptr)
+        return false;
+
+    // The peaks stay: they are a few percent of the audio's size and keep
+    // the hibernated tab drawable.
+    m_cachedSnapshot.reset();
+    return true;
+}
+
 void WaveformDisplay::clear()
 {
-    m_thumbnail.clear();
+    m_peakScan.reset();
     m_fileLoaded = false;
-    m_isLoading = false;
+    m_loadProgress = -1.0;
     m_numChannels = 0;
     m_totalDuration = 0.0;
     m_visibleStart = 0.0;
@@ -297,16 +639,81 @@ void WaveformDisplay::clear()
     clearEditCursor();
     updateScrollbar();
 
-    // Clear fast rendering cache
+    // Clear rendering data
     {
         juce::ScopedLock lock(m_bufferLock);
-        m_cachedBuffer.setSize(0, 0);
-        m_useDirectRendering = false;
+        m_cachedSnapshot.reset();
+        m_peaks.clear();
+        m_peaksFromCache = false;
+        m_spectrogramSourceFile = juce::File();
     }
 
+    m_tileCache.invalidateAll();
+    resetSpectrogram(0, 0);
+    invalidateBodyLayer();
+    m_loadedFile = juce::File();
+
     repaint();
 }
 
+//==============================================================================
+// Display mode
+
+void WaveformDisplay::setSpectrogramMode(bool shouldShowSpectrogram)
+{
+    if (m_spectrogramMode == shouldShowSpectrogram)
+        return;
+
+    m_spectrogramMode = shouldShowSpectrogram;
+    startSpectrogram();
+    repaint();
+}
+
+void WaveformDisplay::resetSpectrogram(int numChannels, int64_t numSamples)
+{
+    m_spectrogram.reset(numChannels, numSamples, m_sampleRate);
+    m_spectrogramLookedUp = false;
+    m_spectrogramSaved = false;
+    startSpectrogram();
+}
+
+void WaveformDisplay::invalidateSpectrogram(int64_t startSample, int64_t endSample)
+{
+    m_spectrogram.invalidateSamples(startSample, endSample);
+    m_spectrogramSaved = false;
+    startSpectrogram();
+}
+
+void WaveformDisplay::startSpectrogram()
+{
+    // Nothing is computed until the view is first shown.
+    if (! m_spectrogramMode || m_spectrogram.isEmpty())
+        return;
+
+    if (! m_spectrogramLookedUp)
+    {
+        m_spectrogramLookedUp = true;
+
+        juce::File sourceFile;
+        {
+            juce::ScopedLock lock(m_bufferLock);
+            sourceFile = m_spectrogramSourceFile;
+        }
+
+        auto onStale = [safeThis = juce::Component::SafePointer<WaveformDisplay>(this), sourceFile]
+        {
+            if (safeThis != nullptr)
+                safeThis->recomputeStaleSpectrogram(sourceFile);
+        };
+
+        if (sourceFile != juce::File() && PeakFileCache::tryReadSpectrogram(sourceFile, m_spectrogram, onStale))
+            m_spectrogramSaved = true;
+    }
+
+    // Fills in the gaps behind whatever is on screen.
+    m_spectrogram.requestOverview();
+}
+
 //==============================================================================
 // Playback control
 
@@ -319,6 +726,7 @@ void WaveformDisplay::setPlaybackPosition(double positionInSeconds)
     {
         m_lastPlaybackPosition = m_playbackPosition;
         m_playbackPosition = positionInSeconds;
+        bool scrolled = false;
 
         // Auto-scroll to keep playback cursor visible (only if follow mode enabled)
         // EDGE CASE PROTECTION (2025-10-17): Don't auto-scroll while user is dragging selection
@@ -342,10 +750,20 @@ void WaveformDisplay::setPlaybackPosition(double positionInSeconds)
 
                 // Update scrollbar without triggering callback (to prevent disabling follow mode)
                 updateScrollbar(false);
+                scrolled = true;
             }
         }
 
-        repaint();
+        // Unless the view moved, only the old and new cursor strips change.
+        if (scrolled)
+        {
+            repaint();
+        }
+        else
+        {
+            repaintCursorStrip(m_lastPlaybackPosition, kPlaybackCursorHalfWidth);
+            repaintCursorStrip(m_playbackPosition, kPlaybackCursorHalfWidth);
+        }
     }
 }
 
@@ -360,10 +778,13 @@ void WaveformDisplay::setPreviewPosition(double positionInSeconds)
         return;  // No significant change
     }
 
+    if (m_hasPreviewPosition)
+        repaintCursorStrip(m_previewPosition, kPlaybackCursorHalfWidth);
+
     m_previewPosition = positionInSeconds;
     m_hasPreviewPosition = true;
 
-    repaint();
+    repaintCursorStrip(m_previewPosition, kPlaybackCursorHalfWidth);
 }
 
 void WaveformDisplay::clearPreviewPosition()
@@ -375,10 +796,10 @@ void WaveformDisplay::clearPreviewPosition()
         return;  // Already cleared
     }
 
+    repaintCursorStrip(m_previewPosition, kPlaybackCursorHalfWidth);
+
     m_hasPreviewPosition = false;
     m_previewPosition = 0.0;
-
-    repaint();
 }
 
 void WaveformDisplay::setFollowPlayback(bool shouldFollow)
@@ -591,6 +1012,9 @@ int WaveformDisplay::getChannelAtY(int y) const
 
 void WaveformDisplay::setEditCursor(double positionInSeconds)
 {
+    if (m_hasEditCursor)
+        repaintCursorStrip(m_editCursorPosition, kEditCursorHalfWidth);
+
     // Clamp position to valid range
     m_editCursorPosition = juce::jlimit(0.0, m_totalDuration, positionInSeconds);
     m_hasEditCursor = true;
@@ -603,16 +1027,20 @@ void WaveformDisplay::setEditCursor(double positionInSeconds)
         m_visibleEnd = m_visibleStart + visibleDuration;
         constrainVisibleRange();
         updateScrollbar();
+        repaint();
+        return;
     }
 
-    repaint();
+    repaintCursorStrip(m_editCursorPosition, kEditCursorHalfWidth);
 }
 
 void WaveformDisplay::clearEditCursor()
 {
+    if (m_hasEditCursor)
+        repaintCursorStrip(m_editCursorPosition, kEditCursorHalfWidth);
+
     m_hasEditCursor = false;
     m_editCursorPosition = 0.0;
-    repaint();
 }
 
 void WaveformDisplay::moveEditCursor(double deltaInSeconds)
@@ -819,6 +1247,30 @@ double WaveformDisplay::snapTimeToUnit(double time) const
 
 void WaveformDisplay::timerCallback()
 {
+    // The background peak scan has filled in more of the waveform, or the
+    // tile renderer has finished tiles a paint asked for.
+    const bool peaksChanged = m_peaksChanged.exchange(false);
+    const bool tilesChanged = m_tilesChanged.exchange(false);
+    if (peaksChanged || tilesChanged)
+    {
+        invalidateBodyLayer();
+        repaint();
+    }
+
+    // The spectrogram overview has just been finished: store it for the
+    // next time this file is opened, if the audio is still the file's.
+    if (tilesChanged && m_spectrogramMode && ! m_spectrogramSaved && m_spectrogram.isOverviewComplete())
+    {
+        juce::File sourceFile;
+        {
+            juce::ScopedLock lock(m_bufferLock);
+            sourceFile = m_spectrogramSourceFile;
+        }
+
+        if (sourceFile != juce::File())
+            saveSpectrogramFile(sourceFile);
+    }
+
     if (!m_hasSelection)
     {
         return;
@@ -848,8 +1300,8 @@ void WaveformDisplay::timerCallback()
         }
     }
 
-    // Trigger repaint for animation
-    repaint();
+    // Only the selection pulses; the body underneath is blitted back.
+    repaintSelectionArea();
 }
 
 //==============================================================================
@@ -859,69 +1311,7 @@ void WaveformDisplay::changeListenerCallback(juce::ChangeBroadcaster* source)
 {
     if (source == &waveedit::ThemeManager::getInstance())
     {
-        repaint();
-        return;
-    }
-
-    if (source == &m_thumbnail)
-    {
-        // Check if thumbnail is ready (only used for initial file load)
-        if (m_isLoading && m_thumbnail.getTotalLength() > 0.0)
-        {
-            // Thumbnail loaded successfully from initial file load
-            m_fileLoaded = true;
-            m_isLoading = false;
-            m_totalDuration = m_thumbnail.getTotalLength();
-
-            // Set visible range to show entire file initially
-            m_visibleStart = 0.0;
-            m_visibleEnd = m_totalDuration;
-            m_zoomLevel = 1.0;
-
-            // Reset playback position
-            m_playbackPosition = 0.0;
-
-            // Clear selection
-            clearSelection();
-
-            // Update scrollbar
-            updateScrollbar();
-
-            // Notify listeners (RegionDisplay) of visible range change
-            if (onVisibleRangeChanged)
-                onVisibleRangeChanged(m_visibleStart, m_visibleEnd);
-
-            // NOTE: We do NOT switch rendering modes here anymore
-            // Once a file has been edited, we stay in fast rendering mode permanently
-            // Fast direct rendering is sufficient for all use cases and much faster
-        }
-
-        // Save freshly-generated thumbnails to the on-disk cache so the
-        // next open of this file is instant. Skip if we already loaded
-        // from cache (no point re-saving the same data) or if we've
-        // already saved in this session.
-        //
-        // M19: guard against rapid double-loadFile. If loadFile() was
-        // called again for a different file before this (stale) change
-        // message ran, m_loadedFile already points at the NEW file while
-        // the thumbnail may still hold the previous file's data — saving
-        // here would write the wrong waveform under the new file's key.
-        // m_isLoading is true from loadFile() until the new file's own
-        // change callback finishes setup above, so requiring it to be
-        // false ensures we only persist the thumbnail for the file whose
-        // load actually completed and is currently displayed.
-        if (! m_isLoading
-            && ! m_thumbnailFromCache
-            && ! m_thumbnailCacheSaved
-            && m_thumbnail.isFullyLoaded()
-            && m_loadedFile != juce::File()
-            && m_loadedFile.existsAsFile())
-        {
-            ThumbnailDiskCache::save(m_loadedFile, m_thumbnail);
-            m_thumbnailCacheSaved = true;
-        }
-
-        // Repaint for loading progress or completion
+        invalidateBodyLayer();
         repaint();
     }
 }
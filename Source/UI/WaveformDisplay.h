@@ -27,8 +27,15 @@
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <functional>
 #include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
 #include "../Utils/AudioUnits.h"
 #include "../Utils/NavigationPreferences.h"
+#include "../Audio/AudioSnapshot.h"
+#include "../Audio/PeakPyramid.h"
+#include "../Audio/SpectrogramCache.h"
+#include "WaveformTileCache.h"
 
 /**
  * High-performance waveform display component.
@@ -54,7 +61,9 @@ public:
     // File loading
 
     /**
-     * Loads an audio file and generates a thumbnail for display.
+     * Loads an audio file for display. The timeline is shown at once; the
+     * peaks come from the peak file cache if it has them, otherwise the
+     * waveform fills in as a background scan computes (and caches) them.
      *
      * @param file The audio file to load
      * @param sampleRate The sample rate of the audio file
@@ -63,26 +72,91 @@ public:
      */
     bool loadFile(const juce::File& file, double sampleRate, int numChannels);
 
+    /**
+     * Prepares the display for a file that is being decoded in the
+     * background (see ProgressiveAudioLoader). The full timeline is shown at
+     * once, and the waveform fills in as addLoadedBlock() delivers audio,
+     * so the file is not decoded a second time for the peaks.
+     *
+     * @param totalSamples Length of the file being loaded
+     */
+    void beginProgressiveLoad(const juce::File& file, double sampleRate,
+                              int numChannels, int64_t totalSamples);
+
+    /** Adds freshly decoded audio at startSample to the waveform peaks. */
+    void addLoadedBlock(int64_t startSample, const juce::AudioBuffer<float>& block);
+
+    /**
+     * Stores the current peaks in the peak file cache as those of
+     * audioFile, whose contents must match what is displayed (a finished
+     * load, or a file just saved from this document). Does nothing while
+     * the peaks are incomplete or were mapped from that same entry.
+     */
+    void savePeakFile(const juce::File& audioFile);
+
+    /**
+     * Shows load progress (0.0 - 1.0) over the waveform. Pass a negative
+     * value once loading has finished to hide it.
+     */
+    void setLoadProgress(double progress);
+
     /**
      * Reloads the waveform display from an audio buffer (used after edits).
-     * This regenerates the thumbnail from the edited buffer data.
+     * This rebuilds the waveform peaks from the edited buffer data.
      *
      * @param buffer The audio buffer containing edited samples
      * @param sampleRate The sample rate of the audio data
      * @param preserveView If true, maintains current zoom and scroll position
      * @param preserveEditCursor If true, maintains edit cursor position
+     * @param sameAudio True if these are the samples already displayed (the
+     *        finished load, or a tab waking from hibernation), so the
+     *        spectrogram computed from them is kept
      * @return true if successful, false otherwise
      */
     bool reloadFromBuffer(const juce::AudioBuffer<float>& buffer,
                           double sampleRate,
                           bool preserveView = false,
-                          bool preserveEditCursor = false);
+                          bool preserveEditCursor = false,
+                          bool sameAudio = false);
+
+    /**
+     * Reloads the waveform from a published document snapshot. Unlike
+     * reloadFromBuffer() this keeps a reference to the snapshot instead of
+     * copying its samples, so the display shares the document's pieces with
+     * the buffer manager and the playback engine. Peaks are computed through
+     * the snapshot's range reader; nothing is flattened.
+     *
+     * @return false if the snapshot is null or invalid
+     */
+    bool reloadFromSnapshot(const AudioSnapshotPtr& snapshot,
+                            bool preserveView = false,
+                            bool preserveEditCursor = false,
+                            bool sameAudio = false);
+
+    /**
+     * Takes the snapshot published after an edit that changed only range.
+     * For an in-place edit the view, cursor and selection are untouched and
+     * only the peaks and pixels of the edited span are updated; an edit that
+     * changes the length or layout is handled like reloadFromSnapshot() with
+     * view and edit cursor preserved, recomputing peaks from the edit on.
+     */
+    bool applyEditedSnapshot(const AudioSnapshotPtr& snapshot, const AudioEditRange& range);
 
     /**
      * Clears the current waveform display.
      */
     void clear();
 
+    /**
+     * Drops the reference to the document's samples (tab hibernation),
+     * keeping the peaks, view, selection and cursor. Until the next
+     * reloadFromSnapshot()/reloadFromBuffer() the waveform is drawn from the
+     * peaks alone, so the deepest zoom levels lose sample detail.
+     *
+     * @return true if a snapshot was held
+     */
+    bool releaseCachedBuffer();
+
     /**
      * Returns true if a file is currently loaded.
      */
@@ -322,6 +396,22 @@ public:
      */
     double getPreviewPosition() const { return m_previewPosition; }
 
+    //==============================================================================
+    // Display mode
+
+    /**
+     * Switches the channel lanes between the waveform and a spectrogram
+     * (log frequency, low at the bottom). The spectrogram is computed in
+     * the background and fills in as its tiles finish; a file whose
+     * overview is in the peak file cache shows it at once.
+     */
+    void setSpectrogramMode(bool shouldShowSpectrogram);
+
+    /**
+     * Returns true if the lanes show the spectrogram.
+     */
+    bool isSpectrogramMode() const { return m_spectrogramMode; }
+
     //==============================================================================
     // Zoom and navigation
 
@@ -572,6 +662,7 @@ public:
 
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void visibilityChanged() override;
     void mouseDown(const juce::MouseEvent& event) override;
     void mouseDoubleClick(const juce::MouseEvent& event) override;
     void mouseDrag(const juce::MouseEvent& event) override;
@@ -608,6 +699,35 @@ private:
      */
     void updateScrollbar(bool sendNotification = true);
 
+    /**
+     * Draws the body layer: the time ruler and every channel lane. This is
+     * what m_bodyLayer caches; nothing that moves on its own belongs here.
+     */
+    void paintBody(juce::Graphics& g);
+
+    /**
+     * Draws what sits over the body: region overlays, selection, cursors
+     * and the load progress. Redrawn on every paint, usually clipped to the
+     * strip that changed.
+     */
+    void paintOverlays(juce::Graphics& g, juce::Rectangle<int> waveformArea);
+
+    /** Area below the ruler and above the scrollbar. */
+    juce::Rectangle<int> getWaveformArea() const;
+
+    /**
+     * Repaints the strip around a cursor at timeInSeconds, halfWidth pixels
+     * each side, over the waveform area only. The body is blitted back from
+     * m_bodyLayer, so this costs next to nothing.
+     */
+    void repaintCursorStrip(double timeInSeconds, int halfWidth);
+
+    /** Repaints the selection (and its edge handles), over the waveform area only. */
+    void repaintSelectionArea();
+
+    /** Forces the body layer to be redrawn on the next paint (peaks or tiles changed). */
+    void invalidateBodyLayer() { ++m_bodyGeneration; }
+
     /**
      * Draws the time ruler at the top of the display.
      */
@@ -619,10 +739,58 @@ private:
     void drawChannelWaveform(juce::Graphics& g, juce::Rectangle<int> bounds, int channelNum);
 
     /**
-     * Fast direct rendering from cached buffer (bypasses thumbnail regeneration).
-     * Used immediately after edit operations for <10ms visual feedback.
+     * Draws one channel's min/max outline and RMS core by compositing
+     * pre-rendered tiles from m_tileCache. Spans whose tile is not ready
+     * yet are drawn directly this frame, and the neighbouring tiles are
+     * queued so scrolling (and playback auto-scroll) finds them rendered.
+     */
+    void drawChannelPeaks(juce::Graphics& g, juce::Rectangle<int> bounds, int channelNum);
+
+    /**
+     * Draws one channel's spectrogram from m_spectrogram at the finest
+     * level the zoom needs, falling back to the overview where detail
+     * tiles are still computing.
+     */
+    void drawChannelSpectrogram(juce::Graphics& g, juce::Rectangle<int> bounds, int channelNum);
+
+    /**
+     * SpectrogramCache sample source: reads m_cachedSnapshot or, when
+     * that has been released or not decoded yet, reads
+     * m_spectrogramSourceFile. Called on the spectrogram pool threads.
+     */
+    bool readSpectrogramSamples(int channel, int64_t startSample, int numSamples, float* dest) const;
+
+    /** Sizes m_spectrogram for new audio, dropping everything it held. */
+    void resetSpectrogram(int numChannels, int64_t numSamples);
+
+    /** Drops the spectrogram tiles over samples [startSample, endSample) after an edit. */
+    void invalidateSpectrogram(int64_t startSample, int64_t endSample);
+
+    /**
+     * In spectrogram mode, loads the cached overview for the file the
+     * audio came from (once per reset) and queues whatever is missing.
+     */
+    void startSpectrogram();
+
+    /** Stores the complete overview in the peak file cache as audioFile's. */
+    void saveSpectrogramFile(const juce::File& audioFile);
+
+    /**
+     * Peak file cache onStale callbacks: the entry read for file did not
+     * match its contents after all. Rescans the peaks from file, or
+     * recomputes the spectrogram, if they still come from that entry.
      */
-    void drawChannelWaveformDirect(juce::Graphics& g, juce::Rectangle<int> bounds, int channelNum);
+    void rescanStalePeaks(const juce::File& file);
+    void recomputeStaleSpectrogram(const juce::File& file);
+
+    /**
+     * Fills dest with one peak per column (see PeakPyramid::getColumns()),
+     * from the peak pyramid or, when zoomed in below its base resolution,
+     * from the raw samples. Called on the message thread and on the tile
+     * render thread; takes m_bufferLock.
+     */
+    bool readColumnPeaks(int channel, double startSample, double samplesPerColumn,
+                         int numColumns, PeakPyramid::Peak* dest) const;
 
     /**
      * Draws the selection highlight.
@@ -658,16 +826,14 @@ private:
     //==============================================================================
     // Member variables
 
-    // Audio thumbnail for waveform rendering
-    juce::AudioThumbnailCache m_thumbnailCache;
-    juce::AudioThumbnail m_thumbnail;
+    // Opens files for the background peak scan in loadFile()
+    juce::AudioFormatManager& m_formatManager;
 
     // Scrollbar for navigation
     juce::ScrollBar m_scrollbar;
 
     // File state
     bool m_fileLoaded;
-    bool m_isLoading;
     int m_numChannels;
     double m_sampleRate;
     double m_totalDuration;
@@ -720,10 +886,90 @@ private:
     const juce::AudioBuffer<float>* m_audioBufferRef; // Reference for zero-crossing snap
     juce::CriticalSection m_snapLock;           // Thread safety for snap mode changes
 
-    // Fast direct rendering (for <10ms waveform updates after edits)
-    juce::AudioBuffer<float> m_cachedBuffer;  // Cached copy for direct rendering
-    bool m_useDirectRendering;  // If true, bypass thumbnail, render from buffer
-    juce::CriticalSection m_bufferLock;  // Thread safety for buffer access
+    /**
+     * Marks samples [startSample, endSample) as changed: drops their cached
+     * tiles and repaints the columns showing them, if visible.
+     */
+    void repaintSampleRange(int64_t startSample, int64_t endSample);
+
+    /**
+     * Shared body of reloadFromBuffer() / reloadFromSnapshot(). Peaks before
+     * firstChangedSample are kept when the channel layout is unchanged.
+     */
+    bool reloadFromSnapshotAt(AudioSnapshotPtr snapshot,
+                              bool preserveView, bool preserveEditCursor,
+                              int64_t firstChangedSample = 0, bool sameAudio = false);
+
+    /** A PeakPyramid reader over snapshot (which must outlive its use). */
+    static PeakPyramid::SampleReader makeSnapshotReader(const AudioSnapshot& snapshot);
+
+    /** Reads a file in the background and feeds it into m_peaks (see loadFile()). */
+    class PeakScanThread;
+
+    // Waveform rendering data
+    PeakPyramid m_peaks;               // Min/max/RMS for every zoom level
+    AudioSnapshotPtr m_cachedSnapshot; // Shared document audio for zoom levels finer than the peaks
+    juce::CriticalSection m_bufferLock;  // Guards m_peaks and m_cachedSnapshot (the peak scan writes from its thread)
+    std::unique_ptr<PeakScanThread> m_peakScan;
+    std::atomic<bool> m_peaksChanged { false };  // Set by the peak scan; the timer repaints
+    juce::File m_loadedFile;           // File the unedited peaks belong to
+    bool m_peaksFromCache = false;     // m_peaks is m_loadedFile's mapped peak file entry
+    std::vector<PeakPyramid::Peak> m_columnPeaks;  // Paint scratch, one entry per pixel column
+    std::atomic<bool> m_tilesChanged { false };    // Set by the tile renderer; the timer repaints
+
+    // Declared after everything readColumnPeaks() touches, so its render
+    // thread stops first.
+    WaveformTileCache m_tileCache {
+        [this](int channel, double startSample, double samplesPerColumn, int numColumns, PeakPyramid::Peak* dest)
+        { return readColumnPeaks(channel, startSample, samplesPerColumn, numColumns, dest); },
+        [this] { m_tilesChanged.store(true); }
+    };
+
+    // Spectrogram view. m_spectrogramSourceFile is guarded by m_bufferLock
+    // and is cleared once the audio no longer matches the file.
+    bool m_spectrogramMode = false;
+    juce::File m_spectrogramSourceFile;
+    bool m_spectrogramLookedUp = false;  // Cached overview already tried since the last reset
+    bool m_spectrogramSaved = false;     // Overview already stored since the last reset/edit
+    juce::Image m_spectrogramImage;      // Paint scratch, one pixel per column and band
+
+    // Declared after everything readSpectrogramSamples() touches, so its
+    // pool stops first.
+    SpectrogramCache m_spectrogram {
+        [this](int channel, int64_t startSample, int numSamples, float* dest)
+        { return readSpectrogramSamples(channel, startSample, numSamples, dest); },
+        [this] { m_tilesChanged.store(true); }
+    };
+
+    /**
+     * Everything the body layer's pixels depend on. paint() compares it
+     * with the state the layer was drawn for and redraws on any difference,
+     * so callers only ever need repaint(); m_bodyGeneration covers the
+     * inputs that are not cheap to compare (peak data, theme).
+     */
+    struct BodyLayerState
+    {
+        double visibleStart = 0.0;
+        double visibleEnd = 0.0;
+        int width = 0;
+        int height = 0;
+        float scale = 0.0f;
+        bool fileLoaded = false;
+        bool spectrogram = false;
+        int numChannels = 0;
+        int focusedChannels = 0;
+        juce::uint32 soloMuteBits = 0;
+        std::vector<juce::uint32> channelColours;
+        uint64_t generation = 0;
+
+        bool operator== (const BodyLayerState& other) const;
+    };
+
+    BodyLayerState getBodyLayerState(float scale) const;
+
+    juce::Image m_bodyLayer;            // Ruler and lanes at physical resolution
+    BodyLayerState m_bodyLayerState;    // Inputs m_bodyLayer was drawn from
+    uint64_t m_bodyGeneration = 0;      // Bumped by invalidateBodyLayer()
 
     // Region overlay rendering (optional, nullptr if not set)
     class RegionManager* m_regionManager;  // For drawing semi-transparent region overlays
@@ -745,13 +991,8 @@ private:
     std::array<juce::Colour, 8> m_channelWaveformOverride {};
     bool m_channelOverridesLoaded = false;
 
-    // Disk thumbnail cache bookkeeping. We remember the audio file
-    // we're displaying so we can save the thumbnail to disk after
-    // generation completes, and to avoid re-saving an already-cached
-    // thumbnail on subsequent change broadcasts.
-    juce::File m_loadedFile;
-    bool m_thumbnailFromCache = false;
-    bool m_thumbnailCacheSaved = false;
+    // Background-load progress (0.0 - 1.0), or negative when not loading.
+    double m_loadProgress = -1.0;
 
     // Selection-edge resize gesture state. When the user clicks within
     // kEdgeHandleHaloPx of selectionStart or selectionEnd, the next
@@ -764,6 +1005,11 @@ private:
     // Time comparison epsilon (1ms for sample-accurate comparisons)
     static constexpr double TIME_EPSILON = 0.001;
 
+    // Half-widths of the strips repainted when a cursor moves: the
+    // playback/preview triangle, and the edit cursor's time label.
+    static constexpr int kPlaybackCursorHalfWidth = 6;
+    static constexpr int kEditCursorHalfWidth = 41;
+
     // Channel context menu methods
     void showChannelContextMenu(int channel, juce::Point<int> screenPos);
     void handleChannelMenuResult(int channel, int menuResult);
@@ -22,10 +22,69 @@
 #include "../Utils/Settings.h"
 #include "ThemeManager.h"
 #include "../Audio/ChannelLayout.h"
+#include <array>
 #include <cmath>
 #include <juce_gui_extra/juce_gui_extra.h>
 
+namespace
+{
+    // Spectrogram colours for magnitude bytes 0..255: near-black through
+    // purple, red and orange to pale yellow.
+    const std::array<juce::PixelARGB, 256>& getSpectrogramPalette()
+    {
+        static const auto palette = []
+        {
+            juce::ColourGradient gradient(juce::Colour(0xff000004), 0.0f, 0.0f,
+                                          juce::Colour(0xfffcffa4), 1.0f, 0.0f, false);
+            gradient.addColour(0.25, juce::Colour(0xff420a68));
+            gradient.addColour(0.5, juce::Colour(0xff932667));
+            gradient.addColour(0.75, juce::Colour(0xffdd513a));
+            gradient.addColour(0.9, juce::Colour(0xfffca50a));
+
+            std::array<juce::PixelARGB, 256> colours;
+            for (size_t i = 0; i < colours.size(); ++i)
+                colours[i] = gradient.getColourAtPosition(static_cast<double>(i) / 255.0).getPixelARGB();
+            return colours;
+        }();
+
+        return palette;
+    }
+}
+
 void WaveformDisplay::paint(juce::Graphics& g)
+{
+    // The body (ruler and lanes) comes from m_bodyLayer, redrawn only when
+    // one of its inputs changed. Cursor moves and the selection pulse
+    // repaint narrow strips, which makes most paints a clipped blit plus
+    // the overlays.
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const int layerWidth = juce::roundToInt(getWidth() * scale);
+    const int layerHeight = juce::roundToInt(getHeight() * scale);
+    if (layerWidth <= 0 || layerHeight <= 0)
+        return;
+
+    auto state = getBodyLayerState(scale);
+    if (! m_bodyLayer.isValid() || ! (state == m_bodyLayerState))
+    {
+        if (m_bodyLayer.getWidth() != layerWidth || m_bodyLayer.getHeight() != layerHeight)
+            m_bodyLayer = juce::Image(juce::Image::RGB, layerWidth, layerHeight, false);
+
+        juce::Graphics layer(m_bodyLayer);
+        layer.addTransform(juce::AffineTransform::scale(scale));
+        paintBody(layer);
+        m_bodyLayerState = std::move(state);
+    }
+
+    if (scale == 1.0f)
+        g.drawImageAt(m_bodyLayer, 0, 0);
+    else
+        g.drawImageTransformed(m_bodyLayer, juce::AffineTransform::scale(1.0f / scale));
+
+    if (m_fileLoaded)
+        paintOverlays(g, getWaveformArea());
+}
+
+void WaveformDisplay::paintBody(juce::Graphics& g)
 {
     // Background
     g.fillAll(waveedit::ThemeManager::getInstance().getCurrent().background);
@@ -39,15 +98,6 @@ void WaveformDisplay::paint(juce::Graphics& g)
     auto rulerBounds = bounds.removeFromTop(RULER_HEIGHT);
     drawTimeRuler(g, rulerBounds);
 
-    if (m_isLoading)
-    {
-        // Loading in progress
-        g.setColour(waveedit::ThemeManager::getInstance().getCurrent().text);
-        g.setFont(16.0f);
-        g.drawText("Loading waveform...", bounds, juce::Justification::centred, true);
-        return;
-    }
-
     if (!m_fileLoaded)
     {
         // No file loaded
@@ -57,10 +107,6 @@ void WaveformDisplay::paint(juce::Graphics& g)
         return;
     }
 
-    // Save the full waveform area bounds BEFORE we start modifying it
-    auto waveformArea = bounds;
-
-    // Draw waveforms for each channel FIRST
     if (m_numChannels == 1)
     {
         // Mono - use full height
@@ -81,7 +127,10 @@ void WaveformDisplay::paint(juce::Graphics& g)
             drawChannelWaveform(g, channelBounds, ch);
         }
     }
+}
 
+void WaveformDisplay::paintOverlays(juce::Graphics& g, juce::Rectangle<int> waveformArea)
+{
     // Draw region overlays ON TOP of waveform (semi-transparent colored bands)
     drawRegionOverlays(g, waveformArea);
 
@@ -99,6 +148,97 @@ void WaveformDisplay::paint(juce::Graphics& g)
 
     // Draw edit cursor on top of everything (yellow, shows paste position)
     drawEditCursor(g, waveformArea);
+
+    // Background decode still running: the waveform fills in left to right,
+    // and the percentage tells the user how far it has got.
+    if (m_loadProgress >= 0.0)
+    {
+        g.setColour(waveedit::ThemeManager::getInstance().getCurrent().textMuted);
+        g.setFont(12.0f);
+        g.drawText("Loading " + juce::String(juce::roundToInt(m_loadProgress * 100.0)) + "%",
+                   waveformArea.reduced(6, 4), juce::Justification::topRight, false);
+    }
+}
+
+bool WaveformDisplay::BodyLayerState::operator== (const BodyLayerState& other) const
+{
+    return visibleStart == other.visibleStart
+        && visibleEnd == other.visibleEnd
+        && width == other.width
+        && height == other.height
+        && scale == other.scale
+        && fileLoaded == other.fileLoaded
+        && spectrogram == other.spectrogram
+        && numChannels == other.numChannels
+        && focusedChannels == other.focusedChannels
+        && soloMuteBits == other.soloMuteBits
+        && channelColours == other.channelColours
+        && generation == other.generation;
+}
+
+WaveformDisplay::BodyLayerState WaveformDisplay::getBodyLayerState(float scale) const
+{
+    BodyLayerState state;
+    state.visibleStart = m_visibleStart;
+    state.visibleEnd = m_visibleEnd;
+    state.width = getWidth();
+    state.height = getHeight();
+    state.scale = scale;
+    state.fileLoaded = m_fileLoaded;
+    state.spectrogram = m_spectrogramMode;
+    state.numChannels = m_numChannels;
+    state.focusedChannels = m_focusedChannels;
+    state.generation = m_bodyGeneration;
+
+    if (m_fileLoaded)
+    {
+        // Solo/mute live in the engine and the waveform colour in Settings;
+        // neither tells us when it changes, so compare them directly.
+        // Labels (and so these flags) exist for the first 8 channels only.
+        for (int ch = 0; ch < juce::jmin(m_numChannels, 8); ++ch)
+        {
+            if (getChannelSolo && getChannelSolo(ch))
+                state.soloMuteBits |= 1u << ch;
+            if (getChannelMute && getChannelMute(ch))
+                state.soloMuteBits |= 1u << (ch + 8);
+        }
+
+        state.channelColours.reserve(static_cast<size_t>(m_numChannels));
+        for (int ch = 0; ch < m_numChannels; ++ch)
+            state.channelColours.push_back(getChannelWaveformColour(ch).getARGB());
+    }
+
+    return state;
+}
+
+juce::Rectangle<int> WaveformDisplay::getWaveformArea() const
+{
+    auto bounds = getLocalBounds();
+    bounds.removeFromBottom(SCROLLBAR_HEIGHT);
+    bounds.removeFromTop(RULER_HEIGHT);
+    return bounds;
+}
+
+void WaveformDisplay::repaintCursorStrip(double timeInSeconds, int halfWidth)
+{
+    if (timeInSeconds < m_visibleStart || timeInSeconds > m_visibleEnd)
+        return;
+
+    const auto area = getWaveformArea();
+    const int x = timeToX(timeInSeconds);
+    repaint(area.withX(x - halfWidth).withWidth(2 * halfWidth + 1).getIntersection(area));
+}
+
+void WaveformDisplay::repaintSelectionArea()
+{
+    if (!m_hasSelection)
+        return;
+
+    // Edge lines, their shadows and the corner handles reach 3px outside.
+    const auto area = getWaveformArea();
+    const int left = timeToX(m_selectionStart) - 4;
+    const int right = timeToX(m_selectionEnd) + 5;
+    repaint(area.withX(left).withRight(right).getIntersection(area));
 }
 
 void WaveformDisplay::resized()
@@ -112,6 +252,14 @@ void WaveformDisplay::resized()
     updateScrollbar();
 }
 
+void WaveformDisplay::visibilityChanged()
+{
+    // A hidden tab's body layer is a full-window image; drop it until the
+    // tab is shown again.
+    if (!isVisible())
+        m_bodyLayer = juce::Image();
+}
+
 void WaveformDisplay::drawTimeRuler(juce::Graphics& g, juce::Rectangle<int> bounds)
 {
     const auto& theme = waveedit::ThemeManager::getInstance().getCurrent();
@@ -202,39 +350,33 @@ void WaveformDisplay::drawChannelWaveform(juce::Graphics& g, juce::Rectangle<int
     }
     g.fillRect(bounds);
 
-    // Draw focus indicator border for focused channels (when not all are focused)
+    if (m_spectrogramMode)
+    {
+        drawChannelSpectrogram(g, bounds, channelNum);
+    }
+    else
+    {
+        // Center line
+        g.setColour(theme.gridLine);
+        g.drawLine(bounds.getX(), bounds.getCentreY(),
+                   bounds.getRight(), bounds.getCentreY(), 1.0f);
+
+        drawChannelPeaks(g, bounds, channelNum);
+    }
+
+    // Draw focus indicator border for focused channels (when not all are focused),
+    // over the lane content so an opaque spectrogram does not hide it
     if (isFocused && showFocusIndicator)
     {
         g.setColour(theme.waveformBorder.withAlpha(0.6f));
         g.drawRect(bounds.reduced(1), 2);
     }
 
-    // Center line
-    g.setColour(theme.gridLine);
-    g.drawLine(bounds.getX(), bounds.getCentreY(),
-               bounds.getRight(), bounds.getCentreY(), 1.0f);
-
-    // Draw waveform - use fast direct rendering if enabled, otherwise use thumbnail
     // Dim unfocused channels when single channel is focused
-    float waveformAlpha = (isFocused || !showFocusIndicator) ? 1.0f : 0.4f;
-
-    if (m_useDirectRendering)
-    {
-        // For direct rendering, we'll handle alpha in drawChannelWaveformDirect
-        drawChannelWaveformDirect(g, bounds, channelNum);
-
-        // Apply dimming overlay for unfocused channels
-        if (!isFocused && showFocusIndicator)
-        {
-            g.setColour(juce::Colours::black.withAlpha(0.5f));
-            g.fillRect(bounds);
-        }
-    }
-    else
+    if (!isFocused && showFocusIndicator)
     {
-        juce::Colour waveformColor = getChannelWaveformColour(channelNum).withAlpha(waveformAlpha);
-        g.setColour(waveformColor);
-        m_thumbnail.drawChannel(g, bounds, m_visibleStart, m_visibleEnd, channelNum, 1.0f);
+        g.setColour(juce::Colours::black.withAlpha(0.5f));
+        g.fillRect(bounds);
     }
 
     // Channel label with solo/mute indicators (for all channel counts)
@@ -310,75 +452,246 @@ void WaveformDisplay::drawChannelWaveform(juce::Graphics& g, juce::Rectangle<int
     }
 }
 
-void WaveformDisplay::drawChannelWaveformDirect(juce::Graphics& g, juce::Rectangle<int> bounds, int channelNum)
+void WaveformDisplay::drawChannelPeaks(juce::Graphics& g, juce::Rectangle<int> bounds, int channelNum)
 {
-    // PERFORMANCE-CRITICAL: Fast direct rendering from cached buffer
-    // Achieves <10ms redraw by bypassing AudioThumbnail regeneration
+    const int width = bounds.getWidth();
+    if (width <= 0 || bounds.getHeight() <= 0 || m_sampleRate <= 0.0)
+        return;
 
-    juce::ScopedLock lock(m_bufferLock);
+    const double startSample = m_visibleStart * m_sampleRate;
+    const double samplesPerPixel = WaveformTileCache::quantiseSamplesPerPixel(
+        (m_visibleEnd - m_visibleStart) * m_sampleRate / width);
 
-    // Validate buffer
-    if (m_cachedBuffer.getNumSamples() == 0 || channelNum >= m_cachedBuffer.getNumChannels())
-    {
+    if (samplesPerPixel <= 0.0)
         return;
-    }
 
-    const float* channelData = m_cachedBuffer.getReadPointer(channelNum);
-    const int totalSamples = m_cachedBuffer.getNumSamples();
+    // Tiles sit on a grid of absolute pixel columns at this zoom; the view
+    // starts at column originX, rounded so every tile lands on a whole pixel.
+    constexpr int tileWidth = WaveformTileCache::kTileWidth;
+    const auto originX = static_cast<int64_t>(std::llround(startSample / samplesPerPixel));
+    const int64_t firstTile = originX >= 0 ? originX / tileWidth : (originX - tileWidth + 1) / tileWidth;
+    const int64_t lastTile = (originX + width - 1) / tileWidth;
+
+    WaveformTileCache::TileKey key;
+    key.channel = channelNum;
+    key.samplesPerPixel = samplesPerPixel;
+    key.height = bounds.getHeight();
+    key.colour = getChannelWaveformColour(channelNum).getARGB();
+
+    // Queue one tile beyond each edge, so scrolling (including playback
+    // auto-scroll) uncovers tiles that are already rendered. Queued first:
+    // the newest requests, the visible tiles below, render first.
+    key.index = firstTile - 1;
+    if (key.index >= 0)
+        m_tileCache.prefetch(key);
+    key.index = lastTile + 1;
+    m_tileCache.prefetch(key);
+
+    for (int64_t tile = firstTile; tile <= lastTile; ++tile)
+    {
+        key.index = tile;
+        const int tileX = bounds.getX() + static_cast<int>(tile * tileWidth - originX);
+
+        const auto image = m_tileCache.getTile(key);
+        if (image.isValid())
+        {
+            g.drawImageAt(image, tileX, bounds.getY());
+            continue;
+        }
 
-    // Calculate visible sample range
-    const int64_t startSample = static_cast<int64_t>(m_visibleStart * m_sampleRate);
-    const int64_t endSample = static_cast<int64_t>(m_visibleEnd * m_sampleRate);
-    const int64_t visibleSamples = endSample - startSample;
+        // Not rendered yet: draw the visible part of this tile directly.
+        const int left = juce::jmax(bounds.getX(), tileX);
+        const int right = juce::jmin(bounds.getRight(), tileX + tileWidth);
+        const int numColumns = right - left;
+        if (numColumns <= 0)
+            continue;
 
-    if (visibleSamples <= 0)
-    {
-        return;
+        m_columnPeaks.resize(static_cast<size_t>(numColumns));
+        const double firstColumn = static_cast<double>(originX + (left - bounds.getX()));
+        if (readColumnPeaks(channelNum, firstColumn * samplesPerPixel, samplesPerPixel,
+                            numColumns, m_columnPeaks.data()))
+        {
+            WaveformTileCache::drawPeakColumns(g, bounds.withX(left).withWidth(numColumns),
+                                               m_columnPeaks.data(), numColumns, juce::Colour(key.colour));
+        }
     }
+}
 
-    // Rendering parameters
+void WaveformDisplay::drawChannelSpectrogram(juce::Graphics& g, juce::Rectangle<int> bounds, int channelNum)
+{
     const int width = bounds.getWidth();
-    const int height = bounds.getHeight();
-    const float centerY = bounds.getCentreY();
-    const float halfHeight = height * 0.5f;
+    if (width <= 0 || bounds.getHeight() <= 0 || m_sampleRate <= 0.0 || m_spectrogram.isEmpty())
+        return;
+
+    const double startSample = m_visibleStart * m_sampleRate;
+    const double samplesPerPixel = (m_visibleEnd - m_visibleStart) * m_sampleRate / width;
+    if (samplesPerPixel <= 0.0)
+        return;
 
-    // Set waveform color (per-channel override falls back to global setting)
-    g.setColour(getChannelWaveformColour(channelNum));
+    constexpr int numBins = SpectrogramCache::kNumBins;
+    constexpr int columnsPerTile = SpectrogramCache::kColumnsPerTile;
+    constexpr int overviewLevel = SpectrogramCache::kOverviewLevel;
 
-    // Calculate samples per pixel
-    const double samplesPerPixel = static_cast<double>(visibleSamples) / width;
+    const int level = SpectrogramCache::getLevelFor(samplesPerPixel);
+    const int hopSize = SpectrogramCache::getLevel(level).hopSize;
+    const int overviewHop = SpectrogramCache::getLevel(overviewLevel).hopSize;
+    const int64_t numColumns = m_spectrogram.getNumColumns(level);
 
-    // Fast rendering: for each pixel column, find min/max and draw vertical line
-    for (int x = 0; x < width; ++x)
+    // Columns are read left to right, so remembering the last tile of each
+    // level means one cache lookup per tile rather than per column.
+    SpectrogramCache::TilePtr tiles[2];
+    int64_t tileIndices[2] = { -1, -1 };
+    const auto getColumn = [&](int slot, int columnLevel, int64_t column) -> const uint8_t*
     {
-        // Calculate sample range for this pixel
-        const int64_t pixelStartSample = startSample + static_cast<int64_t>(x * samplesPerPixel);
-        const int64_t pixelEndSample = startSample + static_cast<int64_t>((x + 1) * samplesPerPixel);
+        const int64_t index = column / columnsPerTile;
+        if (index != tileIndices[slot])
+        {
+            tileIndices[slot] = index;
+            tiles[slot] = m_spectrogram.getTile(columnLevel, channelNum, index);
+        }
+
+        return tiles[slot] != nullptr ? tiles[slot]->getColumn(static_cast<int>(column % columnsPerTile)) : nullptr;
+    };
+
+    // One pixel per lane column and band, stretched over the lane below.
+    if (m_spectrogramImage.getWidth() != width)
+        m_spectrogramImage = juce::Image(juce::Image::ARGB, width, numBins, false);
+    m_spectrogramImage.clear(m_spectrogramImage.getBounds());
 
-        // Clamp to buffer bounds
-        const int64_t clampedStart = juce::jlimit<int64_t>(0, totalSamples - 1, pixelStartSample);
-        const int64_t clampedEnd = juce::jlimit<int64_t>(clampedStart + 1, totalSamples, pixelEndSample);
+    const auto& palette = getSpectrogramPalette();
+    std::array<uint8_t, numBins> loudest;
 
-        // Find min/max in this pixel's sample range
-        float minSample = 0.0f;
-        float maxSample = 0.0f;
+    {
+        juce::Image::BitmapData pixels(m_spectrogramImage, juce::Image::BitmapData::writeOnly);
 
-        for (int64_t i = clampedStart; i < clampedEnd; ++i)
+        for (int x = 0; x < width; ++x)
         {
-            const float sample = channelData[i];
-            minSample = juce::jmin(minSample, sample);
-            maxSample = juce::jmax(maxSample, sample);
+            // Every column the pixel overlaps, and at least one.
+            const double first = startSample + x * samplesPerPixel;
+            const auto firstColumn = static_cast<int64_t>(std::floor(first / hopSize));
+            const int64_t endColumn = juce::jmin(numColumns, juce::jmax(firstColumn + 1,
+                static_cast<int64_t>(std::ceil((first + samplesPerPixel) / hopSize))));
+
+            loudest.fill(0);
+            bool anyColumn = false;
+
+            for (int64_t column = juce::jmax<int64_t>(0, firstColumn); column < endColumn; ++column)
+            {
+                // A detail tile still computing shows the overview meanwhile.
+                const uint8_t* magnitudes = getColumn(0, level, column);
+                if (magnitudes == nullptr && level != overviewLevel)
+                    magnitudes = getColumn(1, overviewLevel, column * hopSize / overviewHop);
+
+                if (magnitudes == nullptr)
+                    continue;
+
+                for (int bin = 0; bin < numBins; ++bin)
+                    loudest[static_cast<size_t>(bin)] = juce::jmax(loudest[static_cast<size_t>(bin)], magnitudes[bin]);
+
+                anyColumn = true;
+            }
+
+            if (! anyColumn)
+                continue;
+
+            // Lowest band at the bottom.
+            for (int bin = 0; bin < numBins; ++bin)
+                *reinterpret_cast<juce::PixelARGB*>(pixels.getPixelPointer(x, numBins - 1 - bin))
+                    = palette[loudest[static_cast<size_t>(bin)]];
         }
+    }
+
+    juce::Graphics::ScopedSaveState saved(g);
+    g.setImageResamplingQuality(juce::Graphics::lowResamplingQuality);
+    g.drawImage(m_spectrogramImage, bounds.toFloat());
+}
+
+bool WaveformDisplay::readSpectrogramSamples(int channel, int64_t startSample, int numSamples, float* dest) const
+{
+    juce::File sourceFile;
+    {
+        juce::ScopedLock lock(m_bufferLock);
+
+        if (m_cachedSnapshot != nullptr)
+            return m_cachedSnapshot->readChannelRange(channel, dest, startSample, numSamples);
+
+        sourceFile = m_spectrogramSourceFile;
+    }
 
-        // Convert to pixel coordinates (flipped Y axis, -1.0 is top, +1.0 is bottom)
-        const float minY = centerY - (maxSample * halfHeight);
-        const float maxY = centerY - (minSample * halfHeight);
+    // Still loading, hibernated, or too big to keep in memory: read the
+    // file the audio came from, as long as it has not been edited since.
+    if (sourceFile == juce::File())
+        return false;
 
-        // Draw vertical line for this pixel column
-        g.drawLine(bounds.getX() + x, minY,
-                   bounds.getX() + x, maxY,
-                   1.0f);
+    std::unique_ptr<juce::AudioFormatReader> reader(m_formatManager.createReaderFor(sourceFile));
+    if (reader == nullptr || channel >= static_cast<int>(reader->numChannels)
+        || startSample + numSamples > reader->lengthInSamples)
+    {
+        return false;
     }
+
+    juce::AudioBuffer<float> block(static_cast<int>(reader->numChannels), numSamples);
+    if (! reader->read(&block, 0, numSamples, startSample, true, true))
+        return false;
+
+    juce::FloatVectorOperations::copy(dest, block.getReadPointer(channel), numSamples);
+    return true;
+}
+
+bool WaveformDisplay::readColumnPeaks(int channel, double startSample, double samplesPerColumn,
+                                      int numColumns, PeakPyramid::Peak* dest) const
+{
+    juce::ScopedLock lock(m_bufferLock);
+
+    if (channel >= m_peaks.getNumChannels())
+        return false;
+
+    // Zoomed in past the pyramid's base resolution: a column spans fewer
+    // than kBaseSamplesPerPeak samples, so read them directly. Still
+    // O(columns), and it shows single-sample detail.
+    if (samplesPerColumn < PeakPyramid::kBaseSamplesPerPeak
+        && m_cachedSnapshot != nullptr
+        && channel < m_cachedSnapshot->getNumChannels()
+        && m_cachedSnapshot->getNumSamples() > 0)
+    {
+        const int64_t totalSamples = m_cachedSnapshot->getNumSamples();
+
+        // The visible span is under kBaseSamplesPerPeak samples per column,
+        // so read it out of the snapshot's pieces in one go.
+        const int64_t spanStart = juce::jlimit<int64_t>(0, totalSamples - 1, static_cast<int64_t>(startSample));
+        const int64_t spanEnd = juce::jlimit<int64_t>(spanStart + 1, totalSamples,
+                                                      static_cast<int64_t>(startSample + numColumns * samplesPerColumn) + 1);
+        std::vector<float> span(static_cast<size_t>(spanEnd - spanStart));
+        if (! m_cachedSnapshot->readChannelRange(channel, span.data(), spanStart, static_cast<int>(span.size())))
+            return false;
+
+
+        for (int x = 0; x < numColumns; ++x)
+        {
+            const auto first = static_cast<int64_t>(startSample + x * samplesPerColumn);
+            const auto end = static_cast<int64_t>(startSample + (x + 1) * samplesPerColumn);
+
+            // Past the end of the audio: silence, as the pyramid reports.
+            if (first >= totalSamples)
+            {
+                dest[x] = {};
+                continue;
+            }
+
+            // Clamp to the span read; every column shows at least one sample
+            const int64_t clampedStart = juce::jlimit<int64_t>(spanStart, spanEnd - 1, first);
+            const int64_t clampedEnd = juce::jlimit<int64_t>(clampedStart + 1, spanEnd, end);
+
+            dest[x] = PeakPyramid::computePeak(span.data() + (clampedStart - spanStart),
+                                               static_cast<int>(clampedEnd - clampedStart));
+        }
+    }
+    else
+    {
+        m_peaks.getColumns(channel, startSample, samplesPerColumn, numColumns, dest);
+    }
+
+    return true;
 }
 
 void WaveformDisplay::drawSelection(juce::Graphics& g, juce::Rectangle<int> bounds)
@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+    WaveformTileCache.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "WaveformTileCache.h"
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+//==============================================================================
+bool WaveformTileCache::TileKey::operator< (const TileKey& other) const
+{
+    return std::tie(channel, samplesPerPixel, index, height, colour)
+         < std::tie(other.channel, other.samplesPerPixel, other.index, other.height, other.colour);
+}
+
+bool WaveformTileCache::TileKey::operator== (const TileKey& other) const
+{
+    return channel == other.channel
+        && samplesPerPixel == other.samplesPerPixel
+        && index == other.index
+        && height == other.height
+        && colour == other.colour;
+}
+
+//==============================================================================
+class WaveformTileCache::RenderThread : public juce::Thread
+{
+public:
+    explicit RenderThread(WaveformTileCache& owner)
+        : juce::Thread("Waveform Tile Renderer"),
+          m_owner(owner)
+    {
+    }
+
+    ~RenderThread() override
+    {
+        signalThreadShouldExit();
+        m_wakeUp.signal();
+        stopThread(2000);
+    }
+
+    void wake() { m_wakeUp.signal(); }
+
+    void run() override
+    {
+        std::vector<PeakPyramid::Peak> scratch;
+
+        while (! threadShouldExit())
+        {
+            TileKey key;
+            if (! m_owner.takeNextRequest(key))
+            {
+                m_wakeUp.wait(100);
+                continue;
+            }
+
+            m_owner.storeRenderedTile(key, m_owner.renderTile(key, scratch));
+
+            if (m_owner.m_tileReady)
+                m_owner.m_tileReady();
+        }
+    }
+
+private:
+    WaveformTileCache& m_owner;
+    juce::WaitableEvent m_wakeUp;
+};
+
+//==============================================================================
+WaveformTileCache::WaveformTileCache(ColumnSource source, std::function<void()> tileReady)
+    : m_source(std::move(source)),
+      m_tileReady(std::move(tileReady))
+{
+    m_thread = std::make_unique<RenderThread>(*this);
+    m_thread->startThread();
+}
+
+WaveformTileCache::~WaveformTileCache()
+{
+    // Stop rendering before the source (usually the owner's peaks) goes away.
+    m_thread.reset();
+}
+
+juce::Image WaveformTileCache::getTile(const TileKey& key)
+{
+    {
+        juce::ScopedLock lock(m_lock);
+
+        const auto found = m_tileIndex.find(key);
+        if (found != m_tileIndex.end())
+        {
+            // Most recently drawn moves to the front.
+            m_tiles.splice(m_tiles.begin(), m_tiles, found->second);
+            return found->second->image;
+        }
+
+        requestLocked(key);
+    }
+
+    m_thread->wake();
+    return {};
+}
+
+void WaveformTileCache::prefetch(const TileKey& key)
+{
+    {
+        juce::ScopedLock lock(m_lock);
+        if (m_tileIndex.count(key) != 0)
+            return;
+
+        requestLocked(key);
+    }
+
+    m_thread->wake();
+}
+
+void WaveformTileCache::requestLocked(const TileKey& key)
+{
+    const auto matches = [&key](const PendingTile& p) { return p.key == key && ! p.stale; };
+
+    if (std::any_of(m_inFlight.begin(), m_inFlight.end(), matches))
+        return;
+
+    // Already queued: move it to the back so it is rendered next.
+    const auto queued = std::find_if(m_pending.begin(), m_pending.end(), matches);
+    if (queued != m_pending.end())
+    {
+        std::rotate(queued, queued + 1, m_pending.end());
+        return;
+    }
+
+    m_pending.push_back({ key, false });
+
+    // Tiles requested long ago are usually off screen or at an old zoom.
+    if (static_cast<int>(m_pending.size()) > kMaxPendingTiles)
+        m_pending.erase(m_pending.begin());
+}
+
+bool WaveformTileCache::takeNextRequest(TileKey& key)
+{
+    juce::ScopedLock lock(m_lock);
+
+    if (m_pending.empty())
+        return false;
+
+    m_inFlight.push_back(m_pending.back());
+    m_pending.pop_back();
+    key = m_inFlight.back().key;
+    return true;
+}
+
+void WaveformTileCache::storeRenderedTile(const TileKey& key, juce::Image image)
+{
+    juce::ScopedLock lock(m_lock);
+
+    const auto flight = std::find_if(m_inFlight.begin(), m_inFlight.end(),
+                                     [&key](const PendingTile& p) { return p.key == key; });
+    jassert(flight != m_inFlight.end());
+
+    const bool stale = flight == m_inFlight.end() || flight->stale;
+    if (flight != m_inFlight.end())
+        m_inFlight.erase(flight);
+
+    // The peaks changed under the renderer; the next paint asks again.
+    if (stale || ! image.isValid() || m_tileIndex.count(key) != 0)
+        return;
+
+    m_tiles.push_front({ key, image });
+    m_tileIndex[key] = m_tiles.begin();
+    m_cachedBytes += static_cast<int64_t>(image.getWidth()) * image.getHeight() * 4;
+
+    while (m_cachedBytes > kBudgetBytes && m_tiles.size() > 1)
+    {
+        const auto& oldest = m_tiles.back();
+        m_cachedBytes -= static_cast<int64_t>(oldest.image.getWidth()) * oldest.image.getHeight() * 4;
+        m_tileIndex.erase(oldest.key);
+        m_tiles.pop_back();
+    }
+}
+
+bool WaveformTileCache::overlaps(const TileKey& key, int64_t startSample, int64_t endSample)
+{
+    // One column of slack each side: getColumns() may merge a peak that
+    // straddles the tile edge.
+    const double tileStart = (static_cast<double>(key.index) * kTileWidth - 1.0) * key.samplesPerPixel;
+    const double tileEnd = (static_cast<double>(key.index + 1) * kTileWidth + 1.0) * key.samplesPerPixel;
+
+    return static_cast<double>(endSample) > tileStart && static_cast<double>(startSample) < tileEnd;
+}
+
+void WaveformTileCache::invalidateSamples(int64_t startSample, int64_t endSample)
+{
+    if (endSample <= startSample)
+        return;
+
+    juce::ScopedLock lock(m_lock);
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end();)
+    {
+        if (overlaps(it->key, startSample, endSample))
+        {
+            m_cachedBytes -= static_cast<int64_t>(it->image.getWidth()) * it->image.getHeight() * 4;
+            m_tileIndex.erase(it->key);
+            it = m_tiles.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto& pending : m_inFlight)
+        if (overlaps(pending.key, startSample, endSample))
+            pending.stale = true;
+}
+
+void WaveformTileCache::invalidateAll()
+{
+    juce::ScopedLock lock(m_lock);
+
+    m_tiles.clear();
+    m_tileIndex.clear();
+    m_pending.clear();
+    m_cachedBytes = 0;
+
+    for (auto& pending : m_inFlight)
+        pending.stale = true;
+}
+
+juce::Image WaveformTileCache::renderTile(const TileKey& key, std::vector<PeakPyramid::Peak>& scratch) const
+{
+    if (key.height <= 0 || key.samplesPerPixel <= 0.0)
+        return {};
+
+    scratch.resize(static_cast<size_t>(kTileWidth));
+
+    const double startSample = static_cast<double>(key.index) * kTileWidth * key.samplesPerPixel;
+    if (! m_source(key.channel, startSample, key.samplesPerPixel, kTileWidth, scratch.data()))
+        return {};
+
+    // Software image: this runs off the message thread.
+    juce::Image image(juce::Image::ARGB, kTileWidth, key.height, true, juce::SoftwareImageType());
+    juce::Graphics g(image);
+    drawPeakColumns(g, image.getBounds(), scratch.data(), kTileWidth, juce::Colour(key.colour));
+    return image;
+}
+
+double WaveformTileCache::quantiseSamplesPerPixel(double samplesPerPixel)
+{
+    int exponent = 0;
+    const double mantissa = std::frexp(samplesPerPixel, &exponent);
+    return std::ldexp(std::round(std::ldexp(mantissa, 30)), exponent - 30);
+}
+
+void WaveformTileCache::drawPeakColumns(juce::Graphics& g, juce::Rectangle<int> bounds,
+                                        const PeakPyramid::Peak* peaks, int numColumns, juce::Colour colour)
+{
+    const float centreY = static_cast<float>(bounds.getCentreY());
+    const float halfHeight = bounds.getHeight() * 0.5f;
+
+    juce::RectangleList<float> outline;
+    juce::RectangleList<float> core;
+    outline.ensureStorageAllocated(numColumns);
+    core.ensureStorageAllocated(numColumns);
+
+    for (int x = 0; x < numColumns; ++x)
+    {
+        const auto& peak = peaks[x];
+        const float columnX = static_cast<float>(bounds.getX() + x);
+
+        // Flipped Y axis: +1.0 is the top of the lane. At least one pixel
+        // tall so silence still shows as a line.
+        const float top = centreY - peak.maxValue * halfHeight;
+        const float bottom = centreY - peak.minValue * halfHeight;
+        outline.addWithoutMerging({ columnX, top, 1.0f, juce::jmax(1.0f, bottom - top) });
+
+        const float rmsHeight = peak.rms * halfHeight;
+        const float coreTop = juce::jmax(top, centreY - rmsHeight);
+        const float coreBottom = juce::jmin(bottom, centreY + rmsHeight);
+        if (coreBottom > coreTop)
+            core.addWithoutMerging({ columnX, coreTop, 1.0f, coreBottom - coreTop });
+    }
+
+    g.setColour(colour);
+    g.fillRectList(outline);
+    g.setColour(colour.brighter(0.5f));
+    g.fillRectList(core);
+}
@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    WaveformTileCache.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "../Audio/PeakPyramid.h"
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * Waveform images rasterised on a background thread, so painting a channel
+ * lane is a handful of image blits instead of one rectangle per column.
+ *
+ * The waveform at a given zoom is cut into tiles kTileWidth pixels wide,
+ * numbered from the start of the file: tile i covers the samples under
+ * absolute pixel columns [i * kTileWidth, (i + 1) * kTileWidth). A tile
+ * holds only the min/max outline and RMS core on a transparent background;
+ * lane backgrounds, labels and every overlay are still drawn live on top.
+ *
+ * getTile() returns a finished tile or queues it for the render thread
+ * (newest requests first) and returns a null image; the caller draws that
+ * span directly for this frame. Finished tiles are kept in an LRU cache
+ * bounded by kBudgetBytes. Edits call invalidateSamples(), which drops the
+ * tiles over the range and discards any of them still being rendered.
+ *
+ * The peaks are read through a ColumnSource callback, which is called on
+ * the render thread and must do its own locking. The tileReady callback
+ * also runs there, once per finished tile.
+ */
+class WaveformTileCache
+{
+public:
+    /** Width of one tile in pixel columns. */
+    static constexpr int kTileWidth = 256;
+
+    /** Image bytes kept before the least recently drawn tiles are dropped. */
+    static constexpr int64_t kBudgetBytes = 96 * 1024 * 1024;
+
+    /** Tiles still queued beyond this many are dropped, oldest first. */
+    static constexpr int kMaxPendingTiles = 128;
+
+    struct TileKey
+    {
+        int channel = 0;
+        double samplesPerPixel = 0.0;
+        int64_t index = 0;
+        int height = 0;
+        juce::uint32 colour = 0;
+
+        bool operator< (const TileKey& other) const;
+        bool operator== (const TileKey& other) const;
+    };
+
+    /**
+     * Fills dest with numColumns peaks for channel, column c covering
+     * samples from startSample + c * samplesPerColumn (see
+     * PeakPyramid::getColumns()). Returns false if there is nothing to draw.
+     */
+    using ColumnSource = std::function<bool(int channel, double startSample, double samplesPerColumn,
+                                            int numColumns, PeakPyramid::Peak* dest)>;
+
+    WaveformTileCache(ColumnSource source, std::function<void()> tileReady);
+    ~WaveformTileCache();
+
+    /**
+     * The rendered tile for key, or a null image after queueing it for the
+     * render thread. Message thread.
+     */
+    juce::Image getTile(const TileKey& key);
+
+    /** Queues key for rendering if it is neither cached nor pending. */
+    void prefetch(const TileKey& key);
+
+    /** Drops every tile showing any sample in [startSample, endSample). Any thread. */
+    void invalidateSamples(int64_t startSample, int64_t endSample);
+
+    /** Drops every tile. Any thread. */
+    void invalidateAll();
+
+    /**
+     * Rounds a zoom to 30 significant bits. The view's samples per pixel is
+     * recomputed from its start and end times on every scroll and jitters
+     * in the last few bits; keying tiles on the raw value would miss on
+     * every frame.
+     */
+    static double quantiseSamplesPerPixel(double samplesPerPixel);
+
+    /**
+     * Fills one rectangle per column for the min/max outline, then one for
+     * the RMS core over it. Shared by the tile renderer and direct drawing
+     * so both look identical.
+     */
+    static void drawPeakColumns(juce::Graphics& g, juce::Rectangle<int> bounds,
+                                const PeakPyramid::Peak* peaks, int numColumns, juce::Colour colour);
+
+private:
+    class RenderThread;
+
+    struct Tile
+    {
+        TileKey key;
+        juce::Image image;
+    };
+
+    struct PendingTile
+    {
+        TileKey key;
+        bool stale = false;  // Invalidated while rendering: discard the result
+    };
+
+    /** Whether key's tile shows any sample in [startSample, endSample). */
+    static bool overlaps(const TileKey& key, int64_t startSample, int64_t endSample);
+
+    /** Queues key unless it is cached or already pending. Caller holds m_lock. */
+    void requestLocked(const TileKey& key);
+
+    /** Takes the newest pending tile, or returns false if there is none. */
+    bool takeNextRequest(TileKey& key);
+
+    /** Stores a finished tile unless it went stale, then trims to budget. */
+    void storeRenderedTile(const TileKey& key, juce::Image image);
+
+    /** Rasterises key's tile. Render thread. */
+    juce::Image renderTile(const TileKey& key, std::vector<PeakPyramid::Peak>& scratch) const;
+
+    const ColumnSource m_source;
+    const std::function<void()> m_tileReady;
+
+    juce::CriticalSection m_lock;             // Guards everything below
+    std::list<Tile> m_tiles;                  // Most recently drawn first
+    std::map<TileKey, std::list<Tile>::iterator> m_tileIndex;
+    std::vector<PendingTile> m_pending;       // Oldest first; back is rendered next
+    std::vector<PendingTile> m_inFlight;      // Taken by the render thread, not yet stored
+    int64_t m_cachedBytes = 0;
+
+    std::unique_ptr<RenderThread> m_thread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformTileCache)
+};
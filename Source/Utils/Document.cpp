@@ -25,8 +25,52 @@
 #include "../Automation/AutomationRecorder.h"
 #include "../Plugins/PluginChain.h"
 #include "SidecarPolicy.h"
+#include "UndoAudioSpool.h"
+#include <atomic>
 #include <cmath>
 
+//==============================================================================
+class Document::WakeThread : public juce::Thread
+{
+public:
+    explicit WakeThread(AudioSnapshotPtr snapshot)
+        : juce::Thread("Document Wake"),
+          m_snapshot(std::move(snapshot))
+    {
+    }
+
+    ~WakeThread() override
+    {
+        // Checked between blocks, so this waits at most one block's read.
+        stopThread(10000);
+    }
+
+    bool isDone() const { return m_done.load(); }
+
+    void run() override
+    {
+        // Reading every frame once faults the mapped spill into the page
+        // cache, so the paints after the waveform takes it back don't stall.
+        const int64_t totalSamples = m_snapshot->getNumSamples();
+        juce::AudioBuffer<float> block(m_snapshot->getNumChannels(), kBlockSamples);
+
+        for (int64_t position = 0; position < totalSamples && ! threadShouldExit(); position += kBlockSamples)
+        {
+            const int numSamples = static_cast<int>(juce::jmin<int64_t>(kBlockSamples, totalSamples - position));
+            if (! m_snapshot->readRange(block, 0, position, numSamples))
+                break;
+        }
+
+        m_done.store(true);
+    }
+
+private:
+    static constexpr int kBlockSamples = 1 << 18;
+
+    const AudioSnapshotPtr m_snapshot;
+    std::atomic<bool> m_done { false };
+};
+
 Document::Document(const juce::File& file)
     : m_file(file),
       m_isModified(false),
@@ -76,6 +120,16 @@ Document::Document(const juce::File& file)
 
 Document::~Document()
 {
+    // Stop a background decode before the buffer manager it feeds goes away,
+    // and a page-in before the spill it maps is deleted.
+    cancelProgressiveLoad();
+    cancelWake();
+
+    // Unmap a hibernation spill before deleting it (Windows refuses to
+    // delete a mapped file).
+    m_bufferManager.clear();
+    releaseSpillFile(true);
+
     // Detach plugin-chain listener before tearing down so the
     // AutomationRecorder doesn't see a final change-broadcast during
     // destruction with half-destroyed members.
@@ -127,6 +181,9 @@ void Document::setModified(bool modified)
             getFilename().toRawUTF8(),
             modified ? "true" : "false"));
     }
+
+    if (modified)
+        notifyResidentAudioChanged();
 }
 
 bool Document::loadFile(const juce::File& file)
@@ -144,47 +201,67 @@ bool Document::loadFile(const juce::File& file)
         return false;
     }
 
-    // CRITICAL FIX: Load audio buffer into BufferManager (for editing)
-    if (!m_bufferManager.loadFromFile(file, m_audioEngine.getFormatManager()))
+    // A previous background load (if any) would append into the new file.
+    cancelProgressiveLoad();
+    cancelWake();
+
+    // CRITICAL FIX: Load audio buffer into BufferManager (for editing).
+    // PCM files are memory-mapped, which is instant. Everything else is
+    // decoded in the background so a long take doesn't freeze the UI; the
+    // decoder feeds both the buffer manager and the waveform peaks, so
+    // the file is decoded once rather than twice.
+    if (!m_bufferManager.loadMappedFile(file, m_audioEngine.getFormatManager()))
     {
-        juce::Logger::writeToLog("Error: Failed to load audio buffer for editing: " + file.getFullPathName());
-        m_audioEngine.closeAudioFile();
-        return false;
+        auto loader = std::make_unique<ProgressiveAudioLoader>();
+        if (!loader->start(file, m_audioEngine.getFormatManager()))
+        {
+            juce::Logger::writeToLog("Error: Failed to load audio buffer for editing: " + file.getFullPathName());
+            m_audioEngine.closeAudioFile();
+            return false;
+        }
+
+        m_bufferManager.beginIncrementalLoad(loader->getSampleRate(), loader->getBitsPerSample());
+        m_loader = std::move(loader);
     }
 
+    // The previous contents (and any hibernation spill) are gone.
+    releaseSpillFile(true);
+    m_isHibernated = false;
+    m_hibernatedWaveformCache = false;
+
     // Update file path
     m_file = file;
     m_isModified = false;
 
+    // The final length is known from the header even while decoding.
+    const double totalDuration = m_loader != nullptr
+        ? m_loader->getTotalSamples() / m_loader->getSampleRate()
+        : m_bufferManager.getLengthInSeconds();
+
     // Load waveform display
-    if (!m_waveformDisplay.loadFile(file, m_audioEngine.getSampleRate(), m_audioEngine.getNumChannels()))
+    if (m_loader != nullptr)
     {
-        juce::Logger::writeToLog("Warning: Failed to load waveform display for: " + file.getFullPathName());
+        m_waveformDisplay.beginProgressiveLoad(file, m_loader->getSampleRate(),
+                                               m_loader->getNumChannels(),
+                                               m_loader->getTotalSamples());
     }
-
-    // Sharp per-pixel rendering on load for reasonably-sized files (SFX/VO --
-    // the common case). Without this, a freshly-loaded file shows the coarse
-    // 512-sample AudioThumbnail until the first edit ("chunky" waveform). Huge
-    // files stay on the memory-light async thumbnail (the cached-buffer copy
-    // direct rendering needs would double their footprint).
+    else
     {
-        const auto& loadedBuffer = m_bufferManager.getBuffer();
-        constexpr int64_t kDirectRenderMaxSamples = 20000000; // ~7 min mono @48k
-        if (loadedBuffer.getNumSamples() > 0
-            && static_cast<int64_t>(loadedBuffer.getNumSamples()) <= kDirectRenderMaxSamples)
+        if (!m_waveformDisplay.loadFile(file, m_audioEngine.getSampleRate(), m_audioEngine.getNumChannels()))
         {
-            m_waveformDisplay.reloadFromBuffer(loadedBuffer, m_audioEngine.getSampleRate(),
-                                               false, false);
+            juce::Logger::writeToLog("Warning: Failed to load waveform display for: " + file.getFullPathName());
         }
+
+        enableDirectRendering(false);
     }
 
     m_waveformDisplay.clearSelection();
 
     // Initialize region display (Phase 3 Tier 2)
     m_regionDisplay.setSampleRate(m_audioEngine.getSampleRate());
-    m_regionDisplay.setTotalDuration(m_bufferManager.getLengthInSeconds());
-    m_regionDisplay.setVisibleRange(0.0, m_bufferManager.getLengthInSeconds());
-    m_regionDisplay.setAudioBuffer(&m_bufferManager.getBuffer());  // Phase 3.3 - For zero-crossing snap
+    m_regionDisplay.setTotalDuration(totalDuration);
+    m_regionDisplay.setVisibleRange(0.0, totalDuration);
+    m_regionDisplay.setBufferManager(&m_bufferManager);  // Phase 3.3 - For zero-crossing snap
 
     // Regions + markers are loaded together below (loadRegionsAndMarkers) so the
     // sidecar/embedded-cue precedence is applied consistently to both.
@@ -194,8 +271,8 @@ bool Document::loadFile(const juce::File& file)
 
     // Initialize marker display (Phase 3.4)
     m_markerDisplay.setSampleRate(m_audioEngine.getSampleRate());
-    m_markerDisplay.setTotalDuration(m_bufferManager.getLengthInSeconds());
-    m_markerDisplay.setVisibleRange(0.0, m_bufferManager.getLengthInSeconds());
+    m_markerDisplay.setTotalDuration(totalDuration);
+    m_markerDisplay.setVisibleRange(0.0, totalDuration);
 
     // Load regions + markers, applying sidecar/embedded-cue precedence:
     //   - sidecar present and fresh  -> sidecar wins
@@ -247,14 +324,277 @@ bool Document::loadFile(const juce::File& file)
     // Clear undo history for new file
     m_undoManager.clearUndoHistory();
 
+    // Poll the background decoder; timerCallback() finishes the load.
+    if (m_loader != nullptr)
+        startTimerHz(20);
+
     DBG("Document loaded: " + file.getFullPathName());
     return true;
 }
 
+void Document::timerCallback()
+{
+    if (m_wakeThread != nullptr && m_wakeThread->isDone())
+        finishWake();
+
+    if (m_loader == nullptr)
+    {
+        if (m_wakeThread == nullptr)
+            stopTimer();
+        return;
+    }
+
+    for (auto& block : m_loader->takeDecodedBlocks())
+    {
+        m_waveformDisplay.addLoadedBlock(block.startSample, *block.audio);
+        m_bufferManager.appendLoadedAudio(block.pieces);
+    }
+
+    m_waveformDisplay.setLoadProgress(m_loader->getProgress());
+
+    if (m_loader->isFinished())
+        finishProgressiveLoad();
+}
+
+void Document::finishProgressiveLoad()
+{
+    stopTimer();
+
+    const bool failed = m_loader->hasFailed();
+    const double expectedDuration = m_loader->getTotalSamples() / m_loader->getSampleRate();
+    m_loader.reset();
+
+    m_waveformDisplay.setLoadProgress(-1.0);
+
+    if (!failed)
+        m_waveformDisplay.savePeakFile(m_file);
+
+    if (failed)
+    {
+        // Keep what was decoded, but say so: saving would otherwise silently
+        // truncate the file.
+        const double loadedDuration = m_bufferManager.getLengthInSeconds();
+        juce::Logger::writeToLog("Warning: Decoding stopped early for " + m_file.getFullPathName());
+        juce::AlertWindow::showMessageBoxAsync(
+            juce::AlertWindow::WarningIcon,
+            "Incomplete File",
+            "Only the first " + juce::String(loadedDuration, 1) + " of "
+                + juce::String(expectedDuration, 1) + " seconds of " + m_file.getFileName()
+                + " could be decoded.",
+            "OK");
+
+        m_regionDisplay.setTotalDuration(loadedDuration);
+        m_markerDisplay.setTotalDuration(loadedDuration);
+    }
+
+    enableDirectRendering(true);
+    notifyResidentAudioChanged();
+
+    DBG("Document background load finished: " + m_file.getFullPathName());
+}
+
+void Document::notifyResidentAudioChanged()
+{
+    if (onResidentAudioChanged)
+        onResidentAudioChanged();
+}
+
+void Document::cancelProgressiveLoad()
+{
+    stopTimer();
+    m_loader.reset();  // joins the decoder thread
+    m_waveformDisplay.setLoadProgress(-1.0);
+}
+
+void Document::enableDirectRendering(bool preserveView)
+{
+    // Sample-level detail on load. Without this, a freshly-loaded file is
+    // drawn from its peaks alone until the first edit, which stop at
+    // 64-sample resolution when zoomed right in. The display shares the
+    // document's pieces and keeps the peaks it already has, so this costs
+    // no copy even for huge or memory-mapped files.
+    if (m_bufferManager.getNumSamples() <= 0)
+        return;
+
+    reloadWaveformCache(preserveView);
+}
+
+void Document::reloadWaveformCache(bool preserveView)
+{
+    // The snapshot shares the store's pieces -- float, packed or mapped --
+    // and the display reads peaks through its range reader, so nothing is
+    // flattened or copied into RAM to draw it.
+    if (auto snapshot = m_bufferManager.getSnapshot())
+        m_waveformDisplay.reloadFromSnapshot(snapshot, preserveView, preserveView, true);
+}
+
+//==============================================================================
+// Hibernation
+
+int64_t Document::getResidentAudioBytes() const
+{
+    // The waveform and playback share the store's chunks through snapshots
+    // (see reloadWaveformCache()), so the store's bytes are the whole cost
+    // of the current audio.
+    int64_t bytes = m_bufferManager.getResidentBytes();
+
+    if (auto* spool = UndoAudioSpool::getInstance())
+        bytes += spool->getResidentBytes(m_bufferManager);
+
+    return bytes;
+}
+
+bool Document::canHibernate() const
+{
+    return !m_isHibernated
+        && !isLoading()
+        && !m_audioEngine.isPlaying()
+        && m_bufferManager.hasAudioData();
+}
+
+bool Document::hibernate()
+{
+    if (!canHibernate())
+        return false;
+
+    // A wake still paging in has left the waveform detached.
+    cancelWake();
+
+    // Playback and the waveform let go of their snapshots first, so once
+    // the spill is mapped nothing else holds the in-memory chunks.
+    const bool engineBuffer = m_audioEngine.isPlayingFromBuffer();
+    if (engineBuffer)
+        m_audioEngine.releasePlaybackBuffer();
+
+    const bool waveformCache = m_waveformDisplay.releaseCachedBuffer() || m_hibernatedWaveformCache;
+
+    // A previous spill may have been read back into RAM since.
+    releaseSpillFile(false);
+
+    // Only in-memory audio needs spilling; a mapped original file already
+    // costs no RAM.
+    if (m_bufferManager.getResidentBytes() > 0)
+    {
+        auto spillDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                            .getChildFile("WaveEdit").getChildFile("Hibernation");
+        spillDir.createDirectory();
+
+        const auto spillFile = spillDir.getNonexistentChildFile("document", ".wav", false);
+        if (!m_bufferManager.spillToFile(spillFile))
+        {
+            spillFile.deleteFile();
+            juce::Logger::writeToLog("Warning: Could not hibernate " + m_file.getFileName());
+
+            // Still in RAM after all: hand the samples back.
+            if (engineBuffer)
+                m_audioEngine.reloadSnapshotPreservingPlayback(m_bufferManager.getSnapshot());
+
+            if (waveformCache)
+                reloadWaveformCache(true);
+
+            m_hibernatedWaveformCache = false;
+            return false;
+        }
+
+        releaseSpillFile(true);
+        m_spillFile = spillFile;
+    }
+
+    m_hibernatedEngineBuffer = engineBuffer;
+    m_hibernatedWaveformCache = waveformCache;
+    m_isHibernated = true;
+
+    DBG("Document hibernated: " + m_file.getFileName());
+    return true;
+}
+
+void Document::wake()
+{
+    if (!m_isHibernated)
+        return;
+
+    m_isHibernated = false;
+
+    // Playback reads a file-backed snapshot ahead on its own thread, so it
+    // can have the samples straight away.
+    auto snapshot = m_bufferManager.getSnapshot();
+    if (m_hibernatedEngineBuffer)
+        m_audioEngine.reloadSnapshotPreservingPlayback(snapshot);
+
+    // The waveform paints on the message thread; it keeps drawing from its
+    // peaks until the spill is back in the page cache.
+    if (m_hibernatedWaveformCache && snapshot != nullptr && snapshot->isFileBacked())
+    {
+        m_wakeThread = std::make_unique<WakeThread>(std::move(snapshot));
+        m_wakeThread->startThread();
+        startTimerHz(20);
+        return;
+    }
+
+    finishWake();
+}
+
+void Document::finishWake()
+{
+    m_wakeThread.reset();
+
+    // The snapshot reads the spill where it is mapped; the spill stays until
+    // the document is hibernated again or closed.
+    if (m_hibernatedWaveformCache)
+        reloadWaveformCache(true);
+
+    m_hibernatedWaveformCache = false;
+    releaseSpillFile(false);
+    notifyResidentAudioChanged();
+
+    DBG("Document woken: " + m_file.getFileName());
+}
+
+void Document::cancelWake()
+{
+    m_wakeThread.reset();  // joins the page-in
+}
+
+bool Document::loadRecordedTake(const juce::File& takeFile)
+{
+    if (!loadFile(takeFile))
+        return false;
+
+    // Not the user's file: save must ask for a name, and the take goes
+    // away with the last mapping of it.
+    m_file = juce::File();
+    m_isModified = true;
+    m_spillFile = takeFile;
+    notifyResidentAudioChanged();
+    return true;
+}
+
+void Document::releaseSpillFile(bool force)
+{
+    if (m_spillFile == juce::File())
+        return;
+
+    if (!force && m_bufferManager.isFileBacked())
+        return;
+
+    m_spillFile.deleteFile();
+    m_spillFile = juce::File();
+}
+
+int64_t Document::getFinalNumSamples() const
+{
+    return m_loader != nullptr ? m_loader->getTotalSamples() : m_bufferManager.getNumSamples();
+}
+
 void Document::closeFile()
 {
+    cancelProgressiveLoad();
+    cancelWake();
     m_audioEngine.closeAudioFile();
     m_bufferManager.clear();
+    releaseSpillFile(true);
+    m_isHibernated = false;
+    m_hibernatedWaveformCache = false;
     m_waveformDisplay.clear();
     m_waveformDisplay.clearSelection();
     m_undoManager.clearUndoHistory();
@@ -268,6 +608,13 @@ void Document::closeFile()
 
 bool Document::saveFile(const juce::File& file, int bitDepth, int quality, double targetSampleRate)
 {
+    // A partially decoded document would be written out truncated.
+    if (isLoading())
+    {
+        juce::Logger::writeToLog("Error: Cannot save while the file is still loading");
+        return false;
+    }
+
     // Validate parameters
     if (!file.getParentDirectory().exists())
     {
@@ -287,11 +634,35 @@ bool Document::saveFile(const juce::File& file, int bitDepth, int quality, doubl
         return false;
     }
 
-    // Get audio buffer and sample rate from buffer manager
-    const juce::AudioBuffer<float>& buffer = m_bufferManager.getBuffer();
+    // Overwriting the source file: unedited ranges are still read from a
+    // mapping of it, so pull them into RAM and move playback and the display
+    // onto the detached audio before the file is replaced.
+    if (file == m_file && m_bufferManager.isFileBacked())
+    {
+        if (!m_bufferManager.detachFromMappedFile())
+        {
+            juce::Logger::writeToLog("Error: Could not read the source file before overwriting it");
+            return false;
+        }
+
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.reloadSnapshotPreservingPlayback(snapshot);
+        m_waveformDisplay.reloadFromSnapshot(snapshot, true, true, true);
+    }
+    else if (!m_audioEngine.isPlayingFromBuffer() && m_audioEngine.getCurrentFile() == file)
+    {
+        // An unedited document may still stream playback from its source
+        // file; move the transport onto the buffer before replacing it.
+        m_audioEngine.reloadSnapshotPreservingPlayback(m_bufferManager.getSnapshot());
+    }
+
+    // Stream the document out of an immutable snapshot in bounded blocks
+    // rather than flattening it, so long documents (past INT_MAX samples
+    // included) save without a second full copy in RAM.
+    const auto snapshot = m_bufferManager.getSnapshot();
     double sourceSampleRate = m_audioEngine.getSampleRate();
 
-    if (buffer.getNumSamples() == 0)
+    if (snapshot == nullptr || snapshot->getNumSamples() == 0)
     {
         juce::Logger::writeToLog("Error: No audio data to save");
         return false;
@@ -300,22 +671,15 @@ bool Document::saveFile(const juce::File& file, int bitDepth, int quality, doubl
     // Determine final sample rate
     double finalSampleRate = (targetSampleRate > 0.0) ? targetSampleRate : sourceSampleRate;
 
-    // Resample if necessary
-    juce::AudioBuffer<float> bufferToSave;
+    // Resample on the fly if necessary
+    auto source = AudioBlockSource::fromSnapshot(snapshot);
     const bool isRateConverting = targetSampleRate > 0.0
                                 && std::abs(targetSampleRate - sourceSampleRate) > 0.01;
     if (isRateConverting)
     {
         DBG("Resampling from " + juce::String(sourceSampleRate, 0) +
                                  " Hz to " + juce::String(targetSampleRate, 0) + " Hz");
-        bufferToSave = AudioFileManager::resampleBuffer(buffer, sourceSampleRate, targetSampleRate);
-    }
-    else
-    {
-        // No resampling needed - create copy of buffer
-        bufferToSave.setSize(buffer.getNumChannels(), buffer.getNumSamples());
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            bufferToSave.copyFrom(ch, 0, buffer, ch, 0, buffer.getNumSamples());
+        source = AudioBlockSource::resampled(std::move(source), sourceSampleRate, targetSampleRate);
     }
 
     // Cue/sidecar positions are still expressed in source-rate samples (the
@@ -349,7 +713,7 @@ bool Document::saveFile(const juce::File& file, int bitDepth, int quality, doubl
 
     // Use the universal saveAudioFile method which auto-detects format
     // For WAV files, this will use saveAsWav/overwriteFile internally
-    bool success = fileManager.saveAudioFile(file, bufferToSave, finalSampleRate, bitDepth, quality, metadata);
+    bool success = fileManager.saveAudioFile(file, source, finalSampleRate, bitDepth, quality, metadata);
 
     if (success)
     {
@@ -387,6 +751,11 @@ bool Document::saveFile(const juce::File& file, int bitDepth, int quality, doubl
             }
         }
 
+        // The displayed peaks now describe this file (a rate-converted
+        // copy has a different length, so there is nothing to reuse).
+        if (!isRateConverting)
+            m_waveformDisplay.savePeakFile(file);
+
         // Update document state
         m_file = file;
         m_isModified = false;
@@ -442,7 +811,7 @@ void Document::loadRegionsAndMarkers(const juce::File& file)
     }
 
     // A sidecar is present -- it is the richer store, so it wins by default.
-    const int64_t totalSamples = m_bufferManager.getBuffer().getNumSamples();
+    const int64_t totalSamples = getFinalNumSamples();
     m_regionManager.loadFromFile(file, totalSamples);
     m_markerManager.loadFromFile(file, totalSamples);
 
@@ -461,7 +830,7 @@ void Document::loadRegionsAndMarkers(const juce::File& file)
 
 void Document::importEmbeddedCues(const WavCueData& cues)
 {
-    const int64_t totalSamples = m_bufferManager.getBuffer().getNumSamples();
+    const int64_t totalSamples = getFinalNumSamples();
 
     m_regionManager.removeAllRegions();
     m_markerManager.removeAllMarkers();
@@ -26,6 +26,7 @@
 #include <juce_audio_formats/juce_audio_formats.h>
 #include "../Audio/AudioEngine.h"
 #include "../Audio/AudioBufferManager.h"
+#include "../Audio/ProgressiveAudioLoader.h"
 #include "../UI/WaveformDisplay.h"
 #include "../UI/TransportControls.h"
 #include "RegionManager.h"
@@ -54,7 +55,8 @@
  *
  * Thread Safety: All methods must be called from the message thread only.
  */
-class Document : private juce::ChangeListener
+class Document : private juce::ChangeListener,
+                 private juce::Timer
 {
 public:
     /**
@@ -245,11 +247,79 @@ public:
     /**
      * Loads an audio file into this document.
      *
+     * Memory-mappable files (PCM WAV/AIFF) are ready when this returns.
+     * Other formats are decoded on a background thread: the document opens
+     * immediately, the waveform fills in as audio arrives, and playback
+     * streams from the file in the meantime. isLoading() is true until the
+     * decode finishes; editing commands are disabled until then.
+     *
      * @param file The audio file to load
-     * @return true if load successful, false on error
+     * @return true if load successful (or started), false on error
      */
     bool loadFile(const juce::File& file);
 
+    /**
+     * Opens a finished recording (RecordingEngine::releaseTakeFile()) as an
+     * untitled, modified document. The take is memory-mapped like any PCM
+     * WAV, so a take of any length opens without being read into RAM. The
+     * document owns the file from then on and deletes it once nothing maps
+     * it any more (or on close).
+     *
+     * @return false if the take could not be opened; it is left on disk
+     */
+    bool loadRecordedTake(const juce::File& takeFile);
+
+    /** True while a background decode started by loadFile() is running. */
+    bool isLoading() const { return m_loader != nullptr; }
+
+    /** Fraction of the file decoded so far; 1.0 when not loading. */
+    double getLoadProgress() const { return m_loader != nullptr ? m_loader->getProgress() : 1.0; }
+
+    //==============================================================================
+    // Hibernation (see DocumentManager::enforceMemoryBudget)
+
+    /**
+     * Approximate RAM held by this document's audio: the sample store
+     * (which playback and the waveform share) plus the undo history's
+     * payloads that UndoAudioSpool has not spilled.
+     */
+    int64_t getResidentAudioBytes() const;
+
+    /** True if hibernate() may run now (loaded, idle, not already hibernated). */
+    bool canHibernate() const;
+
+    /**
+     * Frees the document's audio RAM while keeping everything else (undo
+     * history, regions, view, selection, modified flag). In-memory audio is
+     * spilled to a temporary file and memory-mapped; playback and waveform
+     * buffers are released first, so the spill is the last holder of the
+     * samples. Call wake() before the document is shown again.
+     *
+     * @return false if nothing was released
+     */
+    bool hibernate();
+
+    /**
+     * Restores playback after hibernate() and returns at once. The spill is
+     * paged back in on a background thread; the waveform draws from its
+     * peaks until then and takes the samples back when it is done, so the
+     * message thread never waits on the disk.
+     */
+    void wake();
+
+    bool isHibernated() const { return m_isHibernated; }
+
+    /** True from wake() until the background page-in has finished. */
+    bool isWaking() const { return m_wakeThread != nullptr; }
+
+    /**
+     * Called on the message thread when the resident audio may have grown:
+     * after an edit (setModified(true)), a recorded take loading, or a
+     * background load or wake finishing. DocumentManager re-checks its
+     * memory budget from here.
+     */
+    std::function<void()> onResidentAudioChanged;
+
     /**
      * Saves the current audio buffer to a file with BWF metadata.
      *
@@ -337,9 +407,60 @@ private:
     bool m_sidecarConflict = false;
     bool m_sidecarRequirementAnnounced = false;
 
+    // Background decode of a non-mappable file; nullptr once loaded.
+    std::unique_ptr<ProgressiveAudioLoader> m_loader;
+
+    // Hibernation state: what was released, and the spill file (if any) the
+    // buffer manager may still be mapping. A recorded take the document was
+    // opened from is owned the same way (see loadRecordedTake()).
+    bool m_isHibernated = false;
+    bool m_hibernatedEngineBuffer = false;
+    bool m_hibernatedWaveformCache = false;
+    juce::File m_spillFile;
+
+    /** Reads a woken document's spill back into the page cache (see wake()). */
+    class WakeThread;
+    std::unique_ptr<WakeThread> m_wakeThread;
+
     /** Refresh AutomationRecorder dispatchers when the plugin chain changes. */
     void changeListenerCallback(juce::ChangeBroadcaster* source) override;
 
+    /**
+     * Moves decoded blocks from m_loader into the buffer manager and
+     * waveform, and finishes a wake() whose page-in is done.
+     */
+    void timerCallback() override;
+
+    /** Gives the waveform its samples back once m_wakeThread is done. */
+    void finishWake();
+
+    /** Stops a running page-in; the waveform stays detached (hibernate, close, reload). */
+    void cancelWake();
+
+    /** Called once the background decode has delivered its last block. */
+    void finishProgressiveLoad();
+
+    /** Invokes onResidentAudioChanged, if set. */
+    void notifyResidentAudioChanged();
+
+    /** Stops a running background decode (closing the tab, loading another file). */
+    void cancelProgressiveLoad();
+
+    /** Document length in samples, counting audio a background load has yet to deliver. */
+    int64_t getFinalNumSamples() const;
+
+    /**
+     * Sharp per-pixel rendering once the audio is loaded; see loadFile().
+     * preserveView keeps the zoom/scroll the user chose during a background load.
+     */
+    void enableDirectRendering(bool preserveView);
+
+    /** Shares the current audio with the waveform for direct rendering. */
+    void reloadWaveformCache(bool preserveView);
+
+    /** Deletes m_spillFile once the buffer manager no longer maps it (or force). */
+    void releaseSpillFile(bool force);
+
     /** Load regions+markers with sidecar/embedded-cue precedence (see .cpp). */
     void loadRegionsAndMarkers(const juce::File& file);
 
@@ -21,6 +21,8 @@
 */
 
 #include "DocumentManager.h"
+#include "Settings.h"
+#include <limits>
 
 DocumentManager::DocumentManager()
     : m_currentDocumentIndex(-1),
@@ -31,6 +33,7 @@ DocumentManager::DocumentManager()
 
 DocumentManager::~DocumentManager()
 {
+    cancelPendingUpdate();
     closeAllDocuments();
 }
 
@@ -41,6 +44,8 @@ Document* DocumentManager::createDocument()
 {
     auto* document = new Document();
     m_documents.add(document);
+    m_viewOrder.add(document);
+    watchResidentAudio(document);
 
     int newIndex = m_documents.size() - 1;
     notifyDocumentAdded(document, newIndex);
@@ -86,6 +91,8 @@ Document* DocumentManager::openDocument(const juce::File& file)
     }
 
     m_documents.add(document);
+    m_viewOrder.add(document);
+    watchResidentAudio(document);
 
     int newIndex = m_documents.size() - 1;
     notifyDocumentAdded(document, newIndex);
@@ -118,6 +125,7 @@ bool DocumentManager::closeDocumentAt(int index)
 
     // Notify before removal
     notifyDocumentRemoved(document, index);
+    m_viewOrder.removeFirstMatchingValue(document);
 
     // Remove document (this will delete it)
     m_documents.remove(index);
@@ -200,6 +208,16 @@ bool DocumentManager::setCurrentDocumentIndex(int index)
     }
 
     m_currentDocumentIndex = index;
+
+    // Bring a hibernated document back before anything shows or plays it
+    // (its samples page back in on a background thread), then make room
+    // for it.
+    auto* newDoc = m_documents[index];
+    newDoc->wake();
+    m_viewOrder.removeFirstMatchingValue(newDoc);
+    m_viewOrder.add(newDoc);
+    enforceMemoryBudget();
+
     notifyCurrentDocumentChanged();
 
     DBG("Switched to document at index " + juce::String(index));
@@ -269,6 +287,64 @@ bool DocumentManager::selectDocumentByNumber(int number)
     return setCurrentDocumentIndex(index);
 }
 
+//==============================================================================
+// Memory Budget
+
+void DocumentManager::enforceMemoryBudget()
+{
+    const int64_t budgetMB = static_cast<juce::int64>(
+        Settings::getInstance().getSetting("memory.budgetMB", kDefaultMemoryBudgetMB));
+    if (budgetMB <= 0)
+        return;
+
+    const int64_t budgetBytes = budgetMB * 1024 * 1024;
+    int64_t residentBytes = getResidentAudioBytes();
+    if (residentBytes <= budgetBytes)
+        return;
+
+    const auto* current = getCurrentDocument();
+
+    // Least recently viewed first.
+    for (auto* doc : m_viewOrder)
+    {
+        if (residentBytes <= budgetBytes)
+            break;
+
+        if (doc == current || !doc->canHibernate())
+            continue;
+
+        const int64_t before = doc->getResidentAudioBytes();
+        if (doc->hibernate())
+            residentBytes -= before - doc->getResidentAudioBytes();
+    }
+
+    DBG(juce::String::formatted("Memory budget: %lld MB resident of %lld MB",
+                                static_cast<long long>(residentBytes / (1024 * 1024)),
+                                static_cast<long long>(budgetMB)));
+}
+
+void DocumentManager::watchResidentAudio(Document* document)
+{
+    // Edits, recordings, background loads and wakes all grow what is
+    // resident; check the budget once the current callback has finished
+    // rather than hibernating a document from inside its own callback.
+    document->onResidentAudioChanged = [this]() { triggerAsyncUpdate(); };
+}
+
+void DocumentManager::handleAsyncUpdate()
+{
+    enforceMemoryBudget();
+}
+
+int64_t DocumentManager::getResidentAudioBytes() const
+{
+    int64_t total = 0;
+    for (auto* doc : m_documents)
+        total += doc->getResidentAudioBytes();
+
+    return total;
+}
+
 //==============================================================================
 // Inter-File Clipboard
 
@@ -302,9 +378,9 @@ bool DocumentManager::pasteFromInterFileClipboard(Document* targetDoc, double po
     auto& bufferManager = targetDoc->getBufferManager();
     double targetSampleRate = bufferManager.getSampleRate();
 
-    // Check if target document has a valid buffer initialized
-    const auto& targetBuffer = bufferManager.getBuffer();
-    if (targetBuffer.getNumSamples() == 0 || targetBuffer.getNumChannels() == 0)
+    // Check if target document has audio loaded. Only the length and
+    // channel count are needed, so the document is never flattened.
+    if (bufferManager.getNumSamples() == 0 || bufferManager.getNumChannels() == 0)
     {
         juce::Logger::writeToLog("Cannot paste into uninitialized document (no buffer)");
         return false;
@@ -314,7 +390,7 @@ bool DocumentManager::pasteFromInterFileClipboard(Document* targetDoc, double po
     int64_t insertSample = static_cast<int64_t>(position * targetSampleRate);
 
     // Get target channel count for conversion if needed
-    int targetChannels = targetBuffer.getNumChannels();
+    int targetChannels = bufferManager.getNumChannels();
 
     // Prepare audio to paste (handle sample rate conversion if needed)
     juce::AudioBuffer<float> audioToPaste;
@@ -328,7 +404,13 @@ bool DocumentManager::pasteFromInterFileClipboard(Document* targetDoc, double po
     {
         // Sample rates differ - need conversion
         double ratio = targetSampleRate / m_interFileClipboardSampleRate;
-        int newNumSamples = static_cast<int>(m_interFileClipboard.getNumSamples() * ratio);
+        const int64_t convertedLength = static_cast<int64_t>(m_interFileClipboard.getNumSamples() * ratio);
+        if (convertedLength > std::numeric_limits<int>::max())
+        {
+            juce::Logger::writeToLog("Cannot paste: clipboard audio is too long after sample rate conversion");
+            return false;
+        }
+        const int newNumSamples = static_cast<int>(convertedLength);
 
         audioToPaste.setSize(m_interFileClipboard.getNumChannels(), newNumSamples, false, false, false);
 
@@ -422,8 +504,7 @@ bool DocumentManager::pasteFromInterFileClipboard(Document* targetDoc, double po
 
     // Reload the audio engine buffer to reflect the changes
     auto& audioEngine = targetDoc->getAudioEngine();
-    const auto& updatedBuffer = bufferManager.getBuffer();
-    audioEngine.loadFromBuffer(updatedBuffer, targetSampleRate, updatedBuffer.getNumChannels());
+    audioEngine.loadFromSnapshot(bufferManager.getSnapshot());
 
     DBG(juce::String::formatted(
         "Pasted %.2f seconds of audio at position %.2f seconds (sample rate conversion: %.0f Hz → %.0f Hz)",
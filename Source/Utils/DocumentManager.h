@@ -39,6 +39,11 @@
  * The manager ensures only one document is "active" at a time, which determines
  * which document's UI components are visible and which receives input.
  *
+ * Memory: when the audio held by all documents -- their samples plus the
+ * undo payloads still in RAM -- exceeds the "memory.budgetMB" setting, the
+ * least recently viewed tabs are hibernated (Document::hibernate) and woken
+ * again when selected.
+ *
  * Thread Safety: All methods must be called from the message thread only.
  *
  * Usage Example:
@@ -50,7 +55,7 @@
  * docMgr.closeDocument(doc);
  * ```
  */
-class DocumentManager
+class DocumentManager : private juce::AsyncUpdater
 {
 public:
     /**
@@ -239,6 +244,23 @@ public:
      */
     bool selectDocumentByNumber(int number);
 
+    //==============================================================================
+    // Memory Budget
+
+    /** Default for the "memory.budgetMB" setting; 0 disables hibernation. */
+    static constexpr int kDefaultMemoryBudgetMB = 4096;
+
+    /**
+     * Hibernates least-recently-viewed documents (never the current one)
+     * until the total resident audio fits the budget. Runs on open and tab
+     * switch, and shortly after any document reports that its resident
+     * audio may have grown (Document::onResidentAudioChanged).
+     */
+    void enforceMemoryBudget();
+
+    /** Sum of Document::getResidentAudioBytes() over all open documents. */
+    int64_t getResidentAudioBytes() const;
+
     //==============================================================================
     // Inter-File Clipboard
 
@@ -296,6 +318,9 @@ private:
     juce::OwnedArray<Document> m_documents;
     int m_currentDocumentIndex;
 
+    // Documents by last view, least recent first (hibernation order)
+    juce::Array<Document*> m_viewOrder;
+
     // Inter-file clipboard
     juce::AudioBuffer<float> m_interFileClipboard;
     double m_interFileClipboardSampleRate;
@@ -305,6 +330,8 @@ private:
     juce::ListenerList<Listener> m_listeners;
 
     // Helper methods
+    void watchResidentAudio(Document* document);
+    void handleAsyncUpdate() override;
     void notifyCurrentDocumentChanged();
     void notifyDocumentAdded(Document* document, int index);
     void notifyDocumentRemoved(Document* document, int index);
@@ -670,6 +670,7 @@ juce::String KeymapManager::getCommandName(juce::CommandID commandID)
         commandNameMap[CommandIDs::viewAutoPreviewRegions] = "viewAutoPreviewRegions";
         commandNameMap[CommandIDs::viewToggleRegions] = "viewToggleRegions";
         commandNameMap[CommandIDs::viewSpectrumAnalyzer] = "viewSpectrumAnalyzer";
+        commandNameMap[CommandIDs::viewSpectrogram] = "viewSpectrogram";
 
         // Processing operations
         commandNameMap[CommandIDs::processFadeIn] = "processFadeIn";
@@ -682,6 +683,7 @@ juce::String KeymapManager::getCommandName(juce::CommandID commandID)
         commandNameMap[CommandIDs::processGraphicalEQ] = "processGraphicalEQ";
         commandNameMap[CommandIDs::processReverse] = "processReverse";
         commandNameMap[CommandIDs::processInvert] = "processInvert";
+        commandNameMap[CommandIDs::processSwapChannels] = "processSwapChannels";
         commandNameMap[CommandIDs::processResample] = "processResample";
         commandNameMap[CommandIDs::processTimeStretch] = "processTimeStretch";
         commandNameMap[CommandIDs::processPitchShift] = "processPitchShift";
@@ -827,6 +829,7 @@ juce::CommandID KeymapManager::getCommandID(const juce::String& commandName)
             CommandIDs::viewCycleTimeFormat, CommandIDs::viewAutoScroll,
             CommandIDs::viewZoomToRegion, CommandIDs::viewAutoPreviewRegions,
             CommandIDs::viewToggleRegions, CommandIDs::viewSpectrumAnalyzer,
+            CommandIDs::viewSpectrogram,
 
             // Processing operations (0x5000-0x50FF)
             CommandIDs::processFadeIn, CommandIDs::processFadeOut,
@@ -836,6 +839,7 @@ juce::CommandID KeymapManager::getCommandID(const juce::String& commandName)
             CommandIDs::processGraphicalEQ, CommandIDs::processReverse,
             CommandIDs::processInvert, CommandIDs::processResample,
             CommandIDs::processTimeStretch, CommandIDs::processPitchShift,
+            CommandIDs::processSwapChannels,
 
             // Navigation operations (0x6000-0x60FF)
             CommandIDs::navigateLeft, CommandIDs::navigateRight,
@@ -0,0 +1,336 @@
+/*
+  ==============================================================================
+
+    PeakFileCache.cpp
+    Copyright (C) 2025 ZQ SFX
+
+  ==============================================================================
+*/
+
+#include "PeakFileCache.h"
+#include <juce_events/juce_events.h>
+#include "Settings.h"
+#include "../Audio/PeakPyramid.h"
+#include "../Audio/SpectrogramCache.h"
+
+namespace PeakFileCache
+{
+
+namespace
+{
+    // Fingerprint sampling: the first kHeaderBytes (the format header and
+    // any metadata chunks) are hashed in full, then kNumSampledBlocks blocks
+    // spread evenly over the file, last included. Small files are hashed
+    // whole.
+    constexpr int kHeaderBytes = 64 * 1024;
+    constexpr int kNumSampledBlocks = 16;
+    constexpr int kSampledBlockBytes = 16 * 1024;
+
+    // Read size of the background full-content hash.
+    constexpr int kVerifyBlockBytes = 1 << 20;
+
+    constexpr uint64_t kHashSeed = 0xcbf29ce484222325ull;
+
+    juce::ThreadPool& getWriterPool()
+    {
+        static juce::ThreadPool pool(1);
+        return pool;
+    }
+
+    // 64-bit FNV-1a: fast, and collisions only matter between files of
+    // identical size and timestamp anyway.
+    void addToHash(uint64_t& hash, const void* data, size_t numBytes)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < numBytes; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+    }
+
+    juce::String toHex(uint64_t hash)
+    {
+        return juce::String::toHexString(static_cast<juce::int64>(hash));
+    }
+
+    juce::String computeContentKey(const juce::File& audioFile)
+    {
+        juce::FileInputStream in(audioFile);
+        if (! in.openedOk())
+            return {};
+
+        const int64_t size = in.getTotalLength();
+        const juce::int64 modified = audioFile.getLastModificationTime().toMilliseconds();
+        uint64_t hash = kHashSeed;
+        addToHash(hash, &size, sizeof(size));
+        addToHash(hash, &modified, sizeof(modified));
+
+        juce::HeapBlock<char> block(static_cast<size_t>(kHeaderBytes));
+        const int headerRead = in.read(block.get(), kHeaderBytes);
+        if (headerRead > 0)
+            addToHash(hash, block.get(), static_cast<size_t>(headerRead));
+
+        if (size > kHeaderBytes)
+        {
+            const int64_t sampledStart = kHeaderBytes;
+            const int64_t sampledBytes = size - sampledStart;
+            const bool hashRestWhole = sampledBytes <= static_cast<int64_t>(kNumSampledBlocks) * kSampledBlockBytes;
+
+            for (int i = 0; i < kNumSampledBlocks; ++i)
+            {
+                const int64_t position = sampledStart + (hashRestWhole
+                    ? static_cast<int64_t>(i) * kSampledBlockBytes
+                    : (sampledBytes - kSampledBlockBytes) * i / (kNumSampledBlocks - 1));
+
+                if (position >= size || ! in.setPosition(position))
+                    break;
+
+                const int numRead = in.read(block.get(), kSampledBlockBytes);
+                if (numRead <= 0)
+                    break;
+
+                addToHash(hash, block.get(), static_cast<size_t>(numRead));
+            }
+        }
+
+        return toHex(hash) + "_" + juce::String(static_cast<juce::int64>(size));
+    }
+
+    /** Hash of every byte of audioFile, or {} if it could not be read (or the pool is stopping). */
+    juce::String computeFullHash(const juce::File& audioFile)
+    {
+        juce::FileInputStream in(audioFile);
+        if (! in.openedOk())
+            return {};
+
+        uint64_t hash = kHashSeed;
+        juce::HeapBlock<char> block(static_cast<size_t>(kVerifyBlockBytes));
+        auto* job = juce::ThreadPoolJob::getCurrentThreadPoolJob();
+
+        while (! in.isExhausted())
+        {
+            if (job != nullptr && job->shouldExit())
+                return {};
+
+            const int numRead = in.read(block.get(), kVerifyBlockBytes);
+            if (numRead < 0)
+                return {};
+
+            if (numRead == 0)
+                break;
+
+            addToHash(hash, block.get(), static_cast<size_t>(numRead));
+        }
+
+        return toHex(hash);
+    }
+
+    // Keys whose entries already passed verification in this session.
+    juce::CriticalSection verifiedLock;
+    juce::StringArray verifiedKeys;
+
+    /**
+     * Queues the full-content check of a hit on entry. A stale or
+     * unverifiable key loses all its entries, and onStale is posted to the
+     * message thread.
+     */
+    void verifyAsync(const juce::File& audioFile, const juce::File& entry, std::function<void()> onStale)
+    {
+        const auto key = entry.getFileNameWithoutExtension();
+        {
+            const juce::ScopedLock lock(verifiedLock);
+            if (verifiedKeys.contains(key))
+                return;
+        }
+
+        getWriterPool().addJob([audioFile, entry, key, onStale = std::move(onStale)]()
+        {
+            const auto fullHash = computeFullHash(audioFile);
+            if (fullHash.isEmpty())
+                return;
+
+            const auto hashFile = entry.withFileExtension(kHashExtension);
+            if (hashFile.existsAsFile() && hashFile.loadFileAsString().trim() == fullHash)
+            {
+                hashFile.setLastModificationTime(juce::Time::getCurrentTime());
+                const juce::ScopedLock lock(verifiedLock);
+                verifiedKeys.addIfNotAlreadyThere(key);
+                return;
+            }
+
+            juce::Logger::writeToLog("PeakFileCache: Stale entry " + key + " for "
+                                     + audioFile.getFileName() + ", discarding");
+
+            for (const auto* extension : { kPeaksExtension, kSpectrogramExtension, kHashExtension })
+                entry.withFileExtension(extension).deleteFile();
+
+            if (onStale != nullptr)
+                juce::MessageManager::callAsync(onStale);
+        });
+    }
+}
+
+juce::File getCacheDirectory()
+{
+    const auto settingsDir = Settings::getInstance().getSettingsDirectory();
+    auto dir = settingsDir.getChildFile("peak_cache");
+    if (! dir.exists())
+    {
+        dir.createDirectory();
+
+        // AudioThumbnail dumps from earlier versions; nothing reads them
+        // any more.
+        settingsDir.getChildFile("thumbnail_cache").deleteRecursively();
+    }
+    return dir;
+}
+
+juce::File getCacheEntryFor(const juce::File& audioFile, const char* extension)
+{
+    if (! audioFile.existsAsFile())
+        return {};
+
+    const auto key = computeContentKey(audioFile);
+    if (key.isEmpty())
+        return {};
+
+    return getCacheDirectory().getChildFile(key + extension);
+}
+
+bool tryMap(const juce::File& audioFile, int numChannels, int64_t numSamples, PeakPyramid& peaks,
+            std::function<void()> onStale)
+{
+    const auto entry = getCacheEntryFor(audioFile);
+    if (entry == juce::File() || ! entry.existsAsFile())
+        return false;
+
+    if (! peaks.loadFromMappedFile(entry, numChannels, numSamples))
+    {
+        DBG("PeakFileCache: Ignoring unusable entry " + entry.getFileName());
+        return false;
+    }
+
+    // Eviction is least-recently-used by modification time.
+    entry.setLastModificationTime(juce::Time::getCurrentTime());
+    verifyAsync(audioFile, entry, std::move(onStale));
+    return true;
+}
+
+bool tryReadSpectrogram(const juce::File& audioFile, SpectrogramCache& spectrogram,
+                        std::function<void()> onStale)
+{
+    const auto entry = getCacheEntryFor(audioFile, kSpectrogramExtension);
+    if (entry == juce::File() || ! entry.existsAsFile())
+        return false;
+
+    juce::FileInputStream in(entry);
+    if (! in.openedOk() || ! spectrogram.readOverviewFrom(in))
+    {
+        DBG("PeakFileCache: Ignoring unusable entry " + entry.getFileName());
+        return false;
+    }
+
+    entry.setLastModificationTime(juce::Time::getCurrentTime());
+    verifyAsync(audioFile, entry, std::move(onStale));
+    return true;
+}
+
+void saveAsync(const juce::File& audioFile, juce::MemoryBlock serialised, const char* extension)
+{
+    if (serialised.getSize() == 0)
+        return;
+
+    auto data = std::make_shared<juce::MemoryBlock>(std::move(serialised));
+    const auto modified = audioFile.getLastModificationTime();
+
+    getWriterPool().addJob([audioFile, data, extension, modified]()
+    {
+        // The data describes the file as it was when this was queued; a
+        // newer file would be stored under the newer key.
+        if (audioFile.getLastModificationTime() != modified)
+            return;
+
+        const auto entry = getCacheEntryFor(audioFile, extension);
+        if (entry == juce::File())
+            return;
+
+        const auto hashFile = entry.withFileExtension(kHashExtension);
+        if (! hashFile.existsAsFile())
+        {
+            const auto fullHash = computeFullHash(audioFile);
+            if (fullHash.isEmpty() || ! hashFile.replaceWithText(fullHash))
+                return;
+        }
+
+        juce::TemporaryFile tmp(entry, juce::TemporaryFile::useHiddenFile);
+        {
+            juce::FileOutputStream out(tmp.getFile());
+            if (! out.openedOk() || ! out.write(data->getData(), data->getSize()))
+                return;
+        }
+
+        // Fails harmlessly if the entry is mapped by an open document on
+        // a platform that locks mapped files; it is already current then.
+        if (! tmp.overwriteTargetFileWithTemporary())
+            return;
+
+        DBG("PeakFileCache: Saved " + entry.getFileName() + " for " + audioFile.getFileName());
+        enforceBudget();
+    });
+}
+
+void enforceBudget()
+{
+    const int budgetMB = Settings::getInstance().getSetting("display.peakCacheMB", kDefaultBudgetMB);
+    const int64_t budgetBytes = static_cast<int64_t>(juce::jmax(0, budgetMB)) * 1024 * 1024;
+
+    juce::Array<juce::File> all;
+    getCacheDirectory().findChildFiles(all, juce::File::findFiles, false,
+                                       juce::String("*") + kPeaksExtension + ";*" + kSpectrogramExtension);
+
+    int64_t totalBytes = 0;
+    for (const auto& file : all)
+        totalBytes += file.getSize();
+
+    if (totalBytes <= budgetBytes)
+        return;
+
+    struct ByMTimeAsc
+    {
+        static int compareElements(const juce::File& a, const juce::File& b)
+        {
+            const auto ta = a.getLastModificationTime();
+            const auto tb = b.getLastModificationTime();
+            if (ta < tb) return -1;
+            if (ta > tb) return 1;
+            // Stable tiebreaker for coarse filesystem timestamps.
+            return a.getFileName().compare(b.getFileName());
+        }
+    };
+    ByMTimeAsc cmp;
+    all.sort(cmp, false);
+
+    for (int i = 0; i < all.size() && totalBytes > budgetBytes; ++i)
+    {
+        const auto size = all.getReference(i).getSize();
+        if (all.getReference(i).deleteFile())
+            totalBytes -= size;
+    }
+
+    // Hash sidecars go with the last entry of their key.
+    juce::Array<juce::File> hashes;
+    getCacheDirectory().findChildFiles(hashes, juce::File::findFiles, false,
+                                       juce::String("*") + kHashExtension);
+
+    for (const auto& hashFile : hashes)
+    {
+        if (! hashFile.withFileExtension(kPeaksExtension).existsAsFile()
+            && ! hashFile.withFileExtension(kSpectrogramExtension).existsAsFile())
+        {
+            hashFile.deleteFile();
+        }
+    }
+}
+
+}  // namespace PeakFileCache
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    PeakFileCache.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 ZQ SFX
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Persistent on-disk cache of waveform peaks (see PeakPyramid). The
+    first time a file is opened its peaks are computed while it loads and
+    then written to `<settings>/peak_cache/<key>.peaks` on a background
+    thread. On later opens the entry is memory-mapped and drawn straight
+    away, without decoding or scanning the audio. The spectrogram view's
+    overview (see SpectrogramCache) is kept beside it under the same key,
+    as `<key>.spectrogram`.
+
+    Entries are keyed by a fingerprint of the file, not its path: its
+    size, modification time and format header in full, plus sampled
+    blocks spread across the audio. A moved file (or a copy that keeps
+    its timestamp) still hits; an overwritten one misses. The peak file
+    header records the audio's shape as well, and an entry that does not
+    match is ignored.
+
+    The fingerprint only samples the audio, so each entry also has a
+    `<key>.hash` sidecar holding a hash of the whole file. A hit is shown
+    straight away and then verified against it on the background thread;
+    on a mismatch the key's entries are deleted and the caller's onStale
+    callback runs on the message thread so it can recompute.
+
+    Eviction is byte-budgeted: once the cache directory exceeds the
+    "display.peakCacheMB" setting, the least recently used entries are
+    deleted. A hit refreshes the entry's modification time.
+
+    Lifetime: free functions plus one background writer thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <functional>
+
+class PeakPyramid;
+class SpectrogramCache;
+
+namespace PeakFileCache
+{
+    /** Default for the "display.peakCacheMB" setting. */
+    constexpr int kDefaultBudgetMB = 2048;
+
+    /** Cache directory under the per-user settings root. */
+    juce::File getCacheDirectory();
+
+    /** File extensions of the two kinds of entry. */
+    constexpr const char* kPeaksExtension = ".peaks";
+    constexpr const char* kSpectrogramExtension = ".spectrogram";
+
+    /** Extension of the full-content hash kept beside each key's entries. */
+    constexpr const char* kHashExtension = ".hash";
+
+    /**
+     * Cache entry of the given kind for audioFile's current contents, or
+     * juce::File() if it cannot be read.
+     */
+    juce::File getCacheEntryFor(const juce::File& audioFile, const char* extension = kPeaksExtension);
+
+    /**
+     * Maps the cached peaks for audioFile into peaks, if there is an entry
+     * for audio of this shape. peaks is left untouched on a miss.
+     *
+     * A hit is then checked against the whole file in the background; if
+     * the entry turns out to be stale, it is deleted and onStale (when
+     * given) is called on the message thread.
+     */
+    bool tryMap(const juce::File& audioFile, int numChannels, int64_t numSamples, PeakPyramid& peaks,
+                std::function<void()> onStale = nullptr);
+
+    /**
+     * Reads the cached spectrogram overview for audioFile into spectrogram,
+     * if there is an entry for audio of the shape it was last reset() to.
+     * Verified in the background like tryMap().
+     */
+    bool tryReadSpectrogram(const juce::File& audioFile, SpectrogramCache& spectrogram,
+                            std::function<void()> onStale = nullptr);
+
+    /**
+     * Stores serialised data (PeakPyramid::writeTo() or
+     * SpectrogramCache::writeOverviewTo() output) as audioFile's entry of
+     * that kind. The write, the fingerprinting, the full-content hash and
+     * the eviction pass all run on the background writer thread. Nothing
+     * is written if audioFile changes on disk before the job runs.
+     */
+    void saveAsync(const juce::File& audioFile, juce::MemoryBlock serialised,
+                   const char* extension = kPeaksExtension);
+
+    /** Deletes least recently used entries until the cache fits its byte budget. */
+    void enforceBudget();
+}
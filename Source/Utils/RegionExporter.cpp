@@ -114,6 +114,18 @@ RegionExporter::ExportResult RegionExporter::exportRegionsEx(
     const juce::File& sourceFile,
     const ExportSettings& settings,
     ProgressCallback progressCallback)
+{
+    return exportRegionsEx(AudioBlockSource::fromBuffer(buffer), sampleRate, regionManager,
+                           sourceFile, settings, progressCallback);
+}
+
+RegionExporter::ExportResult RegionExporter::exportRegionsEx(
+    const AudioBlockSource& audio,
+    double sampleRate,
+    const RegionManager& regionManager,
+    const juce::File& sourceFile,
+    const ExportSettings& settings,
+    ProgressCallback progressCallback)
 {
     ExportResult result;
 
@@ -185,7 +197,7 @@ RegionExporter::ExportResult RegionExporter::exportRegionsEx(
         // Export region in the requested format/bit depth.
         juce::String errorMessage;
         int effectiveBitDepth = settings.bitDepth;
-        bool success = exportSingleRegion(buffer, sampleRate, *region,
+        bool success = exportSingleRegion(audio, sampleRate, *region,
                                           outputFile, settings.bitDepth,
                                           errorMessage, settings.format,
                                           &effectiveBitDepth);
@@ -310,11 +322,24 @@ bool RegionExporter::exportSingleRegion(const juce::AudioBuffer<float>& buffer,
                                          juce::String& errorMessage,
                                          const juce::String& format,
                                          int* effectiveBitDepthOut)
+{
+    return exportSingleRegion(AudioBlockSource::fromBuffer(buffer), sampleRate, region, outputFile,
+                              bitDepth, errorMessage, format, effectiveBitDepthOut);
+}
+
+bool RegionExporter::exportSingleRegion(const AudioBlockSource& audio,
+                                         double sampleRate,
+                                         const Region& region,
+                                         const juce::File& outputFile,
+                                         int bitDepth,
+                                         juce::String& errorMessage,
+                                         const juce::String& format,
+                                         int* effectiveBitDepthOut)
 {
     // Validate region bounds
     int64_t startSample = region.getStartSample();
     int64_t endSample = region.getEndSample();
-    int64_t totalSamples = buffer.getNumSamples();
+    int64_t totalSamples = audio.numSamples;
 
     if (startSample < 0 || startSample >= totalSamples)
     {
@@ -341,7 +366,7 @@ bool RegionExporter::exportSingleRegion(const juce::AudioBuffer<float>& buffer,
     // format-imposed cap (FLAC <= 24-bit) so the caller can report coercion.
     int effectiveBitDepth = bitDepth;
     auto writer = createWriter(outputFile, format, sampleRate,
-                               buffer.getNumChannels(), bitDepth, effectiveBitDepth);
+                               audio.numChannels, bitDepth, effectiveBitDepth);
     if (effectiveBitDepthOut != nullptr)
         *effectiveBitDepthOut = effectiveBitDepth;
 
@@ -351,35 +376,11 @@ bool RegionExporter::exportSingleRegion(const juce::AudioBuffer<float>& buffer,
         return false;
     }
 
-    // C17: stream the region to disk in chunks instead of allocating one
-    // int-sized temporary buffer. This both avoids the int64->int overflow
-    // (a region longer than INT_MAX samples wrapped negative) and keeps peak
-    // memory bounded for long-form files. We write directly from a view into
-    // the source buffer per chunk, so no full copy is made.
-    const int kChunkSamples = 1 << 20;  // ~1M samples per write
-    const int numChannels = buffer.getNumChannels();
-
-    bool writeSuccess = true;
-    int64_t written = 0;
-
-    while (written < regionLength && writeSuccess)
-    {
-        const int thisChunk =
-            static_cast<int>(std::min<int64_t>(kChunkSamples, regionLength - written));
-
-        // Build a lightweight buffer that points at the source samples for
-        // this chunk (no deep copy). setDataToReferTo needs a channel pointer
-        // array offset to (startSample + written).
-        juce::AudioBuffer<float> chunk(numChannels, thisChunk);
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            chunk.copyFrom(ch, 0, buffer, ch,
-                           static_cast<int>(startSample + written), thisChunk);
-        }
-
-        writeSuccess = writer->writeFromAudioSampleBuffer(chunk, 0, thisChunk);
-        written += thisChunk;
-    }
+    // C17: stream the region to disk in bounded blocks instead of allocating
+    // one int-sized temporary buffer. This both avoids the int64->int
+    // overflow (a region longer than INT_MAX samples wrapped negative) and
+    // keeps peak memory bounded for long-form files.
+    const bool writeSuccess = audio.writeTo(*writer, startSample, regionLength);
 
     // Flush and close writer
     writer.reset();
@@ -17,6 +17,7 @@
 
 #include <juce_audio_formats/juce_audio_formats.h>
 #include "RegionManager.h"
+#include "../Audio/AudioBlockSource.h"
 #include <vector>
 
 /**
@@ -121,6 +122,18 @@ public:
                                         const ExportSettings& settings,
                                         ProgressCallback progressCallback = nullptr);
 
+    /**
+     * As above, reading the audio from a block source. The batch-export UI
+     * passes AudioBlockSource::fromSnapshot() so each region streams straight
+     * from the document's piece table and nothing is copied up front.
+     */
+    static ExportResult exportRegionsEx(const AudioBlockSource& audio,
+                                        double sampleRate,
+                                        const RegionManager& regionManager,
+                                        const juce::File& sourceFile,
+                                        const ExportSettings& settings,
+                                        ProgressCallback progressCallback = nullptr);
+
     /**
      * Generates filename for a region based on naming template.
      *
@@ -163,6 +176,16 @@ public:
                                     const juce::String& format = "wav",
                                     int* effectiveBitDepthOut = nullptr);
 
+    /** As above, streaming the region from a block source. */
+    static bool exportSingleRegion(const AudioBlockSource& audio,
+                                    double sampleRate,
+                                    const Region& region,
+                                    const juce::File& outputFile,
+                                    int bitDepth,
+                                    juce::String& errorMessage,
+                                    const juce::String& format = "wav",
+                                    int* effectiveBitDepthOut = nullptr);
+
     /**
      * Returns the file extension (including the leading dot) for a format
      * string ("wav"/"flac"). Shared by the exporter and the preview UI so the
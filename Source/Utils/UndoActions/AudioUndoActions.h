@@ -17,7 +17,9 @@
 
       - LevelUndoActions.h     — Gain, Normalize, DC offset removal
       - RangeUndoActions.h     — Silence, Trim
-      - TransformUndoActions.h — Reverse, Invert, Resample, Head/Tail
+      - TransformUndoActions.h — Resample, Head/Tail, Time/Pitch
+      - LosslessTransformUndoActions.h — Reverse, Invert, Swap Channels
+        (operation-log entries that store no audio)
 
     Channel-shape actions (ConvertToStereo, SilenceChannels,
     ReplaceChannels) moved to ChannelUndoActions.h alongside
@@ -35,4 +37,5 @@
 #include "LevelUndoActions.h"
 #include "RangeUndoActions.h"
 #include "TransformUndoActions.h"
+#include "LosslessTransformUndoActions.h"
 #include "ChannelUndoActions.h"
@@ -23,6 +23,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "../UndoableEdits.h"
+#include "../UndoAudioSpool.h"
 
 //==============================================================================
 /**
@@ -39,23 +40,17 @@ public:
                          AudioEngine& audioEngine,
                          WaveformDisplay& waveformDisplay,
                          const juce::AudioBuffer<float>& convertedBuffer)
-        : UndoableEditBase(bufferManager, audioEngine, waveformDisplay),
-          m_convertedBuffer(convertedBuffer.getNumChannels(), convertedBuffer.getNumSamples())
+        : UndoableEditBase(bufferManager, audioEngine, waveformDisplay)
     {
-        const auto& buffer = m_bufferManager.getBuffer();
-        m_originalBuffer.setSize(buffer.getNumChannels(), buffer.getNumSamples());
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            m_originalBuffer.copyFrom(ch, 0, buffer, ch, 0, buffer.getNumSamples());
-
-        for (int ch = 0; ch < convertedBuffer.getNumChannels(); ++ch)
-            m_convertedBuffer.copyFrom(ch, 0, convertedBuffer, ch, 0, convertedBuffer.getNumSamples());
+        m_originalBuffer.assign(m_bufferManager.getAudioRange(0, m_bufferManager.getNumSamples()), m_bufferManager);
+        m_convertedBuffer.assign(convertedBuffer, m_bufferManager);
 
         m_sampleRate = m_bufferManager.getSampleRate();
     }
 
     bool perform() override
     {
-        m_bufferManager.setBuffer(m_convertedBuffer, m_sampleRate);
+        m_bufferManager.setBuffer(m_convertedBuffer.get(), m_sampleRate);
         // Channel conversion changes channel count/layout, not sample count
         // (mono<->stereo/downmix all preserve numSamples), so it is safe --
         // and, per CLAUDE.md §6.5, required -- to preserve playback here
@@ -66,7 +61,7 @@ public:
 
     bool undo() override
     {
-        m_bufferManager.setBuffer(m_originalBuffer, m_sampleRate);
+        m_bufferManager.setBuffer(m_originalBuffer.get(), m_sampleRate);
         updatePlaybackAndDisplayPreservingPlayback();
         return true;
     }
@@ -81,8 +76,8 @@ public:
     }
 
 private:
-    juce::AudioBuffer<float> m_originalBuffer;
-    juce::AudioBuffer<float> m_convertedBuffer;
+    SpooledAudioBuffer m_originalBuffer;
+    SpooledAudioBuffer m_convertedBuffer;
     double m_sampleRate;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelConvertAction)
@@ -104,10 +99,7 @@ public:
           m_audioEngine(audioEngine)
     {
         // Store the original mono buffer for undo
-        const auto& originalBuffer = m_bufferManager.getBuffer();
-        m_originalMonoBuffer.setSize(originalBuffer.getNumChannels(),
-                                     originalBuffer.getNumSamples());
-        m_originalMonoBuffer.makeCopyOf(originalBuffer, true);
+        m_originalMonoBuffer.assign(m_bufferManager.getAudioRange(0, m_bufferManager.getNumSamples()), m_bufferManager);
     }
 
     void markAsAlreadyPerformed() { m_alreadyPerformed = true; }
@@ -127,18 +119,11 @@ public:
         }
 
         // Reload audio engine with new channel count
-        m_audioEngine.reloadBufferPreservingPlayback(
-            m_bufferManager.getBuffer(),
-            m_bufferManager.getSampleRate(),
-            m_bufferManager.getBuffer().getNumChannels()
-        );
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.reloadSnapshotPreservingPlayback(snapshot);
 
         // Reload waveform display
-        m_waveformDisplay.reloadFromBuffer(
-            m_bufferManager.getBuffer(),
-            m_bufferManager.getSampleRate(),
-            true, true
-        );
+        m_waveformDisplay.reloadFromSnapshot(snapshot, true, true);
 
         return true;
     }
@@ -146,24 +131,14 @@ public:
     bool undo() override
     {
         // Restore the original mono buffer
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        buffer.setSize(m_originalMonoBuffer.getNumChannels(),
-                      m_originalMonoBuffer.getNumSamples());
-        buffer.makeCopyOf(m_originalMonoBuffer, true);
+        m_bufferManager.setBuffer(m_originalMonoBuffer.get(), m_bufferManager.getSampleRate());
 
         // Reload audio engine with mono
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer,
-            m_bufferManager.getSampleRate(),
-            buffer.getNumChannels()
-        );
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.reloadSnapshotPreservingPlayback(snapshot);
 
         // Reload waveform display
-        m_waveformDisplay.reloadFromBuffer(
-            buffer,
-            m_bufferManager.getSampleRate(),
-            true, true
-        );
+        m_waveformDisplay.reloadFromSnapshot(snapshot, true, true);
 
         return true;
     }
@@ -174,7 +149,7 @@ private:
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_originalMonoBuffer;
+    SpooledAudioBuffer m_originalMonoBuffer;
     bool m_alreadyPerformed = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConvertToStereoAction)
@@ -199,14 +174,12 @@ public:
         : m_bufferManager(bufferManager),
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
-          m_beforeBuffer(),
           m_startSample(startSample),
           m_numSamples(numSamples),
           m_channelMask(channelMask)
     {
         // Store only the affected region for the affected channels
-        m_beforeBuffer.setSize(beforeBuffer.getNumChannels(), beforeBuffer.getNumSamples());
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
     }
 
     bool perform() override
@@ -220,16 +193,12 @@ public:
             return false;
         }
 
-        // Get the updated buffer
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         // Log the operation
         DBG("Applied silence to channels in selection");
@@ -239,36 +208,34 @@ public:
 
     bool undo() override
     {
-        // Restore the before state for the affected channels
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        // Map the stored channels back to their original positions
-        int storedCh = 0;
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        // Restore the before state for the affected channels; the stored
+        // channels map back onto the masked ones in order.
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, m_beforeBuffer.get(), m_channelMask))
         {
-            if ((m_channelMask & (1 << ch)) != 0 && storedCh < m_beforeBuffer.getNumChannels())
-            {
-                buffer.copyFrom(ch, m_startSample, m_beforeBuffer, storedCh, 0, m_numSamples);
-                storedCh++;
-            }
+            DBG("SilenceChannelsUndoAction::undo - Failed to restore channels");
+            return false;
         }
 
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(buffer, m_bufferManager.getSampleRate(),
-                                                    buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         return true;
     }
 
 private:
+    AudioEditRange getEditRange() const
+    {
+        return AudioEditRange::inPlace(m_startSample, m_numSamples);
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
+    SpooledAudioBuffer m_beforeBuffer;
     int m_startSample;
     int m_numSamples;
     int m_channelMask;
@@ -296,23 +263,19 @@ public:
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
           m_startSample(startSample),
-          m_beforeBuffer(),
-          m_newAudio(),
           m_channelMask(channelMask)
     {
         // Store the before state for undo
-        m_beforeBuffer.setSize(beforeBuffer.getNumChannels(), beforeBuffer.getNumSamples());
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
 
         // Store the new audio for redo
-        m_newAudio.setSize(newAudio.getNumChannels(), newAudio.getNumSamples());
-        m_newAudio.makeCopyOf(newAudio, true);
+        m_newAudio.assign(newAudio, m_bufferManager);
     }
 
     bool perform() override
     {
         // Replace the specified channels with new audio
-        bool success = m_bufferManager.replaceChannelsInRange(m_startSample, m_newAudio, m_channelMask);
+        bool success = m_bufferManager.replaceChannelsInRange(m_startSample, m_newAudio.get(), m_channelMask);
 
         if (!success)
         {
@@ -320,16 +283,12 @@ public:
             return false;
         }
 
-        // Get the updated buffer
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true);
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         return true;
     }
@@ -337,7 +296,7 @@ public:
     bool undo() override
     {
         // Restore the before state
-        bool success = m_bufferManager.replaceChannelsInRange(m_startSample, m_beforeBuffer, m_channelMask);
+        bool success = m_bufferManager.replaceChannelsInRange(m_startSample, m_beforeBuffer.get(), m_channelMask);
 
         if (!success)
         {
@@ -345,26 +304,28 @@ public:
             return false;
         }
 
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
         // Reload buffer in AudioEngine
-        m_audioEngine.reloadBufferPreservingPlayback(buffer, m_bufferManager.getSampleRate(),
-                                                    buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true);
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         return true;
     }
 
 private:
+    AudioEditRange getEditRange() const
+    {
+        return AudioEditRange::inPlace(m_startSample, m_newAudio.getNumSamples());
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
     int m_startSample;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    juce::AudioBuffer<float> m_newAudio;
+    SpooledAudioBuffer m_beforeBuffer;
+    SpooledAudioBuffer m_newAudio;
     int m_channelMask;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReplaceChannelsAction)
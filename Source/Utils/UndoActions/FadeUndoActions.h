@@ -21,6 +21,7 @@
 #include "../../Audio/AudioEngine.h"
 #include "../../Audio/AudioProcessor.h"
 #include "../../UI/WaveformDisplay.h"
+#include "../UndoAudioSpool.h"
 
 //==============================================================================
 /**
@@ -34,19 +35,17 @@ public:
                     WaveformDisplay& waveform,
                     AudioEngine& audioEngine,
                     const juce::AudioBuffer<float>& beforeBuffer,
-                    int startSample,
+                    int64_t startSample,
                     int numSamples,
                     FadeCurveType curveType = FadeCurveType::LINEAR)
         : m_bufferManager(bufferManager),
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
-          m_beforeBuffer(),
           m_startSample(startSample),
           m_numSamples(numSamples),
           m_curveType(curveType)
     {
-        m_beforeBuffer.setSize(beforeBuffer.getNumChannels(), beforeBuffer.getNumSamples());
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
     }
 
     void markAsAlreadyPerformed() { m_alreadyPerformed = true; }
@@ -59,45 +58,43 @@ public:
             return true;
         }
 
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        juce::AudioBuffer<float> regionBuffer;
-        regionBuffer.setSize(buffer.getNumChannels(), m_numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            regionBuffer.copyFrom(ch, 0, buffer, ch, m_startSample, m_numSamples);
+        auto regionBuffer = m_bufferManager.getAudioRange(m_startSample, m_numSamples);
+        if (regionBuffer.getNumSamples() != m_numSamples)
+            return false;
 
         AudioProcessor::fadeIn(regionBuffer, m_numSamples, m_curveType);
 
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            buffer.copyFrom(ch, m_startSample, regionBuffer, ch, 0, m_numSamples);
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, regionBuffer, -1))
+            return false;
 
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                           true, true);
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
         return true;
     }
 
     bool undo() override
     {
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        for (int ch = 0; ch < m_beforeBuffer.getNumChannels(); ++ch)
-            buffer.copyFrom(ch, m_startSample, m_beforeBuffer, ch, 0, m_numSamples);
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, m_beforeBuffer.get(), -1))
+            return false;
 
-        m_audioEngine.reloadBufferPreservingPlayback(buffer, m_bufferManager.getSampleRate(),
-                                                     buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                           true, true);
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
         return true;
     }
 
 private:
+    AudioEditRange getEditRange() const
+    {
+        return AudioEditRange::inPlace(m_startSample, m_numSamples);
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    int m_startSample;
+    SpooledAudioBuffer m_beforeBuffer;
+    int64_t m_startSample;
     int m_numSamples;
     FadeCurveType m_curveType;
     bool m_alreadyPerformed = false;
@@ -117,19 +114,17 @@ public:
                      WaveformDisplay& waveform,
                      AudioEngine& audioEngine,
                      const juce::AudioBuffer<float>& beforeBuffer,
-                     int startSample,
+                     int64_t startSample,
                      int numSamples,
                      FadeCurveType curveType = FadeCurveType::LINEAR)
         : m_bufferManager(bufferManager),
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
-          m_beforeBuffer(),
           m_startSample(startSample),
           m_numSamples(numSamples),
           m_curveType(curveType)
     {
-        m_beforeBuffer.setSize(beforeBuffer.getNumChannels(), beforeBuffer.getNumSamples());
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
     }
 
     void markAsAlreadyPerformed() { m_alreadyPerformed = true; }
@@ -142,45 +137,43 @@ public:
             return true;
         }
 
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        juce::AudioBuffer<float> regionBuffer;
-        regionBuffer.setSize(buffer.getNumChannels(), m_numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            regionBuffer.copyFrom(ch, 0, buffer, ch, m_startSample, m_numSamples);
+        auto regionBuffer = m_bufferManager.getAudioRange(m_startSample, m_numSamples);
+        if (regionBuffer.getNumSamples() != m_numSamples)
+            return false;
 
         AudioProcessor::fadeOut(regionBuffer, m_numSamples, m_curveType);
 
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            buffer.copyFrom(ch, m_startSample, regionBuffer, ch, 0, m_numSamples);
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, regionBuffer, -1))
+            return false;
 
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                           true, true);
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
         return true;
     }
 
     bool undo() override
     {
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        for (int ch = 0; ch < m_beforeBuffer.getNumChannels(); ++ch)
-            buffer.copyFrom(ch, m_startSample, m_beforeBuffer, ch, 0, m_numSamples);
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, m_beforeBuffer.get(), -1))
+            return false;
 
-        m_audioEngine.reloadBufferPreservingPlayback(buffer, m_bufferManager.getSampleRate(),
-                                                     buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                           true, true);
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
         return true;
     }
 
 private:
+    AudioEditRange getEditRange() const
+    {
+        return AudioEditRange::inPlace(m_startSample, m_numSamples);
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    int m_startSample;
+    SpooledAudioBuffer m_beforeBuffer;
+    int64_t m_startSample;
     int m_numSamples;
     FadeCurveType m_curveType;
     bool m_alreadyPerformed = false;
@@ -28,6 +28,7 @@
 #include "../../Audio/AudioEngine.h"
 #include "../../Audio/AudioProcessor.h"
 #include "../../UI/WaveformDisplay.h"
+#include "../UndoAudioSpool.h"
 
 //==============================================================================
 /**
@@ -41,22 +42,20 @@ public:
                   WaveformDisplay& waveform,
                   AudioEngine& audioEngine,
                   const juce::AudioBuffer<float>& beforeBuffer,
-                  int startSample,
+                  int64_t startSample,
                   int numSamples,
                   float gainDB,
                   bool isSelection)
         : m_bufferManager(bufferManager),
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
-          m_beforeBuffer(),
           m_startSample(startSample),
           m_numSamples(numSamples),
           m_gainDB(gainDB),
           m_isSelection(isSelection)
     {
         // Store only the affected region to save memory
-        m_beforeBuffer.setSize(beforeBuffer.getNumChannels(), beforeBuffer.getNumSamples());
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
     }
 
     /**
@@ -84,19 +83,26 @@ public:
             "GainUndoAction::perform - Before edit: playing=%s, position=%.3f",
             wasPlaying ? "YES" : "NO", positionBeforeEdit));
 
-        // Apply gain to the current buffer
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        AudioProcessor::applyGainToRange(buffer, m_gainDB, m_startSample, m_numSamples);
+        // Apply gain to the affected range only
+        const float gainDB = m_gainDB;
+        if (! m_bufferManager.processRange(m_startSample, m_numSamples,
+                [gainDB](juce::AudioBuffer<float>& block, int blockStart, int blockLength, int64_t)
+                {
+                    AudioProcessor::applyGainToRange(block, gainDB, blockStart, blockLength);
+                }))
+        {
+            DBG("GainUndoAction::perform - Failed to apply gain");
+            return false;
+        }
 
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         DBG("GainUndoAction::perform - Gain applied and buffer reloaded");
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         // Log the operation
         juce::String region = m_isSelection ? "selection" : "entire file";
@@ -110,31 +116,30 @@ public:
     bool undo() override
     {
         // Restore the before state (only the affected region)
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        // Copy the affected region from before buffer back to original position
-        for (int ch = 0; ch < m_beforeBuffer.getNumChannels(); ++ch)
-        {
-            buffer.copyFrom(ch, m_startSample, m_beforeBuffer, ch, 0, m_numSamples);
-        }
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, m_beforeBuffer.get(), -1))
+            return false;
 
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(buffer, m_bufferManager.getSampleRate(),
-                                                    buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         return true;
     }
 
 private:
+    AudioEditRange getEditRange() const
+    {
+        return AudioEditRange::inPlace(m_startSample, m_numSamples);
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    int m_startSample;
+    SpooledAudioBuffer m_beforeBuffer;
+    int64_t m_startSample;
     int m_numSamples;
     float m_gainDB;
     bool m_isSelection;
@@ -155,53 +160,41 @@ public:
                        WaveformDisplay& waveform,
                        AudioEngine& audioEngine,
                        const juce::AudioBuffer<float>& beforeBuffer,
-                       int startSample,
+                       int64_t startSample,
                        int numSamples,
                        bool isSelection,
                        float targetDB = 0.0f)
         : m_bufferManager(bufferManager),
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
-          m_beforeBuffer(),
           m_startSample(startSample),
           m_numSamples(numSamples),
           m_isSelection(isSelection),
           m_targetDB(targetDB)
     {
         // Store only the affected region to save memory
-        m_beforeBuffer.setSize(beforeBuffer.getNumChannels(), beforeBuffer.getNumSamples());
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
     }
 
     bool perform() override
     {
-        // Get the buffer and create a region buffer for normalization
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
         // Extract the region to normalize
-        juce::AudioBuffer<float> regionBuffer;
-        regionBuffer.setSize(buffer.getNumChannels(), m_numSamples);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            regionBuffer.copyFrom(ch, 0, buffer, ch, m_startSample, m_numSamples);
-        }
+        auto regionBuffer = m_bufferManager.getAudioRange(m_startSample, m_numSamples);
+        if (regionBuffer.getNumSamples() != m_numSamples)
+            return false;
 
-        // Apply normalization to the region
+        // Apply normalization to the region and write it back
         AudioProcessor::normalize(regionBuffer, m_targetDB);
 
-        // Copy normalized region back to main buffer
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            buffer.copyFrom(ch, m_startSample, regionBuffer, ch, 0, m_numSamples);
-        }
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, regionBuffer, -1))
+            return false;
 
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         // Log the operation
         juce::String region = m_isSelection ? "selection" : "entire file";
@@ -215,31 +208,30 @@ public:
     bool undo() override
     {
         // Restore the before state (only the affected region)
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        // Copy the affected region from before buffer back to original position
-        for (int ch = 0; ch < m_beforeBuffer.getNumChannels(); ++ch)
-        {
-            buffer.copyFrom(ch, m_startSample, m_beforeBuffer, ch, 0, m_numSamples);
-        }
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, m_beforeBuffer.get(), -1))
+            return false;
 
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(buffer, m_bufferManager.getSampleRate(),
-                                                    buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         return true;
     }
 
 private:
+    AudioEditRange getEditRange() const
+    {
+        return AudioEditRange::inPlace(m_startSample, m_numSamples);
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    int m_startSample;
+    SpooledAudioBuffer m_beforeBuffer;
+    int64_t m_startSample;
     int m_numSamples;
     bool m_isSelection;
     float m_targetDB;
@@ -259,18 +251,16 @@ public:
                              WaveformDisplay& waveform,
                              AudioEngine& audioEngine,
                              const juce::AudioBuffer<float>& beforeBuffer,
-                             int startSample = 0,
+                             int64_t startSample = 0,
                              int numSamples = -1)
         : m_bufferManager(bufferManager),
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
-          m_beforeBuffer(),
           m_startSample(startSample),
           m_numSamples(numSamples)
     {
         // Store the affected region
-        m_beforeBuffer.setSize(beforeBuffer.getNumChannels(), beforeBuffer.getNumSamples());
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
     }
 
     void markAsAlreadyPerformed() { m_alreadyPerformed = true; }
@@ -283,17 +273,13 @@ public:
             return true;
         }
 
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
         // Extract the region to process
-        juce::AudioBuffer<float> regionBuffer;
-        int actualNumSamples = (m_numSamples < 0) ? buffer.getNumSamples() : m_numSamples;
-        regionBuffer.setSize(buffer.getNumChannels(), actualNumSamples);
-
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            regionBuffer.copyFrom(ch, 0, buffer, ch, m_startSample, actualNumSamples);
-        }
+        const int64_t actualNumSamples = (m_numSamples < 0)
+            ? m_bufferManager.getNumSamples() - m_startSample
+            : static_cast<int64_t>(m_numSamples);
+        auto regionBuffer = m_bufferManager.getAudioRange(m_startSample, actualNumSamples);
+        if (regionBuffer.getNumSamples() == 0 || regionBuffer.getNumSamples() != actualNumSamples)
+            return false;
 
         // Apply DC offset removal to the region
         bool success = AudioProcessor::removeDCOffset(regionBuffer);
@@ -304,19 +290,16 @@ public:
             return false;
         }
 
-        // Copy the processed region back into the main buffer
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            buffer.copyFrom(ch, m_startSample, regionBuffer, ch, 0, actualNumSamples);
-        }
+        // Write the processed region back
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, regionBuffer, -1))
+            return false;
 
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         // Log the operation
         juce::String message = (m_numSamples < 0) ? "Removed DC offset from entire file"
@@ -329,30 +312,30 @@ public:
     bool undo() override
     {
         // Restore the affected region from before buffer
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            buffer.copyFrom(ch, m_startSample, m_beforeBuffer, ch, 0, m_beforeBuffer.getNumSamples());
-        }
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, m_beforeBuffer.get(), -1))
+            return false;
 
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(buffer, m_bufferManager.getSampleRate(),
-                                                    buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         return true;
     }
 
 private:
+    AudioEditRange getEditRange() const
+    {
+        return AudioEditRange::inPlace(m_startSample, m_beforeBuffer.getNumSamples());
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    int m_startSample;
+    SpooledAudioBuffer m_beforeBuffer;
+    int64_t m_startSample;
     int m_numSamples;
     bool m_alreadyPerformed = false;
 
@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    LosslessTransformUndoActions.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 ZQ SFX
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Operation-log undo for exactly invertible transforms (reverse, polarity
+    invert, channel swap). Unlike the snapshot actions next door, these
+    entries keep no audio: they record the operation and its range and
+    re-apply the transform (or its inverse) on redo/undo, so a whole-file
+    polarity flip costs no undo memory at all.
+
+    Reach this header through the umbrella `AudioUndoActions.h`.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "../../Audio/AudioBufferManager.h"
+#include "../../Audio/AudioEngine.h"
+#include "../../Audio/AudioProcessor.h"
+#include "../../UI/WaveformDisplay.h"
+
+//==============================================================================
+/**
+ * A transform whose exact inverse is known, so undo can recompute the
+ * previous audio instead of storing it.
+ *
+ * Only bit-exact operations belong here: float sign flips, sample
+ * reordering and channel permutations round-trip exactly, while anything
+ * that rounds (gain, resampling, filtering) must keep a snapshot.
+ *
+ * To add one: add the enum value, its case in apply(), its inverse in
+ * getInverse() (itself, if self-inverse) and a name in getName().
+ */
+enum class LosslessTransform
+{
+    reverse,        // time-reverse the range in every channel
+    invert,         // multiply by -1
+    swapChannels    // exchange channels 0 and 1
+};
+
+namespace LosslessTransforms
+{
+    /** The transform that exactly undoes transform. */
+    inline LosslessTransform getInverse(LosslessTransform transform)
+    {
+        switch (transform)
+        {
+            case LosslessTransform::reverse:
+            case LosslessTransform::invert:
+            case LosslessTransform::swapChannels:
+                return transform;  // self-inverse
+        }
+
+        jassertfalse;
+        return transform;
+    }
+
+    /** Applies transform to [startSample, startSample + numSamples) in place. */
+    inline bool apply(LosslessTransform transform, juce::AudioBuffer<float>& buffer,
+                      int startSample, int numSamples)
+    {
+        switch (transform)
+        {
+            case LosslessTransform::reverse:
+                return AudioProcessor::reverseRange(buffer, startSample, numSamples);
+            case LosslessTransform::invert:
+                return AudioProcessor::invertRange(buffer, startSample, numSamples);
+            case LosslessTransform::swapChannels:
+                return AudioProcessor::swapChannelsRange(buffer, 0, 1, startSample, numSamples);
+        }
+
+        jassertfalse;
+        return false;
+    }
+
+    /** Frames read and written per step by applyToDocument(). */
+    constexpr int kBlockSamples = 1 << 16;
+
+    /**
+     * Applies transform to [startSample, startSample + numSamples) of the
+     * document, a fixed-size block at a time, so no more than two blocks are
+     * ever copied out whatever the range length. Invert and channel swap are
+     * block-local; reverse swaps mirrored blocks from the two ends of the
+     * range inwards and finishes with the middle.
+     */
+    inline bool applyToDocument(LosslessTransform transform, AudioBufferManager& bufferManager,
+                                int64_t startSample, int64_t numSamples)
+    {
+        if (transform != LosslessTransform::reverse)
+        {
+            bool applied = true;
+            const bool processed = bufferManager.processRange(startSample, numSamples,
+                [transform, &applied](juce::AudioBuffer<float>& block, int blockStart, int blockLength, int64_t)
+                {
+                    applied = apply(transform, block, blockStart, blockLength) && applied;
+                });
+            return processed && applied;
+        }
+
+        int64_t low = startSample;
+        int64_t high = startSample + numSamples;
+
+        while (high - low > 2 * static_cast<int64_t>(kBlockSamples))
+        {
+            auto head = bufferManager.getAudioRange(low, kBlockSamples);
+            auto tail = bufferManager.getAudioRange(high - kBlockSamples, kBlockSamples);
+            if (head.getNumSamples() != kBlockSamples || tail.getNumSamples() != kBlockSamples
+                || ! apply(transform, head, 0, kBlockSamples)
+                || ! apply(transform, tail, 0, kBlockSamples)
+                || ! bufferManager.replaceChannelsInRange(low, tail, -1)
+                || ! bufferManager.replaceChannelsInRange(high - kBlockSamples, head, -1))
+            {
+                return false;
+            }
+
+            low += kBlockSamples;
+            high -= kBlockSamples;
+        }
+
+        // At most two blocks left; reverse them in one piece.
+        const int middleLength = static_cast<int>(high - low);
+        if (middleLength == 0)
+            return true;
+
+        auto middle = bufferManager.getAudioRange(low, middleLength);
+        return middle.getNumSamples() == middleLength
+            && apply(transform, middle, 0, middleLength)
+            && bufferManager.replaceChannelsInRange(low, middle, -1);
+    }
+
+    inline juce::String getName(LosslessTransform transform)
+    {
+        switch (transform)
+        {
+            case LosslessTransform::reverse:      return "Reverse";
+            case LosslessTransform::invert:       return "Invert";
+            case LosslessTransform::swapChannels: return "Swap Channels";
+        }
+
+        return {};
+    }
+}
+
+//==============================================================================
+/**
+ * Undo entry for a LosslessTransform over a sample range.
+ *
+ * perform() applies the transform, undo() applies its inverse. The entry
+ * holds only the operation and range, so its undo cost is independent of
+ * the range length.
+ */
+class LosslessTransformUndoAction : public juce::UndoableAction
+{
+public:
+    LosslessTransformUndoAction(AudioBufferManager& bufferManager,
+                                WaveformDisplay& waveform,
+                                AudioEngine& audioEngine,
+                                LosslessTransform transform,
+                                int64_t startSample, int64_t numSamples, bool isSelection)
+        : m_bufferManager(bufferManager),
+          m_waveformDisplay(waveform),
+          m_audioEngine(audioEngine),
+          m_transform(transform),
+          m_startSample(startSample),
+          m_numSamples(numSamples),
+          m_isSelection(isSelection)
+    {
+    }
+
+    bool perform() override
+    {
+        return applyAndRefresh(m_transform);
+    }
+
+    bool undo() override
+    {
+        return applyAndRefresh(LosslessTransforms::getInverse(m_transform));
+    }
+
+    int getSizeInUnits() override
+    {
+        // No audio is stored; count only the entry itself.
+        return static_cast<int>(sizeof(*this));
+    }
+
+    LosslessTransform getTransform() const { return m_transform; }
+
+private:
+    bool applyAndRefresh(LosslessTransform transform)
+    {
+        if (! LosslessTransforms::applyToDocument(transform, m_bufferManager, m_startSample, m_numSamples))
+        {
+            DBG("LosslessTransformUndoAction - " + LosslessTransforms::getName(transform) + " failed");
+            return false;
+        }
+
+        // Preserve playback, view and selection; only the range changed.
+        const auto range = AudioEditRange::inPlace(m_startSample, m_numSamples);
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, range);
+        m_waveformDisplay.applyEditedSnapshot(snapshot, range);
+
+        DBG(LosslessTransforms::getName(transform) + " applied to "
+            + (m_isSelection ? "selection" : "entire file"));
+        return true;
+    }
+
+    AudioBufferManager& m_bufferManager;
+    WaveformDisplay& m_waveformDisplay;
+    AudioEngine& m_audioEngine;
+    LosslessTransform m_transform;
+    int64_t m_startSample;
+    int64_t m_numSamples;
+    bool m_isSelection;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LosslessTransformUndoAction)
+};
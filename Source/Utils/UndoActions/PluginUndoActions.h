@@ -17,6 +17,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "../UndoableEdits.h"
+#include "../UndoAudioSpool.h"
 #include "../../DSP/DynamicParametricEQ.h"
 
 //==============================================================================
@@ -41,7 +42,7 @@ public:
         jassert(startSample >= 0 && startSample < m_bufferManager.getNumSamples());
         jassert(numSamples > 0 && (startSample + numSamples) <= m_bufferManager.getNumSamples());
 
-        m_originalAudio = m_bufferManager.getAudioRange(startSample, numSamples);
+        m_originalAudio.assign(m_bufferManager.getAudioRange(startSample, numSamples), m_bufferManager);
         m_sampleRate = m_bufferManager.getSampleRate();
     }
 
@@ -59,15 +60,15 @@ public:
             // EQ processes the range in place -- length is always m_numSamples
             // in and out, so preserving playback (§6.5) is safe here, unlike
             // the length-changing actions (Delete/Insert/Replace).
-            updatePlaybackAndDisplayPreservingPlayback();
+            updatePlaybackAndDisplayPreservingPlayback(AudioEditRange::inPlace(m_startSample, m_numSamples));
         return success;
     }
 
     bool undo() override
     {
-        const bool success = m_bufferManager.replaceRange(m_startSample, m_numSamples, m_originalAudio);
+        const bool success = m_bufferManager.replaceRange(m_startSample, m_numSamples, m_originalAudio.get());
         if (success)
-            updatePlaybackAndDisplayPreservingPlayback();
+            updatePlaybackAndDisplayPreservingPlayback(AudioEditRange::inPlace(m_startSample, m_numSamples));
         return success;
     }
 
@@ -82,7 +83,7 @@ private:
     int64_t m_startSample;
     int64_t m_numSamples;
     DynamicParametricEQ::Parameters m_eqParams;
-    juce::AudioBuffer<float> m_originalAudio;
+    SpooledAudioBuffer m_originalAudio;
     double m_sampleRate;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ApplyDynamicParametricEQAction)
@@ -116,7 +117,6 @@ public:
         : UndoableEditBase(bufferManager, audioEngine, waveformDisplay),
           m_startSample(startSample),
           m_numSamples(numSamples),
-          m_processedAudio(processedAudio.getNumChannels(), processedAudio.getNumSamples()),
           m_chainDescription(chainDescription)
     {
         jassert(m_bufferManager.hasAudioData());
@@ -125,9 +125,8 @@ public:
         // processedAudio may exceed numSamples when an effect tail is included.
         jassert(processedAudio.getNumSamples() >= numSamples);
 
-        m_originalAudio = m_bufferManager.getAudioRange(startSample, numSamples);
-        for (int ch = 0; ch < processedAudio.getNumChannels(); ++ch)
-            m_processedAudio.copyFrom(ch, 0, processedAudio, ch, 0, processedAudio.getNumSamples());
+        m_originalAudio.assign(m_bufferManager.getAudioRange(startSample, numSamples), m_bufferManager);
+        m_processedAudio.assign(processedAudio, m_bufferManager);
 
         m_sampleRate = m_bufferManager.getSampleRate();
     }
@@ -158,7 +157,7 @@ public:
             return true;
         }
 
-        const bool success = m_bufferManager.replaceRange(m_startSample, m_numSamples, m_processedAudio);
+        const bool success = m_bufferManager.replaceRange(m_startSample, m_numSamples, m_processedAudio.get());
         if (success)
             updatePlaybackForLengthChange(m_numSamples, m_processedAudio.getNumSamples());
         return success;
@@ -169,7 +168,7 @@ public:
         // When effect tail was included, m_processedAudio is larger than m_originalAudio.
         // Replace the extended range with the original range.
         const int64_t samplesToReplace = m_processedAudio.getNumSamples();
-        const bool success = m_bufferManager.replaceRange(m_startSample, samplesToReplace, m_originalAudio);
+        const bool success = m_bufferManager.replaceRange(m_startSample, samplesToReplace, m_originalAudio.get());
         if (success)
             updatePlaybackForLengthChange(samplesToReplace, m_originalAudio.getNumSamples());
         return success;
@@ -199,23 +198,19 @@ private:
     /**
      * A plugin chain render is only length-preserving when no effect tail
      * was included -- otherwise it grows the affected range (reverb/delay
-     * tail), which shifts everything after it, the same content-position
-     * hazard Delete/Insert/Replace have. Preserve playback (§6.5) only in
-     * the genuinely safe case; otherwise fall back to the deterministic
-     * stop-on-length-change behavior those actions use.
+     * tail), which shifts everything after it, as Delete/Insert/Replace do.
+     * The range-aware base update remaps the play position through that
+     * shift, so playback carries on in both cases (§6.5).
      */
     void updatePlaybackForLengthChange(int64_t oldLength, int64_t newLength)
     {
-        if (oldLength == newLength)
-            updatePlaybackAndDisplayPreservingPlayback();
-        else
-            updatePlaybackAndDisplay();
+        updatePlaybackAndDisplay(AudioEditRange { m_startSample, oldLength, newLength });
     }
 
     int64_t m_startSample;
     int64_t m_numSamples;
-    juce::AudioBuffer<float> m_originalAudio;
-    juce::AudioBuffer<float> m_processedAudio;
+    SpooledAudioBuffer m_originalAudio;
+    SpooledAudioBuffer m_processedAudio;
     juce::String m_chainDescription;
     double m_sampleRate;
     bool m_alreadyPerformed = false;
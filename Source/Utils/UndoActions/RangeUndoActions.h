@@ -25,6 +25,7 @@
 #include "../../Audio/AudioBufferManager.h"
 #include "../../Audio/AudioEngine.h"
 #include "../../UI/WaveformDisplay.h"
+#include "../UndoAudioSpool.h"
 
 //==============================================================================
 /**
@@ -38,18 +39,16 @@ public:
                      WaveformDisplay& waveform,
                      AudioEngine& audioEngine,
                      const juce::AudioBuffer<float>& beforeBuffer,
-                     int startSample,
+                     int64_t startSample,
                      int numSamples)
         : m_bufferManager(bufferManager),
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
-          m_beforeBuffer(),
           m_startSample(startSample),
           m_numSamples(numSamples)
     {
         // Store only the affected region to save memory
-        m_beforeBuffer.setSize(beforeBuffer.getNumChannels(), beforeBuffer.getNumSamples());
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
     }
 
     bool perform() override
@@ -63,16 +62,12 @@ public:
             return false;
         }
 
-        // Get the updated buffer
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         // Log the operation
         DBG("Applied silence to selection");
@@ -83,31 +78,30 @@ public:
     bool undo() override
     {
         // Restore the before state (only the affected region)
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        // Copy the affected region from before buffer back to original position
-        for (int ch = 0; ch < m_beforeBuffer.getNumChannels(); ++ch)
-        {
-            buffer.copyFrom(ch, m_startSample, m_beforeBuffer, ch, 0, m_numSamples);
-        }
+        if (! m_bufferManager.replaceChannelsInRange(m_startSample, m_beforeBuffer.get(), -1))
+            return false;
 
         // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(buffer, m_bufferManager.getSampleRate(),
-                                                    buffer.getNumChannels());
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, getEditRange());
 
         // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true); // preserveView=true, preserveEditCursor=true
+        m_waveformDisplay.applyEditedSnapshot(snapshot, getEditRange());
 
         return true;
     }
 
 private:
+    AudioEditRange getEditRange() const
+    {
+        return AudioEditRange::inPlace(m_startSample, m_numSamples);
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    int m_startSample;
+    SpooledAudioBuffer m_beforeBuffer;
+    int64_t m_startSample;
     int m_numSamples;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SilenceUndoAction)
@@ -116,7 +110,8 @@ private:
 //==============================================================================
 /**
  * Undo action for trim.
- * Stores the entire buffer before trimming since trim changes the file length.
+ * Stores only the removed head and tail; the kept range never leaves the
+ * document, so undo re-inserts the two ends around it.
  */
 class TrimUndoAction : public juce::UndoableAction
 {
@@ -124,48 +119,48 @@ public:
     TrimUndoAction(AudioBufferManager& bufferManager,
                   WaveformDisplay& waveform,
                   AudioEngine& audioEngine,
-                  const juce::AudioBuffer<float>& beforeBuffer,
-                  int startSample,
-                  int numSamples)
+                  int64_t startSample,
+                  int64_t numSamples)
         : m_bufferManager(bufferManager),
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
-          m_beforeBuffer(),
           m_startSample(startSample),
           m_numSamples(numSamples)
     {
-        // Store entire buffer since trim changes the file length
-        m_beforeBuffer.setSize(beforeBuffer.getNumChannels(), beforeBuffer.getNumSamples());
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        const int64_t keepEnd = startSample + numSamples;
+        m_head.assign(m_bufferManager.getAudioRange(0, startSample), m_bufferManager);
+        m_tail.assign(m_bufferManager.getAudioRange(keepEnd, m_bufferManager.getNumSamples() - keepEnd), m_bufferManager);
     }
 
     bool perform() override
     {
-        // Trim to the range using AudioBufferManager
-        bool success = m_bufferManager.trimToRange(m_startSample, m_numSamples);
+        // Remove the tail first so the head's range is still valid. Each
+        // removal is published as its own edit: playback keeps running and
+        // its position is remapped onto the kept audio (a position inside a
+        // removed end is moved to the nearest kept sample).
+        const int64_t keepEnd = m_startSample + m_numSamples;
 
-        if (!success)
+        if (m_tail.getNumSamples() > 0)
         {
-            DBG("TrimUndoAction::perform - Failed to trim range");
-            return false;
+            if (! m_bufferManager.deleteRange(keepEnd, m_tail.getNumSamples()))
+            {
+                DBG("TrimUndoAction::perform - Failed to trim range");
+                return false;
+            }
+            publish({ keepEnd, m_tail.getNumSamples(), 0 });
+        }
+
+        if (m_head.getNumSamples() > 0)
+        {
+            if (! m_bufferManager.deleteRange(0, m_head.getNumSamples()))
+            {
+                DBG("TrimUndoAction::perform - Failed to trim range");
+                return false;
+            }
+            publish({ 0, m_head.getNumSamples(), 0 });
         }
 
-        // Get the updated buffer
-        auto& buffer = m_bufferManager.getMutableBuffer();
-
-        // Trim REMOVES samples, so the buffer length / timeline changes.
-        // Deterministically STOP playback and reset to 0 rather than preserving
-        // a seconds-position that now maps onto different content -- matching
-        // Delete/Insert/Replace (UndoableEditBase::updatePlaybackAndDisplay),
-        // CLAUDE.md Sec 6.5. reloadBufferPreservingPlayback() would resume on
-        // the wrong audio.
-        m_audioEngine.stop();
-        m_audioEngine.loadFromBuffer(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
-
-        // Update waveform display - clear selection since file length changed
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          false, false); // preserveView=false, preserveEditCursor=false
+        // Clear selection since the file length changed
         m_waveformDisplay.clearSelection();
         m_waveformDisplay.setEditCursor(0.0);
 
@@ -177,31 +172,40 @@ public:
 
     bool undo() override
     {
-        // Restore the entire buffer (before trim)
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        buffer.setSize(m_beforeBuffer.getNumChannels(), m_beforeBuffer.getNumSamples());
-        buffer.makeCopyOf(m_beforeBuffer, true);
-
-        // Undo restores the original (longer) length -- again a length change,
-        // so STOP playback deterministically rather than preserving position.
-        m_audioEngine.stop();
-        m_audioEngine.loadFromBuffer(buffer, m_bufferManager.getSampleRate(),
-                                     buffer.getNumChannels());
+        // Re-insert the head, then the tail after the kept range.
+        if (m_head.getNumSamples() > 0)
+        {
+            if (! m_bufferManager.insertAudio(0, m_head.get()))
+                return false;
+            publish({ 0, 0, m_head.getNumSamples() });
+        }
 
-        // Update waveform display - clear selection since file length changed
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          false, false); // preserveView=false, preserveEditCursor=false
+        if (m_tail.getNumSamples() > 0)
+        {
+            const int64_t keepEnd = m_startSample + m_numSamples;
+            if (! m_bufferManager.insertAudio(keepEnd, m_tail.get()))
+                return false;
+            publish({ keepEnd, 0, m_tail.getNumSamples() });
+        }
 
         return true;
     }
 
 private:
+    void publish(const AudioEditRange& range)
+    {
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, range);
+        m_waveformDisplay.applyEditedSnapshot(snapshot, range);
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    int m_startSample;
-    int m_numSamples;
+    SpooledAudioBuffer m_head;   // [0, startSample) before the trim
+    SpooledAudioBuffer m_tail;   // [startSample + numSamples, end) before the trim
+    int64_t m_startSample;
+    int64_t m_numSamples;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrimUndoAction)
 };
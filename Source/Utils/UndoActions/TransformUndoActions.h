@@ -11,7 +11,8 @@
     (at your option) any later version.
 
     Whole-buffer transform undo actions split out of AudioUndoActions.h
-    per CLAUDE.md §7.5: reverse, polarity invert, resample, head/tail.
+    per CLAUDE.md §7.5: resample, head/tail, time/pitch. Reverse and
+    polarity invert keep no audio and live in LosslessTransformUndoActions.h.
 
     Reach this header through the umbrella `AudioUndoActions.h`.
 
@@ -27,112 +28,7 @@
 #include "../../Audio/AudioFileManager.h"
 #include "../../Audio/AudioProcessor.h"
 #include "../../UI/WaveformDisplay.h"
-
-//==============================================================================
-/**
- * Undo action for reversing audio.
- * Reverse is its own inverse, so perform() and undo() do the same thing.
- */
-class ReverseUndoAction : public juce::UndoableAction
-{
-public:
-    ReverseUndoAction(AudioBufferManager& bufferManager,
-                      WaveformDisplay& waveform,
-                      AudioEngine& audioEngine,
-                      int startSample, int numSamples, bool isSelection)
-        : m_bufferManager(bufferManager),
-          m_waveformDisplay(waveform),
-          m_audioEngine(audioEngine),
-          m_startSample(startSample),
-          m_numSamples(numSamples),
-          m_isSelection(isSelection)
-    {
-    }
-
-    bool perform() override
-    {
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        AudioProcessor::reverseRange(buffer, m_startSample, m_numSamples);
-
-        // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
-
-        // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true);
-
-        juce::String region = m_isSelection ? "selection" : "entire file";
-        DBG("Reversed " + region);
-
-        return true;
-    }
-
-    bool undo() override { return perform(); }  // Reverse is self-inverse
-
-private:
-    AudioBufferManager& m_bufferManager;
-    WaveformDisplay& m_waveformDisplay;
-    AudioEngine& m_audioEngine;
-    int m_startSample;
-    int m_numSamples;
-    bool m_isSelection;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReverseUndoAction)
-};
-
-//==============================================================================
-/**
- * Undo action for inverting polarity.
- * Invert is its own inverse, so perform() and undo() do the same thing.
- */
-class InvertUndoAction : public juce::UndoableAction
-{
-public:
-    InvertUndoAction(AudioBufferManager& bufferManager,
-                     WaveformDisplay& waveform,
-                     AudioEngine& audioEngine,
-                     int startSample, int numSamples, bool isSelection)
-        : m_bufferManager(bufferManager),
-          m_waveformDisplay(waveform),
-          m_audioEngine(audioEngine),
-          m_startSample(startSample),
-          m_numSamples(numSamples),
-          m_isSelection(isSelection)
-    {
-    }
-
-    bool perform() override
-    {
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        AudioProcessor::invertRange(buffer, m_startSample, m_numSamples);
-
-        // Reload buffer in AudioEngine - preserve playback if active
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_bufferManager.getSampleRate(), buffer.getNumChannels());
-
-        // Update waveform display - preserve view and selection
-        m_waveformDisplay.reloadFromBuffer(buffer, m_audioEngine.getSampleRate(),
-                                          true, true);
-
-        juce::String region = m_isSelection ? "selection" : "entire file";
-        DBG("Inverted polarity of " + region);
-
-        return true;
-    }
-
-    bool undo() override { return perform(); }  // Invert is self-inverse
-
-private:
-    AudioBufferManager& m_bufferManager;
-    WaveformDisplay& m_waveformDisplay;
-    AudioEngine& m_audioEngine;
-    int m_startSample;
-    int m_numSamples;
-    bool m_isSelection;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(InvertUndoAction)
-};
+#include "../UndoAudioSpool.h"
 
 //==============================================================================
 /**
@@ -146,28 +42,29 @@ public:
                        WaveformDisplay& waveform,
                        AudioEngine& audioEngine,
                        const juce::AudioBuffer<float>& beforeBuffer,
-                       double oldSampleRate, double newSampleRate)
+                       double oldSampleRate, double newSampleRate,
+                       SampleRateConverter::Quality quality = SampleRateConverter::Quality::High)
         : m_bufferManager(bufferManager),
           m_waveformDisplay(waveform),
           m_audioEngine(audioEngine),
           m_oldSampleRate(oldSampleRate),
-          m_newSampleRate(newSampleRate)
+          m_newSampleRate(newSampleRate),
+          m_quality(quality)
     {
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
     }
 
     bool perform() override
     {
         auto resampled = AudioFileManager::resampleBuffer(
-            m_beforeBuffer, m_oldSampleRate, m_newSampleRate);
+            m_beforeBuffer.get(), m_oldSampleRate, m_newSampleRate, m_quality);
 
         // Use setBuffer() which updates both the buffer and sample rate
         m_bufferManager.setBuffer(resampled, m_newSampleRate);
 
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_newSampleRate, buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_newSampleRate, false, false);
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.reloadSnapshotPreservingPlayback(snapshot);
+        m_waveformDisplay.reloadFromSnapshot(snapshot, false, false);
 
         DBG(juce::String::formatted(
             "Resampled from %.0f Hz to %.0f Hz", m_oldSampleRate, m_newSampleRate));
@@ -178,12 +75,11 @@ public:
     bool undo() override
     {
         // Restore original buffer and sample rate
-        m_bufferManager.setBuffer(m_beforeBuffer, m_oldSampleRate);
+        m_bufferManager.setBuffer(m_beforeBuffer.get(), m_oldSampleRate);
 
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        m_audioEngine.reloadBufferPreservingPlayback(
-            buffer, m_oldSampleRate, buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_oldSampleRate, false, false);
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.reloadSnapshotPreservingPlayback(snapshot);
+        m_waveformDisplay.reloadFromSnapshot(snapshot, false, false);
 
         DBG(juce::String::formatted(
             "Undo resample: restored to %.0f Hz", m_oldSampleRate));
@@ -197,9 +93,10 @@ private:
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
+    SpooledAudioBuffer m_beforeBuffer;
     double m_oldSampleRate;
     double m_newSampleRate;
+    SampleRateConverter::Quality m_quality;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ResampleUndoAction)
 };
@@ -223,44 +120,43 @@ public:
           m_audioEngine(audioEngine),
           m_sampleRate(sampleRate)
     {
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
-        m_afterBuffer.makeCopyOf(afterBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
+        m_afterBuffer.assign(afterBuffer, m_bufferManager);
     }
 
     bool perform() override
     {
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        buffer.setSize(m_afterBuffer.getNumChannels(), m_afterBuffer.getNumSamples());
-        buffer.makeCopyOf(m_afterBuffer, true);
-        // Head & Tail can prepend/trim silence, changing the buffer length and
-        // shifting the timeline. STOP playback deterministically (reset to 0)
-        // rather than preserving a position that now maps onto different
-        // content -- matching Delete/Insert/Replace, CLAUDE.md Sec 6.5.
-        m_audioEngine.stop();
-        m_audioEngine.loadFromBuffer(buffer, m_sampleRate, buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_sampleRate, false, false);
+        // Head & Tail can prepend/trim silence, changing the buffer length.
+        // The whole file is the edited range, so playback carries on at the
+        // same position (clamped to the new end) instead of stopping.
+        publish(m_afterBuffer.get());
         return true;
     }
 
     bool undo() override
     {
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        buffer.setSize(m_beforeBuffer.getNumChannels(), m_beforeBuffer.getNumSamples());
-        buffer.makeCopyOf(m_beforeBuffer, true);
-        m_audioEngine.stop();
-        m_audioEngine.loadFromBuffer(buffer, m_sampleRate, buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_sampleRate, false, false);
+        publish(m_beforeBuffer.get());
         return true;
     }
 
     int getSizeInUnits() override { return 100; }
 
 private:
+    void publish(const juce::AudioBuffer<float>& audio)
+    {
+        const AudioEditRange range { 0, m_bufferManager.getNumSamples(), audio.getNumSamples() };
+        m_bufferManager.setBuffer(audio, m_bufferManager.getSampleRate());
+
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, range);
+        m_waveformDisplay.applyEditedSnapshot(snapshot, range);
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    juce::AudioBuffer<float> m_afterBuffer;
+    SpooledAudioBuffer m_beforeBuffer;
+    SpooledAudioBuffer m_afterBuffer;
     double m_sampleRate;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HeadTailUndoAction)
@@ -288,46 +184,44 @@ public:
           m_sampleRate(sampleRate),
           m_description(description)
     {
-        m_beforeBuffer.makeCopyOf(beforeBuffer, true);
-        m_afterBuffer.makeCopyOf(afterBuffer, true);
+        m_beforeBuffer.assign(beforeBuffer, m_bufferManager);
+        m_afterBuffer.assign(afterBuffer, m_bufferManager);
     }
 
     bool perform() override
     {
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        buffer.setSize(m_afterBuffer.getNumChannels(), m_afterBuffer.getNumSamples());
-        buffer.makeCopyOf(m_afterBuffer, true);
-        // Time-stretch / pitch-shift rescales duration -> the sample count and
-        // timeline change, so STOP playback deterministically (reset to 0)
-        // instead of preserving a position that now maps onto different content
-        // -- matching Delete/Insert/Replace, CLAUDE.md Sec 6.5. (ResampleUndoAction
-        // is the intentional exception: it preserves real-time duration 1:1.)
-        m_audioEngine.stop();
-        m_audioEngine.loadFromBuffer(buffer, m_sampleRate, buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_sampleRate, false, false);
+        // Time-stretch / pitch-shift rescales duration, so the whole file is
+        // the edited range. Playback is not stopped: it keeps its sample
+        // position (clamped to the new end) across the swap.
+        publish(m_afterBuffer.get());
         DBG("TimePitchUndoAction::perform - " + m_description);
         return true;
     }
 
     bool undo() override
     {
-        auto& buffer = m_bufferManager.getMutableBuffer();
-        buffer.setSize(m_beforeBuffer.getNumChannels(), m_beforeBuffer.getNumSamples());
-        buffer.makeCopyOf(m_beforeBuffer, true);
-        m_audioEngine.stop();
-        m_audioEngine.loadFromBuffer(buffer, m_sampleRate, buffer.getNumChannels());
-        m_waveformDisplay.reloadFromBuffer(buffer, m_sampleRate, false, false);
+        publish(m_beforeBuffer.get());
         return true;
     }
 
     int getSizeInUnits() override { return 100; }
 
 private:
+    void publish(const juce::AudioBuffer<float>& audio)
+    {
+        const AudioEditRange range { 0, m_bufferManager.getNumSamples(), audio.getNumSamples() };
+        m_bufferManager.setBuffer(audio, m_bufferManager.getSampleRate());
+
+        const auto snapshot = m_bufferManager.getSnapshot();
+        m_audioEngine.applyEditedSnapshot(snapshot, range);
+        m_waveformDisplay.applyEditedSnapshot(snapshot, range);
+    }
+
     AudioBufferManager& m_bufferManager;
     WaveformDisplay& m_waveformDisplay;
     AudioEngine& m_audioEngine;
-    juce::AudioBuffer<float> m_beforeBuffer;
-    juce::AudioBuffer<float> m_afterBuffer;
+    SpooledAudioBuffer m_beforeBuffer;
+    SpooledAudioBuffer m_afterBuffer;
     double m_sampleRate;
     juce::String m_description;
 
@@ -0,0 +1,714 @@
+/*
+  ==============================================================================
+
+    UndoAudioSpool.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include "UndoAudioSpool.h"
+#include "Settings.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+
+//==============================================================================
+struct SpooledAudioBuffer::Entry
+{
+    enum class State
+    {
+        resident,   // samples in 'audio'
+        spilling,   // samples in 'audio', background write to 'spillFile' in flight
+        spilled,    // samples only in 'spillFile'
+        reloading   // samples only in 'spillFile', background read into 'reloadedAudio' in flight
+    };
+
+    ~Entry()
+    {
+        if (spillFile != juce::File())
+            spillFile.deleteFile();
+    }
+
+    int64_t getAudioBytes() const
+    {
+        return static_cast<int64_t>(numChannels) * numSamples * static_cast<int64_t>(sizeof(float));
+    }
+
+    /** Takes over the samples a reload read back, waiting for the read if it is still running. */
+    void completeReload()
+    {
+        if (state != State::reloading)
+            return;
+
+        reloadDone.wait(-1);
+
+        if (! reloadSucceeded)
+        {
+            // Nothing better to hand back than silence; make it visible.
+            jassertfalse;
+            juce::Logger::writeToLog("Error: Could not reload undo audio from " + spillFile.getFullPathName());
+            reloadedAudio.setSize(numChannels, numSamples);
+            reloadedAudio.clear();
+        }
+
+        DBG("UndoAudioSpool: Reloaded " + juce::String(getAudioBytes() / (1024 * 1024)) + " MB");
+
+        audio = std::move(reloadedAudio);
+        reloadedAudio = juce::AudioBuffer<float>();
+        state = State::resident;
+        spillFile.deleteFile();
+        spillFile = juce::File();
+        spilledBytes = 0;
+    }
+
+    juce::AudioBuffer<float> audio;
+    int numChannels = 0;
+    int numSamples = 0;
+    const void* owner = nullptr;   // the AudioBufferManager whose history holds this
+    uint64_t sequence = 0;         // creation order, which is history order within one owner
+    uint64_t batch = 0;            // shared by the payloads of one undoable step
+    uint64_t lastUse = 0;          // UndoAudioSpool::m_useCount at the last get()
+    State state = State::resident;
+    juce::File spillFile;
+    int64_t spilledBytes = 0;
+
+    // Written by the reload job before it signals reloadDone
+    juce::AudioBuffer<float> reloadedAudio;
+    bool reloadSucceeded = false;
+    juce::WaitableEvent reloadDone { true };
+};
+
+//==============================================================================
+namespace
+{
+    constexpr int kShuffleBlockSamples = 1 << 16;
+
+    // Byte-plane transposition: the sign/exponent bytes of neighbouring
+    // samples are nearly constant, so grouping them lets zlib find the
+    // redundancy that interleaved floats hide. Lossless by construction.
+    void shuffleBytes(const float* source, int count, uint8_t* planes)
+    {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(source);
+        for (int i = 0; i < count; ++i)
+            for (int b = 0; b < 4; ++b)
+                planes[b * count + i] = bytes[i * 4 + b];
+    }
+
+    void unshuffleBytes(const uint8_t* planes, int count, float* dest)
+    {
+        auto* bytes = reinterpret_cast<uint8_t*>(dest);
+        for (int i = 0; i < count; ++i)
+            for (int b = 0; b < 4; ++b)
+                bytes[i * 4 + b] = planes[b * count + i];
+    }
+}
+
+//==============================================================================
+// SpooledAudioBuffer
+
+SpooledAudioBuffer::SpooledAudioBuffer()
+    : m_entry(std::make_shared<Entry>())
+{
+}
+
+SpooledAudioBuffer::~SpooledAudioBuffer() = default;
+
+void SpooledAudioBuffer::assign(const juce::AudioBuffer<float>& audio, const AudioBufferManager& owner)
+{
+    juce::AudioBuffer<float> copy;
+    copy.makeCopyOf(audio, true);
+    assign(std::move(copy), owner);
+}
+
+void SpooledAudioBuffer::assign(juce::AudioBuffer<float>&& audio, const AudioBufferManager& owner)
+{
+    // A fresh entry: a background write may still be reading the old one.
+    auto entry = std::make_shared<Entry>();
+    entry->numChannels = audio.getNumChannels();
+    entry->numSamples = audio.getNumSamples();
+    entry->audio = std::move(audio);
+    entry->owner = &owner;
+    m_entry = std::move(entry);
+
+    if (m_entry->numSamples > 0)
+        if (auto* spool = UndoAudioSpool::getInstance())
+            spool->touch(m_entry);
+}
+
+const juce::AudioBuffer<float>& SpooledAudioBuffer::get()
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    auto* spool = UndoAudioSpool::getInstance();
+
+    if (m_entry->state == Entry::State::spilling)
+    {
+        // The samples were never released; just cancel. The finished write
+        // is discarded when it reports back.
+        m_entry->state = Entry::State::resident;
+    }
+    else if (m_entry->state == Entry::State::spilled)
+    {
+        // Nothing prefetched it; read it back now. Spilled files live in
+        // the spool's directory, so there is always a spool here.
+        jassert(spool != nullptr);
+        if (spool != nullptr)
+            spool->reload(m_entry);
+    }
+
+    m_entry->completeReload();
+
+    if (m_entry->numSamples > 0 && spool != nullptr)
+    {
+        m_entry->lastUse = ++spool->m_useCount;
+        spool->touch(m_entry);
+    }
+
+    return m_entry->audio;
+}
+
+bool SpooledAudioBuffer::isResident() const
+{
+    return m_entry->state == Entry::State::resident || m_entry->state == Entry::State::spilling;
+}
+
+int SpooledAudioBuffer::getNumChannels() const
+{
+    return m_entry->numChannels;
+}
+
+int SpooledAudioBuffer::getNumSamples() const
+{
+    return m_entry->numSamples;
+}
+
+//==============================================================================
+// UndoAudioSpool
+
+UndoAudioSpool* UndoAudioSpool::s_instance = nullptr;
+
+bool UndoAudioSpool::writeCompressedAudio(const juce::AudioBuffer<float>& audio, juce::OutputStream& out)
+{
+    // Fastest level: payloads can be gigabytes, and the shuffle does most
+    // of the work for audio anyway.
+    juce::GZIPCompressorOutputStream zip(out, 1);
+    juce::HeapBlock<uint8_t> planes(static_cast<size_t>(kShuffleBlockSamples) * sizeof(float));
+
+    for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+    {
+        for (int start = 0; start < audio.getNumSamples(); start += kShuffleBlockSamples)
+        {
+            const int count = juce::jmin(kShuffleBlockSamples, audio.getNumSamples() - start);
+            shuffleBytes(audio.getReadPointer(ch, start), count, planes.get());
+
+            if (! zip.write(planes.get(), static_cast<size_t>(count) * sizeof(float)))
+                return false;
+        }
+    }
+
+    zip.flush();   // writes the final compressed block
+    return true;
+}
+
+bool UndoAudioSpool::readCompressedAudio(juce::InputStream& in, juce::AudioBuffer<float>& audio)
+{
+    juce::GZIPDecompressorInputStream zip(in);
+    juce::HeapBlock<uint8_t> planes(static_cast<size_t>(kShuffleBlockSamples) * sizeof(float));
+
+    for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+    {
+        for (int start = 0; start < audio.getNumSamples(); start += kShuffleBlockSamples)
+        {
+            const int count = juce::jmin(kShuffleBlockSamples, audio.getNumSamples() - start);
+            const int numBytes = count * static_cast<int>(sizeof(float));
+
+            int done = 0;
+            while (done < numBytes)
+            {
+                const int got = zip.read(planes.get() + done, numBytes - done);
+                if (got <= 0)
+                    return false;
+                done += got;
+            }
+
+            unshuffleBytes(planes.get(), count, audio.getWritePointer(ch, start));
+        }
+    }
+
+    return true;
+}
+
+namespace
+{
+    bool writeSpillFile(const juce::AudioBuffer<float>& audio, const juce::File& file)
+    {
+        juce::FileOutputStream out(file);
+        if (out.failedToOpen() || ! UndoAudioSpool::writeCompressedAudio(audio, out))
+            return false;
+
+        out.flush();
+        return out.getStatus().wasOk();
+    }
+
+    bool readSpillFile(const juce::File& file, juce::AudioBuffer<float>& audio)
+    {
+        juce::FileInputStream in(file);
+        return in.openedOk() && UndoAudioSpool::readCompressedAudio(in, audio);
+    }
+}
+
+UndoAudioSpool* UndoAudioSpool::getInstance()
+{
+    return s_instance;
+}
+
+UndoAudioSpool::UndoAudioSpool()
+{
+    jassert(s_instance == nullptr);
+    s_instance = this;
+
+    // One directory per session so a second running instance never
+    // deletes this one's files.
+    m_directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                      .getChildFile("WaveEdit").getChildFile("Undo")
+                      .getNonexistentChildFile("session", "", false);
+}
+
+UndoAudioSpool::~UndoAudioSpool()
+{
+    // Completions still queued on the message thread find no spool and
+    // drop their results.
+    s_instance = nullptr;
+    m_reloadCallbacks.clear();
+
+    m_ioPool.removeAllJobs(true, 10000);
+    m_directory.deleteRecursively();
+}
+
+int64_t UndoAudioSpool::getResidentBytes() const
+{
+    return getResidentBytes(nullptr);
+}
+
+int64_t UndoAudioSpool::getResidentBytes(const AudioBufferManager& owner) const
+{
+    return getResidentBytes(static_cast<const void*>(&owner));
+}
+
+int64_t UndoAudioSpool::getResidentBytes(const void* owner) const
+{
+    int64_t bytes = 0;
+    for (const auto& weak : m_entries)
+    {
+        if (auto entry = weak.lock())
+        {
+            if (entry->state != SpooledAudioBuffer::Entry::State::spilled
+                && (owner == nullptr || entry->owner == owner))
+            {
+                bytes += entry->getAudioBytes();
+            }
+        }
+    }
+
+    return bytes;
+}
+
+int64_t UndoAudioSpool::getSpilledBytes() const
+{
+    int64_t bytes = 0;
+    for (const auto& weak : m_entries)
+    {
+        if (auto entry = weak.lock())
+        {
+            if (entry->state == SpooledAudioBuffer::Entry::State::spilled)
+                bytes += entry->spilledBytes;
+        }
+    }
+
+    return bytes;
+}
+
+void UndoAudioSpool::enforceCap()
+{
+    using State = SpooledAudioBuffer::Entry::State;
+
+    const int capMB = Settings::getInstance().getSetting("undo.memoryCapMB", kDefaultMemoryCapMB);
+    if (capMB <= 0)
+        return;
+
+    const int documentCapMB = Settings::getInstance().getSetting("undo.documentCapMB", kDefaultDocumentCapMB);
+    const int64_t capBytes = static_cast<int64_t>(capMB) * 1024 * 1024;
+    const int64_t documentCapBytes = documentCapMB > 0
+        ? static_cast<int64_t>(documentCapMB) * 1024 * 1024
+        : std::numeric_limits<int64_t>::max();
+
+    // What is still to be released; writes already in flight will free
+    // theirs shortly.
+    int64_t residentBytes = 0;
+    std::map<const void*, int64_t> documentBytes;
+    for (const auto& weak : m_entries)
+    {
+        if (auto entry = weak.lock())
+        {
+            if (entry->state == State::resident || entry->state == State::reloading)
+            {
+                residentBytes += entry->getAudioBytes();
+                documentBytes[entry->owner] += entry->getAudioBytes();
+            }
+        }
+    }
+
+    // Oldest first, so a long history in one tab spills its own early
+    // steps before anything of another document's. Never the most
+    // recently used payload: it is the one being performed or undone
+    // right now.
+    for (size_t i = 0; i + 1 < m_entries.size(); ++i)
+    {
+        auto entry = m_entries[i].lock();
+        if (entry == nullptr
+            || entry->state != State::resident
+            || entry->getAudioBytes() < kMinSpillBytes)
+        {
+            continue;
+        }
+
+        auto& ownerBytes = documentBytes[entry->owner];
+        if (residentBytes <= capBytes && ownerBytes <= documentCapBytes)
+            continue;
+
+        spill(entry);
+        residentBytes -= entry->getAudioBytes();
+        ownerBytes -= entry->getAudioBytes();
+    }
+}
+
+bool UndoAudioSpool::prepareHistoryStep(const AudioBufferManager& owner, bool isUndo,
+                                        std::function<void()> callback)
+{
+    using State = SpooledAudioBuffer::Entry::State;
+
+    const auto target = getHistoryTarget(&owner, isUndo);
+
+    bool pending = false;
+    for (const auto& entry : target)
+    {
+        reload(entry);
+        pending = pending || entry->state == State::reloading;
+    }
+
+    // Most recently used from here on, so enforcing the caps spills
+    // something else before the step can run.
+    for (const auto& entry : target)
+        touch(entry);
+
+    if (! pending)
+        return false;
+
+    m_reloadCallbacks.emplace_back(&owner, std::move(callback));
+    return true;
+}
+
+bool UndoAudioSpool::takeHistoryStep(const AudioBufferManager& owner, bool isUndo,
+                                     const std::function<bool()>& step)
+{
+    const uint64_t useCountBefore = m_useCount;
+    if (! step())
+        return false;
+
+    auto& position = m_history[&owner];
+
+    if (isUndo)
+    {
+        position.redoCursors.push_back(position.cursor);
+
+        // The undone step is whatever batches it just read back; the redo
+        // side now starts at the oldest payload of them. A step without
+        // audio (a region edit) reads nothing and leaves the cursor alone.
+        std::vector<uint64_t> undoneBatches;
+        for (const auto& weak : m_entries)
+            if (auto entry = weak.lock())
+                if (entry->owner == &owner && entry->lastUse > useCountBefore)
+                    undoneBatches.push_back(entry->batch);
+
+        for (const auto& weak : m_entries)
+            if (auto entry = weak.lock())
+                if (entry->owner == &owner
+                    && std::find(undoneBatches.begin(), undoneBatches.end(), entry->batch) != undoneBatches.end())
+                    position.cursor = juce::jmin(position.cursor, entry->sequence);
+    }
+    else if (! position.redoCursors.empty())
+    {
+        position.cursor = position.redoCursors.back();
+        position.redoCursors.pop_back();
+    }
+
+    prefetchHistoryTargets(&owner);
+    return true;
+}
+
+void UndoAudioSpool::touch(const EntryPtr& entry)
+{
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                   [&entry](const std::weak_ptr<SpooledAudioBuffer::Entry>& weak)
+                                   {
+                                       auto locked = weak.lock();
+                                       return locked == nullptr || locked == entry;
+                                   }),
+                    m_entries.end());
+    m_entries.push_back(entry);
+
+    if (entry->sequence == 0)
+    {
+        // A new payload means a new step was just performed: it is the
+        // newest on the undo side, and the redo side has been discarded.
+        entry->sequence = ++m_nextSequence;
+        entry->batch = getCurrentBatch();
+
+        auto& position = m_history[entry->owner];
+        position.cursor = entry->sequence + 1;
+        position.redoCursors.clear();
+
+        // Forget documents whose history is gone.
+        for (auto it = m_history.begin(); it != m_history.end();)
+        {
+            const void* owner = it->first;
+            const bool hasPayloads = std::any_of(m_entries.begin(), m_entries.end(),
+                                                 [owner](const std::weak_ptr<SpooledAudioBuffer::Entry>& weak)
+                                                 {
+                                                     auto locked = weak.lock();
+                                                     return locked != nullptr && locked->owner == owner;
+                                                 });
+            it = hasPayloads ? std::next(it) : m_history.erase(it);
+        }
+    }
+
+    enforceCap();
+}
+
+uint64_t UndoAudioSpool::getCurrentBatch()
+{
+    if (! m_batchOpen)
+    {
+        m_batchOpen = true;
+        ++m_currentBatch;
+
+        // Closed once the message loop moves on to its next callback.
+        juce::MessageManager::callAsync([]()
+        {
+            if (auto* spool = UndoAudioSpool::getInstance())
+                spool->m_batchOpen = false;
+        });
+    }
+
+    return m_currentBatch;
+}
+
+void UndoAudioSpool::spill(const EntryPtr& entry)
+{
+    m_directory.createDirectory();
+
+    // Create the file now so the next spill cannot be handed the same name.
+    const auto file = m_directory.getNonexistentChildFile("undo", ".bin", false);
+    file.create();
+
+    entry->state = SpooledAudioBuffer::Entry::State::spilling;
+    entry->spillFile = file;
+
+    // The job's strong reference keeps the samples alive while they are
+    // written; 'audio' is not modified while the state is 'spilling'.
+    m_ioPool.addJob([entry, file]() mutable
+    {
+        const bool ok = writeSpillFile(entry->audio, file);
+        std::weak_ptr<SpooledAudioBuffer::Entry> weakEntry = entry;
+        entry.reset();
+
+        // Release the RAM on the message thread, so it can never happen
+        // while an undo is reading the buffer.
+        juce::MessageManager::callAsync([weakEntry, file, ok]()
+        {
+            if (auto* spool = UndoAudioSpool::getInstance())
+                spool->finishSpill(weakEntry, file, ok);
+        });
+    });
+}
+void UndoAudioSpool::finishSpill(const std::weak_ptr<SpooledAudioBuffer::Entry>& weakEntry,
+                                 const juce::File& file, bool succeeded)
+{
+    using State = SpooledAudioBuffer::Entry::State;
+
+    auto entry = weakEntry.lock();
+
+    // Payload gone (its destructor removed the file), or re-spilled to a
+    // newer file since.
+    if (entry == nullptr || entry->spillFile != file)
+    {
+        file.deleteFile();
+        return;
+    }
+
+    if (! succeeded || entry->state != State::spilling)
+    {
+        if (! succeeded)
+            juce::Logger::writeToLog("Warning: Could not spill undo audio to " + file.getFullPathName());
+
+        entry->state = State::resident;
+        entry->spillFile = juce::File();
+        file.deleteFile();
+        return;
+    }
+
+    entry->spilledBytes = file.getSize();
+    entry->audio = juce::AudioBuffer<float>();
+    entry->state = State::spilled;
+
+    DBG("UndoAudioSpool: Spilled " + juce::String(entry->getAudioBytes() / (1024 * 1024)) + " MB as "
+        + juce::String(entry->spilledBytes / (1024 * 1024)) + " MB");
+}
+
+void UndoAudioSpool::reload(const EntryPtr& entry)
+{
+    using State = SpooledAudioBuffer::Entry::State;
+
+    if (entry->state != State::spilled)
+        return;
+
+    entry->state = State::reloading;
+    entry->reloadDone.reset();
+
+    // As with spill(), the job's reference keeps the entry alive; the
+    // message thread leaves 'spillFile' and 'reloadedAudio' alone until
+    // reloadDone is signalled.
+    const void* owner = entry->owner;
+    m_ioPool.addJob([entry, owner]() mutable
+    {
+        juce::AudioBuffer<float> audio(entry->numChannels, entry->numSamples);
+        entry->reloadSucceeded = readSpillFile(entry->spillFile, audio);
+        entry->reloadedAudio = std::move(audio);
+        entry->reloadDone.signal();
+
+        std::weak_ptr<SpooledAudioBuffer::Entry> weakEntry = entry;
+        entry.reset();
+
+        juce::MessageManager::callAsync([weakEntry, owner]()
+        {
+            if (auto* spool = UndoAudioSpool::getInstance())
+                spool->finishReload(weakEntry, owner);
+        });
+    });
+}
+
+void UndoAudioSpool::finishReload(const std::weak_ptr<SpooledAudioBuffer::Entry>& weakEntry, const void* owner)
+{
+    // get() may have taken the samples over already; this is then a no-op.
+    if (auto entry = weakEntry.lock())
+        entry->completeReload();
+
+    if (isReloading(owner))
+        return;
+
+    // Collected first: a callback may queue another one.
+    std::vector<std::function<void()>> ready;
+    for (auto it = m_reloadCallbacks.begin(); it != m_reloadCallbacks.end();)
+    {
+        if (it->first == owner)
+        {
+            ready.push_back(std::move(it->second));
+            it = m_reloadCallbacks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto& callback : ready)
+        callback();
+}
+
+std::vector<UndoAudioSpool::EntryPtr> UndoAudioSpool::getHistoryTarget(const void* owner, bool isUndo) const
+{
+    const auto position = m_history.find(owner);
+    if (position == m_history.end())
+        return {};
+
+    const uint64_t cursor = position->second.cursor;
+    const auto onTargetSide = [cursor, isUndo](const EntryPtr& entry)
+    {
+        return isUndo ? entry->sequence < cursor : entry->sequence >= cursor;
+    };
+
+    // Batches grow with the sequence, so the nearest step is the newest
+    // batch before the cursor or the oldest one after it.
+    bool found = false;
+    uint64_t targetBatch = 0;
+    for (const auto& weak : m_entries)
+    {
+        auto entry = weak.lock();
+        if (entry == nullptr || entry->owner != owner || ! onTargetSide(entry))
+            continue;
+
+        if (! found || (isUndo ? entry->batch > targetBatch : entry->batch < targetBatch))
+            targetBatch = entry->batch;
+        found = true;
+    }
+
+    std::vector<EntryPtr> target;
+    for (const auto& weak : m_entries)
+    {
+        auto entry = weak.lock();
+        if (found && entry != nullptr && entry->owner == owner
+            && entry->batch == targetBatch && onTargetSide(entry))
+        {
+            target.push_back(entry);
+        }
+    }
+
+    return target;
+}
+
+void UndoAudioSpool::prefetchHistoryTargets(const void* owner)
+{
+    for (const bool isUndo : { true, false })
+    {
+        for (const auto& entry : getHistoryTarget(owner, isUndo))
+        {
+            // Reading back what the cap would spill again at once only churns the disk.
+            if (entry->state == SpooledAudioBuffer::Entry::State::spilled
+                && fitsUnderCaps(owner, entry->getAudioBytes()))
+            {
+                reload(entry);
+            }
+        }
+    }
+}
+
+bool UndoAudioSpool::fitsUnderCaps(const void* owner, int64_t bytes) const
+{
+    const int capMB = Settings::getInstance().getSetting("undo.memoryCapMB", kDefaultMemoryCapMB);
+    const int documentCapMB = Settings::getInstance().getSetting("undo.documentCapMB", kDefaultDocumentCapMB);
+
+    if (capMB > 0 && getResidentBytes(nullptr) + bytes > static_cast<int64_t>(capMB) * 1024 * 1024)
+        return false;
+
+    return documentCapMB <= 0
+        || getResidentBytes(owner) + bytes <= static_cast<int64_t>(documentCapMB) * 1024 * 1024;
+}
+
+bool UndoAudioSpool::isReloading(const void* owner) const
+{
+    return std::any_of(m_entries.begin(), m_entries.end(),
+                       [owner](const std::weak_ptr<SpooledAudioBuffer::Entry>& weak)
+                       {
+                           auto entry = weak.lock();
+                           return entry != nullptr
+                               && entry->owner == owner
+                               && entry->state == SpooledAudioBuffer::Entry::State::reloading;
+                       });
+}
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    UndoAudioSpool.h
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+class AudioBufferManager;
+
+/**
+ * Audio payload of an undo action (the before/after copy it restores).
+ *
+ * Behaves like a read-only juce::AudioBuffer<float> that UndoAudioSpool may
+ * move to disk while it sits in the undo history. A spilled payload is read
+ * back on a background thread -- it is "pending" until then -- either ahead
+ * of time (the spool prefetches the next undo and redo targets after each
+ * history step) or when get() needs it; get() only blocks if the read has
+ * not finished yet. The shape accessors never touch the disk.
+ *
+ * Message thread only.
+ */
+class SpooledAudioBuffer
+{
+public:
+    SpooledAudioBuffer();
+    ~SpooledAudioBuffer();
+
+    /**
+     * Replaces the contents with a copy of audio. owner is the document the
+     * payload belongs to; it keys the per-document cap and is never
+     * dereferenced.
+     */
+    void assign(const juce::AudioBuffer<float>& audio, const AudioBufferManager& owner);
+
+    /** Replaces the contents with audio, taking its storage. */
+    void assign(juce::AudioBuffer<float>&& audio, const AudioBufferManager& owner);
+
+    /** The samples; waits for (or starts) the read-back first if they were spilled. */
+    const juce::AudioBuffer<float>& get();
+
+    /** True unless the samples are on disk or still being read back. */
+    bool isResident() const;
+
+    int getNumChannels() const;
+    int getNumSamples() const;
+
+    /** Shared with UndoAudioSpool (defined in the .cpp). */
+    struct Entry;
+
+private:
+    std::shared_ptr<Entry> m_entry;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpooledAudioBuffer)
+};
+
+//==============================================================================
+/**
+ * Keeps undo-history audio within a memory cap.
+ *
+ * Every SpooledAudioBuffer registers here. When the in-memory total exceeds
+ * the "undo.memoryCapMB" setting, or one document's share exceeds
+ * "undo.documentCapMB", the least recently used payloads are compressed
+ * (byte-plane shuffle + zlib, lossless) and written to the temp directory
+ * on a background thread; their RAM is released once the write has
+ * finished. Spilled payloads are decompressed on the same thread when an
+ * undo/redo is about to need them.
+ *
+ * The application creates the spool in initialise() and destroys it in
+ * shutdown(), while the message loop still runs, so no background job can
+ * outlive it. Without a spool (unit tests) payloads simply stay in RAM.
+ */
+class UndoAudioSpool
+{
+public:
+    /** Default for the "undo.memoryCapMB" setting; 0 disables spilling. */
+    static constexpr int kDefaultMemoryCapMB = 1024;
+
+    /** Default for the "undo.documentCapMB" setting; 0 disables the per-document cap. */
+    static constexpr int kDefaultDocumentCapMB = 512;
+
+    UndoAudioSpool();
+    ~UndoAudioSpool();
+
+    /** The spool the application created, or nullptr outside its lifetime. */
+    static UndoAudioSpool* getInstance();
+
+    /** Bytes of undo audio currently held in RAM (including writes in flight). */
+    int64_t getResidentBytes() const;
+
+    /** getResidentBytes() for one document's undo history. */
+    int64_t getResidentBytes(const AudioBufferManager& owner) const;
+
+    /** Compressed bytes of undo audio currently on disk. */
+    int64_t getSpilledBytes() const;
+
+    /** Spills least recently used payloads until every cap is met. */
+    void enforceCap();
+
+    /**
+     * Call before undoing (isUndo) or redoing a step of owner's history.
+     * Starts reading back any spilled payload of the step's target; if one
+     * is not in RAM yet, queues callback to run on the message thread once
+     * the reads have finished and returns true. Returns false (callback not
+     * kept) when the target is resident, so the caller can go ahead at once
+     * instead of blocking on the read in get().
+     */
+    bool prepareHistoryStep(const AudioBufferManager& owner, bool isUndo, std::function<void()> callback);
+
+    /**
+     * Runs step -- the UndoManager's undo() or redo() for owner -- and
+     * follows the history position it moves to, then prefetches the
+     * payloads of the next undo and redo targets. Returns step's result.
+     */
+    bool takeHistoryStep(const AudioBufferManager& owner, bool isUndo, const std::function<bool()>& step);
+
+    /**
+     * The spill file format (byte-plane shuffle + zlib) on its own, so the
+     * round trip can be tested without a message loop.
+     */
+    static bool writeCompressedAudio(const juce::AudioBuffer<float>& audio, juce::OutputStream& out);
+
+    /** Reads what writeCompressedAudio() wrote into audio, which must already have its shape. */
+    static bool readCompressedAudio(juce::InputStream& in, juce::AudioBuffer<float>& audio);
+
+private:
+    friend class SpooledAudioBuffer;
+
+    using EntryPtr = std::shared_ptr<SpooledAudioBuffer::Entry>;
+
+    /** Records a new or just-used payload as the most recently used. */
+    void touch(const EntryPtr& entry);
+
+    /**
+     * Id shared by every payload created during the current message-thread
+     * callback, i.e. by one undoable step (an action stores its before and
+     * after audio in its constructor).
+     */
+    uint64_t getCurrentBatch();
+
+    /** Starts the background write of one payload. */
+    void spill(const EntryPtr& entry);
+
+    /** Message-thread completion of spill(): releases the RAM, or discards a cancelled write. */
+    void finishSpill(const std::weak_ptr<SpooledAudioBuffer::Entry>& weakEntry,
+                     const juce::File& file, bool succeeded);
+
+    /** Starts the background read of one spilled payload. */
+    void reload(const EntryPtr& entry);
+
+    /** Message-thread completion of reload(): runs owner's deferred callbacks. */
+    void finishReload(const std::weak_ptr<SpooledAudioBuffer::Entry>& weakEntry, const void* owner);
+
+    /**
+     * owner's payloads that the next undo (isUndo) or redo restores: the
+     * newest batch before the history position, or the oldest after it.
+     */
+    std::vector<EntryPtr> getHistoryTarget(const void* owner, bool isUndo) const;
+
+    /** Reads back the next undo and redo targets, as long as they fit under the caps. */
+    void prefetchHistoryTargets(const void* owner);
+
+    /** True if bytes more can be resident without exceeding either cap. */
+    bool fitsUnderCaps(const void* owner, int64_t bytes) const;
+
+    int64_t getResidentBytes(const void* owner) const;
+    bool isReloading(const void* owner) const;
+
+    /** Payloads below this size are never spilled; the file churn isn't worth it. */
+    static constexpr int64_t kMinSpillBytes = 256 * 1024;
+
+    /**
+     * Where a document's undo history stands: payloads with a sequence
+     * below 'cursor' belong to steps that are applied (the undo side), the
+     * rest to undone steps (the redo side). Each undo pushes the cursor it
+     * leaves, so the matching redo can restore it even for a step whose
+     * redo does not read its payloads.
+     */
+    struct HistoryPosition
+    {
+        uint64_t cursor = 0;
+        std::vector<uint64_t> redoCursors;
+    };
+
+    std::vector<std::weak_ptr<SpooledAudioBuffer::Entry>> m_entries;  // least recently used first
+    std::vector<std::pair<const void*, std::function<void()>>> m_reloadCallbacks;
+    std::map<const void*, HistoryPosition> m_history;
+    uint64_t m_nextSequence = 0;
+    uint64_t m_currentBatch = 0;
+    bool m_batchOpen = false;
+    uint64_t m_useCount = 0;
+    juce::File m_directory;
+    juce::ThreadPool m_ioPool { 1 };
+
+    static UndoAudioSpool* s_instance;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UndoAudioSpool)
+};
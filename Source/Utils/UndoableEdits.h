@@ -26,6 +26,7 @@
 #include "Region.h"
 #include "MarkerManager.h"
 #include "Marker.h"
+#include "UndoAudioSpool.h"
 
 // UndoableEditBase + the generic Delete/Insert/Replace primitives live here.
 // Domain-specific actions live alongside their domain in Source/Utils/UndoActions/.
@@ -34,7 +35,9 @@
 //   AudioUndoActions.h          (umbrella)
 //     ├─ LevelUndoActions.h      (Gain, Normalize, DCOffsetRemoval)
 //     ├─ RangeUndoActions.h      (Silence, Trim)
-//     ├─ TransformUndoActions.h  (Reverse, Invert, Resample, HeadTail)
+//     ├─ TransformUndoActions.h  (Resample, HeadTail, TimePitch)
+//     ├─ LosslessTransformUndoActions.h (Reverse, Invert, SwapChannels;
+//     │                                  operation-log, no stored audio)
 //     └─ ChannelUndoActions.h    (ChannelConvert, ConvertToStereo,
 //                                  SilenceChannels, ReplaceChannels)
 //   RegionUndoActions.h         (umbrella)
@@ -71,54 +74,6 @@ public:
     virtual ~UndoableEditBase() = default;
 
 protected:
-    /**
-     * Updates both the audio engine and waveform display after a buffer
-     * modification that changes the buffer's LENGTH (Delete/Insert/Replace,
-     * and ApplyPluginChainAction when an effect tail extends the buffer).
-     *
-     * Deliberately stops playback and resets position to 0 rather than
-     * preserving it: a length-changing edit moves audio content around, so
-     * naively keeping the same raw position (as
-     * AudioEngine::reloadBufferPreservingPlayback() does) would silently
-     * resume playback on DIFFERENT audio content at that position -- worse
-     * than stopping, because the user has no indication the content
-     * changed. Correctly remapping the position through the shift (the way
-     * DeleteAction already remaps region start/end) is possible in
-     * principle but is not implemented here; until it is, stop-on-length-
-     * change is the safe, deterministic contract this codebase tests for
-     * (Tests/Unit/LargeOperationUndoTests.cpp,
-     * "Buffer-length-changing edits stop playback deterministically at
-     * scale"). Do NOT swap this for reloadBufferPreservingPlayback() without
-     * also fixing that remap -- see updatePlaybackAndDisplayPreservingPlayback()
-     * below for the actions where preserving is actually safe.
-     *
-     * CRITICAL FIX (Phase 1.4 - Instant Waveform Redraw):
-     * Uses updateAfterEdit() instead of reloadFromBuffer() for seamless editing workflow.
-     * - NO screen flash (no loading state)
-     * - NO view jump (preserves zoom and scroll)
-     * - NO progressive redraw (synchronous update)
-     * - Preserves edit cursor position
-     *
-     * Region Fix: Also updates RegionDisplay to synchronize region positions with waveform changes.
-     */
-    void updatePlaybackAndDisplay()
-    {
-        // CRITICAL: Stop playback first to avoid race conditions
-        // Updating the buffer while the audio callback is reading it can cause glitches or crashes
-        m_audioEngine.stop();
-
-        // Update audio engine for playback
-        if (!m_audioEngine.loadFromBuffer(
-            m_bufferManager.getBuffer(),
-            m_bufferManager.getSampleRate(),
-            m_bufferManager.getNumChannels()))
-        {
-            DBG("ERROR: Failed to update audio engine after undo/redo");
-        }
-
-        updateWaveformAndRegionDisplay();
-    }
-
     /**
      * Updates the audio engine and waveform display after a buffer
      * modification that does NOT change the buffer's length -- channel
@@ -132,20 +87,59 @@ protected:
      * Fade, Normalize, etc. -- which already do this). Callers MUST verify
      * the edit is actually length-preserving before using this method; if
      * it might not be (e.g. a plugin chain render with a reverb/delay
-     * tail), fall back to updatePlaybackAndDisplay() instead -- see
+     * tail), use updatePlaybackAndDisplay(range) instead -- see
      * ApplyPluginChainAction::perform()/undo().
      */
     void updatePlaybackAndDisplayPreservingPlayback()
     {
-        if (!m_audioEngine.reloadBufferPreservingPlayback(
-            m_bufferManager.getBuffer(),
-            m_bufferManager.getSampleRate(),
-            m_bufferManager.getNumChannels()))
+        const auto snapshot = m_bufferManager.getSnapshot();
+        if (!m_audioEngine.reloadSnapshotPreservingPlayback(snapshot))
+        {
+            DBG("ERROR: Failed to update audio engine after undo/redo");
+        }
+
+        updateWaveformAndRegionDisplay(snapshot);
+    }
+
+    /**
+     * Updates the audio engine and waveform display after an edit of range,
+     * which may change the buffer's LENGTH (Delete/Insert/Replace, and
+     * ApplyPluginChainAction when an effect tail extends the buffer).
+     *
+     * Playback is NOT stopped: the engine hot-swaps the snapshot and remaps
+     * the play position through the range (AudioEditRange::remapPosition()),
+     * so audio after the edit keeps playing from the same material -- the
+     * same shift DeleteAction applies to region start/end. The waveform
+     * keeps its view and edit cursor, and region displays are re-synced
+     * when the duration changed.
+     */
+    void updatePlaybackAndDisplay(const AudioEditRange& range)
+    {
+        updatePlaybackAndDisplayPreservingPlayback(range);
+
+        if (range.changesLength())
+            refreshRegionDisplay();
+    }
+
+    /**
+     * Publishes the edit of range to the engine and the waveform: the
+     * engine hot-swaps the snapshot under the running transport and the
+     * waveform repaints only what changed (the edited columns for an
+     * in-place edit). Region displays are left alone; see
+     * updatePlaybackAndDisplay(range) for edits that move them.
+     */
+    void updatePlaybackAndDisplayPreservingPlayback(const AudioEditRange& range)
+    {
+        const auto snapshot = m_bufferManager.getSnapshot();
+        if (!m_audioEngine.applyEditedSnapshot(snapshot, range))
         {
             DBG("ERROR: Failed to update audio engine after undo/redo");
         }
 
-        updateWaveformAndRegionDisplay();
+        if (!m_waveformDisplay.applyEditedSnapshot(snapshot, range))
+        {
+            DBG("Warning: Failed to update waveform display after undo/redo");
+        }
     }
 
     /**
@@ -171,6 +165,30 @@ protected:
         markerDisplay->repaint();
     }
 
+    /**
+     * Re-syncs the RegionDisplay (duration, visible range, repaint) with the
+     * waveform. Part of every full update; the in-place path skips it, so an
+     * in-place action that removed regions calls it itself.
+     */
+    void refreshRegionDisplay()
+    {
+        if (m_regionDisplay)
+        {
+            // Update total duration so RegionDisplay can properly position regions
+            double newDuration = static_cast<double>(m_bufferManager.getNumSamples()) / m_bufferManager.getSampleRate();
+            m_regionDisplay->setTotalDuration(newDuration);
+
+            // CRITICAL FIX: Also update the visible range from WaveformDisplay
+            // This ensures regions redraw correctly after undo without needing to zoom
+            double visibleStart = m_waveformDisplay.getVisibleRangeStart();
+            double visibleEnd = m_waveformDisplay.getVisibleRangeEnd();
+            m_regionDisplay->setVisibleRange(visibleStart, visibleEnd);
+
+            // Force repaint to show updated region positions
+            m_regionDisplay->repaint();
+        }
+    }
+
     AudioBufferManager& m_bufferManager;
     AudioEngine& m_audioEngine;
     WaveformDisplay& m_waveformDisplay;
@@ -178,16 +196,15 @@ protected:
     RegionDisplay* m_regionDisplay;    // Optional - may be nullptr if no region display
 
 private:
-    /** Shared waveform/region display refresh used by both playback-update
-        variants above (the only difference between them is the AudioEngine
-        reload strategy). */
-    void updateWaveformAndRegionDisplay()
+    /** Full waveform/region display refresh behind
+        updatePlaybackAndDisplayPreservingPlayback(), for edits without a
+        known range. */
+    void updateWaveformAndRegionDisplay(const AudioSnapshotPtr& snapshot)
     {
-        // CRITICAL FIX: Use reloadFromBuffer() with preserve flags
+        // CRITICAL FIX: Use reloadFromSnapshot() with preserve flags
         // This preserves view position and edit cursor for seamless workflow
-        if (!m_waveformDisplay.reloadFromBuffer(
-            m_bufferManager.getBuffer(),
-            m_bufferManager.getSampleRate(),
+        if (!m_waveformDisplay.reloadFromSnapshot(
+            snapshot,
             true,  // preserveView = true
             true)) // preserveEditCursor = true
         {
@@ -196,21 +213,7 @@ private:
 
         // REGION FIX: Update RegionDisplay to synchronize with waveform changes
         // After delete/undo, the total duration changes and regions need to be redrawn
-        if (m_regionDisplay)
-        {
-            // Update total duration so RegionDisplay can properly position regions
-            double newDuration = static_cast<double>(m_bufferManager.getNumSamples()) / m_bufferManager.getSampleRate();
-            m_regionDisplay->setTotalDuration(newDuration);
-
-            // CRITICAL FIX: Also update the visible range from WaveformDisplay
-            // This ensures regions redraw correctly after undo without needing to zoom
-            double visibleStart = m_waveformDisplay.getVisibleRangeStart();
-            double visibleEnd = m_waveformDisplay.getVisibleRangeEnd();
-            m_regionDisplay->setVisibleRange(visibleStart, visibleEnd);
-
-            // Force repaint to show updated region positions
-            m_regionDisplay->repaint();
-        }
+        refreshRegionDisplay();
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UndoableEditBase)
@@ -241,7 +244,7 @@ public:
         jassert(numSamples > 0 && (startSample + numSamples) <= m_bufferManager.getNumSamples());
 
         // Store the audio data that will be deleted
-        m_deletedAudio = m_bufferManager.getAudioRange(startSample, numSamples);
+        m_deletedAudio.assign(m_bufferManager.getAudioRange(startSample, numSamples), m_bufferManager);
         m_sampleRate = m_bufferManager.getSampleRate();
 
         // Save all region positions BEFORE the delete (for undo)
@@ -333,7 +336,7 @@ public:
                 }
             }
 
-            updatePlaybackAndDisplay();
+            updatePlaybackAndDisplay(AudioEditRange { m_startSample, m_numSamples, 0 });
         }
 
         return success;
@@ -342,7 +345,7 @@ public:
     bool undo() override
     {
         // Restore the deleted audio by inserting it back
-        bool success = m_bufferManager.insertAudio(m_startSample, m_deletedAudio);
+        bool success = m_bufferManager.insertAudio(m_startSample, m_deletedAudio.get());
 
         if (success)
         {
@@ -359,7 +362,7 @@ public:
                 }
             }
 
-            updatePlaybackAndDisplay();
+            updatePlaybackAndDisplay(AudioEditRange { m_startSample, 0, m_numSamples });
         }
 
         return success;
@@ -375,7 +378,7 @@ public:
 private:
     int64_t m_startSample;
     int64_t m_numSamples;
-    juce::AudioBuffer<float> m_deletedAudio;
+    SpooledAudioBuffer m_deletedAudio;
     double m_sampleRate;
     juce::Array<Region> m_savedRegions;  // Saved region positions for undo
 
@@ -402,7 +405,6 @@ public:
         : UndoableEditBase(bufferManager, audioEngine, waveformDisplay, regionManager, regionDisplay),
           m_insertPosition(insertPosition),
           m_numSamples(audioToInsert.getNumSamples()),
-          m_audioToInsert(audioToInsert.getNumChannels(), audioToInsert.getNumSamples()),
           m_markerManager(markerManager),
           m_markerDisplay(markerDisplay)
     {
@@ -413,10 +415,7 @@ public:
         jassert(audioToInsert.getNumChannels() > 0);
 
         // Store a copy of the audio to insert
-        for (int ch = 0; ch < audioToInsert.getNumChannels(); ++ch)
-        {
-            m_audioToInsert.copyFrom(ch, 0, audioToInsert, ch, 0, audioToInsert.getNumSamples());
-        }
+        m_audioToInsert.assign(audioToInsert, m_bufferManager);
 
         m_sampleRate = m_bufferManager.getSampleRate();
 
@@ -446,7 +445,7 @@ public:
     bool perform() override
     {
         // Perform the insert operation
-        bool success = m_bufferManager.insertAudio(m_insertPosition, m_audioToInsert);
+        bool success = m_bufferManager.insertAudio(m_insertPosition, m_audioToInsert.get());
 
         if (success)
         {
@@ -500,7 +499,7 @@ public:
                 }
             }
 
-            updatePlaybackAndDisplay();
+            updatePlaybackAndDisplay(AudioEditRange { m_insertPosition, 0, m_numSamples });
             refreshMarkerDisplay(m_markerDisplay);
         }
 
@@ -530,7 +529,7 @@ public:
                     m_markerManager->addMarker(marker);
             }
 
-            updatePlaybackAndDisplay();
+            updatePlaybackAndDisplay(AudioEditRange { m_insertPosition, m_numSamples, 0 });
             refreshMarkerDisplay(m_markerDisplay);
         }
 
@@ -547,7 +546,7 @@ public:
 private:
     int64_t m_insertPosition;
     int64_t m_numSamples;
-    juce::AudioBuffer<float> m_audioToInsert;
+    SpooledAudioBuffer m_audioToInsert;
     double m_sampleRate;
     juce::Array<Region> m_savedRegions;  // Saved region positions for undo
     MarkerManager* m_markerManager;      // Optional - may be nullptr if no markers
@@ -578,7 +577,6 @@ public:
         : UndoableEditBase(bufferManager, audioEngine, waveformDisplay, regionManager, regionDisplay),
           m_startSample(startSample),
           m_numSamplesToReplace(numSamplesToReplace),
-          m_newAudio(newAudio.getNumChannels(), newAudio.getNumSamples()),
           m_markerManager(markerManager),
           m_markerDisplay(markerDisplay)
     {
@@ -590,13 +588,10 @@ public:
         jassert(newAudio.getNumChannels() > 0);
 
         // Store the original audio that will be replaced
-        m_originalAudio = m_bufferManager.getAudioRange(startSample, numSamplesToReplace);
+        m_originalAudio.assign(m_bufferManager.getAudioRange(startSample, numSamplesToReplace), m_bufferManager);
 
         // Store a copy of the new audio
-        for (int ch = 0; ch < newAudio.getNumChannels(); ++ch)
-        {
-            m_newAudio.copyFrom(ch, 0, newAudio, ch, 0, newAudio.getNumSamples());
-        }
+        m_newAudio.assign(newAudio, m_bufferManager);
 
         m_sampleRate = m_bufferManager.getSampleRate();
 
@@ -626,14 +621,13 @@ public:
     bool perform() override
     {
         // Perform the replace operation
-        bool success = m_bufferManager.replaceRange(m_startSample, m_numSamplesToReplace, m_newAudio);
+        bool success = m_bufferManager.replaceRange(m_startSample, m_numSamplesToReplace, m_newAudio.get());
 
         if (success)
         {
             shiftRegionsForReplace(m_numSamplesToReplace, m_newAudio.getNumSamples());
             shiftMarkersForReplace(m_numSamplesToReplace, m_newAudio.getNumSamples());
-            updatePlaybackAndDisplay();
-            refreshMarkerDisplay(m_markerDisplay);
+            updateAfterReplace(AudioEditRange { m_startSample, m_numSamplesToReplace, m_newAudio.getNumSamples() });
         }
 
         return success;
@@ -642,7 +636,7 @@ public:
     bool undo() override
     {
         // Undo the replace by restoring the original audio
-        bool success = m_bufferManager.replaceRange(m_startSample, m_newAudio.getNumSamples(), m_originalAudio);
+        bool success = m_bufferManager.replaceRange(m_startSample, m_newAudio.getNumSamples(), m_originalAudio.get());
 
         if (success)
         {
@@ -662,8 +656,7 @@ public:
                     m_markerManager->addMarker(marker);
             }
 
-            updatePlaybackAndDisplay();
-            refreshMarkerDisplay(m_markerDisplay);
+            updateAfterReplace(AudioEditRange { m_startSample, m_newAudio.getNumSamples(), m_numSamplesToReplace });
         }
 
         return success;
@@ -694,6 +687,21 @@ private:
      *   changed, so -- matching DeleteAction's convention for the same
      *   ambiguous case -- remove it rather than guess new boundaries.
      */
+    /**
+     * A same-length replace keeps playback running, but it may still have
+     * removed regions/markers overlapping the range, so those displays are
+     * refreshed regardless.
+     */
+    void updateAfterReplace(const AudioEditRange& range)
+    {
+        updatePlaybackAndDisplay(range);
+
+        if (!range.changesLength())
+            refreshRegionDisplay();
+
+        refreshMarkerDisplay(m_markerDisplay);
+    }
+
     void shiftRegionsForReplace(int64_t oldLength, int64_t newLength)
     {
         if (!m_regionManager || m_regionManager->getNumRegions() == 0)
@@ -772,8 +780,8 @@ private:
 
     int64_t m_startSample;
     int64_t m_numSamplesToReplace;
-    juce::AudioBuffer<float> m_originalAudio;
-    juce::AudioBuffer<float> m_newAudio;
+    SpooledAudioBuffer m_originalAudio;
+    SpooledAudioBuffer m_newAudio;
     double m_sampleRate;
     juce::Array<Region> m_savedRegions;  // Saved region positions for undo
     MarkerManager* m_markerManager;      // Optional - may be nullptr if no markers
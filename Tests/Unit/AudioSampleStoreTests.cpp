@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+    AudioSampleStoreTests.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "../../Source/Audio/AudioSampleStore.h"
+#include "../../Source/Audio/AudioBlockSource.h"
+#include <limits>
+
+namespace
+{
+    /** Every sample holds its own document position (plus 0.5 per channel). */
+    AudioSampleStore::ChunkPtr makeRampChunk(int numChannels, int numSamples, int firstValue)
+    {
+        auto chunk = std::make_shared<juce::AudioBuffer<float>>(numChannels, numSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                chunk->setSample(ch, i, static_cast<float>(firstValue + i) + 0.5f * static_cast<float>(ch));
+        return chunk;
+    }
+
+    /** Three 100-sample pieces holding the ramp 0..299. */
+    AudioSampleStore makeThreePieceStore(int numChannels)
+    {
+        AudioSampleStore store;
+        store.append(makeRampChunk(numChannels, 100, 0));
+        store.append(makeRampChunk(numChannels, 100, 100));
+        store.append(makeRampChunk(numChannels, 100, 200));
+        return store;
+    }
+
+    juce::AudioBuffer<float> readAll(const AudioSampleStore& store)
+    {
+        juce::AudioBuffer<float> out(store.getNumChannels(), static_cast<int>(store.getNumSamples()));
+        store.read(out, 0, 0, out.getNumSamples());
+        return out;
+    }
+}
+
+class AudioSampleStoreTests : public juce::UnitTest
+{
+public:
+    AudioSampleStoreTests() : juce::UnitTest("AudioSampleStore", "AudioSampleStore") {}
+
+    void runTest() override
+    {
+        testReadAcrossPieces();
+        testEraseAcrossPieces();
+        testInsertAtAndInsidePieces();
+        testReplaceAcrossPieces();
+        testTrimAndCopiesAreIndependent();
+        testBeyondIntMaxBookkeeping();
+        testBlockSourceStreamsInBlocks();
+    }
+
+private:
+    void testReadAcrossPieces()
+    {
+        beginTest("readRange spans piece boundaries");
+
+        auto store = makeThreePieceStore(2);
+        expectEquals(store.getNumPieces(), 3);
+        expectEquals(store.getNumSamples(), static_cast<int64_t>(300));
+
+        juce::AudioBuffer<float> dest(2, 150);
+        dest.clear();
+        expect(store.read(dest, 10, 95, 130));   // 95..224, three pieces
+
+        for (int i = 0; i < 130; ++i)
+        {
+            expectEquals(dest.getSample(0, 10 + i), static_cast<float>(95 + i));
+            expectEquals(dest.getSample(1, 10 + i), static_cast<float>(95 + i) + 0.5f);
+        }
+
+        float single[20] = {};
+        expect(store.readChannel(1, single, 190, 20));
+        for (int i = 0; i < 20; ++i)
+            expectEquals(single[i], static_cast<float>(190 + i) + 0.5f);
+
+        expect(! store.read(dest, 0, 290, 20), "reading past the end must fail");
+        expect(! store.read(dest, 140, 0, 20), "overrunning dest must fail");
+    }
+
+    void testEraseAcrossPieces()
+    {
+        beginTest("erase removes a range spanning several pieces");
+
+        auto store = makeThreePieceStore(1);
+        expect(store.erase(50, 200));   // keeps 0..49 and 250..299
+
+        expectEquals(store.getNumSamples(), static_cast<int64_t>(100));
+        const auto out = readAll(store);
+        for (int i = 0; i < 50; ++i)
+        {
+            expectEquals(out.getSample(0, i), static_cast<float>(i));
+            expectEquals(out.getSample(0, 50 + i), static_cast<float>(250 + i));
+        }
+
+        expect(! store.erase(90, 20), "erasing past the end must fail");
+        expectEquals(store.getNumSamples(), static_cast<int64_t>(100));
+    }
+
+    void testInsertAtAndInsidePieces()
+    {
+        beginTest("insert at a boundary and inside a piece");
+
+        auto store = makeThreePieceStore(1);
+        juce::AudioBuffer<float> marker(1, 5);
+        marker.clear();
+        for (int i = 0; i < 5; ++i)
+            marker.setSample(0, i, -1.0f);
+
+        expect(store.insert(100, marker));   // exactly on a boundary
+        expect(store.insert(150, marker));   // inside the second piece (original 145)
+        expect(store.insert(store.getNumSamples(), marker));   // append
+        expect(! store.insert(store.getNumSamples() + 1, marker));
+
+        expectEquals(store.getNumSamples(), static_cast<int64_t>(315));
+        const auto out = readAll(store);
+
+        expectEquals(out.getSample(0, 99), 99.0f);
+        expectEquals(out.getSample(0, 100), -1.0f);
+        expectEquals(out.getSample(0, 105), 100.0f);
+        expectEquals(out.getSample(0, 149), 144.0f);
+        expectEquals(out.getSample(0, 150), -1.0f);
+        expectEquals(out.getSample(0, 155), 145.0f);
+        expectEquals(out.getSample(0, 309), 299.0f);
+        expectEquals(out.getSample(0, 310), -1.0f);
+
+        juce::AudioBuffer<float> stereo(2, 5);
+        stereo.clear();
+        expect(! store.insert(0, stereo), "channel mismatch must be rejected");
+    }
+
+    void testReplaceAcrossPieces()
+    {
+        beginTest("replace with shorter and with empty audio");
+
+        auto store = makeThreePieceStore(1);
+        juce::AudioBuffer<float> patch(1, 10);
+        for (int i = 0; i < 10; ++i)
+            patch.setSample(0, i, 1000.0f + static_cast<float>(i));
+
+        expect(store.replace(90, 30, patch));   // 90..119 -> 10 samples
+        expectEquals(store.getNumSamples(), static_cast<int64_t>(280));
+
+        auto out = readAll(store);
+        expectEquals(out.getSample(0, 89), 89.0f);
+        expectEquals(out.getSample(0, 90), 1000.0f);
+        expectEquals(out.getSample(0, 99), 1009.0f);
+        expectEquals(out.getSample(0, 100), 120.0f);
+
+        juce::AudioBuffer<float> empty(1, 0);
+        expect(store.replace(0, 10, empty), "an empty replacement is a delete");
+        expectEquals(store.getNumSamples(), static_cast<int64_t>(270));
+
+        const auto before = readAll(store);
+        expect(! store.replace(260, 20, patch), "out-of-range replace must fail");
+        const auto after = readAll(store);
+        expectEquals(after.getNumSamples(), before.getNumSamples());
+        for (int i = 0; i < after.getNumSamples(); ++i)
+            expectEquals(after.getSample(0, i), before.getSample(0, i));
+    }
+
+    void testTrimAndCopiesAreIndependent()
+    {
+        beginTest("trim, and edits do not leak into copies");
+
+        auto store = makeThreePieceStore(1);
+        const AudioSampleStore copy = store;
+
+        expect(store.trim(150, 100));
+        expectEquals(store.getNumSamples(), static_cast<int64_t>(100));
+        expectEquals(readAll(store).getSample(0, 0), 150.0f);
+
+        // The copy still sees the original three pieces.
+        expectEquals(copy.getNumSamples(), static_cast<int64_t>(300));
+        expectEquals(copy.getNumPieces(), 3);
+        expectEquals(readAll(copy).getSample(0, 299), 299.0f);
+
+        // A consolidated chunk shared with a copy is not exclusive.
+        AudioSampleStore single;
+        single.append(makeRampChunk(1, 64, 0));
+        expect(single.isConsolidated());
+        const AudioSampleStore sharer = single;
+        expect(! single.isExclusivelyConsolidated());
+        auto privateChunk = single.consolidateExclusive();
+        expect(privateChunk != nullptr && single.isExclusivelyConsolidated());
+        privateChunk->setSample(0, 0, 42.0f);
+        expectEquals(readAll(sharer).getSample(0, 0), 0.0f);
+    }
+
+    void testBeyondIntMaxBookkeeping()
+    {
+        beginTest("lengths and positions past INT_MAX");
+
+        // One shared 1M-frame chunk referenced 2100 times: ~2.2G frames of
+        // document for 4 MB of RAM.
+        constexpr int chunkLength = 1 << 20;
+        constexpr int repeats = 2100;
+        auto chunk = makeRampChunk(1, chunkLength, 0);
+
+        AudioSampleStore store;
+        for (int i = 0; i < repeats; ++i)
+            expect(store.append(chunk));
+
+        const int64_t total = static_cast<int64_t>(chunkLength) * repeats;
+        const int64_t intMax = std::numeric_limits<int>::max();
+        expectEquals(store.getNumSamples(), total);
+        expect(store.getNumSamples() > intMax);
+        expectEquals(store.getResidentBytes(), static_cast<int64_t>(chunkLength) * static_cast<int64_t>(sizeof(float)));
+
+        // Reads straddling INT_MAX land on the right frames.
+        float frames[8] = {};
+        const int64_t start = intMax - 3;
+        expect(store.readChannel(0, frames, start, 8));
+        for (int i = 0; i < 8; ++i)
+            expectEquals(frames[i], static_cast<float>((start + i) % chunkLength));
+
+        // Edits beyond INT_MAX split pieces and keep the bookkeeping exact.
+        juce::AudioBuffer<float> patch(1, 4);
+        patch.clear();
+        expect(store.insert(intMax + 10, patch));
+        expectEquals(store.getNumSamples(), total + 4);
+        expect(store.erase(intMax - 100, 300));
+        expectEquals(store.getNumSamples(), total + 4 - 300);
+
+        expect(store.readChannel(0, frames, intMax - 101, 2));
+        expectEquals(frames[0], static_cast<float>((intMax - 101) % chunkLength));
+        expectEquals(frames[1], static_cast<float>((intMax - 100 + 300 - 4) % chunkLength));
+
+        expect(store.consolidate() == nullptr, "a document past INT_MAX cannot be one chunk");
+
+        expect(store.trim(total - chunkLength, chunkLength - 296));
+        expectEquals(store.getNumSamples(), static_cast<int64_t>(chunkLength - 296));
+    }
+
+    void testBlockSourceStreamsInBlocks()
+    {
+        beginTest("block source reads a store-backed snapshot block by block");
+
+        AudioSampleStore store;
+        const int pieceLength = AudioBlockSource::kBlockSamples / 3;
+        for (int i = 0; i < 5; ++i)
+            store.append(makeRampChunk(2, pieceLength, i * pieceLength));
+
+        auto snapshot = std::make_shared<const AudioSnapshot>(store, 48000.0, 1);
+        const auto source = AudioBlockSource::fromSnapshot(snapshot);
+        expectEquals(source.numSamples, static_cast<int64_t>(5 * pieceLength));
+
+        juce::AudioBuffer<float> block(2, 1000);
+        expect(source.read(block, pieceLength - 500, 1000));
+        for (int i = 0; i < 1000; ++i)
+            expectEquals(block.getSample(1, i), static_cast<float>(pieceLength - 500 + i) + 0.5f);
+    }
+};
+
+static AudioSampleStoreTests audioSampleStoreTests;
@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    AutomationSliceTests.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "../../Source/Automation/AutomationData.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    using Curve = AutomationPoint::CurveType;
+
+    constexpr double kSampleRate = 44100.0;
+    constexpr int kTotalSamples = 14000;
+
+    /**
+     * Flat, step and every ramp shape, with breakpoints on sample times and
+     * one between samples. 6000 -> 6150 leaves a ramp remainder of 150
+     * samples, between one ramp slice and one ramp slice plus a minimum one.
+     */
+    std::vector<AutomationPoint> makePoints()
+    {
+        const auto at = [](double sample, float value, Curve curve)
+        {
+            AutomationPoint point;
+            point.timeInSeconds = sample / kSampleRate;
+            point.value = value;
+            point.curve = curve;
+            return point;
+        };
+
+        return { at(1000.0, 0.2f, Curve::Step),
+                 at(3000.0, 0.8f, Curve::Linear),
+                 at(6000.0, 0.3f, Curve::SCurve),
+                 at(6150.0, 0.9f, Curve::Exponential),
+                 at(6250.0, 0.1f, Curve::Linear),
+                 at(9000.3, 0.1f, Curve::Step),
+                 at(12000.0, 0.4f, Curve::Linear) };
+    }
+
+    /** Where the renderers read a sample: half a sample in (AutomationManager, PluginChainRenderer). */
+    double readTime(int64_t sample)
+    {
+        return (static_cast<double>(sample) + 0.5) / kSampleRate;
+    }
+
+    /** The first sample whose read time is at or past a breakpoint, i.e. the first one it applies to. */
+    int64_t firstSampleAt(double pointTime)
+    {
+        int64_t sample = static_cast<int64_t>(std::floor(pointTime * kSampleRate)) - 1;
+        while (readTime(sample) < pointTime)
+            ++sample;
+        return sample;
+    }
+
+    /** The per-sample reference: a fresh cursor, so a plain binary search. */
+    float valueAt(const std::vector<AutomationPoint>& points, int64_t sample)
+    {
+        AutomationCurve::Cursor cursor;
+        return AutomationCurve::evaluateSegment(points, readTime(sample), cursor).value;
+    }
+
+    struct Slice
+    {
+        int64_t start;
+        int length;
+        AutomationCurve::Segment segment;
+    };
+
+    /** Slices the way the renderers do: per block, one cursor carried across blocks. */
+    std::vector<Slice> render(const std::vector<AutomationPoint>& points, int blockSize)
+    {
+        std::vector<Slice> slices;
+        AutomationCurve::Cursor cursor;
+
+        for (int64_t blockStart = 0; blockStart < kTotalSamples; blockStart += blockSize)
+        {
+            const int64_t blockEnd = juce::jmin(blockStart + blockSize, static_cast<int64_t>(kTotalSamples));
+
+            for (int64_t pos = blockStart; pos < blockEnd;)
+            {
+                const double t = readTime(pos);
+                const auto segment = AutomationCurve::evaluateSegment(points, t, cursor);
+                const int length = AutomationCurve::samplesUntilUpdate(segment, t, kSampleRate,
+                                                                       static_cast<int>(blockEnd - pos));
+                slices.push_back({ pos, length, segment });
+                pos += length;
+            }
+        }
+
+        return slices;
+    }
+}
+
+/**
+ * Pins sub-block automation against per-sample evaluation: each slice holds
+ * the value a per-sample read gives at its first sample, stays exact until
+ * the next breakpoint unless ramping, and a breakpoint starts a new slice.
+ */
+class AutomationSliceTests : public juce::UnitTest
+{
+public:
+    AutomationSliceTests() : juce::UnitTest("AutomationSlice", "AutomationSlice") {}
+
+    void runTest() override
+    {
+        testSliceValues();
+        testBreakpointBoundaries();
+        testSliceLengthOne();
+    }
+
+private:
+    /** Largest change of the reference between neighbouring samples, away from step jumps. */
+    float maxRampStep(const std::vector<AutomationPoint>& points)
+    {
+        float maxStep = 0.0f;
+        for (int64_t sample = 1; sample < kTotalSamples; ++sample)
+        {
+            const bool isBreakpoint = std::any_of(points.begin(), points.end(),
+                [sample](const AutomationPoint& point) { return firstSampleAt(point.timeInSeconds) == sample; });
+            if (! isBreakpoint)
+                maxStep = juce::jmax(maxStep, std::abs(valueAt(points, sample) - valueAt(points, sample - 1)));
+        }
+        return maxStep;
+    }
+
+    void checkSlices(const std::vector<AutomationPoint>& points, int blockSize)
+    {
+        const float rampStep = maxRampStep(points);
+
+        for (const auto& slice : render(points, blockSize))
+        {
+            expect(slice.length >= 1);
+            expectEquals(slice.segment.value, valueAt(points, slice.start),
+                         "slice value at sample " + juce::String(slice.start));
+
+            if (slice.segment.ramping)
+                expect(slice.length <= AutomationCurve::kRampSliceSamples);
+
+            const int64_t nextPoint = std::isinf(slice.segment.nextPointTime)
+                ? kTotalSamples : firstSampleAt(slice.segment.nextPointTime);
+
+            // Past a breakpoint only when it was closer than the minimum slice
+            if (slice.start + slice.length > nextPoint)
+                expect(nextPoint - slice.start < AutomationCurve::kMinSliceSamples,
+                       "slice at " + juce::String(slice.start) + " runs past the breakpoint at "
+                           + juce::String(nextPoint));
+
+            for (int64_t sample = slice.start; sample < juce::jmin(slice.start + slice.length, nextPoint); ++sample)
+            {
+                const float reference = valueAt(points, sample);
+                if (slice.segment.ramping)
+                    expect(std::abs(reference - slice.segment.value)
+                               <= rampStep * static_cast<float>(sample - slice.start) + 1.0e-6f,
+                           "ramp error at sample " + juce::String(sample));
+                else
+                    expectEquals(slice.segment.value, reference, "held value at sample " + juce::String(sample));
+            }
+        }
+    }
+
+    void testSliceValues()
+    {
+        beginTest("slice values match per-sample evaluation");
+
+        const auto points = makePoints();
+        for (const int blockSize : { 64, 512, 1024, 4096 })
+            checkSlices(points, blockSize);
+    }
+
+    void testBreakpointBoundaries()
+    {
+        beginTest("breakpoints start a slice");
+
+        // One block over everything, so only breakpoints and ramps split it
+        const auto points = makePoints();
+        const auto slices = render(points, kTotalSamples);
+
+        for (const auto& point : points)
+        {
+            const int64_t boundary = firstSampleAt(point.timeInSeconds);
+            const bool startsSlice = std::any_of(slices.begin(), slices.end(),
+                [boundary](const Slice& s) { return s.start == boundary; });
+            expect(startsSlice, "no slice starts at the breakpoint sample " + juce::String(boundary));
+        }
+
+        // The off-grid point at 9000.3 applies from sample 9000 (read at 9000.5)
+        expectEquals(firstSampleAt(points[5].timeInSeconds), static_cast<int64_t>(9000));
+
+        checkSlices(points, kTotalSamples);
+    }
+
+    void testSliceLengthOne()
+    {
+        beginTest("a slice length of 1 is per-sample evaluation");
+
+        const auto points = makePoints();
+        const auto slices = render(points, 1);
+
+        expectEquals(static_cast<int>(slices.size()), kTotalSamples);
+        for (const auto& slice : slices)
+        {
+            expectEquals(slice.length, 1);
+            expectEquals(slice.segment.value, valueAt(points, slice.start),
+                         "value at sample " + juce::String(slice.start));
+        }
+
+        // Nothing left to render still advances by one sample
+        AutomationCurve::Cursor cursor;
+        const auto segment = AutomationCurve::evaluateSegment(points, readTime(0), cursor);
+        expectEquals(AutomationCurve::samplesUntilUpdate(segment, readTime(0), kSampleRate, 0), 1);
+    }
+};
+
+static AutomationSliceTests automationSliceTests;
@@ -0,0 +1,261 @@
+/*
+  ==============================================================================
+
+    ParametricEQCascadeTests.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include "../../Source/DSP/DynamicParametricEQ.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    using EQ = DynamicParametricEQ;
+    using Coefficients = juce::dsp::IIR::Coefficients<float>;
+
+    constexpr double kSampleRate = 44100.0;
+
+    EQ::BandParameters makeBand(EQ::FilterType type, float frequency, float gain, float q, bool enabled = true)
+    {
+        EQ::BandParameters band;
+        band.filterType = type;
+        band.frequency = frequency;
+        band.gain = gain;
+        band.q = q;
+        band.enabled = enabled;
+        return band;
+    }
+
+    /** Every filter type, plus a disabled band the cascade must skip. All values are in range, so nothing is clamped. */
+    EQ::Parameters makeParameters()
+    {
+        EQ::Parameters params;
+        params.bands = { makeBand(EQ::FilterType::LowCut, 40.0f, 0.0f, 0.707f),
+                         makeBand(EQ::FilterType::LowShelf, 120.0f, 4.0f, 0.8f),
+                         makeBand(EQ::FilterType::Bell, 1000.0f, -6.0f, 2.0f),
+                         makeBand(EQ::FilterType::Bell, 2500.0f, 9.0f, 4.0f, false),
+                         makeBand(EQ::FilterType::Notch, 3000.0f, 0.0f, 8.0f),
+                         makeBand(EQ::FilterType::Bandpass, 5000.0f, 0.0f, 0.5f),
+                         makeBand(EQ::FilterType::HighShelf, 8000.0f, -3.0f, 0.707f),
+                         makeBand(EQ::FilterType::HighCut, 16000.0f, 0.0f, 0.9f) };
+        return params;
+    }
+
+    /** The coefficients the previous per-band juce::dsp::IIR path ran. */
+    Coefficients::Ptr makeCoefficients(const EQ::BandParameters& band)
+    {
+        const float gain = juce::Decibels::decibelsToGain(band.gain);
+        switch (band.filterType)
+        {
+            case EQ::FilterType::Bell:      return Coefficients::makePeakFilter(kSampleRate, band.frequency, band.q, gain);
+            case EQ::FilterType::LowShelf:  return Coefficients::makeLowShelf(kSampleRate, band.frequency, band.q, gain);
+            case EQ::FilterType::HighShelf: return Coefficients::makeHighShelf(kSampleRate, band.frequency, band.q, gain);
+            case EQ::FilterType::LowCut:    return Coefficients::makeHighPass(kSampleRate, band.frequency, band.q);
+            case EQ::FilterType::HighCut:   return Coefficients::makeLowPass(kSampleRate, band.frequency, band.q);
+            case EQ::FilterType::Notch:     return Coefficients::makeNotch(kSampleRate, band.frequency, band.q);
+            case EQ::FilterType::Bandpass:  return Coefficients::makeBandPass(kSampleRate, band.frequency, band.q);
+            default:                        return nullptr;
+        }
+    }
+
+    /** The previous applyEQ(): one IIR::Filter per band and channel, band by band over the whole buffer. */
+    void applyReference(const EQ::Parameters& params, juce::AudioBuffer<float>& buffer)
+    {
+        for (const auto& band : params.bands)
+        {
+            if (! band.enabled)
+                continue;
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                juce::dsp::IIR::Filter<float> filter(makeCoefficients(band));
+                float* data = buffer.getWritePointer(ch);
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    data[i] = filter.processSample(data[i]);
+            }
+        }
+
+        buffer.applyGain(juce::Decibels::decibelsToGain(params.outputGain));
+    }
+
+    /** Runs buffer through eq in host-sized blocks. */
+    void applyInBlocks(EQ& eq, juce::AudioBuffer<float>& buffer, int blockSize)
+    {
+        juce::dsp::AudioBlock<float> whole(buffer);
+        for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+        {
+            auto block = whole.getSubBlock(static_cast<size_t>(start),
+                                           static_cast<size_t>(juce::jmin(blockSize, buffer.getNumSamples() - start)));
+            eq.applyEQ(block);
+        }
+    }
+
+    juce::AudioBuffer<float> makeNoise(int numChannels, int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        juce::Random random(0xe0);
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.5f);
+        return buffer;
+    }
+
+    float maxDifference(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int start = 0)
+    {
+        float largest = 0.0f;
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = start; i < a.getNumSamples(); ++i)
+                largest = juce::jmax(largest, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+        return largest;
+    }
+
+    /** Largest second difference of channel 0 in [start, end): a click shows up as a spike here. */
+    float maxCurvature(const juce::AudioBuffer<float>& buffer, int start, int end)
+    {
+        float largest = 0.0f;
+        const float* data = buffer.getReadPointer(0);
+        for (int i = juce::jmax(1, start); i < end - 1; ++i)
+            largest = juce::jmax(largest, std::abs(data[i + 1] - 2.0f * data[i] + data[i - 1]));
+        return largest;
+    }
+}
+
+/**
+ * Pins the tiled transposed direct form II cascade against the per-band
+ * juce::dsp::IIR path it replaced, and checks that a coefficient change
+ * ramps in without a step where host blocks or tiles meet.
+ */
+class ParametricEQCascadeTests : public juce::UnitTest
+{
+public:
+    ParametricEQCascadeTests() : juce::UnitTest("ParametricEQCascade", "ParametricEQCascade") {}
+
+    void runTest() override
+    {
+        testMatchesIIRReference();
+        testOutputGain();
+        testCoefficientRampIsContinuous();
+    }
+
+private:
+    void testMatchesIIRReference()
+    {
+        beginTest("cascade matches the juce::dsp::IIR path");
+
+        const auto params = makeParameters();
+
+        // Every lane width (1, 2, 4, 8), padded lanes (3, 6), and block sizes
+        // below, at and across the 64-sample tile.
+        for (const int numChannels : { 1, 2, 3, 4, 6, 8 })
+        {
+            for (const int blockSize : { 1, 37, 64, 100, 512, 4096 })
+            {
+                const auto input = makeNoise(numChannels, 8192);
+
+                auto expected = input;
+                applyReference(params, expected);
+
+                EQ eq;
+                eq.prepare(kSampleRate, blockSize);
+                eq.setParameters(params);
+
+                auto actual = input;
+                applyInBlocks(eq, actual, blockSize);
+
+                expect(maxDifference(expected, actual) < 1.0e-4f,
+                       juce::String(numChannels) + " channels, blocks of " + juce::String(blockSize)
+                           + ": off by " + juce::String(maxDifference(expected, actual)));
+            }
+        }
+    }
+
+    void testOutputGain()
+    {
+        beginTest("output gain is applied after the cascade");
+
+        auto params = makeParameters();
+        params.outputGain = -6.0f;
+
+        const auto input = makeNoise(2, 4096);
+        auto expected = input;
+        applyReference(params, expected);
+
+        EQ eq;
+        eq.prepare(kSampleRate, 512);
+        eq.setParameters(params);
+
+        auto actual = input;
+        applyInBlocks(eq, actual, 512);
+
+        expect(maxDifference(expected, actual) < 1.0e-4f);
+    }
+
+    void testCoefficientRampIsContinuous()
+    {
+        beginTest("a coefficient change ramps without a step at block boundaries");
+
+        // A 100 Hz tone through a bell that goes from 0 to +12 dB mid-stream.
+        // Blocks of 100 are not tile-aligned, so the ramp crosses both host
+        // block and tile boundaries.
+        constexpr int kBlockSize = 100;
+        constexpr int kChangeAt = 8000;
+        constexpr int kNumSamples = 30000;
+
+        juce::AudioBuffer<float> buffer(1, kNumSamples);
+        for (int i = 0; i < kNumSamples; ++i)
+            buffer.setSample(0, i, 0.5f * static_cast<float>(
+                std::sin(juce::MathConstants<double>::twoPi * 100.0 * i / kSampleRate)));
+        const auto input = buffer;
+
+        EQ::Parameters flat;
+        flat.bands = { makeBand(EQ::FilterType::Bell, 100.0f, 0.0f, 1.0f) };
+        EQ::Parameters boosted;
+        boosted.bands = { makeBand(EQ::FilterType::Bell, 100.0f, 12.0f, 1.0f) };
+
+        EQ eq;
+        eq.prepare(kSampleRate, kBlockSize);
+        eq.setParameters(flat);
+
+        juce::dsp::AudioBlock<float> whole(buffer);
+        for (int start = 0; start < kNumSamples; start += kBlockSize)
+        {
+            if (start == kChangeAt)
+                eq.setParameters(boosted);
+
+            auto block = whole.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(kBlockSize));
+            eq.applyEQ(block);
+        }
+
+        // Once settled, the boosted tone's curvature is the largest a smooth
+        // transition may show. Switching the coefficients outright spikes it
+        // about tenfold.
+        const float settled = maxCurvature(buffer, 20000, kNumSamples);
+        const float transition = maxCurvature(buffer, kChangeAt - 2, kChangeAt + 4000);
+        expect(transition <= settled * 1.25f,
+               "curvature " + juce::String(transition) + " through the ramp, " + juce::String(settled) + " settled");
+
+        for (int boundary = kChangeAt; boundary < kChangeAt + 4000; boundary += kBlockSize)
+            expect(maxCurvature(buffer, boundary - 1, boundary + 2) <= settled * 1.25f,
+                   "step at the block boundary " + juce::String(boundary));
+
+        // The ramp lands on the new coefficients: long after it, the output
+        // matches the reference run on the boosted band from the start.
+        auto expected = input;
+        applyReference(boosted, expected);
+        expect(maxDifference(expected, buffer, 20000) < 1.0e-3f);
+    }
+};
+
+static ParametricEQCascadeTests parametricEQCascadeTests;
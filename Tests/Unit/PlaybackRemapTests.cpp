@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    PlaybackRemapTests.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "../../Source/Audio/AudioSnapshot.h"
+
+namespace
+{
+    /** The ranges Delete/Insert/Replace publish through updatePlaybackAndDisplay(range). */
+    AudioEditRange deleted(int64_t start, int64_t length)  { return { start, length, 0 }; }
+    AudioEditRange inserted(int64_t start, int64_t length) { return { start, 0, length }; }
+
+    /** A position whose material survives the edit, and where that material ends up. */
+    struct Expectation
+    {
+        int64_t before;
+        int64_t after;
+    };
+}
+
+/**
+ * Pins where the playhead goes when an edit or its undo is published while
+ * playing. Delete, insert and replace no longer stop the transport; the
+ * engine hot-swaps the snapshot and moves the read position through
+ * AudioEditRange::remapPosition(), so playback continues on the same audio.
+ */
+class PlaybackRemapTests : public juce::UnitTest
+{
+public:
+    PlaybackRemapTests() : juce::UnitTest("PlaybackRemap", "PlaybackRemap") {}
+
+    void runTest() override
+    {
+        testDelete();
+        testInsert();
+        testReplace();
+        testUndoRoundTrip();
+        testInPlace();
+        testBeyondIntRange();
+    }
+
+private:
+    void expectRemaps(const AudioEditRange& range, std::initializer_list<Expectation> expectations)
+    {
+        for (const auto& e : expectations)
+            expectEquals(range.remapPosition(e.before), e.after,
+                         "position " + juce::String(e.before));
+    }
+
+    void testDelete()
+    {
+        beginTest("delete while playing");
+
+        // Before: unchanged. After: pulled back by the deleted length.
+        // Inside: snaps to the join, the first sample after the cut.
+        expectRemaps(deleted(1000, 500), { { 0, 0 }, { 999, 999 },
+                                           { 1000, 1000 }, { 1250, 1000 }, { 1499, 1000 },
+                                           { 1500, 1000 }, { 4000, 3500 } });
+    }
+
+    void testInsert()
+    {
+        beginTest("insert while playing");
+
+        // A playhead at the insert point keeps the sample it was about to
+        // play, which now sits after the inserted audio.
+        expectRemaps(inserted(1000, 500), { { 999, 999 }, { 1000, 1500 }, { 4000, 4500 } });
+    }
+
+    void testReplace()
+    {
+        beginTest("replace while playing");
+
+        // Growing: positions inside keep their offset; after shifts by the delta.
+        expectRemaps({ 1000, 500, 800 }, { { 999, 999 }, { 1200, 1200 }, { 1499, 1499 }, { 1500, 1800 } });
+
+        // Shrinking: positions inside clamp to the end of the new span.
+        expectRemaps({ 1000, 500, 100 }, { { 1050, 1050 }, { 1200, 1100 }, { 1500, 1100 }, { 2000, 1600 } });
+    }
+
+    void testUndoRoundTrip()
+    {
+        beginTest("edit then undo returns the playhead to the same material");
+
+        // Undo publishes the inverse range; positions outside the edited
+        // span must come back exactly where they were.
+        const auto edit = deleted(1000, 500);
+        const auto undo = inserted(1000, 500);
+
+        for (const int64_t position : { int64_t(0), int64_t(999), int64_t(1500), int64_t(2000), int64_t(100000) })
+            expectEquals(undo.remapPosition(edit.remapPosition(position)), position);
+
+        const AudioEditRange replace { 1000, 500, 800 };
+        const AudioEditRange replaceUndo { 1000, 800, 500 };
+        for (const int64_t position : { int64_t(10), int64_t(1000), int64_t(1499), int64_t(1500), int64_t(50000) })
+            expectEquals(replaceUndo.remapPosition(replace.remapPosition(position)), position);
+    }
+
+    void testInPlace()
+    {
+        beginTest("in-place edits leave the playhead alone");
+
+        const auto gain = AudioEditRange::inPlace(1000, 500);
+        expect(! gain.changesLength());
+        for (const int64_t position : { int64_t(0), int64_t(1000), int64_t(1250), int64_t(1500), int64_t(9000) })
+            expectEquals(gain.remapPosition(position), position);
+    }
+
+    void testBeyondIntRange()
+    {
+        beginTest("positions past INT_MAX");
+
+        const int64_t start = int64_t(3) * 1000 * 1000 * 1000;
+        expectRemaps(deleted(start, 44100), { { start - 1, start - 1 },
+                                              { start + 100, start },
+                                              { start + 44100 + 7, start + 7 } });
+    }
+};
+
+static PlaybackRemapTests playbackRemapTests;
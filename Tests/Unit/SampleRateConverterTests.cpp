@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    SampleRateConverterTests.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "../../Source/Audio/SampleRateConverter.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    constexpr float kAmplitude = 0.5f;
+
+    juce::AudioBuffer<float> makeSine(double frequency, double sampleRate, int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(1, numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            buffer.setSample(0, i, kAmplitude * static_cast<float>(
+                std::sin(juce::MathConstants<double>::twoPi * frequency * i / sampleRate)));
+        return buffer;
+    }
+
+    /** Streams input through a converter in chunkSize blocks, then flushes it. */
+    juce::AudioBuffer<float> convertStreamed(const juce::AudioBuffer<float>& input,
+                                             double fromRate, double toRate, int chunkSize)
+    {
+        SampleRateConverter converter(fromRate, toRate, input.getNumChannels());
+        juce::AudioBuffer<float> output(input.getNumChannels(),
+                                        static_cast<int>(converter.getOutputLength(input.getNumSamples())) + 64);
+        juce::AudioBuffer<float> block(input.getNumChannels(), converter.getMaxOutputSamples(chunkSize));
+        int written = 0;
+
+        const auto append = [&](int count)
+        {
+            for (int ch = 0; ch < input.getNumChannels(); ++ch)
+                output.copyFrom(ch, written, block, ch, 0, count);
+            written += count;
+        };
+
+        std::vector<const float*> pointers(static_cast<size_t>(input.getNumChannels()));
+        for (int position = 0; position < input.getNumSamples(); position += chunkSize)
+        {
+            const int count = juce::jmin(chunkSize, input.getNumSamples() - position);
+            for (int ch = 0; ch < input.getNumChannels(); ++ch)
+                pointers[static_cast<size_t>(ch)] = input.getReadPointer(ch, position);
+
+            append(converter.process(pointers.data(), count, block.getArrayOfWritePointers()));
+        }
+
+        block.setSize(input.getNumChannels(), converter.getMaxOutputSamples(0), false, false, true);
+        append(converter.finish(block.getArrayOfWritePointers()));
+
+        output.setSize(input.getNumChannels(), written, true, false, true);
+        return output;
+    }
+
+    /** Amplitude of the frequency component in [start, start + length), by least-squares fit. */
+    double measureAmplitude(const juce::AudioBuffer<float>& buffer, double frequency,
+                            double sampleRate, int start, int length)
+    {
+        double ss = 0.0, cc = 0.0, sc = 0.0, xs = 0.0, xc = 0.0;
+        const float* data = buffer.getReadPointer(0);
+        for (int i = start; i < start + length; ++i)
+        {
+            const double phase = juce::MathConstants<double>::twoPi * frequency * i / sampleRate;
+            const double s = std::sin(phase);
+            const double c = std::cos(phase);
+            ss += s * s;
+            cc += c * c;
+            sc += s * c;
+            xs += data[i] * s;
+            xc += data[i] * c;
+        }
+
+        const double det = ss * cc - sc * sc;
+        const double a = (xs * cc - xc * sc) / det;
+        const double b = (xc * ss - xs * sc) / det;
+        return std::sqrt(a * a + b * b);
+    }
+}
+
+class SampleRateConverterTests : public juce::UnitTest
+{
+public:
+    SampleRateConverterTests() : juce::UnitTest("SampleRateConverter", "SampleRateConverter") {}
+
+    void runTest() override
+    {
+        testPassbandRipple(44100.0, 48000.0);
+        testPassbandRipple(48000.0, 44100.0);
+        testStopbandAttenuation();
+        testLengthAndLatency(44100.0, 48000.0);
+        testLengthAndLatency(48000.0, 44100.0);
+    }
+
+private:
+    void testPassbandRipple(double fromRate, double toRate)
+    {
+        beginTest("passband ripple " + juce::String(fromRate) + " -> " + juce::String(toRate));
+
+        // Up to ~0.73 of the lower Nyquist rate, well clear of the transition band
+        const int numSamples = static_cast<int>(fromRate);
+        const int margin = static_cast<int>(toRate / 10.0);
+
+        for (const double frequency : { 100.0, 1000.0, 5000.0, 10000.0, 16000.0 })
+        {
+            const auto output = convertStreamed(makeSine(frequency, fromRate, numSamples), fromRate, toRate, 4096);
+            const double amplitude = measureAmplitude(output, frequency, toRate, margin,
+                                                      output.getNumSamples() - 2 * margin);
+            const double gainDb = juce::Decibels::gainToDecibels(amplitude / kAmplitude);
+
+            expect(std::abs(gainDb) < 0.05,
+                   juce::String(frequency) + " Hz comes out at " + juce::String(gainDb, 4) + " dB");
+        }
+    }
+
+    void testStopbandAttenuation()
+    {
+        beginTest("stopband attenuation 48000 -> 44100");
+
+        // Above 22.05 kHz these can only reach the output as aliases.
+        const int numSamples = 48000;
+        const int margin = 4410;
+
+        for (const double frequency : { 23000.0, 30000.0 })
+        {
+            const auto output = convertStreamed(makeSine(frequency, 48000.0, numSamples), 48000.0, 44100.0, 4096);
+            const float rms = output.getRMSLevel(0, margin, output.getNumSamples() - 2 * margin);
+            const double levelDb = juce::Decibels::gainToDecibels(rms / (kAmplitude / std::sqrt(2.0f)), -200.0f);
+
+            expect(levelDb < -100.0,
+                   juce::String(frequency) + " Hz leaks through at " + juce::String(levelDb, 1) + " dB");
+        }
+    }
+
+    void testLengthAndLatency(double fromRate, double toRate)
+    {
+        beginTest("length and latency " + juce::String(fromRate) + " -> " + juce::String(toRate));
+
+        // An odd length, fed in chunks that do not divide it.
+        const int numSamples = 2 * static_cast<int>(fromRate) + 17;
+        const double frequency = 1000.0;
+        const auto input = makeSine(frequency, fromRate, numSamples);
+
+        SampleRateConverter converter(fromRate, toRate, 1);
+        const int64_t expectedLength = static_cast<int64_t>(numSamples) * static_cast<int64_t>(toRate)
+                                       / static_cast<int64_t>(fromRate);
+        expectEquals(converter.getOutputLength(numSamples), expectedLength);
+
+        const auto streamed = convertStreamed(input, fromRate, toRate, 1000);
+        expectEquals(static_cast<int64_t>(streamed.getNumSamples()), expectedLength);
+
+        const auto whole = SampleRateConverter::resample(input, fromRate, toRate);
+        expectEquals(whole.getNumSamples(), streamed.getNumSamples());
+
+        // No delay: away from the edges the output is the same sine sampled
+        // at the new rate. A one-sample lag would be off by ~0.07 here.
+        const int margin = static_cast<int>(toRate / 10.0);
+        float worst = 0.0f;
+        for (int i = margin; i < streamed.getNumSamples() - margin; ++i)
+        {
+            const float ideal = kAmplitude * static_cast<float>(
+                std::sin(juce::MathConstants<double>::twoPi * frequency * i / toRate));
+            worst = juce::jmax(worst, std::abs(streamed.getSample(0, i) - ideal));
+            worst = juce::jmax(worst, std::abs(whole.getSample(0, i) - streamed.getSample(0, i)));
+        }
+
+        expect(worst < 1.0e-3f, "largest deviation " + juce::String(worst));
+    }
+};
+
+static SampleRateConverterTests sampleRateConverterTests;
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    TimePitchEngineTests.cpp
+    WaveEdit - Professional Audio Editor
+    Copyright (C) 2025 WaveEdit
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "../../Source/DSP/TimePitchEngine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // A low rate keeps the minute-long inputs that take the segmented path cheap.
+    constexpr double kSampleRate = 8000.0;
+    constexpr double kToneHz = 220.0;
+    constexpr float kAmplitude = 0.5f;
+
+    juce::AudioBuffer<float> makeSine(int numChannels, double seconds)
+    {
+        const int numSamples = juce::roundToInt(seconds * kSampleRate);
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(ch, i, kAmplitude * static_cast<float>(
+                    std::sin(juce::MathConstants<double>::twoPi * kToneHz * i / kSampleRate)));
+        return buffer;
+    }
+
+    /** Largest sample-to-sample step in [start, start + length) of channel 0. */
+    float maxStep(const juce::AudioBuffer<float>& buffer, int start, int length)
+    {
+        float largest = 0.0f;
+        const float* data = buffer.getReadPointer(0);
+        for (int i = start + 1; i < start + length; ++i)
+            largest = std::max(largest, std::abs(data[i] - data[i - 1]));
+        return largest;
+    }
+}
+
+class TimePitchEngineTests : public juce::UnitTest
+{
+public:
+    TimePitchEngineTests() : juce::UnitTest("TimePitchEngine", "TimePitchEngine") {}
+
+    void runTest() override
+    {
+        testSegmentedLengthMatchesSingle();
+        testSegmentJoinIsContinuous();
+        testCancelReturnsEmpty();
+    }
+
+private:
+    static TimePitchEngine::Recipe fasterRecipe()
+    {
+        TimePitchEngine::Recipe recipe;
+        recipe.tempoPercent = 25.0;
+        return recipe;
+    }
+
+    void testSegmentedLengthMatchesSingle()
+    {
+        beginTest("segmented render is as long as a single render");
+
+        // 50 s renders in one piece, 65 s in two segments. Whatever
+        // SoundTouch adds at the ends is the same for both, so the lengths
+        // must differ by the extra 15 s of input, scaled by the tempo.
+        const auto single = TimePitchEngine::apply(makeSine(2, 50.0), kSampleRate, fasterRecipe());
+        const auto segmented = TimePitchEngine::apply(makeSine(2, 65.0), kSampleRate, fasterRecipe());
+
+        expect(single.getNumSamples() > 0 && segmented.getNumSamples() > 0);
+        expectEquals(segmented.getNumChannels(), 2);
+
+        const double expectedExtra = 15.0 * kSampleRate / 1.25;
+        const double actualExtra = segmented.getNumSamples() - single.getNumSamples();
+        const double tolerance = 0.025 * kSampleRate;   // the alignment search range, plus slack
+        expectWithinAbsoluteError(actualExtra, expectedExtra, tolerance);
+    }
+
+    void testSegmentJoinIsContinuous()
+    {
+        beginTest("segments join without a click or a comb-filter dip");
+
+        const auto result = TimePitchEngine::apply(makeSine(1, 65.0), kSampleRate, fasterRecipe());
+        expect(result.getNumSamples() > 0);
+
+        // Segment 1 starts at 30 s of input, which lands at 24 s of output.
+        const int join = juce::roundToInt(30.0 * kSampleRate / 1.25);
+        const int window = juce::roundToInt(0.1 * kSampleRate);
+        const int joinStart = join - window / 2;
+        const int referenceStart = juce::roundToInt(10.0 * kSampleRate);
+
+        const float referenceStep = maxStep(result, referenceStart, window);
+        const float joinStep = maxStep(result, joinStart, window);
+        expect(joinStep <= referenceStep * 1.5f + 1.0e-3f,
+               "step at the join " + juce::String(joinStep) + " vs " + juce::String(referenceStep));
+
+        const float referenceRms = result.getRMSLevel(0, referenceStart, window);
+        const float joinRms = result.getRMSLevel(0, joinStart, window);
+        expect(joinRms >= referenceRms * 0.8f,
+               "level at the join " + juce::String(joinRms) + " vs " + juce::String(referenceRms));
+    }
+
+    void testCancelReturnsEmpty()
+    {
+        beginTest("cancelling a segmented render returns an empty buffer");
+
+        int calls = 0;
+        const auto result = TimePitchEngine::apply(makeSine(1, 65.0), kSampleRate, fasterRecipe(),
+                                                   [&calls](float) { return ++calls < 2; });
+        expectEquals(result.getNumSamples(), 0);
+    }
+};
+
+static TimePitchEngineTests timePitchEngineTests;